@@ -310,7 +310,7 @@ def display_args_to_z3(params):
 
 NULLWrapped = [ 'Z3_mk_context', 'Z3_mk_context_rc' ]
 Unwrapped = [ 'Z3_del_context', 'Z3_get_error_code' ]
-Unchecked = frozenset([ 'Z3_dec_ref', 'Z3_params_dec_ref', 'Z3_model_dec_ref',
+Unchecked = frozenset([ 'Z3_dec_ref', 'Z3_dec_ref_array', 'Z3_params_dec_ref', 'Z3_model_dec_ref',
                         'Z3_func_interp_dec_ref', 'Z3_func_entry_dec_ref',
                         'Z3_goal_dec_ref', 'Z3_tactic_dec_ref', 'Z3_simplifier_dec_ref', 'Z3_probe_dec_ref',
                         'Z3_fixedpoint_dec_ref', 'Z3_param_descrs_dec_ref',
@@ -363,6 +363,10 @@ def Z3_solver_propagate_diseq(ctx, s, diseq_eh, _elems = Elementaries(_lib.Z3_so
     _elems.f(ctx, s, diseq_eh)
     _elems.Check(ctx)
 
+def Z3_solver_propagate_batch(ctx, s, batch_eh, _elems = Elementaries(_lib.Z3_solver_propagate_batch)):
+    _elems.f(ctx, s, batch_eh)
+    _elems.Check(ctx)
+
 def Z3_optimize_register_model_eh(ctx, o, m, user_ctx, on_model_eh, _elems = Elementaries(_lib.Z3_optimize_register_model_eh)):
     _elems.f(ctx, o, m, user_ctx, on_model_eh)
     _elems.Check(ctx)
@@ -426,7 +430,7 @@ def mk_dotnet(dotnet):
     dotnet.write('    {\n\n')
 
     for name, ret, sig in Closures:
-        sig = sig.replace("unsigned const*","uint[]")
+        sig = sig.replace("unsigned const*","uint[]").replace("Z3_ast const*","IntPtr")
         sig = sig.replace("void*","voidp").replace("unsigned","uint")
         sig = sig.replace("Z3_ast*","ref IntPtr").replace("uint*","ref uint").replace("Z3_lbool*","ref int")
         ret = ret.replace("void*","voidp").replace("unsigned","uint")        
@@ -1390,6 +1394,7 @@ z3_ml_callbacks = frozenset([
     'Z3_solver_propagate_final',
     'Z3_solver_propagate_eq',
     'Z3_solver_propagate_diseq',
+    'Z3_solver_propagate_batch',
     'Z3_solver_propagate_created',
     'Z3_solver_propagate_decide',
     'Z3_solver_register_on_clause'
@@ -1944,6 +1949,7 @@ Z3_eq_eh    = ctypes.CFUNCTYPE(None, ctypes.c_void_p, ctypes.c_void_p, ctypes.c_
 
 Z3_created_eh = ctypes.CFUNCTYPE(None, ctypes.c_void_p, ctypes.c_void_p, ctypes.c_void_p)
 Z3_decide_eh = ctypes.CFUNCTYPE(None, ctypes.c_void_p, ctypes.c_void_p, ctypes.c_void_p, ctypes.c_uint, ctypes.c_int)
+Z3_batch_eh = ctypes.CFUNCTYPE(None, ctypes.c_void_p, ctypes.c_void_p, ctypes.c_uint, ctypes.POINTER(ctypes.c_void_p), ctypes.POINTER(ctypes.c_void_p), ctypes.c_uint, ctypes.POINTER(ctypes.c_void_p), ctypes.POINTER(ctypes.c_void_p))
 
 _lib.Z3_solver_register_on_clause.restype = None
 _lib.Z3_solver_propagate_init.restype = None
@@ -1951,6 +1957,7 @@ _lib.Z3_solver_propagate_final.restype = None
 _lib.Z3_solver_propagate_fixed.restype = None
 _lib.Z3_solver_propagate_eq.restype = None
 _lib.Z3_solver_propagate_diseq.restype = None
+_lib.Z3_solver_propagate_batch.restype = None
 _lib.Z3_solver_propagate_decide.restype = None
 
 on_model_eh_type = ctypes.CFUNCTYPE(None, ctypes.c_void_p)
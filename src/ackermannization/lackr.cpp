@@ -46,6 +46,7 @@ lackr::lackr(ast_manager& m, const params_ref& p, lackr_stats& st,
 void lackr::updt_params(params_ref const & _p) {
     ackermannization_params p(_p);
     m_eager = p.eager();
+    m_eager_max_lemmas = p.eager_max_lemmas();
 }
 
 lackr::~lackr() {    
@@ -61,7 +62,10 @@ lbool lackr::operator()() {
     SASSERT(m_solver);
     if (!init()) 
         return l_undef;
-    lbool rv = m_eager ? eager() : lazy();
+    // the number of lemmas is quadratic in the number of applications of each function,
+    // large problems are refined with the lemmas violated by the abstraction models.
+    bool eager = m_eager && ackr_helper::calculate_lemma_bound(m_fun2terms, m_sel2terms) <= m_eager_max_lemmas;
+    lbool rv = eager ? this->eager() : lazy();
     if (rv == l_true) {
         m_solver->get_model(m_model);
     }
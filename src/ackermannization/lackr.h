@@ -92,6 +92,7 @@ class lackr {
         expr_ref_vector                      m_ackrs;
         model_ref                            m_model;
         bool                                 m_eager;
+        unsigned                             m_eager_max_lemmas;
         expr_mark                            m_non_select;
         ast_mark                             m_non_funs;
         lackr_stats&                         m_st;
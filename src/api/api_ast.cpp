@@ -18,6 +18,7 @@ Revision History:
 #include "api/api_log_macros.h"
 #include "api/api_context.h"
 #include "api/api_util.h"
+#include "api/api_ast_vector.h"
 #include "ast/well_sorted.h"
 #include "ast/arith_decl_plugin.h"
 #include "ast/bv_decl_plugin.h"
@@ -209,6 +210,62 @@ extern "C" {
         Z3_CATCH_RETURN(nullptr);
     }
 
+    Z3_ast_vector Z3_API Z3_mk_ast_dag(Z3_context c,
+                                       unsigned num_leaves, Z3_ast const leaves[],
+                                       unsigned num_decls, Z3_func_decl const decls[],
+                                       unsigned code_size, unsigned const code[],
+                                       unsigned num_roots, unsigned const roots[]) {
+        Z3_TRY;
+        LOG_Z3_mk_ast_dag(c, num_leaves, leaves, num_decls, decls, code_size, code, num_roots, roots);
+        RESET_ERROR_CODE();
+        ast_manager& m = mk_c(c)->m();
+        expr_ref_vector nodes(m);
+        for (unsigned i = 0; i < num_leaves; ++i) {
+            if (!is_expr(to_ast(leaves[i]))) {
+                SET_ERROR_CODE(Z3_INVALID_ARG, "leaf is not an expression");
+                RETURN_Z3(nullptr);
+            }
+            nodes.push_back(to_expr(leaves[i]));
+        }
+        ptr_buffer<expr> args;
+        unsigned pc = 0;
+        while (pc < code_size) {
+            if (pc + 1 >= code_size || code[pc] >= num_decls || code[pc + 1] > code_size - pc - 2) {
+                SET_ERROR_CODE(Z3_INVALID_ARG, "malformed code");
+                RETURN_Z3(nullptr);
+            }
+            func_decl* d = to_func_decl(decls[code[pc]]);
+            unsigned n = code[pc + 1];
+            pc += 2;
+            if (d->is_polymorphic()) {
+                SET_ERROR_CODE(Z3_INVALID_ARG, "polymorphic functions are not supported");
+                RETURN_Z3(nullptr);
+            }
+            args.reset();
+            for (unsigned j = 0; j < n; ++j, ++pc) {
+                if (code[pc] >= nodes.size()) {
+                    SET_ERROR_CODE(Z3_INVALID_ARG, "argument refers to a node that is not defined");
+                    RETURN_Z3(nullptr);
+                }
+                args.push_back(nodes.get(code[pc]));
+            }
+            app* a = m.mk_app(d, n, args.data());
+            check_sorts(c, a);
+            nodes.push_back(a);
+        }
+        Z3_ast_vector_ref * v = alloc(Z3_ast_vector_ref, *mk_c(c), m);
+        mk_c(c)->save_object(v);
+        for (unsigned i = 0; i < num_roots; ++i) {
+            if (roots[i] >= nodes.size()) {
+                SET_ERROR_CODE(Z3_INVALID_ARG, "root refers to a node that is not defined");
+                RETURN_Z3(nullptr);
+            }
+            v->m_ast_vector.push_back(nodes.get(roots[i]));
+        }
+        RETURN_Z3(of_ast_vector(v));
+        Z3_CATCH_RETURN(nullptr);
+    }
+
     Z3_ast Z3_API Z3_mk_const(Z3_context c, Z3_symbol s, Z3_sort ty) {
         Z3_TRY;
         LOG_Z3_mk_const(c, s, ty);
@@ -782,6 +839,7 @@ extern "C" {
         bool     use_ctrl_c  = p.get_bool("ctrl_c", false);
         th_rewriter m_rw(m, p);
         m_rw.set_solver(alloc(api::seq_expr_solver, m, p));
+        m_rw.set_cache(mk_c(c)->simplify_cache());
         expr_ref    result(m);
         cancel_eh<reslimit> eh(m.limit());
         api::context::set_interruptable si(*(mk_c(c)), eh);
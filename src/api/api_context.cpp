@@ -79,6 +79,18 @@ namespace api {
             m().dec_ref(a);
     }
 
+    void context::dec_ref(unsigned n, ast* const* as) {
+#ifndef SINGLE_THREAD
+        if (m_concurrent_dec_ref) {
+            lock_guard lock(m_mux);
+            m_asts_to_flush.append(n, as);
+        }
+        else
+#endif
+            for (unsigned i = 0; i < n; ++i)
+                m().dec_ref(as[i]);
+    }
+
     // flush_objects can only be called in the main thread.
     // This ensures that the calls to m().dec_ref() and dealloc(o)
     // only happens in the main thread.
@@ -169,20 +181,22 @@ namespace api {
             DEBUG_CODE(if (!m_concurrent_dec_ref) warning_msg("Uncollected memory: %d: %s", kv.m_key, typeid(*val).name()););
             dealloc(val);
         }
+        m_simplify_cache = nullptr;
         if (m_params.owns_manager())
             m_manager.detach();
 
     }
 
     context::set_interruptable::set_interruptable(context & ctx, event_handler & i):
-        m_ctx(ctx) {
+        m_ctx(ctx), m_eh(i) {
         lock_guard lock(ctx.m_mux);
         m_ctx.m_interruptable.push_back(& i);
     }
 
     context::set_interruptable::~set_interruptable() {
         lock_guard lock(m_ctx.m_mux);
-        m_ctx.m_interruptable.pop_back();
+        // asynchronous checks may finish in any order.
+        m_ctx.m_interruptable.erase(& m_eh);
     }
 
     void context::interrupt() {
@@ -193,6 +207,32 @@ namespace api {
         m().limit().cancel();        
     }
     
+    void context::reset() {
+        if (m_parser) {
+            smt2::free_parser(m_parser);
+            m_parser = nullptr;
+        }
+        m_cmd = nullptr;
+        m_last_obj = nullptr;
+        flush_objects();
+        m_ast_trail.reset();
+        m_simplify_cache = nullptr;
+        m_string_buffer.clear();
+        m_error_code = Z3_OK;
+        m_exception_msg.clear();
+        m_print_mode = Z3_PRINT_SMTLIB_FULL;
+        m_limit.reset_cancel();
+        m().limit().reset_cancel();
+        if (!m_params.owns_manager())
+            m().compact_memory();
+    }
+
+    context * context::mk_child() {
+        ast_context_params p(m_params);
+        p.set_foreign_manager(&m());
+        return alloc(context, &p, m_user_ref_count);
+    }
+
     void context::set_error_code(Z3_error_code err, char const* opt_msg) {
         m_error_code = err; 
         if (err != Z3_OK) {
@@ -370,6 +410,16 @@ namespace api {
         return *(m_rcf_manager.get());
     }
 
+    th_rewriter_cache * context::simplify_cache() {
+        unsigned max_size = m_params.m_simplify_cache;
+        if (max_size == 0)
+            return nullptr;
+        if (!m_simplify_cache)
+            m_simplify_cache = alloc(th_rewriter_cache, m(), max_size);
+        m_simplify_cache->set_max_size(max_size);
+        return m_simplify_cache.get();
+    }
+
 };
 
 
@@ -408,6 +458,23 @@ extern "C" {
         Z3_CATCH;
     }
 
+    void Z3_API Z3_context_reset(Z3_context c) {
+        Z3_TRY;
+        LOG_Z3_context_reset(c);
+        RESET_ERROR_CODE();
+        mk_c(c)->reset();
+        Z3_CATCH;
+    }
+
+    Z3_context Z3_API Z3_mk_child_context(Z3_context c) {
+        Z3_TRY;
+        LOG_Z3_mk_child_context(c);
+        RESET_ERROR_CODE();
+        Z3_context r = reinterpret_cast<Z3_context>(mk_c(c)->mk_child());
+        RETURN_Z3(r);
+        Z3_CATCH_RETURN(nullptr);
+    }
+
     void Z3_API Z3_interrupt(Z3_context c) {
         Z3_TRY;
         LOG_Z3_interrupt(c);
@@ -451,6 +518,24 @@ extern "C" {
         Z3_CATCH;
     }
 
+    void Z3_API Z3_dec_ref_array(Z3_context c, unsigned num, Z3_ast const a[]) {
+        Z3_TRY;
+        LOG_Z3_dec_ref_array(c, num, a);
+        ptr_buffer<ast, 128> as;
+        for (unsigned i = 0; i < num; ++i) {
+            if (!a[i])
+                continue;
+            if (to_ast(a[i])->get_ref_count() == 0) {
+                RESET_ERROR_CODE();
+                SET_ERROR_CODE(Z3_DEC_REF_ERROR, nullptr);
+                break;
+            }
+            as.push_back(to_ast(a[i]));
+        }
+        mk_c(c)->dec_ref(as.size(), as.data());
+        Z3_CATCH;
+    }
+
 
     void Z3_API Z3_get_version(unsigned * major, 
                                unsigned * minor, 
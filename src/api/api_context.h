@@ -32,6 +32,7 @@ Revision History:
 #include "ast/recfun_decl_plugin.h"
 #include "ast/special_relations_decl_plugin.h"
 #include "ast/rewriter/seq_rewriter.h"
+#include "ast/rewriter/th_rewriter_cache.h"
 #include "smt/params/smt_params.h"
 #include "smt/smt_kernel.h"
 #include "smt/smt_solver.h"
@@ -132,7 +133,8 @@ namespace api {
      public:
         // Scoped obj for setting m_interruptable
         class set_interruptable {
-            context & m_ctx;
+            context &       m_ctx;
+            event_handler & m_eh;
         public:
             set_interruptable(context & ctx, event_handler & i);
             ~set_interruptable();
@@ -192,6 +194,7 @@ namespace api {
         unsigned add_object(api::object* o);
         void del_object(api::object* o);
         void dec_ref(ast* a);
+        void dec_ref(unsigned n, ast* const* as);
         void flush_objects();
 
         Z3_ast_print_mode get_print_mode() const { return m_print_mode; }
@@ -234,6 +237,12 @@ namespace api {
         // Interrupt the current interruptible object
         void interrupt();
 
+        // Release the state accumulated since the creation of the context.
+        void reset();
+
+        // Create a context that uses the same ast_manager.
+        context * mk_child();
+
         void invoke_error_handler(Z3_error_code c);
 
         void check_sorts(ast * n);
@@ -274,6 +283,16 @@ namespace api {
     public:
         realclosure::manager & rcfm();
 
+        // ------------------------
+        //
+        // Simplification results shared by Z3_simplify calls
+        //
+        // -----------------------
+    private:
+        scoped_ptr<th_rewriter_cache>    m_simplify_cache;
+    public:
+        th_rewriter_cache * simplify_cache();
+
         // ------------------------
         //
         // Solver interface for backward compatibility 
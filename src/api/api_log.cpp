@@ -16,13 +16,145 @@ Revision History:
 
 --*/
 #include<fstream>
+#include<chrono>
+#include<memory>
+#ifndef SINGLE_THREAD
+#include<thread>
+#include<condition_variable>
+#endif
 #include "api/z3.h"
 #include "api/api_log_macros.h"
 #include "api/z3_logger.h"
 #include "util/util.h"
 #include "util/z3_version.h"
 #include "util/mutex.h"
+#include "util/gparams.h"
+#include "util/memory_manager.h"
+
+namespace {
+/**
+   \brief stream buffer for the API log. Records are collected in memory and
+   written to the file at the end of each API call, so that the log is complete
+   up to the last call when the process crashes.
+   With the global parameter log_buffered=true the records are instead written
+   by a background thread, either when the buffer is full or when the last write
+   is older than the flush interval. Logging then costs a memory copy per record
+   instead of a write system call, but the tail of the log is lost on a crash.
+*/
+class log_buffer : public std::streambuf {
+    static const size_t BUFFER_SIZE = 1 << 20;
+    static const unsigned FLUSH_INTERVAL_MS = 100;
+    std::ofstream m_out;
+    std::vector<char> m_active, m_pending;
+    size_t m_pending_size = 0;
+    std::chrono::steady_clock::time_point m_last_flush;
+    unsigned m_calls = 0;
+    bool m_buffered;
+#ifndef SINGLE_THREAD
+    std::mutex m_mux;
+    std::condition_variable m_cv;
+    bool m_done = false;
+    std::thread m_writer;
+
+    void writer() {
+        std::unique_lock<std::mutex> lock(m_mux);
+        while (true) {
+            m_cv.wait(lock, [&]() { return m_pending_size > 0 || m_done; });
+            if (m_pending_size > 0) {
+                m_out.write(m_pending.data(), m_pending_size);
+                m_out.flush();
+                m_pending_size = 0;
+                m_cv.notify_all();
+            }
+            else if (m_done)
+                return;
+        }
+    }
+#endif
+
+    // write the active buffer, or hand it to the writer when buffered.
+    void hand_off() {
+        size_t sz = pptr() - pbase();
+        m_last_flush = std::chrono::steady_clock::now();
+        if (sz == 0)
+            return;
+#ifndef SINGLE_THREAD
+        if (m_buffered) {
+            std::unique_lock<std::mutex> lock(m_mux);
+            m_cv.wait(lock, [&]() { return m_pending_size == 0; });
+            m_active.swap(m_pending);
+            m_pending_size = sz;
+            m_cv.notify_all();
+            setp(m_active.data(), m_active.data() + m_active.size());
+            return;
+        }
+#endif
+        m_out.write(m_active.data(), sz);
+        m_out.flush();
+        setp(m_active.data(), m_active.data() + m_active.size());
+    }
+
+protected:
+    int_type overflow(int_type c) override {
+        hand_off();
+        if (c != traits_type::eof()) {
+            *pptr() = traits_type::to_char_type(c);
+            pbump(1);
+        }
+        return traits_type::not_eof(c);
+    }
+
+    int sync() override {
+        hand_off();
+        return 0;
+    }
+
+public:
+    log_buffer(char const * filename, bool buffered):
+        m_out(filename, std::ios::binary), m_active(BUFFER_SIZE), m_pending(buffered ? BUFFER_SIZE : 0), m_buffered(buffered) {
+        setp(m_active.data(), m_active.data() + m_active.size());
+        m_last_flush = std::chrono::steady_clock::now();
+#ifndef SINGLE_THREAD
+        if (m_out && m_buffered)
+            m_writer = std::thread([this]() { writer(); });
+#endif
+    }
+
+    ~log_buffer() override {
+        hand_off();
+#ifndef SINGLE_THREAD
+        {
+            std::lock_guard<std::mutex> lock(m_mux);
+            m_done = true;
+            m_cv.notify_all();
+        }
+        if (m_writer.joinable())
+            m_writer.join();
+#endif
+    }
+
+    bool ok() const { return !m_out.fail(); }
+
+    // called at the end of each logged API call.
+    void end_of_call() {
+        if (!m_buffered)
+            hand_off();
+        else if ((++m_calls & 0xFF) == 0 &&
+            std::chrono::steady_clock::now() - m_last_flush > std::chrono::milliseconds(FLUSH_INTERVAL_MS))
+            hand_off();
+    }
+};
+
+struct api_log {
+    log_buffer   m_buffer;
+    std::ostream m_stream;
+    api_log(char const * filename, bool buffered): m_buffer(filename, buffered), m_stream(&m_buffer) {}
+};
+}
 
+// the log is allocated outside of the memory manager, since it is flushed
+// when the process exits, possibly after the memory manager was finalized.
+static std::unique_ptr<api_log> g_api_log;
 static std::ostream * g_z3_log = nullptr;
 atomic<bool> g_z3_log_enabled;
 
@@ -73,12 +205,12 @@ std::ostream & operator<<(std::ostream & out, ll_escaped const & d) {
 }
 }
 
-void R()              { *g_z3_log << 'R' << std::endl; }
-void P(void * obj)    { *g_z3_log << "P " << obj <<std::endl; }
-void I(int64_t i)     { *g_z3_log << "I " << i << std::endl; }
-void U(uint64_t u)    { *g_z3_log << "U " << u << std::endl; }
-void D(double d)      { *g_z3_log << "D " << d << std::endl; }
-void S(Z3_string str) { *g_z3_log << "S \"" << ll_escaped{str} << '"' << std::endl; }
+void R()              { *g_z3_log << 'R' << '\n'; }
+void P(void * obj)    { *g_z3_log << "P " << obj << '\n'; }
+void I(int64_t i)     { *g_z3_log << "I " << i << '\n'; }
+void U(uint64_t u)    { *g_z3_log << "U " << u << '\n'; }
+void D(double d)      { *g_z3_log << "D " << d << '\n'; }
+void S(Z3_string str) { *g_z3_log << "S \"" << ll_escaped{str} << '"' << '\n'; }
 void Sy(Z3_symbol sym) {
     symbol s = symbol::c_api_ext2symbol(sym);
     if (s.is_null()) {
@@ -90,14 +222,14 @@ void Sy(Z3_symbol sym) {
     else {
         *g_z3_log << "$ |" << ll_escaped{s.str().c_str()} << '|';
     }
-    *g_z3_log << std::endl;
+    *g_z3_log << '\n';
 }
-void Ap(unsigned sz)  { *g_z3_log << "p " << sz << std::endl; }
-void Au(unsigned sz)  { *g_z3_log << "u " << sz << std::endl; }
-void Ai(unsigned sz)  { *g_z3_log << "i " << sz << std::endl; }
-void Asy(unsigned sz) { *g_z3_log << "s " << sz << std::endl; }
-void C(unsigned id)   { *g_z3_log << "C " << id << std::endl; }
-static void _Z3_append_log(char const * msg) { *g_z3_log << "M \"" << ll_escaped{msg} << '"' << std::endl; }
+void Ap(unsigned sz)  { *g_z3_log << "p " << sz << '\n'; }
+void Au(unsigned sz)  { *g_z3_log << "u " << sz << '\n'; }
+void Ai(unsigned sz)  { *g_z3_log << "i " << sz << '\n'; }
+void Asy(unsigned sz) { *g_z3_log << "s " << sz << '\n'; }
+void C(unsigned id)   { *g_z3_log << "C " << id << '\n'; g_api_log->m_buffer.end_of_call(); }
+static void _Z3_append_log(char const * msg) { *g_z3_log << "M \"" << ll_escaped{msg} << '"' << '\n'; }
 
 void ctx_enable_logging() {
     SCOPED_LOCK();
@@ -108,7 +240,7 @@ void ctx_enable_logging() {
 static void Z3_close_log_unsafe(void) {
     if (g_z3_log != nullptr) {
         g_z3_log_enabled = false;
-        dealloc(g_z3_log);
+        g_api_log = nullptr;
         g_z3_log = nullptr;
     }
 }
@@ -117,16 +249,18 @@ extern "C" {
     bool Z3_API Z3_open_log(Z3_string filename) {
         bool res;
 
+        memory::initialize(UINT_MAX);
+        bool buffered = gparams::get_ref().get_bool("log_buffered", false);
         SCOPED_LOCK();
         Z3_close_log_unsafe();
 
-        g_z3_log = alloc(std::ofstream, filename);
-        if (g_z3_log->bad() || g_z3_log->fail()) {
-            dealloc(g_z3_log);
-            g_z3_log = nullptr;
+        g_api_log = std::make_unique<api_log>(filename, buffered);
+        if (!g_api_log->m_buffer.ok()) {
+            g_api_log = nullptr;
             res = false;
         }
         else {
+            g_z3_log = &g_api_log->m_stream;
             *g_z3_log << "V \"" << Z3_MAJOR_VERSION << "." << Z3_MINOR_VERSION << "." << Z3_BUILD_NUMBER << "." << Z3_REVISION_NUMBER << '"' << std::endl;
             res = true;
         }
@@ -172,6 +172,94 @@ extern "C" {
         Z3_CATCH_RETURN(false);
     }
 
+    /**
+       \brief store the value r in w little-endian words, in two's complement.
+       Return false if it does not fit, where unsigned values may use all bits.
+    */
+    static bool rational2words(rational r, bool is_signed, unsigned w, unsigned* words) {
+        rational bound = rational::power_of_two(32 * w - (is_signed ? 1 : 0));
+        if (!r.is_int() || r >= bound || (is_signed ? r < -bound : r.is_neg()))
+            return false;
+        if (r.is_neg())
+            r += rational::power_of_two(32 * w);
+        if (r.is_uint64()) {
+            uint64_t v = r.get_uint64();
+            words[0] = static_cast<unsigned>(v);
+            if (w > 1)
+                words[1] = static_cast<unsigned>(v >> 32);
+            return true;
+        }
+        rational two32 = rational::power_of_two(32);
+        for (unsigned i = 0; i < w; ++i) {
+            rational lo = mod(r, two32);
+            words[i] = lo.get_unsigned();
+            r = (r - lo) / two32;
+        }
+        return true;
+    }
+
+    bool Z3_API Z3_model_eval_values(Z3_context c, Z3_model m, unsigned num_terms, Z3_ast const terms[],
+                                     bool model_completion, bool as_double, unsigned num_words, unsigned words[]) {
+        Z3_TRY;
+        LOG_Z3_model_eval_values(c, m, num_terms, terms, model_completion, as_double, num_words, words);
+        RESET_ERROR_CODE();
+        CHECK_NON_NULL(m, false);
+        for (unsigned i = 0; i < num_words; ++i)
+            words[i] = 0;
+        if (num_terms == 0)
+            return true;
+        unsigned w = num_words / num_terms;
+        if (w == 0 || w * num_terms != num_words || (as_double && w != 2)) {
+            SET_ERROR_CODE(Z3_INVALID_ARG, "the number of words is not a multiple of the number of terms");
+            return false;
+        }
+        model * _m = to_model_ref(m);
+        ast_manager& mgr = mk_c(c)->m();
+        arith_util& a = mk_c(c)->autil();
+        bv_util& bv = mk_c(c)->bvutil();
+        fpa_util& fu = mk_c(c)->fpautil();
+        if (!_m->has_solver()) {
+            params_ref p;
+            _m->set_solver(alloc(api::seq_expr_solver, mgr, p));
+        }
+        model::scoped_model_completion _scm(*_m, model_completion);
+        expr_ref val(mgr);
+        rational r;
+        unsigned sz;
+        scoped_mpf f(fu.fm());
+        bool all_ok = true;
+        for (unsigned i = 0; i < num_terms; ++i) {
+            CHECK_IS_EXPR(terms[i], false);
+            val = (*_m)(to_expr(terms[i]));
+            unsigned* out = words + i * w;
+            bool ok = true;
+            if (as_double) {
+                double d = 0;
+                if (mgr.is_true(val) || mgr.is_false(val))
+                    d = mgr.is_true(val) ? 1.0 : 0.0;
+                else if (a.is_numeral(val, r))
+                    d = r.get_double();
+                else if (fu.is_numeral(val, f))
+                    d = fu.fm().to_double(f);
+                else
+                    ok = false;
+                if (ok)
+                    memcpy(out, &d, sizeof(d));
+            }
+            else if (mgr.is_true(val) || mgr.is_false(val))
+                out[0] = mgr.is_true(val) ? 1 : 0;
+            else if (a.is_numeral(val, r))
+                ok = rational2words(r, true, w, out);
+            else if (bv.is_numeral(val, r, sz))
+                ok = rational2words(r, false, w, out);
+            else
+                ok = false;
+            all_ok &= ok;
+        }
+        return all_ok;
+        Z3_CATCH_RETURN(false);
+    }
+
     unsigned Z3_API Z3_model_get_num_sorts(Z3_context c, Z3_model m) {
         Z3_TRY;
         LOG_Z3_model_get_num_sorts(c, m);
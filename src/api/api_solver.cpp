@@ -17,6 +17,8 @@ Revision History:
 
 --*/
 #include<thread>
+#include<condition_variable>
+#include<chrono>
 #include "util/scoped_ctrl_c.h"
 #include "util/cancel_eh.h"
 #include "util/file_path.h"
@@ -121,6 +123,60 @@ extern "C" {
         }
     }
 
+    /**
+       \brief state of an asynchronous check. The interrupt handler is registered with
+       the solver and the context before the worker starts, and unregistered only after
+       the worker is joined, so interrupts cannot be lost or reach a finished check.
+    */
+    struct Z3_solver_ref::async_check {
+        expr_ref_vector m_assumptions;
+        lbool           m_result = l_undef;
+        std::string     m_error;
+        bool            m_done = false;
+        cancel_eh<reslimit> m_eh;
+        scoped_ptr<api::context::set_interruptable> m_interruptable;
+#ifndef SINGLE_THREAD
+        std::thread             m_thread;
+        std::mutex              m_mux;
+        std::condition_variable m_cv;
+#endif
+        async_check(api::context& c): m_assumptions(c.m()), m_eh(c.m().limit()) {
+            m_interruptable = alloc(api::context::set_interruptable, c, m_eh);
+        }
+
+        bool wait(unsigned timeout_ms) {
+#ifndef SINGLE_THREAD
+            std::unique_lock<std::mutex> lock(m_mux);
+            if (timeout_ms == UINT_MAX)
+                m_cv.wait(lock, [&]() { return m_done; });
+            else
+                m_cv.wait_for(lock, std::chrono::milliseconds(timeout_ms), [&]() { return m_done; });
+#endif
+            return m_done;
+        }
+
+        void join() {
+#ifndef SINGLE_THREAD
+            if (m_thread.joinable())
+                m_thread.join();
+#endif
+        }
+    };
+
+    Z3_solver_ref::Z3_solver_ref(api::context& c, solver_factory * f): 
+        api::object(c), m_solver_factory(f), m_solver(nullptr), m_logic(symbol::null), m_eh(nullptr) {}
+
+    Z3_solver_ref::Z3_solver_ref(api::context& c, solver * s): 
+        api::object(c), m_solver_factory(nullptr), m_solver(s), m_logic(symbol::null), m_eh(nullptr) {}
+
+    Z3_solver_ref::~Z3_solver_ref() {
+        if (m_async) {
+            set_cancel();
+            m_async->join();
+            set_eh(nullptr);
+        }
+    }
+
     void Z3_solver_ref::set_eh(event_handler* eh) {
         lock_guard lock(m_mux);
         m_eh = eh;
@@ -532,6 +588,23 @@ extern "C" {
         Z3_CATCH;
     }
 
+    void Z3_API Z3_solver_assert_vector(Z3_context c, Z3_solver s, Z3_ast_vector v) {
+        Z3_TRY;
+        LOG_Z3_solver_assert_vector(c, s, v);
+        RESET_ERROR_CODE();
+        init_solver(c, s);
+        ast_manager& m = mk_c(c)->m();
+        for (ast* a : to_ast_vector_ref(v)) {
+            if (!is_expr(a) || !m.is_bool(to_expr(a))) {
+                SET_ERROR_CODE(Z3_SORT_ERROR, "not a Boolean expression");
+                return;
+            }
+        }
+        for (ast* a : to_ast_vector_ref(v))
+            to_solver(s)->assert_expr(to_expr(a));
+        Z3_CATCH;
+    }
+
     void Z3_API Z3_solver_assert_and_track(Z3_context c, Z3_solver s, Z3_ast a, Z3_ast p) {
         Z3_TRY;
         LOG_Z3_solver_assert_and_track(c, s, a, p);
@@ -613,6 +686,41 @@ extern "C" {
         Z3_CATCH;
     }
 
+    unsigned Z3_API Z3_solver_export_lemmas(Z3_context c, Z3_solver s, Z3_ast_vector lemmas, unsigned sz, unsigned glue[]) {
+        Z3_TRY;
+        LOG_Z3_solver_export_lemmas(c, s, lemmas, sz, glue);
+        RESET_ERROR_CODE();
+        init_solver(c, s);
+        expr_ref_vector _lemmas(mk_c(c)->m());
+        unsigned_vector _glue;
+        to_solver_ref(s)->export_lemmas(sz, _lemmas, _glue);
+        for (unsigned i = 0; i < _lemmas.size(); ++i) {
+            to_ast_vector_ref(lemmas).push_back(_lemmas.get(i));
+            glue[i] = _glue[i];
+        }
+        return _lemmas.size();
+        Z3_CATCH_RETURN(0);
+    }
+
+    void Z3_API Z3_solver_import_lemmas(Z3_context c, Z3_solver s, Z3_ast_vector lemmas, unsigned sz, unsigned const glue[]) {
+        Z3_TRY;
+        LOG_Z3_solver_import_lemmas(c, s, lemmas, sz, glue);
+        RESET_ERROR_CODE();
+        init_solver(c, s);
+        if (sz != Z3_ast_vector_size(c, lemmas)) {
+            SET_ERROR_CODE(Z3_IOB, nullptr);
+            return;
+        }
+        expr_ref_vector _lemmas(mk_c(c)->m());
+        unsigned_vector _glue;
+        for (unsigned i = 0; i < sz; ++i) {
+            _lemmas.push_back(to_expr(Z3_ast_vector_get(c, lemmas, i)));
+            _glue.push_back(glue[i]);
+        }
+        to_solver_ref(s)->import_lemmas(_lemmas, _glue);
+        Z3_CATCH;
+    }
+
     Z3_ast_vector Z3_API Z3_solver_get_trail(Z3_context c, Z3_solver s) {
         Z3_TRY;
         LOG_Z3_solver_get_trail(c, s);
@@ -693,6 +801,102 @@ extern "C" {
         Z3_CATCH_RETURN(Z3_L_UNDEF);
     }
     
+    /**
+       \brief body of an asynchronous check. It does not report errors to the
+       context, since the error handler must be invoked from the caller's thread.
+    */
+    static void _solver_check_async(api::context* c, Z3_solver_ref* s, Z3_solver_ref::async_check* _st, unsigned timeout, unsigned rlimit) {
+        auto& st = *_st;
+        lbool result = l_undef;
+        {
+            scoped_timer timer(timeout, &st.m_eh);
+            scoped_rlimit _rlimit(c->m().limit(), rlimit);
+            try {
+                result = s->m_solver->check_sat(st.m_assumptions.size(), st.m_assumptions.data());
+            }
+            catch (z3_exception & ex) {
+                if (c->m().inc())
+                    st.m_error = ex.msg();
+            }
+            catch (...) {
+            }
+        }
+        if (result == l_undef)
+            s->m_solver->set_reason_unknown(st.m_eh);
+#ifndef SINGLE_THREAD
+        std::lock_guard<std::mutex> lock(st.m_mux);
+#endif
+        st.m_result = result;
+        st.m_done = true;
+#ifndef SINGLE_THREAD
+        st.m_cv.notify_all();
+#endif
+    }
+
+    void Z3_API Z3_solver_check_async(Z3_context c, Z3_solver s, unsigned num_assumptions, Z3_ast const assumptions[]) {
+        Z3_TRY;
+        LOG_Z3_solver_check_async(c, s, num_assumptions, assumptions);
+        RESET_ERROR_CODE();
+        init_solver(c, s);
+        if (to_solver(s)->m_async) {
+            SET_ERROR_CODE(Z3_INVALID_USAGE, "an asynchronous check is already running on the solver");
+            return;
+        }
+        for (unsigned i = 0; i < num_assumptions; i++) {
+            if (!is_expr(to_ast(assumptions[i]))) {
+                SET_ERROR_CODE(Z3_INVALID_ARG, "assumption is not an expression");
+                return;
+            }
+        }
+        solver_params sp(to_solver(s)->m_params);
+        unsigned timeout     = mk_c(c)->get_timeout();
+        timeout              = to_solver(s)->m_params.get_uint("timeout", timeout);
+        timeout              = sp.timeout() != UINT_MAX ? sp.timeout() : timeout;
+        unsigned rlimit      = to_solver(s)->m_params.get_uint("rlimit", mk_c(c)->get_rlimit());
+        if (to_solver(s)->m_pp) to_solver(s)->m_pp->check(num_assumptions, to_exprs(num_assumptions, assumptions));
+        auto* st = alloc(Z3_solver_ref::async_check, *mk_c(c));
+        st->m_assumptions.append(num_assumptions, to_exprs(num_assumptions, assumptions));
+        to_solver(s)->m_async = st;
+        to_solver(s)->set_eh(&st->m_eh);
+#ifdef SINGLE_THREAD
+        _solver_check_async(mk_c(c), to_solver(s), st, timeout, rlimit);
+#else
+        st->m_thread = std::thread(_solver_check_async, mk_c(c), to_solver(s), st, timeout, rlimit);
+#endif
+        Z3_CATCH;
+    }
+
+    bool Z3_API Z3_solver_check_async_wait(Z3_context c, Z3_solver s, unsigned timeout_ms) {
+        Z3_TRY;
+        LOG_Z3_solver_check_async_wait(c, s, timeout_ms);
+        RESET_ERROR_CODE();
+        if (!to_solver(s)->m_async) {
+            SET_ERROR_CODE(Z3_INVALID_USAGE, "there is no asynchronous check");
+            return true;
+        }
+        return to_solver(s)->m_async->wait(timeout_ms);
+        Z3_CATCH_RETURN(true);
+    }
+
+    Z3_lbool Z3_API Z3_solver_check_async_result(Z3_context c, Z3_solver s) {
+        Z3_TRY;
+        LOG_Z3_solver_check_async_result(c, s);
+        RESET_ERROR_CODE();
+        if (!to_solver(s)->m_async) {
+            SET_ERROR_CODE(Z3_INVALID_USAGE, "there is no asynchronous check");
+            return Z3_L_UNDEF;
+        }
+        scoped_ptr<Z3_solver_ref::async_check> st = to_solver(s)->m_async.detach();
+        st->join();
+        to_solver(s)->set_eh(nullptr);
+        if (!st->m_error.empty()) {
+            SET_ERROR_CODE(Z3_EXCEPTION, st->m_error.c_str());
+            return Z3_L_UNDEF;
+        }
+        return static_cast<Z3_lbool>(st->m_result);
+        Z3_CATCH_RETURN(Z3_L_UNDEF);
+    }
+
     Z3_model Z3_API Z3_solver_get_model(Z3_context c, Z3_solver s) {
         Z3_TRY;
         LOG_Z3_solver_get_model(c, s);
@@ -1077,6 +1281,17 @@ extern "C" {
         Z3_CATCH;        
     }
 
+    void Z3_API Z3_solver_propagate_batch(
+        Z3_context  c, 
+        Z3_solver   s,
+        Z3_batch_eh batch_eh) {
+        Z3_TRY;
+        RESET_ERROR_CODE();
+        user_propagator::batch_eh_t _batch = (void(*)(void*,user_propagator::callback*,unsigned,expr* const*,expr* const*,unsigned,expr* const*,expr* const*))batch_eh;
+        to_solver_ref(s)->user_propagate_register_batch(_batch);
+        Z3_CATCH;        
+    }
+
     void Z3_API Z3_solver_propagate_register(Z3_context c, Z3_solver s, Z3_ast e) {
         Z3_TRY;
         LOG_Z3_solver_propagate_register(c, s, e);
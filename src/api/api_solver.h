@@ -49,14 +49,18 @@ struct Z3_solver_ref : public api::object {
     mutex                      m_mux;
     event_handler*             m_eh;
 
-    Z3_solver_ref(api::context& c, solver_factory * f): 
-        api::object(c), m_solver_factory(f), m_solver(nullptr), m_logic(symbol::null), m_eh(nullptr) {}
+    // state of a check started with Z3_solver_check_async.
+    struct async_check;
+    scoped_ptr<async_check>    m_async;
 
-    Z3_solver_ref(api::context& c, solver * s): 
-        api::object(c), m_solver_factory(nullptr), m_solver(s), m_logic(symbol::null), m_eh(nullptr) {}
+    Z3_solver_ref(api::context& c, solver_factory * f);
+    Z3_solver_ref(api::context& c, solver * s);
 
     void assert_expr(expr* e);
     void assert_expr(expr* e, expr* t);
+
+    ~Z3_solver_ref() override;
+
     void set_eh(event_handler* eh);
     void set_cancel();
 
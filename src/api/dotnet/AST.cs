@@ -217,13 +217,7 @@ namespace Microsoft.Z3
         internal override void DecRef(IntPtr o)
         {
             if (Context != null && o != IntPtr.Zero)
-            {
-                lock (Context)
-                {
-                    if (Context.nCtx != IntPtr.Zero)
-                        Native.Z3_dec_ref(Context.nCtx, o);
-                }
-            }
+                Context.DecRefAST(o);
         }
 
         internal static AST Create(Context ctx, IntPtr obj)
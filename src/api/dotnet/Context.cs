@@ -4901,6 +4901,30 @@ namespace Microsoft.Z3
         internal static Object creation_lock = new Object();
         internal IntPtr nCtx { get { return m_ctx; } }
 
+        // ASTs released by finalizers are collected and released with one call to Z3_dec_ref_array.
+        private readonly List<IntPtr> m_pendingDecRefs = new List<IntPtr>();
+        private const int DecRefBatchSize = 64;
+
+        internal void DecRefAST(IntPtr o)
+        {
+            lock (this)
+            {
+                if (m_ctx == IntPtr.Zero)
+                    return;
+                m_pendingDecRefs.Add(o);
+                if (m_pendingDecRefs.Count >= DecRefBatchSize)
+                    FlushDecRefs();
+            }
+        }
+
+        private void FlushDecRefs()
+        {
+            if (m_pendingDecRefs.Count == 0)
+                return;
+            Native.Z3_dec_ref_array(m_ctx, (uint)m_pendingDecRefs.Count, m_pendingDecRefs.ToArray());
+            m_pendingDecRefs.Clear();
+        }
+
         internal void NativeErrorHandler(IntPtr ctx, Z3_error_code errorCode)
         {
             // Do-nothing error handler. The wrappers in Z3.Native will throw exceptions upon errors.
@@ -5003,6 +5027,8 @@ namespace Microsoft.Z3
                 IntPtr ctx = m_ctx;
                 lock (this)
                 {
+                    // the pending ASTs are deleted together with the context
+                    m_pendingDecRefs.Clear();
                     m_n_err_handler = null;
                     m_ctx = IntPtr.Zero;
                 }
@@ -230,5 +230,10 @@ public class AST extends Z3Object implements Comparable<AST>
         void decRef(Context ctx, long z3Obj) {
             Native.decRef(ctx.nCtx(), z3Obj);
         }
+
+        @Override
+        boolean isAST() {
+            return true;
+        }
     }
 }
@@ -22,6 +22,10 @@ import com.microsoft.z3.enumerations.Z3_lbool;
 
 import java.lang.ref.ReferenceQueue;
 import java.util.*;
+import java.util.concurrent.CompletableFuture;
+import java.util.concurrent.Executors;
+import java.util.concurrent.ScheduledExecutorService;
+import java.util.concurrent.TimeUnit;
 
 /**
  * Solvers.
@@ -260,6 +264,51 @@ public class Solver extends Z3Object {
         return check((Expr[]) null);
     }
 
+    /**
+     * Checks the consistency of the assertions in the solver on a separate
+     * thread and returns a future for the result.
+     * Remarks: Until the future is completed, the context of the solver must
+     * not be used otherwise. Cancelling the future interrupts the check.
+     * @see #check
+     **/
+    @SafeVarargs
+    public final CompletableFuture<Status> checkAsync(Expr<BoolSort>... assumptions)
+    {
+        int n = assumptions == null ? 0 : assumptions.length;
+        long[] asms = assumptions == null ? new long[0] : AST.arrayToNative(assumptions);
+        Native.solverCheckAsync(getContext().nCtx(), getNativeObject(), n, asms);
+        CompletableFuture<Status> result = new CompletableFuture<>();
+        pollAsync(result);
+        return result;
+    }
+
+    // polls running asynchronous checks, so that no thread is blocked per check.
+    private static final ScheduledExecutorService asyncPoller =
+        Executors.newSingleThreadScheduledExecutor(r -> {
+            Thread t = new Thread(r, "z3-check-async");
+            t.setDaemon(true);
+            return t;
+        });
+
+    private void pollAsync(CompletableFuture<Status> result)
+    {
+        asyncPoller.schedule(() -> {
+            try {
+                if (result.isCancelled())
+                    interrupt();
+                if (!Native.solverCheckAsyncWait(getContext().nCtx(), getNativeObject(), 0)) {
+                    pollAsync(result);
+                    return;
+                }
+                Z3_lbool r = Z3_lbool.fromInt(Native.solverCheckAsyncResult(getContext().nCtx(), getNativeObject()));
+                result.complete(lboolToStatus(r));
+            }
+            catch (Z3Exception e) {
+                result.completeExceptionally(e);
+            }
+        }, 10, TimeUnit.MILLISECONDS);
+    }
+
     /**
      * Retrieve fixed assignments to the set of variables in the form of consequences.
      * Each consequence is an implication of the form 
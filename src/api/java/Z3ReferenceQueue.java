@@ -40,6 +40,7 @@ class Z3ReferenceQueue {
     private final Context ctx;
     private final ReferenceQueue<Z3Object> referenceQueue = new ReferenceQueue<>();
     private final Reference<?> referenceList = emptyList();
+    private final long[] astBuffer = new long[64];
 
     Z3ReferenceQueue(Context ctx) {
         this.ctx = ctx;
@@ -58,9 +59,33 @@ class Z3ReferenceQueue {
      */
     private void clear() {
         Reference<?> ref;
+        int n = 0;
         while ((ref = (Reference<?>)referenceQueue.poll()) != null) {
-            ref.cleanup(ctx);
+            if (ref.isAST()) {
+                n = addAST(n, ref.nativePtr);
+                ref.unlink();
+            }
+            else
+                ref.cleanup(ctx);
         }
+        flushASTs(n);
+    }
+
+    /**
+     * Queue an AST for release; ASTs are released in batches with a single call to {@code Native.decRefArray}.
+     */
+    private int addAST(int n, long ptr) {
+        if (n == astBuffer.length) {
+            flushASTs(n);
+            n = 0;
+        }
+        astBuffer[n] = ptr;
+        return n + 1;
+    }
+
+    private void flushASTs(int n) {
+        if (n > 0)
+            Native.decRefArray(ctx.nCtx(), n, astBuffer);
     }
 
     /**
@@ -71,10 +96,15 @@ class Z3ReferenceQueue {
     public void forceClear() {
         // Decrement all reference counters
         Reference<?> cur = referenceList.next;
+        int n = 0;
         while (cur.next != null) {
-            cur.decRef(ctx, cur.nativePtr);
+            if (cur.isAST())
+                n = addAST(n, cur.nativePtr);
+            else
+                cur.decRef(ctx, cur.nativePtr);
             cur = cur.next;
         }
+        flushASTs(n);
 
         // Bulk-delete the reference list's entries
         referenceList.next = cur;
@@ -113,6 +143,10 @@ class Z3ReferenceQueue {
 
         private void cleanup(Context ctx) {
             decRef(ctx, nativePtr);
+            unlink();
+        }
+
+        private void unlink() {
             assert (prev != null && next != null);
             prev.next = next;
             next.prev = prev;
@@ -127,6 +161,13 @@ class Z3ReferenceQueue {
         }
 
         abstract void decRef(Context ctx, long z3Obj);
+
+        /**
+         * ASTs are released together by {@code Native.decRefArray} instead of {@link #decRef}.
+         */
+        boolean isAST() {
+            return false;
+        }
     }
 
     private static class DummyReference extends Reference<Z3Object> {
@@ -10,12 +10,18 @@ import { functions } from './parse-api';
 
 console.log('--- Building WASM');
 
+// Number of worker threads available to parallel solving (sat.threads, smt.threads, parallel tactic).
+// Emscripten preallocates the workers, two more are used by the async call itself and by timers.
+const numThreads = parseInt(process.env.Z3_WASM_THREADS ?? '4', 10);
+assert(numThreads > 0, 'Z3_WASM_THREADS must be a positive number');
+const poolSize = numThreads + 2;
+
 const SWAP_OPTS: SpawnOptions = {
   shell: true,
   stdio: 'inherit',
   env: {
     ...process.env,
-    CXXFLAGS: '-pthread -s USE_PTHREADS=1 -s DISABLE_EXCEPTION_CATCHING=0',
+    CXXFLAGS: `-pthread -s USE_PTHREADS=1 -s DISABLE_EXCEPTION_CATCHING=0 -DZ3_WASM_THREADS=${numThreads}`,
     LDFLAGS: '-s WASM_BIGINT -s -pthread -s USE_PTHREADS=1',
     FPMATH_ENABLED: 'False', // Until Safari supports WASM SSE, we have to disable fast FP support
     // TODO(ritave): Setting EM_CACHE breaks compiling on M1 MacBook
@@ -52,8 +58,15 @@ assert(fs.existsSync('./package.json'), 'Not in the root directory of js api');
 const z3RootDir = path.join(process.cwd(), '../../../');
 
 // TODO(ritave): Detect if it's in the configuration we need
-if (!existsSync(path.join(z3RootDir, 'build/Makefile'))) {
-  spawnSync('emconfigure python scripts/mk_make.py --staticlib --single-threaded --arm64=false', {
+// builds configured with --single-threaded, or for another number of threads, are configured again
+const configPath = path.join(z3RootDir, 'build/config.mk');
+if (
+  !existsSync(path.join(z3RootDir, 'build/Makefile')) ||
+  !existsSync(configPath) ||
+  fs.readFileSync(configPath, 'utf8').includes('SINGLE_THREAD') ||
+  !fs.readFileSync(configPath, 'utf8').includes(`-DZ3_WASM_THREADS=${numThreads}`)
+) {
+  spawnSync('emconfigure python scripts/mk_make.py --staticlib --arm64=false', {
     cwd: z3RootDir,
   });
 }
@@ -69,7 +82,7 @@ const fns = JSON.stringify(exportedFuncs());
 const methods = '["ccall","FS","allocate","UTF8ToString","intArrayFromString","ALLOC_NORMAL"]';
 const libz3a = path.normalize('../../../build/libz3.a');
 spawnSync(
-  `emcc build/async-fns.cc ${libz3a} --std=c++20 --pre-js src/low-level/async-wrapper.js -g2 -pthread -fexceptions -s WASM_BIGINT -s USE_PTHREADS=1 -s PTHREAD_POOL_SIZE=0 -s PTHREAD_POOL_SIZE_STRICT=0 -s MODULARIZE=1 -s 'EXPORT_NAME="initZ3"' -s EXPORTED_RUNTIME_METHODS=${methods} -s EXPORTED_FUNCTIONS=${fns} -s DISABLE_EXCEPTION_CATCHING=0 -s SAFE_HEAP=0 -s DEMANGLE_SUPPORT=1 -s TOTAL_MEMORY=1GB -s TOTAL_STACK=20MB -I z3/src/api/ -o build/z3-built.js`,
+  `emcc build/async-fns.cc ${libz3a} --std=c++20 --pre-js src/low-level/async-wrapper.js -g2 -pthread -fexceptions -s WASM_BIGINT -s USE_PTHREADS=1 -s PTHREAD_POOL_SIZE=${poolSize} -s PTHREAD_POOL_SIZE_STRICT=0 -s MODULARIZE=1 -s 'EXPORT_NAME="initZ3"' -s EXPORTED_RUNTIME_METHODS=${methods} -s EXPORTED_FUNCTIONS=${fns} -s DISABLE_EXCEPTION_CATCHING=0 -s SAFE_HEAP=0 -s DEMANGLE_SUPPORT=1 -s TOTAL_MEMORY=1GB -s TOTAL_STACK=20MB -I z3/src/api/ -o build/z3-built.js`,
 );
 
 fs.rmSync(ccWrapperPath);
@@ -5942,21 +5942,31 @@ class AstVector(Z3PPObject):
         """
 
         if isinstance(i, int):
+            sz = self.__len__()
             if i < 0:
-                i += self.__len__()
+                i += sz
 
-            if i >= self.__len__():
+            if i < 0 or i >= sz:
                 raise IndexError
             return _to_ast_ref(Z3_ast_vector_get(self.ctx.ref(), self.vector, i), self.ctx)
 
         elif isinstance(i, slice):
-            result = []
-            for ii in range(*i.indices(self.__len__())):
-                result.append(_to_ast_ref(
-                    Z3_ast_vector_get(self.ctx.ref(), self.vector, ii),
-                    self.ctx,
-                ))
-            return result
+            ctx_ref = self.ctx.ref()
+            return [_to_ast_ref(Z3_ast_vector_get(ctx_ref, self.vector, ii), self.ctx)
+                    for ii in range(*i.indices(self.__len__()))]
+
+    def __iter__(self):
+        """Iterate over the ASTs of the vector; the size is read only once.
+
+        >>> A = AstVector()
+        >>> A.push(Int('x'))
+        >>> A.push(Int('y'))
+        >>> [a for a in A]
+        [x, y]
+        """
+        ctx_ref = self.ctx.ref()
+        for i in range(self.__len__()):
+            yield _to_ast_ref(Z3_ast_vector_get(ctx_ref, self.vector, i), self.ctx)
 
     def __setitem__(self, i, v):
         """Update AST at position `i`.
@@ -6487,6 +6497,33 @@ class ModelRef(Z3PPObject):
         """
         return self.eval(t, model_completion)
 
+    def eval_values(self, terms, model_completion=False, as_double=False, as_buffer=False):
+        """Evaluate a list of integer, bit-vector, Boolean or (with `as_double`)
+        real and floating-point terms, and return their values as Python ints
+        or floats, using one call into Z3. Values are read as 64-bit signed
+        integers, so bit-vectors of more than 63 bits may wrap around; terms
+        whose value cannot be converted yield 0.
+
+        With `as_buffer`, the values are returned without conversion as a
+        `memoryview` of format 'q' or 'd', which supports the buffer protocol,
+        e.g. `numpy.frombuffer(m.eval_values(xs, as_buffer=True), dtype=numpy.int64)`.
+
+        >>> x, y = Ints('x y')
+        >>> s = Solver()
+        >>> s.add(x == 3, y == -2)
+        >>> s.check()
+        sat
+        >>> s.model().eval_values([x, y, x + y])
+        [3, -2, 1]
+        """
+        _terms, n = _to_ast_array(terms)
+        words = (ctypes.c_uint * (2 * n))()
+        Z3_model_eval_values(self.ctx.ref(), self.model, n, _terms, model_completion, as_double, 2 * n, words)
+        if as_buffer:
+            return memoryview(words).cast("B").cast("d" if as_double else "q")
+        values = ctypes.cast(words, ctypes.POINTER(ctypes.c_double if as_double else ctypes.c_int64))
+        return [values[i] for i in range(n)]
+
     def __len__(self):
         """Return the number of constant and function declarations in the model `self`.
 
@@ -6940,6 +6977,57 @@ unsat = CheckSatResult(Z3_L_FALSE)
 unknown = CheckSatResult(Z3_L_UNDEF)
 
 
+class CheckSatFuture:
+    """Handle for a satisfiability check started with `Solver.check_async()`.
+
+    The check runs on a separate thread. Until its result is retrieved,
+    the context of the solver must only be used to poll, wait for or
+    interrupt the check.
+    """
+
+    def __init__(self, solver):
+        self.solver = solver
+        self._result = None
+
+    def done(self):
+        """Return `True` if the check has finished."""
+        return self.wait(0)
+
+    def wait(self, timeout=None):
+        """Wait at most `timeout` seconds for the check to finish, or until
+        it finishes if `timeout` is `None`. Return `True` if it finished."""
+        if self._result is not None:
+            return True
+        ms = 4294967295 if timeout is None else max(0, int(timeout * 1000))
+        return Z3_solver_check_async_wait(self.solver.ctx.ref(), self.solver.solver, ms)
+
+    def cancel(self):
+        """Interrupt the check. The result is then `unknown`."""
+        if self._result is None:
+            self.solver.interrupt()
+
+    def result(self, timeout=None):
+        """Return the result of the check, waiting for it as `wait()` does.
+        Raise `Z3Exception` if the check did not finish in time."""
+        if self._result is None:
+            if not self.wait(timeout):
+                raise Z3Exception("check did not finish")
+            r = Z3_solver_check_async_result(self.solver.ctx.ref(), self.solver.solver)
+            self._result = CheckSatResult(r)
+        return self._result
+
+    async def result_async(self, poll_interval=0.01):
+        """Awaitable result for use in asyncio event loops; the check is polled
+        every `poll_interval` seconds, without blocking the loop."""
+        import asyncio
+        while not self.done():
+            await asyncio.sleep(poll_interval)
+        return self.result()
+
+    def __await__(self):
+        return self.result_async().__await__()
+
+
 class Solver(Z3PPObject):
     """
     Solver API provides methods for implementing the main SMT 2.0 commands:
@@ -7071,7 +7159,9 @@ class Solver(Z3PPObject):
         args = _get_args(args)
         s = BoolSort(self.ctx)
         for arg in args:
-            if isinstance(arg, Goal) or isinstance(arg, AstVector):
+            if isinstance(arg, AstVector):
+                Z3_solver_assert_vector(self.ctx.ref(), self.solver, arg.vector)
+            elif isinstance(arg, Goal):
                 for f in arg:
                     Z3_solver_assert(self.ctx.ref(), self.solver, f.as_ast())
             else:
@@ -7174,6 +7264,28 @@ class Solver(Z3PPObject):
         r = Z3_solver_check_assumptions(self.ctx.ref(), self.solver, num, _assumptions)
         return CheckSatResult(r)
 
+    def check_async(self, *assumptions):
+        """Start checking the assertions in the solver plus the optional assumptions
+        on a separate thread, and return a `CheckSatFuture` for the result.
+
+        >>> x = Int('x')
+        >>> s = Solver()
+        >>> s.add(x > 0, x < 2)
+        >>> f = s.check_async()
+        >>> f.result()
+        sat
+        >>> s.model().eval(x)
+        1
+        """
+        s = BoolSort(self.ctx)
+        assumptions = _get_args(assumptions)
+        num = len(assumptions)
+        _assumptions = (Ast * num)()
+        for i in range(num):
+            _assumptions[i] = s.cast(assumptions[i]).as_ast()
+        Z3_solver_check_async(self.ctx.ref(), self.solver, num, _assumptions)
+        return CheckSatFuture(self)
+
     def model(self):
         """Return a model for the last `check()`.
 
@@ -7365,6 +7477,24 @@ class Solver(Z3PPObject):
         """
         return AstVector(Z3_solver_get_trail(self.ctx.ref(), self.solver), self.ctx)
 
+    def export_lemmas(self, max_num=10000):
+        """Return up to max_num clauses learned by the solver and their glue, lowest glue first.
+        """
+        lemmas = AstVector(None, self.ctx)
+        glue = (ctypes.c_uint * max_num)()
+        n = Z3_solver_export_lemmas(self.ctx.ref(), self.solver, lemmas.vector, max_num, glue)
+        return lemmas, [glue[i] for i in range(n)]
+
+    def import_lemmas(self, lemmas, glue):
+        """Add clauses implied by the assertions, such as those returned by export_lemmas
+        on a solver for a related problem, as learned clauses.
+        """
+        v = AstVector(None, self.ctx)
+        for lemma in lemmas:
+            v.push(lemma)
+        _glue = (ctypes.c_uint * len(v))(*glue)
+        Z3_solver_import_lemmas(self.ctx.ref(), self.solver, v.vector, len(v), _glue)
+
     def statistics(self):
         """Return statistics for the last `check()`.
 
@@ -9011,6 +9141,31 @@ def substitute_funs(t, *m):
     return _to_expr_ref(Z3_substitute_funs(t.ctx.ref(), t.as_ast(), num, _from, _to), t.ctx)
 
 
+def BuildDag(leaves, decls, code, roots, ctx=None):
+    """Create many function applications with a single call into Z3.
+
+    Nodes are numbered with the leaves first, followed by the applications
+    in `code`. An application is encoded as the index of its function in
+    `decls`, its number of arguments and the indices of its argument nodes.
+    Return an `AstVector` with the nodes listed in `roots`.
+
+    >>> x, y = Ints('x y')
+    >>> plus = (x + y).decl()
+    >>> le = (x <= y).decl()
+    >>> BuildDag([x, y], [plus, le], [0, 2, 0, 1,  1, 2, 2, 0], [3])
+    [x + y <= x]
+    """
+    ctx = _get_ctx(ctx)
+    _leaves, nl = _to_ast_array(leaves)
+    _decls = (FuncDecl * len(decls))()
+    for i, d in enumerate(decls):
+        _decls[i] = d.as_func_decl()
+    _code = (ctypes.c_uint * len(code))(*code)
+    _roots = (ctypes.c_uint * len(roots))(*roots)
+    v = Z3_mk_ast_dag(ctx.ref(), nl, _leaves, len(decls), _decls, len(code), _code, len(roots), _roots)
+    return AstVector(v, ctx)
+
+
 def Sum(*args):
     """Create the sum of the Z3 expressions.
 
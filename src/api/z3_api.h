@@ -1441,6 +1441,7 @@ Z3_DECLARE_CLOSURE(Z3_final_eh,   void, (void* ctx, Z3_solver_callback cb));
 Z3_DECLARE_CLOSURE(Z3_created_eh, void, (void* ctx, Z3_solver_callback cb, Z3_ast t));
 Z3_DECLARE_CLOSURE(Z3_decide_eh,  void, (void* ctx, Z3_solver_callback cb, Z3_ast t, unsigned idx, bool phase));
 Z3_DECLARE_CLOSURE(Z3_on_clause_eh, void, (void* ctx, Z3_ast proof_hint, unsigned n, unsigned const* deps, Z3_ast_vector literals));
+Z3_DECLARE_CLOSURE(Z3_batch_eh,   void, (void* ctx, Z3_solver_callback cb, unsigned num_fixed, Z3_ast const* fixed, Z3_ast const* values, unsigned num_eqs, Z3_ast const* lhs, Z3_ast const* rhs));
 
 
 /**
@@ -1651,6 +1652,38 @@ extern "C" {
     */
     void Z3_API Z3_del_context(Z3_context c);
 
+    /**
+       \brief Return the context to the state it had after creation, so that
+       it can be reused for another query without paying for the creation of
+       a context: the declaration plugins, the parameters of the context and
+       the memory pools are kept.
+
+       Terms, solvers and other objects retained only by the context are
+       released, errors and interrupts are cleared and the state of
+       #Z3_eval_smtlib2_string is discarded. Objects whose reference counters
+       were incremented by the user must be released before the reset.
+
+       \sa Z3_mk_context
+
+       def_API('Z3_context_reset', VOID, (_in(CONTEXT),))
+    */
+    void Z3_API Z3_context_reset(Z3_context c);
+
+    /**
+       \brief Create a context that shares the terms, sorts and declarations
+       of \c c. Terms of either context can be used in the other without
+       translation, while solvers, parameters, error codes and API objects
+       are separate. Creating a child context does not register declaration
+       plugins again.
+
+       The contexts share one term manager, so a child may not be used
+       concurrently with its parent or its siblings, and it must be deleted
+       with #Z3_del_context before its parent.
+
+       def_API('Z3_mk_child_context', CONTEXT, (_in(CONTEXT),))
+    */
+    Z3_context Z3_API Z3_mk_child_context(Z3_context c);
+
     /**
        \brief Increment the reference counter of the given AST.
        The context \c c should have been created using #Z3_mk_context_rc.
@@ -1669,6 +1702,16 @@ extern "C" {
     */
     void Z3_API Z3_dec_ref(Z3_context c, Z3_ast a);
 
+    /**
+       \brief Decrement the reference counters of the ASTs in \c a.
+       It has the same effect as calling #Z3_dec_ref on each element,
+       but avoids a call per AST when bindings release many ASTs at once.
+       Null entries are ignored.
+
+       def_API('Z3_dec_ref_array', VOID, (_in(CONTEXT), _in(UINT), _in_array(1, AST)))
+    */
+    void Z3_API Z3_dec_ref_array(Z3_context c, unsigned num, Z3_ast const a[]);
+
     /**
        \brief Set a value of a context parameter.
 
@@ -2256,6 +2299,34 @@ extern "C" {
         unsigned num_args,
         Z3_ast const args[]);
 
+    /**
+       \brief Create many function applications with one call.
+
+       The nodes of the DAG are numbered: the leaves come first, followed by
+       the applications described by \c code, in order. Each application is
+       encoded in \c code as the index of its function in \c decls, the
+       number of arguments, and the indices of the argument nodes, which must
+       precede it. Numerals, constants and bound variables are passed as
+       leaves.
+
+       For example, with leaves \c x and \c y and functions \c + and \c <=,
+       the code <tt>0 2 0 1  1 2 2 0</tt> creates <tt>x + y</tt> as node 2
+       and <tt>x + y <= x</tt> as node 3.
+
+       Return the nodes whose indices are listed in \c roots.
+
+       \sa Z3_mk_app
+       \sa Z3_solver_assert_vector
+
+       def_API('Z3_mk_ast_dag', AST_VECTOR, (_in(CONTEXT), _in(UINT), _in_array(1, AST), _in(UINT), _in_array(3, FUNC_DECL), _in(UINT), _in_array(5, UINT), _in(UINT), _in_array(7, UINT)))
+    */
+    Z3_ast_vector Z3_API Z3_mk_ast_dag(
+        Z3_context c,
+        unsigned num_leaves, Z3_ast const leaves[],
+        unsigned num_decls, Z3_func_decl const decls[],
+        unsigned code_size, unsigned const code[],
+        unsigned num_roots, unsigned const roots[]);
+
     /**
        \brief Declare and create a constant.
 
@@ -5489,6 +5560,28 @@ extern "C" {
     */
     bool Z3_API Z3_model_eval(Z3_context c, Z3_model m, Z3_ast t, bool model_completion, Z3_ast * v);
 
+    /**
+       \brief Evaluate many terms in the model and store their values as
+       machine words, without creating numerals or strings.
+
+       Each term receives <tt>num_words / num_terms</tt> consecutive 32-bit
+       words of \c words, least significant first. Integers are stored in
+       two's complement, bit-vectors as unsigned values and Booleans as 1 or 0;
+       an array of \c int64_t or \c uint64_t values can therefore be passed as
+       \c words with two words per term. If \c as_double is true, each term
+       uses two words holding an IEEE double: the value of an integer, real
+       or floating-point numeral, or 1 and 0 for Booleans.
+
+       The words of terms whose value is not a numeral of a suitable sort, or
+       does not fit, are set to 0. Return true if all terms were converted.
+
+       \sa Z3_model_eval
+
+       def_API('Z3_model_eval_values', BOOL, (_in(CONTEXT), _in(MODEL), _in(UINT), _in_array(2, AST), _in(BOOL), _in(BOOL), _in(UINT), _out_array(6, UINT)))
+    */
+    bool Z3_API Z3_model_eval_values(Z3_context c, Z3_model m, unsigned num_terms, Z3_ast const terms[],
+                                     bool model_completion, bool as_double, unsigned num_words, unsigned words[]);
+
     /**
        \brief Return the interpretation (i.e., assignment) of constant \c a in the model \c m.
        Return \c NULL, if the model does not assign an interpretation for \c a.
@@ -6981,6 +7074,17 @@ extern "C" {
     */
     void Z3_API Z3_solver_assert(Z3_context c, Z3_solver s, Z3_ast a);
 
+    /**
+       \brief Assert all formulas of the given vector into the solver.
+       Nothing is asserted if one of them is not a Boolean expression.
+
+       \sa Z3_solver_assert
+       \sa Z3_mk_ast_dag
+
+       def_API('Z3_solver_assert_vector', VOID, (_in(CONTEXT), _in(SOLVER), _in(AST_VECTOR)))
+    */
+    void Z3_API Z3_solver_assert_vector(Z3_context c, Z3_solver s, Z3_ast_vector v);
+
     /**
        \brief Assert a constraint \c a into the solver, and track it (in the unsat) core using
        the Boolean constant \c p.
@@ -7057,6 +7161,30 @@ extern "C" {
     */
     void Z3_API Z3_solver_get_levels(Z3_context c, Z3_solver s, Z3_ast_vector literals, unsigned sz,  unsigned levels[]);
 
+    /**
+       \brief Retrieve up to \c sz clauses learned by the solver, the ones with the lowest glue first.
+       The clauses are appended to \c lemmas and the glue (literal block distance) of the
+       i-th retrieved clause is stored in \c glue[i]. The function returns the number of retrieved clauses.
+       Only the SAT based solvers learn clauses, and clauses over auxiliary variables are not retrieved.
+
+       \sa Z3_solver_import_lemmas
+
+       def_API('Z3_solver_export_lemmas', UINT, (_in(CONTEXT), _in(SOLVER), _in(AST_VECTOR), _in(UINT), _out_array(3, UINT)))
+    */
+    unsigned Z3_API Z3_solver_export_lemmas(Z3_context c, Z3_solver s, Z3_ast_vector lemmas, unsigned sz, unsigned glue[]);
+
+    /**
+       \brief Add clauses retrieved with \c Z3_solver_export_lemmas, for example from a solver for
+       a related problem, as learned clauses of the solver.
+       The caller ensures that the lemmas are implied by the assertions of \c s.
+       Lemmas over atoms that the solver has not seen yet are ignored.
+
+       \sa Z3_solver_export_lemmas
+
+       def_API('Z3_solver_import_lemmas', VOID, (_in(CONTEXT), _in(SOLVER), _in(AST_VECTOR), _in(UINT), _in_array(3, UINT)))
+    */
+    void Z3_API Z3_solver_import_lemmas(Z3_context c, Z3_solver s, Z3_ast_vector lemmas, unsigned sz, unsigned const glue[]);
+
     /**
        \brief retrieve the congruence closure root of an expression.
        The root is retrieved relative to the state where the solver was in when it completed.
@@ -7159,6 +7287,21 @@ extern "C" {
     */
     void Z3_API Z3_solver_propagate_diseq(Z3_context c, Z3_solver s, Z3_eq_eh eq_eh);
 
+    /**
+       \brief register a callback that receives fixed values and equalities in batches.
+
+       Once it is registered, fixed values and equalities of registered expressions are no longer
+       passed to the callbacks of \ref Z3_solver_propagate_fixed and \ref Z3_solver_propagate_eq.
+       They are queued while the solver assigns literals and are delivered together in a single call
+       when the user propagator is scheduled to propagate.
+       The arrays \c fixed and \c values have \c num_fixed elements, \c lhs and \c rhs have \c num_eqs elements.
+       They are only valid during the callback.
+       Events that are undone by a conflict before they are delivered are not reported.
+
+       def_API('Z3_solver_propagate_batch', VOID, (_in(CONTEXT), _in(SOLVER), _fnptr(Z3_batch_eh)))
+    */
+    void Z3_API Z3_solver_propagate_batch(Z3_context c, Z3_solver s, Z3_batch_eh batch_eh);
+
     /**
        \brief register a callback when a new expression with a registered function is used by the solver 
        The registered function appears at the top level and is created using \ref Z3_solver_propagate_declare.
@@ -7287,6 +7430,46 @@ extern "C" {
     Z3_lbool Z3_API Z3_solver_check_assumptions(Z3_context c, Z3_solver s,
                                                 unsigned num_assumptions, Z3_ast const assumptions[]);
 
+    /**
+       \brief Start checking the assertions in the given solver, under the
+       given assumptions, on a separate thread and return immediately.
+
+       Use #Z3_solver_check_async_wait to poll or wait for the check to finish,
+       #Z3_solver_interrupt to cancel it and #Z3_solver_check_async_result to
+       retrieve its outcome. The result must be retrieved before another
+       check is started on the solver and before the solver is used otherwise.
+
+       The terms and solvers of a context are not thread-safe: while the check
+       runs, only #Z3_solver_check_async_wait, #Z3_solver_check_async_result,
+       #Z3_solver_interrupt and #Z3_interrupt may be called on the context.
+       Solvers in different contexts can be checked concurrently.
+
+       \sa Z3_solver_check_assumptions
+
+       def_API('Z3_solver_check_async', VOID, (_in(CONTEXT), _in(SOLVER), _in(UINT), _in_array(2, AST)))
+    */
+    void Z3_API Z3_solver_check_async(Z3_context c, Z3_solver s,
+                                      unsigned num_assumptions, Z3_ast const assumptions[]);
+
+    /**
+       \brief Wait at most \c timeout_ms milliseconds for the check started
+       with #Z3_solver_check_async to finish. A timeout of 0 polls, UINT_MAX
+       waits until the check finishes. Return true if the check finished.
+
+       def_API('Z3_solver_check_async_wait', BOOL, (_in(CONTEXT), _in(SOLVER), _in(UINT)))
+    */
+    bool Z3_API Z3_solver_check_async_wait(Z3_context c, Z3_solver s, unsigned timeout_ms);
+
+    /**
+       \brief Wait for the check started with #Z3_solver_check_async to finish
+       and return its result, as #Z3_solver_check_assumptions would.
+       Models, cores and the reason for unknown results are obtained from the
+       solver as usual afterwards.
+
+       def_API('Z3_solver_check_async_result', LBOOL, (_in(CONTEXT), _in(SOLVER)))
+    */
+    Z3_lbool Z3_API Z3_solver_check_async_result(Z3_context c, Z3_solver s);
+
     /**
        \brief Retrieve congruence class representatives for terms.
 
@@ -45,6 +45,10 @@ Notes:
   The cache maintains at most m_max_unused entries.
   When the maximum number of unused entries exceeds m_max_unused, then
   the cache will delete the oldest unused entry.
+
+  Most keys are cached with offset 0. As long as the ids of those keys
+  are dense enough, they are kept in an array indexed by the key id,
+  so lookups during rewriting do not probe the hash table.
 */
 
 /**
@@ -77,6 +81,65 @@ void act_cache::dec_refs() {
         m_manager.dec_ref(kv.m_key.first);
         m_manager.dec_ref(UNTAG(expr*, kv.m_value));
     }
+    for (unsigned i = 0; i < m_dense.size(); ++i) {
+        if (m_dense[i]) {
+            m_manager.dec_ref(m_dense_keys[i]);
+            m_manager.dec_ref(UNTAG(expr*, m_dense[i]));
+        }
+    }
+}
+
+/**
+   \brief Return a pointer to the (tagged) value stored for e, or nullptr if e is not in the cache.
+*/
+expr ** act_cache::find_slot(entry_t const& e) {
+    if (e.second == 0 && e.first->get_id() < m_dense.size()) {
+        expr ** r = m_dense.data() + e.first->get_id();
+        return *r ? r : nullptr;
+    }
+    map::key_value * entry = m_table.find_core(e);
+    return entry ? &entry->m_value : nullptr;
+}
+
+/**
+   \brief Extend m_dense to cover id, unless this would make it too sparse.
+   Entries with offset 0 that move into the range of m_dense are migrated
+   from the hash table.
+*/
+bool act_cache::try_grow_dense(unsigned id) {
+    unsigned old_sz = m_dense.size();
+    SASSERT(id >= old_sz);
+    unsigned new_sz = std::max(id + 1, 2 * old_sz);
+    if (new_sz > 4 * (size() + 1) + MIN_MAX_UNUSED)
+        return false;
+    m_dense.resize(new_sz, nullptr);
+    m_dense_keys.resize(new_sz, nullptr);
+    svector<entry_t> moved;
+    for (auto & kv : m_table) 
+        if (kv.m_key.second == 0 && kv.m_key.first->get_id() < new_sz)
+            moved.push_back(kv.m_key);
+    for (entry_t const& e : moved) {
+        expr * v = nullptr;
+        VERIFY(m_table.find(e, v));
+        m_table.erase(e);
+        unsigned i = e.first->get_id();
+        m_dense[i] = v;
+        m_dense_keys[i] = e.first;
+        m_num_dense++;
+    }
+    return true;
+}
+
+void act_cache::erase(entry_t const& e) {
+    if (e.second == 0 && e.first->get_id() < m_dense.size()) {
+        unsigned i = e.first->get_id();
+        m_dense[i] = nullptr;
+        m_dense_keys[i] = nullptr;
+        m_num_dense--;
+    }
+    else {
+        m_table.erase(e);
+    }
 }
 
 act_cache::act_cache(ast_manager & m):
@@ -103,17 +166,16 @@ act_cache::~act_cache() {
 void act_cache::del_unused() {
     unsigned sz = m_queue.size();
     while (m_qhead < sz) {
-        entry_t const& e = m_queue[m_qhead];
+        entry_t e = m_queue[m_qhead];
         m_qhead++;
-        SASSERT(m_table.contains(e));
-        map::key_value * entry = m_table.find_core(e);
-        SASSERT(entry);
-        if (GET_TAG(entry->m_value) == 0) {
+        expr ** slot = find_slot(e);
+        SASSERT(slot);
+        if (GET_TAG(*slot) == 0) {
             // Key k was never accessed by client code.
             // That is, find(k) was never executed by client code.
             m_unused--;
-            expr * v = entry->m_value;
-            m_table.erase(e);
+            expr * v = *slot;
+            erase(e);
             m_manager.dec_ref(e.first);
             m_manager.dec_ref(v);
             break;
@@ -139,7 +201,18 @@ void act_cache::insert(expr * k, unsigned offset, expr * v) {
     if (m_unused >= m_max_unused)
         del_unused();
     expr * dummy = reinterpret_cast<expr*>(1);
-    map::key_value & entry = m_table.insert_if_not_there(e, dummy);
+    expr ** slot = nullptr;
+    if (offset == 0 && (k->get_id() < m_dense.size() || try_grow_dense(k->get_id()))) {
+        unsigned i = k->get_id();
+        if (!m_dense[i]) {
+            m_dense[i] = dummy;
+            m_dense_keys[i] = k;
+            m_num_dense++;
+        }
+        slot = m_dense.data() + i;
+    }
+    else 
+        slot = &m_table.insert_if_not_there(e, dummy).m_value;
 #if 0
     unsigned static counter = 0;
     counter++;
@@ -150,33 +223,33 @@ void act_cache::insert(expr * k, unsigned offset, expr * v) {
 #ifdef Z3DEBUG
     unsigned expected_tag;
 #endif
-    if (entry.m_value == dummy) {
+    if (*slot == dummy) {
         // new entry;
         m_manager.inc_ref(k);
         m_manager.inc_ref(v);
-        entry.m_value = v;
+        *slot = v;
         m_queue.push_back(e);
         m_unused++;
         DEBUG_CODE(expected_tag = 0;); // new entry
     }
-    else if (UNTAG(expr*, entry.m_value) == v) {
+    else if (UNTAG(expr*, *slot) == v) {
         // already there
-        DEBUG_CODE(expected_tag = GET_TAG(entry.m_value);); 
+        DEBUG_CODE(expected_tag = GET_TAG(*slot);); 
     }
     else {
         // replacing old entry
         m_manager.inc_ref(v);
-        m_manager.dec_ref(UNTAG(expr*, entry.m_value));
-        entry.m_value = v;
-        SASSERT(GET_TAG(entry.m_value) == 0);
+        m_manager.dec_ref(UNTAG(expr*, *slot));
+        *slot = v;
+        SASSERT(GET_TAG(*slot) == 0);
         // replaced old entry, and reset the tag.
         DEBUG_CODE(expected_tag = 0;); 
     }
     DEBUG_CODE({
-        expr * v2;
-        SASSERT(m_table.find(e, v2));
-        SASSERT(v == UNTAG(expr*, v2));
-        SASSERT(expected_tag == GET_TAG(v2));
+        expr ** v2 = find_slot(e);
+        SASSERT(v2);
+        SASSERT(v == UNTAG(expr*, *v2));
+        SASSERT(expected_tag == GET_TAG(*v2));
     });
 }
 
@@ -185,27 +258,24 @@ void act_cache::insert(expr * k, unsigned offset, expr * v) {
    If entry k -> (v, tag) is found, we set tag to 1.
 */
 expr * act_cache::find(expr * k, unsigned offset) {
-    entry_t e(k, offset);
-    map::key_value * entry = m_table.find_core(e);
-    if (entry == nullptr)
+    expr ** slot = find_slot(entry_t(k, offset));
+    if (slot == nullptr)
         return nullptr;
-    if (GET_TAG(entry->m_value) == 0) {
-        entry->m_value = TAG(expr*, entry->m_value, 1);
-        SASSERT(GET_TAG(entry->m_value) == 1);
+    if (GET_TAG(*slot) == 0) {
+        *slot = TAG(expr*, *slot, 1);
+        SASSERT(GET_TAG(*slot) == 1);
         SASSERT(m_unused > 0);
         m_unused--;
-        DEBUG_CODE({
-            expr * v;
-            SASSERT(m_table.find(e, v));
-            SASSERT(GET_TAG(v) == 1);
-        });
     }
-    return UNTAG(expr*, entry->m_value);
+    return UNTAG(expr*, *slot);
 }
 
 void act_cache::reset() {
     dec_refs();
     m_table.reset();
+    m_dense.reset();
+    m_dense_keys.reset();
+    m_num_dense = 0;
     m_queue.reset();
     m_unused = 0;
     m_qhead = 0;
@@ -214,6 +284,9 @@ void act_cache::reset() {
 void act_cache::cleanup() {
     dec_refs();
     m_table.finalize();
+    m_dense.finalize();
+    m_dense_keys.finalize();
+    m_num_dense = 0;
     m_queue.finalize();
     m_unused = 0;
     m_qhead = 0;
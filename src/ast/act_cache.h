@@ -33,6 +33,11 @@ class act_cache {
     };
     typedef cmap<entry_t, expr*, entry_hash, default_eq<entry_t> > map;
     map                  m_table;
+    // entries with offset 0 whose key id is below m_dense.size() are
+    // stored in m_dense, indexed by the id of the key.
+    ptr_vector<expr>     m_dense;
+    ptr_vector<expr>     m_dense_keys;
+    unsigned             m_num_dense = 0;
     svector<entry_t>     m_queue; // recently created queue
     unsigned             m_qhead;
     unsigned             m_unused;
@@ -42,6 +47,9 @@ class act_cache {
     void init();
     void dec_refs();
     void del_unused();
+    expr ** find_slot(entry_t const& e);
+    bool try_grow_dense(unsigned id);
+    void erase(entry_t const& e);
 
 public:
     act_cache(ast_manager & m);
@@ -53,9 +61,9 @@ public:
     expr * find(expr * k, unsigned offset);
     void reset();
     void cleanup();
-    unsigned size() const { return m_table.size(); }
-    unsigned capacity() const { return m_table.capacity(); }
-    bool empty() const { return m_table.empty(); }
+    unsigned size() const { return m_table.size() + m_num_dense; }
+    unsigned capacity() const { return m_table.capacity() + m_dense.size(); }
+    bool empty() const { return size() == 0; }
     bool check_invariant() const;
     
 };
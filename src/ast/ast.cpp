@@ -1313,6 +1313,9 @@ ast_manager::ast_manager(ast_manager const & src, bool disable_proofs):
     init();
     copy_families_plugins(src);
     update_fresh_id(src);
+    // managers cloned from src are typically populated by translating
+    // the terms of src, so size the node table for them up front.
+    m_ast_table.reserve(src.m_ast_table.capacity());
 }
 
 void ast_manager::update_fresh_id(ast_manager const& m) {
@@ -1455,6 +1458,8 @@ ast_manager::~ast_manager() {
 
 void ast_manager::compact_memory() {
     m_alloc.consolidate();
+    m_expr_id_gen.compact();
+    m_decl_id_gen.compact();
     unsigned capacity = m_ast_table.capacity();
     if (capacity > 4*m_ast_table.size()) {
         ast_table new_ast_table;
@@ -2052,6 +2052,7 @@ public:
     void mk(expr_array & r) { m_expr_array_manager.mk(r); }
     void del(expr_array & r) { m_expr_array_manager.del(r); }
     void copy(expr_array const & s, expr_array & r) { m_expr_array_manager.copy(s, r); }
+    bool same(expr_array const & r1, expr_array const & r2) const { return m_expr_array_manager.same(r1, r2); }
     unsigned size(expr_array const & r) const { return m_expr_array_manager.size(r); }
     bool empty(expr_array const & r) const { return m_expr_array_manager.empty(r); }
     expr * get(expr_array const & r, unsigned i) const { return m_expr_array_manager.get(r, i); }
@@ -2483,6 +2484,7 @@ typedef app_ref_buffer                proof_ref_buffer;
 // -----------------------------------
 
 typedef obj_mark<expr> expr_mark;
+typedef obj_mark<expr, epoch_bit_vector> expr_epoch_mark;
 
 class expr_sparse_mark {
     obj_hashtable<expr> m_marked;
@@ -21,6 +21,8 @@ Revision History:
 #include "ast/ast_smt2_pp.h"
 #include "ast/ast_smt_pp.h"
 #include "ast/recfun_decl_plugin.h"
+#include "ast/for_each_expr.h"
+#include "ast/pp_params.hpp"
 
 void ast_pp_util::collect(expr* e) {
     coll.visit(e);
@@ -91,7 +93,7 @@ void ast_pp_util::remove_decl(func_decl* f) {
 }
 
 std::ostream& ast_pp_util::display_expr(std::ostream& out, expr* f, bool neat) {
-    if (neat) {
+    if (use_neat(f, neat)) {
         ast_smt2_pp(out, f, m_env);
     }
     else {
@@ -106,7 +108,7 @@ void ast_pp_util::display_assert(std::ostream& out, expr* f, bool neat) {
 }
 
 void ast_pp_util::display_assert_and_track(std::ostream& out, expr* f, expr* t, bool neat) {
-    if (neat) {
+    if (use_neat(f, neat)) {
         ast_smt2_pp(out << "(assert (=> ", t, m_env) << " ";
         ast_smt2_pp(out, f, m_env) << "))\n";
     }
@@ -117,22 +119,23 @@ void ast_pp_util::display_assert_and_track(std::ostream& out, expr* f, expr* t,
     }
 }
 
+ast_pp_util::ast_pp_util(ast_manager& m): m(m), m_env(m), m_rec_decls(0), m_decls(0), m_sorts(0), m_defined(m), coll(m) {
+    pp_params p;
+    m_max_neat_size = p.max_neat_size();
+}
+
+/**
+   \brief the layout based printer builds a format tree of the whole formula
+   before printing it. Large formulas are printed by the low level printer
+   that streams let-bindings directly to the output.
+*/
+bool ast_pp_util::use_neat(expr* f, bool neat) {
+    return neat && (m_max_neat_size == UINT_MAX || get_num_exprs(f) <= m_max_neat_size);
+}
+
 void ast_pp_util::display_asserts(std::ostream& out, expr_ref_vector const& fmls, bool neat) {
-    if (neat) {
-        for (expr* f : fmls) {
-            out << "(assert ";
-            ast_smt2_pp(out, f, m_env);
-            out << ")\n";
-        }
-    }
-    else {
-        ast_smt_pp ll_smt2_pp(m);
-        for (expr* f : fmls) {
-            out << "(assert ";
-            ll_smt2_pp.display_expr_smt2(out, f);
-            out << ")\n";
-        }
-    }
+    for (expr* f : fmls) 
+        display_assert(out, f, neat);
 }
 
 void ast_pp_util::push() {
@@ -33,12 +33,15 @@ class ast_pp_util {
     expr_mark               m_is_defined;
     expr_ref_vector         m_defined;
     unsigned_vector         m_defined_lim;
+    unsigned                m_max_neat_size;
+
+    bool use_neat(expr* f, bool neat);
 
  public:
 
     decl_collector      coll;
     
-    ast_pp_util(ast_manager& m): m(m), m_env(m), m_rec_decls(0), m_decls(0), m_sorts(0), m_defined(m), coll(m) {}
+    ast_pp_util(ast_manager& m);
 
     void reset();
 
@@ -0,0 +1,625 @@
+/*++
+Copyright (c) 2024 Microsoft Corporation
+
+Module Name:
+
+    ast_serialize.cpp
+
+Abstract:
+
+    Compact binary format for expressions.
+
+    Layout:
+
+        "Z3B1"  node* END_TAG  num_roots root*
+
+    Each node starts with a tag and refers to previously written
+    nodes by their position in the node sequence.
+
+--*/
+
+#include <cstring>
+#include "ast/ast_serialize.h"
+#include "util/obj_hashtable.h"
+#include "util/zstring.h"
+
+namespace {
+
+    static char const g_magic[4] = { 'Z', '3', 'B', '1' };
+
+    enum node_tag {
+        SORT_TAG = 0,
+        DECL_TAG,
+        APP_TAG,
+        VAR_TAG,
+        QUANTIFIER_TAG,
+        END_TAG
+    };
+
+    enum info_tag {
+        NO_INFO = 0,
+        USER_SORT_INFO,
+        BUILTIN_INFO
+    };
+
+    enum sort_size_tag {
+        FINITE_SIZE = 0,
+        VERY_BIG_SIZE,
+        INFINITE_SIZE
+    };
+
+    enum decl_flag {
+        LEFT_ASSOC_FLAG   = 1 << 0,
+        RIGHT_ASSOC_FLAG  = 1 << 1,
+        FLAT_ASSOC_FLAG   = 1 << 2,
+        COMMUTATIVE_FLAG  = 1 << 3,
+        CHAINABLE_FLAG    = 1 << 4,
+        PAIRWISE_FLAG     = 1 << 5,
+        INJECTIVE_FLAG    = 1 << 6,
+        IDEMPOTENT_FLAG   = 1 << 7,
+        SKOLEM_FLAG       = 1 << 8
+    };
+
+    enum symbol_tag {
+        NULL_SYMBOL = 0,
+        NUMERICAL_SYMBOL,
+        STRING_SYMBOL
+    };
+
+    // families whose sorts and declarations depend on definitions
+    // stored in the plugin. They cannot be rebuilt from the node alone.
+    static bool is_unsupported_family(ast_manager& m, family_id fid) {
+        symbol const& name = m.get_family_name(fid);
+        return name == "datatype" || name == "recfun";
+    }
+
+    class writer {
+        ast_manager&           m;
+        std::ostream&          m_out;
+        obj_map<ast, unsigned> m_ids;
+        ptr_vector<ast>        m_todo;
+
+        void write_byte(unsigned char b) { m_out.put(b); }
+
+        void write_uint(uint64_t n) {
+            do {
+                unsigned char b = n & 0x7f;
+                n >>= 7;
+                if (n != 0)
+                    b |= 0x80;
+                write_byte(b);
+            }
+            while (n != 0);
+        }
+
+        void write_int(int64_t n) {
+            // zig-zag encoding keeps small negative numbers short.
+            write_uint((static_cast<uint64_t>(n) << 1) ^ static_cast<uint64_t>(n >> 63));
+        }
+
+        void write_string(char const* s, size_t len) {
+            write_uint(len);
+            m_out.write(s, len);
+        }
+
+        void write_string(std::string const& s) { write_string(s.data(), s.size()); }
+
+        void write_symbol(symbol const& s) {
+            if (s.is_null())
+                write_byte(NULL_SYMBOL);
+            else if (s.is_numerical()) {
+                write_byte(NUMERICAL_SYMBOL);
+                write_uint(s.get_num());
+            }
+            else {
+                write_byte(STRING_SYMBOL);
+                write_string(s.bare_str(), strlen(s.bare_str()));
+            }
+        }
+
+        void write_ref(ast* a) { write_uint(m_ids[a]); }
+
+        void write_parameter(parameter const& p) {
+            write_byte(static_cast<unsigned char>(p.get_kind()));
+            switch (p.get_kind()) {
+            case parameter::PARAM_INT:
+                write_int(p.get_int());
+                break;
+            case parameter::PARAM_AST:
+                write_ref(p.get_ast());
+                break;
+            case parameter::PARAM_SYMBOL:
+                write_symbol(p.get_symbol());
+                break;
+            case parameter::PARAM_ZSTRING: {
+                zstring const& s = p.get_zstring();
+                write_uint(s.length());
+                for (unsigned i = 0; i < s.length(); ++i)
+                    write_uint(s[i]);
+                break;
+            }
+            case parameter::PARAM_RATIONAL:
+                write_string(p.get_rational().to_string());
+                break;
+            case parameter::PARAM_DOUBLE: {
+                double d = p.get_double();
+                uint64_t bits;
+                memcpy(&bits, &d, sizeof(d));
+                write_uint(bits);
+                break;
+            }
+            default:
+                throw default_exception("serialization of external parameters is not supported");
+            }
+        }
+
+        void write_parameters(decl_info const& info) {
+            write_uint(info.get_num_parameters());
+            for (parameter const& p : info.parameters())
+                write_parameter(p);
+        }
+
+        void write_family(family_id fid) {
+            if (is_unsupported_family(m, fid))
+                throw default_exception(std::string("serialization of ") + m.get_family_name(fid).str() + " terms is not supported");
+            write_symbol(m.get_family_name(fid));
+        }
+
+        void write_sort(sort* s) {
+            write_byte(SORT_TAG);
+            write_symbol(s->get_name());
+            sort_info* info = s->get_info();
+            if (!info) {
+                write_byte(NO_INFO);
+                return;
+            }
+            if (info->get_family_id() == m.get_user_sort_family_id()) {
+                write_byte(USER_SORT_INFO);
+                write_parameters(*info);
+                return;
+            }
+            write_byte(BUILTIN_INFO);
+            write_family(info->get_family_id());
+            write_uint(info->get_decl_kind());
+            sort_size const& sz = info->get_num_elements();
+            if (sz.is_finite()) {
+                write_byte(FINITE_SIZE);
+                write_uint(sz.size());
+            }
+            else
+                write_byte(sz.is_very_big() ? VERY_BIG_SIZE : INFINITE_SIZE);
+            write_byte(info->private_parameters());
+            write_parameters(*info);
+        }
+
+        void write_decl(func_decl* f) {
+            write_byte(DECL_TAG);
+            write_symbol(f->get_name());
+            write_uint(f->get_arity());
+            for (sort* s : *f)
+                write_ref(s);
+            write_ref(f->get_range());
+            func_decl_info* info = f->get_info();
+            if (!info) {
+                write_byte(NO_INFO);
+                return;
+            }
+            if (info->is_lambda() || info->is_polymorphic())
+                throw default_exception("serialization of lambda and polymorphic declarations is not supported");
+            write_byte(BUILTIN_INFO);
+            write_family(info->get_family_id());
+            write_uint(info->get_decl_kind());
+            unsigned flags = 0;
+            if (info->is_left_associative()) flags |= LEFT_ASSOC_FLAG;
+            if (info->is_right_associative()) flags |= RIGHT_ASSOC_FLAG;
+            if (info->is_flat_associative()) flags |= FLAT_ASSOC_FLAG;
+            if (info->is_commutative()) flags |= COMMUTATIVE_FLAG;
+            if (info->is_chainable()) flags |= CHAINABLE_FLAG;
+            if (info->is_pairwise()) flags |= PAIRWISE_FLAG;
+            if (info->is_injective()) flags |= INJECTIVE_FLAG;
+            if (info->is_idempotent()) flags |= IDEMPOTENT_FLAG;
+            if (info->is_skolem()) flags |= SKOLEM_FLAG;
+            write_uint(flags);
+            write_parameters(*info);
+        }
+
+        void write_node(ast* a) {
+            switch (a->get_kind()) {
+            case AST_SORT:
+                write_sort(to_sort(a));
+                break;
+            case AST_FUNC_DECL:
+                write_decl(to_func_decl(a));
+                break;
+            case AST_APP: {
+                app* e = to_app(a);
+                write_byte(APP_TAG);
+                write_ref(e->get_decl());
+                write_uint(e->get_num_args());
+                for (expr* arg : *e)
+                    write_ref(arg);
+                break;
+            }
+            case AST_VAR:
+                write_byte(VAR_TAG);
+                write_uint(to_var(a)->get_idx());
+                write_ref(to_var(a)->get_sort());
+                break;
+            case AST_QUANTIFIER: {
+                quantifier* q = to_quantifier(a);
+                write_byte(QUANTIFIER_TAG);
+                write_byte(static_cast<unsigned char>(q->get_kind()));
+                write_uint(q->get_num_decls());
+                for (unsigned i = 0; i < q->get_num_decls(); ++i) {
+                    write_symbol(q->get_decl_name(i));
+                    write_ref(q->get_decl_sort(i));
+                }
+                write_ref(q->get_expr());
+                write_int(q->get_weight());
+                write_symbol(q->get_qid());
+                write_symbol(q->get_skid());
+                write_uint(q->get_num_patterns());
+                for (unsigned i = 0; i < q->get_num_patterns(); ++i)
+                    write_ref(q->get_pattern(i));
+                write_uint(q->get_num_no_patterns());
+                for (unsigned i = 0; i < q->get_num_no_patterns(); ++i)
+                    write_ref(q->get_no_pattern(i));
+                break;
+            }
+            default:
+                UNREACHABLE();
+            }
+        }
+
+        void push_child(ast* a) {
+            if (!m_ids.contains(a))
+                m_todo.push_back(a);
+        }
+
+        void push_parameters(decl_info const* info) {
+            if (!info)
+                return;
+            for (parameter const& p : info->parameters())
+                if (p.is_ast())
+                    push_child(p.get_ast());
+        }
+
+        void push_children(ast* a) {
+            switch (a->get_kind()) {
+            case AST_SORT:
+                push_parameters(to_sort(a)->get_info());
+                break;
+            case AST_FUNC_DECL: {
+                func_decl* f = to_func_decl(a);
+                push_parameters(f->get_info());
+                for (sort* s : *f)
+                    push_child(s);
+                push_child(f->get_range());
+                break;
+            }
+            case AST_APP:
+                push_child(to_app(a)->get_decl());
+                for (expr* arg : *to_app(a))
+                    push_child(arg);
+                break;
+            case AST_VAR:
+                push_child(to_var(a)->get_sort());
+                break;
+            case AST_QUANTIFIER: {
+                quantifier* q = to_quantifier(a);
+                for (unsigned i = 0; i < q->get_num_decls(); ++i)
+                    push_child(q->get_decl_sort(i));
+                push_child(q->get_expr());
+                for (unsigned i = 0; i < q->get_num_patterns(); ++i)
+                    push_child(q->get_pattern(i));
+                for (unsigned i = 0; i < q->get_num_no_patterns(); ++i)
+                    push_child(q->get_no_pattern(i));
+                break;
+            }
+            default:
+                UNREACHABLE();
+            }
+        }
+
+        void visit(ast* root) {
+            push_child(root);
+            while (!m_todo.empty()) {
+                ast* a = m_todo.back();
+                if (m_ids.contains(a)) {
+                    m_todo.pop_back();
+                    continue;
+                }
+                unsigned sz = m_todo.size();
+                push_children(a);
+                if (sz < m_todo.size())
+                    continue;
+                m_todo.pop_back();
+                write_node(a);
+                m_ids.insert(a, m_ids.size());
+            }
+        }
+
+    public:
+        writer(ast_manager& m, std::ostream& out): m(m), m_out(out) {}
+
+        void operator()(expr_ref_vector const& fmls) {
+            m_out.write(g_magic, sizeof(g_magic));
+            for (expr* e : fmls)
+                visit(e);
+            write_byte(END_TAG);
+            write_uint(fmls.size());
+            for (expr* e : fmls)
+                write_ref(e);
+        }
+    };
+
+    class reader {
+        ast_manager&   m;
+        std::istream&  m_in;
+        ast_ref_vector m_nodes;
+
+        [[noreturn]] void fail(char const* msg) {
+            throw default_exception(std::string("invalid serialized expression: ") + msg);
+        }
+
+        unsigned char read_byte() {
+            int c = m_in.get();
+            if (c == std::char_traits<char>::eof())
+                fail("unexpected end of input");
+            return static_cast<unsigned char>(c);
+        }
+
+        uint64_t read_uint() {
+            uint64_t r = 0;
+            for (unsigned shift = 0; shift < 64; shift += 7) {
+                unsigned char b = read_byte();
+                r |= static_cast<uint64_t>(b & 0x7f) << shift;
+                if ((b & 0x80) == 0)
+                    return r;
+            }
+            fail("integer overflow");
+        }
+
+        unsigned read_unsigned() {
+            uint64_t r = read_uint();
+            if (r > UINT_MAX)
+                fail("integer overflow");
+            return static_cast<unsigned>(r);
+        }
+
+        int64_t read_int() {
+            uint64_t r = read_uint();
+            return static_cast<int64_t>(r >> 1) ^ -static_cast<int64_t>(r & 1);
+        }
+
+        std::string read_string() {
+            // the length is untrusted: read in chunks so that a corrupt length
+            // fails at the end of the input instead of allocating len bytes up front.
+            unsigned len = read_unsigned();
+            std::string s;
+            char buffer[4096];
+            while (len > 0) {
+                unsigned n = std::min(len, static_cast<unsigned>(sizeof(buffer)));
+                if (!m_in.read(buffer, n))
+                    fail("unexpected end of input");
+                s.append(buffer, n);
+                len -= n;
+            }
+            return s;
+        }
+
+        symbol read_symbol() {
+            switch (read_byte()) {
+            case NULL_SYMBOL: return symbol::null;
+            case NUMERICAL_SYMBOL: return symbol(read_unsigned());
+            case STRING_SYMBOL: return symbol(read_string());
+            default: fail("unknown symbol tag");
+            }
+        }
+
+        ast* read_ref() {
+            unsigned id = read_unsigned();
+            if (id >= m_nodes.size())
+                fail("reference to undefined node");
+            return m_nodes.get(id);
+        }
+
+        sort* read_sort_ref() {
+            ast* a = read_ref();
+            if (!is_sort(a))
+                fail("sort expected");
+            return to_sort(a);
+        }
+
+        expr* read_expr_ref() {
+            ast* a = read_ref();
+            if (!is_expr(a))
+                fail("expression expected");
+            return to_expr(a);
+        }
+
+        parameter read_parameter() {
+            switch (read_byte()) {
+            case parameter::PARAM_INT:
+                return parameter(static_cast<int>(read_int()));
+            case parameter::PARAM_AST:
+                return parameter(read_ref());
+            case parameter::PARAM_SYMBOL:
+                return parameter(read_symbol());
+            case parameter::PARAM_ZSTRING: {
+                unsigned len = read_unsigned();
+                unsigned_vector chars;
+                for (unsigned i = 0; i < len; ++i)
+                    chars.push_back(read_unsigned());
+                return parameter(zstring(chars.size(), chars.data()));
+            }
+            case parameter::PARAM_RATIONAL:
+                return parameter(rational(read_string().c_str()));
+            case parameter::PARAM_DOUBLE: {
+                uint64_t bits = read_uint();
+                double d;
+                memcpy(&d, &bits, sizeof(d));
+                return parameter(d);
+            }
+            default:
+                fail("unknown parameter kind");
+            }
+        }
+
+        void read_parameters(vector<parameter>& ps) {
+            unsigned n = read_unsigned();
+            for (unsigned i = 0; i < n; ++i)
+                ps.push_back(read_parameter());
+        }
+
+        family_id read_family() {
+            symbol name = read_symbol();
+            family_id fid = m.mk_family_id(name);
+            if (!m.has_plugin(fid))
+                throw default_exception(std::string("invalid serialized expression: theory ") + name.str() + " is not registered");
+            return fid;
+        }
+
+        sort* read_sort() {
+            symbol name = read_symbol();
+            vector<parameter> ps;
+            switch (read_byte()) {
+            case NO_INFO:
+                return m.mk_uninterpreted_sort(name);
+            case USER_SORT_INFO:
+                read_parameters(ps);
+                return m.mk_uninterpreted_sort(name, ps.size(), ps.data());
+            case BUILTIN_INFO: {
+                family_id fid = read_family();
+                decl_kind k = read_unsigned();
+                sort_size sz;
+                switch (read_byte()) {
+                case FINITE_SIZE: sz = sort_size::mk_finite(read_uint()); break;
+                case VERY_BIG_SIZE: sz = sort_size::mk_very_big(); break;
+                case INFINITE_SIZE: sz = sort_size::mk_infinite(); break;
+                default: fail("unknown sort size");
+                }
+                bool private_params = read_byte() != 0;
+                read_parameters(ps);
+                return m.mk_sort(name, sort_info(fid, k, sz, ps.size(), ps.data(), private_params));
+            }
+            default:
+                fail("unknown sort info");
+            }
+        }
+
+        func_decl* read_decl() {
+            symbol name = read_symbol();
+            unsigned arity = read_unsigned();
+            ptr_buffer<sort> domain;
+            for (unsigned i = 0; i < arity; ++i)
+                domain.push_back(read_sort_ref());
+            sort* range = read_sort_ref();
+            switch (read_byte()) {
+            case NO_INFO:
+                return m.mk_func_decl(name, arity, domain.data(), range);
+            case BUILTIN_INFO: {
+                family_id fid = read_family();
+                decl_kind k = read_unsigned();
+                unsigned flags = read_unsigned();
+                vector<parameter> ps;
+                read_parameters(ps);
+                func_decl_info info(fid, k, ps.size(), ps.data());
+                info.set_left_associative((flags & LEFT_ASSOC_FLAG) != 0);
+                info.set_right_associative((flags & RIGHT_ASSOC_FLAG) != 0);
+                info.set_flat_associative((flags & FLAT_ASSOC_FLAG) != 0);
+                info.set_commutative((flags & COMMUTATIVE_FLAG) != 0);
+                info.set_chainable((flags & CHAINABLE_FLAG) != 0);
+                info.set_pairwise((flags & PAIRWISE_FLAG) != 0);
+                info.set_injective((flags & INJECTIVE_FLAG) != 0);
+                info.set_idempotent((flags & IDEMPOTENT_FLAG) != 0);
+                info.set_skolem((flags & SKOLEM_FLAG) != 0);
+                return m.mk_func_decl(name, arity, domain.data(), range, info);
+            }
+            default:
+                fail("unknown declaration info");
+            }
+        }
+
+        app* read_app() {
+            ast* d = read_ref();
+            if (!is_func_decl(d))
+                fail("function declaration expected");
+            func_decl* f = to_func_decl(d);
+            unsigned n = read_unsigned();
+            ptr_buffer<expr> args;
+            for (unsigned i = 0; i < n; ++i)
+                args.push_back(read_expr_ref());
+            return m.mk_app(f, n, args.data());
+        }
+
+        quantifier* read_quantifier() {
+            unsigned char k = read_byte();
+            if (k != forall_k && k != exists_k && k != lambda_k)
+                fail("unknown quantifier kind");
+            unsigned n = read_unsigned();
+            svector<symbol> names;
+            ptr_buffer<sort> sorts;
+            for (unsigned i = 0; i < n; ++i) {
+                names.push_back(read_symbol());
+                sorts.push_back(read_sort_ref());
+            }
+            expr* body = read_expr_ref();
+            int weight = static_cast<int>(read_int());
+            symbol qid = read_symbol();
+            symbol skid = read_symbol();
+            ptr_buffer<expr> patterns, no_patterns;
+            unsigned num_patterns = read_unsigned();
+            for (unsigned i = 0; i < num_patterns; ++i)
+                patterns.push_back(read_expr_ref());
+            unsigned num_no_patterns = read_unsigned();
+            for (unsigned i = 0; i < num_no_patterns; ++i)
+                no_patterns.push_back(read_expr_ref());
+            if (k == lambda_k)
+                return m.mk_lambda(n, sorts.data(), names.data(), body);
+            return m.mk_quantifier(static_cast<quantifier_kind>(k), n, sorts.data(), names.data(), body, weight, qid, skid,
+                                   num_patterns, patterns.data(), num_no_patterns, no_patterns.data());
+        }
+
+    public:
+        reader(ast_manager& m, std::istream& in): m(m), m_in(in), m_nodes(m) {}
+
+        void operator()(expr_ref_vector& result) {
+            char magic[sizeof(g_magic)];
+            if (!m_in.read(magic, sizeof(magic)) || memcmp(magic, g_magic, sizeof(magic)) != 0)
+                fail("bad header");
+            while (true) {
+                unsigned char tag = read_byte();
+                switch (tag) {
+                case SORT_TAG: m_nodes.push_back(read_sort()); break;
+                case DECL_TAG: m_nodes.push_back(read_decl()); break;
+                case APP_TAG: m_nodes.push_back(read_app()); break;
+                case VAR_TAG: {
+                    unsigned idx = read_unsigned();
+                    m_nodes.push_back(m.mk_var(idx, read_sort_ref()));
+                    break;
+                }
+                case QUANTIFIER_TAG: m_nodes.push_back(read_quantifier()); break;
+                case END_TAG: {
+                    unsigned n = read_unsigned();
+                    for (unsigned i = 0; i < n; ++i)
+                        result.push_back(read_expr_ref());
+                    return;
+                }
+                default:
+                    fail("unknown node tag");
+                }
+            }
+        }
+    };
+}
+
+void serialize(std::ostream& out, expr_ref_vector const& fmls) {
+    writer w(fmls.get_manager(), out);
+    w(fmls);
+}
+
+void deserialize(std::istream& in, expr_ref_vector& result) {
+    reader r(result.get_manager(), in);
+    r(result);
+}
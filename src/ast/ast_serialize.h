@@ -0,0 +1,36 @@
+/*++
+Copyright (c) 2024 Microsoft Corporation
+
+Module Name:
+
+    ast_serialize.h
+
+Abstract:
+
+    Compact binary format for expressions.
+
+    The format stores a DAG of sorts, declarations and expressions.
+    Every node is written once, after its children, and refers to
+    them by position. Integers are written as variable length
+    (LEB128) numbers, so small node tables and arities take one byte.
+
+    Theory families are identified by name. The target manager must
+    have the plugins of those families registered, for instance by
+    reg_decl_plugins, before deserializing.
+
+    Lambda definitions, polymorphic declarations and plugin specific
+    (external) parameters are not supported.
+
+--*/
+#pragma once
+
+#include <iostream>
+#include "ast/ast.h"
+
+void serialize(std::ostream& out, expr_ref_vector const& fmls);
+
+/**
+   \brief read expressions written with serialize and append them to \c result.
+   Throws default_exception if the input is malformed.
+*/
+void deserialize(std::istream& in, expr_ref_vector& result);
@@ -22,6 +22,7 @@ Notes:
 #include "ast/for_each_expr.h"
 #include "ast/ast_util.h"
 #include "ast/occurs.h"
+#include "ast/array_decl_plugin.h"
 #include "ast/rewriter/expr_safe_replace.h"
 #include "ast/rewriter/th_rewriter.h"
 #include "ast/converters/generic_model_converter.h"
@@ -44,6 +45,54 @@ void generic_model_converter::operator()(model_ref & md) {
     unsigned arity;
     bool reset_ev = false;
     obj_map<sort, ptr_vector<expr>> uninterpreted;
+
+    // The evaluator cache is shared by all entries. It needs to be reset when a
+    // symbol is redefined only if its previous interpretation can have been read,
+    // that is, if the symbol occurs in an evaluated definition or, transitively,
+    // in the interpretation of a symbol occurring there.
+    array_util autil(m);
+    obj_hashtable<func_decl> read;
+    expr_mark visited;
+    ptr_vector<expr> todo;
+    auto add_read = [&](func_decl* f) {
+        if (f->get_family_id() != null_family_id || read.contains(f))
+            return;
+        read.insert(f);
+        if (f->get_arity() == 0) {
+            if (expr* v = md->get_const_interp(f))
+                todo.push_back(v);
+        }
+        else if (func_interp* fi = md->get_func_interp(f)) {
+            if (fi->get_else())
+                todo.push_back(fi->get_else());
+            for (func_entry* fe : *fi) {
+                todo.push_back(fe->get_result());
+                for (unsigned j = 0; j < fi->get_arity(); ++j)
+                    todo.push_back(fe->get_arg(j));
+            }
+        }
+    };
+    auto collect_read = [&](expr* def) {
+        todo.push_back(def);
+        while (!todo.empty()) {
+            expr* t = todo.back();
+            todo.pop_back();
+            if (visited.is_marked(t))
+                continue;
+            visited.mark(t, true);
+            func_decl* g = nullptr;
+            if (is_app(t)) {
+                add_read(to_app(t)->get_decl());
+                if (autil.is_as_array(t, g))
+                    add_read(g);
+                for (expr* arg : *to_app(t))
+                    todo.push_back(arg);
+            }
+            else if (is_quantifier(t))
+                todo.push_back(to_quantifier(t)->get_expr());
+        }
+    };
+
     for (unsigned i = m_entries.size(); i-- > 0; ) {
         entry const& e = m_entries[i];
         switch (e.m_instruction) {
@@ -52,6 +101,7 @@ void generic_model_converter::operator()(model_ref & md) {
             break;
         case instruction::ADD:
             ev(e.m_def, val);
+            collect_read(e.m_def);
             TRACE("model_converter", tout << e.m_f->get_name() << " ->\n" << e.m_def << "\n==>\n" << val << "\n";);
             arity = e.m_f->get_arity();
             reset_ev = false;
@@ -61,7 +111,7 @@ void generic_model_converter::operator()(model_ref & md) {
                     // skip
                 }
                 else {
-                    reset_ev = old_val != nullptr;
+                    reset_ev = old_val != nullptr && read.contains(e.m_f);
                     md->register_decl(e.m_f, val);
                 }
                 // corner case when uninterpreted constants are eliminated
@@ -78,7 +128,7 @@ void generic_model_converter::operator()(model_ref & md) {
                     // skip
                 }
                 else {
-                    reset_ev = old_val != nullptr;
+                    reset_ev = old_val != nullptr && read.contains(e.m_f);
                     func_interp * new_fi = alloc(func_interp, m, arity);
                     new_fi->set_else(val);
                     md->register_decl(e.m_f, new_fi);
@@ -88,6 +138,8 @@ void generic_model_converter::operator()(model_ref & md) {
                 ev.reset();
                 ev.set_model_completion(m_completion);
                 ev.set_expand_array_equalities(false);
+                read.reset();
+                visited.reset();
             }
             break;
         }
@@ -291,7 +291,7 @@ namespace euf {
             for (auto n : monomial(eq.r))
                 n->root->n->unmark1();
 
-            m_to_simplify_todo.insert(eq_id);
+            add_to_simplify(eq_id);
         }
         else
             m_eqs.pop_back();
@@ -468,16 +468,46 @@ namespace euf {
         CTRACE("plugin", !m_shared.empty() || !m_eqs.empty(), display(tout));
     }
 
+    //
+    // pick the smallest equation to simplify next.
+    // Queue entries are not removed when equations change, so an entry is
+    // used only if the equation is still to be simplified.
+    // The queue is rebuilt when it runs out of entries, for example after backtracking.
+    //
     unsigned ac_plugin::pick_next_eq() {
+        auto& q = m_to_simplify_queue;
+        std::greater<std::pair<unsigned, unsigned>> gt;
         while (!m_to_simplify_todo.empty()) {
-            unsigned id = *m_to_simplify_todo.begin();
+            if (q.empty()) {
+                for (unsigned id : m_to_simplify_todo)
+                    if (id < m_eqs.size())
+                        q.push_back({ monomial(m_eqs[id].l).size() + monomial(m_eqs[id].r).size(), id });
+                std::make_heap(q.begin(), q.end(), gt);
+                if (q.empty()) {
+                    m_to_simplify_todo.reset();
+                    break;
+                }
+            }
+            std::pop_heap(q.begin(), q.end(), gt);
+            unsigned id = q.back().second;
+            q.pop_back();
+            if (!m_to_simplify_todo.contains(id))
+                continue;
             if (id < m_eqs.size() && is_to_simplify(id))
                 return id;
             m_to_simplify_todo.remove(id);
         }
+        q.reset();
         return UINT_MAX;
     }
 
+    void ac_plugin::add_to_simplify(unsigned id) {
+        m_to_simplify_todo.insert(id);
+        auto const& eq = m_eqs[id];
+        m_to_simplify_queue.push_back({ monomial(eq.l).size() + monomial(eq.r).size(), id });
+        std::push_heap(m_to_simplify_queue.begin(), m_to_simplify_queue.end(), std::greater<std::pair<unsigned, unsigned>>());
+    }
+
     // reorient equations when the status of equations are set to to_simplify.
     void ac_plugin::set_status(unsigned id, eq_status s) {
         auto& eq = m_eqs[id];
@@ -494,11 +524,12 @@ namespace euf {
         switch (s) {
         case eq_status::processed:
         case eq_status::is_dead:
-            m_to_simplify_todo.remove(id);
+            if (m_to_simplify_todo.contains(id))
+                m_to_simplify_todo.remove(id);
             break;
         case eq_status::to_simplify:
-            m_to_simplify_todo.insert(id);
             orient_equation(eq);
+            add_to_simplify(id);
             break;
         }        
     }
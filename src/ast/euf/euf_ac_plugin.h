@@ -145,7 +145,8 @@ namespace euf {
         vector<monomial_t>       m_monomials;
         svector<shared>          m_shared;
         justification::dependency_manager m_dep_manager;
-        tracked_uint_set         m_to_simplify_todo;
+        indexed_uint_set         m_to_simplify_todo;
+        svector<std::pair<unsigned, unsigned>> m_to_simplify_queue;  // min-heap of (size, eq) over m_to_simplify_todo, stale entries are skipped
         tracked_uint_set         m_shared_todo;
         uint64_t                 m_tick = 1;
         
@@ -204,6 +205,7 @@ namespace euf {
         bool orient_equation(eq& e);
         void set_status(unsigned eq_id, eq_status s);
         unsigned pick_next_eq();
+        void add_to_simplify(unsigned eq_id);
 
         void forward_simplify(unsigned eq_id, unsigned using_eq);
         bool backward_simplify(unsigned eq_id, unsigned using_eq);
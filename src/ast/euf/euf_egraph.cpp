@@ -20,9 +20,13 @@ Notes:
 #include "ast/euf/euf_egraph.h"
 #include "ast/ast_pp.h"
 #include "ast/ast_translation.h"
+#include "util/prefetch.h"
 
 namespace euf {
 
+    // number of parents looked ahead when removing and reinserting parents.
+    static const unsigned euf_prefetch_distance = 4;
+
     enode* egraph::mk_enode(expr* f, unsigned generation, unsigned num_args, enode * const* args) {
         enode* n = enode::mk(m_region, f, generation, num_args, args);
         if (m_default_relevant)
@@ -56,6 +60,7 @@ namespace euf {
             m_tmp_node->m_args[i] = args[i];
         m_tmp_node->m_num_args = n;
         m_tmp_node->m_expr = e;
+        m_tmp_node->m_id = e->get_id();
         m_tmp_node->m_table_id = UINT_MAX;
         return m_table.find(m_tmp_node);
     }
@@ -524,7 +529,14 @@ namespace euf {
     void egraph::remove_parents(enode* r) {
         TRACE("euf_verbose", tout << bpp(r) << "\n");
         SASSERT(all_of(enode_parents(r), [&](enode* p) { return !p->is_marked1(); }));
-        for (enode* p : enode_parents(r)) {
+        enode_vector const& parents = r->m_parents;
+        unsigned sz = parents.size();
+        for (unsigned i = 0; i < sz; ++i) {
+            enode* p = parents[i];
+            // high-degree classes have many parents, the nodes are spread
+            // over the region, so ask for the next ones early.
+            if (i + euf_prefetch_distance < sz)
+                prefetch_address(parents[i + euf_prefetch_distance]);
             if (p->is_marked1())
                 continue;
             if (p->cgc_enabled()) {
@@ -542,7 +554,12 @@ namespace euf {
     }
 
     void egraph::reinsert_parents(enode* r1, enode* r2) {
-        for (enode* p : enode_parents(r1)) {
+        enode_vector const& parents = r1->m_parents;
+        unsigned sz = parents.size();
+        for (unsigned i = 0; i < sz; ++i) {
+            enode* p = parents[i];
+            if (i + euf_prefetch_distance < sz)
+                prefetch_address(parents[i + euf_prefetch_distance]);
             if (!p->is_marked1())
                 continue;
             p->unmark1();
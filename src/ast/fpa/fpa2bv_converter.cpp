@@ -41,6 +41,7 @@ fpa2bv_converter::fpa2bv_converter(ast_manager & m) :
     m_mpf_manager(m_util.fm()),
     m_mpz_manager(m_mpf_manager.mpz_manager()),
     m_hi_fp_unspecified(true),
+    m_unpack_results(m),
     m_extra_assertions(m) {
     m_plugin = static_cast<fpa_decl_plugin*>(m.get_plugin(m.mk_family_id("fpa")));
 }
@@ -184,6 +185,82 @@ void fpa2bv_converter::mk_numeral(sort * s, mpf const & v, expr_ref & result) {
     }
 }
 
+/**
+   \brief recognize the bit-vector encoding of a floating-point numeral, as produced by mk_numeral.
+*/
+bool fpa2bv_converter::is_fp_numeral(expr * e, mpf & v) {
+    expr * sgn = nullptr, * exp = nullptr, * sig = nullptr, * e1 = nullptr, * e2 = nullptr;
+    rational rsgn, rexp, rsig, r1, r2;
+    unsigned sz = 0, sbits = 0;
+    if (!m_util.is_fp(e, sgn, exp, sig) ||
+        !m_bv_util.is_numeral(sgn, rsgn, sz) ||
+        !m_bv_util.is_numeral(sig, rsig, sbits))
+        return false;
+    unsigned ebits = m_bv_util.get_bv_size(exp);
+    if (m_bv_util.is_numeral(exp, rexp, sz))
+        ;
+    else if (m_bv_util.is_bv_add(exp, e1, e2) && m_bv_util.is_numeral(e1, r1, sz) && m_bv_util.is_numeral(e2, r2, sz))
+        rexp = mod(r1 + r2, rational::power_of_two(ebits));
+    else
+        return false;
+    m_mpf_manager.set(v, ebits, sbits + 1, rsgn.is_one(), m_mpf_manager.unbias_exp(ebits, rexp.get_int64()), rsig.to_mpq().numerator());
+    return true;
+}
+
+/**
+   \brief evaluate arithmetic operations on numerals instead of building their circuits.
+   Multiplication, division, fused multiply-add and square root produce circuits
+   that are quadratic in the number of significand bits, while constant arguments
+   remain after simplification when terms are created during search.
+*/
+bool fpa2bv_converter::fold_numerals(func_decl * f, unsigned num, expr * const * args, expr_ref & result) {
+    unsigned first = 0;
+    switch (f->get_decl_kind()) {
+    case OP_FPA_ADD:
+    case OP_FPA_SUB:
+    case OP_FPA_MUL:
+    case OP_FPA_DIV:
+    case OP_FPA_FMA:
+    case OP_FPA_SQRT:
+    case OP_FPA_ROUND_TO_INTEGRAL:
+        first = 1;
+        break;
+    case OP_FPA_REM:
+        break;
+    default:
+        return false;
+    }
+    if (num > 4 || num <= first)
+        return false;
+    rational rm_val;
+    unsigned sz = 0;
+    mpf_rounding_mode rm = MPF_ROUND_NEAREST_TEVEN;
+    if (first == 1) {
+        if (!m_util.is_bv2rm(args[0]) || !m_bv_util.is_numeral(to_app(args[0])->get_arg(0), rm_val, sz) || rm_val > rational(BV_RM_TO_ZERO))
+            return false;
+        rm = static_cast<mpf_rounding_mode>(rm_val.get_unsigned());
+    }
+    scoped_mpf a(m_mpf_manager), b(m_mpf_manager), c(m_mpf_manager), r(m_mpf_manager);
+    mpf * vals[3] = { &a.get(), &b.get(), &c.get() };
+    for (unsigned i = first; i < num; ++i)
+        if (!is_fp_numeral(args[i], *vals[i - first]))
+            return false;
+    switch (f->get_decl_kind()) {
+    case OP_FPA_ADD: m_mpf_manager.add(rm, a, b, r); break;
+    case OP_FPA_SUB: m_mpf_manager.sub(rm, a, b, r); break;
+    case OP_FPA_MUL: m_mpf_manager.mul(rm, a, b, r); break;
+    case OP_FPA_DIV: m_mpf_manager.div(rm, a, b, r); break;
+    case OP_FPA_FMA: m_mpf_manager.fma(rm, a, b, c, r); break;
+    case OP_FPA_SQRT: m_mpf_manager.sqrt(rm, a, r); break;
+    case OP_FPA_ROUND_TO_INTEGRAL: m_mpf_manager.round_to_integral(rm, a, r); break;
+    case OP_FPA_REM: m_mpf_manager.rem(a, b, r); break;
+    default: UNREACHABLE(); return false;
+    }
+    mk_numeral(f->get_range(), r, result);
+    TRACE("fpa2bv", tout << "folded " << f->get_name() << " to " << m_mpf_manager.to_string(r) << "\n";);
+    return true;
+}
+
 app * fpa2bv_converter::mk_fresh_const(char const * prefix, unsigned sz) {
     return m.mk_fresh_const(prefix, m_bv_util.mk_sort(sz));
 }
@@ -3813,7 +3890,30 @@ void fpa2bv_converter::mk_unbias(expr * e, expr_ref & result) {
     result = m_bv_util.mk_concat(n_leading, rest);
 }
 
+/**
+   \brief unpack the operands of operations once.
+   Terms used in several operations, such as the accumulators of numerical code,
+   would otherwise have their normalization circuits rebuilt for each operation.
+*/
 void fpa2bv_converter::unpack(expr * e, expr_ref & sgn, expr_ref & sig, expr_ref & exp, expr_ref & lz, bool normalize) {
+    unsigned offset = 0;
+    if (m_unpack_cache[normalize].find(e, offset)) {
+        sgn = m_unpack_results.get(offset + 1);
+        sig = m_unpack_results.get(offset + 2);
+        exp = m_unpack_results.get(offset + 3);
+        lz = m_unpack_results.get(offset + 4);
+        return;
+    }
+    unpack_core(e, sgn, sig, exp, lz, normalize);
+    m_unpack_cache[normalize].insert(e, m_unpack_results.size());
+    m_unpack_results.push_back(e);
+    m_unpack_results.push_back(sgn);
+    m_unpack_results.push_back(sig);
+    m_unpack_results.push_back(exp);
+    m_unpack_results.push_back(lz);
+}
+
+void fpa2bv_converter::unpack_core(expr * e, expr_ref & sgn, expr_ref & sig, expr_ref & exp, expr_ref & lz, bool normalize) {
     SASSERT(m_util.is_fp(e));
     SASSERT(to_app(e)->get_num_args() == 3);
 
@@ -4337,6 +4437,9 @@ void fpa2bv_converter::reset() {
     }
     m_uf2bvuf.reset();
     m_min_max_ufs.reset();
+    m_unpack_cache[0].reset();
+    m_unpack_cache[1].reset();
+    m_unpack_results.reset();
     m_extra_assertions.reset();
 }
 
@@ -54,6 +54,8 @@ protected:
     const2bv_t                 m_rm_const2bv;
     uf2bvuf_t                  m_uf2bvuf;
     special_t                  m_min_max_ufs;
+    obj_map<expr, unsigned>    m_unpack_cache[2];    // unpacked term, per normalization |-> offset in m_unpack_results
+    expr_ref_vector            m_unpack_results;     // term, sign, significand, exponent and leading zeros
 
     friend class fpa2bv_model_converter;
     friend class bv2fpa_converter;
@@ -86,6 +88,7 @@ public:
     void mk_rounding_mode(decl_kind k, expr_ref & result);
     void mk_numeral(func_decl * f, unsigned num, expr * const * args, expr_ref & result);
     void mk_numeral(sort * s, mpf const & v, expr_ref & result);
+    bool fold_numerals(func_decl * f, unsigned num, expr * const * args, expr_ref & result);
     virtual void mk_const(func_decl * f, expr_ref & result);
     virtual void mk_rm_const(func_decl * f, expr_ref & result);
     virtual void mk_uf(func_decl * f, unsigned num, expr * const * args, expr_ref & result);
@@ -191,10 +194,12 @@ protected:
 
     void mk_leading_zeros(expr * e, unsigned max_bits, expr_ref & result);
 
+    bool is_fp_numeral(expr * e, mpf & v);
     void mk_bias(expr * e, expr_ref & result);
     void mk_unbias(expr * e, expr_ref & result);
 
     void unpack(expr * e, expr_ref & sgn, expr_ref & sig, expr_ref & exp, expr_ref & lz, bool normalize);
+    void unpack_core(expr * e, expr_ref & sgn, expr_ref & sig, expr_ref & exp, expr_ref & lz, bool normalize);
     void round(sort * s, expr_ref & rm, expr_ref & sgn, expr_ref & sig, expr_ref & exp, expr_ref & result);
     expr_ref mk_rounding_decision(expr * rm, expr * sgn, expr * last, expr * round, expr * sticky);
 
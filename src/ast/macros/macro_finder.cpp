@@ -272,6 +272,65 @@ macro_finder::macro_finder(ast_manager & m, macro_manager & mm):
 macro_finder::~macro_finder() {
 }
 
+/**
+   \brief The formulas of a pass are the result of the previous pass, where they were
+   expanded with the macros known at the time and not recognized as macros.
+   Adding macros does not turn a formula into a macro, so a formula only needs
+   to be processed again if it uses the head of a macro found in the previous pass.
+*/
+void macro_finder::start_pass() {
+    m_visited.reset();
+    m_uses_new_head.reset();
+    m_new_heads.reset();
+    if (m_first_pass)
+        return;
+    for (unsigned i = m_num_macros; i < m_macro_manager.get_num_macros(); ++i)
+        m_new_heads.insert(m_macro_manager.get_macro_func_decl(i));
+}
+
+bool macro_finder::uses_new_head(expr * n) {
+    if (m_first_pass)
+        return true;
+    ptr_buffer<expr> todo;
+    todo.push_back(n);
+    while (!todo.empty()) {
+        expr * e = todo.back();
+        if (m_visited.is_marked(e)) {
+            todo.pop_back();
+            continue;
+        }
+        bool visited = true, uses = false;
+        auto visit = [&](expr * arg) {
+            if (!m_visited.is_marked(arg)) {
+                todo.push_back(arg);
+                visited = false;
+            }
+            else if (m_uses_new_head.is_marked(arg))
+                uses = true;
+        };
+        if (is_app(e)) {
+            uses = m_new_heads.contains(to_app(e)->get_decl());
+            for (expr * arg : *to_app(e))
+                visit(arg);
+        }
+        else if (is_quantifier(e)) {
+            quantifier * q = to_quantifier(e);
+            visit(q->get_expr());
+            for (unsigned i = 0; i < q->get_num_patterns(); ++i)
+                visit(q->get_pattern(i));
+            for (unsigned i = 0; i < q->get_num_no_patterns(); ++i)
+                visit(q->get_no_pattern(i));
+        }
+        if (!visited)
+            continue;
+        todo.pop_back();
+        m_visited.mark(e);
+        if (uses)
+            m_uses_new_head.mark(e);
+    }
+    return m_uses_new_head.is_marked(n);
+}
+
 bool macro_finder::expand_macros(expr_ref_vector const& exprs, proof_ref_vector const& prs, expr_dependency_ref_vector const& deps,  expr_ref_vector & new_exprs, proof_ref_vector & new_prs, expr_dependency_ref_vector & new_deps) {
     TRACE("macro_finder", tout << "starting expand_macros:\n";
           m_macro_manager.display(tout););
@@ -279,10 +338,20 @@ bool macro_finder::expand_macros(expr_ref_vector const& exprs, proof_ref_vector
     unsigned num = exprs.size();
     bool deps_valid = deps.size() == exprs.size();
     SASSERT(deps_valid || deps.empty());
+    start_pass();
+    m_num_macros = m_macro_manager.get_num_macros();
     for (unsigned i = 0; i < num; i++) {
         expr * n       = exprs[i];
         proof * pr     = m.proofs_enabled() ? prs[i] : nullptr;
         expr_dependency * dep = deps.get(i, nullptr);
+        if (!uses_new_head(n)) {
+            new_exprs.push_back(n);
+            if (m.proofs_enabled())
+                new_prs.push_back(pr);
+            if (deps_valid)
+                new_deps.push_back(dep);
+            continue;
+        }
         expr_ref new_n(m), def(m);
         proof_ref new_pr(m);
         expr_dependency_ref new_dep(m);
@@ -312,11 +381,13 @@ bool macro_finder::expand_macros(expr_ref_vector const& exprs, proof_ref_vector
         // SASSERT(!m.proofs_enabled() || new_exprs.size() == new_prs.size());
 
     }
+    m_first_pass = false;
     return found_new_macro;
 }
 
 void macro_finder::operator()(expr_ref_vector const& exprs, proof_ref_vector const & prs, expr_dependency_ref_vector const & deps, expr_ref_vector & new_exprs, proof_ref_vector & new_prs, expr_dependency_ref_vector & new_deps) {
     TRACE("macro_finder", tout << "processing macros...\n";);
+    m_first_pass = true;
     expr_ref_vector   _new_exprs(m);
     proof_ref_vector  _new_prs(m);
     expr_dependency_ref_vector _new_deps(m);
@@ -348,9 +419,15 @@ bool macro_finder::expand_macros(unsigned num, justified_expr const * fmls, vect
     TRACE("macro_finder", tout << "starting expand_macros:\n";
           m_macro_manager.display(tout););
     bool found_new_macro = false;
+    start_pass();
+    m_num_macros = m_macro_manager.get_num_macros();
     for (unsigned i = 0; i < num; i++) {
         expr * n       = fmls[i].get_fml();
         proof * pr     = m.proofs_enabled() ? fmls[i].get_proof() : nullptr;
+        if (!uses_new_head(n)) {
+            new_fmls.push_back(fmls[i]);
+            continue;
+        }
         expr_ref new_n(m), def(m);
         proof_ref new_pr(m);
         expr_dependency_ref new_dep(m);
@@ -373,6 +450,7 @@ bool macro_finder::expand_macros(unsigned num, justified_expr const * fmls, vect
             new_fmls.push_back(justified_expr(m, new_n, new_pr));
         }
     }
+    m_first_pass = false;
     return found_new_macro;
 }
 
@@ -388,6 +466,7 @@ void macro_finder::revert_unsafe_macros(vector<justified_expr>& new_fmls) {
 void macro_finder::operator()(unsigned n, justified_expr const* fmls, vector<justified_expr>& new_fmls) {
     m_macro_manager.unsafe_macros().reset();
     TRACE("macro_finder", tout << "processing macros...\n";);
+    m_first_pass = true;
     vector<justified_expr> _new_fmls;
     if (expand_macros(n, fmls, _new_fmls)) {
         while (true) {
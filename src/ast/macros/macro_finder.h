@@ -30,6 +30,14 @@ class macro_finder {
     macro_manager &             m_macro_manager;
     macro_util &                m_util;
     arith_util                  m_autil;
+    // heads of the macros found in the previous pass. Only formulas that use one of them
+    // can be rewritten or become macros in the next pass.
+    func_decl_set               m_new_heads;
+    expr_mark                   m_visited, m_uses_new_head;
+    unsigned                    m_num_macros = 0;
+    bool                        m_first_pass = true;
+    void start_pass();
+    bool uses_new_head(expr * n);
     bool expand_macros(expr_ref_vector const& exprs, proof_ref_vector const& prs, expr_dependency_ref_vector const & deps, 
                        expr_ref_vector & new_exprs, proof_ref_vector & new_prs, expr_dependency_ref_vector& new_deps);
     bool expand_macros(unsigned n, justified_expr const * fmls, vector<justified_expr>& new_fmls);
@@ -635,7 +635,12 @@ struct nnf::imp {
         if (m_mode == NNF_FULL || t->has_quantifiers() || t->has_labels()) {
             expr_ref  n2(m);
             proof_ref pr2(m);
-            if (m_mode == NNF_FULL || (m_mode != NNF_SKOLEM && fr.m_in_q))
+            // the name of t does not depend on the polarity, recover it from the result for the other polarity.
+            // the positive result is the name, the negative result is its negation.
+            expr * r = proofs_enabled() ? nullptr : get_cached(t, !fr.m_pol, fr.m_in_q);
+            if (r)
+                n2 = fr.m_pol ? mk_not(m, r) : r;
+            else if (m_mode == NNF_FULL || (m_mode != NNF_SKOLEM && fr.m_in_q))
                 m_name_nested_formulas->operator()(t, m_todo_defs, m_todo_proofs, n2, pr2);
             else
                 m_name_quant->operator()(t, m_todo_defs, m_todo_proofs, n2, pr2);
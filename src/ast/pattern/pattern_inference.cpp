@@ -114,7 +114,8 @@ pattern_inference_cfg::pattern_inference_cfg(ast_manager & m, pattern_inference_
     m_pattern_weight_lt(m_candidates_info),
     m_collect(m, *this),
     m_contains_subpattern(*this),
-    m_database(m) {
+    m_database(m),
+    m_q2patterns_pinned(m) {
     if (params.m_pi_arith == AP_NO)
         register_forbidden_family(m_afid);
 }
@@ -630,6 +631,28 @@ bool pattern_inference_cfg::reduce_quantifier(
     if (!is_forall(q)) 
         return false;
 
+    if (m.proofs_enabled())
+        return infer_patterns(q, new_body, new_no_patterns, result, result_pr);
+
+    quantifier * cached = nullptr;
+    if (m_q2patterns.find(q, new_body, cached)) {
+        if (!cached)
+            return false;
+        result = cached;
+        return true;
+    }
+    bool r = infer_patterns(q, new_body, new_no_patterns, result, result_pr);
+    cached = r ? to_quantifier(result) : nullptr;
+    m_q2patterns_pinned.push_back(q);
+    m_q2patterns_pinned.push_back(new_body);
+    if (cached)
+        m_q2patterns_pinned.push_back(cached);
+    m_q2patterns.insert(q, new_body, cached);
+    return r;
+}
+
+bool pattern_inference_cfg::infer_patterns(quantifier * q, expr * new_body, expr * const * new_no_patterns,
+                                           expr_ref & result, proof_ref & result_pr) {
     int weight = q->get_weight();
 
     if (m_params.m_pi_use_database) {
@@ -215,6 +215,16 @@ class pattern_inference_cfg :  public default_rewriter_cfg {
                      unsigned num_no_patterns,           // IN num. patterns that should not be used.
                      expr * const * no_patterns,         // IN patterns that should not be used.
                      app_ref_buffer & result);           // OUT result
+
+    bool infer_patterns(quantifier * q, expr * new_body, expr * const * new_no_patterns,
+                        expr_ref & result, proof_ref & result_pr);
+
+    // (quantifier, new body) -> quantifier with inferred patterns, or nullptr if it is unchanged.
+    // Quantifiers are hash-consed, so the same quantifier asserted again, for instance after
+    // a pop, is found here. The entries remain valid as long as the forbidden and preferred
+    // symbols stay the same.
+    obj_pair_map<quantifier, expr, quantifier*> m_q2patterns;
+    expr_ref_vector            m_q2patterns_pinned;
     
 public:
     pattern_inference_cfg(ast_manager & m, pattern_inference_params const & params);
@@ -222,6 +232,7 @@ public:
     void register_forbidden_family(family_id fid) {
         SASSERT(fid != m_bfid);
         m_forbidden.push_back(fid);
+        reset_cache();
     }
 
     /**
@@ -230,6 +241,12 @@ public:
     */
     void register_preferred(func_decl * f) {
         m_preferred.insert(f);
+        reset_cache();
+    }
+
+    void reset_cache() {
+        m_q2patterns.reset();
+        m_q2patterns_pinned.reset();
     }
 
     bool reduce_quantifier(quantifier * old_q, 
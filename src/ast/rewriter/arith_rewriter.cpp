@@ -742,7 +742,7 @@ bool arith_rewriter::mk_eq_mod(expr* arg1, expr* arg2, expr_ref& result) {
 }
 
 expr_ref arith_rewriter::neg_monomial(expr* e) {
-    expr_ref_vector args(m);
+    expr_ref_buffer args(m);
     rational a1;
     if (m_util.is_numeral(e, a1)) 
         args.push_back(m_util.mk_numeral(-a1, e->get_sort()));
@@ -791,7 +791,7 @@ bool arith_rewriter::is_neg_poly(expr* t, expr_ref& neg) {
     expr * t2 = to_app(t)->get_arg(0);
 
     if (m_util.is_mul(t2) && is_numeral(to_app(t2)->get_arg(0), r) && r.is_neg()) {
-        expr_ref_vector args1(m);
+        expr_ref_buffer args1(m);
         for (expr* e1 : *to_app(t)) {
             args1.push_back(neg_monomial(e1));
         }       
@@ -305,8 +305,9 @@ br_status array_rewriter::mk_select_same_store(unsigned num_args, expr * const *
             app* a = to_app(arg0);
             func_decl* f0 = m_util.get_map_func_decl(a);
             expr_ref_vector args0(m());
+            ptr_buffer<expr> args1;
             for (expr* arg : *a) {
-                ptr_vector<expr> args1;
+                args1.reset();
                 args1.push_back(arg);
                 args1.append(num_args-1, args + 1);
                 args0.push_back(m_util.mk_select(args1.size(), args1.data()));
@@ -740,7 +741,7 @@ bool array_rewriter::has_index_set(expr* e, expr_ref& else_case, vector<expr_ref
 bool array_rewriter::add_store(expr_ref_vector& args, unsigned num_idxs, expr* e, expr* store_val, vector<expr_ref_vector>& stores) {
 
     expr* e1, *e2;
-    ptr_vector<expr> eqs;    
+    ptr_buffer<expr> eqs;
     args.reset();
     args.resize(num_idxs + 1, nullptr);
     bool is_not = m().is_bool(store_val) && m().is_not(e, e);
@@ -51,6 +51,15 @@ struct blaster_cfg {
     void mk_carry(expr * a, expr * b, expr * c, expr_ref & r) {
         expr_ref t1(m()), t2(m()), t3(m());
 #if 1
+        // carry = (b & c) | (a & (b xor c)).
+        // b xor c is the gate built by mk_xor3 for the sum bit of the
+        // same full adder, so hash consing shares it between the two
+        // outputs and the carry costs two and-gates instead of three.
+        mk_xor(b, c, t1);
+        mk_and(b, c, t2);
+        mk_and(a, t1, t3);
+        mk_or(t2, t3, r);
+#elif 0
         mk_and(a, b, t1);
         mk_and(a, c, t2);
         mk_and(b, c, t3);
@@ -1469,13 +1469,13 @@ br_status bv_rewriter::mk_bv2int(expr * arg, expr_ref & result) {
         return BR_REWRITE2;
     }
     if (is_mul_no_overflow(arg)) {
-        expr_ref_vector args(m);
+        expr_ref_buffer args(m);
         for (expr* x : *to_app(arg)) args.push_back(m_util.mk_bv2int(x));
         result = m_autil.mk_mul(args.size(), args.data());
         return BR_REWRITE2;
     }
     if (is_add_no_overflow(arg)) {
-        expr_ref_vector args(m);
+        expr_ref_buffer args(m);
         for (expr* x : *to_app(arg)) args.push_back(m_util.mk_bv2int(x));
         result = m_autil.mk_add(args.size(), args.data());
         return BR_REWRITE2;
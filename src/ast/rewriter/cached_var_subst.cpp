@@ -33,10 +33,13 @@ bool cached_var_subst::key_eq_proc::operator()(cached_var_subst::key * k1, cache
 cached_var_subst::cached_var_subst(ast_manager & _m):
     m(_m),
     m_proc(m),
-    m_refs(m) {
+    m_refs(m),
+    m_values(m) {
 }
 
 void cached_var_subst::reset() {
+    m_templates.reset();
+    m_tmpls.reset();
     m_refs.reset();
     m_instances.reset();
     m_region.reset();
@@ -44,6 +47,105 @@ void cached_var_subst::reset() {
     m_key = nullptr;
 }
 
+/**
+   \brief compile the body of q into a template, or return nullptr if the body
+   is ground or contains quantifiers. The templates are created once per quantifier.
+*/
+cached_var_subst::tmpl* cached_var_subst::get_template(quantifier* q) {
+    tmpl* t = nullptr;
+    if (m_templates.find(q, t))
+        return t;
+    expr* body = q->get_expr();
+    m_refs.push_back(q);
+    if (is_ground(body) || has_quantifiers(body)) {
+        m_templates.insert(q, nullptr);
+        return nullptr;
+    }
+    t = alloc(tmpl);
+    m_tmpls.push_back(t);
+    m_templates.insert(q, t);
+    obj_map<expr, unsigned> step_of;
+    ptr_buffer<expr> todo;
+    todo.push_back(body);
+    while (!todo.empty()) {
+        expr* e = todo.back();
+        if (step_of.contains(e)) {
+            todo.pop_back();
+            continue;
+        }
+        if (is_ground(e)) {
+            step_of.insert(e, t->m_steps.size());
+            t->m_steps.push_back({ ground_step, e, 0 });
+            todo.pop_back();
+            continue;
+        }
+        if (is_var(e)) {
+            // std order: (VAR 0) is the last binding
+            unsigned idx = to_var(e)->get_idx();
+            if (idx >= q->get_num_decls()) {
+                t->m_steps.reset();
+                return t;
+            }
+            step_of.insert(e, t->m_steps.size());
+            t->m_steps.push_back({ var_step, e, q->get_num_decls() - idx - 1 });
+            todo.pop_back();
+            continue;
+        }
+        app* a = to_app(e);
+        bool visited = true;
+        for (expr* arg : *a) {
+            if (!step_of.contains(arg)) {
+                todo.push_back(arg);
+                visited = false;
+            }
+        }
+        if (!visited)
+            continue;
+        todo.pop_back();
+        step_of.insert(e, t->m_steps.size());
+        t->m_steps.push_back({ app_step, e, t->m_args.size() });
+        for (expr* arg : *a)
+            t->m_args.push_back(step_of[arg]);
+    }
+    return t;
+}
+
+/**
+   \brief instantiate the body of q by running its template.
+   Returns null if q has no template or a binding is missing.
+*/
+expr_ref cached_var_subst::instantiate(quantifier* q, unsigned num_bindings, expr* const* bindings) {
+    tmpl* t = get_template(q);
+    if (!t || t->m_steps.empty() || num_bindings != q->get_num_decls())
+        return expr_ref(m);
+    for (unsigned i = 0; i < num_bindings; ++i)
+        if (!bindings[i])
+            return expr_ref(m);
+    m_values.reset();
+    ptr_buffer<expr> args;
+    for (step const& s : t->m_steps) {
+        switch (s.m_kind) {
+        case ground_step:
+            m_values.push_back(s.m_expr);
+            break;
+        case var_step:
+            m_values.push_back(bindings[s.m_idx]);
+            break;
+        case app_step: {
+            app* a = to_app(s.m_expr);
+            args.reset();
+            for (unsigned i = 0; i < a->get_num_args(); ++i)
+                args.push_back(m_values.get(t->m_args[s.m_idx + i]));
+            m_values.push_back(m.mk_app(a->get_decl(), args.size(), args.data()));
+            break;
+        }
+        }
+    }
+    expr_ref result(m_values.back(), m);
+    m_values.reset();
+    return result;
+}
+
 expr** cached_var_subst::operator()(quantifier* qa, unsigned num_bindings) {
     m_new_keys.reserve(num_bindings+1, 0);
     m_key = m_new_keys[num_bindings];
@@ -75,7 +177,9 @@ expr_ref cached_var_subst::operator()() {
 
     SASSERT(entry->get_data().m_value == 0);
     try {
-        result = m_proc(m_key->m_qa->get_expr(), m_key->m_num_bindings, m_key->m_bindings);
+        result = instantiate(m_key->m_qa, m_key->m_num_bindings, m_key->m_bindings);
+        if (!result)
+            result = m_proc(m_key->m_qa->get_expr(), m_key->m_num_bindings, m_key->m_bindings);
     }
     catch (...) {
         // CMW: The var_subst reducer was interrupted and m_instances is
@@ -20,6 +20,7 @@ Revision History:
 
 #include "ast/rewriter/var_subst.h"
 #include "util/map.h"
+#include "util/scoped_ptr_vector.h"
 
 class cached_var_subst {
     struct key {
@@ -36,6 +37,24 @@ class cached_var_subst {
         bool operator()(key * k1, key * k2) const;
     };
     typedef map<key *, expr *, key_hash_proc, key_eq_proc> instances;
+
+    /**
+       \brief instantiation template of a quantifier body without nested quantifiers.
+       The nodes of the body are stored in post-order, variables refer to binding
+       slots and ground sub-terms are used as they are. An instance is built in one
+       pass over the steps without going through the rewriter.
+    */
+    enum step_kind { ground_step, var_step, app_step };
+    struct step {
+        step_kind m_kind;
+        expr*     m_expr;
+        unsigned  m_idx;    // binding slot of a variable, offset of the argument steps of an application
+    };
+    struct tmpl {
+        svector<step>   m_steps;
+        unsigned_vector m_args;
+    };
+
     ast_manager&     m;
     var_subst        m_proc;
     expr_ref_vector  m_refs;
@@ -43,6 +62,12 @@ class cached_var_subst {
     region           m_region;
     ptr_vector<key>  m_new_keys; // mapping from num_bindings -> next key
     key*             m_key { nullptr };
+    obj_map<quantifier, tmpl*> m_templates;
+    scoped_ptr_vector<tmpl>    m_tmpls;
+    expr_ref_vector            m_values;
+
+    tmpl* get_template(quantifier* q);
+    expr_ref instantiate(quantifier* q, unsigned num_bindings, expr* const* bindings);
 public:
     cached_var_subst(ast_manager & m);
     expr** operator()(quantifier * qa, unsigned num_bindings);
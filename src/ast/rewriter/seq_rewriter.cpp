@@ -60,17 +60,42 @@ expr_ref sym_expr::accept(expr* e) {
             result = m.mk_and(u.mk_le(m_t, e), u.mk_le(e, m_s));
         }
         break;
+    case t_set:
+        if (u.is_const_char(e, r2))
+            result = m.mk_bool_val(m_set.contains(r2));
+        else {
+            expr_ref_vector disj(m);
+            for (auto const& [lo, hi] : m_set.ranges()) {
+                if (lo == hi)
+                    disj.push_back(m.mk_eq(e, u.mk_char(lo)));
+                else
+                    disj.push_back(m.mk_and(u.mk_le(u.mk_char(lo), e), u.mk_le(e, u.mk_char(hi))));
+            }
+            result = mk_or(disj);
+        }
+        break;
     }
     
     return result;
 }
 
+expr* sym_expr::get_pred() const {
+    SASSERT(is_pred());
+    if (is_set() && !m_t) {
+        ast_manager& m = m_t.get_manager();
+        var_ref v(m.mk_var(0, m_sort), m);
+        m_t = const_cast<sym_expr*>(this)->accept(v);
+    }
+    return m_t;
+}
+
 std::ostream& sym_expr::display(std::ostream& out) const {
     switch (m_ty) {
     case t_char: return out << m_t;
     case t_range: return out << m_t << ":" << m_s;
     case t_pred: return out << m_t;
     case t_not: return m_expr->display(out << "not ");
+    case t_set: return out << m_set;
     }
     return out << "expression type not recognized";
 }
@@ -92,6 +117,48 @@ public:
     sym_expr_boolean_algebra(ast_manager& m, expr_solver& s): 
         m(m), m_solver(s), m_var(m) {}
 
+    /**
+       \brief extract the set of constant characters described by x, if any.
+       Operations on such sets are carried out on interval lists instead of
+       formulas and do not need the solver.
+    */
+    bool to_set(T x, char_set& s) {
+        seq_util u(m);
+        unsigned lo, hi;
+        if (!u.is_char(x->get_sort()))
+            return false;
+        if (x->is_set())
+            s = x->get_set();
+        else if (x->is_char() && u.is_const_char(x->get_char(), lo))
+            s = char_set(lo, lo);
+        else if (x->is_range() && u.is_const_char(x->get_lo(), lo) && u.is_const_char(x->get_hi(), hi))
+            s = char_set(lo, hi);
+        else if (x->is_not() && to_set(x->get_arg(), s))
+            s = s.complement(u.max_char());
+        else if (x->is_pred() && !x->is_range() && !x->is_not() && (m.is_true(x->get_pred()) || m.is_false(x->get_pred())))
+            s = m.is_true(x->get_pred()) ? char_set(0, u.max_char()) : char_set();
+        else
+            return false;
+        return true;
+    }
+
+    T mk_set(sort* srt, char_set const& s) {
+        seq_util u(m);
+        if (s.empty() || s == char_set(0, u.max_char())) {
+            expr_ref fml(m.mk_bool_val(!s.empty()), m);
+            return sym_expr::mk_pred(fml, srt);
+        }
+        if (s.num_ranges() == 1 && s[0].first == s[0].second) {
+            expr_ref ch(u.mk_char(s[0].first), m);
+            return sym_expr::mk_char(ch);
+        }
+        if (s.num_ranges() == 1) {
+            expr_ref lo(u.mk_char(s[0].first), m), hi(u.mk_char(s[0].second), m);
+            return sym_expr::mk_range(lo, hi);
+        }
+        return sym_expr::mk_set(m, srt, s);
+    }
+
     T mk_false() override {
         expr_ref fml(m.mk_false(), m);
         return sym_expr::mk_pred(fml, m.mk_bool_sort()); // use of Bool sort for bound variable is arbitrary
@@ -102,6 +169,9 @@ public:
     }
     T mk_and(T x, T y) override {
         seq_util u(m);
+        char_set s1, s2;
+        if (x->get_sort() == y->get_sort() && to_set(x, s1) && to_set(y, s2))
+            return mk_set(x->get_sort(), s1 & s2);
         if (x->is_char() && y->is_char()) {
             if (x->get_char() == y->get_char()) {
                 return x;
@@ -158,6 +228,9 @@ public:
     }
 
     T mk_or(T x, T y) override {
+        char_set s1, s2;
+        if (x->get_sort() == y->get_sort() && to_set(x, s1) && to_set(y, s2))
+            return mk_set(x->get_sort(), s1 | s2);
         if (x->is_char() && y->is_char() &&
             x->get_char() == y->get_char()) {
             return x;
@@ -205,6 +278,9 @@ public:
     lbool is_sat(T x) override {
         unsigned lo, hi;
         seq_util u(m);
+        char_set s;
+        if (to_set(x, s))
+            return s.empty() ? l_false : l_true;
 
         if (x->is_char()) {
             return l_true;
@@ -229,6 +305,10 @@ public:
     }
 
     T mk_not(T x) override {
+        seq_util u(m);
+        char_set s;
+        if (to_set(x, s))
+            return mk_set(x->get_sort(), s.complement(u.max_char()));
         return sym_expr::mk_not(m, x);    
     }
 
@@ -19,6 +19,7 @@ Notes:
 #include "params/rewriter_params.hpp"
 #include "params/poly_rewriter_params.hpp"
 #include "ast/rewriter/th_rewriter.h"
+#include "ast/rewriter/th_rewriter_cache.h"
 #include "ast/rewriter/bool_rewriter.h"
 #include "ast/rewriter/arith_rewriter.h"
 #include "ast/rewriter/bv_rewriter.h"
@@ -63,6 +64,8 @@ struct th_rewriter_cfg : public default_rewriter_cfg {
       // substitution support
     expr_dependency_ref m_used_dependencies; // set of dependencies of used substitutions
     expr_substitution * m_subst = nullptr;
+    th_rewriter_cache * m_shared_cache = nullptr;
+    unsigned            m_params_id = 0;
     unsigned long long  m_max_memory; // in bytes
     bool                m_new_subst = false;
     expr_fast_mark1     m_visited;
@@ -896,7 +899,7 @@ struct th_rewriter_cfg : public default_rewriter_cfg {
 
     bool get_subst(expr * s, expr * & t, proof * & pr) {
         if (m_subst == nullptr)
-            return false;
+            return m_shared_cache && m_shared_cache->find(s, m_params_id, t);
         expr_dependency * d = nullptr;
         if (m_subst->find(s, t, pr, d)) {
             m_used_dependencies = m().mk_join(m_used_dependencies, d);
@@ -940,6 +943,17 @@ ast_manager & th_rewriter::m() const {
 void th_rewriter::updt_params(params_ref const & p) {
     m_params.append(p);
     m_imp->cfg().updt_params(m_params);
+    if (m_imp->cfg().m_shared_cache)
+        set_cache(m_imp->cfg().m_shared_cache);
+}
+
+void th_rewriter::set_cache(th_rewriter_cache* c) {
+    auto& cfg = m_imp->cfg();
+    if (m().proofs_enabled())
+        c = nullptr;
+    cfg.m_shared_cache = c;
+    cfg.m_params_id = c ? c->mk_params_id(m_params) : 0;
+    m_imp->reset();
 }
 
 void th_rewriter::get_param_descrs(param_descrs & r) {
@@ -972,8 +986,12 @@ unsigned th_rewriter::get_num_steps() const {
 
 void th_rewriter::cleanup() {
     ast_manager & m = m_imp->m();
+    auto* c = m_imp->cfg().m_shared_cache;
+    unsigned id = m_imp->cfg().m_params_id;
     m_imp->~imp();
     new (m_imp) imp(m, m_params);
+    m_imp->cfg().m_shared_cache = c;
+    m_imp->cfg().m_params_id = id;
 }
 
 void th_rewriter::reset() {
@@ -981,10 +999,17 @@ void th_rewriter::reset() {
     m_imp->cfg().reset();
 }
 
+void th_rewriter::cache_result(expr* t, expr* r) {
+    auto& cfg = m_imp->cfg();
+    if (cfg.m_shared_cache && !cfg.m_subst && m().inc())
+        cfg.m_shared_cache->insert(t, cfg.m_params_id, r);
+}
+
 void th_rewriter::operator()(expr_ref & term) {
     expr_ref result(term.get_manager());    
     try {
         m_imp->operator()(term, result);
+        cache_result(term, result);
         term = std::move(result);
     }
     catch (...) {
@@ -997,6 +1022,7 @@ void th_rewriter::operator()(expr_ref & term) {
 void th_rewriter::operator()(expr * t, expr_ref & result) {
     try {
         m_imp->operator()(t, result);
+        cache_result(t, result);
     }
     catch (...) {
         result = t;
@@ -1020,6 +1046,8 @@ void th_rewriter::operator()(expr * t, expr_ref & result, proof_ref & result_pr)
 }
 
 expr_ref th_rewriter::operator()(expr * n, unsigned num_bindings, expr * const * bindings) {
+    // cached results of terms with free variables do not account for the bindings.
+    flet<th_rewriter_cache*> _no_cache(m_imp->cfg().m_shared_cache, nullptr);
     return m_imp->operator()(n, num_bindings, bindings);
 }
 
@@ -26,10 +26,13 @@ class expr_substitution;
 
 class expr_solver;
 
+class th_rewriter_cache;
+
 class th_rewriter {
     struct     imp;
     imp *      m_imp;
     params_ref m_params;
+    void cache_result(expr* t, expr* r);
 public:
     th_rewriter(ast_manager & m, params_ref const & p = params_ref());
     ~th_rewriter();
@@ -76,5 +79,12 @@ public:
 
     void set_solver(expr_solver* solver);
 
+    /**
+       \brief share simplification results with other rewriters through \c c.
+       Top-level results are stored in \c c, and sub-terms found in \c c are
+       not simplified again. Pass nullptr to detach the cache.
+    */
+    void set_cache(th_rewriter_cache* c);
+
 };
 
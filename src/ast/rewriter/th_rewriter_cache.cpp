@@ -0,0 +1,53 @@
+/*++
+Copyright (c) 2024 Microsoft Corporation
+
+Module Name:
+
+    th_rewriter_cache.cpp
+
+Abstract:
+
+    Simplification results shared by several th_rewriter instances.
+
+Notes:
+
+--*/
+#include <sstream>
+#include "ast/rewriter/th_rewriter_cache.h"
+
+unsigned th_rewriter_cache::mk_params_id(params_ref const& p) {
+    std::ostringstream strm;
+    p.display(strm);
+    auto [it, inserted] = m_params2id.emplace(strm.str(), m_params2id.size());
+    return it->second;
+}
+
+bool th_rewriter_cache::find(expr* e, unsigned params_id, expr*& r) {
+    if (!m_cache.find(key(e, params_id), r)) {
+        ++m_misses;
+        return false;
+    }
+    ++m_hits;
+    return true;
+}
+
+void th_rewriter_cache::insert(expr* e, unsigned params_id, expr* r) {
+    if (m_cache.size() >= m_max_size)
+        reset();
+    if (m_max_size == 0)
+        return;
+    if (m_cache.insert_if_not_there(key(e, params_id), r) != r)
+        return;
+    m_pinned.push_back(e);
+    m_pinned.push_back(r);
+}
+
+void th_rewriter_cache::reset() {
+    m_cache.reset();
+    m_pinned.reset();
+}
+
+void th_rewriter_cache::collect_statistics(statistics& st) const {
+    st.update("rewriter cache hits", m_hits);
+    st.update("rewriter cache misses", m_misses);
+}
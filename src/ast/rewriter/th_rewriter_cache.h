@@ -0,0 +1,53 @@
+/*++
+Copyright (c) 2024 Microsoft Corporation
+
+Module Name:
+
+    th_rewriter_cache.h
+
+Abstract:
+
+    Simplification results shared by several th_rewriter instances.
+
+Notes:
+
+--*/
+#pragma once
+
+#include <map>
+#include <string>
+#include "ast/ast.h"
+#include "util/params.h"
+#include "util/statistics.h"
+
+/**
+   \brief Simplification results shared by several th_rewriter instances.
+
+   Entries are keyed by the expression and the parameter set of the
+   rewriter that produced them, so rewriters with different settings
+   do not see each other's results. Keys and values are pinned; the
+   cache is flushed when it exceeds its maximal size.
+   It is only used when proofs are disabled.
+*/
+class th_rewriter_cache {
+    typedef std::pair<expr*, unsigned> key;
+    typedef map<key, expr*, pair_hash<obj_ptr_hash<expr>, unsigned_hash>, default_eq<key>> cache;
+    ast_manager&                    m;
+    cache                           m_cache;
+    expr_ref_vector                 m_pinned;
+    std::map<std::string, unsigned> m_params2id;
+    unsigned                        m_max_size;
+    unsigned                        m_hits = 0;
+    unsigned                        m_misses = 0;
+public:
+    th_rewriter_cache(ast_manager& m, unsigned max_size = UINT_MAX): m(m), m_pinned(m), m_max_size(max_size) {}
+
+    unsigned mk_params_id(params_ref const& p);
+    bool find(expr* e, unsigned params_id, expr*& r);
+    void insert(expr* e, unsigned params_id, expr* r);
+
+    void set_max_size(unsigned sz) { m_max_size = sz; }
+    unsigned size() const { return m_cache.size(); }
+    void reset();
+    void collect_statistics(statistics& st) const;
+};
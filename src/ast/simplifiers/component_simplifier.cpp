@@ -0,0 +1,280 @@
+/*++
+Copyright (c) 2024 Microsoft Corporation
+
+Module Name:
+
+    component_simplifier.cpp
+
+Abstract:
+
+    Run a simplifier on independent components of the assertions in parallel.
+
+--*/
+
+#include <algorithm>
+#include <mutex>
+#include <thread>
+#include "util/union_find.h"
+#include "util/scoped_ptr_vector.h"
+#include "ast/for_each_expr.h"
+#include "ast/recfun_decl_plugin.h"
+#include "ast/simplifiers/component_simplifier.h"
+
+namespace {
+
+    /**
+       \brief assertions of a group of components, owned by the manager of the group.
+    */
+    class component_state : public dependent_expr_state {
+        ast_manager&               m;
+        vector<dependent_expr>     m_fmls;
+        model_reconstruction_trail m_model_trail;
+        bool                       m_updated = false;
+        bool                       m_inconsistent = false;
+    public:
+        component_state(ast_manager& m) : dependent_expr_state(m), m(m), m_model_trail(m, m_trail) {}
+        unsigned qtail() const override { return m_fmls.size(); }
+        dependent_expr const& operator[](unsigned i) override { return m_fmls[i]; }
+        void update(unsigned i, dependent_expr const& j) override {
+            if (m_inconsistent)
+                return;
+            m_updated = true;
+            m_fmls[i] = j;
+            m_inconsistent = m.is_false(j.fml());
+        }
+        void add(dependent_expr const& j) override {
+            if (m_inconsistent)
+                return;
+            m_updated = true;
+            m_fmls.push_back(j);
+            m_inconsistent = m.is_false(j.fml());
+        }
+        bool inconsistent() override { return m_inconsistent; }
+        model_reconstruction_trail& model_trail() override { return m_model_trail; }
+        bool updated() override { return m_updated; }
+        void reset_updated() override { m_updated = false; }
+        vector<dependent_expr> const& fmls() const { return m_fmls; }
+    };
+}
+
+component_simplifier::component_simplifier(ast_manager& m, params_ref const& p, dependent_expr_state& fmls, simplifier_factory const& f):
+    dependent_expr_simplifier(m, fmls),
+    m_factory(f),
+    m_params(p) {
+    m_threads = p.get_uint("threads", 0);
+}
+
+dependent_expr_simplifier& component_simplifier::simp() {
+    if (!m_simp)
+        m_simp = m_factory(m, m_params, m_fmls);
+    return *m_simp;
+}
+
+bool component_simplifier::use_parallel() const {
+#ifdef SINGLE_THREAD
+    return false;
+#else
+    if (m.proofs_enabled() || m.has_trace_stream())
+        return false;
+    if (!m.lambda_defs().empty())
+        return false;
+    recfun::util rec(m);
+    if (rec.has_rec_defs())
+        return false;
+    return qtail() > qhead() + 1;
+#endif
+}
+
+/**
+   \brief partition the unprocessed assertions into groups of components.
+   Return the number of groups.
+*/
+unsigned component_simplifier::mk_groups(vector<unsigned_vector>& groups) {
+    obj_map<func_decl, unsigned> decl2var;
+    basic_union_find uf;
+    unsigned_vector fml2var;
+    ptr_vector<expr> deps;
+    for (unsigned i : indices()) {
+        unsigned v = UINT_MAX;
+        auto add_vars = [&](expr* e) {
+            for (expr* t : subterms::all(expr_ref(e, m))) {
+                if (!is_app(t) || !is_uninterp(t))
+                    continue;
+                func_decl* f = to_app(t)->get_decl();
+                unsigned w;
+                if (!decl2var.find(f, w)) {
+                    w = uf.mk_var();
+                    decl2var.insert(f, w);
+                }
+                if (v == UINT_MAX)
+                    v = w;
+                else
+                    uf.merge(v, w);
+            }
+        };
+        auto const& d = m_fmls[i];
+        add_vars(d.fml());
+        if (d.dep()) {
+            deps.reset();
+            m.linearize(d.dep(), deps);
+            for (expr* e : deps)
+                add_vars(e);
+        }
+        fml2var.push_back(v);
+    }
+
+    vector<unsigned_vector> comps;
+    u_map<unsigned> root2comp;
+    for (unsigned j = 0; j < fml2var.size(); ++j) {
+        unsigned v = fml2var[j], c;
+        if (v == UINT_MAX || !root2comp.find(uf.find(v), c)) {
+            c = comps.size();
+            comps.push_back(unsigned_vector());
+            if (v != UINT_MAX)
+                root2comp.insert(uf.find(v), c);
+        }
+        comps[c].push_back(qhead() + j);
+    }
+
+    unsigned num_threads = get_num_threads(m_threads == 0 ? UINT_MAX : m_threads);
+    unsigned n = std::min(std::max(num_threads, 1u), comps.size());
+    if (n <= 1)
+        return n;
+
+    // place the largest components first, each in the group with the fewest assertions.
+    unsigned_vector order;
+    for (unsigned c = 0; c < comps.size(); ++c)
+        order.push_back(c);
+    std::stable_sort(order.begin(), order.end(), [&](unsigned a, unsigned b) { return comps[a].size() > comps[b].size(); });
+    groups.reset();
+    groups.resize(n);
+    for (unsigned c : order) {
+        unsigned best = 0;
+        for (unsigned g = 1; g < n; ++g)
+            if (groups[g].size() < groups[best].size())
+                best = g;
+        groups[best].append(comps[c]);
+    }
+    for (auto& g : groups)
+        std::sort(g.begin(), g.end());
+    m_stats.update("par-components components", comps.size());
+    return n;
+}
+
+void component_simplifier::reduce_parallel(vector<unsigned_vector> const& groups) {
+#ifndef SINGLE_THREAD
+    unsigned n = groups.size();
+    scoped_ptr_vector<ast_manager> managers;
+    scoped_ptr_vector<component_state> states;
+    scoped_ptr_vector<dependent_expr_simplifier> simps;
+    scoped_limits scl(m.limit());
+    for (unsigned i = 0; i < n; ++i) {
+        ast_manager* new_m = alloc(ast_manager, m, true);
+        managers.push_back(new_m);
+        scl.push_child(&new_m->limit());
+        component_state* st = alloc(component_state, *new_m);
+        states.push_back(st);
+        ast_translation tr(m, *new_m);
+        ast_mark visited;
+        ptr_vector<expr> deps;
+        // symbols that are frozen or occur in the model trail of the main state stay fixed in the group.
+        auto freeze = [&](expr* e) {
+            for (expr* t : subterms::all(expr_ref(e, m)))
+                if (is_app(t) && is_uninterp(t) && !visited.is_marked(to_app(t)->get_decl())) {
+                    func_decl* f = to_app(t)->get_decl();
+                    visited.mark(f, true);
+                    if (m_fmls.frozen(f) || m_fmls.model_trail().is_model_var(f))
+                        st->freeze(tr(f));
+                }
+        };
+        for (unsigned idx : groups[i]) {
+            auto const& d = m_fmls[idx];
+            freeze(d.fml());
+            if (d.dep()) {
+                deps.reset();
+                m.linearize(d.dep(), deps);
+                for (expr* e : deps)
+                    freeze(e);
+            }
+            st->add(dependent_expr(tr, d));
+        }
+        st->reset_updated();
+        simps.push_back(m_factory(*new_m, m_params, *st));
+    }
+
+    std::mutex mux;
+    bool failed = false;
+    std::string ex_msg;
+    auto worker = [&](unsigned i) {
+        try {
+            simps[i]->reduce();
+        }
+        catch (z3_exception& ex) {
+            std::lock_guard<std::mutex> lock(mux);
+            if (!failed) {
+                failed = true;
+                ex_msg = ex.msg();
+                for (ast_manager* mg : managers)
+                    mg->limit().cancel();
+            }
+        }
+    };
+    vector<std::thread> threads(n);
+    for (unsigned i = 0; i < n; ++i)
+        threads[i] = std::thread([&, i]() { worker(i); });
+    for (unsigned i = 0; i < n; ++i)
+        threads[i].join();
+
+    if (failed)
+        throw default_exception(std::move(ex_msg));
+    if (!m.inc())
+        return;
+
+    for (unsigned i = 0; i < n; ++i) {
+        ast_translation tr(*managers[i], m, false);
+        auto const& fmls = states[i]->fmls();
+        auto const& idxs = groups[i];
+        m_fmls.model_trail().append(states[i]->model_trail(), tr);
+        for (unsigned j = 0; j < fmls.size(); ++j) {
+            dependent_expr d(tr, fmls[j]);
+            if (j >= idxs.size())
+                m_fmls.add(d);
+            else if (d.fml() != m_fmls[idxs[j]].fml() || d.dep() != m_fmls[idxs[j]].dep())
+                m_fmls.update(idxs[j], d);
+        }
+        simps[i]->collect_statistics(m_stats);
+    }
+    m_stats.update("par-components groups", n);
+#endif
+}
+
+void component_simplifier::reduce() {
+    vector<unsigned_vector> groups;
+    if (use_parallel() && mk_groups(groups) > 1)
+        reduce_parallel(groups);
+    else
+        simp().reduce();
+}
+
+void component_simplifier::updt_params(params_ref const& p) {
+    m_params.append(p);
+    m_threads = m_params.get_uint("threads", m_threads);
+    simp().updt_params(p);
+}
+
+void component_simplifier::collect_param_descrs(param_descrs& r) {
+    r.insert("threads", CPK_UINT, "maximal number of groups of independent assertions that are simplified in parallel (0 uses the number of cores)", "0");
+    simp().collect_param_descrs(r);
+}
+
+void component_simplifier::collect_statistics(statistics& st) const {
+    st.copy(m_stats);
+    if (m_simp)
+        m_simp->collect_statistics(st);
+}
+
+void component_simplifier::reset_statistics() {
+    m_stats.reset();
+    if (m_simp)
+        m_simp->reset_statistics();
+}
@@ -0,0 +1,53 @@
+/*++
+Copyright (c) 2024 Microsoft Corporation
+
+Module Name:
+
+    component_simplifier.h
+
+Abstract:
+
+    Run a simplifier on independent components of the assertions in parallel.
+
+    The unprocessed assertions are partitioned into components that share
+    no uninterpreted symbols. Components are grouped into at most 'threads'
+    groups; each group is copied into its own ast_manager and simplified
+    there by a fresh instance of the given simplifier. The simplified
+    assertions and the model reconstruction trails are copied back.
+
+    The simplifier is applied directly, without partitioning, when there
+    is only one group, when proofs are enabled, or when recursive function
+    or lambda definitions are present: these live in the manager and are
+    not copied with the assertions.
+
+--*/
+
+#pragma once
+
+#include "ast/simplifiers/dependent_expr_state.h"
+
+class component_simplifier : public dependent_expr_simplifier {
+    simplifier_factory                    m_factory;
+    params_ref                            m_params;
+    scoped_ptr<dependent_expr_simplifier> m_simp;  // used when assertions are not partitioned
+    unsigned                              m_threads = 0;
+    ::statistics                          m_stats;
+
+    dependent_expr_simplifier& simp();
+    bool use_parallel() const;
+    unsigned mk_groups(vector<unsigned_vector>& groups);
+    void reduce_parallel(vector<unsigned_vector> const& groups);
+
+public:
+    component_simplifier(ast_manager& m, params_ref const& p, dependent_expr_state& fmls, simplifier_factory const& f);
+
+    char const* name() const override { return "par-components"; }
+
+    void reduce() override;
+    void push() override { simp().push(); }
+    void pop(unsigned n) override { simp().pop(n); }
+    void updt_params(params_ref const& p) override;
+    void collect_param_descrs(param_descrs& r) override;
+    void collect_statistics(statistics& st) const override;
+    void reset_statistics() override;
+};
@@ -121,6 +121,11 @@ void elim_unconstrained::eliminate() {
         gc(e);
         invalidate_parents(e);
         freeze_rec(r);
+
+        // r takes over the node of e. If r is a variable that was frozen before,
+        // later occurrences of it must freeze the node of e.
+        if (is_uninterp_const(r) && m_frozen.is_marked(r))
+            m_frozen.reset();
         
         m_root.setx(r->get_id(), e->get_id(), UINT_MAX);
         get_node(e).m_term = r;
@@ -186,6 +191,7 @@ void elim_unconstrained::init_nodes() {
     m_heap.reset();
     m_root.reset();
     m_nodes.reset();
+    m_frozen.reset();
 
     // initialize nodes for terms in the original goal
     init_terms(terms);
@@ -235,18 +241,29 @@ void elim_unconstrained::init_terms(expr_ref_vector const& terms) {
     }
 }
 
+/**
+ * freeze the variables occurring below r.
+ * Results of inversion share sub-terms with the arguments they were built from,
+ * so sub-terms that were already visited in this round are not traversed again.
+ */
 void elim_unconstrained::freeze_rec(expr* r) {
-    expr_ref_vector children(m);
+    ptr_buffer<expr> todo;
     if (is_quantifier(r))
-        children.push_back(to_quantifier(r)->get_expr());
+        todo.push_back(to_quantifier(r)->get_expr());
     else if (is_app(r))
-        children.append(to_app(r)->get_num_args(), to_app(r)->get_args());
-    else
-        return;
-    if (children.empty())
-        return;
-    for (expr* t : subterms::all(children))
+        todo.append(to_app(r)->get_num_args(), to_app(r)->get_args());
+    while (!todo.empty()) {
+        expr* t = todo.back();
+        todo.pop_back();
+        if (m_frozen.is_marked(t))
+            continue;
+        m_frozen.mark(t, true);
         freeze(t);
+        if (is_app(t))
+            todo.append(to_app(t)->get_num_args(), to_app(t)->get_args());
+        else if (is_quantifier(t))
+            todo.push_back(to_quantifier(t)->get_expr());
+    }
 }
 
 void elim_unconstrained::freeze(expr* t) {
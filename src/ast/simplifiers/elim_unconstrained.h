@@ -51,6 +51,7 @@ class elim_unconstrained : public dependent_expr_simplifier {
     expr_ref_vector          m_args;
     stats                    m_stats;
     unsigned_vector          m_root;
+    expr_epoch_mark          m_frozen;              // sub-terms whose variables were frozen in this round
     bool                     m_created_compound = false;
     bool                     m_enable_proofs = false;
 
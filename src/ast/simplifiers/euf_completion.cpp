@@ -341,6 +341,65 @@ namespace euf {
         st.update("euf-completion-rewrites", m_stats.m_num_rewrites);        
     }
 
+    /**
+     * Select the representative of least cost in each class.
+     * Values cost nothing, other terms cost one more than the sum of the costs of
+     * their arguments' classes, which is the size of the extracted term as a tree.
+     * Costs are computed by a fixed point that revisits a class only when the cost
+     * of one of its argument classes decreased.
+     * The roots are marked, and the classes of all arguments of their members are roots.
+     */
+    void completion::select_reps(enode_vector const& roots) {
+        unsigned const inf = UINT_MAX;
+        enode_vector todo;
+        for (enode* r : roots) {
+            m_costs.setx(r->get_id(), inf, inf);
+            m_reps.setx(r->get_id(), nullptr, nullptr);
+            todo.push_back(r);
+        }
+        auto cost_of = [&](enode* k) {
+            if (m.is_value(k->get_expr()))
+                return 0u;
+            unsigned c = 1;
+            for (enode* arg : enode_args(k)) {
+                unsigned a = m_costs[arg->get_root()->get_id()];
+                if (a == inf || c + a < c || c + a == inf)
+                    return inf;
+                c += a;
+            }
+            return c;
+        };
+        while (!todo.empty()) {
+            enode* r = todo.back();
+            todo.pop_back();
+            unsigned best = m_costs[r->get_id()];
+            enode* rep = nullptr;
+            for (enode* k : enode_class(r)) {
+                unsigned c = cost_of(k);
+                if (c < best)
+                    best = c, rep = k;
+            }
+            if (!rep)
+                continue;
+            m_costs[r->get_id()] = best;
+            m_reps[r->get_id()] = rep;
+            for (enode* p : enode_parents(r))
+                if (p->get_root()->is_marked1())
+                    todo.push_back(p->get_root());
+        }
+        for (enode* r : roots) {
+            enode* rep = m_reps[r->get_id()];
+            if (!rep) {
+                for (enode* k : enode_class(r))
+                    if (!rep || get_depth(rep->get_expr()) > get_depth(k->get_expr()))
+                        rep = k;
+                m_reps[r->get_id()] = rep;
+            }
+            TRACE("euf_completion", tout << "rep " << m_egraph.bpp(r) << " -> " << m_egraph.bpp(rep) << " cost " << m_costs[r->get_id()] << "\n";
+                  for (enode* k : enode_class(r)) tout << m_egraph.bpp(k) << "\n";);
+        }
+    }
+
     void completion::map_canonical() {
         m_todo.reset();
         enode_vector roots;
@@ -352,21 +411,16 @@ namespace euf {
                 continue;
             n->mark1();
             roots.push_back(n);
-            enode* rep = nullptr;
-            for (enode* k : enode_class(n)) 
-                if (!rep || m.is_value(k->get_expr()) || get_depth(rep->get_expr()) > get_depth(k->get_expr()))
-                    rep = k;
-            m_reps.setx(n->get_id(), rep, nullptr);
-
-            TRACE("euf_completion", tout << "rep " << m_egraph.bpp(n) << " -> " << m_egraph.bpp(rep) << "\n";
-                         for (enode* k : enode_class(n)) tout << m_egraph.bpp(k) << "\n";);
             m_todo.push_back(n->get_expr());
-            for (enode* arg : enode_args(n)) {
-                arg = arg->get_root();
-                if (!arg->is_marked1())
-                    m_nodes_to_canonize.push_back(arg);
+            for (enode* k : enode_class(n)) {
+                for (enode* arg : enode_args(k)) {
+                    arg = arg->get_root();
+                    if (!arg->is_marked1())
+                        m_nodes_to_canonize.push_back(arg);
+                }
             }
         }
+        select_reps(roots);
         for (enode* r : roots)
             r->unmark1();
 
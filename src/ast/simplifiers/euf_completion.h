@@ -38,6 +38,7 @@ namespace euf {
         expr_dependency_ref_vector m_deps;
         unsigned               m_epoch = 0;
         unsigned_vector        m_epochs;
+        unsigned_vector        m_costs;
         th_rewriter            m_rewriter;
         stats                  m_stats;
         bool                   m_has_new_eq = false;
@@ -48,6 +49,7 @@ namespace euf {
         expr_ref mk_and(expr* a, expr* b);
         void add_egraph();
         void map_canonical();
+        void select_reps(enode_vector const& roots);
         void read_egraph();
         expr_ref canonize(expr* f, expr_dependency_ref& dep);
         expr_ref canonize_fml(expr* f, expr_dependency_ref& dep);
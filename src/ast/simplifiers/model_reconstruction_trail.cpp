@@ -143,6 +143,37 @@ void model_reconstruction_trail::replay(unsigned qhead, expr_ref_vector& assumpt
     }
 }
 
+void model_reconstruction_trail::append(model_reconstruction_trail const& src, ast_translation& tr) {
+    SASSERT(&tr.from() == &src.m && &tr.to() == &m);
+    expr_dependency_translation dtr(tr);
+    for (auto* t : src.m_trail) {
+        if (!t->m_active)
+            continue;
+        vector<dependent_expr> removed;
+        for (auto const& d : t->m_removed)
+            removed.push_back(dependent_expr(tr, d));
+        if (t->is_hide())
+            hide(tr(t->m_decl.get()));
+        else if (t->is_def()) {
+            vector<std::tuple<func_decl_ref, expr_ref, expr_dependency_ref>> defs;
+            for (auto const& [f, def, dep] : t->m_defs)
+                defs.push_back({ func_decl_ref(tr(f.get()), m), expr_ref(tr(def.get()), m), expr_dependency_ref(dtr(dep.get()), m) });
+            push(defs, removed);
+        }
+        else if (t->m_subst) {
+            expr_substitution* s = alloc(expr_substitution, m, t->m_subst->unsat_core_enabled(), t->m_subst->proofs_enabled());
+            for (auto const& [k, v] : t->m_subst->sub()) {
+                expr* def = nullptr;
+                proof* pr = nullptr;
+                expr_dependency* dep = nullptr;
+                t->m_subst->find(k, def, pr, dep);
+                s->insert(tr(k), tr(v), tr(pr), dtr(dep));
+            }
+            push(s, removed);
+        }
+    }
+}
+
 /**
  * retrieve the current model converter corresponding to chaining substitutions from the trail.
  */
@@ -191,6 +191,16 @@ public:
     void replay(unsigned qhead, expr_ref_vector& assumptions, dependent_expr_state& fmls);
     
 
+    /**
+     * check if f occurs in the trail.
+     */
+    bool is_model_var(func_decl* f) const { return m_model_vars.is_marked(f); }
+
+    /**
+     * append the active entries of a trail over another manager.
+     */
+    void append(model_reconstruction_trail const& src, ast_translation& tr);
+
     /**
      * retrieve the current model converter corresponding to chaining substitutions from the trail.
      */
@@ -0,0 +1,82 @@
+/*++
+Copyright (c) 2024 Microsoft Corporation
+
+Module Name:
+
+    seq_length_abstraction.cpp
+
+Abstract:
+
+    Add the linear length abstraction of sequence constraints.
+
+--*/
+
+#include "ast/ast_util.h"
+#include "ast/for_each_expr.h"
+#include "ast/simplifiers/seq_length_abstraction.h"
+
+void seq_length_abstraction_simplifier::add(expr* e, expr_dependency* d) {
+    expr_ref r(m);
+    m_rewriter(e, r);
+    if (m.is_true(r) || m_added.contains(r))
+        return;
+    m_pinned.push_back(r);
+    m_trail.push(push_back_vector(m_pinned));
+    m_added.insert(r);
+    m_trail.push(insert_obj_trail(m_added, r.get()));
+    ++m_num_constraints;
+    m_fmls.add(dependent_expr(m, r, nullptr, d));
+}
+
+/**
+   \brief lengths of sequence variables are non-negative. The sequence solver
+   adds these axioms lazily when the length terms are internalized.
+*/
+void seq_length_abstraction_simplifier::add_non_negative(expr* s, expr_dependency* d) {
+    for (expr* t : subterms::ground(expr_ref(s, m)))
+        if (is_uninterp_const(t) && m_seq.is_seq(t))
+            add(m_arith.mk_ge(m_seq.str.mk_length(t), m_arith.mk_int(0)), d);
+}
+
+void seq_length_abstraction_simplifier::abstract(expr* e, expr_dependency* d) {
+    expr* a = nullptr, *b = nullptr;
+    auto len = [&](expr* s) { return expr_ref(m_seq.str.mk_length(s), m); };
+    if (m.is_eq(e, a, b) && m_seq.is_seq(a)) {
+        add(m.mk_eq(len(a), len(b)), d);
+        add_non_negative(a, d);
+        add_non_negative(b, d);
+    }
+    else if (m_seq.str.is_in_re(e, a, b)) {
+        unsigned lo = m_seq.re.min_length(b);
+        unsigned hi = m_seq.re.max_length(b);
+        if (lo > 0)
+            add(m_arith.mk_ge(len(a), m_arith.mk_int(lo)), d);
+        if (hi != UINT_MAX)
+            add(m_arith.mk_le(len(a), m_arith.mk_int(hi)), d);
+        add_non_negative(a, d);
+    }
+    else if (m_seq.str.is_prefix(e, a, b) || m_seq.str.is_suffix(e, a, b)) {
+        add(m_arith.mk_le(len(a), len(b)), d);
+        add_non_negative(a, d);
+        add_non_negative(b, d);
+    }
+    else if (m_seq.str.is_contains(e, a, b)) {
+        add(m_arith.mk_le(len(b), len(a)), d);
+        add_non_negative(a, d);
+        add_non_negative(b, d);
+    }
+}
+
+void seq_length_abstraction_simplifier::reduce() {
+    expr_ref_vector conjs(m);
+    for (unsigned idx : indices()) {
+        auto const& [f, p, d] = m_fmls[idx]();
+        conjs.reset();
+        flatten_and(f, conjs);
+        for (expr* e : conjs) {
+            if (m_fmls.inconsistent() || !m.inc())
+                return;
+            abstract(e, d);
+        }
+    }
+}
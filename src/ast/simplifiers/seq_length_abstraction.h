@@ -0,0 +1,63 @@
+/*++
+Copyright (c) 2024 Microsoft Corporation
+
+Module Name:
+
+    seq_length_abstraction.h
+
+Abstract:
+
+    Add the linear length abstraction of sequence constraints.
+
+    For every top-level equation s = t over sequences, membership s in R,
+    prefix, suffix and containment constraint, the implied linear
+    constraint over the lengths of the arguments is asserted together with
+    the non-negativity of the lengths of the sequence variables involved.
+    The constraints are seen by the arithmetic solver before the sequence
+    solver starts splitting, so that length conflicts are found without
+    string search and lengths that are fixed by the abstraction are
+    propagated eagerly.
+
+--*/
+
+#pragma once
+
+#include "ast/simplifiers/dependent_expr_state.h"
+#include "ast/rewriter/th_rewriter.h"
+#include "ast/seq_decl_plugin.h"
+#include "ast/arith_decl_plugin.h"
+
+
+class seq_length_abstraction_simplifier : public dependent_expr_simplifier {
+    seq_util         m_seq;
+    arith_util       m_arith;
+    th_rewriter      m_rewriter;
+    obj_hashtable<expr> m_added;     // constraints that were added, removed again on pop
+    expr_ref_vector  m_pinned;
+    unsigned         m_num_constraints = 0;
+
+    void add(expr* e, expr_dependency* d);
+    void add_non_negative(expr* s, expr_dependency* d);
+    void abstract(expr* e, expr_dependency* d);
+
+public:
+    seq_length_abstraction_simplifier(ast_manager& m, params_ref const& p, dependent_expr_state& fmls):
+        dependent_expr_simplifier(m, fmls), m_seq(m), m_arith(m), m_rewriter(m, p), m_pinned(m) {
+    }
+
+    char const* name() const override { return "seq-length-abstraction"; }
+
+    bool supports_proofs() const override { return false; }
+
+    void reduce() override;
+
+    void collect_statistics(statistics& st) const override {
+        st.update("seq-length-abstraction constraints", m_num_constraints);
+    }
+
+    void reset_statistics() override { m_num_constraints = 0; }
+};
+
+/*
+  ADD_SIMPLIFIER("seq-length-abstraction", "add linear length constraints implied by sequence constraints.", "alloc(seq_length_abstraction_simplifier, m, p, s)")
+*/
@@ -78,6 +78,47 @@ namespace euf {
                 m_next[var2id(eq.var)].push_back(eq);
     }
 
+    /**
+    * Determine whether e contains a solvable variable.
+    * The result is cached for all sub-terms, so shared sub-terms without
+    * variables are traversed once per round instead of once per equation.
+    */
+    bool solve_eqs::has_var(expr* e) {
+        if (m_has_var_known.is_marked(e))
+            return m_has_var.is_marked(e);
+        ptr_buffer<expr> todo;
+        todo.push_back(e);
+        while (!todo.empty()) {
+            expr* t = todo.back();
+            if (m_has_var_known.is_marked(t)) {
+                todo.pop_back();
+                continue;
+            }
+            bool has = is_var(t), done = true;
+            auto visit = [&](expr* arg) {
+                if (!m_has_var_known.is_marked(arg)) {
+                    todo.push_back(arg);
+                    done = false;
+                }
+                else if (m_has_var.is_marked(arg))
+                    has = true;
+            };
+            if (is_app(t)) {
+                for (expr* arg : *to_app(t))
+                    visit(arg);
+            }
+            else if (is_quantifier(t))
+                visit(to_quantifier(t)->get_expr());
+            if (!done)
+                continue;
+            todo.pop_back();
+            m_has_var_known.mark(t, true);
+            if (has)
+                m_has_var.mark(t, true);
+        }
+        return m_has_var.is_marked(e);
+    }
+
     /**
     * Build a substitution while assigning levels to terms.
     * The substitution is well-formed when variables are replaced with terms whose
@@ -88,6 +129,8 @@ namespace euf {
         m_id2level.resize(m_id2var.size(), UINT_MAX);
         m_subst_ids.reset();
         m_subst = alloc(expr_substitution, m, true, false);        
+        m_has_var_known.reset();
+        m_has_var.reset();
 
         auto is_explored = [&](unsigned id) {
             return m_id2level[id] != UINT_MAX;
@@ -134,6 +177,8 @@ namespace euf {
                         if (visited.is_marked(e))
                             continue;
                         visited.mark(e, true);
+                        if (!has_var(e))
+                            continue;
                         if (is_app(e)) {
                             for (expr* arg : *to_app(e))
                                 m_todo.push_back(arg);
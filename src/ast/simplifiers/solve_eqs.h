@@ -56,6 +56,8 @@ namespace euf {
         expr_mark                     m_unsafe_vars;   // expressions that cannot be replaced
         ptr_vector<expr>              m_todo;
         expr_mark                     m_visited;
+        expr_epoch_mark               m_has_var_known; // sub-terms for which m_has_var is determined
+        expr_epoch_mark               m_has_var;       // sub-terms containing a solvable variable
         obj_map<expr, unsigned>       m_num_occs;
 
 
@@ -64,6 +66,7 @@ namespace euf {
         bool can_be_var(expr* e) const { return is_uninterp_const(e) && !m_unsafe_vars.is_marked(e) && check_occs(e); }
         void get_eqs(dep_eq_vector& eqs);
         void filter_unsafe_vars();        
+        bool has_var(expr* e);
         void extract_subst();
         void extract_dep_graph(dep_eq_vector& eqs);
         void normalize();
@@ -18,6 +18,7 @@ Author:
 #pragma once
 
 #include "util/stopwatch.h"
+#include "util/phase_profiler.h"
 #include "ast/simplifiers/dependent_expr_state.h"
 
 
@@ -28,13 +29,17 @@ class then_simplifier : public dependent_expr_simplifier {
         stopwatch       m_watch;
         double          m_start_memory = 0;
         dependent_expr_simplifier& s;
+        phase_scope     m_profile;
         collect_stats(dependent_expr_simplifier& s) : 
             m_start_memory(static_cast<double>(memory::get_allocation_size()) / static_cast<double>(1024 * 1024)), 
-            s(s) {
+            s(s),
+            m_profile(s.name(), phase_profiler::enabled() ? s.get_fmls().num_exprs() : 0) {
             m_watch.start();
         }
         ~collect_stats() {
             m_watch.stop();
+            if (phase_profiler::enabled())
+                m_profile.set_size_after(s.get_fmls().num_exprs());
             double end_memory = static_cast<double>(memory::get_allocation_size()) / static_cast<double>(1024 * 1024);
             IF_VERBOSE(10,
                 statistics st;
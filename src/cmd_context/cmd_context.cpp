@@ -965,6 +965,8 @@ void cmd_context::insert(symbol const & s, psort_decl * p) {
         throw cmd_exception("sort already defined ", _s);
     }
     m_psort_decls.insert(s, p);
+    // cached results do not record sort definitions.
+    m_check_sat_cache.reset();
     if (!m_global_decls) {
         m_psort_decls_stack.push_back(s);
     }
@@ -1499,6 +1501,7 @@ void cmd_context::insert_aux_pdecl(pdecl * p) {
 void cmd_context::reset(bool finalize) {    
     m_logic = symbol::null;
     m_check_sat_result = nullptr;
+    m_check_sat_cache.reset();
     m_numeral_as_real = false;
     m_builtin_decls.reset();
     m_extra_builtin_decls.reset();
@@ -1645,6 +1648,8 @@ void cmd_context::restore_psort_decls(unsigned old_sz) {
         pm().dec_ref(d);
         m_psort_decls.erase(s);
     }
+    if (old_sz < m_psort_decls_stack.size())
+        m_check_sat_cache.reset();
     m_psort_decls_stack.shrink(old_sz);
 }
 
@@ -1737,6 +1742,9 @@ void cmd_context::check_sat(unsigned num_assumptions, expr * const * assumptions
     unsigned rlimit  = m_params.rlimit();
     scoped_watch sw(*this);
     lbool r;
+    expr_ref_vector cache_key(m());
+    func_decl_ref_vector cache_decls(m());
+    unsigned cache_hash = 0, cache_num_assertions = 0;
 
     if (m_opt && !m_opt->empty()) {
         bool is_clear = m_check_sat_result == nullptr;
@@ -1772,6 +1780,11 @@ void cmd_context::check_sat(unsigned num_assumptions, expr * const * assumptions
         }
         get_opt()->set_status(r);
     }
+    else if (m_solver && m_params.m_check_sat_cache > 0 && !m_params.m_proof &&
+             (cache_hash = mk_check_sat_cache_key(num_assumptions, assumptions, cache_key, cache_decls, cache_num_assertions),
+              find_check_sat_cache(cache_key, cache_decls, cache_num_assertions, cache_hash, r))) {
+        IF_VERBOSE(10, verbose_stream() << "(check-sat :cached)\n");
+    }
     else if (m_solver) {
         m_check_sat_result = m_solver.get(); // solver itself stores the result.
         m_solver->set_progress_callback(this);
@@ -1798,6 +1811,8 @@ void cmd_context::check_sat(unsigned num_assumptions, expr * const * assumptions
             r = l_undef;
         }
         m_solver->set_status(r);
+        if (!cache_key.empty() && r != l_undef)
+            insert_check_sat_cache(cache_key, cache_decls, cache_num_assertions, cache_hash, r);
     }
     else {
         // There is no solver installed in the command context.
@@ -1815,6 +1830,98 @@ void cmd_context::check_sat(unsigned num_assumptions, expr * const * assumptions
     }
 }
 
+/**
+   \brief the key of a check-sat command is the set of assertions, with named
+   assertions guarded by their names, followed by the set of assumptions.
+   Both sets are sorted by expression id, so the order and repetition of
+   assertions do not matter.
+   The declarations in scope are part of the key, since models are completed
+   for declared functions that do not occur in the assertions.
+*/
+unsigned cmd_context::mk_check_sat_cache_key(unsigned num_assumptions, expr * const * assumptions, expr_ref_vector& key, func_decl_ref_vector& decls, unsigned& num_assertions) {
+    key.reset();
+    decls.reset();
+    for (auto& kv : m_func_decls) 
+        for (unsigned i = 0; i < kv.m_value.get_num_entries(); ++i)
+            if (func_decl* f = kv.m_value.get_entry(i))
+                decls.push_back(f);
+    std::sort(decls.data(), decls.data() + decls.size(), [](func_decl* a, func_decl* b) { return a->get_id() < b->get_id(); });
+    for (unsigned i = 0; i < m_assertions.size(); ++i) {
+        if (m_assertion_names.size() > i && m_assertion_names[i]) 
+            key.push_back(m().mk_implies(m_assertion_names[i], m_assertions[i]));
+        else
+            key.push_back(m_assertions[i]);
+    }
+    auto sort_unique = [&](unsigned start) {
+        std::sort(key.data() + start, key.data() + key.size(), [](expr* a, expr* b) { return a->get_id() < b->get_id(); });
+        unsigned j = start;
+        for (unsigned i = start; i < key.size(); ++i)
+            if (j == start || key.get(j - 1) != key.get(i))
+                key[j++] = key.get(i);
+        key.shrink(j);
+    };
+    sort_unique(0);
+    num_assertions = key.size();
+    key.append(num_assumptions, assumptions);
+    sort_unique(num_assertions);
+    unsigned h = num_assertions;
+    for (expr* e : key)
+        h = hash_u_u(h, e->get_id());
+    for (func_decl* f : decls)
+        h = hash_u_u(h, f->get_id());
+    return h;
+}
+
+bool cmd_context::find_check_sat_cache(expr_ref_vector const& key, func_decl_ref_vector const& decls, unsigned num_assertions, unsigned hash, lbool& r) {
+    for (check_sat_cache_entry* e : m_check_sat_cache) {
+        if (e->m_hash != hash || e->m_num_assertions != num_assertions || e->m_key.size() != key.size() || e->m_decls.size() != decls.size())
+            continue;
+        bool eq = true;
+        for (unsigned i = 0; eq && i < key.size(); ++i)
+            eq = e->m_key.get(i) == key.get(i);
+        for (unsigned i = 0; eq && i < decls.size(); ++i)
+            eq = e->m_decls.get(i) == decls.get(i);
+        if (!eq)
+            continue;
+        e->m_last_use = ++m_check_sat_cache_stamp;
+        m_check_sat_result = e->m_result;
+        r = e->m_result->status();
+        return true;
+    }
+    return false;
+}
+
+void cmd_context::insert_check_sat_cache(expr_ref_vector const& key, func_decl_ref_vector const& decls, unsigned num_assertions, unsigned hash, lbool r) {
+    SASSERT(r != l_undef);
+    simple_check_sat_result* result = alloc(simple_check_sat_result, m());
+    result->set_status(r);
+    m_solver->collect_statistics(result->m_stats);
+    if (r == l_true) 
+        m_solver->get_model(result->m_model);
+    else 
+        m_solver->get_unsat_core(result->m_core);
+    check_sat_cache_entry* e = nullptr;
+    if (m_check_sat_cache.size() < m_params.m_check_sat_cache) {
+        e = alloc(check_sat_cache_entry, m());
+        m_check_sat_cache.push_back(e);
+    }
+    else {
+        // evict the least recently used entry
+        e = m_check_sat_cache[0];
+        for (check_sat_cache_entry* f : m_check_sat_cache)
+            if (f->m_last_use < e->m_last_use)
+                e = f;
+    }
+    e->m_key.reset();
+    e->m_key.append(key);
+    e->m_decls.reset();
+    e->m_decls.append(decls);
+    e->m_num_assertions = num_assertions;
+    e->m_hash = hash;
+    e->m_last_use = ++m_check_sat_cache_stamp;
+    e->m_result = result;
+}
+
 void cmd_context::get_consequences(expr_ref_vector const& assumptions, expr_ref_vector const& vars, expr_ref_vector & conseq) {
     unsigned timeout = m_params.m_timeout;
     unsigned rlimit  = m_params.rlimit();
@@ -297,6 +297,19 @@ protected:
     ref<check_sat_result>        m_check_sat_result;
     ref<opt_wrapper>             m_opt;
 
+    // results of earlier check-sat commands, see m_params.m_check_sat_cache.
+    struct check_sat_cache_entry {
+        expr_ref_vector         m_key;            // sorted assertions followed by sorted assumptions
+        func_decl_ref_vector    m_decls;          // sorted declarations in scope
+        unsigned                m_num_assertions;
+        unsigned                m_hash;
+        unsigned                m_last_use;
+        ref<check_sat_result>   m_result;
+        check_sat_cache_entry(ast_manager& m): m_key(m), m_decls(m), m_num_assertions(0), m_hash(0), m_last_use(0) {}
+    };
+    scoped_ptr_vector<check_sat_cache_entry> m_check_sat_cache;
+    unsigned                     m_check_sat_cache_stamp = 0;
+
     stopwatch                    m_watch;
 
     class dt_eh : public new_datatype_eh {
@@ -430,6 +443,9 @@ public:
     check_sat_state cs_state() const;
     void complete_model(model_ref& mdl) const;
     void validate_model();
+    unsigned mk_check_sat_cache_key(unsigned num_assumptions, expr * const * assumptions, expr_ref_vector& key, func_decl_ref_vector& decls, unsigned& num_assertions);
+    bool find_check_sat_cache(expr_ref_vector const& key, func_decl_ref_vector const& decls, unsigned num_assertions, unsigned hash, lbool& r);
+    void insert_check_sat_cache(expr_ref_vector const& key, func_decl_ref_vector const& decls, unsigned num_assertions, unsigned hash, lbool r);
     void analyze_failure(expr_mark& seen, model_evaluator& ev, expr* e, bool expected_value);
     void display_detailed_analysis(std::ostream& out, model_evaluator& ev, expr* e);
     void display_model(model_ref& mdl);
@@ -22,6 +22,7 @@ Author:
 #include "model/model_smt2_pp.h"
 #include "ast/ast_smt2_pp.h"
 #include "ast/simplifiers/then_simplifier.h"
+#include "ast/simplifiers/component_simplifier.h"
 #include "solver/simplifier_solver.h"
 
 typedef dependent_expr_simplifier simplifier;
@@ -70,6 +71,17 @@ static simplifier_factory mk_using_params(cmd_context & ctx, sexpr * n) {
     return result;
 }
 
+static simplifier_factory mk_par_components(cmd_context & ctx, sexpr * n) {
+    SASSERT(n->is_composite());
+    unsigned num_children = n->get_num_children();
+    if (num_children != 2)
+        throw cmd_exception("invalid par-components combinator, one argument expected", n->get_line(), n->get_pos());
+    simplifier_factory fac = sexpr2simplifier(ctx, n->get_child(1));
+    simplifier_factory result = [fac](ast_manager& m, const params_ref& p, dependent_expr_state& st) {
+        return alloc(component_simplifier, m, p, st, fac);
+    };
+    return result;
+}
 
 simplifier_factory sexpr2simplifier(cmd_context & ctx, sexpr * n) {
     if (n->is_symbol()) {
@@ -90,6 +102,8 @@ simplifier_factory sexpr2simplifier(cmd_context & ctx, sexpr * n) {
             return mk_and_then(ctx, n);
         else if (cmd_name == "!" || cmd_name == "using-params" || cmd_name == "with")
             return mk_using_params(ctx, n);
+        else if (cmd_name == "par-components")
+            return mk_par_components(ctx, n);
         else
             throw cmd_exception("invalid tactic, unknown tactic combinator ", cmd_name, n->get_line(), n->get_pos());
     }
@@ -104,6 +118,7 @@ void help_simplifier(cmd_context & ctx) {
     buf << "combinators:\n";
     buf << "- (and-then <simplifier>+) executes the given simplifiers sequentially.\n";
     buf << "- (using-params <tactic> <attribute>*) executes the given simplifier using the given attributes, where <attribute> ::= <keyword> <value>. ! is syntax sugar for using-params.\n";
+    buf << "- (par-components <simplifier>) executes the given simplifier in parallel on groups of assertions that share no uninterpreted symbols.\n";
     buf << "builtin simplifiers:\n";
     for (simplifier_cmd* cmd : ctx.simplifiers()) {
         buf << "- " << cmd->get_name() << " " << cmd->get_descr() << "\n";
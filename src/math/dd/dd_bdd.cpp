@@ -152,6 +152,10 @@ namespace dd {
         if (is_const(a) && is_const(b)) {
             return m_apply_const[a + 2*b + 4*op];
         }
+        // all binary operations are commutative, normalize the
+        // arguments so that both orders share one cache entry.
+        if (a > b)
+            std::swap(a, b);
         op_entry * e1 = pop_entry(a, b, op);
         op_entry const* e2 = m_op_cache.insert_if_not_there(e1);
         if (check_result(e1, e2, a, b, op)) {
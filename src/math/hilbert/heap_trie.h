@@ -42,6 +42,7 @@ Notes:
 #include "util/buffer.h"
 #include "util/statistics.h"
 #include "util/small_object_allocator.h"
+#include "util/trace.h"
 
 template<typename Key, typename KeyLE, typename KeyHash, typename Value>
 class heap_trie {
@@ -557,11 +558,7 @@ private:
         if (index == num_keys()) {
             SASSERT(n->ref_count() > 0);
             bool r = check(to_leaf(n)->get_value());
-            IF_VERBOSE(2, 
-                       for (unsigned j = 0; j < index; ++j) {
-                           verbose_stream() << " ";
-                       }
-                       verbose_stream() << to_leaf(n)->get_value() << (r?" hit\n":" miss\n"););
+            TRACE("heap_trie", tout << std::string(index, ' ') << to_leaf(n)->get_value() << (r?" hit\n":" miss\n"););
             return r;
         }
         else {
@@ -570,11 +567,7 @@ private:
             for (unsigned i = 0; i < nodes.size(); ++i) {
                 ++m_stats.m_num_find_le_nodes;
                 node* m = nodes[i].second;
-                IF_VERBOSE(2,
-                           for (unsigned j = 0; j < index; ++j) {
-                               verbose_stream() << " ";
-                           }
-                           verbose_stream() << nodes[i].first << " <=? " << key << " rc:" << m->ref_count() << "\n";);
+                TRACE("heap_trie", tout << std::string(index, ' ') << nodes[i].first << " <=? " << key << " rc:" << m->ref_count() << "\n";);
                 if (m->ref_count() > 0 && m_le.le(nodes[i].first, key) && find_le(m, index+1, keys, check)) {
                     if (i > 0) {
                         std::swap(nodes[i], nodes[0]);
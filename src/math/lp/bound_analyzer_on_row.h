@@ -69,13 +69,20 @@ private:
 
     unsigned analyze() {
         unsigned num_prop = 0;
+        bool has_interesting = false;
         for (const auto & c : m_row) {
             if ((m_column_of_l == -2) && (m_column_of_u == -2))
                 return 0;
             analyze_bound_on_var_on_coeff(c.var(), c.coeff());
+            has_interesting |= m_bp.column_is_interesting(c.var());
         }
+        // the row cannot imply a bound that is used, skip the rational arithmetic
+        if (!has_interesting)
+            return 0;
         ++num_prop;
-        if (m_column_of_u >= 0)
+        if (m_column_of_u >= 0 && !m_bp.column_is_interesting(m_column_of_u))
+            --num_prop;
+        else if (m_column_of_u >= 0)
             limit_monoid_u_from_below();
         else if (m_column_of_u == -1)
             limit_all_monoids_from_below();
@@ -83,7 +90,9 @@ private:
             --num_prop;
 
         ++num_prop;
-        if (m_column_of_l >= 0)
+        if (m_column_of_l >= 0 && !m_bp.column_is_interesting(m_column_of_l))
+            --num_prop;
+        else if (m_column_of_l >= 0)
             limit_monoid_l_from_above();
         else if (m_column_of_l == -1)
             limit_all_monoids_from_above();
@@ -164,6 +173,8 @@ private:
         }
         
         for (const auto &p : m_row) {
+            if (!m_bp.column_is_interesting(p.var()))
+                continue;
             bool str;
             bool a_is_pos = is_pos(p.coeff());
             m_bound = m_total;
@@ -190,6 +201,8 @@ private:
         }
 
         for (const auto& p : m_row) {
+            if (!m_bp.column_is_interesting(p.var()))
+                continue;
             bool str;
             bool a_is_pos = is_pos(p.coeff());
             m_bound = m_total;
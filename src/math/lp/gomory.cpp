@@ -479,10 +479,46 @@ public:
         return ret;
     }
 
+    /**
+       \brief distance of the current solution to the hyperplane t = k of the cut t >= k.
+     */
+    double gomory::efficacy(const lar_term& t, const mpq& k) const {
+        double val = 0, norm = 0;
+        for (lar_term::ival p : t) {
+            double c = p.coeff().get_double();
+            val += c * lia.get_value(p.j()).x.get_double();
+            norm += c * c;
+        }
+        return norm == 0 ? 0 : (k.get_double() - val) / std::sqrt(norm);
+    }
+
+    /**
+       \brief cosine of the angle between the normals of two cuts.
+     */
+    double gomory::parallelism(const lar_term& t1, const lar_term& t2) {
+        double dot = 0, norm1 = 0, norm2 = 0;
+        mpq c2;
+        for (lar_term::ival p : t1) {
+            double c = p.coeff().get_double();
+            norm1 += c * c;
+            if (t2.coeffs().find(p.j(), c2))
+                dot += c * c2.get_double();
+        }
+        for (lar_term::ival p : t2) {
+            double c = p.coeff().get_double();
+            norm2 += c * c;
+        }
+        return norm1 == 0 || norm2 == 0 ? 0 : std::abs(dot) / std::sqrt(norm1 * norm2);
+    }
+
+    /**
+       \brief create cuts from twice num_cuts rows of int infeasible basic columns and
+       keep the num_cuts most efficacious cuts that are not almost parallel to a better cut.
+     */
     lia_move gomory::get_gomory_cuts(unsigned num_cuts) {
-        struct cut_result {lar_term t; mpq k; u_dependency *dep;};
-        vector<cut_result> big_cuts;
-        unsigned_vector columns_for_cuts = gomory_select_int_infeasible_vars(num_cuts);
+        struct cut_result {lar_term t; mpq k; u_dependency *dep; double efficacy; bool selected;};
+        vector<cut_result> cuts, big_cuts;
+        unsigned_vector columns_for_cuts = gomory_select_int_infeasible_vars(2 * num_cuts);
         bool has_small_cut = false;
 
         // define inline helper functions
@@ -519,13 +555,32 @@ public:
                 lra.update_column_type_and_bound(j, lp::lconstraint_kind::LE, floor(lra.get_column_value(j).x), add_deps(cc.m_dep, row, j));
             else if (cc.m_polarity == row_polarity::MIN)
                 lra.update_column_type_and_bound(j, lp::lconstraint_kind::GE, ceil(lra.get_column_value(j).x), add_deps(cc.m_dep, row, j));
-            
-            if (!is_small_cut(lia.m_t)) {
-                big_cuts.push_back({cc.m_t, cc.m_k, cc.m_dep});
+            cuts.push_back({cc.m_t, cc.m_k, cc.m_dep, efficacy(cc.m_t, cc.m_k), false});
+        }
+
+        // order the cuts by indices: cut_result holds a lar_term, which is not safe to move
+        unsigned_vector order;
+        for (unsigned i = 0; i < cuts.size(); ++i)
+            order.push_back(i);
+        std::stable_sort(order.begin(), order.end(), [&](unsigned a, unsigned b) { return cuts[a].efficacy > cuts[b].efficacy; });
+        unsigned num_selected = 0;
+        for (unsigned i = 0; i < order.size(); ++i) {
+            auto& cut = cuts[order[i]];
+            bool parallel = false;
+            for (unsigned k = 0; k < i && !parallel; ++k)
+                parallel = cuts[order[k]].selected && parallelism(cut.t, cuts[order[k]].t) > 0.999;
+            if (parallel || num_selected == num_cuts) {
+                lia.settings().stats().m_gomory_cuts_discarded++;
+                continue;
+            }
+            cut.selected = true;
+            ++num_selected;
+            if (!is_small_cut(cut.t)) {
+                big_cuts.push_back(cut);
                 continue;
             }
             has_small_cut = true;
-            add_cut(cc.m_t, cc.m_k, cc.m_dep);
+            add_cut(cut.t, cut.k, cut.dep);
             if (lia.settings().get_cancel_flag())
                 return lia_move::cancelled;
         }
@@ -30,6 +30,8 @@ namespace lp {
         unsigned_vector gomory_select_int_infeasible_vars(unsigned num_cuts);
         bool is_gomory_cut_target(lpvar j); 
         u_dependency* add_deps(u_dependency*, const row_strip<mpq>&, lpvar);
+        double efficacy(const lar_term& t, const mpq& k) const;
+        static double parallelism(const lar_term& t1, const lar_term& t2);
     public:
         lia_move get_gomory_cuts(unsigned num_cuts);
         gomory(int_solver& lia);
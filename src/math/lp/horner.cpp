@@ -87,11 +87,14 @@ bool horner::lemmas_on_row(const T& row) {
     if (!e->is_sum())
         return false;
     
+    // the bounds may have changed since the last row
+    c().m_intervals.reset_cache();
     cross_nested cn(
         [this, dep](const nex* n) { return c().m_intervals.check_nex(n, dep); },
         [this](unsigned j)   { return c().var_is_fixed(j); },
         [this]() { return c().random(); }, m_nex_creator);
     bool ret = lemmas_on_expr(cn, to_sum(e));
+    c().m_intervals.reset_cache();
     c().m_intervals.get_dep_intervals().reset(); // clean the memory allocated by the interval bound dependencies
     return ret;
 
@@ -521,7 +521,7 @@ namespace lp {
         impq prev_value = term.apply(m_mpq_lar_core_solver.m_r_x);
         auto backup = m_mpq_lar_core_solver.m_r_x;
         if (!maximize_term_on_feasible_r_solver(term, term_max, nullptr)) {
-            m_mpq_lar_core_solver.m_r_x = backup;
+            m_mpq_lar_core_solver.m_r_x.swap(backup);
             return lp_status::UNBOUNDED;
         }
 
@@ -535,14 +535,14 @@ namespace lp {
                 continue;
             if (m_int_solver->is_base(j)) {
                 if (!remove_from_basis(j)) { // consider a special version of remove_from_basis that would not remove inf_int columns
-                    m_mpq_lar_core_solver.m_r_x = backup;
+                    m_mpq_lar_core_solver.m_r_x.swap(backup);
                     term_max = prev_value;
                     return lp_status::FEASIBLE; // it should not happen
                 }
             }
             if (!column_value_is_integer(j)) {
                 term_max = prev_value;
-                m_mpq_lar_core_solver.m_r_x = backup;
+                m_mpq_lar_core_solver.m_r_x.swap(backup);
                 return lp_status::FEASIBLE;
             }
             change = true;
@@ -552,7 +552,7 @@ namespace lp {
         }
         if (term_max < prev_value) {
             term_max = prev_value;
-            m_mpq_lar_core_solver.m_r_x = backup;
+            m_mpq_lar_core_solver.m_r_x.swap(backup);
         }
         TRACE("lar_solver", print_values(tout););
         if (term_max == opt_val) {
@@ -706,7 +706,7 @@ namespace lp {
            if (tableau_with_costs()) {
               m_basic_columns_with_changed_cost.insert(bj);
            }
-           m_mpq_lar_core_solver.m_r_solver.add_delta_to_x_and_track_feasibility(bj, -A_r().get_val(c) * delta);
+           m_mpq_lar_core_solver.m_r_solver.sub_mul_from_x_and_track_feasibility(bj, A_r().get_val(c), delta);
            TRACE("change_x_del",
               tout << "changed basis column " << bj << ", it is " <<
               (column_is_feasible(bj) ? "feas" : "inf") << std::endl;);
@@ -146,6 +146,11 @@ public:
     }
 
 
+    // false if no bound on j can be interesting, checked before the bound is computed
+    bool column_is_interesting(lpvar j) const {
+        return m_imp.column_is_interesting(j);
+    }
+
     void add_bound(mpq const& v, unsigned j, bool is_low, bool strict, std::function<u_dependency* ()> explain_bound) {
         lconstraint_kind kind = is_low ? GE : LE;
         if (strict)
@@ -544,6 +544,12 @@ public:
         track_column_feasibility(j);
     }
 
+    // x[j] -= a * del
+    void sub_mul_from_x_and_track_feasibility(unsigned j, const T & a, const X & del) {
+        submul(m_x[j], a, del);
+        track_column_feasibility(j);
+    }
+
     void update_x(unsigned j, const X & v) {
         m_x[j] = v;
         TRACE("lar_solver_feas", tout << "not tracking feas j = " << j << ", v = " << v << (column_is_feasible(j)? " feas":" non-feas") << "\n";);
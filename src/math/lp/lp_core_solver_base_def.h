@@ -119,7 +119,7 @@ add_delta_to_entering(unsigned entering, const X& delta) {
     TRACE("lar_solver_feas", tout << "not tracking feas entering = " << entering << " = " << m_x[entering] << (column_is_feasible(entering) ? " feas" : " non-feas") << "\n";); 
     for (const auto & c : m_A.m_columns[entering]) {
         unsigned i = c.var();
-        m_x[m_basis[i]] -= delta * m_A.get_val(c);
+        submul(m_x[m_basis[i]], m_A.get_val(c), delta);
         TRACE("lar_solver_feas", tout << "not tracking feas m_basis[i] = " << m_basis[i] << " = " << m_x[m_basis[i]] << (column_is_feasible(m_basis[i]) ? " feas" : " non-feas") << "\n";);
     }
 }
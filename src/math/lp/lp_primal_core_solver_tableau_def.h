@@ -282,7 +282,7 @@ update_x_tableau(unsigned entering, const X& delta) {
     this->add_delta_to_x(entering, delta);
     for (const auto & c : this->m_A.m_columns[entering]) {
          unsigned i = c.var();
-         this->add_delta_to_x_and_track_feasibility(this->m_basis[i], -  delta * this->m_A.get_val(c));
+         this->sub_mul_from_x_and_track_feasibility(this->m_basis[i], this->m_A.get_val(c), delta);
     }
 }
 
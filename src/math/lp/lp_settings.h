@@ -115,10 +115,18 @@ struct statistics {
     unsigned m_hnf_cuts = 0;
     unsigned m_nla_calls = 0;
     unsigned m_gomory_cuts = 0;
+    unsigned m_gomory_cuts_discarded = 0;
     unsigned m_nla_add_bounds = 0;
     unsigned m_nla_propagate_bounds = 0;
     unsigned m_nla_propagate_eq = 0;
     unsigned m_nla_lemmas = 0;
+    unsigned m_nla_repeated_lemmas = 0;
+    unsigned m_nla_order_lemmas = 0;
+    unsigned m_nla_order_repeated = 0;
+    unsigned m_nla_monotone_lemmas = 0;
+    unsigned m_nla_monotone_repeated = 0;
+    unsigned m_nla_tangent_lemmas = 0;
+    unsigned m_nla_tangent_repeated = 0;
     unsigned m_nra_calls = 0;
     unsigned m_nla_bounds_improvements = 0;
     unsigned m_horner_calls = 0;
@@ -147,6 +155,7 @@ struct statistics {
         st.update("arith-hnf-calls", m_hnf_cutter_calls);
         st.update("arith-hnf-cuts", m_hnf_cuts);
         st.update("arith-gomory-cuts", m_gomory_cuts);
+        st.update("arith-gomory-cuts-discarded", m_gomory_cuts_discarded);
         st.update("arith-horner-calls", m_horner_calls);
         st.update("arith-horner-conflicts", m_horner_conflicts);
         st.update("arith-horner-cross-nested-forms", m_cross_nested_forms);
@@ -158,6 +167,13 @@ struct statistics {
         st.update("arith-nla-propagate-bounds", m_nla_propagate_bounds);
         st.update("arith-nla-propagate-eq", m_nla_propagate_eq);
         st.update("arith-nla-lemmas", m_nla_lemmas);
+        st.update("arith-nla-repeated-lemmas", m_nla_repeated_lemmas);
+        st.update("arith-nla-order-lemmas", m_nla_order_lemmas);
+        st.update("arith-nla-order-repeated", m_nla_order_repeated);
+        st.update("arith-nla-monotone-lemmas", m_nla_monotone_lemmas);
+        st.update("arith-nla-monotone-repeated", m_nla_monotone_repeated);
+        st.update("arith-nla-tangent-lemmas", m_nla_tangent_lemmas);
+        st.update("arith-nla-tangent-repeated", m_nla_tangent_repeated);
         st.update("arith-nra-calls", m_nra_calls);   
         st.update("arith-bounds-improvements", m_nla_bounds_improvements);
         st.copy(m_st);
@@ -216,6 +232,7 @@ public:
     bool             backup_costs = true;
     unsigned         column_number_threshold_for_using_lu_in_lar_solver = 4000;
     unsigned         m_int_gomory_cut_period = 4;
+    unsigned         m_int_gomory_cuts_per_round = 2;
     unsigned         m_int_find_cube_period = 4;
 private:
     unsigned         m_hnf_cut_period = 4;
@@ -1062,6 +1062,7 @@ new_lemma::~new_lemma() {
     if (current().is_conflict()) {
         c.m_conflicts++;
     }
+    c.register_lemma(current());
     IF_VERBOSE(4, verbose_stream() << name << "\n");
     IF_VERBOSE(4, verbose_stream() << *this << "\n");
     TRACE("nla_solver", tout << name << " " << (++i) << "\n" << *this; );
@@ -1537,17 +1538,22 @@ lbool core::check() {
 
 
     if (no_effect()) {
-        std::function<void(void)> check1 = [&]() { m_order.order_lemma();
+        auto& stats = lp_settings().stats();
+        std::function<void(void)> check1 = [&]() { 
+            run_strategy(m_order_stats, stats.m_nla_order_lemmas, stats.m_nla_order_repeated, [&]() { m_order.order_lemma(); });
         };
-        std::function<void(void)> check2 = [&]() { m_monotone.monotonicity_lemma();
+        std::function<void(void)> check2 = [&]() { 
+            run_strategy(m_monotone_stats, stats.m_nla_monotone_lemmas, stats.m_nla_monotone_repeated, [&]() { m_monotone.monotonicity_lemma(); });
         };
-        std::function<void(void)> check3 = [&]() { m_tangents.tangent_lemma();
+        std::function<void(void)> check3 = [&]() { 
+            run_strategy(m_tangent_stats, stats.m_nla_tangent_lemmas, stats.m_nla_tangent_repeated, [&]() { m_tangents.tangent_lemma(); });
         };
         
+        // strategies that keep re-deriving lemmas of earlier rounds are tried less often
         std::pair<unsigned, std::function<void(void)>> checks[] = 
-            { { 6, check1 }, 
-              { 2, check2 }, 
-              { 1, check3 }};
+            { { strategy_weight(m_order_stats, 6), check1 }, 
+              { strategy_weight(m_monotone_stats, 2), check2 }, 
+              { strategy_weight(m_tangent_stats, 1), check3 }};
         check_weighted(3, checks);
 
         unsigned num_calls = lp_settings().stats().m_nla_calls;
@@ -1571,6 +1577,57 @@ lbool core::check() {
     return ret;
 }
 
+/**
+   \brief hash of a lemma that does not depend on the order of the
+   monomials in its terms or of the constraints in its explanation.
+*/
+unsigned core::lemma_hash(lemma const& l) const {
+    unsigned h = 0;
+    for (ineq const& i : l.ineqs()) {
+        unsigned th = 0;
+        for (lp::lar_term::ival p : i.term())
+            th += combine_hash(p.j(), p.coeff().hash());
+        h += combine_hash(combine_hash(th, i.rs().hash()), static_cast<unsigned>(i.cmp()));
+    }
+    unsigned eh = 0;
+    for (auto p : l.expl())
+        eh += hash_u(p.ci());
+    return combine_hash(h, eh);
+}
+
+void core::register_lemma(lemma const& l) {
+    // the hashes are only used for statistics and strategy weights, so collisions are harmless
+    if (m_lemma_hashes.size() > 1000000)
+        m_lemma_hashes.reset();
+    unsigned h = lemma_hash(l);
+    if (m_lemma_hashes.contains(h)) {
+        ++m_num_repeated_lemmas;
+        lp_settings().stats().m_nla_repeated_lemmas++;
+    }
+    else
+        m_lemma_hashes.insert(h);
+}
+
+void core::run_strategy(strategy_stats& st, unsigned& num_lemmas, unsigned& num_repeated, std::function<void(void)> const& f) {
+    unsigned lemmas = m_lemmas.size(), repeated = m_num_repeated_lemmas;
+    f();
+    lemmas = m_lemmas.size() - lemmas;
+    repeated = m_num_repeated_lemmas - repeated;
+    st.m_lemmas += lemmas;
+    st.m_repeated += repeated;
+    num_lemmas += lemmas;
+    num_repeated += repeated;
+}
+
+/**
+   \brief scale the base weight of a strategy by the fraction of its lemmas
+   that were not produced before.
+*/
+unsigned core::strategy_weight(strategy_stats const& st, unsigned base) const {
+    unsigned fresh = st.m_lemmas - st.m_repeated;
+    return std::max(1u, static_cast<unsigned>((4ull * base * (fresh + 1)) / (st.m_lemmas + 1)));
+}
+
 bool core::should_run_bounded_nlsat() {
     if (!params().arith_nl_nra())
         return false;
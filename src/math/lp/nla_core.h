@@ -64,6 +64,15 @@ class core {
     unsigned m_nlsat_delay_bound = 0;
 
     bool should_run_bounded_nlsat();
+
+    struct strategy_stats {
+        unsigned m_lemmas = 0;
+        unsigned m_repeated = 0;
+    };
+    unsigned lemma_hash(lemma const& l) const;
+    void register_lemma(lemma const& l);
+    void run_strategy(strategy_stats& st, unsigned& num_lemmas, unsigned& num_repeated, std::function<void(void)> const& f);
+    unsigned strategy_weight(strategy_stats const& st, unsigned base) const;
     lbool bounded_nlsat();
 
     var_eqs<emonics>         m_evars;
@@ -88,6 +97,11 @@ class core {
     monomial_bounds          m_monomial_bounds;
     unsigned                 m_conflicts;
     bool                     m_check_feasible = false;
+    // hashes of the lemmas produced so far, used to measure how often a strategy
+    // re-derives a lemma from an earlier round.
+    hashtable<unsigned, u_hash, u_eq> m_lemma_hashes;
+    unsigned                 m_num_repeated_lemmas = 0;
+    strategy_stats           m_order_stats, m_monotone_stats, m_tangent_stats;
     horner                   m_horner;
     grobner                  m_grobner;
     emonics                  m_emons;
@@ -11,6 +11,43 @@ intervals::intervals(core* c, reslimit& lim):
 
 typedef enum dep_intervals::with_deps_t e_with_deps;
 
+void intervals::reset_cache() {
+    for (interval* i : m_cached_intervals) {
+        m_dep_intervals.del(*i);
+        dealloc(i);
+    }
+    m_cached_intervals.reset();
+    m_sum_cache.reset();
+}
+
+unsigned intervals::nex_hash(const nex* e) {
+    unsigned h = 0;
+    if (m_nex_hash.find(e, h))
+        return h;
+    switch (e->type()) {
+    case expr_type::SCALAR:
+        h = to_scalar(e)->value().hash();
+        break;
+    case expr_type::VAR:
+        h = hash_u(e->to_var().var());
+        break;
+    case expr_type::SUM:
+        h = 17;
+        for (const nex* c : e->to_sum())
+            h = combine_hash(h, nex_hash(c));
+        break;
+    case expr_type::MUL:
+        h = combine_hash(31, e->to_mul().coeff().hash());
+        for (const auto& ep : e->to_mul())
+            h = combine_hash(h, combine_hash(nex_hash(ep.e()), ep.pow()));
+        break;
+    default:
+        UNREACHABLE();
+    }
+    m_nex_hash.insert(e, h);
+    return h;
+}
+
 const nex* intervals::get_inf_interval_child(const nex_sum& e) const {
     for (auto * c : e) {
         if (has_inf_interval(*c))
@@ -92,10 +129,16 @@ bool intervals::check_nex(const nex* n, u_dependency* initial_deps) {
         new_lemma lemma(*m_core, "check_nex");
         lemma &= e;
     };
+    // treat cancellation like a conflict, it stops the enumeration of cross nested forms
+    if (m_core->lp_settings().get_cancel_flag())
+        return true;
+    m_nex_hash.reset();
+    flet<bool> _use_cache(m_use_cache, true);
     if (!interval_of_expr<e_with_deps::without_deps>(n, 1, i, f)) {
         // found a conflict during the interval calculation
         return true;
     }
+    m_use_cache = false;
     if (!m_dep_intervals.separated_from_zero(i)) {
         return false;
     }
@@ -443,8 +486,25 @@ bool intervals::interval_of_expr(const nex* e, unsigned p, scoped_dep_interval&
         }
         break;
     case expr_type::SUM: {
+        unsigned h = 0, idx = 0;
+        bool use_cache = wd == e_with_deps::without_deps && m_use_cache;
+        if (use_cache) {
+            h = nex_hash(e);
+            if (m_sum_cache.find(h, idx)) {
+                m_dep_intervals.set<wd>(a, *m_cached_intervals[idx]);
+                if (p != 1)
+                    to_power<wd>(a, p);
+                break;
+            }
+        }
         if (!interval_of_sum<wd>(e->to_sum(), a, f))
             return false;
+        if (use_cache) {
+            interval* i = alloc(interval);
+            m_dep_intervals.set<wd>(*i, a);
+            m_sum_cache.insert(h, m_cached_intervals.size());
+            m_cached_intervals.push_back(i);
+        }
         if (p != 1) {
             to_power<wd>(a, p);
         }
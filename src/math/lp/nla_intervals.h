@@ -25,12 +25,24 @@ class intervals {
 public:
     typedef dep_intervals::interval interval;
 private:
+    // intervals without dependencies of the sums evaluated by check_nex, keyed by
+    // a structural hash. They stay valid as long as the variable bounds do not change.
+    // The intervals with dependencies that justify lemmas are always recomputed,
+    // so a hash collision can only cost a missed or a redundant check.
+    bool                      m_use_cache = false;
+    u_map<unsigned>           m_sum_cache;
+    ptr_vector<interval>      m_cached_intervals;
+    map<nex const*, unsigned, ptr_hash<nex const>, ptr_eq<nex const>> m_nex_hash;
+    unsigned nex_hash(const nex* e);
+
     u_dependency* mk_dep(lp::explanation const&);
     lp::lar_solver& ls();
     const lp::lar_solver& ls() const;
 public:
 
     intervals(core* c, reslimit& lim);
+    ~intervals() { reset_cache(); }
+    void reset_cache();
 
     dep_intervals& get_dep_intervals() { return m_dep_intervals; }
     u_dependency* mk_join(u_dependency* a, u_dependency* b) { return m_dep_intervals.mk_join(a, b); }
@@ -268,6 +268,17 @@ numeric_pair<T> operator*(const numeric_pair<T> & r, const X & a) {
     return numeric_pair<T>(a * r.x, a * r.y);
 }
 
+// r -= a * d, in place
+template <typename T>
+void submul(numeric_pair<T> & r, const T & a, const numeric_pair<T> & d) {
+    r.x.submul(a, d.x);
+    if (!d.y.is_zero())
+        r.y.submul(a, d.y);
+}
+
+inline void submul(rational & r, const rational & a, const rational & d) {
+    r.submul(a, d);
+}
 
 template <typename T, typename X>
 numeric_pair<T> operator/(const numeric_pair<T> & r, const X & a) {
@@ -67,6 +67,7 @@ class static_matrix
     std::stack<dim> m_stack;
 public:
     vector<int> m_vector_of_row_offsets;
+    unsigned_vector m_zero_offsets; // work vector of pivot_row_to_row_given_cell
     indexed_vector<T> m_work_vector;
     vector<row_strip<T>> m_rows;
     vector<column_strip> m_columns;
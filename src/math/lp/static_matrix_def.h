@@ -67,7 +67,10 @@ template <typename T, typename X> bool static_matrix<T, X>::pivot_row_to_row_giv
             add_new_element(ii, j, alv);
         }
         else {
-            addmul(rowii[j_offs].coeff(), iv.coeff(), alpha);
+            auto & coeff = rowii[j_offs].coeff();
+            addmul(coeff, iv.coeff(), alpha);
+            if (is_zero(coeff))
+                m_zero_offsets.push_back(j_offs);
         }
     }
     // clean the work vector
@@ -75,11 +78,12 @@ template <typename T, typename X> bool static_matrix<T, X>::pivot_row_to_row_giv
         m_vector_of_row_offsets[rowii[k].var()] = -1;
     }
 
-    // remove zeroes
-    for (unsigned k = rowii.size(); k-- > 0;  ) {
-        if (is_zero(rowii[k].coeff()))
-            remove_element(rowii, rowii[k]);
-    }
+    // remove zeroes, only updated elements can have become zero.
+    // removal moves the last element into the freed slot, so go from the highest offset down.
+    std::sort(m_zero_offsets.begin(), m_zero_offsets.end(), std::greater<unsigned>());
+    for (unsigned k : m_zero_offsets)
+        remove_element(rowii, rowii[k]);
+    m_zero_offsets.reset();
     return !rowii.empty();
 }
 
@@ -363,7 +367,7 @@ void static_matrix<T, X>::remove_element(vector<row_cell<T>> & row_vals, row_cel
     }
     
     if (row_offset != row_vals.size() - 1) {
-        auto & rc = row_vals[row_offset] = row_vals.back(); // copy from the tail
+        auto & rc = row_vals[row_offset] = std::move(row_vals.back()); // move from the tail
         m_columns[rc.var()][rc.offset()].offset() = row_offset;
     }
 
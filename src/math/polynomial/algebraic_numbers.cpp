@@ -19,6 +19,7 @@ Notes:
 #include "util/mpbq.h"
 #include "util/basic_interval.h"
 #include "util/scoped_ptr_vector.h"
+#include "util/map.h"
 #include "util/mpbqi.h"
 #include "util/timeit.h"
 #include "util/common_msgs.h"
@@ -47,7 +48,8 @@ namespace algebraic_numbers {
         unsigned   m_sign_lower:1;
         unsigned   m_not_rational:1; // if true we know for sure it is not a rational
         unsigned   m_i:29; // number is the i-th root of p, 0 if it is not known which root of p the number is.
-        algebraic_cell():m_p_sz(0), m_p(nullptr), m_minimal(false), m_not_rational(false), m_i(0) {}
+        unsigned   m_log_n; // pace of quadratic interval refinement reached on m_interval
+        algebraic_cell():m_p_sz(0), m_p(nullptr), m_minimal(false), m_not_rational(false), m_i(0), m_log_n(2) {}
         bool is_minimal() const { return m_minimal != 0; }
     };
 
@@ -84,6 +86,18 @@ namespace algebraic_numbers {
         polynomial::var          m_x;
         polynomial::var          m_y;
 
+        // Factorizations of univariate polynomials. nlsat isolates the roots of the
+        // same polynomials under the same sample points over and over again.
+        struct factor_memo {
+            upoly   m_poly;
+            factors m_factors;
+            bool    m_full;
+            factor_memo(upoly_manager & upm): m_factors(upm), m_full(false) {}
+        };
+        static const unsigned      max_factor_memo = 1024;
+        scoped_ptr_vector<factor_memo> m_factor_memo;
+        u_map<unsigned_vector>     m_factor_memo_index;  // hash of the coefficients -> memo entries
+
         // configuration
         int                        m_min_magnitude;
         bool                       m_factor;
@@ -95,6 +109,7 @@ namespace algebraic_numbers {
         unsigned                 m_compare_sturm;
         unsigned                 m_compare_refine;
         unsigned                 m_compare_poly_eq;
+        unsigned                 m_factor_memo_hits;
 
         imp(reslimit& lim, manager & w, unsynch_mpq_manager & m, params_ref const & p, small_object_allocator & a):
             m_limit(lim),
@@ -122,6 +137,7 @@ namespace algebraic_numbers {
         }
 
         ~imp() {
+            reset_factor_memo();
         }
 
         bool acell_inv(algebraic_cell const& c) {
@@ -139,6 +155,7 @@ namespace algebraic_numbers {
             m_compare_sturm   = 0;
             m_compare_refine  = 0;
             m_compare_poly_eq = 0;
+            m_factor_memo_hits = 0;
         }
 
         void collect_statistics(statistics & st) {
@@ -147,6 +164,7 @@ namespace algebraic_numbers {
             st.update("algebraic compare sturm", m_compare_sturm);
             st.update("algebraic compare refine", m_compare_refine);
             st.update("algebraic compare poly", m_compare_poly_eq);
+            st.update("algebraic factor memo hits", m_factor_memo_hits);
 #endif
         }
 
@@ -158,6 +176,7 @@ namespace algebraic_numbers {
             m_factor_params.m_p_trials = p.factor_num_primes();
             m_factor_params.m_max_search_size = p.factor_search_size();
             m_zero_accuracy            = -static_cast<int>(p.zero_accuracy());
+            reset_factor_memo();
         }
 
         unsynch_mpq_manager & qm() {
@@ -547,9 +566,54 @@ namespace algebraic_numbers {
             }
         }
 
+        void reset_factor_memo() {
+            for (factor_memo * e : m_factor_memo)
+                upm().reset(e->m_poly);
+            m_factor_memo.reset();
+            m_factor_memo_index.reset();
+        }
+
+        unsigned hash_upoly(upoly const & p) {
+            unsigned h = p.size();
+            for (auto const & c : p)
+                h = combine_hash(h, qm().hash(c));
+            return h;
+        }
+
+        bool factor_memoized(scoped_upoly const & up, factors & r) {
+            if (up.size() <= 2)
+                return upm().factor(up, r, m_factor_params);
+            unsigned h = hash_upoly(up);
+            auto * idx = m_factor_memo_index.find_core(h);
+            if (idx) {
+                for (unsigned i : idx->get_data().m_value) {
+                    factor_memo const & e = *m_factor_memo[i];
+                    if (!upm().eq(up.size(), up.data(), e.m_poly.size(), e.m_poly.data()))
+                        continue;
+                    ++m_factor_memo_hits;
+                    r.set_constant(e.m_factors.get_constant());
+                    for (unsigned j = 0; j < e.m_factors.distinct_factors(); ++j)
+                        r.push_back(e.m_factors[j], e.m_factors.get_degree(j));
+                    return e.m_full;
+                }
+            }
+            bool full = upm().factor(up, r, m_factor_params);
+            if (m_factor_memo.size() >= max_factor_memo)
+                reset_factor_memo();
+            factor_memo * e = alloc(factor_memo, upm());
+            upm().set(up.size(), up.data(), e->m_poly);
+            e->m_factors.set_constant(r.get_constant());
+            for (unsigned j = 0; j < r.distinct_factors(); ++j)
+                e->m_factors.push_back(r[j], r.get_degree(j));
+            e->m_full = full;
+            m_factor_memo_index.insert_if_not_there(h, unsigned_vector()).push_back(m_factor_memo.size());
+            m_factor_memo.push_back(e);
+            return full;
+        }
+
         bool factor(scoped_upoly const & up, factors & r) {
             if (m_factor) {
-                return upm().factor(up, r, m_factor_params);
+                return factor_memoized(up, r);
             }
             else {
                 scoped_upoly & up_sqf = m_isolate_tmp3;
@@ -801,18 +865,54 @@ namespace algebraic_numbers {
             }
         }
 
+        /**
+           \brief Refine the interval of a until it is smaller than bound, using quadratic
+           interval refinement. The pace reached is kept in the cell for later refinements.
+        */
+        bool refine_core(algebraic_cell * c, mpbq const & bound) {
+            bool r = upm().refine_core(c->m_p_sz, c->m_p, sign_lower(c), bqm(), lower(c), upper(c), bound, c->m_log_n);
+            SASSERT(acell_inv(*c));
+            return r;
+        }
+
+        bool refine_to_basic(numeral & a, bool refined) {
+            if (refined)
+                return true;
+            // root was found
+            algebraic_cell * c = a.to_algebraic();
+            scoped_mpq r(qm());
+            to_mpq(qm(), lower(c), r);
+            del(a);
+            a = mk_basic_cell(r);
+            return false;
+        }
+
+        /**
+           \brief Shrink the interval of a at least as much as k bisections would.
+        */
         bool refine(numeral & a, unsigned k) {
-            for (unsigned i = 0; i < k; i++)
-                if (!refine(a))
-                    return false;
-            return true;
+            if (k <= 2) {
+                for (unsigned i = 0; i < k; i++)
+                    if (!refine(a))
+                        return false;
+                return true;
+            }
+            if (a.is_basic())
+                return false;
+            algebraic_cell * c = a.to_algebraic();
+            scoped_mpbq bound(bqm());
+            bqm().sub(upper(c), lower(c), bound);
+            bqm().div2k(bound, k - 1);
+            return refine_to_basic(a, refine_core(c, bound));
         }
 
         bool refine_until_prec(numeral & a, unsigned prec) {
             if (a.is_basic())
                 return true;
             algebraic_cell * c = a.to_algebraic();
-            if (!upm().refine(c->m_p_sz, c->m_p, bqm(), lower(c), upper(c), prec)) {
+            scoped_mpbq bound(bqm());
+            bqm().set(bound, 1, prec);
+            if (!refine_core(c, bound)) {
                 // actual root was found
                 scoped_mpq r(qm());
                 to_mpq(qm(), lower(c), r);
@@ -779,6 +779,29 @@ namespace polynomial {
         tmp_monomial             m_tmp2;
         tmp_monomial             m_tmp3;
         svector<power>           m_powers_tmp;
+
+        // Direct mapped cache of monomial products. Polynomial multiplication, and thus
+        // pseudo-remainders and subresultants, multiply the same pairs of monomials over
+        // and over. An entry holds references to both factors and the product, so the
+        // monomials of an entry stay alive and can be compared by address.
+        struct mul_entry {
+            monomial * m_m1 = nullptr;
+            monomial * m_m2 = nullptr;
+            monomial * m_r  = nullptr;
+        };
+        static const unsigned    mul_cache_size = 4096;
+        svector<mul_entry>       m_mul_cache;
+
+        void reset_mul_cache() {
+            for (mul_entry & e : m_mul_cache) {
+                if (e.m_r) {
+                    dec_ref(e.m_m1);
+                    dec_ref(e.m_m2);
+                    dec_ref(e.m_r);
+                }
+            }
+            m_mul_cache.reset();
+        }
     public:
         monomial_manager(small_object_allocator * a = nullptr) {
             m_ref_count = 0;
@@ -796,6 +819,7 @@ namespace polynomial {
         }
 
         ~monomial_manager() {
+            reset_mul_cache();
             dec_ref(m_unit);
             CTRACE("polynomial", !m_monomials.empty(),
                    tout << "monomials leaked (can happen during cancelation)\n";
@@ -989,7 +1013,26 @@ namespace polynomial {
                 return const_cast<monomial*>(m2);
             if (m2 == m_unit)
                 return const_cast<monomial*>(m1);
-            return mul(m1->size(), m1->get_powers(), m2->size(), m2->get_powers());
+            if (m1->id() > m2->id())
+                std::swap(m1, m2);
+            if (m_mul_cache.empty())
+                m_mul_cache.resize(mul_cache_size);
+            mul_entry & e = m_mul_cache[hash_u_u(m1->id(), m2->id()) & (mul_cache_size - 1)];
+            if (e.m_m1 == m1 && e.m_m2 == m2)
+                return e.m_r;
+            monomial * r = mul(m1->size(), m1->get_powers(), m2->size(), m2->get_powers());
+            inc_ref(const_cast<monomial*>(m1));
+            inc_ref(const_cast<monomial*>(m2));
+            inc_ref(r);
+            if (e.m_r) {
+                dec_ref(e.m_m1);
+                dec_ref(e.m_m2);
+                dec_ref(e.m_r);
+            }
+            e.m_m1 = const_cast<monomial*>(m1);
+            e.m_m2 = const_cast<monomial*>(m2);
+            e.m_r  = r;
+            return r;
         }
 
 
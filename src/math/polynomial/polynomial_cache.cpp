@@ -144,7 +144,7 @@ namespace polynomial {
         void psc_chain(polynomial * p, polynomial * q, var x, polynomial_ref_vector & S) {
             p = mk_unique(p);
             q = mk_unique(q);
-            unsigned h = hash_u_u(pid(p), pid(q));
+            unsigned h = combine_hash(hash_u_u(pid(p), pid(q)), hash_u(x));
             psc_chain_entry * entry = new (m_allocator.allocate(sizeof(psc_chain_entry))) psc_chain_entry(p, q, x, h);
             psc_chain_entry * old_entry = m_psc_chain_cache.insert_if_not_there(entry); 
             if (entry != old_entry) {
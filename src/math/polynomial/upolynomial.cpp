@@ -1761,6 +1761,20 @@ namespace upolynomial {
         return sign_of(r);
     }
 
+    void manager::eval_at(unsigned sz, numeral const * p, mpbq_manager & bqm, mpbq const & b, mpbq & r) {
+        if (sz == 0) {
+            bqm.reset(r);
+            return;
+        }
+        bqm.set(r, p[sz-1]);
+        unsigned i = sz-1;
+        while (i > 0) {
+            --i;
+            bqm.mul(r, b, r);
+            bqm.add(r, p[i], r);
+        }
+    }
+
     // Evaluate the sign of p(b)
     sign manager::eval_sign_at(unsigned sz, numeral const * p, mpq const & b) {
         // Actually, given b = c/d, we compute the sign of (d^n)*p(b)
@@ -2785,18 +2799,146 @@ namespace upolynomial {
     // Return TRUE, if interval was squeezed, and new interval is stored in (a,b).
     // Return FALSE, if the actual root was found, it is stored in a.
     bool manager::refine_core(unsigned sz, numeral const * p, sign sign_a, mpbq_manager & bqm, mpbq & a, mpbq & b, unsigned prec_k) {
+        scoped_mpbq bound(bqm);
+        bqm.set(bound, 1, prec_k);
+        unsigned log_n = 2;
+        return refine_core(sz, p, sign_a, bqm, a, b, bound, log_n);
+    }
+
+    // Quadratic interval refinement (J. Abbott, Quadratic Interval Refinement for Real Roots).
+    //
+    // The secant through (a, p(a)) and (b, p(b)) predicts the root. The interval is
+    // divided into N = 2^log_n subintervals, and the signs at the grid points next to
+    // the prediction are evaluated. If the root is in the subinterval of the
+    // prediction, the interval shrinks by the factor N and N is squared, otherwise
+    // the interval is bisected and N is reduced to its square root. Near the root the
+    // secant prediction is accurate, so the number of bits gained per evaluation
+    // doubles at every step, while bisection gains one bit per evaluation.
+    bool manager::refine_core(unsigned sz, numeral const * p, sign sign_a, mpbq_manager & bqm, mpbq & a, mpbq & b, mpbq const & bound, unsigned & log_n) {
         SASSERT(sign_a != sign_zero);
         SASSERT(sign_a  == eval_sign_at(sz, p, a));
         SASSERT(-sign_a == eval_sign_at(sz, p, b));
-        scoped_mpbq w(bqm);
+        static const unsigned max_log_n = 1024;
+        z_numeral_manager & zm = m().m();
+        scoped_mpbq w(bqm), fa(bqm), fb(bqm), x(bqm), fx(bqm), y(bqm), fy(bqm);
+        scoped_mpz na(zm), nb(zm), d(zm), idx(zm), n(zm), i1(zm);
+        auto sign_of = [&](mpbq const & v) {
+            return bqm.is_zero(v) ? sign_zero : (bqm.is_pos(v) ? sign_pos : sign_neg);
+        };
+        // r <- a + i * w / N
+        auto grid = [&](mpz const & i, mpbq & r, mpbq & fr) {
+            bqm.mul(w, i, r);
+            bqm.div2k(r, log_n);
+            bqm.add(a, r, r);
+            eval_at(sz, p, bqm, r, fr);
+        };
+        eval_at(sz, p, bqm, a, fa);
+        eval_at(sz, p, bqm, b, fb);
+        if (log_n < 2)
+            log_n = 2;
         while (true) {
             checkpoint();
             bqm.sub(b, a, w);
-            if (bqm.lt_1div2k(w, prec_k)) {
+            if (bqm.lt(w, bound))
                 return true;
+            // idx <- round(N * p(a) / (p(a) - p(b))), the grid point closest to the secant root.
+            unsigned k = std::max(fa.get().k(), fb.get().k());
+            zm.mul2k(fa.get().numerator(), k - fa.get().k(), na);
+            zm.mul2k(fb.get().numerator(), k - fb.get().k(), nb);
+            if (zm.is_neg(na)) {
+                zm.neg(na);
+                zm.neg(nb);
+            }
+            zm.sub(na, nb, d);
+            zm.mul2k(na, log_n + 1, idx);
+            zm.add(idx, d, idx);
+            zm.mul2k(d, 1);
+            zm.div(idx, d, idx);
+            zm.set(n, 1);
+            zm.mul2k(n, log_n);
+            if (zm.is_zero(idx)) {
+                bqm.set(x, a);
+                bqm.set(fx, fa);
+            }
+            else if (zm.eq(idx, n)) {
+                bqm.set(x, b);
+                bqm.set(fx, fb);
+            }
+            else {
+                grid(idx, x, fx);
+            }
+            sign sx = sign_of(fx);
+            if (sx == sign_zero) {
+                swap(a, x);
+                return false;
             }
-            if (!refine_core(sz, p, sign_a, bqm, a, b)) {
-                return false; // found root
+            bool hit = false;
+            if (sx == sign_a) {
+                // the root is in (x, b), test the next grid point
+                zm.add(idx, mpz(1), i1);
+                if (zm.eq(i1, n)) {
+                    bqm.set(y, b);
+                    bqm.set(fy, fb);
+                }
+                else {
+                    grid(i1, y, fy);
+                }
+                sign sy = sign_of(fy);
+                if (sy == sign_zero) {
+                    swap(a, y);
+                    return false;
+                }
+                if (sy != sign_a) {
+                    swap(a, x); swap(fa, fx);
+                    swap(b, y); swap(fb, fy);
+                    hit = true;
+                }
+                else {
+                    swap(a, y); swap(fa, fy);
+                }
+            }
+            else {
+                // the root is in (a, x), test the previous grid point
+                zm.sub(idx, mpz(1), i1);
+                if (zm.is_zero(i1)) {
+                    bqm.set(y, a);
+                    bqm.set(fy, fa);
+                }
+                else {
+                    grid(i1, y, fy);
+                }
+                sign sy = sign_of(fy);
+                if (sy == sign_zero) {
+                    swap(a, y);
+                    return false;
+                }
+                if (sy == sign_a) {
+                    swap(a, y); swap(fa, fy);
+                    swap(b, x); swap(fb, fx);
+                    hit = true;
+                }
+                else {
+                    swap(b, y); swap(fb, fy);
+                }
+            }
+            if (hit) {
+                log_n = std::min(2 * log_n, max_log_n);
+                continue;
+            }
+            log_n = std::max(2u, log_n / 2);
+            bqm.add(a, b, x);
+            bqm.div2(x);
+            eval_at(sz, p, bqm, x, fx);
+            sx = sign_of(fx);
+            if (sx == sign_zero) {
+                swap(a, x);
+                return false;
+            }
+            if (sx == sign_a) {
+                swap(a, x); swap(fa, fx);
+            }
+            else {
+                swap(b, x); swap(fb, fx);
             }
         }
     }
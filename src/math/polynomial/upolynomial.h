@@ -735,6 +735,11 @@ namespace upolynomial {
            \brief Evaluate the sign of p(b) 
         */
         sign eval_sign_at(unsigned sz, numeral const * p, mpbq const & b);
+
+        /**
+           \brief r <- p(b). The value is exact, since p has integer coefficients.
+        */
+        void eval_at(unsigned sz, numeral const * p, mpbq_manager & bqm, mpbq const & b, mpbq & r);
         
         /**
            \brief Evaluate the sign of p(b)
@@ -869,6 +874,12 @@ namespace upolynomial {
         bool refine_core(unsigned sz, numeral const * p, sign sign_a, mpbq_manager & bqm, mpbq & a, mpbq & b, unsigned prec_k);
         
         bool refine(unsigned sz, numeral const * p, mpbq_manager & bqm, mpbq & a, mpbq & b, unsigned prec_k);
+
+        // Refine until b - a < bound by quadratic interval refinement.
+        // log_n is the logarithm of the number of grid points tried in the next step,
+        // it is updated so that repeated refinements of the same interval resume at the
+        // pace reached by the previous one.
+        bool refine_core(unsigned sz, numeral const * p, sign sign_a, mpbq_manager & bqm, mpbq & a, mpbq & b, mpbq const & bound, unsigned & log_n);
         /////////////////////
 
         /**
@@ -286,8 +286,10 @@ namespace realclosure {
         sign_det *   m_sign_det; //!< != 0         if m_iso_interval constrains more than one root of m_p.
         unsigned     m_sc_idx;   //!< != UINT_MAX  if m_sign_det != 0, in this case m_sc_idx < m_sign_det->m_sign_conditions.size()
         bool         m_depends_on_infinitesimals;  //!< True if the polynomial p depends on infinitesimal extensions.
+        svector<p2s> m_sign_cache; //!< Signs of polynomials q(x) that required Tarski queries, see expensive_algebraic_poly_interval.
+        unsigned     m_sign_cache_next; //!< Next entry of m_sign_cache to be replaced when it is full.
 
-        algebraic(unsigned idx):extension(ALGEBRAIC, idx), m_sign_det(nullptr), m_sc_idx(0), m_depends_on_infinitesimals(false) {}
+        algebraic(unsigned idx):extension(ALGEBRAIC, idx), m_sign_det(nullptr), m_sc_idx(0), m_depends_on_infinitesimals(false), m_sign_cache_next(0) {}
 
         polynomial const & p() const { return m_p; }
         bool depends_on_infinitesimals() const { return m_depends_on_infinitesimals; }
@@ -824,6 +826,9 @@ namespace realclosure {
 
         void del_algebraic(algebraic * a) {
             reset_p(a->m_p);
+            for (p2s & e : a->m_sign_cache)
+                reset_p(e.first);
+            a->m_sign_cache.finalize();
             bqim().del(a->m_interval);
             bqim().del(a->m_iso_interval);
             dec_ref_sign_det(a->m_sign_det);
@@ -4730,9 +4735,40 @@ namespace realclosure {
             }
         }
 
+        static const unsigned max_sign_cache_size = 32;
+
+        bool find_cached_sign(algebraic * x, polynomial const & q, int & s) const {
+            for (p2s const & e : x->m_sign_cache) {
+                if (struct_eq(e.first, q)) {
+                    s = e.second;
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        void cache_sign(algebraic * x, polynomial const & q, int s) {
+            p2s e;
+            e.first.set(allocator(), q.size(), q.data());
+            inc_ref(q.size(), q.data());
+            e.second = s;
+            if (x->m_sign_cache.size() < max_sign_cache_size) {
+                x->m_sign_cache.push_back(e);
+                return;
+            }
+            p2s & old = x->m_sign_cache[x->m_sign_cache_next];
+            reset_p(old.first);
+            old.first.swap(e.first);
+            old.second = s;
+            x->m_sign_cache_next = (x->m_sign_cache_next + 1) % max_sign_cache_size;
+        }
+
         /**
            \brief If q(x) != 0, return true and store in r an interval that contains the value q(x), but does not contain 0.
                   If q(x) == 0, return false
+
+           The signs determined with Tarski queries are cached in x, so that evaluating
+           the same polynomial again at x only requires refining the interval r.
         */
         bool expensive_algebraic_poly_interval(polynomial const & q, algebraic * x, mpbqi & r) {
             polynomial_interval(q, x->interval(), r);
@@ -4744,6 +4780,29 @@ namespace realclosure {
                 }
                 return true;
             }
+            int s;
+            if (find_cached_sign(x, q, s)) {
+                if (s == 0)
+                    return false;
+                if (!depends_on_infinitesimals(q, x))
+                    refine_until_sign_determined(q, x, r);
+                else if (s > 0)
+                    set_lower_zero(r);
+                else
+                    set_upper_zero(r);
+                SASSERT(!contains_zero(r));
+                return true;
+            }
+            bool nz = tarski_algebraic_poly_interval(q, x, r);
+            cache_sign(x, q, !nz ? 0 : (bqim().is_P(r) ? 1 : -1));
+            return nz;
+        }
+
+        /**
+           \brief Auxiliary method for expensive_algebraic_poly_interval.
+           The interval of q over the interval of x contains zero, so the sign of q(x) is determined using Tarski queries.
+        */
+        bool tarski_algebraic_poly_interval(polynomial const & q, algebraic * x, mpbqi & r) {
             int num_roots = x->num_roots_inside_interval();
             SASSERT(x->sdt() != 0 || num_roots == 1);
             polynomial const & p = x->p();
@@ -1734,14 +1734,60 @@ namespace opt {
             d.substitute(v, new_def);
     }
     
+    /**
+       \brief estimate the number of rows created by eliminating x.
+       Variables solved by an equality create no rows. Otherwise every bound is
+       resolved against the selected bound, and mod, div and divisibility rows
+       are rewritten.
+    */
+    unsigned model_based_opt::elimination_cost(unsigned x) {
+        unsigned num_lub = 0, num_glb = 0, num_other = 0;
+        uint_set visited;
+        for (unsigned row_id : m_var2row_ids[x]) {
+            if (visited.contains(row_id))
+                continue;
+            visited.insert(row_id);
+            row const& r = m_rows[row_id];
+            if (!r.m_alive)
+                continue;
+            rational a = r.get_coefficient(x);
+            if (a.is_zero())
+                continue;
+            switch (r.m_type) {
+            case t_eq: 
+                return 0;
+            case t_le: 
+            case t_lt:
+                if (a.is_pos()) ++num_lub; else ++num_glb;
+                break;
+            default:
+                ++num_other;
+                break;
+            }
+        }
+        return 1 + num_lub + num_glb + num_other;
+    }
+
     vector<model_based_opt::def> model_based_opt::project(unsigned num_vars, unsigned const* vars, bool compute_def) {
-        m_result.reset();
+        // eliminate the variables with the fewest occurrences first, since
+        // their projections add the fewest rows for the remaining variables.
+        unsigned_vector order, cost;
         for (unsigned i = 0; i < num_vars; ++i) {
+            order.push_back(i);
+            cost.push_back(elimination_cost(vars[i]));
+        }
+        std::stable_sort(order.begin(), order.end(), [&](unsigned i, unsigned j) { return cost[i] < cost[j]; });
+        m_result.reset();
+        for (unsigned i : order) {
             m_result.push_back(project(vars[i], compute_def));
             eliminate(vars[i], m_result.back());
             TRACE("opt", display(tout << "After projecting: v" << vars[i] << "\n"););
         }
-        return m_result;
+        vector<def> result(num_vars);
+        for (unsigned k = 0; k < num_vars; ++k)
+            result[order[k]] = m_result[k];
+        m_result.reset();
+        return result;
     }
 
 }
@@ -166,6 +166,8 @@ namespace opt {
 
         def project(unsigned var, bool compute_def);
 
+        unsigned elimination_cost(unsigned x);
+
         def solve_for(unsigned row_id, unsigned x, bool compute_def);
 
         def solve_divides(unsigned x, unsigned_vector const& divide_rows, bool compute_def);
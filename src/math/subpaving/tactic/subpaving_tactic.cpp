@@ -61,6 +61,8 @@ class subpaving_tactic : public tactic {
         mpfx_manager                    m_fxm;
         arith_util                      m_autil;
         engine_kind                     m_kind;
+        bool                            m_auto;    // start with hwf and fall back to mpq when hwf is not precise enough.
+        params_ref                      m_params;
         scoped_ptr<subpaving::context>  m_ctx;
         scoped_ptr<display_var_proc>    m_proc;
         expr2var                        m_e2v;
@@ -73,6 +75,7 @@ class subpaving_tactic : public tactic {
             m_hm(m_hm_core),
             m_autil(m),
             m_kind(NONE),
+            m_auto(false),
             m_e2v(m) {
             updt_params(p);
         }
@@ -82,15 +85,34 @@ class subpaving_tactic : public tactic {
         void collect_param_descrs(param_descrs & r) {        
             m_ctx->collect_param_descrs(r);
             // #ifndef _EXTERNAL_RELEASE
-            r.insert("numeral", CPK_SYMBOL, "(default: mpq) options: mpq, mpf, hwf, mpff, mpfx.");
+            r.insert("numeral", CPK_SYMBOL, "(default: auto) options: auto, mpq, mpf, hwf, mpff, mpfx. auto uses hwf and switches to mpq if a value cannot be represented precisely.");
             r.insert("print_nodes", CPK_BOOL, "(default: false) display subpaving tree leaves.");
             // #endif
         }
         
+        void set_engine(engine_kind k) {
+            m_kind = k;
+            // m_e2s holds references into the old context
+            m_e2s = nullptr;
+            m_e2v.reset();
+            switch (m_kind) {
+            case MPQ:  m_ctx = subpaving::mk_mpq_context(m().limit(), m_qm); break;
+            case MPF:  m_ctx = subpaving::mk_mpf_context(m().limit(), m_fm); break;
+            case HWF:  m_ctx = subpaving::mk_hwf_context(m().limit(), m_hm, m_qm); break;
+            case MPFF: m_ctx = subpaving::mk_mpff_context(m().limit(), m_ffm, m_qm); break;
+            case MPFX: m_ctx = subpaving::mk_mpfx_context(m().limit(), m_fxm, m_qm); break;
+            default: UNREACHABLE(); break;
+            }
+            m_e2s = alloc(expr2subpaving, m_manager, *m_ctx, &m_e2v);
+            m_ctx->updt_params(m_params);
+        }
+
         void updt_params(params_ref const & p) {
+            m_params.copy(p);
             m_display = p.get_bool("print_nodes", false);
-            symbol engine = p.get_sym("numeral", symbol("mpq"));
+            symbol engine = p.get_sym("numeral", symbol("auto"));
             engine_kind new_kind;
+            m_auto = engine == "auto";
             if (engine == "mpq")
                 new_kind = MPQ;
             else if (engine == "mpf")
@@ -101,19 +123,10 @@ class subpaving_tactic : public tactic {
                 new_kind = MPFX;
             else 
                 new_kind = HWF;
-            if (m_kind != new_kind) {
-                m_kind = new_kind;
-                switch (m_kind) {
-                case MPQ:  m_ctx = subpaving::mk_mpq_context(m().limit(), m_qm); break;
-                case MPF:  m_ctx = subpaving::mk_mpf_context(m().limit(), m_fm); break;
-                case HWF:  m_ctx = subpaving::mk_hwf_context(m().limit(), m_hm, m_qm); break;
-                case MPFF: m_ctx = subpaving::mk_mpff_context(m().limit(), m_ffm, m_qm); break;
-                case MPFX: m_ctx = subpaving::mk_mpfx_context(m().limit(), m_fxm, m_qm); break;
-                default: UNREACHABLE(); break;
-                }
-                m_e2s = alloc(expr2subpaving, m_manager, *m_ctx, &m_e2v);
-            }
-            m_ctx->updt_params(p);
+            if (m_kind != new_kind) 
+                set_engine(new_kind);
+            else
+                m_ctx->updt_params(p);
         }
 
         void collect_statistics(statistics & st) const {
@@ -183,11 +196,13 @@ class subpaving_tactic : public tactic {
                 }
             }
             catch (const subpaving::exception &) {
+                if (m_auto && m_kind == HWF)
+                    throw;
                 throw tactic_exception("failed to internalize goal into subpaving module");
             }
         }
 
-        void process(goal const & g) {
+        void run(goal const & g) {
             internalize(g);
             m_proc = alloc(display_var_proc, m_e2v);
             m_ctx->set_display_proc(m_proc.get());
@@ -195,8 +210,30 @@ class subpaving_tactic : public tactic {
                 (*m_ctx)();
             }
             catch (const subpaving::exception &) {
+                if (m_auto && m_kind == HWF)
+                    throw;
                 throw tactic_exception("failed building subpaving tree...");
             }
+        }
+
+        void process(goal const & g) {
+            if (m_auto) {
+                // the hwf engine rounds outward, the mpq engine is used if an input or
+                // a bound does not have a precise double representation.
+                if (m_kind != HWF)
+                    set_engine(HWF);
+                try {
+                    run(g);
+                }
+                catch (const subpaving::exception &) {
+                    IF_VERBOSE(10, verbose_stream() << "(subpaving :switch-to mpq)\n");
+                    set_engine(MPQ);
+                    run(g);
+                }
+            }
+            else {
+                run(g);
+            }
             if (m_display) {
                 m_ctx->display_constraints(std::cout);
                 std::cout << "bounds at leaves: \n";
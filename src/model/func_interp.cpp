@@ -171,12 +171,80 @@ bool func_interp::is_constant() const {
     return true;
 }
 
+unsigned func_interp::hash_args(expr * const * args) const {
+    unsigned h = m_arity;
+    for (unsigned i = 0; i < m_arity; i++)
+        h = combine_hash(h, hash_u(args[i]->get_id()));
+    return h;
+}
+
+bool func_interp::args_are_unique_values(expr * const * args) const {
+    for (unsigned i = 0; i < m_arity; i++)
+        if (!m().is_unique_value(args[i]))
+            return false;
+    return true;
+}
+
+void func_interp::index_insert(func_entry * e) const {
+    if (!args_are_unique_values(e->get_args()))
+        m_index_unique = false;
+    unsigned mask = m_index.size() - 1;
+    unsigned i = hash_args(e->get_args()) & mask;
+    while (m_index[i])
+        i = (i + 1) & mask;
+    m_index[i] = e;
+}
+
+// Backward shift deletion: entries after the freed slot that would not be found
+// from their home slot across the gap are moved into it.
+void func_interp::index_erase(func_entry * e) const {
+    unsigned mask = m_index.size() - 1;
+    unsigned i = hash_args(e->get_args()) & mask;
+    while (m_index[i] != e)
+        i = (i + 1) & mask;
+    unsigned j = i;
+    while (true) {
+        j = (j + 1) & mask;
+        if (!m_index[j])
+            break;
+        unsigned k = hash_args(m_index[j]->get_args()) & mask;
+        bool move = (i <= j) ? (k <= i || k > j) : (k <= i && k > j);
+        if (move) {
+            m_index[i] = m_index[j];
+            i = j;
+        }
+    }
+    m_index[i] = nullptr;
+}
+
+void func_interp::build_index() const {
+    unsigned sz = 32;
+    while (sz < 2 * m_entries.size())
+        sz *= 2;
+    m_index.reset();
+    m_index.resize(sz, nullptr);
+    m_index_unique = true;
+    for (func_entry * curr : m_entries)
+        index_insert(curr);
+}
+
 /**
    \brief Return a func_entry e such that m().are_equal(e.m_args[i], args[i]) for all i in [0, m_arity).
    If such entry does not exist then return 0, and store set
    args_are_values to true if for all entries e e.args_are_values() is true.
 */
 func_entry * func_interp::get_entry(expr * const * args) const {
+    if (m_entries.size() >= index_threshold) {
+        if (m_index.empty())
+            build_index();
+        unsigned mask = m_index.size() - 1;
+        for (unsigned i = hash_args(args) & mask; m_index[i]; i = (i + 1) & mask)
+            if (m_index[i]->eq_args(m(), m_arity, args))
+                return m_index[i];
+        // entries with other arguments can only be equal if some arguments are not unique values
+        if (m_index_unique && args_are_unique_values(args))
+            return nullptr;
+    }
     for (func_entry* curr : m_entries) {
         if (curr->eq_args(m(), m_arity, args))
             return curr;
@@ -214,12 +282,20 @@ void func_interp::insert_new_entry(expr * const * args, expr * r) {
     if (!new_entry->args_are_values())
         m_args_are_values = false;
     m_entries.push_back(new_entry);
+    if (m_index.empty())
+        return;
+    if (4 * m_entries.size() > 3 * m_index.size())
+        build_index();
+    else
+        index_insert(new_entry);
 }
 
 void func_interp::del_entry(unsigned idx) {
     auto* e = m_entries[idx];
     m_entries[idx] = m_entries.back();
     m_entries.pop_back();
+    if (!m_index.empty())
+        index_erase(e);
     e->deallocate(m(), m_arity);
 }
 
@@ -277,6 +353,7 @@ void func_interp::compress() {
     }
     if (j < m_entries.size()) {
         reset_interp_cache();
+        m_index.reset();
         m_entries.shrink(j);
     }
     // other compression, if else is a default branch.
@@ -302,6 +379,7 @@ void func_interp::compress() {
             curr->deallocate(m(), m_arity);
         }
         m_entries.reset();
+        m_index.reset();
         reset_interp_cache();
         expr_ref new_else(m().mk_var(0, m_else->get_sort()), m());
         m().inc_ref(new_else);
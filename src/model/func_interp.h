@@ -74,8 +74,20 @@ class func_interp {
 
     expr *                 m_array_interp; // <! interp with lambda abstraction
 
+    // Open addressing index of m_entries by the ids of their arguments. It is built
+    // when a lookup finds index_threshold or more entries, and nullptr marks free slots.
+    static const unsigned          index_threshold = 16;
+    mutable ptr_vector<func_entry> m_index;
+    mutable bool                   m_index_unique = true; //!< the arguments of all entries are unique values
+
     void reset_interp_cache();
 
+    unsigned hash_args(expr * const * args) const;
+    bool args_are_unique_values(expr * const * args) const;
+    void index_insert(func_entry * e) const;
+    void index_erase(func_entry * e) const;
+    void build_index() const;
+
     expr * get_interp_core() const;
 
     expr_ref get_array_interp_core(func_decl * f) const;
@@ -67,6 +67,7 @@ struct evaluator_cfg : public default_rewriter_cfg {
     bool                            m_array_as_stores;
     obj_map<func_decl, expr*>       m_def_cache;
     expr_ref_vector                 m_pinned;
+    scoped_ptr<th_rewriter>         m_q_rw;      // reduces quantifiers, created on first use
 
     evaluator_cfg(ast_manager & m, model_core & md, params_ref const & p):
         m(m),
@@ -148,8 +149,9 @@ struct evaluator_cfg : public default_rewriter_cfg {
                            expr * const * new_no_patterns,
                            expr_ref & result,
                            proof_ref & result_pr) {
-        th_rewriter th(m);
-        return th.reduce_quantifier(old_q, new_body, new_patterns, new_no_patterns, result, result_pr);
+        if (!m_q_rw)
+            m_q_rw = alloc(th_rewriter, m);
+        return m_q_rw->reduce_quantifier(old_q, new_body, new_patterns, new_no_patterns, result, result_pr);
     }
 
     br_status reduce_app(func_decl * f, unsigned num, expr * const * args, expr_ref & result, proof_ref & result_pr) {
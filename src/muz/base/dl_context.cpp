@@ -288,6 +288,10 @@ namespace datalog {
     unsigned context::soft_timeout() const { return m_params->datalog_timeout(); }
     bool context::similarity_compressor() const { return m_params->datalog_similarity_compressor(); }
     unsigned context::similarity_compressor_threshold() const { return m_params->datalog_similarity_compressor_threshold(); }
+    unsigned context::join_threads() const { return m_params->datalog_join_threads(); }
+    bool context::sorted_key_index() const { return m_params->datalog_sorted_key_index(); }
+    bool context::leapfrog_join() const { return m_params->datalog_leapfrog_join(); }
+    bool context::incremental() const { return m_params->datalog_incremental(); }
     unsigned context::initial_restart_timeout() const { return m_params->datalog_initial_restart_timeout(); }
     bool context::generate_explanations() const { return m_params->datalog_generate_explanations(); }
     bool context::explanations_on_relation_level() const { return m_params->datalog_explanations_on_relation_level(); }
@@ -94,6 +94,19 @@ namespace datalog {
         }
     }
 
+    void rule_dependencies::populate(const rule_dependencies & o, const item_set * allowed) {
+        SASSERT(m_data.empty());
+        for (auto & kv : o) {
+            if (allowed && !allowed->contains(kv.m_key))
+                continue;
+            item_set * s = alloc(item_set);
+            for (func_decl * d : *kv.get_value())
+                if (!allowed || allowed->contains(d))
+                    s->insert(d);
+            m_data.insert(kv.m_key, s);
+        }
+    }
+
     void rule_dependencies::populate(rule const* r) {
         TRACE("dl_verbose", tout << r->get_decl()->get_name() << "\n";);
         m_visited.reset();
@@ -258,7 +271,8 @@ namespace datalog {
           m_refs(m_context.get_manager()) {
         add_rules(other);
         if (other.m_stratifier) {
-            VERIFY(close());
+            m_deps.populate(other.m_deps);
+            VERIFY(stratify());
         }
     }
 
@@ -371,6 +385,17 @@ namespace datalog {
     bool rule_set::close() {
         SASSERT(!is_closed()); //the rule_set is not already closed
         m_deps.populate(*this);
+        return stratify();
+    }
+
+    bool rule_set::close(rule_set const& src, func_decl_set const& preds) {
+        SASSERT(!is_closed());
+        SASSERT(src.is_closed());
+        m_deps.populate(src.m_deps, &preds);
+        return stratify();
+    }
+
+    bool rule_set::stratify() {
         m_stratifier = alloc(rule_stratifier, m_deps);
         if (!stratified_negation()) {
             m_stratifier = nullptr;
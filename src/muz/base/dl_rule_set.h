@@ -62,6 +62,11 @@ namespace datalog {
 
         void populate(const rule_set & rules);
         void populate(unsigned n, rule * const * rules);
+        /**
+           \brief Copy the dependencies of \c o, restricted to the predicates in \c allowed
+           when it is given. The rules are not traversed again.
+         */
+        void populate(const rule_dependencies & o, const item_set * allowed = nullptr);
         void restrict_dependencies(const item_set & allowed);
         void remove(func_decl * itm);
         void remove(const item_set & to_remove);
@@ -178,6 +183,7 @@ namespace datalog {
         void compute_deps();
         void compute_tc_deps();
         bool stratified_negation();
+        bool stratify();
     public:
         rule_set(context & ctx);
         rule_set(const rule_set & rs);
@@ -221,6 +227,13 @@ namespace datalog {
            \remark If new rules are added, the rule_set will be "reopen".
         */
         bool close();
+        /**
+           \brief Close the rule set using the dependencies of the closed rule set \c src.
+           The rules of this set must have the same dependencies in \c src, and
+           they may only use predicates in \c preds, for example, when they are
+           the rules of the predicates \c preds of \c src.
+        */
+        bool close(rule_set const& src, func_decl_set const& preds);
         void ensure_closed();
         /**
            \brief Undo the effect of the \c close() operation.
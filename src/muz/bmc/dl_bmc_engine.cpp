@@ -483,7 +483,12 @@ namespace datalog {
             q_at_level = m.mk_implies(q, p);
             b.assert_expr(q_at_level);
             expr* qr = q.get();
-            return b.m_solver->check_sat(1, &qr);
+            lbool r = b.m_solver->check_sat(1, &qr);
+            if (r == l_false) {
+                // retire the activation literal of the query at this level
+                b.assert_expr(m.mk_not(q));
+            }
+            return r;
         }
 
         proof_ref get_proof(model_ref& md, func_decl* pred, app* prop, unsigned level) {
@@ -1177,6 +1182,9 @@ namespace datalog {
                     get_model(i);
                     return res;
                 }
+                // the query is unreachable at level i, the unit is implied
+                // and keeps the solver from exploring level i again.
+                b.assert_expr(m.mk_not(mk_level_predicate(b.m_query_pred, i)));
             }
             return l_undef;
         }
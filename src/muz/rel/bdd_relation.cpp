@@ -0,0 +1,686 @@
+/*++
+Copyright (c) 2024 Microsoft Corporation
+
+Module Name:
+
+    bdd_relation.cpp
+
+Abstract:
+
+    Relation represented by a binary decision diagram over the bits
+    of its columns.
+
+--*/
+#include "muz/rel/bdd_relation.h"
+#include "muz/rel/dl_relation_manager.h"
+#include "ast/ast_util.h"
+#include "ast/rewriter/th_rewriter.h"
+
+namespace datalog {
+
+    bdd_relation::bdd_relation(bdd_plugin& p, relation_signature const& sig):
+        relation_base(p, sig),
+        m_bdd(p.get_bdd_manager().mk_false()) {
+    }
+
+    void bdd_relation::reset() {
+        m_bdd = get_plugin().get_bdd_manager().mk_false();
+    }
+
+    dd::bdd bdd_relation::fact2bdd(relation_fact const& f) const {
+        bdd_plugin& p = get_plugin();
+        dd::bdd result = p.get_bdd_manager().mk_true();
+        for (unsigned i = 0; i < f.size(); ++i) {
+            rational val;
+            VERIFY(p.is_numeral(f[i], val));
+            result &= p.mk_value(i, p.num_sort_bits(get_signature()[i]), val);
+        }
+        return result;
+    }
+
+    void bdd_relation::add_fact(const relation_fact & f) {
+        m_bdd |= fact2bdd(f);
+    }
+
+    bool bdd_relation::contains_fact(const relation_fact & f) const {
+        return !(m_bdd && fact2bdd(f)).is_false();
+    }
+
+    bdd_relation * bdd_relation::clone() const {
+        bdd_relation* result = bdd_plugin::get(get_plugin().mk_empty(get_signature()));
+        result->m_bdd = m_bdd;
+        return result;
+    }
+
+    bdd_relation * bdd_relation::complement(func_decl* f) const {
+        bdd_relation* result = bdd_plugin::get(get_plugin().mk_empty(get_signature()));
+        result->m_bdd = !m_bdd && get_plugin().mk_domain(get_signature());
+        return result;
+    }
+
+    void bdd_relation::to_formula(expr_ref& fml) const {
+        bdd_plugin& p = get_plugin();
+        ast_manager& m = fml.get_manager();
+        relation_signature const& sig = get_signature();
+        expr_ref_vector disj(m), conjs(m);
+        p.for_each_tuple(m_bdd, sig, [&](vector<rational> const& values) {
+            conjs.reset();
+            for (unsigned i = 0; i < values.size(); ++i) {
+                conjs.push_back(m.mk_eq(m.mk_var(i, sig[i]), p.mk_numeral(values[i], sig[i])));
+            }
+            disj.push_back(mk_and(conjs));
+        });
+        fml = mk_or(disj);
+    }
+
+    bdd_plugin& bdd_relation::get_plugin() const {
+        return static_cast<bdd_plugin&>(relation_base::get_plugin());
+    }
+
+    void bdd_relation::display(std::ostream& out) const {
+        get_plugin().for_each_tuple(m_bdd, get_signature(), [&](vector<rational> const& values) {
+            out << "(";
+            for (unsigned i = 0; i < values.size(); ++i) {
+                out << (i > 0 ? ", " : "") << values[i];
+            }
+            out << ")\n";
+        });
+    }
+
+    unsigned bdd_relation::get_size_estimate_rows() const {
+        double n = m_bdd.dnf_size();
+        return n > UINT_MAX ? UINT_MAX : static_cast<unsigned>(n);
+    }
+
+    unsigned bdd_relation::get_size_estimate_bytes() const {
+        return sizeof(*this) + 16 * m_bdd.bdd_size();
+    }
+
+    // -------------
+
+    bdd_plugin::bdd_plugin(relation_manager& rm):
+        relation_plugin(bdd_plugin::get_name(), rm),
+        m(rm.get_context().get_manager()),
+        bv(m),
+        dl(m),
+        m_bdd(0) {
+    }
+
+    bdd_relation& bdd_plugin::get(relation_base& r) {
+        return dynamic_cast<bdd_relation&>(r);
+    }
+
+    bdd_relation* bdd_plugin::get(relation_base* r) {
+        return r ? dynamic_cast<bdd_relation*>(r) : nullptr;
+    }
+
+    bdd_relation const & bdd_plugin::get(relation_base const& r) {
+        return dynamic_cast<bdd_relation const&>(r);
+    }
+
+    bool bdd_plugin::is_finite_sort(sort* s) const {
+        return bv.is_bv_sort(s) || m.is_bool(s) || dl.is_finite_sort(s);
+    }
+
+    unsigned bdd_plugin::num_sort_bits(sort* s) const {
+        if (bv.is_bv_sort(s))
+            return bv.get_bv_size(s);
+        if (m.is_bool(s))
+            return 1;
+        uint64_t sz;
+        unsigned num_bits = 0;
+        VERIFY(dl.try_get_size(s, sz));
+        // values range over [0, sz - 1]
+        for (sz = sz > 0 ? sz - 1 : 0; sz > 0; sz /= 2)
+            ++num_bits;
+        return std::max(num_bits, 1u);
+    }
+
+    bool bdd_plugin::is_numeral(expr* e, rational& r) {
+        unsigned num_bits;
+        uint64_t n;
+        if (bv.is_numeral(e, r, num_bits))
+            return true;
+        if (m.is_true(e)) {
+            r = rational(1);
+            return true;
+        }
+        if (m.is_false(e)) {
+            r = rational(0);
+            return true;
+        }
+        if (dl.is_numeral(e, n)) {
+            r = rational(n, rational::ui64());
+            return true;
+        }
+        return false;
+    }
+
+    expr* bdd_plugin::mk_numeral(rational const& r, sort* s) {
+        if (bv.is_bv_sort(s))
+            return bv.mk_numeral(r, s);
+        if (m.is_bool(s))
+            return r.is_zero() ? m.mk_false() : m.mk_true();
+        SASSERT(dl.is_finite_sort(s));
+        return dl.mk_numeral(r.get_uint64(), s);
+    }
+
+    unsigned_vector bdd_plugin::widths(relation_signature const& sig) const {
+        unsigned_vector result;
+        for (sort* s : sig)
+            result.push_back(num_sort_bits(s));
+        return result;
+    }
+
+    unsigned_vector bdd_plugin::column_vars(unsigned col, unsigned num_bits) {
+        unsigned_vector vars;
+        for (unsigned b = 0; b < num_bits; ++b)
+            vars.push_back(var(col, b));
+        return vars;
+    }
+
+    dd::bdd bdd_plugin::mk_value(unsigned col, unsigned num_bits, rational const& r) {
+        return m_bdd.mk_eq(column_vars(col, num_bits), r);
+    }
+
+    dd::bdd bdd_plugin::mk_eq(unsigned col1, unsigned col2, unsigned num_bits) {
+        dd::bdd result = m_bdd.mk_true();
+        for (unsigned b = num_bits; b-- > 0; )
+            result &= !(m_bdd.mk_var(var(col1, b)) ^ m_bdd.mk_var(var(col2, b)));
+        return result;
+    }
+
+    /**
+       \brief finite sorts whose size is not a power of two do not use all values of their bits.
+    */
+    dd::bdd bdd_plugin::mk_domain(relation_signature const& sig) {
+        dd::bdd result = m_bdd.mk_true();
+        for (unsigned i = 0; i < sig.size(); ++i) {
+            uint64_t sz;
+            if (!dl.is_finite_sort(sig[i]) || !dl.try_get_size(sig[i], sz))
+                continue;
+            unsigned num_bits = num_sort_bits(sig[i]);
+            rational size(sz, rational::ui64());
+            if (size == rational::power_of_two(num_bits))
+                continue;
+            result &= m_bdd.mk_ult(m_bdd.mk_var(column_vars(i, num_bits)), m_bdd.mk_num(size, num_bits));
+        }
+        return result;
+    }
+
+    dd::bdd bdd_plugin::mk_exists(dd::bdd const& b, unsigned_vector const& cols, unsigned_vector const& widths) {
+        unsigned_vector vars;
+        for (unsigned c : cols)
+            for (unsigned v : column_vars(c, widths[c]))
+                vars.push_back(v), m_bdd.mk_var(v);
+        return m_bdd.mk_exists(vars.size(), vars.data(), b);
+    }
+
+    dd::bdd bdd_plugin::move(dd::bdd const& b, unsigned_vector const& src, unsigned_vector const& dst, unsigned_vector const& widths) {
+        SASSERT(src.size() <= max_columns);
+        unsigned_vector s, d, w;
+        for (unsigned i = 0; i < src.size(); ++i) {
+            if (src[i] == dst[i])
+                continue;
+            s.push_back(src[i]);
+            d.push_back(dst[i]);
+            w.push_back(widths[i]);
+        }
+        if (s.empty())
+            return b;
+        bool overlap = any_of(s, [&](unsigned c) { return d.contains(c); });
+        if (overlap) {
+            // park the columns in the scratch space first.
+            unsigned_vector tmp;
+            for (unsigned i = 0; i < s.size(); ++i)
+                tmp.push_back(max_columns + i);
+            return move(move(b, s, tmp, w), tmp, d, w);
+        }
+        dd::bdd eqs = m_bdd.mk_true();
+        unsigned_vector vars;
+        for (unsigned i = 0; i < s.size(); ++i) {
+            eqs &= mk_eq(s[i], d[i], w[i]);
+            vars.append(column_vars(s[i], w[i]));
+        }
+        return m_bdd.mk_exists(vars.size(), vars.data(), b && eqs);
+    }
+
+    void bdd_plugin::for_each_tuple(dd::bdd const& b, relation_signature const& sig, std::function<void(vector<rational> const&)> const& f) {
+        unsigned_vector ws = widths(sig);
+        vector<rational> values(sig.size(), rational::zero());
+        std::function<void(dd::bdd, unsigned, unsigned)> rec = [&](dd::bdd c, unsigned col, unsigned bit) {
+            if (c.is_false())
+                return;
+            if (col == sig.size()) {
+                f(values);
+                return;
+            }
+            if (bit == ws[col]) {
+                rec(c, col + 1, 0);
+                return;
+            }
+            rec(c.cofactor(m_bdd.mk_nvar(var(col, bit))), col, bit + 1);
+            values[col] += rational::power_of_two(bit);
+            rec(c.cofactor(m_bdd.mk_var(var(col, bit))), col, bit + 1);
+            values[col] -= rational::power_of_two(bit);
+        };
+        rec(b, 0, 0);
+    }
+
+    bool bdd_plugin::compile_term(relation_signature const& sig, expr* e, dd::bddv& result) {
+        rational r;
+        if (is_var(e)) {
+            unsigned idx = to_var(e)->get_idx();
+            if (idx >= sig.size())
+                return false;
+            result = m_bdd.mk_var(column_vars(idx, num_sort_bits(sig[idx])));
+            return true;
+        }
+        if (is_numeral(e, r) && is_finite_sort(e->get_sort())) {
+            result = m_bdd.mk_num(r, num_sort_bits(e->get_sort()));
+            return true;
+        }
+        return false;
+    }
+
+    /**
+       \brief compile a condition over the columns of sig into a BDD.
+       Variable i of the condition refers to column i.
+    */
+    bool bdd_plugin::compile(relation_signature const& sig, expr* e, dd::bdd& result) {
+        expr* a, * b, * c;
+        dd::bdd r1 = m_bdd.mk_true(), r2 = m_bdd.mk_true(), r3 = m_bdd.mk_true();
+        dd::bddv v1 = m_bdd.mk_zero(1), v2 = m_bdd.mk_zero(1);
+        if (m.is_true(e)) {
+            result = m_bdd.mk_true();
+            return true;
+        }
+        if (m.is_false(e)) {
+            result = m_bdd.mk_false();
+            return true;
+        }
+        if (is_var(e) && m.is_bool(e)) {
+            unsigned idx = to_var(e)->get_idx();
+            if (idx >= sig.size())
+                return false;
+            result = m_bdd.mk_var(var(idx, 0));
+            return true;
+        }
+        if (m.is_not(e, a)) {
+            if (!compile(sig, a, r1))
+                return false;
+            result = !r1;
+            return true;
+        }
+        if (m.is_and(e) || m.is_or(e)) {
+            bool is_and = m.is_and(e);
+            result = is_and ? m_bdd.mk_true() : m_bdd.mk_false();
+            for (expr* arg : *to_app(e)) {
+                if (!compile(sig, arg, r1))
+                    return false;
+                result = is_and ? (result && r1) : (result || r1);
+            }
+            return true;
+        }
+        if (m.is_implies(e, a, b)) {
+            if (!compile(sig, a, r1) || !compile(sig, b, r2))
+                return false;
+            result = !r1 || r2;
+            return true;
+        }
+        if (m.is_ite(e, a, b, c) && m.is_bool(b)) {
+            if (!compile(sig, a, r1) || !compile(sig, b, r2) || !compile(sig, c, r3))
+                return false;
+            result = m_bdd.mk_ite(r1, r2, r3);
+            return true;
+        }
+        if (m.is_eq(e, a, b) && m.is_bool(a)) {
+            if (!compile(sig, a, r1) || !compile(sig, b, r2))
+                return false;
+            result = !(r1 ^ r2);
+            return true;
+        }
+        if (m.is_eq(e, a, b)) {
+            if (!compile_term(sig, a, v1) || !compile_term(sig, b, v2) || v1.size() != v2.size())
+                return false;
+            result = m_bdd.mk_eq(v1, v2);
+            return true;
+        }
+        if (m.is_distinct(e) && to_app(e)->get_num_args() == 2) {
+            a = to_app(e)->get_arg(0);
+            b = to_app(e)->get_arg(1);
+            if (!compile_term(sig, a, v1) || !compile_term(sig, b, v2) || v1.size() != v2.size())
+                return false;
+            result = !m_bdd.mk_eq(v1, v2);
+            return true;
+        }
+        bool strict = bv.is_ult(e, a, b) || bv.is_ugt(e, b, a) || dl.is_lt(e);
+        if (dl.is_lt(e)) {
+            a = to_app(e)->get_arg(0);
+            b = to_app(e)->get_arg(1);
+        }
+        if (strict || bv.is_ule(e, a, b) || bv.is_uge(e, b, a)) {
+            if (!compile_term(sig, a, v1) || !compile_term(sig, b, v2) || v1.size() != v2.size())
+                return false;
+            result = strict ? m_bdd.mk_ult(v1, v2) : m_bdd.mk_ule(v1, v2);
+            return true;
+        }
+        return false;
+    }
+
+    bool bdd_plugin::can_handle_signature(const relation_signature & sig) {
+        if (sig.size() > max_columns)
+            return false;
+        for (sort* s : sig)
+            if (!is_finite_sort(s))
+                return false;
+        return true;
+    }
+
+    relation_base * bdd_plugin::mk_empty(const relation_signature & sig) {
+        return alloc(bdd_relation, *this, sig);
+    }
+
+    relation_base * bdd_plugin::mk_full(func_decl* p, const relation_signature & sig) {
+        bdd_relation* r = get(mk_empty(sig));
+        r->m_bdd = mk_domain(sig);
+        return r;
+    }
+
+    class bdd_plugin::join_fn : public convenient_relation_join_fn {
+        unsigned_vector m_src, m_dst, m_widths2;
+        dd::bdd         m_eqs;
+    public:
+        join_fn(bdd_plugin& p, bdd_relation const& t1, bdd_relation const& t2, unsigned col_cnt,
+                const unsigned * cols1, const unsigned * cols2)
+            : convenient_relation_join_fn(t1.get_signature(), t2.get_signature(), col_cnt, cols1, cols2),
+              m_eqs(p.m_bdd.mk_true()) {
+            unsigned n1 = t1.get_num_cols();
+            m_widths2 = p.widths(t2.get_signature());
+            for (unsigned i = 0; i < t2.get_num_cols(); ++i) {
+                m_src.push_back(i);
+                m_dst.push_back(n1 + i);
+            }
+            for (unsigned i = 0; i < col_cnt; ++i)
+                m_eqs &= p.mk_eq(cols1[i], n1 + cols2[i], m_widths2[cols2[i]]);
+        }
+
+        dd::bdd join(bdd_relation const& r1, bdd_relation const& r2) {
+            bdd_plugin& p = r1.get_plugin();
+            return r1.get_bdd() && m_eqs && p.move(r2.get_bdd(), m_src, m_dst, m_widths2);
+        }
+
+        relation_base * operator()(const relation_base & _r1, const relation_base & _r2) override {
+            bdd_relation const& r1 = get(_r1);
+            bdd_relation const& r2 = get(_r2);
+            bdd_relation* result = get(r1.get_plugin().mk_empty(get_result_signature()));
+            result->set_bdd(join(r1, r2));
+            return result;
+        }
+    };
+
+    relation_join_fn * bdd_plugin::mk_join_fn(
+        const relation_base & t1, const relation_base & t2,
+        unsigned col_cnt, const unsigned * cols1, const unsigned * cols2) {
+        if (!check_kind(t1) || !check_kind(t2))
+            return nullptr;
+        if (t1.get_signature().size() + t2.get_signature().size() > max_columns)
+            return nullptr;
+        return alloc(join_fn, *this, get(t1), get(t2), col_cnt, cols1, cols2);
+    }
+
+    /**
+       \brief join followed by projection, computed as one relational product
+       so that the joined relation is never built as a separate relation.
+    */
+    class bdd_plugin::join_project_fn : public convenient_relation_join_project_fn {
+        bdd_plugin::join_fn m_join;
+        unsigned_vector m_widths, m_src, m_dst, m_kept_widths;
+    public:
+        join_project_fn(bdd_plugin& p, bdd_relation const& t1, bdd_relation const& t2,
+                        unsigned col_cnt, const unsigned * cols1, const unsigned * cols2,
+                        unsigned removed_col_cnt, const unsigned * removed_cols)
+            : convenient_relation_join_project_fn(t1.get_signature(), t2.get_signature(), col_cnt, cols1, cols2,
+                                                  removed_col_cnt, removed_cols),
+              m_join(p, t1, t2, col_cnt, cols1, cols2) {
+            m_widths = p.widths(t1.get_signature());
+            m_widths.append(p.widths(t2.get_signature()));
+            unsigned j = 0;
+            for (unsigned i = 0; i < m_widths.size(); ++i) {
+                if (m_removed_cols.contains(i))
+                    continue;
+                m_src.push_back(i);
+                m_dst.push_back(j++);
+                m_kept_widths.push_back(m_widths[i]);
+            }
+        }
+
+        relation_base * operator()(const relation_base & _r1, const relation_base & _r2) override {
+            bdd_relation const& r1 = get(_r1);
+            bdd_relation const& r2 = get(_r2);
+            bdd_plugin& p = r1.get_plugin();
+            dd::bdd b = p.mk_exists(m_join.join(r1, r2), m_removed_cols, m_widths);
+            bdd_relation* result = get(p.mk_empty(get_result_signature()));
+            result->set_bdd(p.move(b, m_src, m_dst, m_kept_widths));
+            return result;
+        }
+    };
+
+    relation_join_fn * bdd_plugin::mk_join_project_fn(
+        relation_base const& t1, relation_base const& t2,
+        unsigned joined_col_cnt, const unsigned * cols1, const unsigned * cols2,
+        unsigned removed_col_cnt, const unsigned * removed_cols) {
+        if (!check_kind(t1) || !check_kind(t2))
+            return nullptr;
+        if (t1.get_signature().size() + t2.get_signature().size() > max_columns)
+            return nullptr;
+        return alloc(join_project_fn, *this, get(t1), get(t2), joined_col_cnt, cols1, cols2,
+                     removed_col_cnt, removed_cols);
+    }
+
+    class bdd_plugin::project_fn : public convenient_relation_project_fn {
+        unsigned_vector m_widths, m_src, m_dst, m_kept_widths;
+    public:
+        project_fn(bdd_plugin& p, bdd_relation const & t, unsigned removed_col_cnt, const unsigned * removed_cols)
+            : convenient_relation_project_fn(t.get_signature(), removed_col_cnt, removed_cols) {
+            m_widths = p.widths(t.get_signature());
+            unsigned j = 0;
+            for (unsigned i = 0; i < m_widths.size(); ++i) {
+                if (m_removed_cols.contains(i))
+                    continue;
+                m_src.push_back(i);
+                m_dst.push_back(j++);
+                m_kept_widths.push_back(m_widths[i]);
+            }
+        }
+
+        relation_base * operator()(const relation_base & tb) override {
+            bdd_relation const& t = get(tb);
+            bdd_plugin& p = t.get_plugin();
+            dd::bdd b = p.mk_exists(t.get_bdd(), m_removed_cols, m_widths);
+            bdd_relation* r = get(p.mk_empty(get_result_signature()));
+            r->set_bdd(p.move(b, m_src, m_dst, m_kept_widths));
+            return r;
+        }
+    };
+
+    relation_transformer_fn * bdd_plugin::mk_project_fn(
+        const relation_base & t, unsigned col_cnt, const unsigned * removed_cols) {
+        if (!check_kind(t))
+            return nullptr;
+        return alloc(project_fn, *this, get(t), col_cnt, removed_cols);
+    }
+
+    class bdd_plugin::rename_fn : public convenient_relation_rename_fn {
+        unsigned_vector m_src, m_dst, m_widths;
+    public:
+        rename_fn(bdd_plugin& p, bdd_relation const& t, unsigned cycle_len, const unsigned * cycle)
+            : convenient_relation_rename_fn(t.get_signature(), cycle_len, cycle) {
+            unsigned n = t.get_num_cols();
+            m_widths = p.widths(t.get_signature());
+            for (unsigned i = 0; i < n; ++i) {
+                m_src.push_back(i);
+                m_dst.push_back(i);
+            }
+            // same convention as udoc_plugin::rename_fn
+            for (unsigned i = 0; i < cycle_len; ++i)
+                m_dst[cycle[(i + 1) % cycle_len]] = cycle[i];
+        }
+
+        relation_base * operator()(const relation_base & _r) override {
+            bdd_relation const& r = get(_r);
+            bdd_plugin& p = r.get_plugin();
+            bdd_relation* result = get(p.mk_empty(get_result_signature()));
+            result->set_bdd(p.move(r.get_bdd(), m_src, m_dst, m_widths));
+            return result;
+        }
+    };
+
+    relation_transformer_fn * bdd_plugin::mk_rename_fn(
+        const relation_base & r, unsigned cycle_len, const unsigned * permutation_cycle) {
+        if (!check_kind(r))
+            return nullptr;
+        return alloc(rename_fn, *this, get(r), cycle_len, permutation_cycle);
+    }
+
+    class bdd_plugin::union_fn : public relation_union_fn {
+    public:
+        void operator()(relation_base & _r, const relation_base & _src, relation_base * _delta) override {
+            bdd_relation& r = get(_r);
+            bdd_relation const& src = get(_src);
+            bdd_relation* delta = get(_delta);
+            if (delta)
+                delta->set_bdd(delta->get_bdd() || (src.get_bdd() && !r.get_bdd()));
+            r.set_bdd(r.get_bdd() || src.get_bdd());
+        }
+    };
+
+    relation_union_fn * bdd_plugin::mk_union_fn(
+        const relation_base & tgt, const relation_base & src, const relation_base * delta) {
+        if (!check_kind(tgt) || !check_kind(src) || (delta && !check_kind(*delta)))
+            return nullptr;
+        return alloc(union_fn);
+    }
+
+    relation_union_fn * bdd_plugin::mk_widen_fn(
+        const relation_base & tgt, const relation_base & src, const relation_base * delta) {
+        return mk_union_fn(tgt, src, delta);
+    }
+
+    class bdd_plugin::filter_identical_fn : public relation_mutator_fn {
+        dd::bdd m_filter;
+    public:
+        filter_identical_fn(dd::bdd const& filter): m_filter(filter) {}
+        void operator()(relation_base & _r) override {
+            bdd_relation& r = get(_r);
+            r.set_bdd(r.get_bdd() && m_filter);
+        }
+    };
+
+    relation_mutator_fn * bdd_plugin::mk_filter_identical_fn(
+        const relation_base & t, unsigned col_cnt, const unsigned * identical_cols) {
+        if (!check_kind(t))
+            return nullptr;
+        dd::bdd filter = m_bdd.mk_true();
+        for (unsigned i = 1; i < col_cnt; ++i)
+            filter &= mk_eq(identical_cols[0], identical_cols[i], num_sort_bits(t.get_signature()[identical_cols[0]]));
+        return alloc(filter_identical_fn, filter);
+    }
+
+    relation_mutator_fn * bdd_plugin::mk_filter_equal_fn(
+        const relation_base & t, const relation_element & value, unsigned col) {
+        if (!check_kind(t))
+            return nullptr;
+        rational r;
+        VERIFY(is_numeral(value, r));
+        return alloc(filter_identical_fn, mk_value(col, num_sort_bits(t.get_signature()[col]), r));
+    }
+
+    /**
+       \brief filter by a condition that could not be compiled into a BDD:
+       evaluate the condition on each tuple.
+    */
+    class bdd_plugin::filter_interpreted_fn : public relation_mutator_fn {
+        app_ref       m_condition;
+        th_rewriter   m_rw;
+    public:
+        filter_interpreted_fn(ast_manager& m, app* condition): m_condition(condition, m), m_rw(m) {}
+
+        void operator()(relation_base & _r) override {
+            bdd_relation& r = get(_r);
+            bdd_plugin& p = r.get_plugin();
+            ast_manager& m = m_condition.get_manager();
+            relation_signature const& sig = r.get_signature();
+            var_subst& vs = p.get_manager().get_context().get_var_subst();
+            expr_ref_vector args(m);
+            expr_ref ground(m);
+            dd::bdd result = p.m_bdd.mk_false();
+            p.for_each_tuple(r.get_bdd(), sig, [&](vector<rational> const& values) {
+                // arguments are in reverse order for the substitution
+                args.reset();
+                for (unsigned i = values.size(); i-- > 0; )
+                    args.push_back(p.mk_numeral(values[i], sig[i]));
+                ground = vs(m_condition, args);
+                m_rw(ground);
+                if (m.is_false(ground))
+                    return;
+                if (!m.is_true(ground))
+                    throw default_exception("bdd relation cannot evaluate filter condition");
+                dd::bdd t = p.m_bdd.mk_true();
+                for (unsigned i = 0; i < values.size(); ++i)
+                    t &= p.mk_value(i, p.num_sort_bits(sig[i]), values[i]);
+                result |= t;
+            });
+            r.set_bdd(result);
+        }
+    };
+
+    relation_mutator_fn * bdd_plugin::mk_filter_interpreted_fn(const relation_base & t, app * condition) {
+        if (!check_kind(t))
+            return nullptr;
+        dd::bdd filter = m_bdd.mk_true();
+        if (compile(t.get_signature(), condition, filter))
+            return alloc(filter_identical_fn, filter);
+        return alloc(filter_interpreted_fn, m, condition);
+    }
+
+    class bdd_plugin::negation_filter_fn : public convenient_relation_negation_filter_fn {
+        unsigned_vector m_src, m_dst, m_neg_widths, m_widths;
+        dd::bdd         m_eqs;
+    public:
+        negation_filter_fn(bdd_plugin& p, bdd_relation const& t, bdd_relation const& neg, unsigned joined_col_cnt,
+                           const unsigned *t_cols, const unsigned *neg_cols)
+            : convenient_relation_negation_filter_fn(t, neg, joined_col_cnt, t_cols, neg_cols),
+              m_eqs(p.m_bdd.mk_true()) {
+            unsigned n = t.get_num_cols();
+            m_neg_widths = p.widths(neg.get_signature());
+            m_widths = p.widths(t.get_signature());
+            m_widths.append(m_neg_widths);
+            for (unsigned i = 0; i < neg.get_num_cols(); ++i) {
+                m_src.push_back(i);
+                m_dst.push_back(n + i);
+            }
+            for (unsigned i = 0; i < joined_col_cnt; ++i)
+                m_eqs &= p.mk_eq(t_cols[i], n + neg_cols[i], m_neg_widths[neg_cols[i]]);
+        }
+
+        void operator()(relation_base& _t, const relation_base& _neg) override {
+            bdd_relation& t = get(_t);
+            bdd_relation const& neg = get(_neg);
+            bdd_plugin& p = t.get_plugin();
+            dd::bdd matched = t.get_bdd() && m_eqs && p.move(neg.get_bdd(), m_src, m_dst, m_neg_widths);
+            matched = p.mk_exists(matched, m_dst, m_widths);
+            t.set_bdd(t.get_bdd() && !matched);
+        }
+    };
+
+    relation_intersection_filter_fn * bdd_plugin::mk_filter_by_negation_fn(
+        const relation_base& t, const relation_base& neg, unsigned joined_col_cnt,
+        const unsigned *t_cols, const unsigned *negated_cols) {
+        if (!check_kind(t) || !check_kind(neg))
+            return nullptr;
+        if (t.get_signature().size() + neg.get_signature().size() > max_columns)
+            return nullptr;
+        return alloc(negation_filter_fn, *this, get(t), get(neg), joined_col_cnt, t_cols, negated_cols);
+    }
+}
@@ -0,0 +1,143 @@
+/*++
+Copyright (c) 2024 Microsoft Corporation
+
+Module Name:
+
+    bdd_relation.h
+
+Abstract:
+
+    Relation represented by a binary decision diagram over the bits
+    of its columns.
+
+    Columns of bit-vector, Boolean and finite sorts are encoded in
+    binary. Bit b of column c is BDD variable b * stride + c, so the
+    bits of all columns are interleaved from the least significant bit
+    upwards. Equalities between columns, which is what joins, renames and
+    identical-column filters produce, then have BDDs that are linear in
+    the column width. Relational operations are BDD operations: join is
+    a conjunction with column equalities, projection is existential
+    quantification and renaming moves columns through equalities.
+
+--*/
+
+#pragma once
+
+#include <functional>
+#include "math/dd/dd_bdd.h"
+#include "ast/bv_decl_plugin.h"
+#include "ast/dl_decl_plugin.h"
+#include "muz/rel/dl_base.h"
+
+namespace datalog {
+    class bdd_plugin;
+
+    class bdd_relation : public relation_base {
+        friend class bdd_plugin;
+        dd::bdd m_bdd;
+        dd::bdd fact2bdd(relation_fact const& f) const;
+    public:
+        bdd_relation(bdd_plugin& p, relation_signature const& s);
+        void reset() override;
+        void add_fact(const relation_fact & f) override;
+        bool contains_fact(const relation_fact & f) const override;
+        bdd_relation * clone() const override;
+        bdd_relation * complement(func_decl*) const override;
+        void to_formula(expr_ref& fml) const override;
+        bdd_plugin& get_plugin() const;
+        bool fast_empty() const override { return m_bdd.is_false(); }
+        bool empty() const override { return m_bdd.is_false(); }
+        void display(std::ostream& out) const override;
+        bool is_precise() const override { return true; }
+        unsigned get_size_estimate_rows() const override;
+        unsigned get_size_estimate_bytes() const override;
+
+        dd::bdd const& get_bdd() const { return m_bdd; }
+        void set_bdd(dd::bdd const& b) { m_bdd = b; }
+        unsigned get_num_cols() const { return get_signature().size(); }
+    };
+
+    class bdd_plugin : public relation_plugin {
+        friend class bdd_relation;
+        class join_fn;
+        class join_project_fn;
+        class project_fn;
+        class rename_fn;
+        class union_fn;
+        class filter_equal_fn;
+        class filter_identical_fn;
+        class filter_interpreted_fn;
+        class negation_filter_fn;
+
+        // relations have at most max_columns columns; the columns above
+        // are scratch space for moving columns that overlap.
+        static const unsigned max_columns = 64;
+        static const unsigned stride = 2 * max_columns;
+
+        ast_manager&     m;
+        bv_util          bv;
+        dl_decl_util     dl;
+        dd::bdd_manager  m_bdd;
+
+        static bdd_relation& get(relation_base& r);
+        static bdd_relation* get(relation_base* r);
+        static bdd_relation const & get(relation_base const& r);
+
+        bool is_finite_sort(sort* s) const;
+        unsigned num_sort_bits(sort* s) const;
+        bool is_numeral(expr* e, rational& r);
+        expr* mk_numeral(rational const& r, sort* s);
+
+        unsigned var(unsigned col, unsigned bit) const { return bit * stride + col; }
+        unsigned_vector widths(relation_signature const& sig) const;
+        unsigned_vector column_vars(unsigned col, unsigned num_bits);
+        dd::bdd mk_value(unsigned col, unsigned num_bits, rational const& r);
+        dd::bdd mk_eq(unsigned col1, unsigned col2, unsigned num_bits);
+        dd::bdd mk_domain(relation_signature const& sig);
+        dd::bdd mk_exists(dd::bdd const& b, unsigned_vector const& cols, unsigned_vector const& widths);
+
+        /**
+           \brief move column src[i], of width widths[i], to column dst[i].
+           The destination columns must not be constrained by b unless they are also moved.
+        */
+        dd::bdd move(dd::bdd const& b, unsigned_vector const& src, unsigned_vector const& dst, unsigned_vector const& widths);
+
+        /**
+           \brief enumerate the tuples of b, which ranges over columns of signature sig.
+        */
+        void for_each_tuple(dd::bdd const& b, relation_signature const& sig, std::function<void(vector<rational> const&)> const& f);
+
+        bool compile(relation_signature const& sig, expr* e, dd::bdd& result);
+        bool compile_term(relation_signature const& sig, expr* e, dd::bddv& result);
+    public:
+        bdd_plugin(relation_manager& rm);
+        bool can_handle_signature(const relation_signature & s) override;
+        static symbol get_name() { return symbol("bdd"); }
+        dd::bdd_manager& get_bdd_manager() { return m_bdd; }
+        relation_base * mk_empty(const relation_signature & s) override;
+        relation_base * mk_full(func_decl* p, const relation_signature & s) override;
+        relation_join_fn * mk_join_fn(const relation_base & t1, const relation_base & t2,
+            unsigned col_cnt, const unsigned * cols1, const unsigned * cols2) override;
+        relation_join_fn * mk_join_project_fn(
+            relation_base const& t1, relation_base const& t2,
+            unsigned joined_col_cnt, const unsigned * cols1, const unsigned * cols2,
+            unsigned removed_col_cnt, const unsigned * removed_cols) override;
+        relation_transformer_fn * mk_project_fn(const relation_base & t, unsigned col_cnt,
+            const unsigned * removed_cols) override;
+        relation_transformer_fn * mk_rename_fn(const relation_base & t, unsigned permutation_cycle_len,
+            const unsigned * permutation_cycle) override;
+        relation_union_fn * mk_union_fn(const relation_base & tgt, const relation_base & src,
+            const relation_base * delta) override;
+        relation_union_fn * mk_widen_fn(const relation_base & tgt, const relation_base & src,
+            const relation_base * delta) override;
+        relation_mutator_fn * mk_filter_identical_fn(const relation_base & t, unsigned col_cnt,
+            const unsigned * identical_cols) override;
+        relation_mutator_fn * mk_filter_equal_fn(const relation_base & t, const relation_element & value,
+            unsigned col) override;
+        relation_mutator_fn * mk_filter_interpreted_fn(const relation_base & t, app * condition) override;
+        relation_intersection_filter_fn * mk_filter_by_negation_fn(
+            const relation_base& t,
+            const relation_base& neg, unsigned joined_col_cnt, const unsigned *t_cols,
+            const unsigned *negated_cols) override;
+    };
+};
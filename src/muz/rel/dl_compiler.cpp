@@ -28,6 +28,7 @@ Revision History:
 #include "ast/ast_pp.h"
 // include"ast_smt2_pp.h"
 #include "ast/ast_util.h"
+#include "ast/used_vars.h"
 
 
 namespace datalog {
@@ -74,6 +75,70 @@ namespace datalog {
             vars.get_cols2(), removed_cols.size(), removed_cols.data(), result));
     }
 
+    void compiler::make_multi_join(rule * r, const reg_idx * tail_regs, reg_idx & result,
+            expr_ref_vector & result_vars, instruction_block & acc) {
+        ast_manager & m = m_context.get_manager();
+        unsigned pt_len = r->get_positive_tail_size();
+
+        // order the variables by the number of tails they occur in, so that the
+        // variables that constrain the most tables are bound first.
+        unsigned_vector vars, occs;
+        u_map<unsigned> var2idx;
+        ptr_vector<sort> sorts;
+        for (unsigned i = 0; i < pt_len; ++i) {
+            uint_set seen;
+            for (expr * arg : *r->get_tail(i)) {
+                if (!is_var(arg))
+                    continue;
+                unsigned v = to_var(arg)->get_idx();
+                unsigned idx;
+                if (!var2idx.find(v, idx)) {
+                    idx = vars.size();
+                    var2idx.insert(v, idx);
+                    vars.push_back(v);
+                    occs.push_back(0);
+                    sorts.push_back(arg->get_sort());
+                }
+                if (!seen.contains(v)) {
+                    seen.insert(v);
+                    ++occs[idx];
+                }
+            }
+        }
+        unsigned_vector order;
+        for (unsigned i = 0; i < vars.size(); ++i) 
+            order.push_back(i);
+        std::stable_sort(order.begin(), order.end(), [&](unsigned a, unsigned b) { return occs[a] > occs[b]; });
+        unsigned_vector var_order;
+        for (unsigned i : order)
+            var_order.push_back(vars[i]);
+
+        used_vars uv;
+        uv.process(r->get_head());
+        for (unsigned i = pt_len; i < r->get_tail_size(); ++i)
+            uv.process(r->get_tail(i));
+        unsigned_vector out_vars;
+        relation_signature sig;
+        for (unsigned i = 0; i < vars.size(); ++i) {
+            if (uv.contains(vars[i])) {
+                out_vars.push_back(vars[i]);
+                sig.push_back(sorts[i]);
+                result_vars.push_back(m.mk_var(vars[i], sorts[i]));
+            }
+        }
+        if (out_vars.empty() && !vars.empty()) {
+            // keep one column so that the result records whether the body is satisfiable
+            out_vars.push_back(vars[0]);
+            sig.push_back(sorts[0]);
+            result_vars.push_back(m.mk_var(vars[0], sorts[0]));
+        }
+        result = get_fresh_register(sig);
+        ptr_vector<app> atoms;
+        for (unsigned i = 0; i < pt_len; ++i)
+            atoms.push_back(r->get_tail(i));
+        acc.push_back(instruction::mk_multi_join(m, pt_len, tail_regs, atoms.data(), var_order, out_vars, sig, result));
+    }
+
     void compiler::make_filter_interpreted_and_project(reg_idx src, app_ref & cond,
             const unsigned_vector & removed_cols, reg_idx & result, bool reuse, instruction_block & acc) {
         SASSERT(!removed_cols.empty());
@@ -459,7 +524,9 @@ namespace datalog {
         TRACE("dl", r->display(m_context, tout); );
 
         unsigned pt_len = r->get_positive_tail_size();
-        SASSERT(pt_len<=2); //we require rules to be processed by the mk_simple_joins rule transformer plugin
+        //we require rules to be processed by the mk_simple_joins rule transformer plugin,
+        //which keeps longer bodies only for the multi-way join
+        SASSERT(pt_len<=2 || m_context.leapfrog_join());
 
         reg_idx single_res;
         expr_ref_vector single_res_expr(m);
@@ -471,7 +538,10 @@ namespace datalog {
         // whether to dealloc the previous result
         bool dealloc = true;
 
-        if(pt_len == 2) {
+        if(pt_len > 2) {
+            make_multi_join(r, tail_regs, single_res, single_res_expr, acc);
+        }
+        else if(pt_len == 2) {
             reg_idx t1_reg=tail_regs[0];
             reg_idx t2_reg=tail_regs[1];
             app * a1 = r->get_tail(0);
@@ -1099,10 +1169,19 @@ namespace datalog {
 
     void compiler::compile_loop(const func_decl_vector & head_preds, const func_decl_set & widened_preds,
             const pred2idx & global_head_deltas, const pred2idx & global_tail_deltas, 
-            const pred2idx & local_deltas, instruction_block & acc) {
+            const pred2idx & local_deltas, const pred2idx & output_deltas, instruction_block & acc) {
         instruction_block * loop_body = alloc(instruction_block);
         loop_body->set_observer(&m_instruction_observer);
 
+        //the source deltas of each iteration hold the new tuples of the previous one,
+        //and the loop runs until they are empty, so they add up to the output deltas
+        for (auto const& kv : global_tail_deltas) {
+            reg_idx out_delta;
+            if (output_deltas.find(kv.m_key, out_delta)) {
+                loop_body->push_back(instruction::mk_union(kv.m_value, out_delta, execution_context::void_register));
+            }
+        }
+
         pred2idx all_head_deltas(global_head_deltas);
         unite_disjoint_maps(all_head_deltas, local_deltas);
         pred2idx all_tail_deltas(global_tail_deltas);
@@ -1128,19 +1207,6 @@ namespace datalog {
             const pred2idx * input_deltas, const pred2idx & output_deltas, 
             bool add_saturation_marks, instruction_block & acc) {
         
-        if (!output_deltas.empty()) {
-            func_decl_set::iterator hpit = head_preds.begin();
-            func_decl_set::iterator hpend = head_preds.end();
-            for(; hpit!=hpend; ++hpit) {
-                if(output_deltas.contains(*hpit)) {
-                    //we do not support retrieving deltas for rules that are inside a recursive 
-                    //stratum, since we would have to maintain this 'global' delta through the loop
-                    //iterations
-                    NOT_IMPLEMENTED_YET();
-                }
-            }
-        }
-
         func_decl_vector preds_vector;
         func_decl_set global_deltas_dummy;
 
@@ -1170,14 +1236,20 @@ namespace datalog {
         func_decl_set empty_func_decl_set;
 
         //generate code for the initial run
-        // compile_preds(preds_vector, empty_func_decl_set, input_deltas, d_global_src, acc);
-        compile_preds_init(preds_vector, empty_func_decl_set, input_deltas, d_global_src, acc);
+        if (input_deltas) {
+            //the relations are saturated up to the input deltas, so the initial
+            //run only needs the rule instances that use them
+            compile_preds(preds_vector, empty_func_decl_set, input_deltas, d_global_src, acc);
+        }
+        else {
+            compile_preds_init(preds_vector, empty_func_decl_set, input_deltas, d_global_src, acc);
+        }
 
         if (compile_with_widening()) {
-            compile_loop(preds_vector, global_deltas, d_global_tgt, d_global_src, d_local, acc);
+            compile_loop(preds_vector, global_deltas, d_global_tgt, d_global_src, d_local, output_deltas, acc);
         }
         else {
-            compile_loop(preds_vector, empty_func_decl_set, d_global_tgt, d_global_src, d_local, acc);
+            compile_loop(preds_vector, empty_func_decl_set, d_global_tgt, d_global_src, d_local, output_deltas, acc);
         }
 
 
@@ -1290,6 +1362,34 @@ namespace datalog {
         }
     }
 
+    void compiler::compile_strats_incremental(const rule_stratifier & stratifier, pred2idx & deltas,
+            instruction_block & acc) {
+        for (func_decl_set * strat : stratifier.get_strats()) {
+            func_decl_set & strat_preds = *strat;
+            if (all_saturated(strat_preds)) {
+                continue;
+            }
+            pred2idx output_deltas;
+            get_fresh_registers(strat_preds, output_deltas);
+            if (is_nonrecursive_stratum(strat_preds)) {
+                compile_nonrecursive_stratum(strat_preds, &deltas, output_deltas, true, acc);
+            }
+            else {
+                compile_dependent_rules(strat_preds, &deltas, output_deltas, true, acc);
+            }
+            for (auto const& kv : output_deltas) {
+                reg_idx delta;
+                if (deltas.find(kv.m_key, delta)) {
+                    //the predicate also received inserted facts
+                    acc.push_back(instruction::mk_union(kv.m_value, delta, execution_context::void_register));
+                }
+                else {
+                    deltas.insert(kv.m_key, kv.m_value);
+                }
+            }
+        }
+    }
+
     void compiler::do_compilation(instruction_block & execution_code, 
             instruction_block & termination_code) {
 
@@ -1313,10 +1413,26 @@ namespace datalog {
             }
         }
         
-        pred2idx empty_pred2idx_map;
+        if (m_inserted) {
+            pred2idx deltas;
+            for (auto const& kv : *m_inserted) {
+                reg_idx reg;
+                if (!m_pred_regs.find(kv.m_key, reg)) {
+                    continue;
+                }
+                relation_signature sig = m_reg_signatures[reg];
+                reg_idx delta = get_fresh_register(sig);
+                acc.push_back(instruction::mk_load(m_context.get_manager(), kv.m_value, delta));
+                deltas.insert(kv.m_key, delta);
+            }
+            compile_strats_incremental(m_rule_set.get_stratifier(), deltas, execution_code);
+        }
+        else {
+            pred2idx empty_pred2idx_map;
 
-        compile_strats(m_rule_set.get_stratifier(), static_cast<pred2idx *>(nullptr),
-            empty_pred2idx_map, true, execution_code);
+            compile_strats(m_rule_set.get_stratifier(), static_cast<pred2idx *>(nullptr),
+                empty_pred2idx_map, true, execution_code);
+        }
 
 
 
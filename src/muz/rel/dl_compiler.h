@@ -116,6 +116,7 @@ namespace datalog {
         obj_map<decl, reg_idx>            m_empty_tables_registers;
         instruction_observer              m_instruction_observer;
         expr_free_vars                    m_free_vars;
+        obj_map<func_decl, func_decl*> const * m_inserted { nullptr };
 
 
         /**
@@ -148,6 +149,13 @@ namespace datalog {
             unsigned min_col, instruction_block & acc);
         void make_join_project(reg_idx t1, reg_idx t2, const variable_intersection & vars, 
             const unsigned_vector & removed_cols, reg_idx & result, bool reuse_t1, instruction_block & acc);
+        /**
+           \brief Join all positive tails of \c r at once by a multi-way join. The result has
+           one column for each variable of the positive tails that is used elsewhere in the rule;
+           the variables are stored in \c result_vars.
+        */
+        void make_multi_join(rule * r, const reg_idx * tail_regs, reg_idx & result,
+            expr_ref_vector & result_vars, instruction_block & acc);
         void make_filter_interpreted_and_project(reg_idx src, app_ref & cond,
             const unsigned_vector & removed_cols, reg_idx & result, bool reuse, instruction_block & acc);
         void make_select_equal_and_project(reg_idx src, const relation_element val, unsigned col,
@@ -226,7 +234,7 @@ namespace datalog {
             const pred2idx & global_tail_deltas, const pred2idx & local_deltas, instruction_block & acc);
         void compile_loop(const func_decl_vector & head_preds, const func_decl_set & widened_preds,
             const pred2idx & global_head_deltas, const pred2idx & global_tail_deltas, 
-            const pred2idx & local_deltas, instruction_block & acc);
+            const pred2idx & local_deltas, const pred2idx & output_deltas, instruction_block & acc);
         void compile_dependent_rules(const func_decl_set & head_preds,
             const pred2idx * input_deltas, const pred2idx & output_deltas, 
             bool add_saturation_marks, instruction_block & acc);
@@ -250,6 +258,14 @@ namespace datalog {
             const pred2idx * input_deltas, const pred2idx & output_deltas, 
             bool add_saturation_marks, instruction_block & acc);
 
+        /**
+           \brief Generate code that propagates the tuples in \c deltas through the strata.
+           The relations already hold a fixpoint of the rules without these tuples, so only
+           rule instances that use a delta tuple are evaluated.
+        */
+        void compile_strats_incremental(const rule_stratifier & stratifier, pred2idx & deltas,
+            instruction_block & acc);
+
         bool all_saturated(const func_decl_set & preds) const;
 
         void reset();
@@ -276,6 +292,19 @@ namespace datalog {
                 .do_compilation(execution_code, termination_code);
         }
 
+        /**
+           \brief Compile \c rules for incremental saturation. The relations hold a fixpoint
+           and \c inserted maps predicates to predicates whose relations contain the tuples
+           added since then.
+        */
+        static void compile_incremental(context & ctx, rule_set const & rules,
+                obj_map<func_decl, func_decl*> const & inserted,
+                instruction_block & execution_code, instruction_block & termination_code) {
+            compiler c(ctx, rules, execution_code);
+            c.m_inserted = &inserted;
+            c.do_compilation(execution_code, termination_code);
+        }
+
     };
 
 
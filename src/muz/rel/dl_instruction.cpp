@@ -23,6 +23,8 @@ Revision History:
 #include "muz/base/dl_util.h"
 #include "muz/rel/dl_instruction.h"
 #include "muz/rel/rel_context.h"
+#include "muz/rel/dl_table_relation.h"
+#include "muz/rel/dl_leapfrog_join.h"
 #include "util/debug.h"
 #include "util/warning.h"
 
@@ -135,6 +137,7 @@ namespace datalog {
         st.update("dl.filter_interpreted_project", m_stats.m_filter_interp_project);
         st.update("dl.filter_id", m_stats.m_filter_id);
         st.update("dl.filter_eq", m_stats.m_filter_eq);
+        st.update("dl.multi_join", m_stats.m_multi_join);
     }
 
 
@@ -420,6 +423,109 @@ namespace datalog {
         return alloc(instr_join, rel1, rel2, col_cnt, cols1, cols2, result);
     }
 
+    class instr_multi_join : public instruction {
+        svector<reg_idx>   m_rels;
+        app_ref_vector     m_atoms;
+        unsigned_vector    m_var_order;
+        unsigned_vector    m_out_vars;
+        relation_signature m_sig;
+        reg_idx            m_res;
+    public:
+        instr_multi_join(ast_manager & m, unsigned num_rels, const reg_idx * rels, app * const * atoms,
+            const unsigned_vector & var_order, const unsigned_vector & out_vars,
+            const relation_signature & sig, reg_idx result)
+            : m_rels(num_rels, rels), m_atoms(m, num_rels, atoms), m_var_order(var_order),
+            m_out_vars(out_vars), m_sig(sig), m_res(result) {}
+
+        bool perform(execution_context & ctx) override {
+            log_verbose(ctx);
+            ++ctx.m_stats.m_multi_join;
+            for (reg_idx r : m_rels) {
+                if (!ctx.reg(r)) {
+                    ctx.make_empty(m_res);
+                    return true;
+                }
+            }
+            relation_manager & rm = ctx.get_rel_context().get_rmanager();
+            u_map<unsigned> var2pos;
+            for (unsigned i = 0; i < m_var_order.size(); ++i) {
+                var2pos.insert(m_var_order[i], i);
+            }
+            leapfrog_join join(m_var_order.size());
+            unsigned_vector args;
+            table_fact constants;
+            for (unsigned i = 0; i < m_rels.size(); ++i) {
+                const table_relation * r = dynamic_cast<const table_relation *>(ctx.reg(m_rels[i]));
+                if (!r) {
+                    throw default_exception(default_exception::fmt(),
+                                            "multi-way join is not supported on relations of kind %s",
+                                            ctx.reg(m_rels[i])->get_plugin().get_name().str().c_str());
+                }
+                args.reset();
+                constants.reset();
+                for (expr * arg : *m_atoms.get(i)) {
+                    table_element val = 0;
+                    if (is_var(arg)) {
+                        args.push_back(var2pos[to_var(arg)->get_idx()]);
+                    }
+                    else {
+                        rm.relation_to_table(arg->get_sort(), to_app(arg), val);
+                        args.push_back(UINT_MAX);
+                    }
+                    constants.push_back(val);
+                }
+                join.add_table(r->get_table(), args, constants);
+            }
+
+            table_signature tsig;
+            VERIFY(rm.relation_signature_to_table(m_sig, tsig));
+            table_base * res = rm.mk_empty_table(tsig);
+            unsigned_vector out_pos;
+            for (unsigned v : m_out_vars) {
+                out_pos.push_back(var2pos[v]);
+            }
+            table_fact fact;
+            unsigned num_facts = 0;
+            join([&](svector<table_element> const & values) {
+                fact.reset();
+                for (unsigned p : out_pos) {
+                    fact.push_back(values[p]);
+                }
+                res->add_fact(fact);
+                return (++num_facts % 1024) != 0 || !ctx.should_terminate();
+            });
+            ctx.set_reg(m_res, rm.mk_table_relation(m_sig, res));
+            if (ctx.reg(m_res)->fast_empty()) {
+                ctx.make_empty(m_res);
+            }
+            return true;
+        }
+        std::ostream& display_head_impl(execution_context const & ctx, std::ostream & out) const override {
+            out << "multi_join";
+            for (reg_idx r : m_rels) {
+                out << " " << r;
+            }
+            out << " over variables";
+            print_container(m_var_order, out);
+            return out << " into " << m_res;
+        }
+        void make_annotations(execution_context & ctx) override {
+            std::string a = "multi join";
+            for (reg_idx r : m_rels) {
+                std::string s = "rel";
+                ctx.get_register_annotation(r, s);
+                a += " " + s;
+            }
+            ctx.set_register_annotation(m_res, a);
+        }
+    };
+
+    instruction * instruction::mk_multi_join(ast_manager & m, unsigned num_rels, const reg_idx * rels,
+            app * const * atoms, const unsigned_vector & var_order, const unsigned_vector & out_vars,
+            const relation_signature & sig, reg_idx result) {
+        return alloc(instr_multi_join, m, num_rels, rels, atoms, var_order, out_vars, sig, result);
+    }
+
     class instr_filter_equal : public instruction {
         reg_idx m_reg;
         app_ref m_value;
@@ -92,6 +92,7 @@ namespace datalog {
             unsigned m_filter_id;
             unsigned m_filter_eq;
             unsigned m_min;
+            unsigned m_multi_join;
             stats() { reset(); }
             void reset() { memset(this, 0, sizeof(*this)); }
         };
@@ -283,6 +284,14 @@ namespace datalog {
         static instruction * mk_join_project(reg_idx rel1, reg_idx rel2, unsigned joined_col_cnt,
             const unsigned * cols1, const unsigned * cols2, unsigned removed_col_cnt, 
             const unsigned * removed_cols, reg_idx result);
+        /**
+           \brief join the relations in \c rels, which hold the atoms \c atoms of a rule body,
+           by leapfrog triejoin. The join binds the rule variables in the order \c var_order and
+           the result has one column for each variable in \c out_vars.
+        */
+        static instruction * mk_multi_join(ast_manager & m, unsigned num_rels, const reg_idx * rels,
+            app * const * atoms, const unsigned_vector & var_order, const unsigned_vector & out_vars,
+            const relation_signature & sig, reg_idx result);
         static instruction * mk_min(reg_idx source, reg_idx target, const unsigned_vector & group_by_cols,
             unsigned min_col);
         static instruction * mk_rename(reg_idx src, unsigned cycle_len, const unsigned * permutation_cycle, 
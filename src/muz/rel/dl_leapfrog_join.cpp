@@ -0,0 +1,183 @@
+/*++
+Copyright (c) 2024 Microsoft Corporation
+
+Module Name:
+
+    dl_leapfrog_join.cpp
+
+Abstract:
+
+    Multi-way join of tables by leapfrog triejoin.
+
+--*/
+
+#include <algorithm>
+#include "muz/rel/dl_leapfrog_join.h"
+
+namespace datalog {
+
+    leapfrog_join::leapfrog_join(unsigned num_vars):
+        m_num_vars(num_vars),
+        m_var2atoms(num_vars),
+        m_var2cols(num_vars),
+        m_values(num_vars, table_element(0)) {
+    }
+
+    void leapfrog_join::add_table(table_base const& t, unsigned_vector const& args, table_fact const& constants) {
+        atom a;
+        for (unsigned v : args)
+            if (v != UINT_MAX && !a.m_vars.contains(v))
+                a.m_vars.push_back(v);
+        std::sort(a.m_vars.begin(), a.m_vars.end());
+        unsigned width = a.m_vars.size();
+
+        unsigned_vector var2col(m_num_vars, UINT_MAX);
+        for (unsigned i = 0; i < width; ++i)
+            var2col[a.m_vars[i]] = i;
+
+        // copy the rows that agree with the constants and with repeated variables.
+        svector<table_element> rows, row(width, table_element(0));
+        unsigned num_rows = 0;
+        bool_vector seen(width, false);
+        table_fact f;
+        for (auto const& r : t) {
+            r.get_fact(f);
+            seen.fill(false);
+            bool ok = true;
+            for (unsigned i = 0; ok && i < args.size(); ++i) {
+                if (args[i] == UINT_MAX) {
+                    ok = f[i] == constants[i];
+                    continue;
+                }
+                unsigned c = var2col[args[i]];
+                if (seen[c])
+                    ok = row[c] == f[i];
+                row[c] = f[i];
+                seen[c] = true;
+            }
+            if (ok) {
+                rows.append(row);
+                ++num_rows;
+            }
+        }
+
+        if (width == 0) {
+            m_empty |= num_rows == 0;
+            return;
+        }
+
+        unsigned_vector order;
+        for (unsigned i = 0; i < num_rows; ++i)
+            order.push_back(i);
+        std::sort(order.begin(), order.end(), [&](unsigned x, unsigned y) {
+            return std::lexicographical_compare(rows.data() + x * width, rows.data() + (x + 1) * width,
+                                                rows.data() + y * width, rows.data() + (y + 1) * width);
+        });
+        for (unsigned i : order)
+            for (unsigned c = 0; c < width; ++c)
+                a.m_rows.push_back(rows[i * width + c]);
+        a.m_num_rows = num_rows;
+
+        unsigned idx = m_atoms.size();
+        for (unsigned c = 0; c < width; ++c) {
+            m_var2atoms[a.m_vars[c]].push_back(idx);
+            m_var2cols[a.m_vars[c]].push_back(c);
+        }
+        m_atoms.push_back(std::move(a));
+    }
+
+    /**
+       \brief first row in [lo, hi) whose value in column col is at least v (above v if strict).
+       The values of the column are sorted within the range. Gallop from lo, then bisect.
+    */
+    unsigned leapfrog_join::seek(atom const& a, unsigned col, unsigned lo, unsigned hi, table_element v, bool strict) const {
+        auto before = [&](unsigned row) {
+            table_element w = a.get(row, col);
+            return strict ? w <= v : w < v;
+        };
+        if (lo == hi || !before(lo))
+            return lo;
+        unsigned step = 1;
+        unsigned last = lo;
+        while (last + step < hi && before(last + step)) {
+            last += step;
+            step *= 2;
+        }
+        // before(last) holds and the answer lies in (last, min(last + step, hi)]
+        unsigned l = last + 1, h = std::min(last + step, hi);
+        while (l < h) {
+            unsigned mid = l + (h - l) / 2;
+            if (before(mid))
+                l = mid + 1;
+            else
+                h = mid;
+        }
+        return l;
+    }
+
+    bool leapfrog_join::join(unsigned depth, std::function<bool(svector<table_element> const&)> const& f) {
+        if (depth == m_num_vars)
+            return f(m_values);
+        unsigned_vector const& as = m_var2atoms[depth];
+        unsigned_vector const& cs = m_var2cols[depth];
+        unsigned n = as.size();
+        SASSERT(n > 0);
+        unsigned_vector cur(n), up(n);
+        table_element x = 0;
+        for (unsigned i = 0; i < n; ++i) {
+            cur[i] = lo(as[i], cs[i]);
+            if (cur[i] == hi(as[i], cs[i]))
+                return true;
+            x = std::max(x, m_atoms[as[i]].get(cur[i], cs[i]));
+        }
+        while (true) {
+            bool agree = true;
+            for (unsigned i = 0; i < n; ++i) {
+                atom const& a = m_atoms[as[i]];
+                unsigned h = hi(as[i], cs[i]);
+                cur[i] = seek(a, cs[i], cur[i], h, x, false);
+                if (cur[i] == h)
+                    return true;
+                table_element v = a.get(cur[i], cs[i]);
+                if (v != x) {
+                    x = v;
+                    agree = false;
+                }
+            }
+            if (!agree)
+                continue;
+            m_values[depth] = x;
+            for (unsigned i = 0; i < n; ++i) {
+                up[i] = seek(m_atoms[as[i]], cs[i], cur[i], hi(as[i], cs[i]), x, true);
+                lo(as[i], cs[i] + 1) = cur[i];
+                hi(as[i], cs[i] + 1) = up[i];
+            }
+            if (!join(depth + 1, f))
+                return false;
+            x = 0;
+            for (unsigned i = 0; i < n; ++i) {
+                cur[i] = up[i];
+                if (cur[i] == hi(as[i], cs[i]))
+                    return true;
+                x = std::max(x, m_atoms[as[i]].get(cur[i], cs[i]));
+            }
+        }
+    }
+
+    void leapfrog_join::operator()(std::function<bool(svector<table_element> const&)> const& f) {
+        if (m_empty)
+            return;
+        for (unsigned v = 0; v < m_num_vars; ++v)
+            if (m_var2atoms[v].empty())
+                return;
+        m_lo.reset();
+        m_hi.reset();
+        m_lo.resize(m_atoms.size() * (m_num_vars + 1), 0);
+        m_hi.resize(m_atoms.size() * (m_num_vars + 1), 0);
+        for (unsigned a = 0; a < m_atoms.size(); ++a) {
+            lo(a, 0) = 0;
+            hi(a, 0) = m_atoms[a].m_num_rows;
+        }
+        join(0, f);
+    }
+};
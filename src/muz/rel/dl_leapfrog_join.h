@@ -0,0 +1,69 @@
+/*++
+Copyright (c) 2024 Microsoft Corporation
+
+Module Name:
+
+    dl_leapfrog_join.h
+
+Abstract:
+
+    Multi-way join of tables by leapfrog triejoin.
+
+    The variables of the join are bound one at a time in a fixed order.
+    Each table is copied into an array of rows over its variables, sorted
+    in the order of the join variables, so that the rows that agree with
+    the variables bound so far form a contiguous range. The values of the
+    next variable are enumerated by intersecting the ranges of all tables
+    that contain it with galloping lower-bound searches. No intermediate
+    results are built, which keeps cyclic joins such as triangles within
+    the worst-case output size.
+
+--*/
+
+#pragma once
+
+#include <functional>
+#include "muz/rel/dl_base.h"
+
+namespace datalog {
+
+    class leapfrog_join {
+        struct atom {
+            unsigned_vector        m_vars;     // join variables of the table, in join order
+            svector<table_element> m_rows;     // rows over m_vars, sorted lexicographically
+            unsigned               m_num_rows = 0;
+
+            table_element get(unsigned row, unsigned col) const { return m_rows[row * m_vars.size() + col]; }
+        };
+
+        unsigned                m_num_vars;
+        bool                    m_empty = false;    // a table without join variables has no matching row
+        vector<atom>            m_atoms;
+        vector<unsigned_vector> m_var2atoms;        // atoms containing each variable
+        vector<unsigned_vector> m_var2cols;         // column of the variable in each of these atoms
+        svector<table_element>  m_values;           // current binding
+        unsigned_vector         m_lo, m_hi;         // row range of each atom, per bound prefix of its variables
+
+        unsigned seek(atom const& a, unsigned col, unsigned lo, unsigned hi, table_element v, bool strict) const;
+        bool join(unsigned depth, std::function<bool(svector<table_element> const&)> const& f);
+        unsigned& lo(unsigned a, unsigned k) { return m_lo[a * (m_num_vars + 1) + k]; }
+        unsigned& hi(unsigned a, unsigned k) { return m_hi[a * (m_num_vars + 1) + k]; }
+
+    public:
+        leapfrog_join(unsigned num_vars);
+
+        /**
+           \brief add a table to the join. Entry i of \c args is the join variable of column i,
+           or UINT_MAX if the column must be equal to \c constants[i]. A variable may occur in
+           several columns of the same table.
+        */
+        void add_table(table_base const& t, unsigned_vector const& args, table_fact const& constants);
+
+        /**
+           \brief enumerate the bindings of all join variables that satisfy every table.
+           Enumeration stops when \c f returns false.
+        */
+        void operator()(std::function<bool(svector<table_element> const&)> const& f);
+    };
+
+};
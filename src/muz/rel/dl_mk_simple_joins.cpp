@@ -128,6 +128,7 @@ namespace datalog {
         ptr_vector<app>   m_interpreted;
         rule_pred_map     m_rules_content;
         rule_ref_vector   m_introduced_rules;
+        ptr_vector<rule>  m_multi_join_rules;
         bool              m_modified_rules;
         
         ast_ref_vector m_pinned;
@@ -691,11 +692,46 @@ namespace datalog {
         }
 
 
+        /**
+           \brief Rules whose positive tails are all kept in table relations can be evaluated
+           by a single multi-way join when the leapfrog join is enabled.
+        */
+        bool use_multi_join(rule * r) const {
+            if (!m_context.leapfrog_join() || r->get_positive_tail_size() < 3) {
+                return false;
+            }
+            rel_context_base* rel = m_context.get_rel_context();
+            if (!rel) {
+                return false;
+            }
+            relation_manager& rmgr = rel->get_rmanager();
+            bool has_var = false;
+            for (unsigned i = 0; i < r->get_positive_tail_size(); ++i) {
+                func_decl * pred = r->get_decl(i);
+                if (rmgr.get_requested_predicate_kind(pred) != null_family_id) {
+                    return false;
+                }
+                relation_signature sig;
+                rmgr.from_predicate(pred, sig);
+                relation_plugin * p = rmgr.try_get_appropriate_plugin(sig);
+                if (!p || !p->from_table()) {
+                    return false;
+                }
+                for (expr * arg : *r->get_tail(i)) {
+                    has_var |= is_var(arg);
+                }
+            }
+            return has_var;
+        }
+
     public:
         rule_set * run(rule_set const & source) {
 
             for (rule * r : source) {
-                register_rule(r);
+                if (use_multi_join(r)) 
+                    m_multi_join_rules.push_back(r);
+                else 
+                    register_rule(r);
             }
 
             app_pair selected;
@@ -732,6 +768,9 @@ namespace datalog {
                 rm.mk_rule_rewrite_proof(*orig_r, *new_rule);
                 result->add_rule(new_rule);
             }
+            for (rule * r : m_multi_join_rules) {
+                result->add_rule(r);
+            }
             for (rule* r : m_introduced_rules) {
                 result->add_rule(r);
                 rm.mk_rule_asserted_proof(*r);
@@ -18,8 +18,11 @@ Revision History:
 --*/
 
 #include<utility>
+#include<thread>
+#include<algorithm>
 #include "muz/base/dl_context.h"
 #include "muz/base/dl_util.h"
+#include "muz/rel/dl_relation_manager.h"
 #include "muz/rel/dl_sparse_table.h"
 
 namespace datalog {
@@ -366,6 +369,69 @@ namespace datalog {
         }
     };
 
+    /**
+       Index that keeps the offsets of all rows sorted by their key columns. A lookup is a binary
+       search over the table content, so the index costs one offset per row and no copies of keys.
+    */
+    class sparse_table::sorted_key_indexer : public key_indexer {
+        const sparse_table & m_table;
+        svector<store_offset> m_offsets;
+        svector<store_offset> m_new_offsets;
+        store_offset m_first_nonindexed;
+
+        int compare(store_offset a, store_offset b) const {
+            for (unsigned col : m_key_cols) {
+                table_element va = m_table.get_cell(a, col);
+                table_element vb = m_table.get_cell(b, col);
+                if (va != vb) {
+                    return va < vb ? -1 : 1;
+                }
+            }
+            return 0;
+        }
+
+        int compare(store_offset a, const key_value & key) const {
+            for (unsigned i = 0; i < m_key_cols.size(); ++i) {
+                table_element va = m_table.get_cell(a, m_key_cols[i]);
+                if (va != key[i]) {
+                    return va < key[i] ? -1 : 1;
+                }
+            }
+            return 0;
+        }
+
+    public:
+        sorted_key_indexer(unsigned key_len, const unsigned * key_cols, const sparse_table & t)
+            : key_indexer(key_len, key_cols), m_table(t), m_first_nonindexed(0) {}
+
+        void update(const sparse_table & t) override {
+            store_offset after_last = t.m_data.after_last_offset();
+            if (m_first_nonindexed == after_last) {
+                return;
+            }
+            SASSERT(m_first_nonindexed < after_last);
+            m_new_offsets.reset();
+            for (store_offset ofs = m_first_nonindexed; ofs != after_last; ofs += t.m_fact_size) {
+                m_new_offsets.push_back(ofs);
+            }
+            auto lt = [&](store_offset a, store_offset b) { return compare(a, b) < 0; };
+            std::stable_sort(m_new_offsets.begin(), m_new_offsets.end(), lt);
+            unsigned old_size = m_offsets.size();
+            m_offsets.append(m_new_offsets);
+            std::inplace_merge(m_offsets.begin(), m_offsets.begin() + old_size, m_offsets.end(), lt);
+            m_new_offsets.finalize();
+            m_first_nonindexed = after_last;
+        }
+
+        query_result get_matching_offsets(const key_value & key) const override {
+            auto lo = std::lower_bound(m_offsets.begin(), m_offsets.end(), key,
+                [&](store_offset ofs, const key_value & k) { return compare(ofs, k) < 0; });
+            auto hi = std::upper_bound(lo, m_offsets.end(), key,
+                [&](const key_value & k, store_offset ofs) { return compare(ofs, k) > 0; });
+            return query_result(lo, hi);
+        }
+    };
+
     /**
        When doing lookup using this index, the content of the reserve in sparse_table::m_data changes.
     */
@@ -476,6 +542,9 @@ namespace datalog {
             if (full_signature_key_indexer::can_handle(key_len, key_cols, *this)) {
                 key_map_entry->get_data().m_value = alloc(full_signature_key_indexer, key_len, key_cols, *this);
             }
+            else if (get_plugin().get_manager().get_context().sorted_key_index()) {
+                key_map_entry->get_data().m_value = alloc(sorted_key_indexer, key_len, key_cols, *this);
+            }
             else {
                 key_map_entry->get_data().m_value = alloc(general_key_indexer, key_len, key_cols);
             }
@@ -683,6 +752,17 @@ namespace datalog {
             return;
         }
 
+#ifndef SINGLE_THREAD
+        // below this size, building the per-thread indexes costs more than the join itself.
+        static const unsigned parallel_join_min_rows = 10000;
+        unsigned num_threads = get_num_threads(t1.get_plugin().get_manager().get_context().join_threads());
+        if (num_threads > 1 && t1.row_count() + t2.row_count() >= parallel_join_min_rows) {
+            parallel_join_project(t1, t2, joined_col_cnt, t1_joined_cols, t2_joined_cols, removed_cols,
+                tables_swapped, num_threads, result);
+            return;
+        }
+#endif
+
         key_value t1_key;
         t1_key.resize(joined_col_cnt);
         key_indexer& t2_indexer = t2.get_key_indexer(joined_col_cnt, t2_joined_cols);
@@ -729,6 +809,96 @@ namespace datalog {
         }
     }
 
+    void sparse_table::parallel_join_project(const sparse_table & t1, const sparse_table & t2,
+            unsigned joined_col_cnt, const unsigned * t1_joined_cols, const unsigned * t2_joined_cols,
+            const unsigned * removed_cols, bool tables_swapped, unsigned num_threads, sparse_table & result) {
+#ifndef SINGLE_THREAD
+        verbose_action _va("parallel_join_project", 1);
+        unsigned t1_entry_size = t1.m_fact_size;
+        unsigned t2_entry_size = t2.m_fact_size;
+        unsigned res_entry_size = result.m_fact_size;
+        size_t t1end = t1.m_data.after_last_offset();
+        size_t t2end = t2.m_data.after_last_offset();
+
+        auto key_hash = [&](const sparse_table & t, store_offset ofs, const unsigned * cols) {
+            unsigned h = 0;
+            for (unsigned i = 0; i < joined_col_cnt; ++i) {
+                h = combine_hash(h, hash_ull(t.get_cell(ofs, cols[i])));
+            }
+            return h;
+        };
+
+        auto same_key = [&](store_offset t1ofs, store_offset t2ofs) {
+            for (unsigned i = 0; i < joined_col_cnt; ++i) {
+                if (t1.get_cell(t1ofs, t1_joined_cols[i]) != t2.get_cell(t2ofs, t2_joined_cols[i])) {
+                    return false;
+                }
+            }
+            return true;
+        };
+
+        // the threads only read t1 and t2; each one owns its index and its output buffer.
+        vector<svector<char>> rows(num_threads);
+        auto worker = [&](unsigned p) {
+            u_map<svector<store_offset>> index;
+            for (store_offset t2ofs = 0; t2ofs != t2end; t2ofs += t2_entry_size) {
+                unsigned h = key_hash(t2, t2ofs, t2_joined_cols);
+                if (h % num_threads == p) {
+                    index.insert_if_not_there(h, svector<store_offset>()).push_back(t2ofs);
+                }
+            }
+            svector<char> & out = rows[p];
+            for (store_offset t1ofs = 0; t1ofs != t1end; t1ofs += t1_entry_size) {
+                unsigned h = key_hash(t1, t1ofs, t1_joined_cols);
+                if (h % num_threads != p) {
+                    continue;
+                }
+                auto * e = index.find_core(h);
+                if (!e) {
+                    continue;
+                }
+                char const * t1ptr = t1.get_at_offset(t1ofs);
+                for (store_offset t2ofs : e->get_data().m_value) {
+                    if (!same_key(t1ofs, t2ofs)) {
+                        continue;
+                    }
+                    char const * t2ptr = t2.get_at_offset(t2ofs);
+                    // column_layout reads and writes whole 64-bit words, so keep a word of slack after the row.
+                    unsigned sz = out.size();
+                    out.resize(sz + res_entry_size + sizeof(uint64_t), 0);
+                    if (tables_swapped) {
+                        concatenate_rows(t2.m_column_layout, t1.m_column_layout, result.m_column_layout,
+                            t2ptr, t1ptr, out.data() + sz, removed_cols);
+                    } else {
+                        concatenate_rows(t1.m_column_layout, t2.m_column_layout, result.m_column_layout,
+                            t1ptr, t2ptr, out.data() + sz, removed_cols);
+                    }
+                    out.shrink(sz + res_entry_size);
+                }
+            }
+        };
+
+        vector<std::thread> threads(num_threads);
+        for (unsigned p = 0; p < num_threads; ++p) {
+            threads[p] = std::thread([&, p]() { worker(p); });
+        }
+        for (auto & th : threads) {
+            th.join();
+        }
+
+        for (svector<char> const & out : rows) {
+            for (unsigned ofs = 0; ofs < out.size(); ofs += res_entry_size) {
+                result.m_data.ensure_reserve();
+                result.garbage_collect();
+                memcpy(result.m_data.get_reserve_ptr(), out.data() + ofs, res_entry_size);
+                result.add_reserve_content();
+            }
+        }
+#else
+        UNREACHABLE();
+#endif
+    }
+
 
     // -----------------------------------
     //
@@ -312,6 +312,7 @@ namespace datalog {
         class our_iterator_core;
         class key_indexer;
         class general_key_indexer;
+        class sorted_key_indexer;
         class full_signature_key_indexer;
         typedef entry_storage::store_offset store_offset;
 
@@ -451,6 +452,18 @@ namespace datalog {
             unsigned joined_col_cnt, const unsigned * t1_joined_cols, const unsigned * t2_joined_cols,
             const unsigned * removed_cols, bool tables_swapped, sparse_table & result);
 
+        /**
+           \brief Parallel variant of \c self_agnostic_join_project for joins with a non-empty key.
+
+           The rows of both tables are partitioned by the hash of their key columns. Each of the
+           \c num_threads threads builds a hash index for its partition of \c t2, probes it with its
+           partition of \c t1 and collects the joined rows in a local buffer. The buffers are added
+           to \c result afterwards, so \c result and the plugin are only touched by the calling thread.
+        */
+        static void parallel_join_project(const sparse_table & t1, const sparse_table & t2,
+            unsigned joined_col_cnt, const unsigned * t1_joined_cols, const unsigned * t2_joined_cols,
+            const unsigned * removed_cols, bool tables_swapped, unsigned num_threads, sparse_table & result);
+
 
         /**
            If the fact at \c data (in table's native representation) is not in the table,
@@ -33,6 +33,7 @@ Revision History:
 #include "muz/rel/karr_relation.h"
 #include "muz/rel/dl_finite_product_relation.h"
 #include "muz/rel/udoc_relation.h"
+#include "muz/rel/bdd_relation.h"
 #include "muz/rel/check_relation.h"
 #include "muz/rel/dl_lazy_table.h"
 #include "muz/rel/dl_sparse_table.h"
@@ -98,7 +99,8 @@ namespace datalog {
           m_answer(m), 
           m_last_result_relation(nullptr),
           m_ectx(ctx),
-          m_sw(0) {
+          m_sw(0),
+          m_inc_pinned(m) {
 
         // register plugins for builtin tables
 
@@ -115,10 +117,12 @@ namespace datalog {
         rm.register_plugin(alloc(interval_relation_plugin, rm));
         if (m_context.karr()) rm.register_plugin(alloc(karr_relation_plugin, rm));
         rm.register_plugin(alloc(udoc_plugin, rm));
+        rm.register_plugin(alloc(bdd_plugin, rm));
         rm.register_plugin(alloc(check_relation_plugin, rm));
     }
 
     rel_context::~rel_context() {
+        reset_incremental();
         if (m_last_result_relation) {
             m_last_result_relation->deallocate();
             m_last_result_relation = nullptr;
@@ -130,8 +134,83 @@ namespace datalog {
         return saturate(sq);
     }
 
+    void rel_context::reset_inserted_facts() {
+        for (auto const& kv : m_inc_inserted) {
+            kv.m_value->deallocate();
+        }
+        m_inc_inserted.reset();
+    }
+
+    void rel_context::reset_incremental() {
+        reset_inserted_facts();
+        m_inc_source = nullptr;
+        m_inc_rules = nullptr;
+        m_inc_pinned.reset();
+    }
+
+    /**
+       \brief the relations hold the fixpoint of the last saturation, except for the facts
+       in m_inc_inserted, if the rules and outputs are the same and all updates were insertions.
+    */
+    bool rel_context::can_saturate_incrementally() const {
+        if (!m_context.incremental() || !m_inc_rules) {
+            return false;
+        }
+        rule_set const& rules = m_context.get_rules();
+        if (rules.get_num_rules() != m_inc_source->get_num_rules()) {
+            return false;
+        }
+        for (unsigned i = 0; i < rules.get_num_rules(); ++i) {
+            if (rules.get_rule(i) != m_inc_source->get_rule(i)) {
+                return false;
+            }
+        }
+        func_decl_set const& outputs = rules.get_output_predicates();
+        if (outputs.size() != m_inc_source->get_output_predicates().size()) {
+            return false;
+        }
+        for (func_decl* p : outputs) {
+            if (!m_inc_source->is_output_predicate(p)) {
+                return false;
+            }
+        }
+        for (auto const& kv : m_inc_inserted) {
+            // facts must reach the transformed rules under the same name
+            if (m_inc_rules->get_pred(kv.m_key) != kv.m_key) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    relation_base * rel_context::get_inserted_facts(func_decl * pred, relation_base const & rel) {
+        if (!m_inc_rules) {
+            return nullptr;
+        }
+        if (rel.empty()) {
+            // the rule transformations may have pruned rules that depend on empty relations
+            reset_incremental();
+            return nullptr;
+        }
+        relation_base * r = nullptr;
+        if (!m_inc_inserted.find(pred, r)) {
+            r = rel.get_plugin().mk_empty(rel);
+            m_inc_inserted.insert(pred, r);
+            m_inc_pinned.push_back(pred);
+        }
+        return r;
+    }
+
     lbool rel_context::saturate(scoped_query& sq) {
         m_context.ensure_closed();        
+        bool incremental = can_saturate_incrementally();
+        scoped_ptr<rule_set> source;
+        if (m_context.incremental()) {
+            source = alloc(rule_set, m_context.get_rules());
+        }
+        if (!incremental) {
+            reset_incremental();
+        }
         unsigned remaining_time_limit = m_context.soft_timeout();
         unsigned restart_time = m_context.initial_restart_timeout();
         bool time_limit = remaining_time_limit != 0;
@@ -147,7 +226,14 @@ namespace datalog {
             m_code.reset();
             termination_code.reset();
             m_context.ensure_closed();
-            transform_rules();
+            if (incremental) {
+                m_context.reopen();
+                m_context.replace_rules(*m_inc_rules);
+                m_context.close();
+            }
+            else {
+                transform_rules();
+            }
             if (m_context.canceled()) {
                 TRACE("dl", tout << "canceled\n";);
                 result = l_undef;
@@ -167,7 +253,23 @@ namespace datalog {
             ::stopwatch sw;
             sw.start();
 
-            compiler::compile(m_context, m_context.get_rules(), m_code, termination_code);
+            if (incremental) {
+                // hand the inserted facts to the compiled code as relations of fresh predicates
+                obj_map<func_decl, func_decl*> inserted;
+                for (auto const& kv : m_inc_inserted) {
+                    func_decl* p = kv.m_key;
+                    func_decl* d = m.mk_fresh_func_decl(p->get_name(), symbol("delta"), p->get_arity(),
+                                                        p->get_domain(), m.mk_bool_sort());
+                    m_inc_pinned.push_back(d);
+                    get_rmanager().store_relation(d, kv.m_value);
+                    inserted.insert(p, d);
+                }
+                m_inc_inserted.reset();
+                compiler::compile_incremental(m_context, m_context.get_rules(), inserted, m_code, termination_code);
+            }
+            else {
+                compiler::compile(m_context, m_context.get_rules(), m_code, termination_code);
+            }
 
             bool timeout_after_this_round = time_limit && (restart_time==0 || remaining_time_limit<=restart_time);
 
@@ -199,6 +301,9 @@ namespace datalog {
                 result = l_true;
                 break;
             }
+            // the partial run of incremental code loses the inserted facts,
+            // so the restart recomputes the fixpoint
+            incremental = false;
             if (memory::above_high_watermark()) {
                 m_context.set_status(MEMOUT);
                 result = l_undef;
@@ -225,6 +330,17 @@ namespace datalog {
             sq.reset();
         }
         m_context.record_transformed_rules();
+        reset_incremental();
+        if (result == l_true && source) {
+            bool monotone = true;
+            for (rule* r : m_context.get_rules()) {
+                monotone &= !r->has_negation();
+            }
+            if (monotone) {
+                m_inc_source = source.detach();
+                m_inc_rules = alloc(rule_set, m_context.get_rules());
+            }
+        }
         TRACE("dl", display_profile(tout););
         return result;
     }
@@ -447,7 +563,19 @@ namespace datalog {
     }
 
     void rel_context::restrict_predicates(func_decl_set const& predicates) {
-        get_rmanager().restrict_predicates(predicates);
+        if (!m_inc_rules) {
+            get_rmanager().restrict_predicates(predicates);
+            return;
+        }
+        // keep the relations of auxiliary predicates for the next incremental saturation
+        func_decl_set preds(predicates);
+        for (rule* r : *m_inc_rules) {
+            preds.insert(r->get_decl());
+            for (unsigned i = 0; i < r->get_uninterpreted_tail_size(); ++i) {
+                preds.insert(r->get_decl(i));
+            }
+        }
+        get_rmanager().restrict_predicates(preds);
     }
 
     relation_base & rel_context::get_relation(func_decl * pred)  { return get_rmanager().get_relation(pred); }
@@ -551,7 +679,12 @@ namespace datalog {
  
     void rel_context::add_fact(func_decl* pred, relation_fact const& fact) {
         get_rmanager().reset_saturated_marks();
-        get_relation(pred).add_fact(fact);
+        relation_base & rel = get_relation(pred);
+        relation_base * inserted = get_inserted_facts(pred, rel);
+        if (inserted && !rel.contains_fact(fact)) {
+            inserted->add_fact(fact);
+        }
+        rel.add_fact(fact);
         if (!m_context.print_aig().is_null()) {
             m_table_facts.push_back(std::make_pair(pred, fact));
         }
@@ -562,6 +695,10 @@ namespace datalog {
         relation_base & rel0 = get_relation(pred);
         if (rel0.from_table()) {
             table_relation & rel = static_cast<table_relation &>(rel0);
+            relation_base * inserted = get_inserted_facts(pred, rel);
+            if (inserted && !rel.get_table().contains_fact(fact)) {
+                static_cast<table_relation *>(inserted)->add_table_fact(fact);
+            }
             rel.add_table_fact(fact);
             // TODO: table facts?
         }
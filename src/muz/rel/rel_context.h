@@ -42,8 +42,19 @@ namespace datalog {
         instruction_block  m_code;
         double             m_sw;
 
+        // state for maintaining the last fixpoint under insertions (datalog.incremental)
+        scoped_ptr<rule_set>               m_inc_source;   // rules and outputs of the last saturation
+        scoped_ptr<rule_set>               m_inc_rules;    // the transformed rules it evaluated
+        obj_map<func_decl, relation_base*> m_inc_inserted; // facts added since then
+        func_decl_ref_vector               m_inc_pinned;
+
         class scoped_query;
 
+        void reset_incremental();
+        void reset_inserted_facts();
+        bool can_saturate_incrementally() const;
+        relation_base * get_inserted_facts(func_decl * pred, relation_base const & rel);
+
         void reset_negated_tables();
         
         relation_plugin & get_ordinary_relation_plugin(symbol relation_name);
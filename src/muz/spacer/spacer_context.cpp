@@ -712,7 +712,7 @@ pred_transformer::pred_transformer(context& ctx, manager& pm, func_decl* head):
     m_reach_facts(), m_rf_init_sz(0),
     m_transition_clause(m), m_transition(m), m_init(m),
     m_extend_lit0(m), m_extend_lit(m),
-    m_all_init(false), m_has_quantified_frame(false)
+    m_all_init(false), m_mbp_cache(m), m_has_quantified_frame(false)
 {
     m_solver = alloc(prop_solver, m, ctx.mk_solver0(), ctx.mk_solver1(),
                      ctx.get_params(), head->get_name());
@@ -749,6 +749,7 @@ void pred_transformer::collect_statistics(statistics& st) const
     // -- number of times a lemma has been propagated to a higher level
     // -- during push
     st.update("SPACER num propagations", m_stats.m_num_propagations);
+    st.update("SPACER num subsumed lemmas", m_stats.m_num_subsumed_lemmas);
     // -- number of lemmas in all current frames
     st.update("SPACER num active lemmas", m_frames.lemma_size ());
     // -- number of lemmas that are inductive invariants
@@ -770,6 +771,7 @@ void pred_transformer::collect_statistics(statistics& st) const
                m_must_reachable_watch.get_seconds ());
     st.update("time.spacer.ctp", m_ctp_watch.get_seconds());
     st.update("time.spacer.mbp", m_mbp_watch.get_seconds());
+    m_mbp_cache.collect_statistics(st);
     // -- Max cluster size can decrease during run
     st.update("SPACER max cluster size", m_cluster_db.get_max_cluster_size());
 }
@@ -783,6 +785,7 @@ void pred_transformer::reset_statistics()
     m_must_reachable_watch.reset ();
     m_ctp_watch.reset();
     m_mbp_watch.reset();
+    m_mbp_cache.reset_statistics();
 }
 
 void pred_transformer::init_sig()
@@ -1338,7 +1341,12 @@ bool pred_transformer::is_qblocked (pob &n) {
 void pred_transformer::mbp(app_ref_vector &vars, expr_ref &fml, model &mdl,
                            bool reduce_all_selects, bool force) {
     scoped_watch _t_(m_mbp_watch);
+    if (m_mbp_cache.find(vars, fml, mdl))
+        return;
+    app_ref_vector vars0(vars);
+    expr_ref fml0(fml);
     qe_project(m, vars, fml, mdl, reduce_all_selects, use_native_mbp(), !force);
+    m_mbp_cache.insert(vars0, fml0, fml, vars);
 }
 
 //
@@ -2000,62 +2008,80 @@ bool pred_transformer::frames::add_lemma(lemma *new_lemma)
         return true;
     }
 
-    unsigned i = 0;
-    for (auto *old_lemma : m_lemmas) {
-        if (old_lemma->get_expr() == new_lemma->get_expr()) {
-            m_pt.get_context().new_lemma_eh(m_pt, new_lemma);
+    lemma *old_lemma = nullptr;
+    if (m_expr2lemma.find(new_lemma->get_expr(), old_lemma)) {
+        m_pt.get_context().new_lemma_eh(m_pt, new_lemma);
 
-            // register existing lemma with the pob
-            if (new_lemma->has_pob()) {
-                pob_ref &pob = new_lemma->get_pob();
-                if (!pob->lemmas().contains(old_lemma))
-                    pob->add_lemma(old_lemma);
-            }
+        // register existing lemma with the pob
+        if (new_lemma->has_pob()) {
+            pob_ref &pob = new_lemma->get_pob();
+            if (!pob->lemmas().contains(old_lemma))
+                pob->add_lemma(old_lemma);
+        }
 
-            // extend bindings if needed
+        // extend bindings if needed
+        if (!new_lemma->get_bindings().empty()) {
+            old_lemma->add_binding(new_lemma->get_bindings());
+        }
+        // if the lemma is at a higher level, skip it,
+        if (old_lemma->level() >= new_lemma->level()) {
+            TRACE("spacer", tout << "Already at a higher level: "
+                  << pp_level(old_lemma->level()) << "\n";);
+            // but, since the instances might be new, assert the
+            // instances that have been copied into m_lemmas[i]
             if (!new_lemma->get_bindings().empty()) {
-                old_lemma->add_binding(new_lemma->get_bindings());
+                m_pt.add_lemma_core(old_lemma, true);
             }
-            // if the lemma is at a higher level, skip it,
-            if (old_lemma->level() >= new_lemma->level()) {
-                TRACE("spacer", tout << "Already at a higher level: "
-                      << pp_level(old_lemma->level()) << "\n";);
-                // but, since the instances might be new, assert the
-                // instances that have been copied into m_lemmas[i]
-                if (!new_lemma->get_bindings().empty()) {
-                    m_pt.add_lemma_core(old_lemma, true);
+            if (is_infty_level(old_lemma->level())) {
+                old_lemma->bump();
+                if (old_lemma->get_bumped() >= 100) {
+                    IF_VERBOSE(1, verbose_stream() << "Adding lemma to oo "
+                               << old_lemma->get_bumped() << " "
+                               << mk_pp(old_lemma->get_expr(),
+                                        m_pt.get_ast_manager()) << "\n";);
+                    throw default_exception("Stuck on a lemma");
                 }
-                if (is_infty_level(old_lemma->level())) {
-                    old_lemma->bump();
-                    if (old_lemma->get_bumped() >= 100) {
-                        IF_VERBOSE(1, verbose_stream() << "Adding lemma to oo "
-                                   << old_lemma->get_bumped() << " "
-                                   << mk_pp(old_lemma->get_expr(),
-                                            m_pt.get_ast_manager()) << "\n";);
-                        throw default_exception("Stuck on a lemma");
-                    }
-                }
-                // no new lemma added
-                return false;
             }
+            // no new lemma added
+            return false;
+        }
 
-            // update level of the existing lemma
-            old_lemma->set_level(new_lemma->level());
-            // assert lemma in the solver
-            m_pt.add_lemma_core(old_lemma, false);
-            // move the lemma to its new place to maintain sortedness
+        // update level of the existing lemma
+        old_lemma->set_level(new_lemma->level());
+        // assert lemma in the solver
+        m_pt.add_lemma_core(old_lemma, false);
+        // move the lemma to its new place to maintain sortedness
+        if (m_sorted) {
+            unsigned i = m_lemmas.size();
+            while (i-- > 0 && m_lemmas.get(i) != old_lemma)
+                ;
             unsigned sz = m_lemmas.size();
             for (unsigned j = i;
                  (j + 1) < sz && m_lt(m_lemmas[j + 1], m_lemmas[j]); ++j) {
                 m_lemmas.swap (j, j+1);
             }
-            return true;
         }
-        i++;
+        return true;
+    }
+
+    // a frame lemma with a sub-cube at the same or a higher level
+    // already blocks new_lemma
+    old_lemma = find_subsuming(new_lemma);
+    if (old_lemma) {
+        TRACE("spacer", tout << "Subsumed by: " << pp_level(old_lemma->level()) << " "
+              << mk_pp(old_lemma->get_expr(), m_pt.get_ast_manager()) << "\n";);
+        ++m_pt.m_stats.m_num_subsumed_lemmas;
+        if (new_lemma->has_pob()) {
+            pob_ref &pob = new_lemma->get_pob();
+            if (!pob->lemmas().contains(old_lemma))
+                pob->add_lemma(old_lemma);
+        }
+        return false;
     }
 
     // new_lemma is really new
     m_lemmas.push_back(new_lemma);
+    index_lemma(new_lemma);
     // XXX because m_lemmas is reduced, keep secondary vector of all lemmas
     // XXX so that pob can refer to its lemmas without creating reference cycles
     m_pinned_lemmas.push_back(new_lemma);
@@ -2071,6 +2097,54 @@ bool pred_transformer::frames::add_lemma(lemma *new_lemma)
 }
 
 
+void pred_transformer::frames::index_lemma(lemma *l)
+{
+    m_expr2lemma.insert(l->get_expr(), l);
+    if (l->is_ground() && l->get_bindings().empty() && !l->get_cube().empty())
+        m_first_lit2lemmas.insert_if_not_there(l->get_cube().get(0), ptr_vector<lemma>()).push_back(l);
+}
+
+void pred_transformer::frames::reindex()
+{
+    m_expr2lemma.reset();
+    m_first_lit2lemmas.reset();
+    for (lemma *l : m_lemmas)
+        index_lemma(l);
+}
+
+/**
+   \brief find an active ground lemma whose cube is contained in the cube of
+   l and whose level is at least the level of l. Candidates are indexed
+   by the first literal of their cube, so only lemmas whose first literal
+   occurs in the cube of l are inspected.
+*/
+lemma *pred_transformer::frames::find_subsuming(lemma *l)
+{
+    if (m_first_lit2lemmas.empty() || !l->is_ground() || !l->get_bindings().empty())
+        return nullptr;
+    expr_ref_vector const &cube = l->get_cube();
+    if (cube.empty())
+        return nullptr;
+    obj_hashtable<expr> lits;
+    for (expr *e : cube)
+        lits.insert(e);
+    for (expr *e : cube) {
+        auto *cands = m_first_lit2lemmas.find_core(e);
+        if (!cands)
+            continue;
+        for (lemma *c : cands->get_data().m_value) {
+            if (c->level() < l->level())
+                continue;
+            expr_ref_vector const &ccube = c->get_cube();
+            if (ccube.size() > cube.size())
+                continue;
+            if (all_of(ccube, [&](expr *f) { return lits.contains(f); }))
+                return c;
+        }
+    }
+    return nullptr;
+}
+
 void pred_transformer::frames::propagate_to_infinity (unsigned level)
 {
     for (unsigned i = 0, sz = m_lemmas.size (); i < sz; ++i)
@@ -2184,16 +2258,11 @@ void pred_transformer::frames::simplify_formulas ()
             num_sumbsumed += (sz - r->size());
             // For every expression in the result, copy corresponding
             // lemma into new_lemmas
-            // XXX linear search. optimize if needed.
             for (unsigned k = 0; k < r->size(); ++k) {
-                bool found = false;
-                for (unsigned n = begin; n < end; ++n) {
-                    if (m_lemmas[n]->get_expr() == r->form(k)) {
-                        new_lemmas.push_back(m_lemmas[n]);
-                        found = true;
-                        break;
-                    }
-                }
+                lemma *l = nullptr;
+                bool found = m_expr2lemma.find(r->form(k), l) && l->level() == level;
+                if (found)
+                    new_lemmas.push_back(l);
                 if (!found) {
                     verbose_stream() << "Failed to find a lemma for: "
                                      << mk_pp(r->form(k), m) << "\n";
@@ -2222,6 +2291,7 @@ void pred_transformer::frames::simplify_formulas ()
         m_lemmas.append(new_lemmas);
         m_sorted = false;
         sort();
+        reindex();
     }
 }
 
@@ -222,6 +222,7 @@ class pred_transformer {
         unsigned m_num_lemma_level_jump; // lemma learned at higher level than
                                          // expected
         unsigned m_num_reach_queries;
+        unsigned m_num_subsumed_lemmas;  // new lemmas subsumed by a frame lemma
         // clang-format on
         // clang-format off
 
@@ -242,10 +243,15 @@ class pred_transformer {
 
         bool m_sorted;                     // true if m_lemmas is sorted by m_lt
         lemma_lt_proc m_lt;                // sort order for m_lemmas
+        obj_map<expr, lemma *> m_expr2lemma;             // active lemma of a lemma expression
+        obj_map<expr, ptr_vector<lemma>> m_first_lit2lemmas; // active ground lemmas by first cube literal
         // clang-format on
         // clang-format off
 
         void sort();
+        void index_lemma(lemma *l);
+        void reindex();
+        lemma *find_subsuming(lemma *l);
 
       public:
         frames(pred_transformer &pt) : m_pt(pt), m_size(0), m_sorted(true) {}
@@ -507,6 +513,7 @@ class pred_transformer {
     stopwatch                    m_must_reachable_watch;
     stopwatch                    m_ctp_watch;
     stopwatch                    m_mbp_watch;
+    mbp_cache                    m_mbp_cache;
     bool                         m_has_quantified_frame; // True when a quantified lemma is in the frame
     cluster_db                   m_cluster_db;
     // clang-format on
@@ -35,6 +35,7 @@ Revision History:
 #include "ast/scoped_proof.h"
 #include "muz/transforms/dl_transforms.h"
 #include "muz/spacer/spacer_callback.h"
+#include "muz/spacer/spacer_parallel.h"
 
 using namespace spacer;
 
@@ -81,6 +82,16 @@ void dl_interface::check_reset()
 }
 
 
+lbool dl_interface::solve(func_decl* query_pred, unsigned lvl)
+{
+    unsigned num_workers = m_ctx.get_params().spacer_workers();
+    if (num_workers == 0)
+        return m_context->solve(lvl);
+    parallel_workers workers(*m_context, m_ctx, m_spacer_rules, query_pred, num_workers);
+    workers.start(lvl);
+    return m_context->solve(lvl);
+}
+
 lbool dl_interface::query(expr * query)
 {
     //we restore the initial state in the datalog context
@@ -164,7 +175,7 @@ lbool dl_interface::query(expr * query)
         return l_false;
     }
 
-    return m_context->solve(m_ctx.get_params().spacer_min_level());
+    return solve(query_pred, m_ctx.get_params().spacer_min_level());
 
 }
 
@@ -257,7 +268,7 @@ lbool dl_interface::query_from_lvl(expr * query, unsigned lvl)
         return l_false;
     }
 
-    return m_context->solve(lvl);
+    return solve(query_pred, lvl);
 
 }
 
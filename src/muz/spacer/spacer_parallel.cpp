@@ -0,0 +1,172 @@
+/*++
+Copyright (c) 2024 Microsoft Corporation
+
+Module Name:
+
+    spacer_parallel.cpp
+
+Abstract:
+
+    Spacer workers that run next to the main spacer context.
+
+--*/
+
+#include <thread>
+#include "ast/ast_translation.h"
+#include "smt/params/smt_params.h"
+#include "muz/base/dl_context.h"
+#include "muz/spacer/spacer_parallel.h"
+
+namespace spacer {
+
+    namespace {
+        class no_engines : public datalog::register_engine_base {
+        public:
+            datalog::engine_base* mk_engine(datalog::DL_ENGINE engine_type) override { return nullptr; }
+            void set_context(datalog::context* ctx) override {}
+        };
+    }
+
+    class parallel_workers::exchange_callback : public spacer_callback {
+        parallel_workers& m_owner;
+        unsigned          m_id;
+        unsigned          m_head = 0;
+    public:
+        exchange_callback(context& ctx, parallel_workers& owner, unsigned id):
+            spacer_callback(ctx), m_owner(owner), m_id(id) {}
+
+        bool new_lemma() override { return m_id > 0; }
+
+        void new_lemma_eh(expr* lemma, unsigned level) override {
+            m_owner.publish(m_id, m_context.get_ast_manager(), lemma, level);
+        }
+
+        bool unfold() override { return true; }
+
+        void unfold_eh() override {
+            m_owner.import(m_id, m_head, m_context);
+        }
+    };
+
+    struct parallel_workers::worker {
+        scoped_ptr<ast_manager>       m_manager;
+        no_engines                    m_engines;
+        smt_params                    m_fparams;
+        scoped_ptr<datalog::context>  m_dctx;
+        scoped_ptr<datalog::rule_set> m_rules;
+        scoped_ptr<context>           m_context;
+        func_decl_ref                 m_query;
+        std::thread                   m_thread;
+
+        worker(ast_manager& m, smt_params const& fp):
+            m_manager(alloc(ast_manager, m, true)),
+            m_fparams(fp),
+            m_query(*m_manager) {}
+
+        ~worker() {
+            // the spacer context refers to the rules and parameters of the datalog context.
+            m_context = nullptr;
+            m_rules = nullptr;
+            m_dctx = nullptr;
+        }
+    };
+
+    parallel_workers::parallel_workers(context& main, datalog::context& dctx, datalog::rule_set const& rules, func_decl* query, unsigned num_workers):
+        m_main(main),
+        m_shared(alloc(ast_manager, main.get_ast_manager(), true)),
+        m_pinned(*m_shared) {
+        ast_manager& m = main.get_ast_manager();
+        for (unsigned i = 1; i <= num_workers; ++i) {
+            worker* w = alloc(worker, m, dctx.get_fparams());
+            m_workers.push_back(w);
+            ast_manager& wm = *w->m_manager;
+            ast_translation tr(m, wm);
+            params_ref p = dctx.get_params_ref();
+            p.set_uint("spacer.random_seed", dctx.get_params().spacer_random_seed() + i);
+            p.set_bool("spacer.p3.share_lemmas", true);
+            p.set_bool("spacer.p3.share_invariants", true);
+            p.set_uint("spacer.workers", 0);
+            w->m_dctx = alloc(datalog::context, wm, w->m_engines, w->m_fparams, p);
+            w->m_rules = alloc(datalog::rule_set, *w->m_dctx);
+            datalog::rule_manager& rm = w->m_dctx->get_rule_manager();
+            ptr_vector<app> tail;
+            bool_vector is_neg;
+            for (datalog::rule* r : rules) {
+                tail.reset();
+                is_neg.reset();
+                for (unsigned j = 0; j < r->get_tail_size(); ++j) {
+                    tail.push_back(tr(r->get_tail(j)));
+                    is_neg.push_back(r->is_neg_tail(j));
+                }
+                w->m_rules->add_rule(rm.mk(tr(r->get_head()), tail.size(), tail.data(), is_neg.data(), r->name(), false));
+            }
+            w->m_query = tr(query);
+            w->m_rules->set_output_predicate(w->m_query);
+            w->m_rules->close();
+            w->m_context = alloc(context, w->m_dctx->get_params(), wm);
+            w->m_context->callbacks().push_back(alloc(exchange_callback, *w->m_context, *this, i));
+        }
+        m_main_callback = alloc(exchange_callback, main, *this, 0);
+        main.callbacks().push_back(m_main_callback);
+    }
+
+    parallel_workers::~parallel_workers() {
+        for (worker* w : m_workers)
+            w->m_manager->limit().cancel();
+        for (worker* w : m_workers)
+            if (w->m_thread.joinable())
+                w->m_thread.join();
+        auto& cbs = m_main.callbacks();
+        for (unsigned i = 0; i < cbs.size(); ++i) {
+            if (cbs[i] == m_main_callback) {
+                cbs.swap(i, cbs.size() - 1);
+                cbs.pop_back();
+                break;
+            }
+        }
+        m_workers.reset();
+    }
+
+    void parallel_workers::start(unsigned from_lvl) {
+        for (worker* w : m_workers) {
+            w->m_thread = std::thread([w, from_lvl]() {
+                try {
+                    w->m_context->set_query(w->m_query);
+                    w->m_context->update_rules(*w->m_rules);
+                    w->m_context->solve(from_lvl);
+                }
+                catch (z3_exception& ex) {
+                    IF_VERBOSE(2, verbose_stream() << "(spacer.worker :exception \"" << ex.msg() << "\")\n");
+                }
+            });
+        }
+    }
+
+    void parallel_workers::publish(unsigned source, ast_manager& src, expr* lemma, unsigned level) {
+        std::lock_guard<std::mutex> lock(m_mux);
+        ast_translation tr(src, *m_shared);
+        expr* e = tr(lemma);
+        m_pinned.push_back(e);
+        m_lemmas.push_back({ e, level, source });
+    }
+
+    void parallel_workers::import(unsigned target, unsigned& head, context& ctx) {
+        ast_manager& m = ctx.get_ast_manager();
+        expr_ref_vector lemmas(m);
+        unsigned_vector levels;
+        {
+            std::lock_guard<std::mutex> lock(m_mux);
+            ast_translation tr(*m_shared, m);
+            for (; head < m_lemmas.size(); ++head) {
+                auto const& [e, level, source] = m_lemmas[head];
+                if (source == target)
+                    continue;
+                lemmas.push_back(tr(e));
+                levels.push_back(level);
+            }
+        }
+        for (unsigned i = 0; i < lemmas.size(); ++i)
+            ctx.add_constraint(lemmas.get(i), levels[i]);
+        IF_VERBOSE(2, if (!lemmas.empty()) verbose_stream() << "(spacer.worker " << target << " :imported " << lemmas.size() << ")\n");
+    }
+}
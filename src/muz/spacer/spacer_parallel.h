@@ -0,0 +1,60 @@
+/*++
+Copyright (c) 2024 Microsoft Corporation
+
+Module Name:
+
+    spacer_parallel.h
+
+Abstract:
+
+    Spacer workers that run next to the main spacer context.
+
+    Every worker owns a manager, a copy of the transformed rules and a
+    spacer context that is configured with a different random seed. The
+    workers publish their frame lemmas and invariants to a shared pool
+    (through the p3 lemma sharing callbacks); the main context and the
+    workers import the lemmas of the others whenever they unfold a new
+    level. Answers, models and proofs are produced by the main context
+    only.
+
+--*/
+#pragma once
+
+#include <mutex>
+#include "util/scoped_ptr_vector.h"
+#include "muz/base/dl_rule_set.h"
+#include "muz/spacer/spacer_context.h"
+
+namespace spacer {
+
+    class parallel_workers {
+        struct lemma_info {
+            expr*    m_lemma;
+            unsigned m_level;
+            unsigned m_source;
+        };
+        struct worker;
+        class exchange_callback;
+
+        context&                m_main;
+        std::mutex              m_mux;
+        scoped_ptr<ast_manager> m_shared;
+        expr_ref_vector         m_pinned;
+        svector<lemma_info>     m_lemmas;
+        scoped_ptr_vector<worker> m_workers;
+        exchange_callback*      m_main_callback = nullptr;
+
+        void publish(unsigned source, ast_manager& src, expr* lemma, unsigned level);
+        void import(unsigned target, unsigned& head, context& ctx);
+
+    public:
+        parallel_workers(context& main, datalog::context& dctx, datalog::rule_set const& rules, func_decl* query, unsigned num_workers);
+        ~parallel_workers();
+
+        /**
+           \brief start the workers. They stop when this object is destroyed.
+        */
+        void start(unsigned from_lvl);
+    };
+
+}
@@ -311,6 +311,88 @@ void qe_project(ast_manager &m, app_ref_vector &vars, expr_ref &fml, model &mdl,
                           dont_sub);
 }
 
+mbp_cache::formula_info &mbp_cache::get_info(expr *fml) {
+    formula_info *info = nullptr;
+    if (m_formulas.find(fml, info)) return *info;
+    if (m_infos.size() >= max_formulas) reset();
+    info = alloc(formula_info, m);
+    m_infos.push_back(info);
+    m_pinned.push_back(fml);
+    m_formulas.insert(fml, info);
+    if (has_quantifiers(fml)) {
+        info->m_cacheable = false;
+        return *info;
+    }
+    for (expr *t : subterms::all(expr_ref(fml, m))) {
+        if (!is_app(t) || !is_uninterp(t)) continue;
+        if (to_app(t)->get_num_args() > 0) {
+            info->m_cacheable = false;
+            break;
+        }
+        info->m_consts.push_back(to_app(t));
+    }
+    return *info;
+}
+
+bool mbp_cache::find(app_ref_vector &vars, expr_ref &fml, model &mdl) {
+    m_values.reset();
+    formula_info &info = get_info(fml);
+    if (!info.m_cacheable) return false;
+    {
+        model::scoped_model_completion _sc_(mdl, false);
+        for (app *c : info.m_consts) m_values.push_back(mdl(c));
+    }
+    for (entry *e : info.m_entries) {
+        if (e->m_vars != vars || e->m_values != m_values) continue;
+        ++m_hits;
+        fml = e->m_result;
+        vars.reset();
+        vars.append(e->m_remaining);
+        return true;
+    }
+    ++m_misses;
+    return false;
+}
+
+void mbp_cache::insert(app_ref_vector const &vars, expr *fml, expr *result,
+                       app_ref_vector const &remaining) {
+    formula_info *info = nullptr;
+    if (!m_formulas.find(fml, info) || !info->m_cacheable ||
+        m_values.size() != info->m_consts.size())
+        return;
+    // the projection may introduce constants for array indices and values
+    obj_hashtable<app> known;
+    for (app *c : info->m_consts) known.insert(c);
+    for (app *v : remaining)
+        if (!known.contains(v)) return;
+    for (expr *t : subterms::all(expr_ref(result, m)))
+        if (is_uninterp_const(t) && !known.contains(to_app(t))) return;
+
+    entry *e = alloc(entry, m);
+    e->m_vars.append(vars);
+    e->m_values.append(m_values);
+    e->m_result = result;
+    e->m_remaining.append(remaining);
+    if (info->m_entries.size() < max_entries)
+        info->m_entries.push_back(e);
+    else {
+        info->m_entries.set(info->m_next, e);
+        info->m_next = (info->m_next + 1) % max_entries;
+    }
+}
+
+void mbp_cache::reset() {
+    m_formulas.reset();
+    m_infos.reset();
+    m_pinned.reset();
+    m_values.reset();
+}
+
+void mbp_cache::collect_statistics(statistics &st) const {
+    st.update("SPACER mbp cache hits", m_hits);
+    st.update("SPACER mbp cache misses", m_misses);
+}
+
 void expand_literals(ast_manager &m, expr_ref_vector &conjs) {
     if (conjs.empty()) return;
     arith_util arith(m);
@@ -36,6 +36,8 @@ Revision History:
 
 #include "muz/spacer/spacer_antiunify.h"
 #include "util/stopwatch.h"
+#include "util/scoped_ptr_vector.h"
+#include "util/statistics.h"
 
 class model;
 class model_core;
@@ -99,6 +101,67 @@ void qe_project(ast_manager &m, app_ref_vector &vars, expr_ref &fml, model &mdl,
 void qe_project(ast_manager &m, app_ref_vector &vars, expr_ref &fml,
                 model_ref &M, expr_map &map);
 
+/**
+ * Cache of model-based projections.
+ *
+ * The projection of a formula only depends on the variables to eliminate
+ * and on the values that the model assigns to the constants of the
+ * formula. Results are reused for models that agree on these values.
+ * Formulas with uninterpreted functions, and projections that introduce
+ * new constants, are not cached.
+ */
+class mbp_cache {
+    struct entry {
+        app_ref_vector  m_vars;
+        expr_ref_vector m_values;
+        expr_ref        m_result;
+        app_ref_vector  m_remaining;
+        entry(ast_manager &m)
+            : m_vars(m), m_values(m), m_result(m), m_remaining(m) {}
+    };
+    struct formula_info {
+        app_ref_vector           m_consts;
+        bool                     m_cacheable = true;
+        scoped_ptr_vector<entry> m_entries;
+        unsigned                 m_next = 0;
+        formula_info(ast_manager &m) : m_consts(m) {}
+    };
+
+    ast_manager &m;
+    expr_ref_vector m_pinned;
+    obj_map<expr, formula_info *> m_formulas;
+    scoped_ptr_vector<formula_info> m_infos;
+    expr_ref_vector m_values; // values of the last lookup
+    unsigned m_hits = 0;
+    unsigned m_misses = 0;
+
+    static const unsigned max_formulas = 1000;
+    static const unsigned max_entries = 8;
+
+    formula_info &get_info(expr *fml);
+
+  public:
+    mbp_cache(ast_manager &m) : m(m), m_pinned(m), m_values(m) {}
+
+    /**
+       \brief retrieve the projection of fml onto vars under mdl. On a hit,
+       fml is replaced by the projection and vars by the variables that
+       could not be eliminated.
+    */
+    bool find(app_ref_vector &vars, expr_ref &fml, model &mdl);
+
+    /**
+       \brief record the projection of the formula and variables passed to
+       the last call of find, which must have missed.
+    */
+    void insert(app_ref_vector const &vars, expr *fml,
+                expr *result, app_ref_vector const &remaining);
+
+    void reset();
+    void collect_statistics(statistics &st) const;
+    void reset_statistics() { m_hits = m_misses = 0; }
+};
+
 // TBD: sort out
 void expand_literals(ast_manager &m, expr_ref_vector &conjs);
 expr_ref_vector compute_implicant_literals(model &mdl,
@@ -150,6 +150,21 @@ namespace datalog {
             TRACE("dl", tout << "No transformation\n";);
             res = nullptr;
         }
+        else if (source.is_closed()) {
+            // the kept rules only use reachable predicates, except for predicates under quantifiers,
+            // so the dependencies of the source restricted to them are the dependencies of the result.
+            bool has_quantifier = false;
+            for (rule* r : *res) 
+                has_quantifier |= m_context.get_rule_manager().has_quantifiers(*r);
+            if (!has_quantifier) {
+                func_decl_set reachable;
+                for (auto const& kv : engine) 
+                    if (kv.m_value.is_reachable()) 
+                        reachable.insert(kv.m_key);
+                // a subset of the stratified rules remains stratified
+                VERIFY(res->close(source, reachable));
+            }
+        }
         if (res && m_context.get_model_converter() && !pruned_preds.empty()) {
             auto* mc0 = alloc(generic_model_converter, m, "dl_coi");
             horn_subsume_model_converter hmc(m);
@@ -219,23 +219,29 @@ namespace nlsat {
         }
         
         /**
-           \brief Wrapper for factorization
+           \brief Wrapper for factorization. Factorizations are memoized in m_cache.
         */
         void factor(polynomial_ref & p, polynomial_ref_vector & fs) {
-            // TODO: add params, caching
             TRACE("nlsat_factor", tout << "factor\n" << p << "\n";);
             fs.reset();
             m_cache.factor(p.get(), fs);
         }
 
         /**
-           \brief Wrapper for psc chain computation
+           \brief Wrapper for psc chain computation. Chains are memoized in m_cache.
+           The chains of (p, q) and (q, p) agree up to the signs of their elements,
+           which does not matter for projection, so the pair is put in a canonical
+           order to share the cache entry between both orders.
         */
         void psc_chain(polynomial_ref & p, polynomial_ref & q, unsigned x, polynomial_ref_vector & result) {
-            // TODO caching
             SASSERT(max_var(p) == max_var(q));
             SASSERT(max_var(p) == x);
-            m_cache.psc_chain(p, q, x, result);
+            poly * p1 = m_cache.mk_unique(p);
+            poly * q1 = m_cache.mk_unique(q);
+            unsigned dp = m_pm.degree(p1, x), dq = m_pm.degree(q1, x);
+            if (dp < dq || (dp == dq && m_pm.id(p1) > m_pm.id(q1)))
+                std::swap(p1, q1);
+            m_cache.psc_chain(p1, q1, x, result);
         }
         
         /**
@@ -74,7 +74,14 @@ Notes:
 #include "opt/maxsmt.h"
 #include "opt/maxcore.h"
 #include "opt/totalizer.h"
+#include "opt/pb_sls.h"
+#include "ast/ast_translation.h"
 #include <iostream>
+#ifndef SINGLE_THREAD
+#include <atomic>
+#include <mutex>
+#include <thread>
+#endif
 
 using namespace opt;
 
@@ -91,6 +98,9 @@ private:
     struct stats {
         unsigned m_num_cores;
         unsigned m_num_cs;
+        unsigned m_num_parallel_cores;
+        unsigned m_num_merged_totalizers;
+        unsigned m_num_local_search_models;
         stats() { reset(); }
         void reset() {
             memset(this, 0, sizeof(*this));
@@ -135,9 +145,192 @@ private:
     unsigned         m_lns_conflicts = 1000;           // number of conflicts used for LNS improvement
     bool             m_enable_core_rotate = false;     // enable core rotation
     bool             m_use_totalizer = true;           // use totalizer instead of cardinality encoding
+    unsigned         m_threads = 1;                    // number of threads extracting cores
+    unsigned         m_local_search_threads = 0;       // number of threads improving the upper bound
     std::string      m_trace_id;
     typedef ptr_vector<expr> exprs;
 
+    /**
+       A clone of the solver in its own manager that searches for a core under
+       a different assumption order and weight stratum while the main thread
+       extracts cores with the hill-climbing order.
+    */
+    struct core_worker {
+        ast_manager           m;
+        ref<solver>           m_solver;
+        unsigned              m_num_assertions = 0; // assertions of the main solver copied so far
+        expr_ref_vector       m_asms;
+        expr_ref_vector       m_core;
+        obj_map<expr, expr*>  m_asm2main;           // assumption in m to assumption in the main manager
+        lbool                 m_result = l_undef;
+
+        core_worker(): m_asms(m), m_core(m) {}
+
+        void run(bool minimize) {
+            try {
+                m_core.reset();
+                m_result = m_solver->check_sat(m_asms);
+                if (m_result != l_false)
+                    return;
+                m_solver->get_unsat_core(m_core);
+                if (!minimize || m_core.empty())
+                    return;
+                mus mus(*m_solver);
+                expr_ref_vector mcore(m);
+                mus.add_soft(m_core.size(), m_core.data());
+                if (mus.get_mus(mcore) == l_true) {
+                    m_core.reset();
+                    m_core.append(mcore);
+                }
+            }
+            catch (z3_exception&) {
+                m_result = l_undef;
+            }
+        }
+    };
+    scoped_ptr_vector<core_worker> m_workers;
+
+#ifndef SINGLE_THREAD
+    /**
+       The best assignment found by the main thread or a local search worker, kept in
+       a manager of its own. The version is read without taking the lock, so threads
+       only synchronize after one of them found an improvement.
+    */
+    struct incumbent {
+        ast_manager           m;
+        std::atomic<unsigned> m_version { 0 };
+        std::mutex            m_mux;
+        model_ref             m_model;
+        rational              m_cost;
+
+        // called with m_mux held
+        bool publish(ast_manager& src, model_ref const& mdl, rational const& cost) {
+            if (m_model && m_cost <= cost)
+                return false;
+            ast_translation tr(src, m);
+            m_model = mdl->translate(tr);
+            m_cost = cost;
+            ++m_version;
+            return true;
+        }
+    };
+
+    /**
+       A clone of the solver that improves on the incumbent. Each round walks from the
+       incumbent with pb_sls, then fixes a random subset of the soft constraints that the
+       walk satisfies and lets the clone repair the rest under a conflict budget. The
+       clone validates every candidate, so only models of the hard constraints are shared.
+       The neighborhood widens when the clone exhausts it within the budget without an
+       improvement and narrows when the budget runs out.
+    */
+    struct local_search_worker {
+        ast_manager       m;
+        incumbent&        m_inc;
+        ref<solver>       m_solver;
+        expr_ref_vector   m_soft;
+        vector<rational>  m_weights;
+        unsigned          m_seed;
+        unsigned          m_conflicts;
+        unsigned          m_version = 0;
+        unsigned          m_num_models = 0;
+
+        local_search_worker(incumbent& inc, unsigned seed, unsigned conflicts):
+            m_inc(inc), m_soft(m), m_seed(seed), m_conflicts(conflicts) {}
+
+        rational cost(model& mdl) {
+            rational c(0);
+            for (unsigned i = 0; i < m_soft.size(); ++i)
+                if (!mdl.is_true(m_soft.get(i)))
+                    c += m_weights[i];
+            return c;
+        }
+
+        bool fetch(model_ref& mdl, rational& cost) {
+            if (m_inc.m_version == m_version)
+                return false;
+            std::lock_guard<std::mutex> lock(m_inc.m_mux);
+            m_version = m_inc.m_version;
+            if (!m_inc.m_model)
+                return false;
+            ast_translation tr(m_inc.m, m);
+            mdl = m_inc.m_model->translate(tr);
+            cost = m_inc.m_cost;
+            return true;
+        }
+
+        void publish(model_ref const& mdl, rational const& cost) {
+            std::lock_guard<std::mutex> lock(m_inc.m_mux);
+            if (m_inc.publish(m, mdl, cost)) {
+                m_version = m_inc.m_version;
+                ++m_num_models;
+            }
+        }
+
+        void run() {
+            try {
+                random_gen rand(m_seed);
+                params_ref p;
+                p.set_uint("max_conflicts", m_conflicts);
+                m_solver->updt_params(p);
+                smt::pb_sls sls(m);
+                for (expr* f : m_solver->get_assertions())
+                    sls.add(f);
+                for (unsigned i = 0; i < m_soft.size(); ++i)
+                    sls.add(m_soft.get(i), m_weights[i]);
+                model_ref best, mdl;
+                rational best_cost, c;
+                unsigned fraction = 500;   // per mille of the satisfied soft constraints that are fixed
+                expr_ref_vector asms(m);
+                while (m.inc()) {
+                    if (fetch(mdl, c) && (!best || c < best_cost)) {
+                        best = mdl;
+                        best_cost = c;
+                    }
+                    asms.reset();
+                    if (best) {
+                        mdl = best;
+                        sls.set_model(mdl);
+                        if (sls() == l_undef)
+                            break;
+                        sls.get_model(mdl);
+                        for (expr* s : m_soft)
+                            if (mdl->is_true(s) && rand(1000) < fraction)
+                                asms.push_back(s);
+                    }
+                    lbool r = m_solver->check_sat(asms);
+                    if (!m.inc())
+                        break;
+                    if (r == l_true) {
+                        m_solver->get_model(mdl);
+                        mdl->set_model_completion(true);
+                        c = cost(*mdl);
+                        if (!best || c < best_cost) {
+                            best = mdl;
+                            best_cost = c;
+                            publish(best, best_cost);
+                            continue;
+                        }
+                    }
+                    if (!best && r == l_false)
+                        break;
+                    if (r == l_undef)
+                        fraction = std::min(950u, fraction + 50);
+                    else
+                        fraction = std::max(100u, fraction - 50);
+                }
+            }
+            catch (z3_exception&) {
+                // the worker gives up, the main thread continues on its own.
+            }
+        }
+    };
+
+    scoped_ptr<incumbent>                  m_incumbent;
+    scoped_ptr_vector<local_search_worker> m_ls_workers;
+    std::vector<std::thread>               m_ls_threads;
+    unsigned                               m_ls_version = 0;
+#endif
+
 public:
     maxcore(maxsat_context& c, unsigned index,
            vector<soft>& soft,
@@ -174,6 +367,7 @@ public:
     }
 
     ~maxcore() override {
+        stop_local_search();
         for (auto& [k,t] : m_totalizers)
             dealloc(t);        
     }
@@ -234,7 +428,11 @@ public:
         trace();
         improve_model();
         if (is_sat != l_true) return is_sat;
+        start_local_search();
         while (m_lower < m_upper) {
+            import_incumbent();
+            if (m_lower >= m_upper)
+                break;
             TRACE("opt_verbose",
                   s().display(tout << m_asms << "\n") << "\n";
                   display(tout););
@@ -277,7 +475,11 @@ public:
         trace();
         exprs cs;
         if (is_sat != l_true) return is_sat;
+        start_local_search();
         while (m_lower < m_upper) {
+            import_incumbent();
+            if (m_lower >= m_upper)
+                break;
             is_sat = check_sat_hill_climb(m_asms);
             if (!m.inc()) {
                 return l_undef;
@@ -369,21 +571,124 @@ public:
 
     lbool operator()() override {
         m_defs.reset();
+        lbool is_sat = l_undef;
         switch(m_st) {
         case s_primal:
         case s_primal_binary:
         case s_rc2:
         case s_primal_binary_rc2:
-            return mus_solver();
+            is_sat = mus_solver();
+            break;
         case s_primal_dual:
-            return primal_dual_solver();
+            is_sat = primal_dual_solver();
+            break;
         }
-        return l_undef;
+        stop_local_search();
+        return is_sat;
+    }
+
+    /**
+       \brief start the local search workers on clones of the solver. The clones
+       receive the assumption literals of the soft constraints, whose definitions
+       are already asserted, and the current model as the first incumbent.
+       It is called right after init_local, before any core relaxes m_asms.
+    */
+    void start_local_search() {
+#ifndef SINGLE_THREAD
+        stop_local_search();
+        if (m_local_search_threads == 0 || m_asms.empty())
+            return;
+        m_incumbent = alloc(incumbent);
+        m_ls_version = 0;
+        try {
+            for (unsigned i = 0; i < m_local_search_threads; ++i) {
+                local_search_worker* w = alloc(local_search_worker, *m_incumbent, i + 1, m_lns_conflicts);
+                m_ls_workers.push_back(w);
+                params_ref p(m_params);
+                p.set_uint("random_seed", i + 1);
+                w->m_solver = s().translate(w->m, p);
+                ast_translation tr(m, w->m);
+                for (expr* a : m_asms) {
+                    w->m_soft.push_back(tr(a));
+                    w->m_weights.push_back(get_weight(a));
+                }
+            }
+        }
+        catch (z3_exception& ex) {
+            IF_VERBOSE(1, verbose_stream() << "(opt.maxres cannot clone solver: " << ex.msg() << ")\n";);
+            m_ls_workers.reset();
+            m_incumbent = nullptr;
+            return;
+        }
+        if (m_model)
+            publish_incumbent(m_model);
+        for (local_search_worker* w : m_ls_workers)
+            m_ls_threads.push_back(std::thread([w]() { w->run(); }));
+#endif
+    }
+
+    void stop_local_search() {
+#ifndef SINGLE_THREAD
+        for (local_search_worker* w : m_ls_workers)
+            w->m.limit().cancel();
+        for (auto& t : m_ls_threads)
+            t.join();
+        for (local_search_worker* w : m_ls_workers)
+            m_stats.m_num_local_search_models += w->m_num_models;
+        m_ls_threads.clear();
+        m_ls_workers.reset();
+        m_incumbent = nullptr;
+#endif
+    }
+
+    /**
+       \brief adopt the incumbent if a worker improved it since the last round.
+       The version check is lock free, so rounds without news cost a single load.
+    */
+    void import_incumbent() {
+#ifndef SINGLE_THREAD
+        if (!m_incumbent || m_incumbent->m_version == m_ls_version)
+            return;
+        model_ref mdl;
+        {
+            std::lock_guard<std::mutex> lock(m_incumbent->m_mux);
+            m_ls_version = m_incumbent->m_version;
+            if (m_incumbent->m_model) {
+                ast_translation tr(m_incumbent->m, m);
+                mdl = m_incumbent->m_model->translate(tr);
+            }
+        }
+        if (mdl)
+            update_assignment(mdl);
+#endif
+    }
+
+    void publish_incumbent(model_ref const& mdl) {
+#ifndef SINGLE_THREAD
+        if (!m_incumbent)
+            return;
+        // measure cost over the original soft constraints, m_asms is relaxed by the cores.
+        // The workers received the assumption literals before any relaxation, and these
+        // are equivalent to the original soft constraints.
+        rational c(0);
+        for (soft& s : m_soft)
+            if (!mdl->is_true(s.s))
+                c += s.weight;
+        std::lock_guard<std::mutex> lock(m_incumbent->m_mux);
+        if (m_incumbent->publish(m, mdl, c))
+            m_ls_version = m_incumbent->m_version;
+#endif
     }
 
     void collect_statistics(statistics& st) const override {
         st.update("maxsat-cores", m_stats.m_num_cores);
         st.update("maxsat-correction-sets", m_stats.m_num_cs);
+        if (m_threads > 1)
+            st.update("maxsat-parallel-cores", m_stats.m_num_parallel_cores);
+        if (m_use_totalizer)
+            st.update("maxsat-merged-totalizers", m_stats.m_num_merged_totalizers);
+        if (m_local_search_threads > 0)
+            st.update("maxsat-local-search-models", m_stats.m_num_local_search_models);
     }
 
     lbool get_cores(vector<weighted_core>& cores) {
@@ -437,6 +742,114 @@ public:
         return is_sat;
     }
 
+    /**
+       \brief copy the assertions added to the main solver since the last round into the
+       workers and give each worker the current assumptions. Worker i keeps the assumptions
+       of the i-th weight stratum and above, in a shuffled order.
+    */
+    bool prepare_workers() {
+        try {
+            if (s().get_num_assertions() < (m_workers.empty() ? 0 : m_workers[0]->m_num_assertions))
+                m_workers.reset();
+            while (m_workers.size() + 1 < m_threads) {
+                core_worker* w = alloc(core_worker);
+                m_workers.push_back(w);
+                params_ref p(m_params);
+                p.set_uint("random_seed", m_workers.size());
+                w->m_solver = s().translate(w->m, p);
+                w->m_num_assertions = s().get_num_assertions();
+            }
+        }
+        catch (z3_exception& ex) {
+            IF_VERBOSE(1, verbose_stream() << "(opt.maxres cannot clone solver: " << ex.msg() << ")\n";);
+            m_workers.reset();
+            m_threads = 1;
+            return false;
+        }
+        vector<rational> levels;
+        for (expr* a : m_asms)
+            levels.push_back(get_weight(a));
+        std::sort(levels.begin(), levels.end(), [](rational const& a, rational const& b) { return a > b; });
+        unsigned j = 0;
+        for (unsigned i = 0; i < levels.size(); ++i)
+            if (j == 0 || levels[j - 1] != levels[i])
+                levels[j++] = levels[i];
+        levels.shrink(j);
+
+        unsigned num_assertions = s().get_num_assertions();
+        for (unsigned i = 0; i < m_workers.size(); ++i) {
+            core_worker& w = *m_workers[i];
+            ast_translation tr(m, w.m);
+            for (unsigned k = w.m_num_assertions; k < num_assertions; ++k)
+                w.m_solver->assert_expr(tr(s().get_assertion(k)));
+            w.m_num_assertions = num_assertions;
+            w.m_asms.reset();
+            w.m_asm2main.reset();
+            rational const& threshold = levels[(i * levels.size()) / m_workers.size()];
+            for (expr* a : m_asms) {
+                if (get_weight(a) >= threshold) {
+                    expr* b = tr(a);
+                    w.m_asms.push_back(b);
+                    w.m_asm2main.insert(b, a);
+                }
+            }
+            random_gen rand(i + 1);
+            shuffle(w.m_asms.size(), w.m_asms.data(), rand);
+        }
+        return true;
+    }
+
+    /**
+       \brief extract cores concurrently. The main thread extracts disjoint cores as in
+       get_cores while the workers search their clones. Worker cores whose assumptions
+       are still available after the main cores are merged in, so a round relaxes
+       more cores and raises the lower bound by their combined weight.
+    */
+    lbool get_cores_parallel(vector<weighted_core>& cores) {
+#ifdef SINGLE_THREAD
+        return get_cores(cores);
+#else
+        if (m_asms.empty() || !prepare_workers())
+            return get_cores(cores);
+        bool minimize = !m_c.sat_enabled();
+        std::vector<std::thread> threads;
+        for (core_worker* w : m_workers)
+            threads.push_back(std::thread([w, minimize]() { w->run(minimize); }));
+        lbool is_sat = get_cores(cores);
+        for (core_worker* w : m_workers)
+            w->m.limit().cancel();
+        for (auto& t : threads)
+            t.join();
+        for (core_worker* w : m_workers)
+            w->m.limit().reset_cancel();
+        if (is_sat != l_true || cores.empty())
+            return is_sat;
+
+        for (core_worker* w : m_workers) {
+            if (w->m_result != l_false || w->m_core.empty())
+                continue;
+            obj_hashtable<expr> available;
+            for (expr* a : m_asms)
+                available.insert(a);
+            exprs core;
+            for (expr* e : w->m_core) {
+                expr* a = nullptr;
+                if (!w->m_asm2main.find(e, a) || !available.contains(a))
+                    break;
+                core.push_back(a);
+            }
+            if (core.size() != w->m_core.size())
+                continue;
+            ++m_stats.m_num_cores;
+            ++m_stats.m_num_parallel_cores;
+            cores.push_back(weighted_core(core, core_weight(core)));
+            remove_soft(core, m_asms);
+            split_core(core);
+        }
+        return l_true;
+#endif
+    }
+
     void get_current_correction_set(exprs& cs) {
         model_ref mdl;
         s().get_model(mdl);
@@ -504,7 +917,7 @@ public:
             return core_rotate();
 
         vector<weighted_core> cores;
-        lbool is_sat = get_cores(cores);
+        lbool is_sat = m_threads > 1 ? get_cores_parallel(cores) : get_cores(cores);
         if (is_sat != l_true) {
             return is_sat;
         }
@@ -789,13 +1202,50 @@ public:
     rational                  m_unfold_upper;
     obj_map<expr, totalizer*> m_totalizers;
 
-    expr* mk_atmost_tot(expr_ref_vector const& es, unsigned bound, rational const& weight) {
+    /**
+       \brief build a totalizer for es from the largest cached totalizers over subsets of es,
+       so that their outputs and clauses are shared by the new encoding.
+    */
+    totalizer* mk_totalizer(expr_ref_vector const& es) {
+        obj_hashtable<expr> rest;
+        for (expr* e : es)
+            rest.insert(e);
+        ptr_vector<totalizer> parts;
+        while (true) {
+            totalizer* best = nullptr;
+            for (auto const& [k, t] : m_totalizers) {
+                unsigned sz = t->literals().size();
+                if (sz <= 1 || (best && sz <= best->literals().size()) || sz > rest.size())
+                    continue;
+                if (all_of(t->literals(), [&](expr* e) { return rest.contains(e); }))
+                    best = t;
+            }
+            if (!best)
+                break;
+            parts.push_back(best);
+            for (expr* e : best->literals())
+                rest.remove(e);
+        }
+        if (parts.empty())
+            return alloc(totalizer, es);
+        ++m_stats.m_num_merged_totalizers;
+        expr_ref_vector lits(m);
+        for (expr* e : es)
+            if (rest.contains(e))
+                lits.push_back(e);
+        return alloc(totalizer, m, parts, lits);
+    }
+
+    expr* mk_atmost_tot(expr_ref_vector const& _es, unsigned bound, rational const& weight) {
         pb_util pb(m);
+        // the cache is keyed by the set of literals
+        expr_ref_vector es(_es);
+        std::sort(es.data(), es.data() + es.size(), [](expr* a, expr* b) { return a->get_id() < b->get_id(); });
         expr_ref am(pb.mk_at_most_k(es, 0), m);
         totalizer* t = nullptr;        
         if (!m_totalizers.find(am, t)) {
             m_trail.push_back(am);
-            t = alloc(totalizer, es);
+            t = mk_totalizer(es);
             m_totalizers.insert(am, t);
         }
         expr* at_least = t->at_least(bound + 1);
@@ -1017,6 +1467,8 @@ public:
         if (num_assertions == s().get_num_assertions())
             m_upper = upper;
 
+        publish_incumbent(m_model);
+
         trace();
 
         add_upper_bound_block();
@@ -1062,6 +1514,8 @@ public:
         m_enable_core_rotate =      p.enable_core_rotate();
         m_lns_conflicts =           p.lns_conflicts();
         m_use_totalizer =           p.rc2_totalizer();
+        m_threads =                 p.maxres_threads();
+        m_local_search_threads =    p.maxres_local_search_threads();
 	if (m_c.num_objectives() > 1)
 	  m_add_upper_bound_block = false;
     }
@@ -1081,6 +1535,7 @@ public:
         for (auto& [k,t] : m_totalizers)
             dealloc(t);
         m_totalizers.reset();
+        m_workers.reset();
         return l_true;
     }
 
@@ -642,7 +642,11 @@ namespace opt {
 
     lbool context::execute_pareto() {        
         if (!m_pareto) {
-            set_pareto(alloc(gia_pareto, m, *this, m_solver.get(), m_params));
+            unsigned threads = opt_params(m_params).pareto_threads();
+            if (threads > 1)
+                set_pareto(alloc(parallel_pareto, m, *this, m_solver.get(), m_params, threads));
+            else
+                set_pareto(alloc(gia_pareto, m, *this, m_solver.get(), m_params));
         }
         lbool is_sat = (*(m_pareto.get()))();
         if (is_sat != l_true) {
@@ -18,10 +18,17 @@ Notes:
    
 --*/
 
+#include "util/scoped_ptr_vector.h"
 #include "opt/opt_pareto.h"
 #include "ast/ast_pp.h"
 #include "ast/ast_util.h"
+#include "ast/ast_translation.h"
 #include "model/model_smt2_pp.h"
+#include "smt/smt_solver.h"
+#ifndef SINGLE_THREAD
+#include <chrono>
+#include <thread>
+#endif
 
 namespace opt {
 
@@ -63,34 +70,242 @@ namespace opt {
         return is_sat;
     }
 
-    void pareto_base::mk_dominates() {
+    expr_ref pareto_base::mk_dominates(model_ref& mdl) {
         unsigned sz = cb.num_objectives();
-        expr_ref fml(m);
         expr_ref_vector gt(m), fmls(m);
         for (unsigned i = 0; i < sz; ++i) {
-            fmls.push_back(cb.mk_ge(i, m_model));
-            gt.push_back(cb.mk_gt(i, m_model));
+            fmls.push_back(cb.mk_ge(i, mdl));
+            gt.push_back(cb.mk_gt(i, mdl));
         }
         fmls.push_back(mk_or(gt));
-        fml = mk_and(fmls);
-        IF_VERBOSE(10, verbose_stream() << "dominates: " << fml << "\n";);
-        TRACE("opt", model_smt2_pp(tout << fml << "\n", m, *m_model, 0););
-        m_solver->assert_expr(fml);        
+        return mk_and(fmls);
     }
 
-    void pareto_base::mk_not_dominated_by() {
+    expr_ref pareto_base::mk_not_dominated_by(model_ref& mdl) {
         unsigned sz = cb.num_objectives();
-        expr_ref fml(m);
         expr_ref_vector le(m);
         for (unsigned i = 0; i < sz; ++i) {
-            le.push_back(cb.mk_le(i, m_model));
+            le.push_back(cb.mk_le(i, mdl));
         }
-        fml = m.mk_not(mk_and(le));
+        return expr_ref(m.mk_not(mk_and(le)), m);
+    }
+
+    void pareto_base::mk_dominates() {
+        expr_ref fml = mk_dominates(m_model);
+        IF_VERBOSE(10, verbose_stream() << "dominates: " << fml << "\n";);
+        TRACE("opt", model_smt2_pp(tout << fml << "\n", m, *m_model, 0););
+        m_solver->assert_expr(fml);        
+    }
+
+    void pareto_base::mk_not_dominated_by() {
+        expr_ref fml = mk_not_dominated_by(m_model);
         IF_VERBOSE(10, verbose_stream() << "not dominated by: " << fml << "\n";);
         TRACE("opt", tout << fml << "\n";);
         m_solver->assert_expr(fml);        
     }
 
+    // ---------------------------------
+    // Parallel enumeration over boxes
+
+    struct parallel_pareto::worker {
+        ast_manager      m;
+        ref<solver>      m_solver;
+        expr_ref_vector  m_boxes;
+        unsigned         m_num_seen = 0;    // shared points excluded so far
+        lbool            m_result = l_true;
+        atomic<bool>     m_done;
+        worker(): m_boxes(m), m_done(false) {}
+    };
+
+    lbool parallel_pareto::operator()() {
+        if (!m_enumerated) {
+            lbool is_sat = enumerate();
+            if (is_sat != l_true) 
+                return is_sat;
+            m_enumerated = true;
+        }
+        if (m_next == m_points.size())
+            return l_false;
+        m_model = m_points[m_next];
+        m_labels = m_point_labels[m_next];
+        ++m_next;
+        mk_not_dominated_by();
+        return l_true;
+    }
+
+    /**
+       \brief b dominates a, or b has the same objective values as a.
+    */
+    bool parallel_pareto::dominates(model_ref& a, model_ref& b) {
+        unsigned sz = cb.num_objectives();
+        for (unsigned i = 0; i < sz; ++i) 
+            if (!a->is_true(cb.mk_le(i, b)))
+                return false;
+        return true;
+    }
+
+    void parallel_pareto::run(worker& w) {
+        ast_manager& wm = w.m;
+        try {
+            unsigned box = 0;
+            while (wm.inc() && (box = m_next_box++) < w.m_boxes.size()) {
+                expr_ref guard(wm.mk_fresh_const("box", wm.mk_bool_sort()), wm);
+                w.m_solver->assert_expr(wm.mk_implies(guard, w.m_boxes.get(box)));
+                expr* asms[1] = { guard.get() };
+                while (true) {
+                    expr_ref_vector fmls(wm);
+                    {
+                        lock_guard lock(m_mux);
+                        ast_translation tr(m, wm);
+                        for (; w.m_num_seen < m_points.size(); ++w.m_num_seen) 
+                            fmls.push_back(tr(mk_not_dominated_by(m_points[w.m_num_seen]).get()));
+                    }
+                    for (expr* f : fmls)
+                        w.m_solver->assert_expr(f);
+                    lbool is_sat = w.m_solver->check_sat(1, asms);
+                    if (is_sat == l_false)
+                        break;
+                    if (is_sat == l_undef) {
+                        w.m_result = l_undef;
+                        w.m_done = true;
+                        return;
+                    }
+                    model_ref mdl;
+                    svector<symbol> labels;
+                    w.m_solver->get_model(mdl);
+                    {
+                        solver::scoped_push _s(*w.m_solver.get());
+                        while (is_sat == l_true) {
+                            w.m_solver->get_labels(labels);
+                            mdl->set_model_completion(true);
+                            expr_ref fml(wm);
+                            {
+                                lock_guard lock(m_mux);
+                                ast_translation tr1(wm, m);
+                                model_ref mmdl = mdl->translate(tr1);
+                                ast_translation tr2(m, wm);
+                                fml = tr2(mk_dominates(mmdl).get());
+                            }
+                            w.m_solver->assert_expr(fml);
+                            is_sat = w.m_solver->check_sat(1, asms);
+                            if (is_sat == l_true) 
+                                w.m_solver->get_model(mdl);
+                        }
+                    }
+                    if (is_sat == l_undef) {
+                        w.m_result = l_undef;
+                        w.m_done = true;
+                        return;
+                    }
+                    lock_guard lock(m_mux);
+                    ast_translation tr(wm, m);
+                    m_points.push_back(model_ref(mdl->translate(tr)));
+                    m_point_labels.push_back(labels);
+                }
+                w.m_solver->assert_expr(wm.mk_not(guard));
+            }
+            if (!wm.inc())
+                w.m_result = l_undef;
+        }
+        catch (z3_exception&) {
+            w.m_result = l_undef;
+        }
+        w.m_done = true;
+    }
+
+    lbool parallel_pareto::enumerate() {
+        lbool is_sat = m_solver->check_sat(0, nullptr);
+        if (is_sat != l_true)
+            return is_sat;
+        m_solver->get_model(m_model);
+        {
+            solver::scoped_push _s(*m_solver.get());
+            while (is_sat == l_true) {
+                if (!m.inc())
+                    return l_undef;
+                m_solver->get_labels(m_labels);
+                m_model->set_model_completion(true);
+                mk_dominates();
+                is_sat = m_solver->check_sat(0, nullptr);
+                if (is_sat == l_true) m_solver->get_model(m_model);
+            }
+        }
+        if (is_sat == l_undef)
+            return l_undef;
+        m_points.push_back(m_model);
+        m_point_labels.push_back(m_labels);
+
+        unsigned sz = cb.num_objectives();
+        expr_ref_vector boxes(m), fmls(m);
+        for (unsigned k = 0; k < sz; ++k) {
+            fmls.reset();
+            for (unsigned j = 0; j < k; ++j)
+                fmls.push_back(cb.mk_le(j, m_model));
+            fmls.push_back(cb.mk_gt(k, m_model));
+            boxes.push_back(mk_and(fmls));
+        }
+
+        unsigned num_workers = std::max(1u, std::min(m_threads, sz));
+        scoped_ptr_vector<worker> workers;
+        for (unsigned i = 0; i < num_workers; ++i) {
+            worker* w = alloc(worker);
+            workers.push_back(w);
+            params_ref p(m_params);
+            p.set_uint("random_seed", i + 1);
+            w->m_solver = mk_smt_solver(w->m, p, symbol::null);
+            ast_translation tr(m, w->m);
+            for (unsigned j = 0; j < m_solver->get_num_assertions(); ++j)
+                w->m_solver->assert_expr(tr(m_solver->get_assertion(j)));
+            for (expr* b : boxes)
+                w->m_boxes.push_back(tr(b));
+        }
+        m_next_box = 0;
+#ifdef SINGLE_THREAD
+        for (worker* w : workers)
+            run(*w);
+#else
+        std::vector<std::thread> threads;
+        for (worker* w : workers)
+            threads.push_back(std::thread([this, w]() { run(*w); }));
+        auto all_done = [&]() {
+            for (worker* w : workers)
+                if (!w->m_done)
+                    return false;
+            return true;
+        };
+        while (!all_done()) {
+            if (!m.inc())
+                for (worker* w : workers)
+                    w->m.limit().cancel();
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        for (auto& t : threads)
+            t.join();
+#endif
+        for (worker* w : workers)
+            if (w->m_result == l_undef)
+                return l_undef;
+
+        // keep the points that are not dominated by another point, nor equal to an earlier one
+        bool_vector keep(m_points.size(), true);
+        for (unsigned i = 0; i < m_points.size(); ++i) 
+            for (unsigned k = 0; keep[i] && k < m_points.size(); ++k) 
+                if (k != i && dominates(m_points[i], m_points[k]))
+                    keep[i] = k > i && dominates(m_points[k], m_points[i]);
+        unsigned j = 0;
+        for (unsigned i = 0; i < m_points.size(); ++i) {
+            if (keep[i]) {
+                m_points[j] = m_points[i];
+                m_point_labels[j] = m_point_labels[i];
+                ++j;
+            }
+        }
+        m_points.shrink(j);
+        m_point_labels.shrink(j);
+        IF_VERBOSE(1, verbose_stream() << "(opt.pareto " << m_points.size() << " points)\n";);
+        return l_true;
+    }
+
     // ---------------------------------
     // OIA algorithm (without filtering)
 
@@ -19,6 +19,7 @@ Notes:
 --*/
 #pragma once
 
+#include "util/mutex.h"
 #include "solver/solver.h"
 #include "model/model.h"
 
@@ -75,6 +76,10 @@ namespace opt {
 
     protected:
 
+        expr_ref mk_dominates(model_ref& mdl);
+
+        expr_ref mk_not_dominated_by(model_ref& mdl);
+
         void mk_dominates();
 
         void mk_not_dominated_by();            
@@ -91,6 +96,42 @@ namespace opt {
         lbool operator()() override;
     };
 
+    /**
+       Enumerate the front concurrently. A first Pareto point p is found by GIA.
+       The points not dominated by p are split into one box per objective k, with
+       objective k above p and objectives before k at most p. The boxes are disjoint
+       and solved by worker threads on copies of the solver, each running GIA inside
+       its box. Workers share the points they find, so every worker excludes the
+       points that are dominated by any point found so far. Points found by GIA in
+       a box are only optimal within the box, so the merged set is filtered for
+       dominance before the points are returned one per call.
+    */
+    class parallel_pareto : public pareto_base {
+        struct worker;
+        unsigned                 m_threads;
+        bool                     m_enumerated = false;
+        unsigned                 m_next = 0;
+        vector<model_ref>        m_points;
+        vector<svector<symbol>>  m_point_labels;
+        mutex                    m_mux;             // protects m and m_points while workers run
+        atomic<unsigned>         m_next_box;
+        void run(worker& w);
+        bool dominates(model_ref& a, model_ref& b);
+        lbool enumerate();
+    public:
+        parallel_pareto(ast_manager & m, 
+                        pareto_callback& cb, 
+                        solver* s, 
+                        params_ref & p,
+                        unsigned threads):
+            pareto_base(m, cb, s, p),
+            m_threads(threads),
+            m_next_box(0) {
+        }
+
+        lbool operator()() override;
+    };
+
     // opportunistic improvement algorithm.
     class oia_pareto : public pareto_base {
     public:
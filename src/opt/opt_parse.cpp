@@ -21,19 +21,35 @@ Revision History:
 #include <iostream>
 
 class opt_stream_buffer {
+    static const unsigned s_block_size = 1 << 16;
     std::istream & m_stream;
     int            m_val;
     unsigned       m_line;
+    char const*    m_pos;
+    char const*    m_end;
+    char           m_block[s_block_size];
+
+    // read the input in blocks instead of one character at a time.
+    int get() {
+        if (m_pos == m_end) {
+            m_stream.read(m_block, s_block_size);
+            m_pos = m_block;
+            m_end = m_block + m_stream.gcount();
+        }
+        return m_pos == m_end ? EOF : static_cast<unsigned char>(*m_pos++);
+    }
 public:    
     opt_stream_buffer(std::istream & s):
         m_stream(s),
-        m_line(0) {
-        m_val = m_stream.get();
+        m_line(0),
+        m_pos(m_block),
+        m_end(m_block) {
+        m_val = get();
     }
     int  operator *() const { return m_val;}
-    void operator ++() { m_val = m_stream.get(); }
+    void operator ++() { m_val = get(); }
     int ch() const { return m_val; }
-    void next() { m_val = m_stream.get(); }
+    void next() { m_val = get(); }
     bool eof() const { return ch() == EOF; }
     unsigned line() const { return m_line; }
     void skip_whitespace() {
@@ -80,15 +80,27 @@ namespace opt {
     }
 
     totalizer::totalizer(expr_ref_vector const& literals):
-        m(literals.m()),
-        m_literals(literals),
+        totalizer(literals.m(), ptr_vector<totalizer>(), literals) {
+    }
+
+    totalizer::totalizer(ast_manager& m, ptr_vector<totalizer> const& parts, expr_ref_vector const& literals):
+        m(m),
+        m_literals(m),
         m_clauses(m) {
         ptr_vector<node> trees;
+        for (totalizer* t : parts) {
+            m_literals.append(t->m_literals);
+            trees.push_back(t->m_root);
+            t->m_root->inc_ref();
+        }
         for (expr* e : literals) {
             expr_ref_vector ls(m);
             ls.push_back(e);
-            trees.push_back(alloc(node, ls));            
+            trees.push_back(alloc(node, ls));
+            trees.back()->inc_ref();
+            m_literals.push_back(e);
         }
+        SASSERT(!trees.empty());
         for (unsigned i = 0; i + 1 < trees.size(); i += 2) {
             node* left = trees[i];
             node* right = trees[i + 1];
@@ -97,13 +109,14 @@ namespace opt {
             node* n = alloc(node, ls);
             n->m_left = left;
             n->m_right = right;
+            n->inc_ref();
             trees.push_back(n);
         }
         m_root = trees.back();
     }
         
     totalizer::~totalizer() {
-        dealloc(m_root);
+        node::dec_ref(m_root);
     }
     
     expr* totalizer::at_least(unsigned k) {
@@ -9,6 +9,11 @@ Abstract:
    
     Incremental totalizer for at least constraints
 
+    Totalizers can be merged: the trees of existing totalizers become
+    subtrees of a new one, so the outputs they already define and the
+    clauses asserted for them are reused when a core combines earlier
+    bounds with new literals.
+
 Author:
 
     Nikolaj Bjorner (nbjorner) 2022-06-27
@@ -24,14 +29,16 @@ namespace opt {
         struct node {
             node* m_left = nullptr;
             node* m_right = nullptr;
+            unsigned m_ref = 0;      // nodes are shared between merged totalizers
             expr_ref_vector m_literals;
             node(expr_ref_vector& l): m_literals(l) {}
             ~node() {
-                dealloc(m_left);
-                dealloc(m_right);
+                dec_ref(m_left);
+                dec_ref(m_right);
             }
             unsigned size() const { return m_literals.size(); }
-            
+            void inc_ref() { ++m_ref; }
+            static void dec_ref(node* n) { if (n && --n->m_ref == 0) dealloc(n); }
         };
 
         ast_manager&            m;
@@ -44,7 +51,13 @@ namespace opt {
 
     public:
         totalizer(expr_ref_vector const& literals);
+
+        /**
+           \brief totalizer for the literals of \c parts, which must be disjoint, and \c literals.
+        */
+        totalizer(ast_manager& m, ptr_vector<totalizer> const& parts, expr_ref_vector const& literals);
         ~totalizer();
+        expr_ref_vector const& literals() const { return m_literals; }
         expr* at_least(unsigned k);
         expr_ref_vector& clauses() { return m_clauses; }
         vector<std::pair<expr_ref, expr_ref>>& defs() { return m_defs; }
@@ -87,6 +87,12 @@ void context_params::set(char const * param, char const * value) {
     else if (p == "dump_models") {
         set_bool(m_dump_models, param, value);
     }
+    else if (p == "check_sat_cache") {
+        set_uint(m_check_sat_cache, param, value);
+    }
+    else if (p == "simplify_cache") {
+        set_uint(m_simplify_cache, param, value);
+    }
     else if (p == "stats") {
         set_bool(m_statistics, param, value);
     }
@@ -144,6 +150,8 @@ void context_params::updt_params(params_ref const & p) {
     m_model             = p.get_bool("model", m_model);
     m_model_validate    = p.get_bool("model_validate", m_model_validate);
     m_dump_models       = p.get_bool("dump_models", m_dump_models);
+    m_check_sat_cache   = p.get_uint("check_sat_cache", m_check_sat_cache);
+    m_simplify_cache    = p.get_uint("simplify_cache", m_simplify_cache);
     m_trace             = p.get_bool("trace", m_trace);
     m_trace_file_name   = p.get_str("trace_file_name", "z3.log");
     m_dot_proof_file    = p.get_str("dot_proof_file", "proof.dot");
@@ -162,6 +170,8 @@ void context_params::collect_param_descrs(param_descrs & d) {
     d.insert("auto_config", CPK_BOOL, "use heuristics to automatically select solver and configure it", "true");
     d.insert("model_validate", CPK_BOOL, "validate models produced by solvers", "false");
     d.insert("dump_models", CPK_BOOL, "dump models whenever check-sat returns sat", "false");
+    d.insert("check_sat_cache", CPK_UINT, "number of sat/unsat results of check-sat that are kept and reused when the same assertions and assumptions are checked again (0 disables the cache)", "0");
+    d.insert("simplify_cache", CPK_UINT, "maximal number of simplification results that Z3_simplify keeps and reuses across calls (0 disables the cache)", "0");
     d.insert("trace", CPK_BOOL, "trace generation for VCC", "false");
     d.insert("trace_file_name", CPK_STRING, "trace out file name (see option 'trace')", "z3.log");
     d.insert("dot_proof_file", CPK_STRING, "file in which to output graphical proofs", "proof.dot");
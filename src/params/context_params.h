@@ -30,6 +30,8 @@ class context_params {
 
 public:
     unsigned         m_timeout { UINT_MAX } ;
+    unsigned         m_check_sat_cache { 0 };
+    unsigned         m_simplify_cache { 0 };
     std::string      m_dot_proof_file;
     std::string      m_trace_file_name;
     bool             m_auto_config { true };
@@ -50,6 +50,23 @@ namespace smt2 {
         m_spos++;
     }
 
+    void scanner::push_digit(unsigned base, unsigned d) {
+        SASSERT(base <= 16 && d < base);
+        m_digits = base * m_digits + d;
+        m_digits_scale *= base;
+        if (m_digits_scale >= (1ull << 58))
+            flush_digits();
+    }
+
+    void scanner::flush_digits() {
+        if (m_digits_scale == 1)
+            return;
+        m_number *= rational(m_digits_scale, rational::ui64());
+        m_number += rational(m_digits, rational::ui64());
+        m_digits = 0;
+        m_digits_scale = 1;
+    }
+
     void scanner::read_comment() {
         SASSERT(curr() == ';');
         next();
@@ -150,17 +167,19 @@ namespace smt2 {
 
     scanner::token scanner::read_number() {
         SASSERT('0' <= curr() && curr() <= '9');
-        rational q(1);
+        unsigned num_decimals = 0;
         m_number = rational(curr() - '0');
+        m_digits = 0;
+        m_digits_scale = 1;
         next();
         bool is_float = false;
 
         while (!m_at_eof) {
             char c = curr();
             if ('0' <= c && c <= '9') {
-                m_number = rational(10)*m_number + rational(c - '0');
+                push_digit(10, c - '0');
                 if (is_float)
-                    q *= rational(10);
+                    ++num_decimals;
                 next();
             }
             else if (c == '.') {
@@ -173,8 +192,9 @@ namespace smt2 {
                 break;
             }
         }
+        flush_digits();
         if (is_float)
-            m_number /= q;
+            m_number /= power(rational(10), num_decimals);
         TRACE("scanner", tout << "new number: " << m_number << "\n";);
         return is_float ? FLOAT_TOKEN : INT_TOKEN;
     }
@@ -227,20 +247,17 @@ namespace smt2 {
             c = curr();
             m_number  = rational(0);
             m_bv_size = 0;
+            m_digits  = 0;
+            m_digits_scale = 1;
             while (true) {
-                if ('0' <= c && c <= '9') {
-                    m_number *= rational(16);
-                    m_number += rational(c - '0');
-                }
-                else if ('a' <= c && c <= 'f') {
-                    m_number *= rational(16);
-                    m_number += rational(10 + (c - 'a'));
-                }
-                else if ('A' <= c && c <= 'F') {
-                    m_number *= rational(16);
-                    m_number += rational(10 + (c - 'A'));
-                }
+                if ('0' <= c && c <= '9') 
+                    push_digit(16, c - '0');
+                else if ('a' <= c && c <= 'f') 
+                    push_digit(16, 10 + (c - 'a'));
+                else if ('A' <= c && c <= 'F') 
+                    push_digit(16, 10 + (c - 'A'));
                 else {
+                    flush_digits();
                     if (m_bv_size == 0)
                         throw scanner_exception("invalid empty bit-vector literal", m_line, m_spos);
                     return BV_TOKEN;
@@ -255,13 +272,15 @@ namespace smt2 {
             c = curr();
             m_number  = rational(0);
             m_bv_size = 0;
+            m_digits  = 0;
+            m_digits_scale = 1;
             while (c == '0' || c == '1') {
-                m_number *= rational(2);
-                m_number += rational(c - '0');
+                push_digit(2, c - '0');
                 m_bv_size++;
                 next();
                 c = curr();
             }
+            flush_digits();
             if (m_bv_size == 0)
                 throw scanner_exception("invalid empty bit-vector literal", m_line, m_spos);
             return BV_TOKEN;
@@ -284,6 +303,8 @@ namespace smt2 {
         m_line(1),
         m_pos(0),
         m_bv_size(UINT_MAX),
+        m_digits(0),
+        m_digits_scale(1),
         m_bpos(0),
         m_bend(0),
         m_stream(&stream),
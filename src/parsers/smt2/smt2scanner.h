@@ -43,8 +43,11 @@ namespace smt2 {
         rational           m_number;
         unsigned           m_bv_size;
         // end of data
+        // digits of the numeral being read that are not yet folded into m_number.
+        uint64_t           m_digits;
+        uint64_t           m_digits_scale;
         signed char        m_normalized[256];
-#define SCANNER_BUFFER_SIZE 1024
+#define SCANNER_BUFFER_SIZE (1 << 16)
         char               m_buffer[SCANNER_BUFFER_SIZE];
         unsigned           m_bpos;
         unsigned           m_bend;
@@ -59,6 +62,8 @@ namespace smt2 {
         char curr() const { return m_curr; }
         void new_line() { m_line++; m_spos = 0; }
         void next();
+        void push_digit(unsigned base, unsigned d);
+        void flush_digits();
         
     public:
         
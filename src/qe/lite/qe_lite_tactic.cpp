@@ -75,6 +75,7 @@ namespace qel {
         expr_ref_vector m_subst_map;
         expr_ref_vector m_new_exprs;
         plugin_manager<mbp::solve_plugin> m_solvers;
+        expr_free_vars  m_free_vars;
 
         ptr_vector<expr> m_map;
         int_vector       m_pos2var;
@@ -616,30 +617,39 @@ namespace qel {
             }
         }
 
-        bool is_unconstrained(var* x, expr* t, unsigned i, expr_ref_vector const& conjs) {
+        /**
+           \brief x occurs in the disequality x != t at position i.
+           It is unconstrained if it does not occur in t and no other conjunct contains it.
+        */
+        bool is_unconstrained(var* x, expr* t, unsigned_vector const& var_occs) {
             sort* s = x->get_sort();
             if (!m.is_fully_interp(s) || !s->get_num_elements().is_infinite()) return false;
-            bool occ = occurs_var(x->get_idx(), t);
-            for (unsigned j = 0; !occ && j < conjs.size(); ++j) {
-                occ = (i != j) && occurs_var(x->get_idx(), conjs[j]);
-            }
-            return !occ;
+            return var_occs[x->get_idx()] == 1 && !occurs_var(x->get_idx(), t);
+        }
+
+        void update_var_occs(expr* conj, int delta, unsigned_vector& var_occs) {
+            m_free_vars(conj);
+            var_occs.reserve(m_free_vars.size(), 0);
+            for (unsigned idx = 0; idx < m_free_vars.size(); ++idx) 
+                if (m_free_vars.contains(idx)) 
+                    var_occs[idx] += delta;
         }
 
         bool remove_unconstrained(expr_ref_vector& conjs) {
             bool reduced = false, change = true;
             expr *r = nullptr, *l = nullptr, *ne = nullptr;
+            // number of conjuncts containing each variable
+            unsigned_vector var_occs;
+            for (expr* c : conjs)
+                update_var_occs(c, 1, var_occs);
             while (change) {
                 change = false;
                 for (unsigned i = 0; i < conjs.size(); ++i) {
                     if (m.is_not(conjs[i].get(), ne) && m.is_eq(ne, l, r)) {
                         TRACE("qe_lite", tout << mk_pp(conjs[i].get(), m) << " " << is_variable(l) << " " << is_variable(r) << "\n";);
-                        if (is_variable(l) && ::is_var(l) && is_unconstrained(::to_var(l), r, i, conjs)) {
-                            conjs[i] = m.mk_true();
-                            reduced = true;
-                            change = true;
-                        }
-                        else if (is_variable(r) && ::is_var(r) && is_unconstrained(::to_var(r), l, i, conjs)) {
+                        if ((is_variable(l) && ::is_var(l) && is_unconstrained(::to_var(l), r, var_occs)) ||
+                            (is_variable(r) && ::is_var(r) && is_unconstrained(::to_var(r), l, var_occs))) {
+                            update_var_occs(conjs.get(i), -1, var_occs);
                             conjs[i] = m.mk_true();
                             reduced = true;
                             change = true;
@@ -28,16 +28,40 @@ bool parse_dimacs(std::istream & s, std::ostream& err, sat::solver & solver);
 namespace dimacs {
     struct lex_error {};
 
+    /**
+       \brief character stream over an input stream.
+       The input is read in blocks, instead of one character at a time, 
+       so that parsing large benchmarks is not dominated by calls to std::istream::get.
+    */
     class stream_buffer {
+        static const unsigned s_block_size = 1 << 16;
         std::istream & m_stream;
         int            m_val;
         unsigned       m_line;
+        char const*    m_pos;
+        char const*    m_end;
+        char           m_block[s_block_size];
+
+        void fill() {
+            m_stream.read(m_block, s_block_size);
+            m_pos = m_block;
+            m_end = m_block + m_stream.gcount();
+        }
+
+        int get() {
+            if (m_pos == m_end)
+                fill();
+            return m_pos == m_end ? EOF : static_cast<unsigned char>(*m_pos++);
+        }
+
     public:
         
-    stream_buffer(std::istream & s):
-        m_stream(s),
-            m_line(0) {
-            m_val = m_stream.get();
+        stream_buffer(std::istream & s):
+            m_stream(s),
+            m_line(0),
+            m_pos(m_block),
+            m_end(m_block) {
+            m_val = get();
         }
         
         int  operator *() const { 
@@ -45,7 +69,7 @@ namespace dimacs {
         }
         
         void operator ++() { 
-            m_val = m_stream.get();
+            m_val = get();
             if (m_val == '\n') ++m_line;
         }
         
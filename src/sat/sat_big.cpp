@@ -177,9 +177,29 @@ namespace sat {
         m_del_bin[u.index()].push_back(v);
     }
 
+    /**
+       \brief a literal that reaches its negation in the DFS forest is failed.
+       The DFS intervals give this for free after stamping, so failed literals
+       are detected on every rebuild of the graph without probing.
+    */
+    unsigned big::failed_literals(solver& s) {
+        unsigned num_failed = 0;
+        unsigned num_lits = m_num_vars * 2;
+        for (unsigned l_idx = 0; l_idx < num_lits && !s.inconsistent(); ++l_idx) {
+            literal u = to_literal(l_idx);
+            if (reaches(u, ~u) && s.value(u) == l_undef) {
+                IF_VERBOSE(20, verbose_stream() << "failed: " << u << "\n");
+                s.assign_unit(~u);
+                ++num_failed;
+            }
+        }
+        return num_failed;
+    }
+
     unsigned big::reduce_tr(solver& s) {
         unsigned idx = 0;
         unsigned elim = 0;
+        failed_literals(s);
         m_del_bin.reset();
         m_del_bin.reserve(s.m_watches.size());
         for (watch_list & wlist : s.m_watches) {
@@ -75,6 +75,8 @@ namespace sat {
 
         unsigned reduce_tr(solver& s);
 
+        unsigned failed_literals(solver& s);
+
         // does it include learned binaries?
         bool learned() const { return m_learned; }
         int get_left(literal l) const { return m_left[l.index()]; }
@@ -51,6 +51,7 @@ namespace sat {
         m_fast_glue_avg = p.restart_emafastglue();
         m_slow_glue_avg = p.restart_emaslowglue();
         m_restart_margin = p.restart_margin();
+        m_restart_stable_unit = p.restart_stable_unit();
         m_restart_fast = p.restart_fast();
         s = p.phase();
         if (s == symbol("always_false")) 
@@ -83,6 +84,8 @@ namespace sat {
         m_restart_max     = p.restart_max();
         m_propagate_prefetch = p.propagate_prefetch();
         m_inprocess_max   = p.inprocess_max();
+        m_inprocess_max_delay = p.inprocess_max_delay();
+        m_inprocess_min_yield = p.inprocess_min_yield();
         m_inprocess_out   = p.inprocess_out();
 
         m_random_freq     = p.random_freq();
@@ -96,6 +99,10 @@ namespace sat {
         
         m_max_conflicts   = p.max_conflicts();
         m_num_threads     = p.threads();
+        m_par_share_max_size = p.par_share_max_size();
+        m_par_share_max_glue = p.par_share_max_glue();
+        m_par_keep_lemmas = p.par_keep_lemmas();
+        m_par_diversify = p.par_diversify();
         m_ddfw_search     = p.ddfw_search();
         m_ddfw_threads    = p.ddfw_threads();
         m_prob_search     = p.prob_search();
@@ -154,6 +161,7 @@ namespace sat {
         m_lookahead_cube_psat_var_exp = p.lookahead_cube_psat_var_exp();
         m_lookahead_cube_psat_clause_base = p.lookahead_cube_psat_clause_base();
         m_lookahead_cube_psat_trigger = p.lookahead_cube_psat_trigger();
+        m_lookahead_cube_icnf = p.lookahead_cube_icnf();
         m_lookahead_global_autarky = p.lookahead_global_autarky();
         m_lookahead_delta_fraction = p.lookahead_delta_fraction();
         m_lookahead_use_learned = p.lookahead_use_learned();
@@ -184,14 +192,17 @@ namespace sat {
         m_gc_initial      = p.gc_initial();
         m_gc_increment    = p.gc_increment();
         m_gc_small_lbd    = p.gc_small_lbd();
+        m_gc_tier2_lbd    = p.gc_tier2_lbd();
         m_gc_k            = std::min(255u, p.gc_k());
         m_gc_burst        = p.gc_burst();
         m_gc_defrag       = p.gc_defrag();
+        m_gc_defrag_interval = std::max(1u, p.gc_defrag_interval());
 
         m_force_cleanup   = p.force_cleanup();
 
         m_backtrack_scopes = p.backtrack_scopes();
         m_backtrack_init_conflicts = p.backtrack_conflicts();
+        m_backtrack_assignments = p.backtrack_assignments();
 
         m_minimize_lemmas = p.minimize_lemmas();
         m_core_minimize   = p.core_minimize();
@@ -199,6 +210,7 @@ namespace sat {
         m_drat_check_unsat  = p.drat_check_unsat();
         m_drat_check_sat  = p.drat_check_sat();
         m_drat_file       = p.drat_file();
+        m_clause_cache    = p.clause_cache();
         m_smt_proof_check = p.smt_proof_check();
         m_drat_disable = p.drat_disable();
         m_drat            =
@@ -219,8 +231,10 @@ namespace sat {
             m_branching_heuristic = BH_VSIDS;
         else if (p.branching_heuristic() == symbol("chb")) 
             m_branching_heuristic = BH_CHB;
+        else if (p.branching_heuristic() == symbol("vmtf")) 
+            m_branching_heuristic = BH_VMTF;
         else 
-            throw sat_param_exception("invalid branching heuristic: accepted heuristics are 'vsids' or 'chb'");
+            throw sat_param_exception("invalid branching heuristic: accepted heuristics are 'vsids', 'chb' or 'vmtf'");
 
         m_anti_exploration = p.branching_anti_exploration();
         m_step_size_init = 0.40;
@@ -259,7 +273,7 @@ namespace sat {
             throw sat_param_exception("invalid PB lemma format: 'cardinality' or 'pb' expected");
         
         m_card_solver = p.cardinality_solver();
-        m_xor_solver = false; // prevent users from playing with this option
+        m_xor_solver = p.xor_solver();
 
         sat_simplifier_params ssp(_p);
         m_elim_vars = ssp.elim_vars();
@@ -50,7 +50,8 @@ namespace sat {
 
     enum branching_heuristic {
         BH_VSIDS,
-        BH_CHB
+        BH_CHB,
+        BH_VMTF
     };
 
     enum pb_resolve {
@@ -100,11 +101,14 @@ namespace sat {
         unsigned           m_restart_initial;
         double             m_restart_factor; // for geometric case
         double             m_restart_margin; // for ema
+        unsigned           m_restart_stable_unit; // for ema in the sat phase
         unsigned           m_restart_max;
         unsigned           m_activity_scale;
         double             m_fast_glue_avg;
         double             m_slow_glue_avg;
         unsigned           m_inprocess_max;
+        unsigned           m_inprocess_max_delay;
+        double             m_inprocess_min_yield;
         symbol             m_inprocess_out;
         double             m_random_freq;
         unsigned           m_random_seed;
@@ -112,6 +116,10 @@ namespace sat {
         bool               m_enable_pre_simplify;
         unsigned           m_max_conflicts;
         unsigned           m_num_threads;
+        unsigned           m_par_share_max_size;
+        unsigned           m_par_share_max_glue;
+        unsigned           m_par_keep_lemmas;
+        bool               m_par_diversify;
         bool               m_ddfw_search;
         unsigned           m_ddfw_threads;
         bool               m_prob_search;
@@ -141,6 +149,7 @@ namespace sat {
         double             m_lookahead_cube_psat_var_exp;
         double             m_lookahead_cube_psat_clause_base;
         double             m_lookahead_cube_psat_trigger;
+        symbol             m_lookahead_cube_icnf;
         reward_t           m_lookahead_reward;
         bool               m_lookahead_double;
         bool               m_lookahead_global_autarky;
@@ -159,15 +168,18 @@ namespace sat {
         unsigned           m_gc_initial;
         unsigned           m_gc_increment;
         unsigned           m_gc_small_lbd;
+        unsigned           m_gc_tier2_lbd;
         unsigned           m_gc_k;
         bool               m_gc_burst;
         bool               m_gc_defrag;
+        unsigned           m_gc_defrag_interval;
 
         bool               m_force_cleanup;
 
         // backtracking
         unsigned           m_backtrack_scopes;
         unsigned           m_backtrack_init_conflicts;
+        unsigned           m_backtrack_assignments;
 
         bool               m_minimize_lemmas;
         bool               m_dyn_sub_res;
@@ -179,6 +191,7 @@ namespace sat {
         bool               m_drat_disable;
         bool               m_drat_binary;
         symbol             m_drat_file;
+        symbol             m_clause_cache;
         bool               m_smt_proof_check;
         bool               m_drat_check_unsat;
         bool               m_drat_check_sat;
@@ -112,7 +112,18 @@ namespace sat {
 
         uint64_t shift_table(cut const& other) const;
 
+        /**
+           \brief the filters hash elements to bits, so the number of bits
+           in the union of the filters bounds the size of the merged cut from below.
+        */
+        static bool may_merge(cut const& a, cut const& b) {
+            return get_num_1bits(a.m_filter | b.m_filter) <= max_cut_size();
+        }
+
         bool merge(cut const& a, cut const& b) {
+            if (!may_merge(a, b)) {
+                return false;
+            }
             unsigned i = 0, j = 0;
             unsigned x = a[i];
             unsigned y = b[j];
@@ -195,6 +195,8 @@ namespace sat {
         for (literal lit : *cls) {
             m_use_list.reserve(2*(lit.var()+1));
             m_vars.reserve(lit.var()+1);
+            m_rewards.reserve(lit.var()+1, 0);
+            m_make_counts.reserve(lit.var()+1, 0);
             m_use_list[lit.index()].push_back(idx);
         }
     }
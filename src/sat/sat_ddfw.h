@@ -97,9 +97,7 @@ namespace sat {
         struct var_info {
             var_info() {}
             bool     m_value = false;
-            double   m_reward = 0;
             double   m_last_reward = 0;
-            unsigned m_make_count = 0;
             int      m_bias = 0;
             bool     m_external = false;
             ema      m_reward_avg = 1e-5;
@@ -111,6 +109,11 @@ namespace sat {
         svector<clause_info> m_clauses;
         literal_vector       m_assumptions;        
         svector<var_info>    m_vars;        // var -> info
+        // reward and make count are updated for every literal of every clause
+        // touched by a flip and scanned by pick_var, so they are kept in
+        // dense arrays of their own instead of inside var_info.
+        svector<double>      m_rewards;     // var -> reward
+        unsigned_vector      m_make_counts; // var -> number of unsat clauses containing var
         svector<double>      m_probs;       // var -> probability of flipping
         svector<double>      m_scores;      // reward -> score
         model                m_model;       // var -> best assignment
@@ -144,15 +147,15 @@ namespace sat {
 
         inline unsigned num_vars() const { return m_vars.size(); }
 
-        inline unsigned& make_count(bool_var v) { return m_vars[v].m_make_count; }
+        inline unsigned& make_count(bool_var v) { return m_make_counts[v]; }
 
         inline bool& value(bool_var v) { return m_vars[v].m_value; }
 
         inline bool value(bool_var v) const { return m_vars[v].m_value; }
 
-        inline double& reward(bool_var v) { return m_vars[v].m_reward; }
+        inline double& reward(bool_var v) { return m_rewards[v]; }
 
-        inline double reward(bool_var v) const { return m_vars[v].m_reward; }
+        inline double reward(bool_var v) const { return m_rewards[v]; }
 
         inline double plugin_reward(bool_var v) { return is_external(v) ? (m_vars[v].m_last_reward = m_plugin->reward(v)) : reward(v); }
 
@@ -31,7 +31,13 @@ namespace sat {
     {
         if (s.get_config().m_drat && s.get_config().m_drat_file.is_non_empty_string()) {
             auto mode = s.get_config().m_drat_binary ? (std::ios_base::binary | std::ios_base::out | std::ios_base::trunc) : std::ios_base::out;
-            m_out = alloc(std::ofstream, s.get_config().m_drat_file.str(), mode);
+            // proofs are written one clause at a time, use a large buffer
+            // so the file is written in big chunks.
+            std::ofstream* out = alloc(std::ofstream);
+            m_out_buffer.resize(1 << 20);
+            out->rdbuf()->pubsetbuf(m_out_buffer.data(), m_out_buffer.size());
+            out->open(s.get_config().m_drat_file.str(), mode);
+            m_out = out;
             if (s.get_config().m_drat_binary) 
                 std::swap(m_out, m_bout);            
         }
@@ -682,6 +688,8 @@ namespace sat {
         }
         if (m_out)
             dump(sz, lits, st);
+        if (m_bout)
+            bdump(sz, lits, st);
 
         if (m_clause_eh)
             m_clause_eh->on_clause(sz, lits, st);
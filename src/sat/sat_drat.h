@@ -52,6 +52,7 @@ namespace sat {
         clause_allocator        m_alloc;
         std::ostream*           m_out = nullptr;
         std::ostream*           m_bout = nullptr;
+        svector<char>           m_out_buffer;
         svector<std::pair<clause&, status>> m_proof;
         svector<std::pair<literal, clause*>> m_units;
         vector<watch>           m_watches;
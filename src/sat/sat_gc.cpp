@@ -29,8 +29,10 @@ namespace sat {
     // -----------------------
 
     bool solver::should_gc() const {
+        // collect four times as often while the check is above its memory high watermark
+        unsigned threshold = m_rlimit.above_memory_high_watermark() ? m_gc_threshold / 4 : m_gc_threshold;
         return 
-            m_conflicts_since_gc > m_gc_threshold &&
+            m_conflicts_since_gc > threshold &&
             (m_config.m_gc_strategy != GC_DYN_PSM || at_base_lvl());
     }
 
@@ -39,7 +41,8 @@ namespace sat {
         TRACE("sat", tout << m_conflicts_since_gc << " " << m_gc_threshold << "\n";);
         unsigned gc = m_stats.m_gc_clause;
         m_conflicts_since_gc = 0;
-        m_gc_threshold += m_config.m_gc_increment;
+        if (!m_rlimit.above_memory_high_watermark())
+            m_gc_threshold += m_config.m_gc_increment;
         IF_VERBOSE(10, verbose_stream() << "(sat.gc)\n";);
         CASSERT("sat_gc_bug", check_invariant());
         switch (m_config.m_gc_strategy) {
@@ -153,6 +156,19 @@ namespace sat {
         }
     }
 
+    /**
+       \brief Learned clauses are kept in tiers by glue.
+       Core clauses (glue at most gc.small_lbd) are never deleted.
+       Tier 2 clauses (glue at most gc.tier2_lbd) are kept when they
+       propagated since the last garbage collection.
+       The remaining local clauses are subject to the strategy.
+    */
+    bool solver::keep_tier(clause const& c) const {
+        if (c.glue() <= m_config.m_gc_small_lbd) 
+            return true;
+        return c.glue() <= m_config.m_gc_tier2_lbd && c.was_used();
+    }
+
     /**
        \brief GC (the second) half of the clauses in the database.
     */
@@ -163,7 +179,7 @@ namespace sat {
         unsigned j      = new_sz;
         for (unsigned i = new_sz; i < sz; i++) {
             clause & c = *(m_learned[i]);
-            if (can_delete(c)) {
+            if (!keep_tier(c) && can_delete(c)) {
                 detach_clause(c);
                 del_clause(c);
             }
@@ -175,6 +191,8 @@ namespace sat {
         new_sz = j;
         m_stats.m_gc_clause += sz - new_sz;
         m_learned.shrink(new_sz);
+        for (clause* cp : m_learned) 
+            cp->unmark_used();
         IF_VERBOSE(SAT_VB_LVL, verbose_stream() << "(sat-gc :strategy " << st_name << " :deleted " << (sz - new_sz) << ")\n";);
     }
 
@@ -2102,6 +2102,16 @@ namespace sat {
         st.update("lh cube cutoffs", m_cube_state.m_cutoffs);
         st.update("lh cube conflicts", m_cube_state.m_conflicts);        
         st.update("lh cube backtracks", m_cube_state.m_backtracks);        
+        st.update("lh cube max hardness", m_cube_state.m_max_hardness);
+    }
+
+    void lookahead::display_icnf(literal_vector const& cube, unsigned hardness) {
+        std::ostream& out = *m_icnf;
+        out << "c hardness " << hardness << "\na";
+        for (literal lit : cube) 
+            out << " " << (lit.sign() ? "-" : "") << (lit.var() + 1);
+        out << " 0\n";
+        out.flush();
     }
 
     double lookahead::psat_heur() {
@@ -2154,6 +2164,8 @@ namespace sat {
             init_search();
             m_model.reset();
             m_cube_state.m_first = false;
+            if (m_s.m_config.m_lookahead_cube_icnf.is_non_empty_string()) 
+                m_icnf = alloc(std::ofstream, m_s.m_config.m_lookahead_cube_icnf.str());
         }        
         scoped_level _sl(*this, c_fixed_truth);
         m_search_mode = lookahead_mode::searching;
@@ -2198,6 +2210,10 @@ namespace sat {
                 lits.append(m_cube_state.m_cube);
                 vars.reset();
                 for (auto v : m_freevars) if (in_reduced_clause(v)) vars.push_back(v);
+                m_cube_state.m_hardness = vars.size();
+                m_cube_state.m_max_hardness = std::max(m_cube_state.m_max_hardness, vars.size());
+                if (m_icnf) 
+                    display_icnf(lits, vars.size());
                 backtrack(m_cube_state.m_cube, m_cube_state.m_is_decision);
                 return l_undef;
             }
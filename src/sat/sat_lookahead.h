@@ -20,6 +20,7 @@ Notes:
 #pragma once
 
 
+#include <fstream>
 #include "util/small_object_allocator.h"
 #include "sat/sat_elim_eqs.h"
 
@@ -185,6 +186,8 @@ namespace sat {
             unsigned       m_conflicts;
             unsigned       m_cutoffs;
             unsigned       m_backtracks;
+            unsigned       m_hardness;      // hardness estimate of the last cube
+            unsigned       m_max_hardness;
             cube_state() { reset(); }
             void reset() { 
                 m_first = true;
@@ -192,6 +195,8 @@ namespace sat {
                 m_cube.reset(); 
                 m_freevars_threshold = 0;
                 m_psat_threshold = dbl_max;
+                m_hardness = 0;
+                m_max_hardness = 0;
                 reset_stats();
             }
             void reset_stats() { m_conflicts = 0; m_cutoffs = 0; m_backtracks = 0;}
@@ -250,6 +255,7 @@ namespace sat {
         stats                  m_stats;
         model                  m_model; 
         cube_state             m_cube_state;
+        scoped_ptr<std::ofstream> m_icnf;       // stream of cubes in iCNF
         unsigned               m_max_ops;       // cap number of operations used to compute lookahead reward.
         //scoped_ptr<extension>  m_ext;
  
@@ -566,6 +572,8 @@ namespace sat {
 
         bool should_cutoff(unsigned depth);
 
+        void display_icnf(literal_vector const& cube, unsigned hardness);
+
     public:
         lookahead(solver& s) : 
             m_s(s),
@@ -601,6 +609,13 @@ namespace sat {
 
         lbool cube(bool_var_vector& vars, literal_vector& lits, unsigned backtrack_level);
 
+        /**
+           \brief hardness estimate of the last cube returned by cube():
+           the number of unassigned variables that still occur in reduced clauses.
+           A scheduler can use it to order or balance cubes across workers.
+        */
+        unsigned cube_hardness() const { return m_cube_state.m_hardness; }
+
         void update_cube_statistics(statistics& st);
 
         /**
@@ -91,32 +91,83 @@ namespace sat {
     }
 
     void parallel::reset() {
+        for (unsigned i = 0; i < m_solvers.size(); ++i) {
+            if (!m_solvers[i])
+                continue;
+            solver const& s = *m_solvers[i];
+            IF_VERBOSE(1, verbose_stream() << "(sat-parallel :id " << i 
+                       << " :exported " << s.m_stats.m_par_exported 
+                       << " :imported " << s.m_stats.m_par_imported << ")\n";);
+        }
         m_limits.reset();
         m_scoped_rlimit.reset();
         for (auto* s : m_solvers)
             dealloc(s);
         m_solvers.reset();
+        m_solver_params.reset();
     }
 
     void parallel::init_solvers(solver& s, unsigned num_extra_solvers) {
+        reserve_solvers(s, num_extra_solvers);
+        for (unsigned i = 0; i < num_extra_solvers; ++i) 
+            init_solver(s, i);
+    }
+
+    /**
+       \brief prepare the parameters and resource limits of the extra solvers,
+       so that they can be created by init_solver from their own threads.
+    */
+    void parallel::reserve_solvers(solver& s, unsigned num_extra_solvers) {
         unsigned num_threads = num_extra_solvers + 1;
         m_solvers.init(num_extra_solvers);
         m_limits.init(num_extra_solvers);
+        m_solver_params.reset();
         symbol saved_phase = s.m_params.get_sym("phase", symbol("caching"));
         
         for (unsigned i = 0; i < num_extra_solvers; ++i) {
-            s.m_params.set_uint("random_seed", s.m_rand());
+            unsigned seed = s.m_rand();
+            s.m_params.set_uint("random_seed", seed);
             if (i == 1 + num_threads/2) 
                 s.m_params.set_sym("phase", symbol("random"));
-            m_solvers[i] = alloc(sat::solver, s.m_params, m_limits[i]);
-            m_solvers[i]->copy(s, true);
-            m_solvers[i]->set_par(this, i);
-            push_child(m_solvers[i]->rlimit());            
+            // setting a parameter detaches p from s.m_params, so each solver
+            // owns its parameters: their reference counts are not atomic.
+            params_ref p(s.m_params);
+            p.set_uint("random_seed", seed);
+            if (s.get_config().m_par_diversify)
+                diversify(i, p);
+            m_solver_params.push_back(alloc(params_ref, p));
+            push_child(m_limits[i]);            
         }
         s.set_par(this, num_extra_solvers);
         s.m_params.set_sym("phase", saved_phase);        
     }
 
+    /**
+       \brief create the i'th extra solver as a copy of s.
+       Copies may be created concurrently, but s must not change while they are created.
+    */
+    void parallel::init_solver(solver const& s, unsigned i) {
+        solver* c = alloc(sat::solver, *m_solver_params[i], m_limits[i]);
+        c->copy(s, true);
+        c->set_par(this, i);
+        m_solvers[i] = c;
+    }
+
+    /**
+       \brief the main solver keeps its configuration, and the i'th extra solver
+       cycles through combinations of restart strategy, search mode and branching
+       heuristic, so that the threads do not only differ in the random seed.
+       A stable_unit of 0 keeps ema restarts while searching for a model (focused mode).
+    */
+    void parallel::diversify(unsigned i, params_ref& p) {
+        static char const* restarts[3] = { "ema", "luby", "geometric" };
+        static unsigned stable_units[2] = { 0, 1024 };
+        static char const* heuristics[2] = { "vsids", "chb" };
+        p.set_sym("restart", symbol(restarts[i % 3]));
+        p.set_uint("restart.stable_unit", stable_units[(i / 3) % 2]);
+        p.set_sym("branching.heuristic", symbol(heuristics[(i / 2) % 2]));
+    }
+
     void parallel::push_child(reslimit& rl) {
         m_scoped_rlimit.push_child(&rl);            
     }
@@ -142,62 +193,92 @@ namespace sat {
         }
     }
 
+    void parallel::reserve(unsigned num_owners, unsigned sz) {
+        m_pools.reset();
+        for (unsigned i = 0; i < num_owners; ++i) {
+            m_pools.push_back(alloc(shared_pool));
+            m_pools.back()->m_pool.reserve(num_owners, sz);
+        }
+    }
+
     void parallel::share_clause(solver& s, literal l1, literal l2) {        
         if (s.get_config().m_num_threads == 1 || s.m_par_syncing_clauses) return;
         flet<bool> _disable_sync_clause(s.m_par_syncing_clauses, true);
         IF_VERBOSE(3, verbose_stream() << s.m_par_id << ": share " <<  l1 << " " << l2 << "\n";);
+        shared_pool& p = *m_pools[s.m_par_id];
         {
-            lock_guard lock(m_mux);
-            m_pool.begin_add_vector(s.m_par_id, 2);
-            m_pool.add_vector_elem(l1.index());
-            m_pool.add_vector_elem(l2.index());            
-            m_pool.end_add_vector();
+            lock_guard lock(p.m_mux);
+            p.m_pool.begin_add_vector(s.m_par_id, 2);
+            p.m_pool.add_vector_elem(l1.index());
+            p.m_pool.add_vector_elem(l2.index());            
+            p.m_pool.end_add_vector();
         }        
+        s.m_stats.m_par_exported++;
     }
 
     void parallel::share_clause(solver& s, clause const& c) {        
-        if (s.get_config().m_num_threads == 1 || !enable_add(c) || s.m_par_syncing_clauses) return;
+        if (s.get_config().m_num_threads == 1 || !enable_add(s, c) || s.m_par_syncing_clauses) return;
         flet<bool> _disable_sync_clause(s.m_par_syncing_clauses, true);
         unsigned n = c.size();
         unsigned owner = s.m_par_id;
         IF_VERBOSE(3, verbose_stream() << owner << ": share " <<  c << "\n";);
-        lock_guard lock(m_mux);
-        m_pool.begin_add_vector(owner, n);                
-        for (unsigned i = 0; i < n; ++i) 
-            m_pool.add_vector_elem(c[i].index());
-        m_pool.end_add_vector();        
+        shared_pool& p = *m_pools[owner];
+        {
+            lock_guard lock(p.m_mux);
+            p.m_pool.begin_add_vector(owner, n);                
+            for (unsigned i = 0; i < n; ++i) 
+                p.m_pool.add_vector_elem(c[i].index());
+            p.m_pool.end_add_vector();        
+        }
+        s.m_stats.m_par_exported++;
     }
 
     void parallel::get_clauses(solver& s) {
         if (s.m_par_syncing_clauses) return;
         flet<bool> _disable_sync_clause(s.m_par_syncing_clauses, true);
-        lock_guard lock(m_mux);
-        _get_clauses(s);        
+        for (unsigned i = 0; i < m_pools.size(); ++i) 
+            if (i != s.m_par_id)
+                _get_clauses(s, *m_pools[i]);
     }
 
-    void parallel::_get_clauses(solver& s) {
+    void parallel::_get_clauses(solver& s, shared_pool& p) {
         unsigned n;
         unsigned const* ptr;
         unsigned owner = s.m_par_id;
-        while (m_pool.get_vector(owner, n, ptr)) {
-            m_lits.reset();
+        unsigned_vector buffer;
+        {
+            // copy clauses out of the pool so that the producer is not
+            // blocked while they are added to the importing solver.
+            lock_guard lock(p.m_mux);
+            while (p.m_pool.get_vector(owner, n, ptr)) {
+                buffer.push_back(n);
+                buffer.append(n, ptr);
+            }
+        }
+        literal_vector lits;
+        for (unsigned j = 0; j < buffer.size(); j += n + 1) {
+            n = buffer[j];
+            ptr = buffer.data() + j + 1;
+            lits.reset();
             bool usable_clause = true;
             for (unsigned i = 0; usable_clause && i < n; ++i) {
                 literal lit(to_literal(ptr[i]));                
-                m_lits.push_back(lit);
+                lits.push_back(lit);
                 usable_clause = lit.var() <= s.m_par_num_vars && !s.was_eliminated(lit.var());
             }
-            IF_VERBOSE(3, verbose_stream() << s.m_par_id << ": retrieve " << m_lits << "\n";);
+            IF_VERBOSE(3, verbose_stream() << s.m_par_id << ": retrieve " << lits << "\n";);
             SASSERT(n >= 2);
             if (usable_clause) {
-                s.mk_clause_core(m_lits.size(), m_lits.data(), sat::status::redundant());
+                s.mk_clause_core(lits.size(), lits.data(), sat::status::redundant());
+                s.m_stats.m_par_imported++;
             }
         }        
     }
 
-    bool parallel::enable_add(clause const& c) const {
+    bool parallel::enable_add(solver const& s, clause const& c) const {
         // plingeling, glucose heuristic:
-        return (c.size() <= 40 && c.glue() <= 8) || c.glue() <= 2;
+        config const& cfg = s.get_config();
+        return (c.size() <= cfg.m_par_share_max_size && c.glue() <= cfg.m_par_share_max_glue) || c.glue() <= 2;
     }
 
     void parallel::_from_solver(solver& s) {
@@ -48,18 +48,25 @@ namespace sat {
             bool get_vector(unsigned owner, unsigned& n, unsigned const*& ptr);
         };
 
-        bool enable_add(clause const& c) const;
-        void _get_clauses(solver& s);
+        // clauses are exported into the pool owned by the producing thread.
+        // a producer only contends with consumers reading its own pool.
+        struct shared_pool {
+            vector_pool m_pool;
+            mutex       m_mux;
+        };
+
+        bool enable_add(solver const& s, clause const& c) const;
+        void _get_clauses(solver& s, shared_pool& p);
         void _from_solver(solver& s);
         void _to_solver(solver& s);
         bool _from_solver(i_local_search& s);
         void _to_solver(i_local_search& s);
+        static void diversify(unsigned i, params_ref& p);
 
         typedef hashtable<unsigned, u_hash, u_eq> index_set;
         literal_vector m_units;
         index_set      m_unit_set;
-        literal_vector m_lits;
-        vector_pool    m_pool;
+        scoped_ptr_vector<shared_pool> m_pools;
         mutex          m_mux;
 
         // for exchange with local search:
@@ -71,6 +78,7 @@ namespace sat {
         scoped_limits      m_scoped_rlimit;
         vector<reslimit>   m_limits;
         ptr_vector<solver> m_solvers;
+        scoped_ptr_vector<params_ref> m_solver_params;
         
     public:
 
@@ -82,10 +90,14 @@ namespace sat {
 
         void init_solvers(solver& s, unsigned num_extra_solvers);
 
+        void reserve_solvers(solver& s, unsigned num_extra_solvers);
+
+        void init_solver(solver const& s, unsigned i);
+
         void push_child(reslimit& rl);
 
         // reserve space
-        void reserve(unsigned num_owners, unsigned sz) { m_pool.reserve(num_owners, sz); }
+        void reserve(unsigned num_owners, unsigned sz);
 
         solver& get_solver(unsigned i) { return *m_solvers[i]; }
 
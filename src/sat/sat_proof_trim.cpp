@@ -28,6 +28,9 @@ namespace sat {
     */        
 
     vector<std::pair<unsigned, unsigned_vector>> proof_trim::trim() {
+        stopwatch sw;
+        sw.start();
+        unsigned num_steps = m_trail.size();
         m_result.reset();
         m_propagated.resize(num_vars(), false);
 
@@ -61,6 +64,11 @@ namespace sat {
             conflict_analysis_core(cl, clp);            
         }
         m_result.reverse();
+        sw.stop();
+        IF_VERBOSE(1, verbose_stream() << "(sat.proof-trim :steps " << num_steps 
+                   << " :core " << m_result.size() 
+                   << " :seconds " << sw.get_seconds()
+                   << " :steps/sec " << (sw.get_seconds() > 0 ? num_steps / sw.get_seconds() : 0.0) << ")\n");
         return m_result;
     }
     
@@ -77,9 +85,8 @@ namespace sat {
      * Remove all clauses after cl that are in the cone of influence of cl.
      * The coi is defined inductively: C is in coi of cl if it contains ~l
      * or it contains ~l' where l' is implied by a clause in the coi of cl.
-     * Possible optimization: 
-     * - check if clause contains a literal that is on implied on the trail
-     *   if it doesn't contain any such literal, bypass the trail adjustment.
+     * If cl contains no literal that is implied on the trail, the trail
+     * is unchanged and the scan over it is bypassed.
      */
 
     void proof_trim::prune_trail(literal_vector const& cl, clause* cp) {
@@ -91,6 +98,13 @@ namespace sat {
         if (cl.empty())
             return;
 
+        if (all_of(cl, [&](literal lit) { return s.value(lit) != l_true; })) {
+            s.m_inconsistent = false; 
+            s.m_qhead = s.m_trail.size();
+            s.propagate(false);
+            return;
+        }
+
         for (literal lit : cl) 
             m_in_clause.insert(lit.index());
 
@@ -1913,6 +1913,137 @@ namespace sat {
         }
     }
 
+    /**
+       \brief index of a ternary clause in cs that contains a and b, or UINT_MAX.
+    */
+    unsigned simplifier::find_ternary(clause_wrapper_vector const& cs, literal a, literal b) const {
+        for (unsigned i = 0; i < cs.size(); ++i) 
+            if (cs[i].size() == 3 && cs[i].contains(a) && cs[i].contains(b))
+                return i;
+        return UINT_MAX;
+    }
+
+    /**
+       \brief l <-> a_1 & .. & a_n is defined by the binary clauses ~l | a_i 
+       and the clause l | ~a_1 | .. | ~a_n. For n = 1 this is an equivalence.
+       l_cls contains the clauses with l and nl_cls the clauses with ~l.
+    */
+    bool simplifier::find_and_gate(literal l, clause_wrapper_vector const& l_cls, clause_wrapper_vector const& nl_cls, bool_vector& l_gate, bool_vector& nl_gate) {
+        s.init_visited();
+        for (auto const& c : nl_cls) 
+            if (c.size() == 2)
+                s.mark_visited(c[0] == ~l ? c[1] : c[0]);
+        for (unsigned i = 0; i < l_cls.size(); ++i) {
+            auto const& c = l_cls[i];
+            bool is_gate = true;
+            for (literal x : c)
+                if (x != l && !s.is_visited(~x)) {
+                    is_gate = false;
+                    break;
+                }
+            if (!is_gate)
+                continue;
+            l_gate[i] = true;
+            for (unsigned j = 0; j < nl_cls.size(); ++j) {
+                auto const& d = nl_cls[j];
+                if (d.size() == 2 && c.contains(~(d[0] == ~l ? d[1] : d[0])))
+                    nl_gate[j] = true;
+            }
+            return true;
+        }
+        return false;
+    }
+
+    /**
+       \brief v <-> ite(c, t, e) is defined by 
+       ~v | ~c | t,  ~v | c | e,  v | ~c | ~t,  v | c | ~e.
+       A negated output is the same gate with t and e negated.
+    */
+    bool simplifier::find_ite_gate(bool_var v) {
+        literal neg_l(v, true);
+        for (unsigned i = 0; i < m_neg_cls.size(); ++i) {
+            auto const& c1 = m_neg_cls[i];
+            if (c1.size() != 3)
+                continue;
+            for (literal nc : c1) {
+                if (nc == neg_l)
+                    continue;
+                literal c = ~nc, t = null_literal;
+                for (literal x : c1)
+                    if (x != neg_l && x != nc)
+                        t = x;
+                for (unsigned j = 0; j < m_neg_cls.size(); ++j) {
+                    auto const& c2 = m_neg_cls[j];
+                    if (c2.size() != 3 || !c2.contains(c))
+                        continue;
+                    literal e = null_literal;
+                    for (literal x : c2)
+                        if (x != neg_l && x != c)
+                            e = x;
+                    unsigned k1 = find_ternary(m_pos_cls, nc, ~t);
+                    unsigned k2 = find_ternary(m_pos_cls, c, ~e);
+                    if (k1 == UINT_MAX || k2 == UINT_MAX)
+                        continue;
+                    m_neg_gate[i] = m_neg_gate[j] = true;
+                    m_pos_gate[k1] = m_pos_gate[k2] = true;
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    /**
+       \brief v <-> (x <-> y) is defined by 
+       v | x | y,  v | ~x | ~y,  ~v | ~x | y,  ~v | x | ~y.
+    */
+    bool simplifier::find_xor_gate(bool_var v) {
+        for (unsigned i = 0; i < m_pos_cls.size(); ++i) {
+            auto const& c = m_pos_cls[i];
+            if (c.size() != 3)
+                continue;
+            literal x = null_literal, y = null_literal;
+            for (literal z : c) {
+                if (z.var() == v)
+                    continue;
+                if (x == null_literal)
+                    x = z;
+                else
+                    y = z;
+            }
+            unsigned i2 = find_ternary(m_pos_cls, ~x, ~y);
+            unsigned j1 = find_ternary(m_neg_cls, ~x, y);
+            unsigned j2 = find_ternary(m_neg_cls, x, ~y);
+            if (i2 == UINT_MAX || j1 == UINT_MAX || j2 == UINT_MAX)
+                continue;
+            m_pos_gate[i] = m_pos_gate[i2] = true;
+            m_neg_gate[j1] = m_neg_gate[j2] = true;
+            return true;
+        }
+        return false;
+    }
+
+    /**
+       \brief find a definition of v among its clauses and mark the clauses 
+       that belong to it. When v is defined by a gate it suffices to resolve
+       gate clauses with the other clauses: resolvents of two gate clauses are
+       tautologies and resolvents of two other clauses are implied by the rest
+       (Een and Biere, SAT 2005).
+    */
+    bool simplifier::find_gate(bool_var v) {
+        literal pos_l(v, false);
+        literal neg_l(v, true);
+        m_pos_gate.reset();
+        m_neg_gate.reset();
+        m_pos_gate.resize(m_pos_cls.size(), false);
+        m_neg_gate.resize(m_neg_cls.size(), false);
+        return 
+            find_and_gate(pos_l, m_pos_cls, m_neg_cls, m_pos_gate, m_neg_gate) ||
+            find_and_gate(neg_l, m_neg_cls, m_pos_cls, m_neg_gate, m_pos_gate) ||
+            find_ite_gate(v) ||
+            find_xor_gate(v);
+    }
+
     bool simplifier::try_eliminate(bool_var v) {
         if (value(v) != l_undef)
             return false;
@@ -1959,11 +2090,17 @@ namespace sat {
         collect_clauses(pos_l, m_pos_cls);
         collect_clauses(neg_l, m_neg_cls);
 
+        bool has_gate = find_gate(v);
+
         TRACE("sat_simplifier", tout << "collecting number of after_clauses\n";);
         unsigned before_clauses = num_pos + num_neg;
         unsigned after_clauses  = 0;
-        for (clause_wrapper& c1 : m_pos_cls) {
-            for (clause_wrapper& c2 : m_neg_cls) {
+        for (unsigned i = 0; i < m_pos_cls.size(); ++i) {
+            clause_wrapper& c1 = m_pos_cls[i];
+            for (unsigned j = 0; j < m_neg_cls.size(); ++j) {
+                clause_wrapper& c2 = m_neg_cls[j];
+                if (has_gate && m_pos_gate[i] == m_neg_gate[j])
+                    continue;
                 m_new_cls.reset();
                 if (resolve(c1, c2, pos_l, m_new_cls)) {
                     TRACE("sat_simplifier", tout << c1 << "\n" << c2 << "\n-->\n";
@@ -1990,6 +2127,8 @@ namespace sat {
 
         // eliminate variable
         ++s.m_stats.m_elim_var_res;
+        if (has_gate)
+            ++m_num_elim_gates;
         VERIFY(!is_external(v));
         model_converter::entry & mc_entry = s.m_mc.mk(model_converter::ELIM_VAR, v);
         save_clauses(mc_entry, m_pos_cls);
@@ -1997,10 +2136,14 @@ namespace sat {
         s.set_eliminated(v, true);
         m_elim_counter -= num_pos * num_neg + before_lits;
 
-        for (auto & c1 : m_pos_cls) {
+        for (unsigned i = 0; i < m_pos_cls.size(); ++i) {
+            auto & c1 = m_pos_cls[i];
             if (c1.was_removed() && !c1.contains(pos_l))
                 continue;
-            for (auto & c2 : m_neg_cls) {
+            for (unsigned j = 0; j < m_neg_cls.size(); ++j) {
+                auto & c2 = m_neg_cls[j];
+                if (has_gate && m_pos_gate[i] == m_neg_gate[j])
+                    continue;
                 m_new_cls.reset();
                 if (!resolve(c1, c2, pos_l, m_new_cls))
                     continue;                
@@ -2099,6 +2242,8 @@ namespace sat {
         m_pos_cls.finalize();
         m_neg_cls.finalize();
         m_new_cls.finalize();
+        m_pos_gate.finalize();
+        m_neg_gate.finalize();
     }
 
     void simplifier::updt_params(params_ref const & _p) {
@@ -2145,6 +2290,7 @@ namespace sat {
         st.update("sat abce", m_num_abce);
         st.update("sat bca",  m_num_bca);
         st.update("sat ate",  m_num_ate);
+        st.update("sat elim gates", m_num_elim_gates);
     }
 
     void simplifier::reset_statistics() {
@@ -2156,6 +2302,7 @@ namespace sat {
         m_num_sub_res = 0;
         m_num_elim_lits = 0;
         m_num_elim_vars = 0;
+        m_num_elim_gates = 0;
         m_num_bca = 0;
         m_num_ate = 0;
     }
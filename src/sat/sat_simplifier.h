@@ -117,6 +117,7 @@ namespace sat {
         unsigned               m_num_elim_vars;
         unsigned               m_num_sub_res;
         unsigned               m_num_elim_lits;
+        unsigned               m_num_elim_gates;
 
         bool                   m_learned_in_use_lists;
         unsigned               m_old_num_elim_vars;
@@ -197,7 +198,14 @@ namespace sat {
         void collect_clauses(literal l, clause_wrapper_vector & r);
         clause_wrapper_vector m_pos_cls;
         clause_wrapper_vector m_neg_cls;
+        bool_vector           m_pos_gate;      // m_pos_cls[i] belongs to the definition of the eliminated variable
+        bool_vector           m_neg_gate;
         literal_vector m_new_cls;
+        unsigned find_ternary(clause_wrapper_vector const& cs, literal a, literal b) const;
+        bool find_and_gate(literal l, clause_wrapper_vector const& l_cls, clause_wrapper_vector const& nl_cls, bool_vector& l_gate, bool_vector& nl_gate);
+        bool find_ite_gate(bool_var v);
+        bool find_xor_gate(bool_var v);
+        bool find_gate(bool_var v);
         bool resolve(clause_wrapper const & c1, clause_wrapper const & c2, literal l, literal_vector & r);
         void save_clauses(model_converter::entry & mc_entry, clause_wrapper_vector const & cs);
         void add_non_learned_binary_clause(literal l1, literal l2);
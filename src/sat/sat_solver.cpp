@@ -18,14 +18,20 @@ Revision History:
 --*/
 
 
+#include <climits>
 #include <cmath>
+#include <fstream>
+#include <sstream>
 #ifndef SINGLE_THREAD
 #include <thread>
+#include <mutex>
+#include <condition_variable>
 #endif
 #include "util/luby.h"
 #include "util/trace.h"
 #include "util/max_cliques.h"
 #include "util/gparams.h"
+#include "util/prefetch.h"
 #include "sat/sat_solver.h"
 #include "sat/sat_integrity_checker.h"
 #include "sat/sat_lookahead.h"
@@ -33,14 +39,10 @@ Revision History:
 #include "sat/sat_prob.h"
 #include "sat/sat_anf_simplifier.h"
 #include "sat/sat_cut_simplifier.h"
-#if defined(_MSC_VER) && !defined(_M_ARM) && !defined(_M_ARM64)
-# include <xmmintrin.h>
-#endif
 
 
 namespace sat {
 
-
     solver::solver(params_ref const & p, reslimit& l):
         solver_core(l),
         m_checkpoint_enabled(true),
@@ -208,19 +210,14 @@ namespace sat {
         {
             literal_vector buffer;
             // copy clauses
-            for (clause* c : src.m_clauses) {
-                buffer.reset();
-                for (literal l : *c) buffer.push_back(l);
-                mk_clause_core(buffer);
-            }
+            for (clause* c : src.m_clauses) 
+                copy_clause(*c, buffer, sat::status::asserted());
 
             // copy high quality lemmas
             unsigned num_learned = 0;
             for (clause* c : src.m_learned) {
                 if (c->glue() <= 2 || (c->size() <= 40 && c->glue() <= 8) || copy_learned) {
-                    buffer.reset();
-                    for (literal l : *c) buffer.push_back(l);
-                    clause* c1 = mk_clause_core(buffer.size(), buffer.data(), sat::status::redundant());
+                    clause* c1 = copy_clause(*c, buffer, sat::status::redundant());
                     if (c1) {
                         ++num_learned;
                         c1->set_glue(c->glue());
@@ -245,6 +242,48 @@ namespace sat {
         m_stats.m_units = init_trail_size();
     }
 
+    /**
+       \brief add a clause of a solver that is being copied.
+
+       Clauses of a solver are free of duplicate and complementary literals,
+       so unlike mk_clause_core there is no need to sort them. Only literals
+       assigned by the units copied so far are removed. The literal order,
+       and thereby the watched literals of the source, is preserved.
+     */
+    clause * solver::copy_clause(clause const& c, literal_vector& buffer, sat::status st) {
+        SASSERT(at_base_lvl());
+        buffer.reset();
+        for (literal l : c) {
+            switch (m_trim ? l_undef : value(l)) {
+            case l_true:
+                return nullptr;
+            case l_false:
+                break;
+            case l_undef:
+                buffer.push_back(l);
+                break;
+            }
+        }
+        switch (buffer.size()) {
+        case 0:
+            set_conflict();
+            return nullptr;
+        case 1:
+            if (m_config.m_drat)
+                drat_log_clause(1, buffer.data(), st);
+            {
+                flet<bool> _disable_drat(m_config.m_drat, false);
+                assign(buffer[0], justification(0));
+            }
+            return nullptr;
+        case 2:
+            mk_bin_clause(buffer[0], buffer[1], st);
+            return nullptr;
+        default:
+            return mk_nary_clause(buffer.size(), buffer.data(), st);
+        }
+    }
+
     // -----------------------
     //
     // Variable & Clause creation
@@ -661,10 +700,11 @@ namespace sat {
     }
 
     void solver::defrag_clauses() {
-        m_defrag_threshold = 2;
+        m_defrag_threshold = m_config.m_gc_defrag_interval;
         if (memory_pressure()) return;
         pop(scope_lvl());
-        IF_VERBOSE(2, verbose_stream() << "(sat-defrag)\n");
+        m_stats.m_defrag++;
+        size_t old_size = cls_allocator().get_allocation_size();
         clause_allocator& alloc = m_cls_allocator[!m_cls_allocator_idx];
         ptr_vector<clause> new_clauses, new_learned;
         for (clause* c : m_clauses) c->unmark_used();
@@ -723,6 +763,7 @@ namespace sat {
 
         cls_allocator().finalize();
         m_cls_allocator_idx = !m_cls_allocator_idx;
+        IF_VERBOSE(2, verbose_stream() << "(sat-defrag :bytes " << old_size << " -> " << cls_allocator().get_allocation_size() << ")\n");
 
         reinit_assumptions();
     }
@@ -904,6 +945,7 @@ namespace sat {
         
         switch (m_config.m_branching_heuristic) {
         case BH_VSIDS: 
+        case BH_VMTF:
             break;
         case BH_CHB:
             m_last_propagation[v] = m_stats.m_conflict;
@@ -920,15 +962,8 @@ namespace sat {
             }
         }
         
-        if (m_config.m_propagate_prefetch) {
-#if defined(__GNUC__) || defined(__clang__)
-            __builtin_prefetch((const char*)((m_watches[l.index()].data())));
-#else
-    #if !defined(_M_ARM) && !defined(_M_ARM64)
-            _mm_prefetch((const char*)((m_watches[l.index()].data())), _MM_HINT_T1);
-    #endif
-#endif
-        }
+        if (m_config.m_propagate_prefetch) 
+            prefetch_address(m_watches[l.index()].data());
 
         SASSERT(!l.sign() || !m_phase[v]);
         SASSERT(l.sign()  || m_phase[v]);
@@ -1061,6 +1096,9 @@ namespace sat {
                 }
                 clause_offset cls_off = it->get_clause_offset();
                 clause& c = get_clause(cls_off);
+                // fetch the header of the next watched clause while this one is visited.
+                if (m_config.m_propagate_prefetch && it + 1 != end && (it + 1)->is_clause())
+                    prefetch_address(&get_clause((it + 1)->get_clause_offset()));
                 TRACE("propagate_clause_bug", tout << "processing... " << c << "\nwas_removed: " << c.was_removed() << "\n";);
                 if (c[0] == not_l)
                     std::swap(c[0], c[1]);
@@ -1090,25 +1128,36 @@ namespace sat {
                 unsigned num_undef = 0;
                 unsigned sz = c.size();
 
+                // The scan for a replacement watch only inspects literal values.
+                // Levels are needed only when the clause becomes unit or conflicting,
+                // so they are computed in a second pass for those cases.
                 for (unsigned i = 2; i < sz && num_undef <= 1; ++i) {
                     literal lit = c[i];
-                    switch (value(lit)) {
-                    case l_true:
+                    lbool val = value(lit);
+                    if (val == l_true) {
                         it2->set_clause(lit, cls_off);
                         it2++;
                         goto end_clause_case;
-                    case l_undef:
+                    }
+                    if (val == l_undef) {
                         undef_index = i;
                         ++num_undef;
-                        break;
-                    case l_false: {
+                    }
+                }
+
+                if (undef_index != 0 && (num_undef > 1 || value(c[0]) != l_false)) {
+                    set_watch(c, undef_index, cls_off);
+                    goto end_clause_case;
+                }
+
+                for (unsigned i = 2; i < sz; ++i) {
+                    literal lit = c[i];
+                    if (value(lit) == l_false) {
                         unsigned level = lvl(lit);
                         if (level > assign_level) {
                             assign_level = level;
                             max_index = i;
                         }
-                        break;
-                    }
                     }
                 }
 
@@ -1116,11 +1165,10 @@ namespace sat {
                     assign_level = std::max(assign_level, lvl(c[0]));
 
                 if (undef_index != 0) {       
+                    SASSERT(value(c[0]) == l_false && num_undef == 1);
                     set_watch(c, undef_index, cls_off);
-                    if (value(c[0]) == l_false && num_undef == 1) {   
-                        std::swap(c[0], c[1]);
-                        propagate_clause(c, update, assign_level, cls_off);
-                    }
+                    std::swap(c[0], c[1]);
+                    propagate_clause(c, update, assign_level, cls_off);
                     goto end_clause_case;
                 }
 
@@ -1251,6 +1299,17 @@ namespace sat {
             SASSERT(scope_lvl() == 0);
             return check_par(num_lits, lits);
         }
+        if (!use_clause_cache())
+            return check_core(num_lits, lits);
+        uint64_t key = clause_cache_key();
+        unsigned nv = num_vars(), nc = m_clauses.size();
+        load_clause_cache(key, nv, nc);
+        lbool r = check_core(num_lits, lits);
+        save_clause_cache(key, nv, nc);
+        return r;
+    }
+
+    lbool solver::check_core(unsigned num_lits, literal const* lits) {
         flet<bool> _searching(m_searching, true);
         m_clone = nullptr;
         if (m_mc.empty() && gparams::get_ref().get_bool("model_validate", false)) {
@@ -1316,6 +1375,129 @@ namespace sat {
         }
     }
 
+    // -----------------------
+    //
+    // On-disk cache of learned clauses
+    //
+    // The cache file of a clause set records the number of variables and
+    // clauses it was computed for, followed by units and clauses in DIMACS
+    // notation. Learned clauses are implied by the clause set, so they can be
+    // added when the same clause set, over the same variable numbering, is
+    // solved again.
+    //
+    // -----------------------
+
+    bool solver::use_clause_cache() const {
+        return m_config.m_clause_cache.is_non_empty_string() &&
+            !m_ext && !m_par && !m_config.m_drat && !m_config.m_binspr && m_user_scope_literals.empty() && !inconsistent();
+    }
+
+    uint64_t solver::clause_cache_key() const {
+        SASSERT(at_base_lvl());
+        uint64_t h = 14695981039346656037ull;
+        auto add = [&](uint64_t x) { h = (h ^ x) * 1099511628211ull; };
+        add(num_vars());
+        for (unsigned i = 0; i < init_trail_size(); ++i)
+            add(m_trail[i].index());
+        unsigned l_idx = 0;
+        for (watch_list const& wlist : m_watches) {
+            literal l = ~to_literal(l_idx++);
+            for (watched const& w : wlist) 
+                if (w.is_binary_non_learned_clause() && l.index() < w.get_literal().index()) {
+                    add(l.index());
+                    add(w.get_literal().index());
+                }
+        }
+        for (clause const* c : m_clauses) {
+            add(c->size());
+            for (literal l : *c)
+                add(l.index());
+        }
+        return h;
+    }
+
+    std::string solver::clause_cache_file(uint64_t key) const {
+        std::stringstream strm;
+        strm << m_config.m_clause_cache << "_" << std::hex << key << ".cnf";
+        return strm.str();
+    }
+
+    void solver::load_clause_cache(uint64_t key, unsigned num_vars0, unsigned num_clauses0) {
+        std::ifstream in(clause_cache_file(key));
+        if (!in)
+            return;
+        unsigned nv = 0, nc = 0;
+        if (!(in >> nv >> nc) || nv != num_vars0 || nc != num_clauses0)
+            return;
+        unsigned num_loaded = 0;
+        literal_vector lits;
+        int n;
+        bool ok = true;
+        while (in >> n && !inconsistent()) {
+            if (n != 0) {
+                // the file is untrusted: check the range before mapping n to a literal
+                if (n == INT_MIN || static_cast<unsigned>(n < 0 ? -n : n) > num_vars())
+                    ok = false;
+                else
+                    lits.push_back(literal(static_cast<bool_var>(n < 0 ? -n : n) - 1, n < 0));
+                continue;
+            }
+            ok &= !lits.empty();
+            for (literal l : lits)
+                ok &= !was_eliminated(l.var());
+            unsigned sz = lits.size();
+            if (ok && simplify_clause(sz, lits.data())) {
+                mk_clause_core(sz, lits.data(), sat::status::redundant());
+                ++num_loaded;
+            }
+            lits.reset();
+            ok = true;
+        }
+        IF_VERBOSE(2, verbose_stream() << "(sat.clause-cache :loaded " << num_loaded << ")\n");
+    }
+
+    void solver::save_clause_cache(uint64_t key, unsigned num_vars0, unsigned num_clauses0) {
+        unsigned const max_saved = 100000;
+        std::ofstream out(clause_cache_file(key));
+        if (!out) {
+            IF_VERBOSE(0, verbose_stream() << "could not open clause cache " << clause_cache_file(key) << "\n");
+            return;
+        }
+        unsigned num_saved = 0;
+        auto ok = [&](literal l) { return !was_eliminated(l.var()); };
+        auto save = [&](unsigned sz, literal const* lits) {
+            for (unsigned i = 0; i < sz; ++i)
+                out << (lits[i].sign() ? -static_cast<int>(lits[i].var() + 1) : static_cast<int>(lits[i].var() + 1)) << " ";
+            out << "0\n";
+            ++num_saved;
+        };
+        // the key was computed on the clause set at the start of the check.
+        // record its dimensions, so that a load can reject a hash collision.
+        out << num_vars0 << " " << num_clauses0 << "\n";
+        for (unsigned i = 0; i < init_trail_size(); ++i) 
+            if (ok(m_trail[i]))
+                save(1, m_trail.data() + i);
+        unsigned l_idx = 0;
+        for (watch_list const& wlist : m_watches) {
+            literal l = ~to_literal(l_idx++);
+            for (watched const& w : wlist) {
+                literal l2 = w.get_literal();
+                if (num_saved < max_saved && w.is_binary_learned_clause() && l.index() < l2.index() && ok(l) && ok(l2)) {
+                    literal lits[2] = { l, l2 };
+                    save(2, lits);
+                }
+            }
+        }
+        for (clause const* c : m_learned) {
+            if (num_saved >= max_saved)
+                break;
+            if (c->glue() > 2 || c->was_removed() || !std::all_of(c->begin(), c->end(), ok))
+                continue;
+            save(c->size(), c->begin());
+        }
+        IF_VERBOSE(2, verbose_stream() << "(sat.clause-cache :saved " << num_saved << ")\n");
+    }
+
     bool solver::should_cancel() {
         if (limit_reached() || memory_exceeded() || m_solver_canceled) {
             return true;
@@ -1467,7 +1649,7 @@ namespace sat {
             return l_undef;
 
 
-        int num_extra_solvers = m_config.m_num_threads - 1;
+        int num_extra_solvers = static_cast<int>(get_num_threads(m_config.m_num_threads)) - 1;
         int num_local_search  = static_cast<int>(m_config.m_local_search_threads);
         int num_ddfw      = m_ext ? 0 : static_cast<int>(m_config.m_ddfw_threads);
         int num_threads = num_extra_solvers + 1 + num_local_search + num_ddfw;        
@@ -1500,7 +1682,16 @@ namespace sat {
 
         sat::parallel par(*this);
         par.reserve(num_threads, 1 << 12);
-        par.init_solvers(*this, num_extra_solvers);
+        // without extensions the copies are created by their own threads, so that
+        // their clauses and watch lists are allocated in memory local to the thread.
+        // The main solver waits for the copies before it starts searching.
+        bool copy_in_threads = !m_ext;
+        if (copy_in_threads)
+            par.reserve_solvers(*this, num_extra_solvers);
+        else
+            par.init_solvers(*this, num_extra_solvers);
+        int num_copied = 0;
+        std::condition_variable copied;
         for (unsigned i = 0; i < ls.size(); ++i) {
             par.push_child(ls[i]->rlimit());
         }
@@ -1518,9 +1709,30 @@ namespace sat {
         bool canceled = false;
         std::mutex mux;
 
+        auto copy_done = [&]() {
+            std::lock_guard<std::mutex> lock(mux);
+            ++num_copied;
+            copied.notify_all();
+        };
+
         auto worker_thread = [&](int i) {
+            pin_thread(i);
             try {
                 lbool r = l_undef;
+                if (IS_AUX_SOLVER(i) && copy_in_threads) {
+                    try {
+                        par.init_solver(*this, i);
+                    }
+                    catch (...) {
+                        copy_done();
+                        throw;
+                    }
+                    copy_done();
+                }
+                if (IS_MAIN_SOLVER(i) && copy_in_threads) {
+                    std::unique_lock<std::mutex> lock(mux);
+                    copied.wait(lock, [&]() { return num_copied == num_extra_solvers; });
+                }
                 if (IS_AUX_SOLVER(i)) {
                     r = par.get_solver(i).check(num_lits, lits);
                 }
@@ -1598,8 +1810,10 @@ namespace sat {
         if (!canceled) {
             rlimit().reset_cancel();
         }
-        par.reset();
         set_par(nullptr, 0);
+        if (result == l_false && rlimit().inc())
+            keep_par_lemmas(par, num_extra_solvers);
+        par.reset();
         ls.reset();
         uw.reset();
         if (finished_id == -1) {
@@ -1611,6 +1825,56 @@ namespace sat {
         return result;
 
     }
+
+    /**
+       \brief the extra solvers are recreated for every check.
+       Their best learned clauses are added to the main solver, so that the copies
+       of the next incremental check start from them. Clauses the main solver
+       already has or that were copied into several solvers are added once.
+       The lemmas are added while the variables of the current user scopes are live,
+       so they are removed together with the other learned clauses over these variables on pop.
+    */
+    void solver::keep_par_lemmas(parallel& par, unsigned num_extra_solvers) {
+        unsigned max_num = m_config.m_par_keep_lemmas;
+        if (max_num == 0 || num_extra_solvers == 0 || inconsistent())
+            return;
+        literal_vector tmp;
+        auto clause_hash = [&](unsigned n, literal const* lits) {
+            tmp.reset();
+            tmp.append(n, lits);
+            std::sort(tmp.begin(), tmp.end());
+            uint64_t h = 14695981039346656037ull;
+            for (literal l : tmp)
+                h = (h ^ l.index()) * 1099511628211ull;
+            return h;
+        };
+        hashtable<uint64_t, u64_hash, default_eq<uint64_t>> seen;
+        svector<bin_clause> bins;
+        collect_bin_clauses(bins, true, false);
+        for (auto const& b : bins) {
+            literal lits[2] = { b.first, b.second };
+            seen.insert(clause_hash(2, lits));
+        }
+        for (clause* c : m_learned)
+            seen.insert(clause_hash(c->size(), c->begin()));
+        
+        unsigned num_kept = 0;
+        unsigned max_per_solver = std::max(1u, max_num / num_extra_solvers);
+        for (unsigned i = 0; i < num_extra_solvers && num_kept < max_num && !inconsistent(); ++i) {
+            vector<literal_vector> lemmas;
+            unsigned_vector glue;
+            par.get_solver(i).export_learned(max_per_solver, lemmas, glue);
+            for (unsigned j = 0; j < lemmas.size() && num_kept < max_num && !inconsistent(); ++j) {
+                uint64_t h = clause_hash(lemmas[j].size(), lemmas[j].data());
+                if (seen.contains(h))
+                    continue;
+                seen.insert(h);
+                import_learned(lemmas[j], glue[j]);
+                ++num_kept;
+            }
+        }
+        IF_VERBOSE(2, verbose_stream() << "(sat-parallel :kept-lemmas " << num_kept << ")\n";);
+    }
 #endif
 
     /*
@@ -1984,7 +2248,7 @@ namespace sat {
         m_restart_threshold       = m_config.m_restart_initial;
         m_luby_idx                = 1;
         m_gc_threshold            = m_config.m_gc_initial;
-        m_defrag_threshold        = 2;
+        m_defrag_threshold        = m_config.m_gc_defrag_interval;
         m_restarts                = 0;
         m_last_position_log       = 0;
         m_restart_logs            = 0;
@@ -2010,6 +2274,42 @@ namespace sat {
         TRACE("sat", display(tout););
     }
 
+    /**
+       \brief run an optional inprocessing pass unless it is backed off.
+       The yield of a pass is the number of clauses it removed plus the
+       number of units it found. Its work is the number of propagations
+       and resource limit ticks it takes, so that the backoff does not depend
+       on the speed of the machine. A pass that yields less than
+       sat.inprocess.min_yield per 1000 units of work doubles its delay, up to
+       sat.inprocess.max_delay rounds. A productive pass resets it.
+    */
+    template<typename F>
+    void solver::inprocess(inprocess_pass& p, F const& f) {
+        if (p.m_skip > 0) {
+            --p.m_skip;
+            m_stats.m_inprocess_skipped++;
+            IF_VERBOSE(3, verbose_stream() << "(sat.inprocess :skip " << p.m_name << " :delay " << p.m_delay << ")\n";);
+            return;
+        }
+        unsigned trail_before = m_trail.size();
+        unsigned cls_before = num_clauses() - trail_before;
+        unsigned propagate_before = m_stats.m_propagate;
+        uint64_t ticks_before = m_rlimit.count();
+        f();
+        if (m_config.m_inprocess_max_delay == 0 || inconsistent())
+            return;
+        unsigned trail_after = m_trail.size();
+        unsigned cls_after = num_clauses() - trail_after;
+        double yield = (cls_before > cls_after ? cls_before - cls_after : 0) + (trail_after - trail_before);
+        double work = std::max(1.0, static_cast<double>(m_stats.m_propagate - propagate_before + (m_rlimit.count() - ticks_before)) / 1000);
+        if (yield >= m_config.m_inprocess_min_yield * work)
+            p.m_delay = 0;
+        else
+            p.m_delay = std::min(m_config.m_inprocess_max_delay, 2 * p.m_delay + 1);
+        p.m_skip = p.m_delay;
+        IF_VERBOSE(3, verbose_stream() << "(sat.inprocess " << p.m_name << " :yield " << yield << " :work " << work << " :delay " << p.m_delay << ")\n";);
+    }
+
     bool solver::should_simplify() const {
         return m_conflicts_since_init >= m_next_simplify && m_simplify_enabled;
     }
@@ -2071,15 +2371,17 @@ namespace sat {
             m_ext->simplify();
         }
 
-        m_probing();
+        inprocess(m_probing_pass, [&]() { m_probing(); });
         CASSERT("sat_missed_prop", check_missed_propagation());
         CASSERT("sat_simplify_bug", check_invariant());
         m_asymm_branch(false);
 
         if (m_config.m_lookahead_simplify && !m_ext) {
-            lookahead lh(*this);
-            lh.simplify(true);
-            lh.collect_statistics(m_aux_stats);
+            inprocess(m_lookahead_pass, [&]() {
+                lookahead lh(*this);
+                lh.simplify(true);
+                lh.collect_statistics(m_aux_stats);
+            });
         }
 
         reinit_assumptions();
@@ -2100,20 +2402,21 @@ namespace sat {
         }
 
         if (m_config.m_binspr && !inconsistent()) {
-            m_binspr();
+            inprocess(m_binspr_pass, [&]() { m_binspr(); });
         }
 
         if (m_config.m_anf_simplify && m_simplifications > m_config.m_anf_delay && !inconsistent()) {
-            anf_simplifier anf(*this);
-            anf_simplifier::config cfg;
-            cfg.m_enable_exlin = m_config.m_anf_exlin;
-            anf();
-            anf.collect_statistics(m_aux_stats);
-            // TBD: throttle anf_delay based on yield
+            inprocess(m_anf_pass, [&]() {
+                anf_simplifier anf(*this);
+                anf_simplifier::config cfg;
+                cfg.m_enable_exlin = m_config.m_anf_exlin;
+                anf();
+                anf.collect_statistics(m_aux_stats);
+            });
         }
         
         if (m_cut_simplifier && m_simplifications > m_config.m_cut_delay && !inconsistent()) {
-            (*m_cut_simplifier)();
+            inprocess(m_cut_pass, [&]() { (*m_cut_simplifier)(); });
         }
 
         if (m_config.m_inprocess_out.is_non_empty_string()) {
@@ -2272,7 +2575,7 @@ namespace sat {
         if (m_conflicts_since_restart <= m_restart_threshold) return false;
         if (scope_lvl() < 2 + search_lvl()) return false;
         if (m_case_split_queue.empty()) return false;
-        if (m_config.m_restart != RS_EMA) return true;
+        if (m_config.m_restart != RS_EMA || use_stable_restarts()) return true;
         return 
             m_fast_glue_avg + search_lvl() <= scope_lvl() && 
             m_config.m_restart_margin * m_slow_glue_avg <= m_fast_glue_avg;
@@ -2394,6 +2697,15 @@ namespace sat {
         set_activity(v, new_act);
     }
 
+    /**
+       \brief while searching for a model, the glue averages are not a useful
+       restart signal. The sat phase uses reluctant doubling (Luby) restarts
+       and the unsat phase uses the ema of glues.
+    */
+    bool solver::use_stable_restarts() const {
+        return m_config.m_restart == RS_EMA && m_config.m_restart_stable_unit > 0 && is_sat_phase();
+    }
+
     void solver::set_next_restart() {
         m_conflicts_since_restart = 0;
         switch (m_config.m_restart) {
@@ -2405,7 +2717,12 @@ namespace sat {
             m_restart_threshold = m_config.m_restart_initial * get_luby(m_luby_idx);
             break;
         case RS_EMA:
-            m_restart_threshold = m_config.m_restart_initial;
+            if (use_stable_restarts()) {
+                m_luby_idx++;
+                m_restart_threshold = m_config.m_restart_stable_unit * get_luby(m_luby_idx);
+            }
+            else 
+                m_restart_threshold = m_config.m_restart_initial;
             break;
         case RS_STATIC:
             break;
@@ -2661,9 +2978,16 @@ namespace sat {
     }
 
     bool solver::use_backjumping(unsigned num_scopes) const {
+        if (num_scopes == 0)
+            return false;
+        if (!allow_backtracking())
+            return true;
+        if (num_scopes > m_config.m_backtrack_scopes)
+            return false;
+        // a jump over few scopes can still undo a long stretch of the trail.
         return 
-            num_scopes > 0 && 
-            (num_scopes <= m_config.m_backtrack_scopes || !allow_backtracking());
+            m_config.m_backtrack_assignments == 0 ||
+            m_trail.size() - m_scopes[m_scope_lvl - num_scopes].m_trail_lim <= m_config.m_backtrack_assignments;
     }
 
     bool solver::allow_backtracking() const {
@@ -2879,6 +3203,7 @@ namespace sat {
             mark(var);
             switch (m_config.m_branching_heuristic) {
             case BH_VSIDS:
+            case BH_VMTF:
                 inc_activity(var);
                 break;
             case BH_CHB:
@@ -2968,6 +3293,10 @@ namespace sat {
         }
 
         m_phase_counter = 0;
+        if (m_config.m_restart == RS_EMA) {
+            m_luby_idx = 0;
+            set_next_restart();
+        }
     }
 
     bool solver::should_rephase() {
@@ -3769,6 +4098,7 @@ namespace sat {
         m_fast_glue_backup.set_alpha(m_config.m_fast_glue_avg);
         m_slow_glue_backup.set_alpha(m_config.m_slow_glue_avg);
         m_trail_avg.set_alpha(m_config.m_slow_glue_avg);
+        m_case_split_queue.set_vmtf(m_config.m_branching_heuristic == BH_VMTF, num_vars());
 
         if (m_config.m_cut_simplify && !m_cut_simplifier && m_user_scope_literals.empty()) {
             m_cut_simplifier = alloc(cut_simplifier, *this);
@@ -3812,7 +4142,7 @@ namespace sat {
     // -----------------------
 
     void solver::rescale_activity() {
-        SASSERT(m_config.m_branching_heuristic == BH_VSIDS);
+        SASSERT(m_config.m_branching_heuristic != BH_CHB);
         for (unsigned& act : m_activity) {
             act >>= 14;
         }
@@ -3869,6 +4199,59 @@ namespace sat {
         }
     }
 
+    void solver::export_learned(unsigned max_num, vector<literal_vector>& lemmas, unsigned_vector& glue) const {
+        svector<bin_clause> bins;
+        collect_bin_clauses(bins, true, true);
+        for (auto const& b : bins) {
+            if (lemmas.size() >= max_num)
+                return;
+            lemmas.push_back(literal_vector());
+            lemmas.back().push_back(b.first);
+            lemmas.back().push_back(b.second);
+            glue.push_back(2);
+        }
+        ptr_vector<clause> learned;
+        for (clause* c : m_learned)
+            if (!c->was_removed())
+                learned.push_back(c);
+        std::stable_sort(learned.begin(), learned.end(), [](clause const* a, clause const* b) { return a->glue() < b->glue(); });
+        for (clause const* c : learned) {
+            if (lemmas.size() >= max_num)
+                return;
+            lemmas.push_back(literal_vector(c->size(), c->begin()));
+            glue.push_back(c->glue());
+        }
+    }
+
+    /**
+       \brief lemmas from other solvers are not simplified by mk_clause,
+       so duplicate literals and literals assigned at base level are removed here.
+    */
+    void solver::import_learned(literal_vector const& lemma, unsigned glue) {
+        pop_to_base_level();
+        if (inconsistent())
+            return;
+        literal_vector lits(lemma);
+        std::sort(lits.begin(), lits.end());
+        unsigned j = 0;
+        literal prev = null_literal;
+        for (literal l : lits) {
+            if (l.var() >= num_vars() || was_eliminated(l.var()))
+                return;
+            if (l == prev)
+                continue;
+            if (l == ~prev || value(l) == l_true)
+                return;
+            prev = l;
+            if (value(l) == l_undef)
+                lits[j++] = l;
+        }
+        lits.shrink(j);
+        clause* c = mk_clause(lits, sat::status::redundant());
+        if (c)
+            c->set_glue(glue);
+    }
+
     // -----------------------
     //
     // Debugging
@@ -4755,6 +5138,8 @@ namespace sat {
         st.update("sat mk clause nary", m_mk_clause);
         st.update("sat mk var", m_mk_var);
         st.update("sat gc clause", m_gc_clause);
+        st.update("sat defrag", m_defrag);
+        st.update("sat inprocess skipped", m_inprocess_skipped);
         st.update("sat del clause", m_del_clause);
         st.update("sat conflicts", m_conflict);
         st.update("sat decisions", m_decision);
@@ -4770,6 +5155,8 @@ namespace sat {
         st.update("sat elim bool vars bdd", m_elim_var_bdd);
         st.update("sat backjumps", m_backjumps);
         st.update("sat backtracks", m_backtracks);
+        st.update("sat par clauses exported", m_par_exported);
+        st.update("sat par clauses imported", m_par_imported);
     }
 
     void stats::reset() {
@@ -79,6 +79,10 @@ namespace sat {
         unsigned m_units;
         unsigned m_backtracks;
         unsigned m_backjumps;
+        unsigned m_par_exported;
+        unsigned m_par_imported;
+        unsigned m_defrag;
+        unsigned m_inprocess_skipped;
         stats() { reset(); }
         void reset();
         void collect_statistics(statistics & st) const;
@@ -310,6 +314,7 @@ namespace sat {
         void mk_bin_clause(literal l1, literal l2, bool learned) { mk_bin_clause(l1, l2, learned ? sat::status::redundant() : sat::status::asserted()); }
         bool propagate_bin_clause(literal l1, literal l2);
         clause * mk_nary_clause(unsigned num_lits, literal * lits, status st);
+        clause * copy_clause(clause const& c, literal_vector& buffer, status st);
         bool has_variables_to_reinit(clause const& c) const;
         bool has_variables_to_reinit(literal l1, literal l2) const;
         bool attach_nary_clause(clause & c, bool is_asserting);
@@ -418,7 +423,7 @@ namespace sat {
             if (!m_rlimit.inc()) {
                 m_model_is_current = false;
                 TRACE("sat", tout << "canceled\n";);
-                m_reason_unknown = "sat.canceled";
+                m_reason_unknown = m_rlimit.memory_exceeded() ? "sat.max_memory" : "sat.canceled";
                 return true;
             }
             return false;
@@ -519,6 +524,12 @@ namespace sat {
         // collect binary clauses
         void collect_bin_clauses(svector<bin_clause> & r, bool learned, bool learned_only) const;
 
+        // learned clauses with their glue, the lowest glue first
+        void export_learned(unsigned max_num, vector<literal_vector>& lemmas, unsigned_vector& glue) const;
+
+        // add a clause implied by the clauses of the solver as learned clause.
+        void import_learned(literal_vector const& lemma, unsigned glue);
+
         void set_model(model const& mdl, bool is_current);
         char const* get_reason_unknown() const { return m_reason_unknown.c_str(); }
         bool check_clauses(model const& m) const;
@@ -549,6 +560,23 @@ namespace sat {
         unsigned m_next_simplify = 0;
         double   m_simplify_mult = 1.5;
         bool     m_simplify_enabled = true;
+
+        /**
+           \brief yield bookkeeping for an optional inprocessing pass.
+           A pass that removes too few clauses per millisecond is skipped
+           in an exponentially growing number of simplification rounds.
+        */
+        struct inprocess_pass {
+            char const* m_name;
+            unsigned    m_delay = 0;
+            unsigned    m_skip = 0;
+            inprocess_pass(char const* name): m_name(name) {}
+        };
+        inprocess_pass m_probing_pass { "probing" };
+        inprocess_pass m_lookahead_pass { "lookahead" };
+        inprocess_pass m_binspr_pass { "binspr" };
+        inprocess_pass m_anf_pass { "anf" };
+        inprocess_pass m_cut_pass { "cut" };
         bool     m_restart_enabled = true;
         bool guess(bool_var next);
         bool decide();
@@ -574,6 +602,8 @@ namespace sat {
         bool is_assumption(literal l) const;
         bool should_simplify() const;
         void do_simplify();
+        template<typename F>
+        void inprocess(inprocess_pass& p, F const& f);
         void mk_model();
         bool check_model(model const & m) const;
         void do_restart(bool to_base);
@@ -584,12 +614,27 @@ namespace sat {
         void log_stats();
         bool should_cancel();
         bool should_restart() const;
+        bool use_stable_restarts() const;
         void set_next_restart();
         void update_activity(bool_var v, double p);
         bool reached_max_conflicts();
         void sort_watch_lits();
         void exchange_par();
         lbool check_par(unsigned num_lits, literal const* lits);
+        void keep_par_lemmas(parallel& par, unsigned num_extra_solvers);
+        lbool check_core(unsigned num_lits, literal const* lits);
+
+        // -----------------------
+        //
+        // On-disk cache of learned clauses
+        //
+        // -----------------------
+        bool use_clause_cache() const;
+        uint64_t clause_cache_key() const;
+        std::string clause_cache_file(uint64_t key) const;
+        void load_clause_cache(uint64_t key, unsigned num_vars, unsigned num_clauses);
+        void save_clause_cache(uint64_t key, unsigned num_vars, unsigned num_clauses);
+
         lbool do_local_search(unsigned num_lits, literal const* lits);
         lbool do_ddfw_search(unsigned num_lits, literal const* lits);
         lbool do_prob_search(unsigned num_lits, literal const* lits);
@@ -612,6 +657,7 @@ namespace sat {
         void gc_psm_glue();
         void save_psm();
         void gc_half(char const * st_name);
+        bool keep_tier(clause const& c) const;
         void gc_dyn_psm();
         bool activate_frozen_clause(clause & c);
         unsigned psm(clause const & c) const;
@@ -365,6 +365,7 @@ public:
         m_solver.set_incremental(is_incremental() && !override_incremental());
         if (p1.euf() && !get_euf()) 
             ensure_euf();        
+        m_preprocess = nullptr;
     }
     void collect_statistics(statistics & st) const override {
         if (m_preprocess) m_preprocess->collect_statistics(st);
@@ -401,6 +402,50 @@ public:
         return result;
     }
 
+    void export_lemmas(unsigned max_num, expr_ref_vector& lemmas, unsigned_vector& glue) override {
+        vector<sat::literal_vector> clauses;
+        unsigned_vector clause_glue;
+        m_solver.export_learned(UINT_MAX, clauses, clause_glue);
+        expr_ref_vector lit2expr(m), lits(m);
+        lit2expr.resize(m_solver.num_vars() * 2);
+        m_map.mk_inv(lit2expr);
+        for (unsigned i = 0; i < clauses.size() && lemmas.size() < max_num; ++i) {
+            lits.reset();
+            for (sat::literal lit : clauses[i]) {
+                expr* e = lit2expr.get(lit.index());
+                if (!e)
+                    break;
+                lits.push_back(e);
+            }
+            if (lits.size() < clauses[i].size())
+                continue;
+            lemmas.push_back(mk_or(lits));
+            glue.push_back(clause_glue[i]);
+        }
+    }
+
+    void import_lemmas(expr_ref_vector const& lemmas, unsigned_vector const& glue) override {
+        if (!is_internalized() && internalize_formulas() != l_true)
+            return;
+        sat::literal_vector lits;
+        expr_ref_vector disj(m);
+        for (unsigned i = 0; i < lemmas.size(); ++i) {
+            disj.reset();
+            disj.push_back(lemmas.get(i));
+            flatten_or(disj);
+            lits.reset();
+            for (expr* a : disj) {
+                bool sign = m.is_not(a, a);
+                sat::bool_var b = m_map.to_bool_var(a);
+                if (b == sat::null_bool_var)
+                    break;
+                lits.push_back(sat::literal(b, sign));
+            }
+            if (lits.size() == disj.size())
+                m_solver.import_learned(lits, glue[i]);
+        }
+    }
+
     proof * get_proof_core() override {
         return nullptr;
     }
@@ -611,12 +656,18 @@ public:
     }
 
     void init_preprocess() {
-        if (m_preprocess) {
-            m_preprocess->reset();
-        }
         if (!m_bb_rewriter) {
             m_bb_rewriter = alloc(bit_blaster_rewriter, m, m_params);
         }
+        while (m_bb_rewriter->get_num_scopes() < m_num_scopes) {
+            m_bb_rewriter->push();
+        }
+        if (m_preprocess) {
+            // the pipeline is reused across calls, the bit-blaster
+            // cache it refers to is scoped by push/pop.
+            m_preprocess->reset();
+            return;
+        }
         params_ref simp1_p = m_params;
         simp1_p.set_bool("som", true);
         simp1_p.set_bool("pull_cheap_ite", true);
@@ -646,9 +697,6 @@ public:
                          mk_bit_blaster_tactic(m, m_bb_rewriter.get()),
                          using_params(mk_simplify_tactic(m), simp2_p)
                          );
-        while (m_bb_rewriter->get_num_scopes() < m_num_scopes) {
-            m_bb_rewriter->push();
-        }
         m_preprocess->reset();
     }
 
@@ -690,6 +738,10 @@ public:
         ensure_euf()->user_propagate_register_diseq(diseq_eh);
     }
     
+    void user_propagate_register_batch(user_propagator::batch_eh_t& batch_eh) override {
+        ensure_euf()->user_propagate_register_batch(batch_eh);
+    }
+    
     void user_propagate_register_expr(expr* e) override { 
         ensure_euf()->user_propagate_register_expr(e);
     }
@@ -368,6 +368,48 @@ public:
         return result;
     }
 
+    void export_lemmas(unsigned max_num, expr_ref_vector& lemmas, unsigned_vector& glue) override {
+        vector<sat::literal_vector> clauses;
+        unsigned_vector clause_glue;
+        m_solver.export_learned(UINT_MAX, clauses, clause_glue);
+        expr_ref_vector lit2expr(m), lits(m);
+        lit2expr.resize(m_solver.num_vars() * 2);
+        m_map.mk_inv(lit2expr);
+        for (unsigned i = 0; i < clauses.size() && lemmas.size() < max_num; ++i) {
+            lits.reset();
+            for (sat::literal lit : clauses[i]) {
+                expr* e = lit2expr.get(lit.index());
+                if (!e)
+                    break;
+                lits.push_back(e);
+            }
+            if (lits.size() < clauses[i].size())
+                continue;
+            lemmas.push_back(mk_or(lits));
+            glue.push_back(clause_glue[i]);
+        }
+    }
+
+    void import_lemmas(expr_ref_vector const& lemmas, unsigned_vector const& glue) override {
+        sat::literal_vector lits;
+        expr_ref_vector disj(m);
+        for (unsigned i = 0; i < lemmas.size(); ++i) {
+            disj.reset();
+            disj.push_back(lemmas.get(i));
+            flatten_or(disj);
+            lits.reset();
+            for (expr* a : disj) {
+                bool sign = m.is_not(a, a);
+                sat::bool_var b = m_map.to_bool_var(a);
+                if (b == sat::null_bool_var)
+                    break;
+                lits.push_back(sat::literal(b, sign));
+            }
+            if (lits.size() == disj.size())
+                m_solver.import_learned(lits, glue[i]);
+        }
+    }
+
     proof * get_proof_core() override {
         return nullptr;
     }
@@ -565,6 +607,10 @@ public:
         ensure_euf()->user_propagate_register_diseq(diseq_eh);
     }
     
+    void user_propagate_register_batch(user_propagator::batch_eh_t& batch_eh) override {
+        ensure_euf()->user_propagate_register_batch(batch_eh);
+    }
+    
     void user_propagate_register_expr(expr* e) override { 
         ensure_euf()->user_propagate_register_expr(e);
     }
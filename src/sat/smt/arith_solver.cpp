@@ -350,6 +350,13 @@ namespace arith {
         return true;
     }
 
+    bool solver::column_is_interesting(unsigned vi) const {
+        theory_var v = lp().local_to_external(vi);
+        if (v == euf::null_theory_var)
+            return false;
+        return should_refine_bounds() || (static_cast<unsigned>(v) < m_unassigned_bounds.size() && m_unassigned_bounds[v] > 0);
+    }
+
     bool solver::bound_is_interesting(unsigned vi, lp::lconstraint_kind kind, const rational& bval) const {
         theory_var v = lp().local_to_external(vi);
         if (v == euf::null_theory_var)
@@ -653,7 +660,7 @@ namespace arith {
         if (get_value(n, value))
             ;
         else if (a.is_arith_expr(o) && reflect(o)) {
-            expr_ref_vector args(m);
+            expr_ref_buffer args(m);
             for (auto* arg : *to_app(o)) {
                 if (m.is_value(arg))
                     args.push_back(arg);
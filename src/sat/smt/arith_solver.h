@@ -529,6 +529,7 @@ namespace arith {
         bool is_equal(theory_var x, theory_var y) const;
         bool add_eq(lpvar u, lpvar v, lp::explanation const& e, bool is_fixed);
         void consume(rational const& v, lp::constraint_index j);
+        bool column_is_interesting(unsigned vi) const;
         bool bound_is_interesting(unsigned vi, lp::lconstraint_kind kind, const rational& bval) const;
 
         bool get_value(euf::enode* n, expr_ref& val);
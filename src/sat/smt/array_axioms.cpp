@@ -31,6 +31,15 @@ namespace array {
         }
     };
 
+    struct solver::reset_delayed : trail {
+        solver& s;
+        unsigned m_idx;
+        reset_delayed(solver& s, unsigned idx) : s(s), m_idx(idx) {}
+        void undo() override {
+            s.m_axiom_trail[m_idx].set_delayed();
+        }
+    };
+
     void solver::push_axiom(axiom_record const& r) { 
         unsigned idx = m_axiom_trail.size();
         m_axiom_trail.push_back(r); 
@@ -568,9 +577,16 @@ namespace array {
         unsigned sz = m_axiom_trail.size();
         m_delay_qhead = 0;
         
-        for (; m_delay_qhead < sz; ++m_delay_qhead) 
-            if (m_axiom_trail[m_delay_qhead].is_delayed() && assert_axiom(m_delay_qhead)) 
-                change = true;              
+        // a delayed axiom is asserted once per scope. It stays satisfied until backtracking,
+        // so later final checks at the same level do not need to revisit it.
+        for (; m_delay_qhead < sz; ++m_delay_qhead) {
+            if (!m_axiom_trail[m_delay_qhead].is_delayed())
+                continue;
+            if (assert_axiom(m_delay_qhead)) 
+                change = true;
+            ctx.push(reset_delayed(*this, m_delay_qhead));
+            set_applied(m_delay_qhead);
+        }
         flet<bool> _enable_delay(m_enable_delay, false);
         if (unit_propagate())
             change = true;
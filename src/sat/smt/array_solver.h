@@ -150,6 +150,7 @@ namespace array {
         unsigned              m_delay_qhead = 0;
         bool                  m_enable_delay = true;
         struct reset_new;
+        struct reset_delayed;
         void push_axiom(axiom_record const& r);
         bool propagate_axiom(unsigned idx);
         bool assert_axiom(unsigned idx);
@@ -170,6 +170,7 @@ namespace bv {
         if (m_cheap_axioms)
             return true;
 
+        ++m_stats.m_num_delay_blast;
         set_delay_internalize(e, internalize_mode::no_delay_i);
         internalize_circuit(e);
         return false;
@@ -377,13 +378,75 @@ namespace bv {
         auto r2 = eval_args(n, args);
         if (r1 == r2)
             return true;
+        if (!check_word_bounds(a, args, r1))
+            return false;
         if (m_cheap_axioms)
             return true;
+        ++m_stats.m_num_delay_blast;
         set_delay_internalize(a, internalize_mode::no_delay_i);
         internalize_circuit(a);
         return false;
     }
 
+    /**
+    * Word-level lemmas for delayed division, remainder and shifts.
+    * A lemma is added only when the current assignment violates it, so the
+    * circuit of an operator is bit-blasted only if its value remains spurious
+    * after the lemmas are satisfied.
+    *
+    * y != 0 => x udiv y <= x
+    * y != 0 => x urem y < y and x urem y <= x
+    * x >> y <= x
+    * y >= sz => x << y = 0 and x >> y = 0
+    */
+    bool solver::check_word_bounds(app* n, expr_ref_vector const& arg_values, expr* value) {
+        if (arg_values.size() != 2)
+            return true;
+        rational x, y, z;
+        unsigned sz;
+        VERIFY(bv.is_numeral(arg_values[0], x, sz));
+        VERIFY(bv.is_numeral(arg_values[1], y));
+        VERIFY(bv.is_numeral(value, z));
+        expr* a = n->get_arg(0), *b = n->get_arg(1);
+        bool ok = true;
+        auto add_lemma = [&](sat::literal premise, expr* conclusion) {
+            ++m_stats.m_num_word_lemmas;
+            TRACE("bv", tout << "word lemma " << mk_bounded_pp(conclusion, m) << "\n";);
+            if (premise == sat::null_literal)
+                add_unit(mk_literal(conclusion));
+            else
+                add_clause(~premise, mk_literal(conclusion));
+            ok = false;
+        };
+        auto non_zero = [&]() { return ~eq_internalize(b, bv.mk_zero(sz)); };
+        auto overshift = [&]() { return mk_literal(bv.mk_ule(bv.mk_numeral(rational(sz), sz), b)); };
+        switch (n->get_decl_kind()) {
+        case OP_BUDIV_I:
+            if (!y.is_zero() && z > x)
+                add_lemma(non_zero(), bv.mk_ule(n, a));
+            break;
+        case OP_BUREM_I:
+            if (!y.is_zero() && z >= y)
+                add_lemma(non_zero(), m.mk_not(bv.mk_ule(b, n)));
+            if (!y.is_zero() && z > x)
+                add_lemma(non_zero(), bv.mk_ule(n, a));
+            break;
+        case OP_BLSHR:
+            if (z > x)
+                add_lemma(sat::null_literal, bv.mk_ule(n, a));
+            if (y >= sz && !z.is_zero())
+                add_lemma(overshift(), m.mk_eq(n, bv.mk_zero(sz)));
+            break;
+        case OP_BSHL:
+            if (y >= sz && !z.is_zero())
+                add_lemma(overshift(), m.mk_eq(n, bv.mk_zero(sz)));
+            break;
+        default:
+            break;
+        }
+        return ok;
+    }
+
     bool solver::check_bool_eval(euf::enode* n) {
         expr_ref_vector args(m);
         SASSERT(m.is_bool(n->get_expr()));
@@ -397,6 +460,7 @@ namespace bv {
             return false;
         if (m_cheap_axioms)
             return true;
+        ++m_stats.m_num_delay_blast;
         set_delay_internalize(a, internalize_mode::no_delay_i);
         internalize_circuit(a);
         return false;
@@ -428,6 +492,9 @@ namespace bv {
         case OP_BSREM_I:
         case OP_BUDIV_I:
         case OP_BSDIV_I: 
+        case OP_BSHL:
+        case OP_BLSHR:
+        case OP_BASHR:
         case OP_BADD:
             if (should_bit_blast(to_app(e)))
                 return internalize_mode::no_delay_i;
@@ -790,6 +790,8 @@ namespace bv {
         st.update("bv bit2eq", m_stats.m_num_bit2eq);
         st.update("bv bit2ne", m_stats.m_num_bit2ne);
         st.update("bv ackerman", m_stats.m_ackerman);
+        st.update("bv word lemmas", m_stats.m_num_word_lemmas);
+        st.update("bv delayed blast", m_stats.m_num_delay_blast);
     }
 
     sat::extension* solver::copy(sat::solver* s) { UNREACHABLE(); return nullptr; }
@@ -58,6 +58,7 @@ namespace bv {
             unsigned   m_num_diseq_static, m_num_diseq_dynamic,  m_num_conflicts;
             unsigned   m_num_bit2eq, m_num_bit2ne, m_num_eq2bit, m_num_ne2bit;
             unsigned   m_ackerman;
+            unsigned   m_num_word_lemmas, m_num_delay_blast;
             void reset() { memset(this, 0, sizeof(stats)); }
             stats() { reset(); }
         };
@@ -311,6 +312,7 @@ namespace bv {
         bool check_mul_one(app* n, expr_ref_vector const& arg_values, expr* value1, expr* value2);
         bool check_umul_no_overflow(app* n, expr_ref_vector const& arg_values, expr* value);
         bool check_bv_eval(euf::enode* n);
+        bool check_word_bounds(app* n, expr_ref_vector const& arg_values, expr* value);
         bool check_bool_eval(euf::enode* n);
         void encode_msb_tail(expr* x, expr_ref_vector& xs);
         void encode_lsb_tail(expr* x, expr_ref_vector& xs);
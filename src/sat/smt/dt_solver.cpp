@@ -216,8 +216,14 @@ namespace dt {
         m_var_data.push_back(alloc(var_data));
         var_data* d = m_var_data[r];
         ctx.attach_th_var(n, this, r);
+        m_oc_clean = false;
         if (is_constructor(n)) {
             d->m_constructor = n;
+            for (enode* arg : euf::enode_args(n)) {
+                sort* s = arg->get_sort(), *se;
+                if ((m_autil.is_array(s) && dt.is_datatype(get_array_range(s))) || (m_sutil.is_seq(s, se) && dt.is_datatype(se)))
+                    m_oc_nested = true;
+            }
             assert_accessor_axioms(n);
         }
         else if (is_update_field(n)) 
@@ -484,6 +490,7 @@ namespace dt {
     void solver::merge_eh(theory_var v1, theory_var v2, theory_var, theory_var) {
         // v1 is the new root
         SASSERT(v1 == static_cast<int>(m_find.find(v1)));
+        m_oc_clean = false;
         var_data* d1 = m_var_data[v1];
         var_data* d2 = m_var_data[v2];
         auto* con1 = d1->m_constructor;
@@ -726,6 +733,11 @@ namespace dt {
         int num_vars = get_num_vars();
         sat::check_result r = sat::check_result::CR_DONE;
         final_check_st _guard(*this);
+        // The constructor graph is unchanged since the last cycle-free check.
+        // Backtracking only splits classes, which cannot introduce cycles.
+        // Array and sequence arguments depend on other theories and are always re-checked.
+        bool oc_skip = m_oc_clean;
+        m_oc_clean = !m_oc_nested;
         int start = s().rand()();
         for (int i = 0; i < num_vars; i++) {
             theory_var v = (i + start) % num_vars;
@@ -734,8 +746,10 @@ namespace dt {
             enode* node = var2enode(v);
             if (!is_datatype(node))
                 continue;
-            if (dt.is_recursive(node->get_sort()) && !oc_cycle_free(node) && occurs_check(node))
+            if (!oc_skip && dt.is_recursive(node->get_sort()) && !oc_cycle_free(node) && occurs_check(node)) {
+                m_oc_clean = false;
                 return sat::check_result::CR_CONTINUE;
+            }
             if (get_config().m_dt_lazy_splits == 0)
                 continue;
             if (m_var_data[v]->m_constructor)
@@ -99,6 +99,8 @@ namespace dt {
         enode_pair_vector     m_used_eqs; // conflict, if any
         parent_tbl            m_parent; // parent explanation for occurs_check
         svector<stack_entry>  m_dfs; // stack for DFS for occurs_check
+        bool                  m_oc_clean = false;  // no constructor graph changes since the last cycle-free occurs check
+        bool                  m_oc_nested = false; // constructors with array or sequence arguments are present
         sat::literal_vector   m_lits;
 
         void clear_mark();
@@ -125,15 +125,26 @@ namespace euf {
                 us.register_value(e);
         }
 
-        // fresh values depend on all non-fresh values of the same sort
+        // fresh values depend on all non-fresh values of the same sort.
+        // The roots are bucketed by sort once, so that large signatures
+        // with many fresh values do not require a pass over all nodes per value.
+        obj_map<sort, unsigned> sort2bucket;
+        vector<ptr_vector<enode>> buckets;
         for (enode* n : fresh_values) {
             n->mark1();
             deps.insert(n, nullptr);
+            if (!sort2bucket.contains(n->get_sort())) {
+                sort2bucket.insert(n->get_sort(), buckets.size());
+                buckets.push_back(ptr_vector<enode>());
+            }
         }
+        unsigned idx = 0;
+        for (enode* r : m_egraph.nodes())
+            if (r->is_root() && !r->is_marked1() && sort2bucket.find(r->get_sort(), idx))
+                buckets[idx].push_back(r);
         for (enode* n : fresh_values)
-            for (enode* r : m_egraph.nodes())
-                if (r->is_root() && r->get_sort() == n->get_sort() && !r->is_marked1())
-                    deps.add(n, r);
+            for (enode* r : buckets[sort2bucket[n->get_sort()]])
+                deps.add(n, r);
         for (enode* n : fresh_values)
             n->unmark1();
         
@@ -37,8 +37,15 @@ namespace euf {
             !m_config.m_proof_log.is_non_empty_string())
             return;
         
-        if (m_config.m_proof_log.is_non_empty_string())
-            m_proof_out = alloc(std::ofstream, m_config.m_proof_log.str(), std::ios_base::out);
+        if (m_config.m_proof_log.is_non_empty_string()) {
+            // proof steps are streamed one at a time, use a large buffer
+            // so the log is written in big chunks.
+            std::ofstream* out = alloc(std::ofstream);
+            m_proof_buffer.resize(1 << 20);
+            out->rdbuf()->pubsetbuf(m_proof_buffer.data(), m_proof_buffer.size());
+            out->open(m_config.m_proof_log.str(), std::ios_base::out);
+            m_proof_out = out;
+        }
         get_drat().set_clause_eh(*this);
         m_proof_initialized = true;        
     }
@@ -402,7 +409,9 @@ namespace euf {
             display_assume(out, n, lits);
         else 
             UNREACHABLE();
-        out.flush();
+        // the empty clause completes a refutation
+        if (n == 0)
+            out.flush();
     }
 
     void solver::on_check(unsigned n, literal const* lits, sat::status st) {
@@ -31,6 +31,7 @@ Author:
 #include "sat/smt/sls_solver.h"
 #include "sat/smt/recfun_solver.h"
 #include "sat/smt/specrel_solver.h"
+#include "sat/smt/xor_solver.h"
 
 namespace euf {
 
@@ -191,6 +192,8 @@ namespace euf {
     void solver::init_search() {   
         if (get_config().m_sls_enable)
             add_solver(alloc(sls::solver, *this));
+        if (s().get_config().m_xor_solver && !m_id2solver.get(m.mk_family_id("xor-solver"), nullptr))
+            add_solver(alloc(xr::solver, *this));
         TRACE("before_search", s().display(tout););
         m_reason_unknown.clear();
         for (auto* s : m_solvers)
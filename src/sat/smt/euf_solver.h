@@ -453,6 +453,7 @@ namespace euf {
         sat::status mk_distinct_status(sat::literal_vector const& lits) { return mk_distinct_status(lits.size(), lits.data()); }
         sat::status mk_distinct_status(unsigned n, sat::literal const* lits);
 
+        svector<char>            m_proof_buffer;   // declared before m_proof_out, which writes into it
         scoped_ptr<std::ostream> m_proof_out;
 
         // decompile
@@ -553,6 +554,10 @@ namespace euf {
             check_for_user_propagator();
             m_user_propagator->register_diseq(diseq_eh);
         }
+        void user_propagate_register_batch(user_propagator::batch_eh_t& batch_eh) {
+            check_for_user_propagator();
+            m_user_propagator->register_batch(batch_eh);
+        }
         void user_propagate_register_created(user_propagator::created_eh_t& ceh) {
             check_for_user_propagator();
             m_user_propagator->register_created(ceh);
@@ -36,7 +36,8 @@ namespace pb {
         constraint(tag_t::pb_t, id, lit, wlits.size(), get_obj_size(wlits.size()), k),
         m_slack(0),
         m_num_watch(0),
-        m_max_sum(0) {
+        m_max_sum(0),
+        m_max_coeff(0) {
         for (unsigned i = 0; i < size(); ++i) {
             m_wlits[i] = wlits[i];
             if (wlits[i].first > k)
@@ -47,11 +48,13 @@ namespace pb {
 
     void pbc::update_max_sum() {
         m_max_sum = 0;
+        m_max_coeff = 0;
         for (unsigned i = 0; i < size(); ++i) {
             m_wlits[i].first = std::min(k(), m_wlits[i].first);
             if (m_max_sum + m_wlits[i].first < m_max_sum) 
                 throw default_exception("addition of pb coefficients overflows");
             m_max_sum += m_wlits[i].first;
+            m_max_coeff = std::max(m_max_coeff, m_wlits[i].first);
         }
     }
 
@@ -68,6 +71,7 @@ namespace pb {
         if (m > m_k)  
             for (unsigned i = 0; i < m_size; ++i) 
                 m_wlits[i].first = std::min(m_k, m_wlits[i].first);
+        m_max_coeff = std::min(m, m_k);
                        
         VERIFY(w >= m_k && m_k > 0);
     }
@@ -27,6 +27,7 @@ namespace pb {
         unsigned       m_slack;
         unsigned       m_num_watch;
         unsigned       m_max_sum;
+        unsigned       m_max_coeff;
         wliteral       m_wlits[0];
     public:
         static size_t get_obj_size(unsigned num_lits) { return sat::constraint_base::obj_size(sizeof(pbc) + num_lits * sizeof(wliteral)); }
@@ -41,6 +42,7 @@ namespace pb {
         void set_slack(unsigned s) { m_slack = s; }
         unsigned num_watch() const { return m_num_watch; }
         unsigned max_sum() const { return m_max_sum; }
+        unsigned max_coeff() const { return m_max_coeff; }
         void update_max_sum();
         void set_num_watch(unsigned s) { m_num_watch = s; }
         bool is_cardinality() const;
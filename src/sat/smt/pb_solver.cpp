@@ -292,15 +292,8 @@ namespace pb {
         SASSERT(num_watch > 0);
         SASSERT(validate_watch(p, sat::null_literal));
         unsigned index = 0;
-        m_a_max = 0;
-        m_pb_undef.reset();
-        for (; index < num_watch; ++index) {
-            literal lit = p[index].second;
-            if (lit == alit) {
-                break;
-            }
-            add_index(p, index, lit);
-        }
+        for (; index < num_watch && p[index].second != alit; ++index)
+            ;
         if (index == num_watch || num_watch == 0) {
             _bad_id = p.id();
             BADLOG(
@@ -314,14 +307,30 @@ namespace pb {
         
         
         SASSERT(index < num_watch);
+        unsigned val = p[index].first;
+        SASSERT(val <= slack);
+
+        // the remaining watched slack exceeds the bound by at least the largest
+        // coefficient: no literal is forced and no replacement watch is needed.
+        if ((uint64_t)(slack - val) >= (uint64_t)bound + p.max_coeff()) {
+            --num_watch;
+            p.set_slack(slack - val);
+            p.set_num_watch(num_watch);
+            p.swap(num_watch, index);
+            return l_undef;
+        }
+
+        m_a_max = 0;
+        m_pb_undef.reset();
+        for (unsigned i = 0; i < index; ++i) {
+            add_index(p, i, p[i].second);
+        }
         unsigned index1 = index + 1;
         for (; m_a_max == 0 && index1 < num_watch; ++index1) {
             add_index(p, index1, p[index1].second);
         }
         
-        unsigned val = p[index].first;
         SASSERT(value(p[index].second) == l_false);
-        SASSERT(val <= slack);
         slack -= val;
 
         // find literals to swap with:            
@@ -886,11 +895,21 @@ namespace pb {
     void solver::round_to_one(bool_var w) {
         unsigned c = get_abs_coeff(w);
         if (c == 1 || c == 0) return;
+        round_by(c);
+    }
+
+    /**
+     * Weaken the non-false literals whose coefficients are not divisible by c
+     * and divide the active inequality by c. The slack of the inequality
+     * does not increase, so a conflicting inequality remains conflicting.
+     */
+    void solver::round_by(unsigned c) {
         for (bool_var v : m_active_vars) {
             wliteral wl = get_wliteral(v);
             unsigned q = wl.first % c;
             if (q != 0 && !is_false(wl.second)) {
-                m_coeffs[v] = wl.first - q;
+                int64_t c1 = wl.first - q;
+                m_coeffs[v] = wl.second.sign() ? -c1 : c1;
                 m_bound -= q;
                 SASSERT(m_bound > 0);
             }
@@ -901,6 +920,18 @@ namespace pb {
         TRACE("pb", active2pb(m_B); display(tout, m_B, true););
     }
 
+    /**
+     * Coefficients of the active inequality are bounded by its bound, which grows
+     * by the bound of each resolved constraint. Divide before the bound gets close
+     * to the overflow limit, instead of abandoning the analysis on overflow.
+     */
+    void solver::reduce_coefficients() {
+        unsigned const max_bound = 1u << 24;
+        if (m_bound < max_bound || m_overflow)
+            return;
+        round_by(m_bound >> 20);
+    }
+
     void solver::divide(unsigned c) {
         SASSERT(c != 0);
         if (c == 1) return;
@@ -1085,6 +1116,7 @@ namespace pb {
 
             SASSERT(validate_lemma());
             cut();
+            reduce_coefficients();
 
             // find the next marked variable in the assignment stack
             bool_var v;
@@ -246,6 +246,8 @@ namespace pb {
         lbool resolve_conflict_rs();
         void round_to_one(ineq& ineq, bool_var v);
         void round_to_one(bool_var v);
+        void round_by(unsigned c);
+        void reduce_coefficients();
         void divide(unsigned c);
         void resolve_on(literal lit);
         void resolve_with(ineq const& ineq);
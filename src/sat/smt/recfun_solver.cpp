@@ -32,7 +32,8 @@ namespace recfun {
         m_util(m_plugin.u()), 
         m_disabled_guards(m),
         m_enabled_guards(m),
-        m_preds(m) {
+        m_preds(m),
+        m_apply_pinned(m) {
     }    
 
     solver::~solver() {
@@ -47,13 +48,21 @@ namespace recfun {
         for (auto & kv : m_guard2pending) 
             dealloc(kv.m_value);
         m_guard2pending.reset();
+        m_apply_cache.reset();
+        m_apply_pinned.reset();
     }
 
-    expr_ref solver::apply_args(vars const & vars, expr_ref_vector const & args, expr * e) {
+    expr_ref solver::apply_args(vars const & vars, expr_ref_vector const & args, expr * e, app * call) {
         SASSERT(is_standard_order(vars));
+        expr* r = nullptr;
+        if (m_apply_cache.find(e, call, r))
+            return expr_ref(r, m);
         var_subst subst(m, true);
         expr_ref new_body = subst(e, args);
         ctx.get_rewriter()(new_body);
+        m_apply_cache.insert(e, call, new_body);
+        m_apply_pinned.push_back(call);
+        m_apply_pinned.push_back(new_body);
         return new_body;
     }
 
@@ -69,7 +78,7 @@ namespace recfun {
         SASSERT(e.m_def->is_fun_macro());
         auto & vars = e.m_def->get_vars();
         app_ref lhs = e.m_lhs;
-        expr_ref rhs = apply_args(vars, e.m_args, e.m_def->get_rhs());
+        expr_ref rhs = apply_args(vars, e.m_args, e.m_def->get_rhs(), e.m_lhs);
         unsigned generation = std::max(ctx.get_max_generation(lhs), ctx.get_max_generation(rhs));
         euf::solver::scoped_generation _sgen(ctx, generation + 1);
         auto eq = eq_internalize(lhs, rhs);
@@ -105,7 +114,7 @@ namespace recfun {
             preds.push_back(mk_literal(pred_applied));
             expr_ref_vector guards(m);
             for (auto & g : c.get_guards()) 
-                guards.push_back(apply_args(vars, e.m_args, g));
+                guards.push_back(apply_args(vars, e.m_args, g, e.m_lhs));
             if (c.is_immediate()) {
                 body_expansion be(pred_applied, c, e.m_args);
                 assert_body_axiom(be);            
@@ -165,17 +174,17 @@ namespace recfun {
         auto & vars = d.get_vars();
         auto & args = e.m_args;
         SASSERT(is_standard_order(vars));
+        app_ref lhs(u().mk_fun_defined(d, args), m);
         sat::literal_vector clause;
         for (auto & g : e.m_cdef->get_guards()) {
-            expr_ref guard = apply_args(vars, args, g);
+            expr_ref guard = apply_args(vars, args, g, lhs);
             if (m.is_false(guard))
                 return;
             if (m.is_true(guard))
                 continue;
             clause.push_back(~mk_literal(guard));
         }        
-        expr_ref lhs(u().mk_fun_defined(d, args), m);
-        expr_ref rhs = apply_args(vars, args, e.m_cdef->get_rhs());
+        expr_ref rhs = apply_args(vars, args, e.m_cdef->get_rhs(), lhs);
         clause.push_back(eq_internalize(lhs, rhs));
         add_clause(clause);
     }
@@ -18,6 +18,7 @@ Author:
 #pragma once
 
 #include "ast/recfun_decl_plugin.h"
+#include "util/obj_pair_hashtable.h"
 #include "ast/ast_trail.h"
 #include "sat/smt/sat_th.h"
 
@@ -69,7 +70,11 @@ namespace recfun {
         bool is_case_pred(euf::enode * e) const { return is_case_pred(e->get_expr()); }
 
 
-        expr_ref apply_args(vars const & vars, expr_ref_vector const & args, expr * e); 
+        // instances of definition bodies and guards by (body or guard, call), kept across backtracking
+        obj_pair_map<expr, app, expr*> m_apply_cache;
+        expr_ref_vector          m_apply_pinned;
+
+        expr_ref apply_args(vars const & vars, expr_ref_vector const & args, expr * e, app * call);
         void assert_macro_axiom(case_expansion & e);
         void assert_case_axioms(case_expansion & e);
         void assert_body_axiom(body_expansion & e);
@@ -17,6 +17,7 @@ Author:
 
 #include "sat/smt/sls_solver.h"
 #include "sat/smt/euf_solver.h"
+#include "params/sls_params.hpp"
 
 
 
@@ -38,15 +39,36 @@ namespace sls {
     }
 
     void solver::finalize() {
-        if (!m_completed && m_sls) {
-            m_sls->cancel();
-            m_thread.join();
-            m_sls->collect_statistics(m_st);
-            m_sls = nullptr;
-            m_shared = nullptr;
-            m_slsm = nullptr;
-            m_units = nullptr;
+        stop_workers();
+    }
+
+    void solver::stop_workers() {
+        for (worker* w : m_workers) 
+            w->m_sls->cancel();
+        for (worker* w : m_workers) {
+            if (w->m_thread.joinable()) {
+                w->m_thread.join();
+                w->m_sls->collect_statistics(m_st);
+            }
+        }
+        if (!m_model && m_shared_model) {
+            ast_translation tr(*m_shared, m);
+            m_model = m_shared_model->translate(tr);
         }
+        m_workers.reset();
+        m_shared_model = nullptr;
+        m_units = nullptr;
+        m_shared = nullptr;
+    }
+
+    model_ref solver::get_model() {
+        if (m_model || !m_shared)
+            return m_model;
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_shared_model)
+            return m_model;
+        ast_translation tr(*m_shared, m);
+        return m_shared_model->translate(tr);
     }
 
     sat::check_result solver::check() { 
@@ -73,6 +95,8 @@ namespace sls {
     }
 
     void solver::pop_core(unsigned n) {
+        if (!m_units)
+            return;
         for (; m_trail_lim < s().init_trail_size(); ++m_trail_lim) {
             auto lit = s().trail_literal(m_trail_lim);
             auto e = ctx.literal2expr(lit);
@@ -81,85 +105,84 @@ namespace sls {
                 std::lock_guard<std::mutex> lock(m_mutex);
                 ast_translation tr(m, *m_shared);
                 m_units->push_back(tr(e.get()));
-                m_has_units = true;
+                ++m_num_units;
             }
         }
     }       
 
+    /**
+    * Start sls.threads local search workers. They search with different
+    * random seeds, see the units learned by the SAT core and publish the
+    * models they find. The first worker that satisfies all assertions
+    * stops the SAT core and the other workers.
+    */
     void solver::init_search() {
-        if (m_sls) {
-            m_sls->cancel();
-            m_thread.join();
-            m_result = l_undef;
-            m_completed = false;
-            m_has_units = false;
-            m_model = nullptr;
-            m_units = nullptr;
-        }
-        // set up state for local search solver here
-
+        stop_workers();
+        m_model = nullptr;
+        m_num_units = 0;
         m_shared = alloc(ast_manager);
-        m_slsm = alloc(ast_manager);
         m_units = alloc(expr_ref_vector, *m_shared);
-        ast_translation tr(m, *m_slsm);
-        
-        m_completed = false;
-        m_result = l_undef;
-        m_model = nullptr;
-        m_sls = alloc(bv::sls, *m_slsm, s().params());
-        
-        for (expr* a : ctx.get_assertions())
-            m_sls->assert_expr(tr(a));
 
-        std::function<bool(expr*, unsigned)> eval = [&](expr* e, unsigned r) {
-            return false;
-        };
-
-        m_sls->init();
-        m_sls->init_eval(eval);
-        m_sls->updt_params(s().params());
-        m_sls->init_unit([&]() { 
-            if (!m_has_units)
-                return expr_ref(*m_slsm);
-            expr_ref e(*m_slsm);
-            {
+        sls_params sp(s().params());
+        unsigned num_threads = std::max(1u, sp.threads());
+        for (unsigned i = 0; i < num_threads; ++i) {
+            worker* w = alloc(worker);
+            m_workers.push_back(w);
+            w->m_manager = alloc(ast_manager);
+            ast_manager& wm = *w->m_manager;
+            ast_translation tr(m, wm);
+            params_ref p = s().params();
+            p.set_uint("random_seed", sp.random_seed() + i);
+            w->m_sls = alloc(bv::sls, wm, p);
+            for (expr* a : ctx.get_assertions())
+                w->m_sls->assert_expr(tr(a));
+
+            std::function<bool(expr*, unsigned)> eval = [&](expr* e, unsigned r) {
+                return false;
+            };
+
+            w->m_sls->init();
+            w->m_sls->init_eval(eval);
+            w->m_sls->updt_params(p);
+            w->m_sls->init_unit([this, w]() {
+                ast_manager& wm = *w->m_manager;
+                if (w->m_unit_head == m_num_units)
+                    return expr_ref(wm);
                 std::lock_guard<std::mutex> lock(m_mutex);
-                if (m_units->empty())
-                    return expr_ref(*m_slsm);
-                ast_translation tr(*m_shared, *m_slsm);
-                e = tr(m_units->back());
-                m_units->pop_back();
-            }
-            return e;
-        });
-        m_sls->set_model([&](model& mdl) {
-            std::lock_guard<std::mutex> lock(m_mutex);
-            ast_translation tr(*m_shared, m);
-            m_model = mdl.translate(tr);
-        });
-                                     
-        m_thread = std::thread([this]() { run_local_search(); });        
+                ast_translation tr(*m_shared, wm);
+                return expr_ref(tr(m_units->get(w->m_unit_head++)), wm);
+            });
+            w->m_sls->set_model([this, w](model& mdl) {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                ast_translation tr(*w->m_manager, *m_shared);
+                m_shared_model = mdl.translate(tr);
+            });
+        }
+        for (worker* w : m_workers)
+            w->m_thread = std::thread([this, w]() { run_local_search(*w); });
     }
 
     void solver::sample_local_search() {
-        if (!m_completed)
-            return;        
-        m_thread.join();
-        m_completed = false;
-        m_sls->collect_statistics(m_st);
-        if (m_result == l_true) {
-            IF_VERBOSE(2, verbose_stream() << "(sat.sls :model-completed)\n";);
-            auto mdl = m_sls->get_model();
-            ast_translation tr(*m_slsm, m);
-            m_model = mdl->translate(tr);
-            s().set_canceled();
+        for (worker* w : m_workers) {
+            if (!w->m_completed || !w->m_thread.joinable())
+                continue;
+            w->m_thread.join();
+            w->m_sls->collect_statistics(m_st);
+            if (w->m_result == l_true) {
+                IF_VERBOSE(2, verbose_stream() << "(sat.sls :model-completed)\n";);
+                auto mdl = w->m_sls->get_model();
+                ast_translation tr(*w->m_manager, m);
+                m_model = mdl->translate(tr);
+                s().set_canceled();
+                stop_workers();
+                return;
+            }
         }
-        m_sls = nullptr;
     }
 
-    void solver::run_local_search() {
-        m_result = (*m_sls)();
-        m_completed = true;
+    void solver::run_local_search(worker& w) {
+        w.m_result = (*w.m_sls)();
+        w.m_completed = true;
     }
 
 #endif
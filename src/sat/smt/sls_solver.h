@@ -18,6 +18,7 @@ Author:
 
 
 #include "util/rlimit.h"
+#include "util/scoped_ptr_vector.h"
 #include "ast/sls/bv_sls.h"
 #include "sat/smt/sat_th.h"
 
@@ -62,29 +63,40 @@ namespace euf {
 namespace sls {
 
     class solver : public euf::th_euf_solver {
-        std::atomic<lbool> m_result;
-        std::atomic<bool> m_completed, m_has_units;
-        std::thread m_thread;
+
+        // a local search worker owns its manager and its thread.
+        struct worker {
+            scoped_ptr<ast_manager> m_manager;
+            scoped_ptr<bv::sls>     m_sls;
+            std::thread             m_thread;
+            std::atomic<bool>       m_completed { false };
+            std::atomic<lbool>      m_result { l_undef };
+            unsigned                m_unit_head = 0;
+        };
+
         std::mutex  m_mutex;
         // m is accessed by the main thread
-        // m_slsm is accessed by the sls thread
+        // the manager of a worker is accessed by the worker thread
         // m_shared is only accessed at synchronization points
-        scoped_ptr<ast_manager> m_shared, m_slsm;
-        scoped_ptr<bv::sls> m_sls;
-        scoped_ptr<expr_ref_vector> m_units;
+        scoped_ptr<ast_manager> m_shared;
+        scoped_ptr_vector<worker> m_workers;
+        scoped_ptr<expr_ref_vector> m_units;    // units learned by the SAT core, read by all workers.
+        std::atomic<unsigned> m_num_units { 0 };
+        model_ref m_shared_model;               // best model found so far, in m_shared.
         model_ref m_model;
         unsigned m_trail_lim = 0;
         statistics m_st;
 
-        void run_local_search();
+        void run_local_search(worker& w);
         void sample_local_search();
+        void stop_workers();
         bool is_unit(expr*);
 
     public:
         solver(euf::solver& ctx);
         ~solver();
 
-        model_ref get_model() { return m_model; }
+        model_ref get_model();
 
         void init_search() override;
         void push_core() override {}
@@ -89,17 +89,30 @@ namespace user_solver {
     }
 
     void solver::new_fixed_eh(euf::theory_var v, expr* value, unsigned num_lits, sat::literal const* jlits) {
-        if (!m_fixed_eh)
+        if (!has_fixed())
             return;
         force_push();
+        if (m_batch_eh)
+            m_prop.push_back(prop_info(sat::literal_vector(num_lits, jlits), v, expr_ref(value, m)));
+        else
+            fixed_core(v, value, num_lits, jlits);
+    }
+
+    bool solver::mark_fixed(euf::theory_var v, unsigned num_lits, sat::literal const* jlits) {
         if (m_fixed.contains(v))
-            return;
+            return false;
         m_fixed.insert(v);
         ctx.push(insert_map<uint_set, unsigned>(m_fixed, v));
         m_id2justification.setx(v, sat::literal_vector(num_lits, jlits), sat::literal_vector());
         for (unsigned i = 0; i < num_lits; ++i)
             if (s().value(m_id2justification[v][i]) == l_false)
                 m_id2justification[v][i].neg();
+        return true;
+    }
+
+    void solver::fixed_core(euf::theory_var v, expr* value, unsigned num_lits, sat::literal const* jlits) {
+        if (!mark_fixed(v, num_lits, jlits))
+            return;
         try {
             m_fixed_eh(m_user_context, this, var2expr(v), value);
         }
@@ -146,7 +159,7 @@ namespace user_solver {
     }
 
     void solver::asserted(sat::literal lit) {
-        if (!m_fixed_eh)
+        if (!has_fixed())
             return;
         auto* n = bool_var2enode(lit.var());
         euf::theory_var v = n->get_th_var(get_id());
@@ -157,14 +170,21 @@ namespace user_solver {
         sat::literal_vector lits;
         lits.push_back(lit);
         m_id2justification.setx(v, lits, sat::literal_vector());
-        m_fixed_eh(m_user_context, this, var2expr(v), lit.sign() ? m.mk_false() : m.mk_true());
+        expr* value = lit.sign() ? m.mk_false() : m.mk_true();
+        if (m_batch_eh)
+            m_prop.push_back(prop_info(lits, v, expr_ref(value, m)));
+        else
+            m_fixed_eh(m_user_context, this, var2expr(v), value);
     }
 
     void solver::new_eq_eh(euf::th_eq const& eq) {
-        if (!m_eq_eh)
+        if (!m_eq_eh && !m_batch_eh)
             return;
         force_push();
-        m_eq_eh(m_user_context, this, var2expr(eq.v1()), var2expr(eq.v2()));
+        if (m_batch_eh)
+            m_prop.push_back(prop_info(eq.v1(), eq.v2(), m));
+        else
+            m_eq_eh(m_user_context, this, var2expr(eq.v1()), var2expr(eq.v2()));
     }
 
     void solver::new_diseq_eh(euf::th_eq const& de) {
@@ -200,7 +220,42 @@ namespace user_solver {
     }
 
     void solver::propagate_new_fixed(prop_info const& prop) {
-        new_fixed_eh(prop.m_var, prop.m_conseq, prop.m_lits.size(), prop.m_lits.data());
+        if (m_fixed_eh)
+            fixed_core(prop.m_var, prop.m_conseq, prop.m_lits.size(), prop.m_lits.data());
+    }
+
+    void solver::propagate_new_eq(prop_info const& prop) {
+        expr* a = var2expr(prop.m_var);
+        expr* b = var2expr(prop.m_var2);
+        m_eq_eh(m_user_context, this, a, b);
+    }
+
+    void solver::add_to_batch(prop_info const& prop) {
+        if (prop.m_var2 != euf::null_theory_var) {
+            m_batch_lhs.push_back(var2expr(prop.m_var));
+            m_batch_rhs.push_back(var2expr(prop.m_var2));
+        }
+        else if (mark_fixed(prop.m_var, prop.m_lits.size(), prop.m_lits.data())) {
+            m_batch_fixed.push_back(var2expr(prop.m_var));
+            m_batch_values.push_back(prop.m_conseq);
+        }
+    }
+
+    /**
+       \brief deliver the fixed values and equalities collected by add_to_batch in one call.
+       Consequences the client propagates from the callback are queued behind m_qhead.
+    */
+    void solver::propagate_batch() {
+        if (s().inconsistent() || (m_batch_fixed.empty() && m_batch_lhs.empty()))
+            return;
+        try {
+            m_batch_eh(m_user_context, this, 
+                       m_batch_fixed.size(), m_batch_fixed.data(), m_batch_values.data(), 
+                       m_batch_lhs.size(), m_batch_lhs.data(), m_batch_rhs.data());
+        }
+        catch (...) {
+            throw default_exception("Exception thrown in \"batch\"-callback");
+        }
     }
 
     bool solver::unit_propagate() {
@@ -217,12 +272,24 @@ namespace user_solver {
         }
         ctx.push(value_trail<unsigned>(m_qhead));
         unsigned np = m_stats.m_num_propagations;
-        for (; m_qhead < m_prop.size() && !s().inconsistent(); ++m_qhead) {
-            auto const& prop = m_prop[m_qhead];
-            if (prop.m_var == euf::null_theory_var)
-                propagate_consequence(prop);
-            else
-                propagate_new_fixed(prop);
+        while (m_qhead < m_prop.size() && !s().inconsistent()) {
+            m_batch_fixed.reset();
+            m_batch_values.reset();
+            m_batch_lhs.reset();
+            m_batch_rhs.reset();
+            for (; m_qhead < m_prop.size() && !s().inconsistent(); ++m_qhead) {
+                auto const& prop = m_prop[m_qhead];
+                if (prop.m_var == euf::null_theory_var)
+                    propagate_consequence(prop);
+                else if (m_batch_eh)
+                    add_to_batch(prop);
+                else if (prop.m_var2 != euf::null_theory_var)
+                    propagate_new_eq(prop);
+                else
+                    propagate_new_fixed(prop);
+            }
+            if (m_batch_eh)
+                propagate_batch();
         }
         return np < m_stats.m_num_propagations || replayed;
     }
@@ -34,6 +34,7 @@ namespace user_solver {
             svector<std::pair<expr*, expr*>> m_eqs;
             sat::literal_vector                    m_lits;
             euf::theory_var                  m_var = euf::null_theory_var;
+            euf::theory_var                  m_var2 = euf::null_theory_var; // queued equality m_var == m_var2
 
             prop_info(unsigned num_fixed, unsigned const* fixed_ids, unsigned num_eqs, expr* const* eq_lhs, expr* const* eq_rhs, expr_ref const& c):
                 m_ids(num_fixed, fixed_ids),
@@ -48,6 +49,11 @@ namespace user_solver {
                 m_lits(lits),
                 m_var(v) {}
 
+            prop_info(euf::theory_var v1, euf::theory_var v2, ast_manager& m):
+                m_conseq(m),
+                m_var(v1),
+                m_var2(v2) {}
+
         };
 
         struct stats {
@@ -64,6 +70,7 @@ namespace user_solver {
         user_propagator::fixed_eh_t     m_fixed_eh = nullptr;
         user_propagator::eq_eh_t        m_eq_eh = nullptr;
         user_propagator::eq_eh_t        m_diseq_eh = nullptr;
+        user_propagator::batch_eh_t     m_batch_eh = nullptr;
         user_propagator::created_eh_t   m_created_eh = nullptr;
         user_propagator::decide_eh_t    m_decide_eh = nullptr;
         user_propagator::context_obj*   m_api_context = nullptr;
@@ -80,6 +87,7 @@ namespace user_solver {
         vector<expr_ref_vector> m_clauses_to_replay;
         unsigned                m_replay_qhead = 0;
         uint_set                m_fixed;
+        ptr_vector<expr>        m_batch_fixed, m_batch_values, m_batch_lhs, m_batch_rhs;
 
         struct justification {
             unsigned m_propagation_index { 0 };
@@ -99,6 +107,11 @@ namespace user_solver {
 
         void propagate_consequence(prop_info const& prop);
         void propagate_new_fixed(prop_info const& prop);
+        void propagate_new_eq(prop_info const& prop);
+        bool mark_fixed(euf::theory_var v, unsigned num_lits, sat::literal const* jlits);
+        void fixed_core(euf::theory_var v, expr* value, unsigned num_lits, sat::literal const* jlits);
+        void add_to_batch(prop_info const& prop);
+        void propagate_batch();
 
         void validate_propagation();
 
@@ -136,10 +149,11 @@ namespace user_solver {
         void register_fixed(user_propagator::fixed_eh_t& fixed_eh) { m_fixed_eh = fixed_eh; }
         void register_eq(user_propagator::eq_eh_t& eq_eh) { m_eq_eh = eq_eh; }
         void register_diseq(user_propagator::eq_eh_t& diseq_eh) { m_diseq_eh = diseq_eh; }
+        void register_batch(user_propagator::batch_eh_t& batch_eh) { m_batch_eh = batch_eh; }
         void register_created(user_propagator::created_eh_t& created_eh) { m_created_eh = created_eh; }
         void register_decide(user_propagator::decide_eh_t& decide_eh) { m_decide_eh = decide_eh; }
 
-        bool has_fixed() const { return (bool)m_fixed_eh; }
+        bool has_fixed() const { return (bool)m_fixed_eh || (bool)m_batch_eh; }
 
         bool propagate_cb(unsigned num_fixed, expr* const* fixed_ids, unsigned num_eqs, expr* const* lhs, expr* const* rhs, expr* conseq) override;
         void register_cb(expr* e) override;
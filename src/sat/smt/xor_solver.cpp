@@ -3,77 +3,263 @@ Copyright (c) 2014 Microsoft Corporation
 
 Module Name:
 
-    xor_solver.h
+    xor_solver.cpp
 
 Abstract:
 
     XOR solver.
-    Interface outline.
 
 --*/
 
 
 #include "sat/smt/xor_solver.h"
-#include "sat/sat_simplifier_params.hpp"
 #include "sat/sat_xor_finder.h"
+#include "math/simplex/bit_matrix.h"
 
 namespace xr {
 
+    constraint::constraint(unsigned n, sat::bool_var const* vars, bool rhs):
+        m_size(n), m_rhs(rhs) {
+        for (unsigned i = 0; i < n; ++i)
+            m_vars[i] = vars[i];
+    }
+
+    std::ostream& constraint::display(std::ostream& out) const {
+        out << "xor";
+        for (sat::bool_var v : *this)
+            out << " " << v;
+        return out << " = " << m_rhs;
+    }
+
     solver::solver(euf::solver& ctx):
-        th_solver(ctx.get_manager(), symbol("xor-solver"), ctx.get_manager().get_family_id("xor-solver"))
+        th_solver(ctx.get_manager(), symbol("xor-solver"), ctx.get_manager().mk_family_id("xor-solver"))
     {}
 
     euf::th_solver* solver::clone(euf::solver& ctx) {
-        // and relevant copy internal state
+        // xors are extracted again from the clauses of the copy
         return alloc(solver, ctx);
     }
 
+    /**
+       \brief extract xors from the clauses of the base level and
+       add the rows of their reduced row echelon form.
+       The extracted variables are external, so they are not eliminated
+       and the xors remain implied by the clauses after in-processing.
+    */
+    void solver::init_search() {
+        if (m_initialized || s().scope_lvl() > 0 || s().num_user_scopes() > 0 || s().get_config().m_drat)
+            return;
+        m_initialized = true;
+        vector<sat::literal_vector> xors;
+        std::function<void(sat::literal_vector const&)> on_xor = [&](sat::literal_vector const& x) {
+            xors.push_back(x);
+        };
+        sat::clause_vector clauses(s().clauses());
+        sat::xor_finder xf(s());
+        xf.set(on_xor);
+        xf(clauses);
+        gauss_jordan(xors);
+        IF_VERBOSE(2, verbose_stream() << "(sat.xor :extracted " << xors.size() << " :rows " << m_constraints.size() << ")\n");
+    }
+
+    /**
+       \brief the xor finder produces literals whose xor is true.
+       Each xor becomes a row over the columns of its variables together with
+       a constant column for the right-hand side.
+       A reduced row without variables and a true right-hand side is a conflict.
+    */
+    void solver::gauss_jordan(vector<sat::literal_vector> const& xors) {
+        if (xors.empty())
+            return;
+        unsigned_vector var2col;
+        sat::bool_var_vector col2var;
+        for (auto const& x : xors) {
+            for (sat::literal l : x) {
+                var2col.reserve(l.var() + 1, UINT_MAX);
+                if (var2col[l.var()] == UINT_MAX) {
+                    var2col[l.var()] = col2var.size();
+                    col2var.push_back(l.var());
+                }
+            }
+        }
+        unsigned const_col = col2var.size();
+        bit_matrix bm;
+        bm.reset(const_col + 1);
+        for (auto const& x : xors) {
+            auto row = bm.add_row();
+            bool rhs = true;
+            for (sat::literal l : x) {
+                unsigned col = var2col[l.var()];
+                row.set(col, !row[col]);
+                rhs ^= l.sign();
+            }
+            row.set(const_col, rhs);
+        }
+        bm.solve();
+        TRACE("xor", tout << bm << "\n";);
+
+        sat::bool_var_vector vars;
+        for (auto const& row : bm) {
+            vars.reset();
+            bool rhs = false;
+            for (unsigned col : row) {
+                if (col == const_col)
+                    rhs = true;
+                else
+                    vars.push_back(col2var[col]);
+            }
+            if (!vars.empty())
+                add_xor(vars, rhs);
+            else if (rhs) {
+                s().set_conflict();
+                return;
+            }
+        }
+    }
+
+    void solver::add_xor(sat::bool_var_vector const& vars, bool rhs) {
+        void* mem = m_region.allocate(constraint::get_obj_size(vars.size()));
+        sat::constraint_base::initialize(mem, this);
+        constraint* c = new (sat::constraint_base::ptr2mem(mem)) constraint(vars.size(), vars.data(), rhs);
+        m_constraints.push_back(c);
+        ++m_stats.m_num_xors;
+        unsigned num_undef = 0;
+        for (unsigned i = 0; i < c->size(); ++i)
+            if (s().value((*c)[i]) == l_undef)
+                c->swap(i, num_undef++);
+        if (c->size() >= 2) {
+            watch_var(*c, (*c)[0]);
+            watch_var(*c, (*c)[1]);
+        }
+        if (num_undef < 2)
+            m_prop_queue.push_back(c);
+    }
+
+    /**
+       \brief watch both polarities of v, so that the constraint is visited
+       when v is assigned.
+    */
+    void solver::watch_var(constraint const& c, sat::bool_var v) {
+        sat::watched w(c.cindex());
+        s().get_wlist(sat::literal(v, false)).push_back(w);
+        s().get_wlist(sat::literal(v, true)).push_back(w);
+    }
+
     void solver::asserted(sat::literal l) {
+    }
+
+    /**
+       \brief the watched variable of l is assigned.
+       Move the watch to an unassigned variable if there is one,
+       otherwise propagate or detect a conflict.
+       The watch of l is kept when the function returns true.
+    */
+    bool solver::propagated(sat::literal l, sat::ext_constraint_idx idx) {
+        constraint& c = index2constraint(idx);
+        if (c[0] != l.var())
+            c.swap(0, 1);
+        SASSERT(c[0] == l.var());
+        for (unsigned i = 2; i < c.size(); ++i) {
+            if (s().value(c[i]) == l_undef) {
+                c.swap(0, i);
+                s().get_wlist(~l).erase(sat::watched(idx));
+                watch_var(c, c[0]);
+                return false;
+            }
+        }
+        propagate(c);
+        return true;
+    }
 
+    void solver::propagate(constraint const& c) {
+        bool parity = c.rhs();
+        sat::bool_var u = sat::null_bool_var;
+        for (sat::bool_var v : c) {
+            switch (s().value(v)) {
+            case l_true:
+                parity = !parity;
+                break;
+            case l_undef:
+                if (u != sat::null_bool_var)
+                    return;
+                u = v;
+                break;
+            default:
+                break;
+            }
+        }
+        auto j = sat::justification::mk_ext_justification(s().scope_lvl(), c.cindex());
+        if (u != sat::null_bool_var) {
+            ++m_stats.m_num_propagations;
+            s().assign(sat::literal(u, !parity), j);
+        }
+        else if (parity) {
+            ++m_stats.m_num_conflicts;
+            s().set_conflict(j, true_literal(c[0]));
+        }
     }
 
     bool solver::unit_propagate() {
-        return false;
+        if (m_prop_queue.empty())
+            return false;
+        for (unsigned i = 0; i < m_prop_queue.size() && !s().inconsistent(); ++i)
+            propagate(*m_prop_queue[i]);
+        m_prop_queue.reset();
+        return true;
     }
-    
+
+    /**
+       \brief all variables other than the variable of l are assigned
+       and their values imply l.
+    */
     void solver::get_antecedents(sat::literal l, sat::ext_justification_idx idx,
                                  sat::literal_vector & r, bool probing) {
-        
+        constraint const& c = index2constraint(idx);
+        for (sat::bool_var v : c)
+            if (v != l.var())
+                r.push_back(true_literal(v));
     }
-    
+
     sat::check_result solver::check() {
         return sat::check_result::CR_DONE;
     }
-    
+
     void solver::push() {
     }
-    
+
     void solver::pop(unsigned n) {
+        m_prop_queue.reset();
     }
 
     // inprocessing
-    // pre_simplify: decompile all xor constraints to allow other in-processing.
-    // simplify: recompile clauses to xor constraints
-    // literals that get added to xor constraints are tagged with the theory.
+    // xors are only extracted once from the base level clauses and
+    // propagate over external variables, so in-processing leaves them intact.
     void solver::pre_simplify() {
-        
+
     }
 
     void solver::simplify() {
-        
+
     }
 
     std::ostream& solver::display(std::ostream& out) const {
+        for (constraint const* c : m_constraints)
+            c->display(out) << "\n";
         return out;
     }
-    
+
     std::ostream& solver::display_justification(std::ostream& out, sat::ext_justification_idx idx) const  {
-        return out;
+        return display_constraint(out, idx);
     }
-    
+
     std::ostream& solver::display_constraint(std::ostream& out, sat::ext_constraint_idx idx) const {
-        return out;
+        return index2constraint(idx).display(out);
     }
-    
-}
 
+    void solver::collect_statistics(statistics& st) const {
+        st.update("xor constraints", m_stats.m_num_xors);
+        st.update("xor propagations", m_stats.m_num_propagations);
+        st.update("xor conflicts", m_stats.m_num_conflicts);
+    }
+
+}
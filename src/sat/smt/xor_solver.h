@@ -8,27 +8,78 @@ Module Name:
 Abstract:
 
     XOR solver.
-    Interface outline.
+
+    Xor constraints are extracted from the input clauses and
+    reduced by Gauss-Jordan elimination over a bit-packed matrix.
+    The rows of the reduced matrix are watched on two variables,
+    similar to watched columns in CryptoMiniSat: a row propagates
+    when all but one of its variables are assigned and it is in
+    conflict when all variables are assigned with the wrong parity.
 
 --*/
 
 #pragma once
 
+#include "util/region.h"
 #include "sat/smt/euf_solver.h"
 
 namespace xr {
+
+    /**
+       \brief xor of m_vars equals m_rhs.
+       The variables at positions 0 and 1 are watched.
+    */
+    class constraint {
+        unsigned       m_size;
+        bool           m_rhs;
+        sat::bool_var  m_vars[0];
+    public:
+        static size_t get_obj_size(unsigned num_vars) { return sat::constraint_base::obj_size(sizeof(constraint) + num_vars * sizeof(sat::bool_var)); }
+        constraint(unsigned n, sat::bool_var const* vars, bool rhs);
+        unsigned size() const { return m_size; }
+        bool rhs() const { return m_rhs; }
+        sat::bool_var operator[](unsigned i) const { return m_vars[i]; }
+        sat::bool_var const* begin() const { return m_vars; }
+        sat::bool_var const* end() const { return m_vars + m_size; }
+        void swap(unsigned i, unsigned j) { std::swap(m_vars[i], m_vars[j]); }
+        size_t cindex() const { return sat::constraint_base::mem2base(this); }
+        std::ostream& display(std::ostream& out) const;
+    };
+
     class solver : public euf::th_solver {
+
+        struct stats {
+            unsigned m_num_xors = 0;
+            unsigned m_num_propagations = 0;
+            unsigned m_num_conflicts = 0;
+            void reset() { memset(this, 0, sizeof(*this)); }
+        };
+
+        region                    m_region;
+        ptr_vector<constraint>    m_constraints;
+        ptr_vector<constraint>    m_prop_queue;    // constraints with less than two unassigned variables
+        bool                      m_initialized = false;
+        stats                     m_stats;
+
+        constraint& index2constraint(size_t idx) const { return *reinterpret_cast<constraint*>(sat::constraint_base::idx2mem(idx)); }
+        void gauss_jordan(vector<sat::literal_vector> const& xors);
+        void add_xor(sat::bool_var_vector const& vars, bool rhs);
+        void watch_var(constraint const& c, sat::bool_var v);
+        void propagate(constraint const& c);
+        sat::literal true_literal(sat::bool_var v) const { return sat::literal(v, s().value(v) == l_false); }
+
     public:
         solver(euf::solver& ctx);
-        
+
         th_solver* clone(euf::solver& ctx) override;
 
         sat::literal internalize(expr* e, bool sign, bool root)  override { UNREACHABLE(); return sat::null_literal; }
 
         void internalize(expr* e) override { UNREACHABLE(); }
 
-
+        void init_search() override;
         void asserted(sat::literal l) override;
+        bool propagated(sat::literal l, sat::ext_constraint_idx idx) override;
         bool unit_propagate() override;
         void get_antecedents(sat::literal l, sat::ext_justification_idx idx, sat::literal_vector & r, bool probing) override;
 
@@ -42,6 +93,7 @@ namespace xr {
         std::ostream& display(std::ostream& out) const override;
         std::ostream& display_justification(std::ostream& out, sat::ext_justification_idx idx) const override;
         std::ostream& display_constraint(std::ostream& out, sat::ext_constraint_idx idx) const override;
+        void collect_statistics(statistics& st) const override;
 
     };
 
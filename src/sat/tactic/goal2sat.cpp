@@ -60,8 +60,9 @@ struct goal2sat::imp : public sat::sat_internalizer {
     pb_util                     pb;
     svector<frame>              m_frame_stack;
     svector<sat::literal>       m_result_stack;
-    obj_map<app, sat::literal>  m_app2lit;
-    u_map<app*>                 m_lit2app;
+    svector<sat::literal>       m_app2lit;      // indexed by expression id
+    ptr_vector<app>             m_lit2app;      // indexed by literal index
+    unsigned_vector             m_cached_ids;   // ids entered in m_app2lit since the last reset
     unsigned_vector             m_cache_lim;
     app_ref_vector              m_cache_trail;
     obj_hashtable<expr>         m_interface_vars;
@@ -196,7 +197,7 @@ struct goal2sat::imp : public sat::sat_internalizer {
         sat::bool_var v = m_map.to_bool_var(e);
         if (v != sat::null_bool_var) 
             return v;
-        if (is_app(e) && m_app2lit.find(to_app(e), l) && !l.sign()) 
+        if (is_app(e) && find_cached(to_app(e), l) && !l.sign()) 
             return l.var();
         return sat::null_bool_var;
     }
@@ -248,37 +249,60 @@ struct goal2sat::imp : public sat::sat_internalizer {
         unsigned k = m_cache_lim[m_cache_lim.size() - n];
         for (unsigned i = m_cache_trail.size(); i-- > k; ) {
             app* t = m_cache_trail.get(i);
-            sat::literal lit;
-            if (m_app2lit.find(t, lit)) {
-                m_app2lit.remove(t);
-                m_lit2app.remove(lit.index());
-            }
+            remove_cached(t);
         }
         m_cache_trail.shrink(k);
         m_cache_lim.shrink(m_cache_lim.size() - n);    
     }
 
+    bool find_cached(app* t, sat::literal& lit) const {
+        unsigned id = t->get_id();
+        lit = id < m_app2lit.size() ? m_app2lit[id] : sat::null_literal;
+        return lit != sat::null_literal;
+    }
+
+    void remove_cached(app* t) {
+        sat::literal lit;
+        if (find_cached(t, lit)) {
+            m_app2lit[t->get_id()] = sat::null_literal;
+            m_lit2app[lit.index()] = nullptr;
+        }
+    }
+
+    void reset_cache() {
+        for (unsigned id : m_cached_ids) {
+            sat::literal lit = m_app2lit[id];
+            if (lit != sat::null_literal) {
+                m_app2lit[id] = sat::null_literal;
+                m_lit2app[lit.index()] = nullptr;
+            }
+        }
+        m_cached_ids.reset();
+    }
+
     // remove non-external literals from cache.
     void uncache(sat::literal lit) override {    
-        app* t = nullptr;
-        if (m_lit2app.find(lit.index(), t)) {
-            m_lit2app.remove(lit.index());
-            m_app2lit.remove(t);
-        }     
+        app* t = lit.index() < m_lit2app.size() ? m_lit2app[lit.index()] : nullptr;
+        if (t) 
+            remove_cached(t);
     }
 
     void cache(app* t, sat::literal l) override {
         force_push();
-        SASSERT(!m_app2lit.contains(t));
-        SASSERT(!m_lit2app.contains(l.index()));
-        m_app2lit.insert(t, l);
-        m_lit2app.insert(l.index(), t);
+        unsigned id = t->get_id();
+        m_app2lit.reserve(id + 1, sat::null_literal);
+        m_lit2app.reserve(l.index() + 1, nullptr);
+        SASSERT(m_app2lit[id] == sat::null_literal);
+        SASSERT(!m_lit2app[l.index()]);
+        m_app2lit[id] = l;
+        m_lit2app[l.index()] = t;
+        m_cached_ids.push_back(id);
         m_cache_trail.push_back(t);
     }
 
     sat::literal get_cached(app* t) const override {
-        sat::literal lit = sat::null_literal;
-        m_app2lit.find(t, lit);
+        sat::literal lit;
+        find_cached(t, lit);
         return lit;
     }
 
@@ -354,7 +378,7 @@ struct goal2sat::imp : public sat::sat_internalizer {
 
     bool process_cached(app* t, bool root, bool sign) {
         sat::literal l = sat::null_literal;
-        if (!m_app2lit.find(t, l))
+        if (!find_cached(t, l))
             return false;
         if (sign)
             l.neg();
@@ -923,8 +947,7 @@ struct goal2sat::imp : public sat::sat_internalizer {
         scoped_reset(imp& i) :i(i) {}
         ~scoped_reset() {
             i.m_interface_vars.reset();
-            i.m_app2lit.reset();
-            i.m_lit2app.reset();
+            i.reset_cache();
         }
     };
     
@@ -18,6 +18,7 @@ Revision History:
 
 --*/
 #include<iostream>
+#include<vector>
 #include "util/memory_manager.h"
 #include "util/trace.h"
 #include "util/debug.h"
@@ -38,6 +39,7 @@ Revision History:
 #include "util/env_params.h"
 #include "util/file_path.h"
 #include "shell/drat_frontend.h"
+#include "shell/tune_frontend.h"
 
 #if defined( _WINDOWS ) && defined( __MINGW32__ ) && ( defined( __GNUG__ ) || defined( __clang__ ) )
 #include <crtdbg.h>
@@ -47,11 +49,13 @@ typedef enum { IN_UNSPECIFIED, IN_SMTLIB_2, IN_DATALOG, IN_DIMACS, IN_WCNF, IN_O
 
 static char const * g_input_file          = nullptr;
 static char const * g_drat_input_file     = nullptr;
+static std::vector<char const*> g_extra_input_files; // further SMT2 files processed by the same process
 static bool         g_standard_input      = false;
 static input_kind   g_input_kind          = IN_UNSPECIFIED;
 bool                g_display_statistics  = false;
 bool                g_display_model       = false;
 static bool         g_display_istatistics = false;
+static char const * g_tune_space          = nullptr;
 
 static void error(const char * msg) {
     std::cerr << "Error: " << msg << "\n";
@@ -75,7 +79,8 @@ void display_usage() {
     std::cout << " - build hashcode " << STRINGIZE_VALUE_OF(Z3GITHASH);
 #endif
     std::cout << "]. (C) Copyright 2006-2016 Microsoft Corp.\n";
-    std::cout << "Usage: z3 [options] [-file:]file\n";
+    std::cout << "Usage: z3 [options] [-file:]file [file ...]\n";
+    std::cout << "Several SMT2 files are processed one after the other in the same process, each with a fresh context.\n";
     std::cout << "\nInput format:\n";
     std::cout << "  -smt2       use parser for SMT 2 input format.\n";
     std::cout << "  -dl         use parser for Datalog input format.\n";
@@ -121,7 +126,10 @@ void display_usage() {
     std::cout << "Global and module parameters can be set in the command line.\n";
     std::cout << "  param_name=value              for setting global parameters.\n";
     std::cout << "  module_name.param_name=value  for setting module parameters.\n";
+    std::cout << "  -params:file                  for setting the parameters listed as param_name=value lines in a file.\n";
     std::cout << "Use 'z3 -p' for the complete list of global and module parameters.\n";
+    std::cout << "\nParameter tuning:\n";
+    std::cout << "  -tune:file  race parameter configurations from the search space in <file> on the input files and write the best one as a parameter file.\n";
 }
    
 static void parse_cmd_line_args(std::string& input_file, int argc, char ** argv) {
@@ -289,6 +297,16 @@ static void parse_cmd_line_args(std::string& input_file, int argc, char ** argv)
                     error("option argument (-memory:val) is missing.");
                 gparams::set("memory_max_size", opt_arg);
             }
+            else if (strcmp(opt_name, "params") == 0) {
+                if (!opt_arg)
+                    error("option argument (-params:file) is missing.");
+                load_params_file(opt_arg);
+            }
+            else if (strcmp(opt_name, "tune") == 0) {
+                if (!opt_arg)
+                    error("option argument (-tune:file) is missing.");
+                g_tune_space = opt_arg;
+            }
             else if (strcmp(opt_name, "tactics") == 0) {
                 if (!opt_arg)
                     help_tactics();
@@ -323,7 +341,7 @@ static void parse_cmd_line_args(std::string& input_file, int argc, char ** argv)
                 g_drat_input_file = arg;
             }
             else if (g_input_file) 
-                warning_msg("input file was already specified.");
+                g_extra_input_files.push_back(arg);
             else 
                 g_input_file = arg;
         }
@@ -350,6 +368,14 @@ int STD_CALL main(int argc, char ** argv) {
         if (!g_input_file && !g_standard_input) {
             error("input file was not specified.");
         }
+        if (g_tune_space) {
+            if (!g_input_file)
+                error("-tune requires input files, it cannot read from standard input.");
+            std::vector<char const*> files;
+            files.push_back(g_input_file);
+            files.insert(files.end(), g_extra_input_files.begin(), g_extra_input_files.end());
+            return tune_params(argv[0], g_tune_space, static_cast<unsigned>(files.size()), files.data());
+        }
         
         if (g_input_kind == IN_UNSPECIFIED) {
             g_input_kind = IN_SMTLIB_2;
@@ -378,10 +404,17 @@ int STD_CALL main(int argc, char ** argv) {
                 }
             }
         }
+        if (!g_extra_input_files.empty() && g_input_kind != IN_SMTLIB_2) 
+            warning_msg("input file was already specified.");
         switch (g_input_kind) {
         case IN_SMTLIB_2:
             memory::exit_when_out_of_memory(true, "(error \"out of memory\")");
             return_value = read_smtlib2_commands(g_input_file);
+            for (char const* file : g_extra_input_files) {
+                unsigned r = read_smtlib2_commands(file);
+                if (r != 0)
+                    return_value = r;
+            }
             break;
         case IN_DIMACS:
             return_value = read_dimacs(g_input_file);
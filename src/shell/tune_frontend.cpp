@@ -0,0 +1,386 @@
+/*++
+Copyright (c) 2024 Microsoft Corporation
+
+Module Name:
+
+    tune_frontend.cpp
+
+Abstract:
+
+    Racing based parameter tuning in the style of irace.
+
+    z3 -tune:space.txt file1.smt2 file2.smt2 ...
+
+    The search space file lists the parameters to tune with their candidate
+    values, together with options of the tuner:
+
+        # comment
+        param smt.relevancy 0 1 2
+        param sat.restart ema luby geometric
+        timeout 10          seconds per run
+        threads 4           runs evaluated in parallel
+        configs 12          configurations raced in each iteration
+        iterations 3        number of races
+        min_instances 5     instances evaluated before configurations are dropped
+        seed 0
+        output tuned.params
+
+    Every run is a separate process of the executable, so configurations that
+    set different global parameters are evaluated in parallel.
+    An instance is solved when the first sat or unsat line of the output is
+    printed before the timeout; the run is still timed until the process exits.
+    A configuration costs the run time of the instances it solves and twice the
+    timeout for the other instances (PAR2). A race evaluates the configurations
+    instance by instance and drops those that are clearly worse than the best one.
+    The next race starts from the elite of the previous one and mutations of it.
+    The best configuration is written as a parameter file that is loaded with
+    z3 -params:tuned.params.
+
+--*/
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <map>
+#include <algorithm>
+#include <climits>
+#include <limits>
+#include <cstdio>
+#ifndef SINGLE_THREAD
+#include <thread>
+#include <atomic>
+#include <mutex>
+#endif
+#include "util/util.h"
+#include "util/trace.h"
+#include "util/stopwatch.h"
+#include "util/gparams.h"
+#include "util/z3_exception.h"
+#include "util/warning.h"
+#include "shell/tune_frontend.h"
+
+#ifdef _WINDOWS
+#define popen _popen
+#define pclose _pclose
+#endif
+
+namespace {
+
+    std::string trim(std::string const& s) {
+        size_t b = s.find_first_not_of(" \t\r\n");
+        if (b == std::string::npos)
+            return std::string();
+        size_t e = s.find_last_not_of(" \t\r\n");
+        return s.substr(b, e - b + 1);
+    }
+
+    struct tune_param {
+        std::string              m_name;
+        std::vector<std::string> m_values;
+    };
+
+    // a configuration picks a value for each parameter, UINT_MAX keeps the default.
+    struct tune_config {
+        std::vector<unsigned> m_choice;
+        double                m_cost = 0;
+        bool                  m_alive = true;
+    };
+
+    struct run_result {
+        double      m_cost = 0;
+        std::string m_status;
+    };
+
+    class tuner {
+        std::string              m_exe;
+        std::vector<std::string> m_files;
+        std::vector<tune_param>  m_params;
+        unsigned                 m_timeout = 10;
+        unsigned                 m_threads = 1;
+        unsigned                 m_num_configs = 12;
+        unsigned                 m_iterations = 3;
+        unsigned                 m_min_instances = 5;
+        std::string              m_output = "tuned.params";
+        random_gen               m_rand;
+        std::map<std::pair<std::string, unsigned>, double> m_cache; // cost of a configuration on a file
+        std::vector<std::string> m_status;                          // sat or unsat if some run decided the file
+
+        // a configuration is dropped when its cost exceeds that of the best one by this factor and slack
+        static constexpr double  m_margin = 1.2;
+        static constexpr double  m_slack = 0.5;
+
+        std::string to_args(tune_config const& c) const {
+            std::string r;
+            for (unsigned i = 0; i < m_params.size(); ++i)
+                if (c.m_choice[i] != UINT_MAX)
+                    r += " " + m_params[i].m_name + "=" + m_params[i].m_values[c.m_choice[i]];
+            return r;
+        }
+
+        unsigned random_value(unsigned i) {
+            unsigned n = static_cast<unsigned>(m_params[i].m_values.size());
+            unsigned r = m_rand(n + 1);
+            return r == n ? UINT_MAX : r;
+        }
+
+        tune_config random_config() {
+            tune_config c;
+            for (unsigned i = 0; i < m_params.size(); ++i)
+                c.m_choice.push_back(random_value(i));
+            return c;
+        }
+
+        tune_config mutate(tune_config const& c) {
+            tune_config r;
+            r.m_choice = c.m_choice;
+            unsigned num_changes = 1 + m_rand(2);
+            for (unsigned k = 0; k < num_changes; ++k) {
+                unsigned i = m_rand(static_cast<unsigned>(m_params.size()));
+                r.m_choice[i] = random_value(i);
+            }
+            return r;
+        }
+
+        // run the executable on a file; the status is the first sat or unsat line of its output,
+        // so that models and the results of later check-sat commands are ignored.
+        run_result run(std::string const& args, unsigned f) const {
+            std::string cmd = "\"" + m_exe + "\" -T:" + std::to_string(m_timeout) + args + " \"" + m_files[f] + "\" 2>&1";
+            run_result r;
+            stopwatch sw;
+            sw.start();
+            FILE* out = popen(cmd.c_str(), "r");
+            if (!out)
+                throw default_exception("could not run " + cmd);
+            char buffer[4096];
+            while (fgets(buffer, sizeof(buffer), out)) {
+                std::string line = trim(buffer);
+                if (r.m_status.empty() && (line == "sat" || line == "unsat"))
+                    r.m_status = line;
+            }
+            pclose(out);
+            sw.stop();
+            bool solved = r.m_status == "sat" || r.m_status == "unsat";
+            r.m_cost = solved ? std::min(sw.get_seconds(), static_cast<double>(m_timeout)) : 2.0 * m_timeout;
+            IF_VERBOSE(2, verbose_stream() << "(tune " << m_files[f] << args << " :status " << r.m_status << " :cost " << r.m_cost << ")\n");
+            return r;
+        }
+
+        // evaluate the live configurations on file f, in parallel, and add the costs.
+        void evaluate(std::vector<tune_config>& configs, unsigned f) {
+            std::vector<std::string> tasks;
+            for (auto const& c : configs) {
+                std::string args = to_args(c);
+                if (c.m_alive && !m_cache.count({ args, f }) && std::find(tasks.begin(), tasks.end(), args) == tasks.end())
+                    tasks.push_back(args);
+            }
+            std::vector<run_result> results(tasks.size());
+#ifndef SINGLE_THREAD
+            std::atomic<unsigned> next(0);
+            std::string ex_msg;
+            std::mutex mux;
+            auto worker = [&]() {
+                try {
+                    for (unsigned j = next++; j < tasks.size(); j = next++)
+                        results[j] = run(tasks[j], f);
+                }
+                catch (z3_exception& ex) {
+                    std::lock_guard<std::mutex> lock(mux);
+                    ex_msg = ex.msg();
+                    next = static_cast<unsigned>(tasks.size());
+                }
+            };
+            std::vector<std::thread> threads;
+            for (unsigned i = 0; i < std::min(m_threads, static_cast<unsigned>(tasks.size())); ++i)
+                threads.push_back(std::thread(worker));
+            for (auto& th : threads)
+                th.join();
+            if (!ex_msg.empty())
+                throw default_exception(std::move(ex_msg));
+#else
+            for (unsigned j = 0; j < tasks.size(); ++j)
+                results[j] = run(tasks[j], f);
+#endif
+            for (unsigned j = 0; j < tasks.size(); ++j) {
+                auto const& r = results[j];
+                double cost = r.m_cost;
+                if (r.m_status == "sat" || r.m_status == "unsat") {
+                    if (m_status[f].empty())
+                        m_status[f] = r.m_status;
+                    else if (m_status[f] != r.m_status) {
+                        warning_msg("configuration%s returns %s on %s, other configurations returned %s",
+                                    tasks[j].c_str(), r.m_status.c_str(), m_files[f].c_str(), m_status[f].c_str());
+                        cost = std::numeric_limits<double>::max() / 4;
+                    }
+                }
+                m_cache[{ tasks[j], f }] = cost;
+            }
+            for (auto& c : configs)
+                if (c.m_alive)
+                    c.m_cost += m_cache[{ to_args(c), f }];
+        }
+
+        // race the configurations over the files in random order, return the survivors by increasing cost.
+        std::vector<tune_config> race(std::vector<tune_config> configs) {
+            std::vector<unsigned> order;
+            for (unsigned f = 0; f < m_files.size(); ++f)
+                order.push_back(f);
+            for (unsigned i = static_cast<unsigned>(order.size()); i > 1; --i)
+                std::swap(order[i - 1], order[m_rand(i)]);
+            for (auto& c : configs)
+                c.m_cost = 0, c.m_alive = true;
+            for (unsigned k = 0; k < order.size(); ++k) {
+                evaluate(configs, order[k]);
+                if (k + 1 < m_min_instances)
+                    continue;
+                double best = std::numeric_limits<double>::max();
+                for (auto const& c : configs)
+                    if (c.m_alive)
+                        best = std::min(best, c.m_cost);
+                for (auto& c : configs)
+                    if (c.m_alive && c.m_cost > m_margin * best + m_slack)
+                        c.m_alive = false;
+            }
+            std::vector<tune_config> result;
+            for (auto const& c : configs)
+                if (c.m_alive)
+                    result.push_back(c);
+            std::stable_sort(result.begin(), result.end(), [](tune_config const& a, tune_config const& b) { return a.m_cost < b.m_cost; });
+            return result;
+        }
+
+        void add_unique(std::vector<tune_config>& configs, tune_config const& c) {
+            std::string args = to_args(c);
+            for (auto const& d : configs)
+                if (to_args(d) == args)
+                    return;
+            configs.push_back(c);
+        }
+
+        void read_space(char const* file) {
+            std::ifstream in(file);
+            if (!in)
+                throw default_exception(std::string("could not open search space file ") + file);
+            std::string line;
+            while (std::getline(in, line)) {
+                line = trim(line.substr(0, line.find('#')));
+                if (line.empty())
+                    continue;
+                std::istringstream strm(line);
+                std::string key;
+                strm >> key;
+                if (key == "param") {
+                    tune_param p;
+                    strm >> p.m_name;
+                    std::string v;
+                    while (strm >> v)
+                        p.m_values.push_back(v);
+                    if (p.m_name.empty() || p.m_values.empty())
+                        throw default_exception("parameter without values in search space: " + line);
+                    m_params.push_back(p);
+                    continue;
+                }
+                std::string value;
+                strm >> value;
+                if (key == "output")
+                    m_output = value;
+                else if (key == "timeout")
+                    m_timeout = std::stoul(value);
+                else if (key == "threads")
+                    m_threads = get_num_threads(std::stoul(value));
+                else if (key == "configs")
+                    m_num_configs = std::stoul(value);
+                else if (key == "iterations")
+                    m_iterations = std::stoul(value);
+                else if (key == "min_instances")
+                    m_min_instances = std::stoul(value);
+                else if (key == "seed")
+                    m_rand.set_seed(std::stoul(value));
+                else
+                    throw default_exception("unknown option in search space: " + line);
+            }
+            if (m_params.empty())
+                throw default_exception("the search space has no parameters");
+        }
+
+    public:
+        tuner(char const* exe, unsigned num_files, char const* const* files):
+            m_exe(exe), m_files(files, files + num_files), m_status(num_files) {}
+
+        unsigned operator()(char const* space_file) {
+            read_space(space_file);
+            if (m_files.empty())
+                throw default_exception("no benchmark files to tune on");
+            m_min_instances = std::min(m_min_instances, static_cast<unsigned>(m_files.size()));
+            m_num_configs = std::max(m_num_configs, 2u);
+
+            tune_config default_config;
+            default_config.m_choice.resize(m_params.size(), UINT_MAX);
+            std::vector<tune_config> configs;
+            configs.push_back(default_config);
+            for (unsigned i = 0; configs.size() < m_num_configs && i < 10 * m_num_configs; ++i)
+                add_unique(configs, random_config());
+
+            std::vector<tune_config> elite;
+            for (unsigned it = 0; it < m_iterations; ++it) {
+                elite = race(configs);
+                elite.resize(std::max(1u, std::min(static_cast<unsigned>(elite.size()), m_num_configs / 3)));
+                IF_VERBOSE(1, verbose_stream() << "(tune :iteration " << it << " :best-cost " << elite[0].m_cost << " :best" << to_args(elite[0]) << ")\n");
+                configs = elite;
+                for (unsigned i = 0; configs.size() < m_num_configs && i < 10 * m_num_configs; ++i)
+                    add_unique(configs, mutate(elite[m_rand(static_cast<unsigned>(elite.size()))]));
+            }
+
+            // compare the best configuration with the default on all files.
+            std::vector<tune_config> final_configs;
+            final_configs.push_back(elite[0]);
+            add_unique(final_configs, default_config);
+            for (auto& c : final_configs)
+                c.m_cost = 0, c.m_alive = true;
+            for (unsigned f = 0; f < m_files.size(); ++f)
+                evaluate(final_configs, f);
+            // keep the default unless the tuned configuration is better
+            tune_config best = final_configs[0];
+            double default_cost = best.m_cost;
+            if (final_configs.size() > 1) {
+                default_cost = final_configs[1].m_cost;
+                if (default_cost <= best.m_cost)
+                    best = final_configs[1];
+            }
+
+            std::ofstream out(m_output);
+            if (!out)
+                throw default_exception("could not write " + m_output);
+            out << "# tuned on " << m_files.size() << " files with a timeout of " << m_timeout << "s\n";
+            out << "# PAR2 cost " << best.m_cost << ", default cost " << default_cost << "\n";
+            for (unsigned i = 0; i < m_params.size(); ++i)
+                if (best.m_choice[i] != UINT_MAX)
+                    out << m_params[i].m_name << "=" << m_params[i].m_values[best.m_choice[i]] << "\n";
+            std::cout << "tuned configuration:" << (best.m_choice == default_config.m_choice ? " default" : to_args(best))
+                      << "\ncost: " << best.m_cost << " default cost: " << default_cost << "\nwritten to " << m_output << "\n";
+            return 0;
+        }
+    };
+}
+
+unsigned tune_params(char const* exe, char const* space_file, unsigned num_files, char const* const* files) {
+    tuner t(exe, num_files, files);
+    return t(space_file);
+}
+
+void load_params_file(char const* file) {
+    std::ifstream in(file);
+    if (!in)
+        throw default_exception(std::string("could not open parameter file ") + file);
+    std::string line;
+    while (std::getline(in, line)) {
+        line = trim(line.substr(0, line.find('#')));
+        if (line.empty())
+            continue;
+        size_t eq = line.find('=');
+        if (eq == std::string::npos)
+            throw default_exception("invalid line in parameter file " + std::string(file) + ": " + line);
+        std::string key = trim(line.substr(0, eq)), value = trim(line.substr(eq + 1));
+        gparams::set(key.c_str(), value.c_str());
+    }
+}
@@ -0,0 +1,17 @@
+/*++
+Copyright (c) 2024 Microsoft Corporation
+
+Module Name:
+
+    tune_frontend.h
+
+Abstract:
+
+    Parameter tuning of the command line tool on a benchmark corpus.
+
+--*/
+#pragma once
+
+unsigned tune_params(char const* exe, char const* space_file, unsigned num_files, char const* const* files);
+
+void load_params_file(char const* file);
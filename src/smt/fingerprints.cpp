@@ -62,8 +62,16 @@ namespace smt {
     }
 
     
-    fingerprint * fingerprint_set::insert(void * data, unsigned data_hash, unsigned num_args, enode * const * args, expr* def) {
-        
+    /**
+       \brief create the lookup key for (data args[0] ... args[num_args-1]).
+       The arguments are replaced by their roots and the hash is taken over
+       the roots, so a single lookup finds fingerprints of congruent arguments.
+    */
+    fingerprint * fingerprint_set::mk_key(void * data, unsigned data_hash, unsigned num_args, enode * const * args) {
+        fingerprint * d = mk_dummy(data, data_hash, num_args, args);
+        for (unsigned i = 0; i < num_args; i++)
+            d->m_args[i] = d->m_args[i]->get_root();
+
         struct arg_data {
             unsigned data_hash;
             enode* const* args;
@@ -78,22 +86,21 @@ namespace smt {
                 return d.args[i]->hash();
             }
         };
-        arg_data arg_data({ data_hash, args });
+        arg_data arg_data({ data_hash, d->m_args });
         khash kh;
         arghash ah;
-        data_hash = get_composite_hash(arg_data, num_args, kh, ah);
-
-        fingerprint * d = mk_dummy(data, data_hash, num_args, args);
-        if (m_set.contains(d)) 
-            return nullptr;
-        for (unsigned i = 0; i < num_args; i++)
-            d->m_args[i] = d->m_args[i]->get_root();
+        d->m_data_hash = get_composite_hash(arg_data, num_args, kh, ah);
+        return d;
+    }
+    
+    fingerprint * fingerprint_set::insert(void * data, unsigned data_hash, unsigned num_args, enode * const * args, expr* def) {
+        fingerprint * d = mk_key(data, data_hash, num_args, args);
         if (m_set.contains(d)) {
             TRACE("fingerprint_bug", tout << "failed: " << *d;);
             return nullptr;
         }
         TRACE("fingerprint_bug", tout << "inserting @" << m_scopes.size() << " " << *d;);
-        fingerprint * f = new (m_region) fingerprint(m_region, data, data_hash, def, num_args, d->m_args);
+        fingerprint * f = new (m_region) fingerprint(m_region, data, d->m_data_hash, def, num_args, d->m_args);
         m_fingerprints.push_back(f);
         m_defs.push_back(def);
         m_set.insert(f);
@@ -101,14 +108,7 @@ namespace smt {
     }
 
     bool fingerprint_set::contains(void * data, unsigned data_hash, unsigned num_args, enode * const * args) {
-        fingerprint * d = mk_dummy(data, data_hash, num_args, args);
-        if (m_set.contains(d)) 
-            return true;
-        for (unsigned i = 0; i < num_args; i++)
-            d->m_args[i] = d->m_args[i]->get_root();
-        if (m_set.contains(d))
-            return true;
-        return false;
+        return m_set.contains(mk_key(data, data_hash, num_args, args));
     }
     
     void fingerprint_set::reset() {
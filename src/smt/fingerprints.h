@@ -65,6 +65,7 @@ namespace smt {
         fingerprint              m_dummy;
 
         fingerprint * mk_dummy(void * data, unsigned data_hash, unsigned num_args, enode * const * args);
+        fingerprint * mk_key(void * data, unsigned data_hash, unsigned num_args, enode * const * args);
 
     public:
         fingerprint_set(ast_manager& m, region & r): m_region(r), m_defs(m) {}
@@ -1858,6 +1858,7 @@ namespace {
         // equalities used for pattern match. The first element of the tuple gives the argument (or null) of some term that was matched against some higher level
         // structure of the trigger, the second element gives the term that argument is replaced with in order to match the trigger. Used for logging purposes only.
         vector<std::tuple<enode *, enode *>> m_used_enodes;
+        bool                m_track_used_enodes = false; // m_used_enodes is maintained, fixed for each execute_core
         unsigned            m_curr_used_enodes_size;
         ptr_vector<enode>   m_pattern_instances; // collect the pattern instances... used for computing min_top_generation and max_top_generation
         unsigned_vector     m_min_top_generation, m_max_top_generation;
@@ -1877,7 +1878,7 @@ namespace {
         void update_max_generation(enode * n, enode * prev) {
             m_max_generation = std::max(m_max_generation, n->get_generation());
 
-            if (m.has_trace_stream() || is_trace_enabled("causality"))
+            if (m_track_used_enodes)
                 m_used_enodes.push_back(std::make_tuple(prev, n));
         }
 
@@ -2298,7 +2299,8 @@ namespace {
         m_pattern_instances.push_back(n);
         m_max_generation = n->get_generation();
 
-        if (m.has_trace_stream() || is_trace_enabled("causality")) {
+        m_track_used_enodes = m.has_trace_stream() || is_trace_enabled("causality");
+        if (m_track_used_enodes) {
             m_used_enodes.reset();
             m_used_enodes.push_back(std::make_tuple(nullptr, n)); // null indicates that n was matched against the trigger at the top-level
         }
@@ -2400,7 +2402,7 @@ namespace {
                 goto backtrack;
             
             // We will use the common root when instantiating the quantifier => log the necessary equalities
-            if (m.has_trace_stream() || is_trace_enabled("causality")) {
+            if (m_track_used_enodes) {
                 m_used_enodes.push_back(std::make_tuple(m_n1, m_n1->get_root()));
                 m_used_enodes.push_back(std::make_tuple(m_n2, m_n2->get_root()));
             }
@@ -2420,7 +2422,7 @@ namespace {
                 goto backtrack;
 
             // we used the equality m_n1 = m_n2 for the match and need to make sure it ends up in the log
-            if (m.has_trace_stream() || is_trace_enabled("causality")) {
+            if (m_track_used_enodes) {
                 m_used_enodes.push_back(std::make_tuple(m_n1, m_n2));
             }
 
@@ -2606,7 +2608,7 @@ namespace {
             if (m_n1 == 0 || !m_context.is_relevant(m_n1))                                                                                                              \
                 goto backtrack;                                                                                                                                         \
             update_max_generation(m_n1, nullptr);                                                                                                                       \
-            if (m.has_trace_stream() || is_trace_enabled("causality")) {                                                                                                                     \
+            if (m_track_used_enodes) {                                                                                                                     \
                 for (unsigned i = 0; i < static_cast<const get_cgr *>(m_pc)->m_num_args; ++i) {                                                                         \
                     m_used_enodes.push_back(std::make_tuple(m_n1->get_arg(i), m_n1->get_arg(i)->get_root()));                                                           \
                 }                                                                                                                                                       \
@@ -2702,7 +2704,7 @@ namespace {
         backtrack_point & bp = m_backtrack_stack[m_top - 1];
         m_max_generation     = bp.m_old_max_generation;
 
-        if (m.has_trace_stream() || is_trace_enabled("causality"))
+        if (m_track_used_enodes)
             m_used_enodes.shrink(bp.m_old_used_enodes_size);
 
         TRACE("mam_int", tout << "backtrack top: " << bp.m_instr << " " << *(bp.m_instr) << "\n";);
@@ -36,6 +36,8 @@ void smt_params::updt_local_params(params_ref const & _p) {
     m_restart_strategy = static_cast<restart_strategy>(p.restart_strategy());
     if (m_restart_strategy > RS_ARITHMETIC) throw default_exception("illegal restart strategy numeral");
     m_restart_factor = p.restart_factor();
+    m_lemma_gc_core_glue = p.lemma_gc_core_glue();
+    m_lemma_gc_max_th_lemmas = p.lemma_gc_max_th_lemmas();
     m_case_split_strategy = static_cast<case_split_strategy>(p.case_split());
     m_theory_case_split = p.theory_case_split();
     m_theory_aware_branching = p.theory_aware_branching();
@@ -49,6 +51,7 @@ void smt_params::updt_local_params(params_ref const & _p) {
     m_threads_max_conflicts  = p.threads_max_conflicts();
     m_threads_cube_frequency = p.threads_cube_frequency();
     m_core_validate = p.core_validate();
+    m_phase_timing = p.phase_timing();
     m_sls_enable = p.sls_enable();
     m_logic = _p.get_sym("logic", m_logic);
     m_string_solver = p.string_solver();
@@ -154,6 +157,8 @@ void smt_params::display(std::ostream & out) const {
     DISPLAY_PARAM(m_recent_lemmas_size);
     DISPLAY_PARAM(m_lemma_gc_initial);
     DISPLAY_PARAM(m_lemma_gc_factor);
+    DISPLAY_PARAM(m_lemma_gc_core_glue);
+    DISPLAY_PARAM(m_lemma_gc_max_th_lemmas);
     DISPLAY_PARAM(m_new_old_ratio);
     DISPLAY_PARAM(m_new_clause_activity);
     DISPLAY_PARAM(m_old_clause_activity);
@@ -177,6 +182,7 @@ void smt_params::display(std::ostream & out) const {
     DISPLAY_PARAM(m_progress_sampling_freq);
 
     DISPLAY_PARAM(m_core_validate);
+    DISPLAY_PARAM(m_phase_timing);
 
     DISPLAY_PARAM(m_preprocess);
     DISPLAY_PARAM(m_user_theory_preprocess_axioms);
@@ -170,6 +170,8 @@ struct smt_params : public preprocessor_params,
     unsigned          m_new_clause_relevancy = 45; //!< Max. number of unassigned literals to be considered relevant.
     unsigned          m_old_clause_relevancy = 6; //!< Max. number of unassigned literals to be considered relevant.
     double            m_inv_clause_decay = 1;     //!< clause activity decay
+    unsigned          m_lemma_gc_core_glue = 0;   //!< lemmas with at most this glue are kept
+    unsigned          m_lemma_gc_max_th_lemmas = 0; //!< budget for theory lemmas, 0 for no budget
 
     // -----------------------------------
     //
@@ -220,6 +222,7 @@ struct smt_params : public preprocessor_params,
     //
     // -----------------------------------
     bool             m_core_validate = false;
+    bool             m_phase_timing = false;
 
     // -----------------------------------
     //
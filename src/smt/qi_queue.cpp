@@ -63,6 +63,14 @@ namespace smt {
             warning_msg("invalid new_gen function '%s', switching to default one", m_params.m_qi_new_gen.c_str());
             VERIFY(m_parser.parse_string("cost", m_new_gen_function));
         }
+        // The default functions are evaluated directly, without walking
+        // their expressions for every instance. Expressions are hash-consed,
+        // so equivalent functions are recognized by pointer equality.
+        expr_ref default_fn(m);
+        VERIFY(m_parser.parse_string("(+ weight generation)", default_fn));
+        m_default_cost = default_fn == m_cost_function;
+        VERIFY(m_parser.parse_string("cost", default_fn));
+        m_default_new_gen = default_fn == m_new_gen_function;
         m_eager_cost_threshold = m_params.m_qi_eager_threshold;
     }
 
@@ -121,6 +129,11 @@ namespace smt {
     }
 
     float qi_queue::get_cost(quantifier * q, app * pat, unsigned generation, unsigned min_top_generation, unsigned max_top_generation) {
+        if (m_default_cost) {
+            float r = static_cast<float>(q->get_weight()) + static_cast<float>(generation);
+            m_qm.get_stat(q)->update_max_cost(r);
+            return r;
+        }
         q::quantifier_stat * stat = set_values(q, pat, generation, min_top_generation, max_top_generation, 0);
         float r = m_evaluator(m_cost_function, m_vals.size(), m_vals.data());
         stat->update_max_cost(r);
@@ -129,8 +142,11 @@ namespace smt {
 
     unsigned qi_queue::get_new_gen(quantifier * q, unsigned generation, float cost) {
         // max_top_generation and min_top_generation are not available for computing inc_gen
-        set_values(q, nullptr, generation, 0, 0, cost);
-        float r = m_evaluator(m_new_gen_function, m_vals.size(), m_vals.data());
+        float r = cost;
+        if (!m_default_new_gen) {
+            set_values(q, nullptr, generation, 0, 0, cost);
+            r = m_evaluator(m_new_gen_function, m_vals.size(), m_vals.data());
+        }
         if (q->get_weight() > 0 || r > 0)
             return static_cast<unsigned>(r);
         return std::max(generation + 1, static_cast<unsigned>(r));
@@ -47,6 +47,8 @@ namespace smt {
         checker                       m_checker;
         expr_ref                      m_cost_function;
         expr_ref                      m_new_gen_function;
+        bool                          m_default_cost = false;    // m_cost_function is (+ weight generation)
+        bool                          m_default_new_gen = false; // m_new_gen_function is cost
         cost_parser                   m_parser;
         cost_evaluator                m_evaluator;
         cached_var_subst              m_subst;
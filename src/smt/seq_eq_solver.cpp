@@ -40,6 +40,34 @@ bool theory_seq::solve_eqs(unsigned i) {
     return change || m_new_propagation || ctx.inconsistent();
 }
 
+bool theory_seq::is_failed_eq(unsigned id, expr_ref_vector const& ls, expr_ref_vector const& rs) const {
+    failed_eq f;
+    if (!m_failed_eqs.find(id, f) || f.m_num_assigned != ctx.assigned_literals().size())
+        return false;
+    if (ls.size() != f.m_rs_begin - f.m_ls_begin || rs.size() != f.m_end - f.m_rs_begin)
+        return false;
+    for (unsigned i = 0; i < ls.size(); ++i)
+        if (ls.get(i) != m_failed_eq_args.get(f.m_ls_begin + i))
+            return false;
+    for (unsigned i = 0; i < rs.size(); ++i)
+        if (rs.get(i) != m_failed_eq_args.get(f.m_rs_begin + i))
+            return false;
+    return true;
+}
+
+void theory_seq::set_failed_eq(unsigned id, expr_ref_vector const& ls, expr_ref_vector const& rs) {
+    if (!m_in_solve_round || ctx.inconsistent())
+        return;
+    failed_eq f;
+    f.m_num_assigned = ctx.assigned_literals().size();
+    f.m_ls_begin = m_failed_eq_args.size();
+    m_failed_eq_args.append(ls);
+    f.m_rs_begin = m_failed_eq_args.size();
+    m_failed_eq_args.append(rs);
+    f.m_end = m_failed_eq_args.size();
+    m_failed_eqs.insert(id, f);
+}
+
 bool theory_seq::solve_eq(unsigned idx) {
     const depeq& e = m_eqs[idx];
     expr_ref_vector& ls = m_ls;
@@ -50,6 +78,10 @@ bool theory_seq::solve_eq(unsigned idx) {
     bool change = false;
     if (!canonize(e.ls, ls, dep2, change)) return false;
     if (!canonize(e.rs, rs, dep2, change)) return false;
+    if (m_in_solve_round && is_failed_eq(e.id(), ls, rs)) {
+        ++m_stats.m_num_skipped_eqs;
+        return false;
+    }
     dependency* deps = m_dm.mk_join(dep2, e.dep());
     TRACE("seq_verbose", 
           tout << e.ls << " = " << e.rs << " ==> ";
@@ -86,6 +118,7 @@ bool theory_seq::solve_eq(unsigned idx) {
         TRACE("seq", tout << "inserting equality\n";);
         m_eqs.set(idx, depeq(m_eq_id++, ls, rs, deps));        
     }
+    set_failed_eq(m_eqs[idx].id(), ls, rs);
     return false;
 }
 
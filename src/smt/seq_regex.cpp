@@ -30,7 +30,10 @@ namespace smt {
         ctx(th.get_context()),
         m(th.get_manager()),
         m_state_to_expr(m),
-        m_state_graph(state_graph::state_pp(this, pp_state)) { }
+        m_state_graph(state_graph::state_pp(this, pp_state)),
+        m_trans_states(m),
+        m_trans_conds(m),
+        m_trans_targets(m) { }
 
     seq_util& seq_regex::u() { return th.m_util; }
     class seq_util::rex& seq_regex::re() { return th.m_util.re; }
@@ -521,8 +524,6 @@ namespace smt {
 
         literal null_lit = th.mk_literal(is_nullable);
         expr_ref hd = mk_first(r, n);
-        expr_ref d(m);
-        d = mk_derivative_wrapper(hd, r);
 
         literal_vector lits;
         lits.push_back(~lit);
@@ -530,7 +531,7 @@ namespace smt {
             lits.push_back(null_lit);
 
         expr_ref_pair_vector cofactors(m);
-        get_cofactors(d, cofactors);
+        get_cofactors(hd, r, cofactors);
         for (auto const& p : cofactors) {
             if (is_member(p.second, u)) 
                 continue;            
@@ -687,9 +688,16 @@ namespace smt {
     void seq_regex::get_cofactors(expr* r, expr_ref_pair_vector& result) {
         obj_hashtable<expr> ifs;
         expr* cond = nullptr, * r1 = nullptr, * r2 = nullptr;
-        for (expr* e : subterms::ground(expr_ref(r, m))) 
+        auto collect = [&](expr* e) {
             if (m.is_ite(e, cond, r1, r2))
                 ifs.insert(cond);
+        };
+        if (is_ground(r))
+            for (expr* e : subterms::ground(expr_ref(r, m)))
+                collect(e);
+        else
+            for (expr* e : subterms::all(expr_ref(r, m)))
+                collect(e);
         
         expr_ref_vector rs(m);
         vector<expr_ref_vector> conds;
@@ -723,6 +731,57 @@ namespace smt {
         }
     }
 
+    /*
+        Retrieve the transitions of r in the derivative automaton, computing
+        them on first use. The conditions refer to the next character as
+        (:var 0). Return false if the derivative cannot be represented this
+        way, because it contains binders or a target depends on the character.
+    */
+    bool seq_regex::get_transitions(expr* r, expr_ref_pair_vector& result) {
+        std::pair<unsigned, unsigned> range;
+        if (!m_transitions.find(r, range)) {
+            expr_ref d = seq_rw().mk_derivative(r);
+            if (has_quantifiers(d))
+                return false;
+            expr_ref_pair_vector cofactors(m);
+            get_cofactors(d, cofactors);
+            for (auto const& p : cofactors)
+                if (!is_ground(p.second))
+                    return false;
+            if (m_trans_conds.size() > m_max_transitions) {
+                m_transitions.reset();
+                m_trans_states.reset();
+                m_trans_conds.reset();
+                m_trans_targets.reset();
+            }
+            range.first = m_trans_conds.size();
+            for (auto const& p : cofactors) {
+                m_trans_conds.push_back(p.first);
+                m_trans_targets.push_back(p.second);
+            }
+            range.second = m_trans_conds.size();
+            m_trans_states.push_back(r);
+            m_transitions.insert(r, range);
+        }
+        for (unsigned i = range.first; i < range.second; ++i)
+            result.push_back(m_trans_conds.get(i), m_trans_targets.get(i));
+        return true;
+    }
+
+    /*
+        Cofactors of the derivative of r by hd.
+    */
+    void seq_regex::get_cofactors(expr* hd, expr* r, expr_ref_pair_vector& result) {
+        expr_ref_pair_vector trans(m);
+        if (!get_transitions(r, trans)) {
+            get_cofactors(mk_derivative_wrapper(hd, r), result);
+            return;
+        }
+        var_subst subst(m);
+        for (auto const& p : trans)
+            result.push_back(subst(p.first, hd), p.second);
+    }
+
     /*
       is_empty(r, u) => ~is_nullable(r)
       is_empty(r, u) => (forall x . ~cond(x)) or is_empty(r1, u union r)    for (cond, r) in min-terms(D(x,r))      
@@ -745,11 +804,9 @@ namespace smt {
         }
         th.add_axiom(~lit, ~th.mk_literal(is_nullable));
         expr_ref hd = mk_first(r, n);
-        expr_ref d(m);
-        d = mk_derivative_wrapper(hd, r);
         literal_vector lits;
         expr_ref_pair_vector cofactors(m);
-        get_cofactors(d, cofactors);        
+        get_cofactors(hd, r, cofactors);
         for (auto const& p : cofactors) {
             if (is_member(p.second, u))
                 continue;
@@ -117,6 +117,19 @@ namespace smt {
         /* map from uninterpreted regex constants to assigned regex expressions by EQ */
         // expr_map                       m_const_to_expr;
         unsigned                       m_max_state_graph_size { 10000 };
+
+        /*
+            Transitions of the derivative automaton, computed lazily and kept
+            across checks: for a regex r, the cofactors (cond, target) of
+            the derivative of r by (:var 0), where cond ranges over the
+            character predicates (minterms) that lead to target.
+            Entries [begin, end) of m_trans_conds and m_trans_targets.
+        */
+        obj_map<expr, std::pair<unsigned, unsigned>> m_transitions;
+        expr_ref_vector                m_trans_states, m_trans_conds, m_trans_targets;
+        unsigned                       m_max_transitions { 100000 };
+        bool get_transitions(expr* r, expr_ref_pair_vector& result);
+        void get_cofactors(expr* hd, expr* r, expr_ref_pair_vector& result);
         // Convert between expressions and states (IDs)
         unsigned get_state_id(expr* e);
         expr* get_expr_from_id(unsigned id);
@@ -44,8 +44,10 @@ namespace smt {
         cls->m_deleted             = false;
         SASSERT(!m.proofs_enabled() || js != 0);
         memcpy(cls->m_lits, lits, sizeof(literal) * num_lits);
-        if (cls->is_lemma())
+        if (cls->is_lemma()) {
             cls->set_activity(1);
+            cls->set_glue(num_lits);
+        }
         if (del_eh)
             *(const_cast<clause_del_eh **>(cls->get_del_eh_addr())) = del_eh;
         if (js)
@@ -67,7 +67,7 @@ namespace smt {
         static unsigned get_obj_size(unsigned num_lits, clause_kind k, bool has_atoms, bool has_del_eh, bool has_justification) {
             unsigned r = sizeof(clause) + sizeof(literal) * num_lits;
             if (smt::is_lemma(k)) 
-                r += sizeof(unsigned);
+                r += 2 * sizeof(unsigned); // activity and glue
             /* dvitek: Fix alignment issues on 64-bit platforms.  The
              * 'if' statement below probably isn't worthwhile since
              * I'm guessing the allocator is probably going to round
@@ -95,7 +95,7 @@ namespace smt {
         clause_del_eh * const * get_del_eh_addr() const {
             unsigned const * addr = get_activity_addr();
             if (is_lemma())
-                addr ++;
+                addr += 2;
             /* dvitek: It would be better to use uintptr_t than
              * size_t, but we need to wait until c++11 support is
              * really available.
@@ -221,6 +221,20 @@ namespace smt {
             *(get_activity_addr()) = act;
         }
 
+        /**
+           \brief number of distinct decision levels of the literals (LBD) when the lemma was
+           created or last used in a conflict.
+        */
+        unsigned get_glue() const {
+            SASSERT(is_lemma());
+            return get_activity_addr()[1];
+        }
+
+        void set_glue(unsigned glue) {
+            SASSERT(is_lemma());
+            get_activity_addr()[1] = glue;
+        }
+
         clause_del_eh * get_del_eh() const {
             return m_has_del_eh ? *(get_del_eh_addr()) : nullptr;
         }
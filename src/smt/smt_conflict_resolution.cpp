@@ -521,8 +521,10 @@ namespace smt {
             case b_justification::CLAUSE: {
                 clause * cls = js.get_clause();
                 TRACE("conflict_smt2", m_ctx.display_clause_smt2(tout, *cls););
-                if (cls->is_lemma())
+                if (cls->is_lemma()) {
                     cls->inc_clause_activity();
+                    m_ctx.update_glue(*cls);
+                }
                 unsigned num_lits = cls->get_num_literals();
                 unsigned i        = 0;
                 if (consequent != false_literal) {
@@ -644,7 +646,7 @@ namespace smt {
         bool_var var = antecedent.var();
         unsigned lvl = m_ctx.get_assign_level(var);
         if (!m_ctx.is_marked(var) && lvl > m_ctx.get_base_level()) {
-            if (m_lvl_set.may_contain(lvl)) {
+            if (m_lvl_set.may_contain(lvl) && !m_min_failed.contains(var)) {
                 m_ctx.set_mark(var);
                 m_unmark.push_back(var);
                 m_lemma_min_stack.push_back(var);
@@ -669,6 +671,18 @@ namespace smt {
         return true;
     }
 
+    /**
+       \brief an antecedent of var is not implied by the marked literals, so neither is var.
+       The marked set only grows during minimization, so var is remembered
+       to cut later searches that reach it, in particular through
+       theory justifications that would be explained again.
+    */
+    bool conflict_resolution::minimization_failed(bool_var var, unsigned old_size, unsigned old_js_qhead) {
+        reset_unmark_and_justifications(old_size, old_js_qhead);
+        m_min_failed.insert(var);
+        return false;
+    }
+
     /**
        \brief Return true if lit is implied by other marked literals
        and/or literals assigned at the base level.
@@ -697,35 +711,30 @@ namespace smt {
                         literal l = (*cls)[i];
                         SASSERT(l.var() != var);
                         if (!process_antecedent_for_minimization(~l)) {
-                            reset_unmark_and_justifications(old_size, old_js_qhead);
-                            return false;
+                            return minimization_failed(var, old_size, old_js_qhead);
                         }
                     }
                 }
                 justification * js = cls->get_justification();
                 if (js && !process_justification_for_minimization(js)) {
-                    reset_unmark_and_justifications(old_size, old_js_qhead);
-                    return false;
+                    return minimization_failed(var, old_size, old_js_qhead);
                 }
                 break;
             }
             case b_justification::BIN_CLAUSE:
                 if (!process_antecedent_for_minimization(js.get_literal())) {
-                    reset_unmark_and_justifications(old_size, old_js_qhead);
-                    return false;
+                    return minimization_failed(var, old_size, old_js_qhead);
                 }
                 break;
             case b_justification::AXIOM:
                 // it is a decision variable from a previous scope level or an assumption
                 if (m_ctx.get_assign_level(var) > m_ctx.get_base_level()) {
-                    reset_unmark_and_justifications(old_size, old_js_qhead);
-                    return false;
+                    return minimization_failed(var, old_size, old_js_qhead);
                 }
                 break;
             case b_justification::JUSTIFICATION:
                 if (m_ctx.is_assumption(var) || !process_justification_for_minimization(js.get_justification())) {
-                    reset_unmark_and_justifications(old_size, old_js_qhead);
-                    return false;
+                    return minimization_failed(var, old_size, old_js_qhead);
                 }
                 break;
             }
@@ -740,6 +749,7 @@ namespace smt {
     */
     void conflict_resolution::minimize_lemma() {
         m_unmark.reset();
+        m_min_failed.reset();
 
         m_lvl_set   = get_lemma_approx_level_set();
 
@@ -761,6 +771,7 @@ namespace smt {
         }
 
         reset_unmark_and_justifications(0, 0);
+        m_min_failed.reset();
         m_lemma      .shrink(j);
         m_lemma_atoms.shrink(j);
         m_ctx.m_stats.m_num_minimized_lits += sz - j;
@@ -21,6 +21,7 @@ Revision History:
 #include "util/warning.h"
 #include "util/timeit.h"
 #include "util/union_find.h"
+#include "util/prefetch.h"
 #include "ast/ast_pp.h"
 #include "ast/ast_ll_pp.h"
 #include "ast/ast_smt2_pp.h"
@@ -106,7 +107,7 @@ namespace smt {
     bool context::get_cancel_flag() {
         if (m.limit().inc())
             return false;
-        m_last_search_failure = CANCELED;
+        m_last_search_failure = m.limit().memory_exceeded() ? MEMOUT : CANCELED;
         return true;
     }
 
@@ -123,8 +124,14 @@ namespace smt {
     }
 
     void context::copy(context& src_ctx, context& dst_ctx, bool override_base) {
+        ast_translation tr(src_ctx.get_manager(), dst_ctx.get_manager(), false);
+        copy(src_ctx, dst_ctx, tr, override_base);
+    }
+
+    void context::copy(context& src_ctx, context& dst_ctx, ast_translation& tr, bool override_base) {
         ast_manager& dst_m = dst_ctx.get_manager();
         ast_manager& src_m = src_ctx.get_manager();
+        SASSERT(&tr.from() == &src_m && &tr.to() == &dst_m);
         src_ctx.pop_to_base_lvl();
 
         if (!override_base && src_ctx.m_base_lvl > 0) {
@@ -132,7 +139,6 @@ namespace smt {
         }
         SASSERT(src_ctx.m_base_lvl == 0 || override_base);
 
-        ast_translation tr(src_m, dst_m, false);
 
         dst_ctx.set_logic(src_ctx.m_setup.get_logic());
         dst_ctx.copy_plugins(src_ctx, dst_ctx);
@@ -575,13 +581,23 @@ namespace smt {
         }
     }
 
+    // number of parents looked ahead when updating the congruence table.
+    static const unsigned cg_prefetch_distance = 4;
+
     /**
        \brief When merging to equivalence classes, the parents of the smallest one (that are congruence roots),
        must be removed from the congruence table since their hash code will change.
     */
     void context::remove_parents_from_cg_table(enode * r1) {
         // Remove parents from the congruence table
-        for (enode * parent : enode::parents(r1)) {
+        enode_vector const& r1_parents = r1->m_parents;
+        unsigned num_r1_parents = r1_parents.size();
+        for (unsigned i = 0; i < num_r1_parents; ++i) {
+            enode * parent = r1_parents[i];
+            // parents of high-degree nodes are spread over the heap,
+            // ask for the next ones early.
+            if (i + cg_prefetch_distance < num_r1_parents)
+                prefetch_address(r1_parents[i + cg_prefetch_distance]);
             CTRACE("add_eq", !parent->is_marked() && parent->is_cgc_enabled() && parent->is_true_eq() && m_cg_table.contains_ptr(parent), tout << parent->get_owner_id() << "\n";);
             CTRACE("add_eq", !parent->is_marked() && parent->is_cgc_enabled() && !parent->is_true_eq() &&  parent->is_cgr() && !m_cg_table.contains_ptr(parent), 
                    tout << "cgr !contains " << parent->get_owner_id() << " " << mk_pp(parent->get_decl(), m) << "\n";
@@ -626,6 +642,8 @@ namespace smt {
         unsigned num_r1_parents = r1_parents.size();
         for (unsigned i = 0; i < num_r1_parents; ++i) {
             enode* parent = r1_parents[i];
+            if (i + cg_prefetch_distance < num_r1_parents)
+                prefetch_address(r1_parents[i + cg_prefetch_distance]);
             if (!parent->is_marked())
                 continue;
             parent->unset_mark();
@@ -1698,6 +1716,7 @@ namespace smt {
      */
     bool context::propagate() {
         TRACE("propagate", tout << "propagating... " << m_qhead << ":" << m_assigned_literals.size() << "\n";);
+        scoped_phase_time _time(phase_timer(m_time_propagate));
         while (true) {
             if (inconsistent())
                 return false;
@@ -1725,6 +1744,7 @@ namespace smt {
             }
             if (!get_cancel_flag()) {
 //                scoped_suspend_rlimit _suspend_cancel(m.limit(), at_base_level());
+                scoped_phase_time _time_q(phase_timer(m_time_quantifiers));
                 m_qmanager->propagate();
             }
             if (inconsistent())
@@ -2718,19 +2738,89 @@ namespace smt {
         bool operator()(clause * cls1, clause * cls2) const { return cls1->get_activity() > cls2->get_activity(); }
     };
 
+    /**
+       \brief number of distinct decision levels of the assigned literals of cls.
+       Each unassigned literal counts as a level of its own.
+    */
+    unsigned context::compute_glue(clause const & cls) {
+        if (++m_glue_mark == 0) {
+            m_glue_lvl_marks.fill(0);
+            m_glue_mark = 1;
+        }
+        unsigned glue = 0;
+        for (literal l : cls) {
+            if (get_assignment(l) == l_undef) {
+                ++glue;
+                continue;
+            }
+            unsigned lvl = get_assign_level(l);
+            m_glue_lvl_marks.reserve(lvl + 1, 0);
+            if (m_glue_lvl_marks[lvl] != m_glue_mark) {
+                m_glue_lvl_marks[lvl] = m_glue_mark;
+                ++glue;
+            }
+        }
+        return glue;
+    }
+
+    /**
+       \brief theory lemmas are created by the theories independently of conflicts,
+       and on long runs they can outnumber the learned clauses.
+       When their number exceeds the budget, the ones with the highest glue
+       and lowest activity are deleted until half of the budget is left.
+    */
+    void context::del_th_lemmas_over_budget() {
+        unsigned budget = m_fparams.m_lemma_gc_max_th_lemmas;
+        unsigned start_at = m_base_lvl == 0 ? 0 : m_base_scopes[m_base_lvl - 1].m_lemmas_lim;
+        unsigned sz = m_lemmas.size();
+        unsigned num_th_lemmas = 0;
+        ptr_vector<clause> candidates;
+        for (unsigned i = start_at; i < sz; ++i) {
+            clause * cls = m_lemmas[i];
+            if (cls->get_kind() != CLS_TH_LEMMA)
+                continue;
+            ++num_th_lemmas;
+            if (can_delete(cls) && !is_core_lemma(cls))
+                candidates.push_back(cls);
+        }
+        if (num_th_lemmas <= budget)
+            return;
+        unsigned num_del = std::min(num_th_lemmas - budget / 2, candidates.size());
+        std::stable_sort(candidates.begin(), candidates.end(), [](clause * c1, clause * c2) {
+            return c1->get_glue() > c2->get_glue() || (c1->get_glue() == c2->get_glue() && c1->get_activity() < c2->get_activity());
+        });
+        ptr_addr_hashtable<clause> to_delete;
+        for (unsigned i = 0; i < num_del; ++i)
+            to_delete.insert(candidates[i]);
+        unsigned j = start_at;
+        for (unsigned i = start_at; i < sz; ++i) {
+            clause * cls = m_lemmas[i];
+            if (to_delete.contains(cls))
+                del_clause(true, cls);
+            else
+                m_lemmas[j++] = cls;
+        }
+        m_lemmas.shrink(j);
+        IF_VERBOSE(2, verbose_stream() << "(smt.delete-theory-lemmas :num-deleted-clauses " << num_del << ")\n";);
+    }
+
     /**
        \brief Delete low activity lemmas
     */
     inline void context::del_inactive_lemmas() {
         if (m_fparams.m_lemma_gc_strategy == LGC_NONE)
             return;
-        else if (m_fparams.m_lemma_gc_half)
+        scoped_phase_time _time(phase_timer(m_time_gc));
+        if (m_fparams.m_lemma_gc_max_th_lemmas > 0)
+            del_th_lemmas_over_budget();
+        if (m_fparams.m_lemma_gc_half)
             del_inactive_lemmas1();
         else
             del_inactive_lemmas2();
 
         m_num_conflicts_since_lemma_gc = 0;
-        if (m_fparams.m_lemma_gc_strategy == LGC_GEOMETRIC)
+        // the threshold does not grow while the memory of the check is above its high watermark
+        if (m_fparams.m_lemma_gc_strategy == LGC_GEOMETRIC && !m.limit().above_memory_high_watermark())
             m_lemma_gc_threshold = static_cast<unsigned>(m_lemma_gc_threshold * m_fparams.m_lemma_gc_factor);
     }
 
@@ -2756,9 +2846,9 @@ namespace smt {
               << ", start_del_at: " << start_del_at << "\n";);
         for (; i < end_at; i++) {
             clause * cls = m_lemmas[i];
-            if (can_delete(cls)) {
+            if (can_delete(cls) && (cls->deleted() || !is_core_lemma(cls))) {
                 TRACE("del_inactive_lemmas", tout << "deleting: "; display_clause(tout, cls); tout << ", activity: " <<
-                      cls->get_activity() << "\n";);
+                      cls->get_activity() << ", glue: " << cls->get_glue() << "\n";);
                 del_clause(true, cls);
                 num_del_cls++;
             }
@@ -2819,9 +2909,10 @@ namespace smt {
                 }
                 // A clause is deleted if it has low activity and the number of unknowns is greater than a threshold.
                 // The activity threshold depends on how old the clause is.
+                // Lemmas with low glue are kept.
                 unsigned act_threshold = m_fparams.m_old_clause_activity -
                     (m_fparams.m_old_clause_activity - m_fparams.m_new_clause_activity) * ((i - start_at) / real_sz);
-                if (cls->get_activity() < act_threshold) {
+                if (cls->get_activity() < act_threshold && !is_core_lemma(cls)) {
                     unsigned rel_threshold = (i >= new_first_idx ? m_fparams.m_new_clause_relevancy : m_fparams.m_old_clause_relevancy);
                     if (more_than_k_unassigned_literals(cls, rel_threshold)) {
                         del_clause(true, cls);
@@ -3959,6 +4050,9 @@ namespace smt {
                     (m_fparams.m_lemma_gc_strategy == LGC_FIXED || m_fparams.m_lemma_gc_strategy == LGC_GEOMETRIC)) {
                     del_inactive_lemmas();
                 }
+                else if (4 * m_num_conflicts_since_lemma_gc > m_lemma_gc_threshold && m.limit().above_memory_high_watermark()) {
+                    del_inactive_lemmas();
+                }
 
                 m_dyn_ack_manager.propagate_eh();
                 CASSERT("dyn_ack", check_clauses(m_lemmas) && check_clauses(m_aux_clauses));
@@ -4029,6 +4123,7 @@ namespace smt {
     final_check_status context::final_check() {
         TRACE("final_check", tout << "final_check inconsistent: " << inconsistent() << "\n"; display(tout); display_normalized_enodes(tout););
         CASSERT("relevancy", check_relevancy());
+        scoped_phase_time _time(phase_timer(m_time_final_check));
         
         if (m_fparams.m_model_on_final_check) {
             mk_proto_model();
@@ -4057,7 +4152,15 @@ namespace smt {
             if (m_final_check_idx < num_th) {
                 theory * th = m_theory_set[m_final_check_idx];
                 IF_VERBOSE(100, verbose_stream() << "(smt.final-check \"" << th->get_name() << "\")\n";);
-                ok = th->final_check_eh();
+                phase_time * t = nullptr;
+                if (m_fparams.m_phase_timing) {
+                    m_time_theory_final_check.reserve(num_th, phase_time());
+                    t = &m_time_theory_final_check[m_final_check_idx];
+                }
+                {
+                    scoped_phase_time _time_th(t);
+                    ok = th->final_check_eh();
+                }
                 TRACE("final_check_step", tout << "final check '" << th->get_name() << " ok: " << ok << " inconsistent " << inconsistent() << "\n";);
                 if (ok == FC_GIVEUP) {
                     f  = THEORY;
@@ -4124,6 +4227,7 @@ namespace smt {
 
 
     bool context::resolve_conflict() {
+        scoped_phase_time _time(phase_timer(m_time_conflict));
         m_stats.m_num_conflicts++;
         m_num_conflicts ++;
         m_num_conflicts_since_restart ++;
@@ -89,6 +89,15 @@ namespace smt {
         smt_params &                m_fparams;
         params_ref                  m_params;
         ::statistics                m_aux_stats;
+        // time spent in phases of the search, collected when smt.phase_timing is set.
+        phase_time                  m_time_propagate;
+        phase_time                  m_time_quantifiers;
+        phase_time                  m_time_conflict;
+        phase_time                  m_time_final_check;
+        phase_time                  m_time_gc;
+        svector<phase_time>         m_time_theory_final_check; // indexed by position in m_theory_set
+
+        phase_time * phase_timer(phase_time & t) { return m_fparams.m_phase_timing ? &t : nullptr; }
         setup                       m_setup;
         unsigned                    m_relevancy_lvl;
         timer                       m_timer;
@@ -1217,6 +1226,25 @@ namespace smt {
             return !is_justifying(cls);
         }
 
+        // lemmas with low glue are kept by the garbage collector
+        bool is_core_lemma(clause const * cls) const {
+            return cls->get_glue() <= m_fparams.m_lemma_gc_core_glue;
+        }
+
+        unsigned_vector    m_glue_lvl_marks;
+        unsigned           m_glue_mark = 0;
+
+        unsigned compute_glue(clause const & cls);
+
+    public:
+        void update_glue(clause & cls) {
+            if (!is_core_lemma(&cls))
+                cls.set_glue(std::min(cls.get_glue(), compute_glue(cls)));
+        }
+
+    protected:
+        void del_th_lemmas_over_budget();
+
         void del_inactive_lemmas();
 
         void del_inactive_lemmas1();
@@ -1629,6 +1657,13 @@ namespace smt {
 
         static void copy(context& src, context& dst, bool override_base = false);
 
+        /**
+           \brief Copy src into dst using the translation tr from the manager of src to the manager of dst.
+           Callers that translate further terms, such as assumptions, can reuse the cache that was
+           populated while translating the assertions.
+        */
+        static void copy(context& src, context& dst, ast_translation& tr, bool override_base = false);
+
         /**
            \brief Translate context to use new manager m.
          */
@@ -1770,6 +1805,12 @@ namespace smt {
             m_user_propagator->register_diseq(diseq_eh);
         }
 
+        void user_propagate_register_batch(user_propagator::batch_eh_t& batch_eh) {
+            if (!m_user_propagator) 
+                throw default_exception("user propagator must be initialized");
+            m_user_propagator->register_batch(batch_eh);
+        }
+
         void user_propagate_register_expr(expr* e) {
             if (!m_user_propagator) 
                 throw default_exception("user propagator must be initialized");
@@ -428,6 +428,15 @@ namespace smt {
         for (theory* th : m_theory_set) {
             th->collect_statistics(st);
         }
+        if (m_fparams.m_phase_timing) {
+            m_time_propagate.collect_statistics("propagate", st);
+            m_time_quantifiers.collect_statistics("quantifiers", st);
+            m_time_conflict.collect_statistics("conflict", st);
+            m_time_final_check.collect_statistics("final check", st);
+            m_time_gc.collect_statistics("lemma gc", st);
+            for (unsigned i = 0; i < m_time_theory_final_check.size() && i < m_theory_set.size(); ++i)
+                m_time_theory_final_check[i].collect_statistics((std::string("final check ") + m_theory_set[i]->get_name()).c_str(), st);
+        }
     }
 
     void context::display_statistics(std::ostream & out) const {
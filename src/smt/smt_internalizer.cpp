@@ -1467,6 +1467,7 @@ namespace smt {
             m_clause_proof.add(*cls, &simp_lits);
             if (lemma) {
                 cls->set_activity(activity);
+                cls->set_glue(compute_glue(*cls));
                 if (k == CLS_LEARNED) {
                     int w2_idx  = select_learned_watch_lit(cls);
                     cls->swap_lits(1, w2_idx);
@@ -294,6 +294,10 @@ namespace smt {
         m_imp->m_kernel.user_propagate_register_diseq(diseq_eh);
     }
 
+    void kernel::user_propagate_register_batch(user_propagator::batch_eh_t& batch_eh) {
+        m_imp->m_kernel.user_propagate_register_batch(batch_eh);
+    }
+
     void kernel::user_propagate_register_expr(expr* e) {
         m_imp->m_kernel.user_propagate_register_expr(e);
     }        
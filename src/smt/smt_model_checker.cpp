@@ -50,6 +50,7 @@ namespace smt {
         m_iteration_idx(0),
         m_curr_model(nullptr),
         m_fresh_exprs(m),
+        m_satisfied_pinned(m),
         m_pinned_exprs(m) {
     }
 
@@ -162,14 +163,7 @@ namespace smt {
        The variables are replaced by skolem constants. These constants are stored in sks.
     */
 
-    bool model_checker::assert_neg_q_m(quantifier * q, expr_ref_vector & sks) {
-        expr_ref tmp(m);
-        
-        TRACE("model_checker", tout << "curr_model:\n"; model_pp(tout, *m_curr_model););
-
-        if (!m_curr_model->eval(q->get_expr(), tmp, true)) {
-            return false;
-        }
+    bool model_checker::assert_neg_q_m(quantifier * q, expr * tmp, expr_ref_vector & sks) {
         TRACE("model_checker", tout << "q after applying interpretation:\n" << mk_ismt2_pp(tmp, m) << "\n";);
         ptr_buffer<expr> subst_args;
         unsigned num_decls = q->get_num_decls();
@@ -342,15 +336,46 @@ namespace smt {
        \brief Return true if q is satisfied by m_curr_model.
     */
 
+    bool model_checker::has_finite_binder(quantifier * q) const {
+        for (unsigned i = 0; i < q->get_num_decls(); ++i)
+            if (m_curr_model->is_finite(q->get_decl_sort(i)))
+                return true;
+        return false;
+    }
+
+    void model_checker::set_satisfied(quantifier * q, expr * body) {
+        // m_satisfied_pinned holds (q, body) pairs, stale pairs are dropped in bulk.
+        if (m_satisfied_pinned.size() > 4 * m_satisfied.size() + 64) {
+            m_satisfied.reset();
+            m_satisfied_pinned.reset();
+        }
+        m_satisfied_pinned.push_back(q);
+        m_satisfied_pinned.push_back(body);
+        m_satisfied.insert(q, body);
+    }
+
     bool model_checker::check(quantifier * q) {
         SASSERT(!m_aux_context->relevancy());
-        scoped_ctx_push _push(m_aux_context.get());
 
         quantifier * flat_q = get_flat_quantifier(q);
         TRACE("model_checker", tout << "model checking:\n" << expr_ref(flat_q->get_expr(), m) << "\n";);
+        TRACE("model_checker", tout << "curr_model:\n"; model_pp(tout, *m_curr_model););
+        expr_ref body(m);
+        if (!m_curr_model->eval(flat_q->get_expr(), body, true))
+            return false;
+
+        // the universe of finite sorts restricts the skolem constants and may change between rounds.
+        bool cacheable = !has_finite_binder(flat_q);
+        expr * prev = nullptr;
+        if (cacheable && m_satisfied.find(q, prev) && prev == body) {
+            TRACE("model_checker", tout << "unchanged since last satisfied\n";);
+            return true;
+        }
+
+        scoped_ctx_push _push(m_aux_context.get());
         expr_ref_vector sks(m);
 
-        if (!assert_neg_q_m(flat_q, sks))
+        if (!assert_neg_q_m(flat_q, body, sks))
             return false;
         TRACE("model_checker", tout << "skolems:\n" << sks << "\n";);
 
@@ -359,7 +384,10 @@ namespace smt {
         
         TRACE("model_checker", tout << "[complete] model-checker result: " << to_sat_str(r) << "\n";);
         if (r != l_true) {
-            return is_safe_for_mbqi(q) && r == l_false; // quantifier is satisfied by m_curr_model
+            bool satisfied = is_safe_for_mbqi(q) && r == l_false; // quantifier is satisfied by m_curr_model
+            if (satisfied && cacheable)
+                set_satisfied(q, body);
+            return satisfied;
         }
 
         model_ref complete_cex;
@@ -564,6 +592,8 @@ namespace smt {
 
     void model_checker::reset() {
         reset_new_instances();
+        m_satisfied.reset();
+        m_satisfied_pinned.reset();
     }
 
     void model_checker::assert_new_instances() {
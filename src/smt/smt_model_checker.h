@@ -53,6 +53,11 @@ namespace smt {
         proto_model *                               m_curr_model;
         obj_map<expr, expr *>                       m_value2expr;
         expr_ref_vector                             m_fresh_exprs;
+        // quantifier -> body under the model of the last round in which it was satisfied.
+        // The aux context holds no assertions outside of check(q), so a quantifier whose
+        // body evaluates to the same expression in a later round is still satisfied.
+        obj_map<quantifier, expr*>                  m_satisfied;
+        expr_ref_vector                             m_satisfied_pinned;
 
         friend class model_instantiation_set;
 
@@ -62,7 +67,9 @@ namespace smt {
         expr * get_type_compatible_term(expr * val);
         expr_ref replace_value_from_ctx(expr * e);
         void restrict_to_universe(expr * sk, obj_hashtable<expr> const & universe);
-        bool assert_neg_q_m(quantifier * q, expr_ref_vector & sks);
+        bool assert_neg_q_m(quantifier * q, expr * body, expr_ref_vector & sks);
+        bool has_finite_binder(quantifier * q) const;
+        void set_satisfied(quantifier * q, expr * body);
         bool add_blocking_clause(model * cex, expr_ref_vector & sks);
         bool check(quantifier * q);
         void check_quantifiers(bool& found_relevant, unsigned& num_failures);
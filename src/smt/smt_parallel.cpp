@@ -42,7 +42,7 @@ namespace smt {
     lbool parallel::operator()(expr_ref_vector const& asms) {
 
         lbool result = l_undef;
-        unsigned num_threads = std::min((unsigned) std::thread::hardware_concurrency(), ctx.get_fparams().m_threads);
+        unsigned num_threads = get_num_threads(ctx.get_fparams().m_threads);
         flet<unsigned> _nt(ctx.m_fparams.m_threads, 1);
         unsigned thread_max_conflicts = ctx.get_fparams().m_threads_max_conflicts;
         unsigned max_conflicts = ctx.get_fparams().m_max_conflicts;
@@ -63,7 +63,7 @@ namespace smt {
         vector<smt_params> smt_params;
         scoped_ptr_vector<ast_manager> pms;
         scoped_ptr_vector<context> pctxs;
-        vector<expr_ref_vector> pasms;
+        scoped_ptr_vector<expr_ref_vector> pasms;
 
         ast_manager& m = ctx.m;
         scoped_limits sl(m.limit());
@@ -72,25 +72,46 @@ namespace smt {
         par_exception_kind ex_kind = DEFAULT_EX;
         unsigned error_code = 0;
         bool done = false;
-        unsigned num_rounds = 0;
         if (m.has_trace_stream())
             throw default_exception("trace streams have to be off in parallel mode");
 
         
         for (unsigned i = 0; i < num_threads; ++i) {
             smt_params.push_back(ctx.get_fparams());
+            pms.push_back(nullptr);
+            pctxs.push_back(nullptr);
+            pasms.push_back(nullptr);
         }
-        for (unsigned i = 0; i < num_threads; ++i) {
+        std::mutex mux;
+
+        // Each worker translates its copy of ctx on its own thread, so that
+        // the manager, clauses and watch lists of the copy are allocated by that
+        // thread and end up in memory local to it. Copies are made one at a time
+        // because translation reads ctx.
+        auto init_worker = [&](unsigned i) {
+            pin_thread(i);
+            std::lock_guard<std::mutex> lock(mux);
+            if (done)
+                return false;
             ast_manager* new_m = alloc(ast_manager, m, true);
-            pms.push_back(new_m);
-            pctxs.push_back(alloc(context, *new_m, smt_params[i], ctx.get_params())); 
-            context& new_ctx = *pctxs.back();
-            context::copy(ctx, new_ctx, true);
-            new_ctx.set_random_seed(i + ctx.get_fparams().m_random_seed);
+            pms.set(i, new_m);
+            pctxs.set(i, alloc(context, *new_m, smt_params[i], ctx.get_params())); 
+            context& new_ctx = *pctxs[i];
             ast_translation tr(m, *new_m);
-            pasms.push_back(tr(asms));
+            context::copy(ctx, new_ctx, tr, true);
+            new_ctx.set_random_seed(i + ctx.get_fparams().m_random_seed);
+            pasms.set(i, alloc(expr_ref_vector, tr(asms)));
             sl.push_child(&(new_m->limit()));
-        }
+            return true;
+        };
+
+        // cancel the other workers that have been created.
+        auto cancel_workers = [&](ast_manager* pm) {
+            std::lock_guard<std::mutex> lock(mux);
+            for (ast_manager* m : pms) 
+                if (m && m != pm) 
+                    m->limit().cancel();
+        };
 
         auto cube = [](context& ctx, expr_ref_vector& lasms, expr_ref& c) {
             lookahead lh(ctx);
@@ -104,92 +125,108 @@ namespace smt {
 
         obj_hashtable<expr> unit_set;
         expr_ref_vector unit_trail(ctx.m);
-        unsigned_vector unit_lim;
-        for (unsigned i = 0; i < num_threads; ++i) unit_lim.push_back(0);
-
-        std::function<void(void)> collect_units = [&,this]() {
-            for (unsigned i = 0; i < num_threads; ++i) {
-                context& pctx = *pctxs[i];
-                pctx.pop_to_base_lvl();
-                ast_translation tr(pctx.m, ctx.m);
-                unsigned sz = pctx.assigned_literals().size();
-                for (unsigned j = unit_lim[i]; j < sz; ++j) {
-                    literal lit = pctx.assigned_literals()[j];
-                    expr_ref e(pctx.bool_var2expr(lit.var()), pctx.m);
-                    if (lit.sign()) e = pctx.m.mk_not(e);
-                    expr_ref ce(tr(e.get()), ctx.m);
-                    if (!unit_set.contains(ce)) {
-                        unit_set.insert(ce);
-                        unit_trail.push_back(ce);
-                    }
+        unsigned_vector unit_lim, assigned_lim;
+        for (unsigned i = 0; i < num_threads; ++i) unit_lim.push_back(0), assigned_lim.push_back(0);
+
+        // Exchange units of worker i with the shared unit trail.
+        // Workers synchronize only with each other through mux, and only
+        // when they have exhausted their current conflict budget.
+        // The shared trail lives in ctx.m, which is otherwise idle while workers run.
+        // Returns false if another worker has already finished.
+        auto share_units = [&](unsigned i) {
+            context& pctx = *pctxs[i];
+            pctx.pop_to_base_lvl();
+            std::lock_guard<std::mutex> lock(mux);
+            if (done) 
+                return false;
+            ast_translation tr_out(pctx.m, ctx.m);
+            unsigned sz = pctx.assigned_literals().size();
+            for (unsigned j = assigned_lim[i]; j < sz; ++j) {
+                literal lit = pctx.assigned_literals()[j];
+                expr_ref e(pctx.bool_var2expr(lit.var()), pctx.m);
+                if (lit.sign()) e = pctx.m.mk_not(e);
+                expr_ref ce(tr_out(e.get()), ctx.m);
+                if (!unit_set.contains(ce)) {
+                    unit_set.insert(ce);
+                    unit_trail.push_back(ce);
                 }
             }
-
-            unsigned sz = unit_trail.size();
-            for (unsigned i = 0; i < num_threads; ++i) {
-                context& pctx = *pctxs[i];
-                ast_translation tr(ctx.m, pctx.m);
-                for (unsigned j = unit_lim[i]; j < sz; ++j) {
-                    expr_ref src(ctx.m), dst(pctx.m);
-                    dst = tr(unit_trail.get(j));
-                    pctx.assert_expr(dst);
-                }
-                unit_lim[i] = sz;
+            assigned_lim[i] = sz;
+            ast_translation tr_in(ctx.m, pctx.m);
+            for (unsigned j = unit_lim[i]; j < unit_trail.size(); ++j) {
+                expr_ref dst(tr_in(unit_trail.get(j)), pctx.m);
+                pctx.assert_expr(dst);
             }
-            IF_VERBOSE(1, verbose_stream() << "(smt.thread :units " << sz << ")\n");
+            unit_lim[i] = unit_trail.size();
+            IF_VERBOSE(1, verbose_stream() << "(smt.thread " << i << " :units " << unit_trail.size() << ")\n");
+            return true;
         };
 
-        std::mutex mux;
-
+        // Each worker runs until it produces a result. Between conflict budgets
+        // it exchanges units and continues without waiting for the other workers.
         auto worker_thread = [&](int i) {
             try {
+                if (!init_worker(i))
+                    return;
                 context& pctx = *pctxs[i];
                 ast_manager& pm = *pms[i];
-                expr_ref_vector lasms(pasms[i]);
-                expr_ref c(pm);
-
-                pctx.get_fparams().m_max_conflicts = std::min(thread_max_conflicts, max_conflicts);
-                if (num_rounds > 0 && (pctx.get_fparams().m_threads_cube_frequency % num_rounds) == 0) 
-                    cube(pctx, lasms, c);
-                IF_VERBOSE(1, verbose_stream() << "(smt.thread " << i; 
-                           if (num_rounds > 0) verbose_stream() << " :round " << num_rounds;
-                           if (c) verbose_stream() << " :cube " << mk_bounded_pp(c, pm, 3);
-                           verbose_stream() << ")\n";);
-                lbool r = pctx.check(lasms.size(), lasms.data());
-                
-                if (r == l_undef && pctx.m_num_conflicts >= max_conflicts) 
-                    ; // no-op
-                else if (r == l_undef && pctx.m_num_conflicts >= thread_max_conflicts) 
-                    return;
-                else if (r == l_false && pctx.unsat_core().contains(c)) {
-                    IF_VERBOSE(1, verbose_stream() << "(smt.thread " << i << " :learn " << mk_bounded_pp(c, pm, 3) << ")");
-                    pctx.assert_expr(mk_not(mk_and(pctx.unsat_core())));
-                    return;
-                } 
-                
-
-                bool first = false;
-                {
-                    std::lock_guard<std::mutex> lock(mux);
-                    if (finished_id == UINT_MAX) {
-                        finished_id = i;
-                        first = true;
-                        result = r;
-                        done = true;
+                unsigned num_rounds = 0;
+                unsigned max_c = max_conflicts;
+                unsigned thread_max_c = thread_max_conflicts;
+                while (true) {
+                    expr_ref_vector lasms(*pasms[i]);
+                    expr_ref c(pm);
+
+                    pctx.get_fparams().m_max_conflicts = std::min(thread_max_c, max_c);
+                    if (num_rounds > 0 && (pctx.get_fparams().m_threads_cube_frequency % num_rounds) == 0) 
+                        cube(pctx, lasms, c);
+                    IF_VERBOSE(1, verbose_stream() << "(smt.thread " << i; 
+                               if (num_rounds > 0) verbose_stream() << " :round " << num_rounds;
+                               if (c) verbose_stream() << " :cube " << mk_bounded_pp(c, pm, 3);
+                               verbose_stream() << ")\n";);
+                    lbool r = pctx.check(lasms.size(), lasms.data());
+
+                    bool next_round = false;
+                    if (r == l_undef && pctx.m_num_conflicts >= max_c) 
+                        ; // no-op
+                    else if (r == l_undef && pctx.m_num_conflicts >= thread_max_c) 
+                        next_round = true;
+                    else if (r == l_false && pctx.unsat_core().contains(c)) {
+                        IF_VERBOSE(1, verbose_stream() << "(smt.thread " << i << " :learn " << mk_bounded_pp(c, pm, 3) << ")");
+                        pctx.assert_expr(mk_not(mk_and(pctx.unsat_core())));
+                        next_round = true;
+                    } 
+
+                    if (next_round) {
+                        if (!share_units(i))
+                            return;
+                        ++num_rounds;
+                        max_c = (max_c < thread_max_c) ? 0 : (max_c - thread_max_c);
+                        thread_max_c *= 2;
+                        continue;
                     }
-                    if (!first && r != l_undef && result == l_undef) {
-                        finished_id = i;
-                        result = r;                        
+
+                    {
+                        std::lock_guard<std::mutex> lock(mux);
+                        if (finished_id == UINT_MAX && !done) {
+                            finished_id = i;
+                            result = r;
+                            done = true;
+                        }
+                        else if (finished_id != UINT_MAX && r != l_undef && result == l_undef) {
+                            finished_id = i;
+                            result = r;                        
+                        }
+                        else 
+                            return;
                     }
-                    else if (!first) return;
-                }
 
-                for (ast_manager* m : pms) {
-                    if (m != &pm) m->limit().cancel();
+                    cancel_workers(&pm);
+                    return;
                 }
-
             }
             catch (z3_error & err) {
+                std::lock_guard<std::mutex> lock(mux);
                 if (finished_id == UINT_MAX) {
                     error_code = err.error_code();
                     ex_kind = ERROR_EX;
@@ -197,6 +234,7 @@ namespace smt {
                 }
             }
             catch (z3_exception & ex) {
+                std::lock_guard<std::mutex> lock(mux);
                 if (finished_id == UINT_MAX) {
                     ex_msg = ex.msg();
                     ex_kind = DEFAULT_EX;
@@ -204,36 +242,31 @@ namespace smt {
                 }
             }
             catch (...) {
+                std::lock_guard<std::mutex> lock(mux);
                 if (finished_id == UINT_MAX) {
                     ex_msg = "unknown exception";
                     ex_kind = ERROR_EX;
                     done = true;
                 }
             }
+            // release workers that are still searching.
+            cancel_workers(nullptr);
         };
 
         // for debugging:  num_threads = 1;
 
-        while (true) {
-            vector<std::thread> threads(num_threads);
-            for (unsigned i = 0; i < num_threads; ++i) {
-                threads[i] = std::thread([&, i]() { worker_thread(i); });
-            }
-            for (auto & th : threads) {
-                th.join();
-            }
-            if (done) break;
-
-            collect_units();
-            ++num_rounds;
-            max_conflicts = (max_conflicts < thread_max_conflicts) ? 0 : (max_conflicts - thread_max_conflicts);
-            thread_max_conflicts *= 2;            
+        vector<std::thread> threads(num_threads);
+        for (unsigned i = 0; i < num_threads; ++i) {
+            threads[i] = std::thread([&, i]() { worker_thread(i); });
         }
-
-        for (context* c : pctxs) {
-            c->collect_statistics(ctx.m_aux_stats);
+        for (auto & th : threads) {
+            th.join();
         }
 
+        for (context* c : pctxs) 
+            if (c) 
+                c->collect_statistics(ctx.m_aux_stats);
+
         if (finished_id == UINT_MAX) {
             switch (ex_kind) {
             case ERROR_EX: throw z3_error(error_code);
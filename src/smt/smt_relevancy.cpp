@@ -127,8 +127,9 @@ namespace smt {
         expr_ref_vector                m_relevant_exprs; 
         uint_set                       m_is_relevant;
         typedef list<relevancy_eh *>   relevancy_ehs;
-        obj_map<expr, relevancy_ehs *> m_relevant_ehs;
-        obj_map<expr, relevancy_ehs *> m_watches[2];
+        // handler and watch lists are indexed by expression id.
+        ptr_vector<relevancy_ehs>      m_relevant_ehs;
+        ptr_vector<relevancy_ehs>      m_watches[2];
         struct eh_trail {
             enum class kind { POS_WATCH, NEG_WATCH, HANDLER };
             kind   m_kind;
@@ -158,33 +159,28 @@ namespace smt {
             }
         }
 
-        relevancy_ehs * get_handlers(expr * n) {
-            relevancy_ehs * r = nullptr;
-            m_relevant_ehs.find(n, r);
-            SASSERT(m_relevant_ehs.contains(n) || r == 0);
-            return r;
+        static relevancy_ehs * get_ehs(ptr_vector<relevancy_ehs> const & ehs, expr * n) {
+            unsigned id = n->get_id();
+            return id < ehs.size() ? ehs[id] : nullptr;
         }
 
-        void set_handlers(expr * n, relevancy_ehs * ehs) {
-            if (ehs == nullptr)
-                m_relevant_ehs.erase(n);
-            else
-                m_relevant_ehs.insert(n, ehs);
+        static void set_ehs(ptr_vector<relevancy_ehs> & ehs, expr * n, relevancy_ehs * l) {
+            unsigned id = n->get_id();
+            if (id >= ehs.size()) {
+                if (l == nullptr)
+                    return;
+                ehs.resize(id + 1, nullptr);
+            }
+            ehs[id] = l;
         }
 
-        relevancy_ehs * get_watches(expr * n, bool val) {
-            relevancy_ehs * r = nullptr;
-            m_watches[val ? 1 : 0].find(n, r);
-            SASSERT(m_watches[val ? 1 : 0].contains(n) || r == 0);
-            return r;
-        }
+        relevancy_ehs * get_handlers(expr * n) { return get_ehs(m_relevant_ehs, n); }
 
-        void set_watches(expr * n, bool val, relevancy_ehs * ehs) {
-            if (ehs == nullptr)
-                m_watches[val ? 1 : 0].erase(n);
-            else
-                m_watches[val ? 1 : 0].insert(n, ehs);
-        }
+        void set_handlers(expr * n, relevancy_ehs * ehs) { set_ehs(m_relevant_ehs, n, ehs); }
+
+        relevancy_ehs * get_watches(expr * n, bool val) { return get_ehs(m_watches[val ? 1 : 0], n); }
+
+        void set_watches(expr * n, bool val, relevancy_ehs * ehs) { set_ehs(m_watches[val ? 1 : 0], n, ehs); }
 
         void push_trail(eh_trail const & t) {
             get_manager().inc_ref(t.get_node());
@@ -271,12 +267,19 @@ namespace smt {
         */
         void unmark_relevant_exprs(unsigned old_lim) {
             SASSERT(old_lim <= m_relevant_exprs.size());
-            unsigned i = m_relevant_exprs.size();
-            while (i != old_lim) {
-                --i;
-                expr * n = m_relevant_exprs.get(i);
-                m_is_relevant.remove(n->get_id());
-                TRACE("propagate_relevancy", tout << "unmarking:\n" << mk_ismt2_pp(n, get_manager()) << "\n";);
+            if (old_lim == 0) {
+                // nothing stays relevant, clear the marks in bulk.
+                TRACE("propagate_relevancy", tout << "unmarking all\n";);
+                m_is_relevant.reset();
+            }
+            else {
+                unsigned i = m_relevant_exprs.size();
+                while (i != old_lim) {
+                    --i;
+                    expr * n = m_relevant_exprs.get(i);
+                    m_is_relevant.remove(n->get_id());
+                    TRACE("propagate_relevancy", tout << "unmarking:\n" << mk_ismt2_pp(n, get_manager()) << "\n";);
+                }
             }
             m_relevant_exprs.shrink(old_lim);
             m_qhead = m_relevant_exprs.size();
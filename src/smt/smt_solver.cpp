@@ -240,6 +240,10 @@ namespace {
             m_context.user_propagate_register_diseq(diseq_eh);
         }
 
+        void user_propagate_register_batch(user_propagator::batch_eh_t& batch_eh) override {
+            m_context.user_propagate_register_batch(batch_eh);
+        }
+
         void user_propagate_register_expr(expr* e) override { 
             m_context.user_propagate_register_expr(e);
         }
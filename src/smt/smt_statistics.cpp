@@ -17,6 +17,9 @@ Revision History:
 
 --*/
 #include<string.h>
+#include<string>
+#include "util/statistics.h"
+#include "util/symbol.h"
 #include "smt/smt_statistics.h"
 
 namespace smt {
@@ -25,5 +28,21 @@ namespace smt {
         memset(this, 0, sizeof(statistics));
     }
 
+    void phase_time::add(double secs) {
+        m_seconds += secs;
+        unsigned i = secs < 1e-5 ? 0 : secs < 1e-3 ? 1 : secs < 1e-1 ? 2 : 3;
+        m_hist[i]++;
+    }
+
+    void phase_time::collect_statistics(char const* name, ::statistics& st) const {
+        static char const* suffix[NUM_BUCKETS] = { " <10us", " <1ms", " <100ms", " >=100ms" };
+        // statistics keep the key pointers, so the keys are interned as symbols.
+        std::string key = std::string("time ") + name;
+        st.update(symbol(key).bare_str(), m_seconds);
+        for (unsigned i = 0; i < NUM_BUCKETS; ++i)
+            if (m_hist[i] > 0)
+                st.update(symbol(key + suffix[i]).bare_str(), m_hist[i]);
+    }
+
 };
 
@@ -18,6 +18,10 @@ Revision History:
 --*/
 #pragma once
 
+#include <chrono>
+
+class statistics;
+
 namespace smt {
 
     struct statistics {
@@ -51,6 +55,37 @@ namespace smt {
         
         void reset();
     };
+
+    /**
+       \brief Accumulated time of a phase of the search, with a histogram of
+       the duration of each call: below 10us, 1ms, 100ms, and above.
+    */
+    struct phase_time {
+        static const unsigned NUM_BUCKETS = 4;
+        double   m_seconds = 0;
+        unsigned m_hist[NUM_BUCKETS] = { 0, 0, 0, 0 };
+
+        void add(double secs);
+        void reset() { *this = phase_time(); }
+        void collect_statistics(char const* name, ::statistics& st) const;
+    };
+
+    /**
+       \brief adds the time of its scope to a phase_time, if one is given.
+    */
+    class scoped_phase_time {
+        phase_time* m_time;
+        std::chrono::steady_clock::time_point m_start;
+    public:
+        scoped_phase_time(phase_time* t): m_time(t) {
+            if (t)
+                m_start = std::chrono::steady_clock::now();
+        }
+        ~scoped_phase_time() {
+            if (m_time)
+                m_time->add(std::chrono::duration<double>(std::chrono::steady_clock::now() - m_start).count());
+        }
+    };
 };
 
 
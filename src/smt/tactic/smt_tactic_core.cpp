@@ -322,6 +322,7 @@ public:
     user_propagator::final_eh_t m_final_eh;
     user_propagator::eq_eh_t    m_eq_eh;
     user_propagator::eq_eh_t    m_diseq_eh;
+    user_propagator::batch_eh_t m_batch_eh;
     user_propagator::created_eh_t m_created_eh;
     user_propagator::decide_eh_t m_decide_eh;
     void* m_on_clause_ctx = nullptr;
@@ -340,6 +341,7 @@ public:
         if (m_final_eh)   m_ctx->user_propagate_register_final(m_final_eh);
         if (m_eq_eh)      m_ctx->user_propagate_register_eq(m_eq_eh);
         if (m_diseq_eh)   m_ctx->user_propagate_register_diseq(m_diseq_eh);
+        if (m_batch_eh)   m_ctx->user_propagate_register_batch(m_batch_eh);
         if (m_created_eh) m_ctx->user_propagate_register_created(m_created_eh);
         if (m_decide_eh) m_ctx->user_propagate_register_decide(m_decide_eh);
 
@@ -356,6 +358,7 @@ public:
         m_final_eh = nullptr;
         m_eq_eh = nullptr;
         m_diseq_eh = nullptr;
+        m_batch_eh = nullptr;
         m_created_eh = nullptr;
         m_decide_eh = nullptr;
         m_on_clause_eh = nullptr;
@@ -395,6 +398,10 @@ public:
         m_diseq_eh = diseq_eh;
     }
 
+    void user_propagate_register_batch(user_propagator::batch_eh_t& batch_eh) override {
+        m_batch_eh = batch_eh;
+    }
+
     void user_propagate_register_expr(expr* e) override {
         m_vars.push_back(e);
     }
@@ -267,8 +267,14 @@ namespace smt {
         m_var_data.push_back(alloc(var_data));
         var_data * d  = m_var_data[r];
         ctx.attach_th_var(n, this, r);
+        m_oc_clean = false;
         if (is_constructor(n)) {
             d->m_constructor = n;
+            for (enode * arg : enode::args(n)) {
+                sort * s = arg->get_sort(), * se;
+                if ((m_autil.is_array(s) && m_util.is_datatype(get_array_range(s))) || (m_sutil.is_seq(s, se) && m_util.is_datatype(se)))
+                    m_oc_nested = true;
+            }
             assert_accessor_axioms(n);
         }
         else if (is_update_field(n)) {
@@ -481,15 +487,21 @@ namespace smt {
         int num_vars = get_num_vars();
         final_check_status r = FC_DONE;
         final_check_st _guard(this); 
+        // The constructor graph is unchanged since the last cycle-free check.
+        // Backtracking only splits classes, which cannot introduce cycles.
+        // Array and sequence arguments depend on other theories and are always re-checked.
+        bool oc_skip = m_oc_clean;
+        m_oc_clean = !m_oc_nested;
         for (int v = 0; v < num_vars; v++) {
             if (v == static_cast<int>(m_find.find(v))) {
                 enode * node = get_enode(v);
                 sort* s = node->get_sort();
                 if (!m_util.is_datatype(s))
                     continue;
-                if (m_util.is_recursive(s) && !oc_cycle_free(node) && occurs_check(node)) {
+                if (!oc_skip && m_util.is_recursive(s) && !oc_cycle_free(node) && occurs_check(node)) {
                     // conflict was detected... 
                     // return...
+                    m_oc_clean = false;
                     return FC_CONTINUE;
                 }
                 if (params().m_dt_lazy_splits > 0) {
@@ -853,6 +865,7 @@ namespace smt {
         // v1 is the new root
         TRACE("datatype", tout << "merging v" << v1 << " v" << v2 << "\n";);
         SASSERT(v1 == static_cast<int>(m_find.find(v1)));
+        m_oc_clean = false;
         var_data * d1 = m_var_data[v1];
         var_data * d2 = m_var_data[v2];
         if (d2->m_constructor != nullptr) {
@@ -81,6 +81,8 @@ namespace smt {
         enode_pair_vector     m_used_eqs; // conflict, if any
         parent_tbl            m_parent; // parent explanation for occurs_check
         svector<stack_entry>  m_stack; // stack for DFS for occurs_check
+        bool                  m_oc_clean = false;  // no constructor graph changes since the last cycle-free occurs check
+        bool                  m_oc_nested = false; // constructors with array or sequence arguments are present
         literal_vector        m_lits;
 
         void clear_mark();
@@ -180,6 +180,7 @@ namespace smt {
 
         ptr_vector<atom>               m_atoms;
         ptr_vector<atom>               m_asserted_atoms;   // set of asserted atoms
+        svector<edge_id>               m_subsumed;         // edges implied by the last enabled edge
         unsigned                       m_asserted_qhead;   
         bool_var2atom                  m_bool_var2atom;
         svector<scope>                 m_scopes;
@@ -334,6 +335,8 @@ namespace smt {
 
         bool propagate_atom(atom* a);
 
+        void propagate_subsumed(edge_id id);
+
         theory_var mk_term(app* n);
 
         theory_var mk_num(app* n, rational const& r);
@@ -589,9 +589,32 @@ bool theory_diff_logic<Ext>::propagate_atom(atom* a) {
         
         return false;
     }
+    if (m_params.m_arith_bound_prop != bound_prop_mode::BP_NONE)
+        propagate_subsumed(edge_id);
     return true;
 }
 
+/**
+   \brief assign the atoms of the edges that are directly implied by the enabled edge:
+   src - dst <= w implies src - dst <= w' for w <= w'. Only edges between the same 
+   pair of nodes are considered, so the propagation is justified by a single literal.
+*/
+template<typename Ext>
+void theory_diff_logic<Ext>::propagate_subsumed(edge_id id) {
+    literal l = m_graph.get_explanation(id);
+    if (l == null_literal)
+        return;
+    m_subsumed.reset();
+    m_graph.find_subsumed1(id, m_subsumed);
+    for (edge_id e : m_subsumed) {
+        literal l2 = m_graph.get_explanation(e);
+        if (l2 == null_literal || ctx.get_assignment(l2) != l_undef)
+            continue;
+        TRACE("arith", tout << "implied " << l2 << " by " << l << "\n";);
+        ctx.assign(l2, ctx.mk_justification(theory_propagation_justification(get_id(), ctx, 1, &l, l2)));
+    }
+}
+
 template<typename Ext>
 void theory_diff_logic<Ext>::new_edge(dl_var src, dl_var dst, unsigned num_edges, edge_id const* edges) {
 
@@ -2210,6 +2210,14 @@ public:
         }
     }
 
+    // cheap test that rules out columns without unassigned bound atoms before computing implied bounds
+    bool column_is_interesting(unsigned vi) const {
+        theory_var v = lp().local_to_external(vi);
+        if (v == null_theory_var) 
+            return false;
+        return should_refine_bounds() || (static_cast<unsigned>(v) < m_unassigned_bounds.size() && m_unassigned_bounds[v] > 0);
+    }
+
     bool bound_is_interesting(unsigned vi, lp::lconstraint_kind kind, const rational & bval) const {
         theory_var v = lp().local_to_external(vi);
         if (v == null_theory_var) 
@@ -2283,6 +2291,7 @@ public:
         lp_bounds const& bounds = m_bounds[v];
         bool first = true;
         unsigned count = 0;
+        u_dependency* lazy_dep = nullptr;
         for (unsigned i = 0; i < bounds.size(); ++i) {
             api_bound* b = bounds[i];
             if (ctx().get_assignment(b->get_lit()) != l_undef) 
@@ -2299,7 +2308,16 @@ public:
                 first = false;
                 reset_evidence();
                 m_explanation.clear();
-                lp().explain_implied_bound(be, m_bp);
+                if (use_lazy_explanation())
+                    lazy_dep = explain_implied_bound_lazy(be);
+                else
+                    lp().explain_implied_bound(be, m_bp);
+            }
+            if (lazy_dep) {
+                updt_unassigned_bounds(v, -1);
+                ++m_stats.m_bound_propagations1;
+                ctx().assign(lit, ctx().mk_justification(lazy_bound_justification(*this, lazy_dep)));
+                continue;
             }
             CTRACE("arith", m_unassigned_bounds[v] == 0, tout << "missed bound\n";);
             updt_unassigned_bounds(v, -1);
@@ -2392,6 +2410,73 @@ public:
         return true;
     }
 
+    /**
+       \brief justification of a bound propagation whose explanation is
+       only flattened into literals and equalities when conflict resolution
+       asks for the antecedents. The dependency is created in the current
+       scope of the lar_solver, so it lives as long as the propagated literal.
+    */
+    class lazy_bound_justification : public justification {
+        imp&          m_imp;
+        u_dependency* m_dep;
+    public:
+        lazy_bound_justification(imp& i, u_dependency* dep): m_imp(i), m_dep(dep) {}
+
+        void get_antecedents(conflict_resolution& cr) override {
+            for (auto ci : m_imp.lp().flatten(m_dep)) {
+                switch (m_imp.m_constraint_sources[ci]) {
+                case inequality_source:
+                    cr.mark_literal(m_imp.m_inequalities[ci]);
+                    break;
+                case equality_source:
+                    cr.mark_eq(m_imp.m_equalities[ci].first, m_imp.m_equalities[ci].second);
+                    break;
+                default:
+                    break;
+                }
+            }
+        }
+
+        theory_id get_from_theory() const override { return m_imp.get_id(); }
+
+        proof* mk_proof(conflict_resolution& cr) override { UNREACHABLE(); return nullptr; }
+
+        char const* get_name() const override { return "arith-lazy-bound"; }
+    };
+
+    /**
+       \brief explanations of propagated bounds are delayed above the base level
+       when they are not needed for proofs, validation or lemma logging.
+    */
+    bool use_lazy_explanation() const {
+        return 
+            !proofs_enabled() && 
+            !params().m_arith_validate && 
+            !ctx().get_fparams().m_axioms2files &&
+            ctx().get_scope_level() > ctx().get_base_level();
+    }
+
+    /**
+       \brief return the dependency of an implied bound if the propagation is
+       justified lazily. Otherwise, when the explanation is small enough to be
+       added as a theory lemma, the core is filled in and nullptr is returned.
+    */
+    u_dependency* explain_implied_bound_lazy(lp::implied_bound const& be) {
+        u_dependency* dep = be.explain_implied();
+        unsigned num_lits = 0, num_eqs = 0;
+        for (auto ci : lp().flatten(dep)) {
+            if (m_constraint_sources[ci] == inequality_source)
+                ++num_lits;
+            else if (m_constraint_sources[ci] == equality_source)
+                ++num_eqs;
+        }
+        if (num_eqs > 0 || num_lits >= small_lemma_size())
+            return dep;
+        for (auto ci : lp().flatten(dep))
+            set_evidence(ci, m_core, m_eqs);
+        return nullptr;
+    }
+
     literal_vector m_core2;
 
     void assign(literal lit, literal_vector const& core, svector<enode_pair> const& eqs, vector<parameter> const& ps) {
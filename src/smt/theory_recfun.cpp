@@ -34,7 +34,8 @@ namespace smt {
           m_util(m_plugin.u()), 
           m_disabled_guards(m),
           m_enabled_guards(m),
-          m_preds(m) {
+          m_preds(m),
+          m_apply_pinned(m) {
         }
 
     theory_recfun::~theory_recfun() {
@@ -92,6 +93,8 @@ namespace smt {
         for (auto & kv : m_guard2pending) 
             dealloc(kv.m_value);
         m_guard2pending.reset();
+        m_apply_cache.reset();
+        m_apply_pinned.reset();
     }
 
     /*
@@ -224,11 +227,21 @@ namespace smt {
         unsigned depth,
         recfun::vars const & vars,
         expr_ref_vector const & args,
-        expr * e) {
+        expr * e,
+        app * call) {
         SASSERT(is_standard_order(vars));
+        expr* r = nullptr;
+        if (m_apply_cache.find(e, call, r)) {
+            expr_ref new_body(r, m);
+            set_depth_rec(depth + 1, new_body);
+            return new_body;
+        }
         var_subst subst(m, true);
         expr_ref new_body = subst(e, args);
         ctx.get_rewriter()(new_body); // simplify
+        m_apply_cache.insert(e, call, new_body);
+        m_apply_pinned.push_back(call);
+        m_apply_pinned.push_back(new_body);
         set_depth_rec(depth + 1, new_body);
         return new_body;
     }
@@ -287,7 +300,7 @@ namespace smt {
         auto & vars = e.m_def->get_vars();
         expr_ref lhs(e.m_lhs, m);
         unsigned depth = get_depth(e.m_lhs);
-        expr_ref rhs(apply_args(depth, vars, e.m_args, e.m_def->get_rhs()), m);
+        expr_ref rhs(apply_args(depth, vars, e.m_args, e.m_def->get_rhs(), e.m_lhs), m);
         literal lit = mk_eq_lit(lhs, rhs);
         std::function<literal(void)> fn = [&]() { return lit; };
         scoped_trace_stream _tr(*this, fn);
@@ -329,7 +342,7 @@ namespace smt {
             set_depth(depth, pred_applied);
             expr_ref_vector guards(m);
             for (auto & g : c.get_guards()) {
-                guards.push_back(apply_args(depth, vars, e.m_args, g));
+                guards.push_back(apply_args(depth, vars, e.m_args, g, e.m_lhs));
             }
             if (c.is_immediate()) {
                 recfun::body_expansion be(pred_applied, c, e.m_args);
@@ -379,8 +392,8 @@ namespace smt {
         auto & args = e.m_args;
         SASSERT(is_standard_order(vars));
         unsigned depth = get_depth(e.m_pred);
-        expr_ref lhs(u().mk_fun_defined(d, args), m);
-        expr_ref rhs = apply_args(depth, vars, args, e.m_cdef->get_rhs());
+        app_ref lhs(u().mk_fun_defined(d, args), m);
+        expr_ref rhs = apply_args(depth, vars, args, e.m_cdef->get_rhs(), lhs);
         if (has_quantifiers(rhs)) {
             expr_ref fn(m.mk_fresh_const("rec-eq", m.mk_bool_sort()), m);
             expr_ref eq(m.mk_eq(fn, rhs), m);
@@ -390,7 +403,7 @@ namespace smt {
         }
         literal_vector clause;
         for (auto & g : e.m_cdef->get_guards()) {
-            expr_ref guard = apply_args(depth, vars, args, g);
+            expr_ref guard = apply_args(depth, vars, args, g, lhs);
             clause.push_back(~mk_literal(guard));
             if (clause.back() == true_literal) {
                 TRACEFN("body " << e << "\n" << clause << "\n" << guard);
@@ -19,6 +19,7 @@ Revision History:
 #pragma once
 
 #include "util/scoped_ptr_vector.h"
+#include "util/obj_pair_hashtable.h"
 #include "smt/smt_theory.h"
 #include "smt/smt_context.h"
 #include "ast/ast_pp.h"
@@ -69,7 +70,11 @@ namespace smt {
 
         void activate_guard(expr* guard, expr_ref_vector const& guards);
 
-        expr_ref apply_args(unsigned depth, recfun::vars const & vars, expr_ref_vector const & args, expr * e); //!< substitute variables by args
+        // instances of definition bodies and guards by (body or guard, call), kept across backtracking and rounds
+        obj_pair_map<expr, app, expr*> m_apply_cache;
+        expr_ref_vector          m_apply_pinned;
+
+        expr_ref apply_args(unsigned depth, recfun::vars const & vars, expr_ref_vector const & args, expr * e, app * call); //!< substitute variables by args
         void assert_macro_axiom(recfun::case_expansion & e);
         void assert_case_axioms(recfun::case_expansion & e);
         void assert_body_axiom(recfun::body_expansion & e);
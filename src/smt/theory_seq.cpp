@@ -285,7 +285,8 @@ theory_seq::theory_seq(context& ctx):
     m_unhandled_expr(nullptr),
     m_has_seq(m_util.has_seq()),
     m_new_solution(false),
-    m_new_propagation(false) {
+    m_new_propagation(false),
+    m_failed_eq_args(m) {
 }
 
 theory_seq::~theory_seq() {
@@ -1292,9 +1293,7 @@ bool theory_seq::solve_nc(unsigned idx) {
 }
 
 theory_seq::cell* theory_seq::mk_cell(cell* p, expr* e, dependency* d) {
-    cell* c = alloc(cell, p, e, d);
-    m_all_cells.push_back(c);
-    return c;
+    return new (m_cell_region) cell(p, e, d);
 }
 
 void theory_seq::unfold(cell* c, ptr_vector<cell>& cons) {
@@ -1347,7 +1346,7 @@ bool theory_seq::explain_eq(expr* e1, expr* e2, dependency*& dep) {
     }
     expr* a1, *a2;
     ptr_vector<cell> v1, v2;
-    unsigned cells_sz = m_all_cells.size();
+    m_cell_region.push_scope();
     cell* c1 = mk_cell(nullptr, e1, nullptr);
     cell* c2 = mk_cell(nullptr, e2, nullptr);
     unfold(c1, v1);
@@ -1425,7 +1424,7 @@ bool theory_seq::explain_eq(expr* e1, expr* e2, dependency*& dep) {
             break;
         }
     }   
-    m_all_cells.resize(cells_sz);
+    m_cell_region.pop_scope();
     return result;
     
 }
@@ -1450,11 +1449,16 @@ bool theory_seq::explain_empty(expr_ref_vector& es, dependency*& dep) {
 }
 
 bool theory_seq::simplify_and_solve_eqs() {
+    // the arithmetic state may have changed since the last round,
+    // so reductions that failed before are attempted again.
+    reset_failed_eqs();
+    flet<bool> _in_round(m_in_solve_round, true);
     m_new_solution = true;
     while (m_new_solution && !ctx.inconsistent()) {
         m_new_solution = false;
         solve_eqs(0);
     }
+    reset_failed_eqs();
     return m_new_propagation || ctx.inconsistent();
 }
 
@@ -1894,6 +1898,7 @@ std::ostream& theory_seq::display_deps(std::ostream& out, dependency* dep) const
 void theory_seq::collect_statistics(::statistics & st) const {
     st.update("seq num splits", m_stats.m_num_splits);
     st.update("seq num reductions", m_stats.m_num_reductions);
+    st.update("seq skip unchanged eqs", m_stats.m_num_skipped_eqs);
     st.update("seq length coherence", m_stats.m_check_length_coherence);
     st.update("seq branch", m_stats.m_branch_variable);
     st.update("seq solve !=", m_stats.m_solve_nqs);
@@ -307,6 +307,7 @@ namespace smt {
             void reset() { memset(this, 0, sizeof(stats)); }
             unsigned m_num_splits;
             unsigned m_num_reductions;
+            unsigned m_num_skipped_eqs;
             unsigned m_check_length_coherence;
             unsigned m_branch_variable;
             unsigned m_branch_nqs;
@@ -458,6 +459,21 @@ namespace smt {
         bool check_contains();
         bool check_lts();
         dependency* m_eq_deps { nullptr };
+
+        // equations that could not be reduced in the current round of simplify_and_solve_eqs,
+        // together with their canonical form and the number of assigned literals at the time.
+        // They are skipped until their canonical form or the assignment changes.
+        struct failed_eq {
+            unsigned m_num_assigned;
+            unsigned m_ls_begin, m_rs_begin, m_end;  // ranges in m_failed_eq_args
+        };
+        u_map<failed_eq>  m_failed_eqs;
+        expr_ref_vector   m_failed_eq_args;
+        bool              m_in_solve_round { false };
+        void reset_failed_eqs() { m_failed_eqs.reset(); m_failed_eq_args.reset(); }
+        bool is_failed_eq(unsigned id, expr_ref_vector const& ls, expr_ref_vector const& rs) const;
+        void set_failed_eq(unsigned id, expr_ref_vector const& ls, expr_ref_vector const& rs);
+
         bool solve_eqs(unsigned start);
         bool solve_eq(unsigned idx);
         bool simplify_eq(expr_ref_vector& l, expr_ref_vector& r, dependency* dep);
@@ -500,7 +516,7 @@ namespace smt {
             unsigned    m_last;
             cell(cell* p, expr* e, dependency* d): m_parent(p), m_expr(e), m_dep(d), m_last(0) {}
         };
-        scoped_ptr_vector<cell> m_all_cells;
+        region      m_cell_region;      // cells of explain_eq, released when it returns
         cell* mk_cell(cell* p, expr* e, dependency* d);
         void unfold(cell* c, ptr_vector<cell>& cons);
         void display_explain(std::ostream& out, unsigned indent, expr* e);
@@ -48,6 +48,7 @@ namespace smt {
         s.m_asserted_qhead_old = m_asserted_qhead;
         m_graph.push();        
         m_ufctx.get_trail_stack().push_scope();
+        m_closure.push();
     }
 
     void theory_special_relations::relation::pop(unsigned num_scopes) {
@@ -58,6 +59,8 @@ namespace smt {
         m_scopes.shrink(new_lvl);
         m_graph.pop(num_scopes);        
         m_ufctx.get_trail_stack().pop_scope(num_scopes);
+        m_closure.pop(num_scopes);
+        m_new_pairs.reset();
     }
 
     void theory_special_relations::relation::ensure_var(theory_var v) {
@@ -72,7 +75,62 @@ namespace smt {
         ensure_var(v2);
         literal_vector ls;
         ls.push_back(l);        
-        return m_graph.add_non_strict_edge(v1, v2, ls) && m_graph.add_non_strict_edge(v2, v1, ls);
+        if (!m_graph.add_non_strict_edge(v1, v2, ls) || !m_graph.add_non_strict_edge(v2, v1, ls))
+            return false;
+        if (m_property == sr_po) {
+            m_closure.add_edge(v1, v2, m_new_pairs);
+            m_closure.add_edge(v2, v1, m_new_pairs);
+        }
+        return true;
+    }
+
+    /**
+       \brief add the pairs that become reachable through the edge u -> v.
+       Every node that reaches u (or u itself) now reaches every node reachable from v (or v itself).
+       A source that already reaches v reaches all successors of v.
+    */
+    void theory_special_relations::closure::add_edge(unsigned u, unsigned v, svector<std::pair<unsigned, unsigned>>& new_pairs) {
+        if (reaches(u, v))
+            return;
+        unsigned n = std::max(u, v) + 1;
+        if (m_succ.size() < n) {
+            m_succ.resize(n);
+            m_pred.resize(n);
+        }
+        m_sources.reset();
+        m_targets.reset();
+        m_sources.push_back(u);
+        for (unsigned x : m_pred[u]) 
+            if (x != u)
+                m_sources.push_back(x);
+        m_targets.push_back(v);
+        for (unsigned y : m_succ[v]) 
+            if (y != v)
+                m_targets.push_back(y);
+        for (unsigned x : m_sources) {
+            if (m_succ[x].contains(v))
+                continue;
+            for (unsigned y : m_targets) {
+                if (m_succ[x].contains(y))
+                    continue;
+                m_succ[x].insert(y);
+                m_pred[y].insert(x);
+                m_trail.push_back({ x, y });
+                new_pairs.push_back({ x, y });
+            }
+        }
+    }
+
+    void theory_special_relations::closure::pop(unsigned num_scopes) {
+        unsigned new_lvl = m_lim.size() - num_scopes;
+        unsigned lim = m_lim[new_lvl];
+        for (unsigned i = m_trail.size(); i-- > lim; ) {
+            auto [x, y] = m_trail[i];
+            m_succ[x].remove(y);
+            m_pred[y].remove(x);
+        }
+        m_trail.shrink(lim);
+        m_lim.shrink(new_lvl);
     }
 
     std::ostream& theory_special_relations::relation::display(theory_special_relations const& th, std::ostream& out) const {
@@ -155,6 +213,10 @@ namespace smt {
         ctx.set_var_theory(v, get_id());
         atom* a = alloc(atom, v, *r, v0, v1);
         m_atoms.push_back(a);
+        if (r->m_property == sr_po) {
+            r->m_out_atoms.reserve(v0 + 1);
+            r->m_out_atoms[v0].push_back(a);
+        }
         TRACE("special_relations", tout << mk_pp(atm, m) << " : bv" << v << " v" << a->v1() << " v" << a->v2() << ' ' << gate_ctx << "\n";);
         m_bool_var2atom.insert(v, a);
         return true;
@@ -183,6 +245,8 @@ namespace smt {
                 set_neg_cycle_conflict(r);
                 break;
             }
+            if (!r.m_new_pairs.empty())
+                m_can_propagate = true;
         }
     }
 
@@ -571,16 +635,73 @@ namespace smt {
         return res;
     }
     
+    /*
+      \brief Propagation for partial orders.
+      Positive atoms extend the transitive closure, negative atoms are checked against it.
+    */
     lbool theory_special_relations::propagate_po(atom& a) {
         lbool res = l_true;
+        relation& r = a.get_relation();
         if (a.phase()) {
-            relation& r = a.get_relation();
             r.m_uf.merge(a.v1(), a.v2());
             res = enable(a);
+            if (res == l_true)
+                r.m_closure.add_edge(a.v1(), a.v2(), r.m_new_pairs);
+        }
+        else if (r.m_closure.reaches(a.v1(), a.v2())) {
+            // v1 !-> v2, but v1 -> v3 -> v4 -> v2
+            r.m_explanation.reset();
+            if (a.v1() != a.v2()) {
+                unsigned timestamp = r.m_graph.get_timestamp();
+                VERIFY(r.m_graph.find_shortest_reachable_path(a.v1(), a.v2(), timestamp, r));
+            }
+            TRACE("special_relations", tout << "check po conflict\n";);
+            r.m_explanation.push_back(a.explanation());
+            set_conflict(r);
+            res = l_false;
         }
         return res;
     }
 
+    /*
+      \brief assign the atoms of a partial order whose arguments became reachable
+      and detect conflicts with atoms that are already false.
+    */
+    lbool theory_special_relations::propagate_reachable(relation& r) {
+        lbool res = l_true;
+        for (unsigned i = 0; res == l_true && i < r.m_new_pairs.size(); ++i) {
+            auto [x, y] = r.m_new_pairs[i];
+            if (x >= r.m_out_atoms.size())
+                continue;
+            for (atom* a : r.m_out_atoms[x]) {
+                if (a->v2() != static_cast<theory_var>(y))
+                    continue;
+                lbool val = ctx.get_assignment(a->var());
+                if (val == l_true)
+                    continue;
+                r.m_explanation.reset();
+                if (x != y) {
+                    unsigned timestamp = r.m_graph.get_timestamp();
+                    VERIFY(r.m_graph.find_shortest_reachable_path(x, y, timestamp, r));
+                }
+                literal lit(a->var());
+                if (val == l_false) {
+                    r.m_explanation.push_back(~lit);
+                    set_conflict(r);
+                    res = l_false;
+                    break;
+                }
+                literal_vector const& lits = r.m_explanation;
+                TRACE("special_relations", ctx.display_literals_verbose(tout, lits) << " => " << lit << "\n";);
+                ctx.assign(lit, ctx.mk_justification(
+                               ext_theory_propagation_justification(
+                                   get_id(), ctx, lits.size(), lits.data(), 0, nullptr, lit)));
+            }
+        }
+        r.m_new_pairs.reset();
+        return res;
+    }
+
     lbool theory_special_relations::propagate_tc(atom& a) {
         if (a.phase()) {
             VERIFY(a.enable());
@@ -590,22 +711,15 @@ namespace smt {
         return l_true;
     }
 
+    /*
+      \brief negative atoms are checked against the transitive closure,
+      which includes edges that were added after the atoms were propagated.
+    */
     lbool theory_special_relations::final_check_po(relation& r) {
         for (atom* ap : r.m_asserted_atoms) {
             atom& a = *ap;
-            if (a.phase())
-                continue;
-            // v1 !-> v2
-            // find v1 -> v3 -> v4 -> v2 path
-            r.m_explanation.reset();
-            unsigned timestamp = r.m_graph.get_timestamp();
-            bool found_path = a.v1() == a.v2() || r.m_graph.find_shortest_reachable_path(a.v1(), a.v2(), timestamp, r);
-            if (found_path) {
-                TRACE("special_relations", tout << "check po conflict\n";);
-                r.m_explanation.push_back(a.explanation());
-                set_conflict(r);
+            if (!a.phase() && propagate_po(a) == l_false)
                 return l_false;
-            }
         }
         return l_true;
     }
@@ -643,15 +757,17 @@ namespace smt {
             }
             ++r.m_asserted_qhead;
         }
+        if (res == l_true && !r.m_new_pairs.empty())
+            res = propagate_reachable(r);
         return res;
     }
 
     void theory_special_relations::reset_eh() {
+        del_atoms(0);
         for (auto const& kv : m_relations) {
             dealloc(kv.m_value);
         }
         m_relations.reset();
-        del_atoms(0);
     }
 
     void theory_special_relations::assign_eh(bool_var v, bool is_true) {
@@ -687,6 +803,11 @@ namespace smt {
             --it;
             atom* a = *it;
             m_bool_var2atom.erase(a->var());
+            relation& r = a->get_relation();
+            if (r.m_property == sr_po) {
+                SASSERT(r.m_out_atoms[a->v1()].back() == a);
+                r.m_out_atoms[a->v1()].pop_back();
+            }
             dealloc(a);
         }
         m_atoms.shrink(old_size);
@@ -24,6 +24,7 @@ Notes:
 #include "smt/theory_diff_logic.h"
 #include "util/union_find.h"
 #include "util/rational.h"
+#include "util/uint_set.h"
 
 namespace smt {
     class theory_special_relations : public theory {
@@ -90,6 +91,25 @@ namespace smt {
 
         typedef union_find<union_find_default_ctx> union_find_t;
 
+        /**
+           \brief transitive closure of the enabled edges of a partial order, maintained
+           incrementally when edges are added (in the style of Italiano) and undone on pop.
+           m_succ[u] are the nodes reachable from u, m_pred[v] the nodes that reach v.
+           Reachability is reflexive, but nodes are only in their own sets when they lie on a cycle.
+        */
+        class closure {
+            vector<uint_set>                      m_succ;
+            vector<uint_set>                      m_pred;
+            svector<std::pair<unsigned, unsigned>> m_trail;
+            unsigned_vector                       m_lim;
+            unsigned_vector                       m_sources, m_targets;
+        public:
+            bool reaches(unsigned u, unsigned v) const { return u == v || (u < m_succ.size() && m_succ[u].contains(v)); }
+            void add_edge(unsigned u, unsigned v, svector<std::pair<unsigned, unsigned>>& new_pairs);
+            void push() { m_lim.push_back(m_trail.size()); }
+            void pop(unsigned num_scopes);
+        };
+
         struct relation {
             ast_manager&           m;
             func_decl_ref          m_next;
@@ -102,6 +122,9 @@ namespace smt {
             union_find_default_ctx m_ufctx;
             union_find_t           m_uf;
             literal_vector         m_explanation;
+            closure                m_closure;          // reachability of partial orders
+            svector<std::pair<unsigned, unsigned>> m_new_pairs; // pairs that became reachable since the last propagation
+            vector<atoms>          m_out_atoms;        // atoms of partial orders indexed by their first argument
 
             relation(sr_property p, func_decl* d, ast_manager& m): m(m), m_next(m), m_property(p), m_decl(d), m_asserted_qhead(0), m_uf(m_ufctx) {}
 
@@ -152,6 +175,7 @@ namespace smt {
         lbool  propagate_plo(atom& a);
         lbool  propagate_po(atom& a); 
         lbool  propagate_tc(atom& a); 
+        lbool  propagate_reachable(relation& r);
         theory_var mk_var(expr* e);
         void count_children(graph const& g, unsigned_vector& num_children);
         void ensure_strict(graph& g);
@@ -139,6 +139,7 @@ theory * theory_user_propagator::mk_fresh(context * new_ctx) {
     if ((bool)m_final_eh) th->register_final(m_final_eh);
     if ((bool)m_eq_eh) th->register_eq(m_eq_eh);
     if ((bool)m_diseq_eh) th->register_diseq(m_diseq_eh);
+    if ((bool)m_batch_eh) th->register_batch(m_batch_eh);
     if ((bool)m_created_eh) th->register_created(m_created_eh);
     if ((bool)m_decide_eh) th->register_decide(m_decide_eh);
     return th;
@@ -165,14 +166,27 @@ final_check_status theory_user_propagator::final_check_eh() {
 }
 
 void theory_user_propagator::new_fixed_eh(theory_var v, expr* value, unsigned num_lits, literal const* jlits) {
-    if (!m_fixed_eh)
+    if (!has_fixed())
         return;
     force_push();
+    if (m_batch_eh)
+        m_prop.push_back(prop_info(literal_vector(num_lits, jlits), v, expr_ref(value, m)));
+    else
+        fixed_core(v, value, num_lits, jlits);
+}
+
+bool theory_user_propagator::mark_fixed(theory_var v, unsigned num_lits, literal const* jlits) {
     if (m_fixed.contains(v))
-        return;
+        return false;
     m_fixed.insert(v);
     ctx.push_trail(insert_map<uint_set, unsigned>(m_fixed, v));
     m_id2justification.setx(v, literal_vector(num_lits, jlits), literal_vector());
+    return true;
+}
+
+void theory_user_propagator::fixed_core(theory_var v, expr* value, unsigned num_lits, literal const* jlits) {
+    if (!mark_fixed(v, num_lits, jlits))
+        return;
     try {
         m_fixed_eh(m_user_context, this, var2expr(v), value);
     }
@@ -361,7 +375,53 @@ void theory_user_propagator::propagate_consequence(prop_info const& prop) {
 }
 
 void theory_user_propagator::propagate_new_fixed(prop_info const& prop) {
-    new_fixed_eh(prop.m_var, prop.m_conseq, prop.m_lits.size(), prop.m_lits.data());
+    if (m_fixed_eh)
+        fixed_core(prop.m_var, prop.m_conseq, prop.m_lits.size(), prop.m_lits.data());
+}
+
+void theory_user_propagator::new_eq_eh(theory_var v1, theory_var v2) {
+    if (!m_eq_eh && !m_batch_eh)
+        return;
+    force_push();
+    if (m_batch_eh)
+        m_prop.push_back(prop_info(v1, v2, m));
+    else
+        m_eq_eh(m_user_context, this, var2expr(v1), var2expr(v2));
+}
+
+void theory_user_propagator::propagate_new_eq(prop_info const& prop) {
+    expr* a = var2expr(prop.m_var);
+    expr* b = var2expr(prop.m_var2);
+    m_eq_eh(m_user_context, this, a, b);
+}
+
+void theory_user_propagator::add_to_batch(prop_info const& prop) {
+    if (prop.m_var2 != null_theory_var) {
+        m_batch_lhs.push_back(var2expr(prop.m_var));
+        m_batch_rhs.push_back(var2expr(prop.m_var2));
+    }
+    else if (mark_fixed(prop.m_var, prop.m_lits.size(), prop.m_lits.data())) {
+        m_batch_fixed.push_back(var2expr(prop.m_var));
+        m_batch_values.push_back(prop.m_conseq);
+    }
+}
+
+/**
+   \brief deliver the fixed values and equalities collected by add_to_batch in one call.
+   Events collected before a conflict are dropped, the backtracking that follows
+   undoes them together with the queue head.
+*/
+void theory_user_propagator::propagate_batch() {
+    if (ctx.inconsistent() || (m_batch_fixed.empty() && m_batch_lhs.empty()))
+        return;
+    try {
+        m_batch_eh(m_user_context, this, 
+                   m_batch_fixed.size(), m_batch_fixed.data(), m_batch_values.data(), 
+                   m_batch_lhs.size(), m_batch_lhs.data(), m_batch_rhs.data());
+    }
+    catch (...) {
+        throw default_exception("Exception thrown in \"batch\"-callback");
+    }
 }
 
 
@@ -388,10 +448,18 @@ void theory_user_propagator::propagate() {
     }
 
     qhead = m_qhead;
+    m_batch_fixed.reset();
+    m_batch_values.reset();
+    m_batch_lhs.reset();
+    m_batch_rhs.reset();
     while (qhead < m_prop.size() && !ctx.inconsistent()) {
         auto const& prop = m_prop[qhead];
         if (prop.m_var == null_theory_var)
             propagate_consequence(prop);
+        else if (m_batch_eh)
+            add_to_batch(prop);
+        else if (prop.m_var2 != null_theory_var)
+            propagate_new_eq(prop);
         else
             propagate_new_fixed(prop);
         ++m_stats.m_num_propagations;
@@ -399,6 +467,8 @@ void theory_user_propagator::propagate() {
     }
     ctx.push_trail(value_trail<unsigned>(m_qhead));
     m_qhead = qhead;
+    if (m_batch_eh)
+        propagate_batch();
 }
 
 
@@ -35,6 +35,7 @@ namespace smt {
             svector<std::pair<expr*, expr*>>       m_eqs;
             literal_vector                         m_lits;
             theory_var                             m_var = null_theory_var;            
+            theory_var                             m_var2 = null_theory_var; // queued equality m_var == m_var2
             prop_info(unsigned num_fixed, expr* const* fixed_ids,
                       unsigned num_eqs, expr* const* eq_lhs, expr* const* eq_rhs, expr_ref const& c):
                 m_ids(num_fixed, fixed_ids),
@@ -47,6 +48,11 @@ namespace smt {
                 m_conseq(val),
                 m_lits(lits),
                 m_var(v) {}
+
+            prop_info(theory_var v1, theory_var v2, ast_manager& m):
+                m_conseq(m),
+                m_var(v1),
+                m_var2(v2) {}
                 
         };
 
@@ -64,6 +70,7 @@ namespace smt {
         user_propagator::fixed_eh_t     m_fixed_eh;
         user_propagator::eq_eh_t        m_eq_eh;
         user_propagator::eq_eh_t        m_diseq_eh;
+        user_propagator::batch_eh_t     m_batch_eh;
         user_propagator::created_eh_t   m_created_eh;
         user_propagator::decide_eh_t    m_decide_eh;
 
@@ -88,6 +95,7 @@ namespace smt {
         lbool                  m_next_split_phase = l_undef;
         vector<expr_ref_vector> m_clauses_to_replay;
         unsigned                m_replay_qhead = 0;
+        ptr_vector<expr>        m_batch_fixed, m_batch_values, m_batch_lhs, m_batch_rhs;
 
         expr* var2expr(theory_var v) { return m_var2expr.get(v); }
         theory_var expr2var(expr* e) { check_defined(e); return m_expr2var[e->get_id()]; }
@@ -100,6 +108,11 @@ namespace smt {
 
         void propagate_consequence(prop_info const& prop);
         void propagate_new_fixed(prop_info const& prop);
+        void propagate_new_eq(prop_info const& prop);
+        bool mark_fixed(theory_var v, unsigned num_lits, literal const* jlits);
+        void fixed_core(theory_var v, expr* value, unsigned num_lits, literal const* jlits);
+        void add_to_batch(prop_info const& prop);
+        void propagate_batch();
         
         bool_var enode_to_bool(enode* n, unsigned bit);
 
@@ -130,10 +143,11 @@ namespace smt {
         void register_fixed(user_propagator::fixed_eh_t& fixed_eh) { m_fixed_eh = fixed_eh; }
         void register_eq(user_propagator::eq_eh_t& eq_eh) { m_eq_eh = eq_eh; }
         void register_diseq(user_propagator::eq_eh_t& diseq_eh) { m_diseq_eh = diseq_eh; }
+        void register_batch(user_propagator::batch_eh_t& batch_eh) { m_batch_eh = batch_eh; }
         void register_created(user_propagator::created_eh_t& created_eh) { m_created_eh = created_eh; }
         void register_decide(user_propagator::decide_eh_t& decide_eh) { m_decide_eh = decide_eh; }
 
-        bool has_fixed() const { return (bool)m_fixed_eh; }
+        bool has_fixed() const { return (bool)m_fixed_eh || (bool)m_batch_eh; }
         
         bool propagate_cb(unsigned num_fixed, expr* const* fixed_ids, unsigned num_eqs, expr* const* lhs, expr* const* rhs, expr* conseq) override;
         void register_cb(expr* e) override;
@@ -147,7 +161,7 @@ namespace smt {
         char const* get_name() const override { return "user_propagate"; }
         bool internalize_atom(app* atom, bool gate_ctx) override;
         bool internalize_term(app* term) override;
-        void new_eq_eh(theory_var v1, theory_var v2) override { if (m_eq_eh) force_push(), m_eq_eh(m_user_context, this, var2expr(v1), var2expr(v2)); }
+        void new_eq_eh(theory_var v1, theory_var v2) override;
         void new_diseq_eh(theory_var v1, theory_var v2) override { if (m_diseq_eh) force_push(), m_diseq_eh(m_user_context, this, var2expr(v1), var2expr(v2)); }
         bool use_diseqs() const override { return ((bool)m_diseq_eh); }
         bool build_models() const override { return false; }
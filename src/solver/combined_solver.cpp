@@ -21,9 +21,15 @@ Notes:
 #include "util/scoped_timer.h"
 #include "util/common_msgs.h"
 #include "ast/ast_pp.h"
+#include "ast/ast_translation.h"
+#include "model/model.h"
 #include "solver/solver.h"
 #include "solver/combined_solver_params.hpp"
 #include <atomic>
+#ifndef SINGLE_THREAD
+#include <thread>
+#include <mutex>
+#endif
 #define PS_VB_LVL 15
 
 /**
@@ -42,6 +48,10 @@ Notes:
        - push is used
        - assertions are performed after a check_sat
        - parameter ignore_solver1==false
+
+   With the parameter race, solver 1 runs on a copy of the assertions in
+   a separate thread while solver 2 runs in incremental mode.
+   The first solver to return sat or unsat cancels the other one.
 */
 class combined_solver : public solver {
 public:
@@ -65,6 +75,14 @@ private:
     bool                 m_ignore_solver1;
     inc_unknown_behavior m_inc_unknown_behavior;
     unsigned             m_inc_timeout;
+    bool                 m_race;
+    // result of a copy of solver 1 that won a race.
+    bool                 m_use_race_results = false;
+    model_ref            m_race_model;
+    proof_ref            m_race_proof;
+    std::string          m_race_reason_unknown;
+    unsigned             m_num_race_solver1_wins = 0;
+    unsigned             m_num_race_solver2_wins = 0;
     
     void switch_inc_mode() {
         m_inc_mode = true;
@@ -90,6 +108,7 @@ private:
         m_inc_timeout    = p.solver2_timeout();
         m_ignore_solver1 = p.ignore_solver1();
         m_inc_unknown_behavior = static_cast<inc_unknown_behavior>(p.solver2_unknown());
+        m_race           = p.race();
     }
 
     ast_manager& get_manager() const override { return m_solver1->get_manager(); }
@@ -114,9 +133,122 @@ private:
         }
     }
 
+#ifdef SINGLE_THREAD
+    lbool race_solvers() {
+        throw default_exception("combined_solver.race requires threads");
+    }
+#else
+    /**
+       \brief run solver 2 and a copy of solver 1 in a fresh manager concurrently.
+       The copy is cancelled as soon as solver 2 returns sat or unsat, and
+       solver 2 is cancelled when the copy returns first.
+       When the copy wins, its model, proof and reason unknown are translated back.
+       The thread running the copy is joined on every exit path.
+    */
+    lbool race_solvers() {
+        ast_manager& m = get_manager();
+        if (m.has_trace_stream())
+            throw default_exception("threads and trace are incompatible");
+        scoped_ptr<ast_manager> new_m = alloc(ast_manager, m, !m.proof_mode());
+        scoped_limits scl(m.limit());
+        scl.push_child(&new_m->limit());
+        ref<solver> s1 = m_solver1->translate(*new_m, get_params());
+        std::mutex mux;
+        unsigned winner = 0;
+        bool canceled2 = false;
+        lbool r1 = l_undef, r2 = l_undef;
+
+        auto solver1_thread = [&]() {
+            try {
+                r1 = s1->check_sat(0, nullptr);
+            }
+            catch (...) {
+                r1 = l_undef;
+            }
+            if (r1 == l_undef)
+                return;
+            std::lock_guard<std::mutex> lock(mux);
+            if (winner == 0) {
+                winner = 1;
+                canceled2 = true;
+                m.limit().inc_cancel();
+            }
+        };
+        std::thread t1(solver1_thread);
+
+        auto stop_solver1 = [&]() {
+            {
+                std::lock_guard<std::mutex> lock(mux);
+                if (winner == 0 && (r2 != l_undef || !use_solver1_when_undef())) {
+                    winner = 2;
+                    new_m->limit().cancel();
+                }
+            }
+            t1.join();
+            if (canceled2)
+                m.limit().dec_cancel();
+        };
+
+        try {
+            r2 = m_solver2->check_sat_core(0, nullptr);
+        }
+        catch (z3_exception&) {
+            bool rethrow = false;
+            {
+                std::lock_guard<std::mutex> lock(mux);
+                if (winner != 1) {
+                    rethrow = true;
+                    winner = 2;
+                    new_m->limit().cancel();
+                }
+            }
+            if (rethrow) {
+                t1.join();
+                throw;
+            }
+        }
+        catch (...) {
+            {
+                std::lock_guard<std::mutex> lock(mux);
+                if (winner == 0)
+                    winner = 2;
+                new_m->limit().cancel();
+            }
+            t1.join();
+            if (canceled2)
+                m.limit().dec_cancel();
+            throw;
+        }
+        stop_solver1();
+
+        if (winner == 2)
+            ++m_num_race_solver2_wins;
+        if (winner != 1)
+            return r2;
+        ++m_num_race_solver1_wins;
+        IF_VERBOSE(PS_VB_LVL, verbose_stream() << "(combined-solver \"solver 1 won the race\")\n";);
+        m_use_race_results = true;
+        m_race_reason_unknown = s1->reason_unknown();
+        ast_translation tr(*new_m, m);
+        if (r1 == l_false && m.proofs_enabled()) {
+            proof* pr = s1->get_proof();
+            if (pr)
+                m_race_proof = tr(pr);
+        }
+        if (r1 == l_true) {
+            model_ref mdl;
+            s1->get_model(mdl);
+            if (mdl)
+                m_race_model = mdl->translate(tr);
+        }
+        return r1;
+    }
+#endif
+
 public:
     combined_solver(solver * s1, solver * s2, params_ref const & p):
-        solver(s1->get_manager()) {
+        solver(s1->get_manager()),
+        m_race_proof(s1->get_manager()) {
         m_solver1 = s1;
         m_solver2 = s2;
         updt_local_params(p);
@@ -211,6 +343,10 @@ public:
     lbool check_sat_core(unsigned num_assumptions, expr * const * assumptions) override {
         m_check_sat_executed  = true;        
         m_use_solver1_results = false;
+        m_use_race_results    = false;
+        m_race_model          = nullptr;
+        m_race_proof          = nullptr;
+        m_race_reason_unknown.clear();
 
         if (get_num_assumptions() != 0 ||            
             num_assumptions > 0 ||  // assumptions were provided            
@@ -220,6 +356,11 @@ public:
             return m_solver2->check_sat_core(num_assumptions, assumptions);
         }
         
+        if (m_inc_mode && m_race) {
+            IF_VERBOSE(PS_VB_LVL, verbose_stream() << "(combined-solver \"racing solver 1 and solver 2\")\n";);
+            return race_solvers();
+        }
+
         if (m_inc_mode) {
             if (m_inc_timeout == UINT_MAX) {
                 IF_VERBOSE(PS_VB_LVL, verbose_stream() << "(combined-solver \"using solver 2 (without a timeout)\")\n";);            
@@ -293,9 +434,15 @@ public:
         m_solver2->collect_statistics(st);
         if (m_use_solver1_results)
             m_solver1->collect_statistics(st);
+        if (m_race) {
+            st.update("combined race solver1 wins", m_num_race_solver1_wins);
+            st.update("combined race solver2 wins", m_num_race_solver2_wins);
+        }
     }
 
     void get_unsat_core(expr_ref_vector & r) override {
+        if (m_use_race_results)
+            return;
         if (m_use_solver1_results)
             m_solver1->get_unsat_core(r);
         else
@@ -303,7 +450,9 @@ public:
     }
 
     void get_model_core(model_ref & m) override {
-        if (m_use_solver1_results)
+        if (m_use_race_results)
+            m = m_race_model;
+        else if (m_use_solver1_results)
             m_solver1->get_model(m);
         else
             m_solver2->get_model(m);
@@ -316,6 +465,15 @@ public:
             m_solver2->get_levels(vars, depth);
     }
 
+    void export_lemmas(unsigned max_num, expr_ref_vector& lemmas, unsigned_vector& glue) override {
+        m_solver2->export_lemmas(max_num, lemmas, glue);
+    }
+
+    void import_lemmas(expr_ref_vector const& lemmas, unsigned_vector const& glue) override {
+        switch_inc_mode();
+        m_solver2->import_lemmas(lemmas, glue);
+    }
+
     expr_ref_vector get_trail(unsigned max_level) override {
         if (m_use_solver1_results)
             return m_solver1->get_trail(max_level);
@@ -324,6 +482,8 @@ public:
     }
 
     proof * get_proof_core() override {
+        if (m_use_race_results)
+            return m_race_proof.get();
         if (m_use_solver1_results)
             return m_solver1->get_proof_core();
         else
@@ -331,6 +491,8 @@ public:
     }
 
     std::string reason_unknown() const override {
+        if (m_use_race_results)
+            return m_race_reason_unknown;
         if (m_use_solver1_results)
             return m_solver1->reason_unknown();
         else
@@ -379,6 +541,10 @@ public:
         m_solver2->user_propagate_register_diseq(diseq_eh);
     }
     
+    void user_propagate_register_batch(user_propagator::batch_eh_t& batch_eh) override {
+        m_solver2->user_propagate_register_batch(batch_eh);
+    }
+    
     void user_propagate_register_expr(expr* e) override {
         m_solver2->user_propagate_register_expr(e);
     }
@@ -74,9 +74,56 @@ struct mus::imp {
             mus.push_back(m_lit2expr.back());
             return l_true;
         }
+        if (m_lit2expr.size() > qx_threshold)
+            return get_mus_qx(mus);
         return get_mus1(mus);
     }
 
+    // large cores are shrunk by QuickXplain, which needs O(k log(n/k))
+    // checks for a MUS of size k among n soft constraints.
+    static const unsigned qx_threshold = 64;
+
+    lbool get_mus_qx(expr_ref_vector& mus) {
+        ptr_vector<expr> soft(m_lit2expr.size(), m_lit2expr.data());
+        expr_ref_vector background(m_assumptions);
+        return quick_xplain(background, false, soft, 0, soft.size(), mus);
+    }
+
+    /**
+       \brief add to mus a minimal subset of soft[lo:hi] that is inconsistent
+       together with background. When has_delta holds the background was
+       extended since the last check and is tested for consistency first.
+    */
+    lbool quick_xplain(expr_ref_vector& background, bool has_delta, ptr_vector<expr> const& soft, 
+                       unsigned lo, unsigned hi, expr_ref_vector& mus) {
+        if (has_delta) {
+            lbool is_sat = m_solver.check_sat(background);
+            if (is_sat == l_false)
+                return l_true;
+            if (is_sat == l_undef)
+                return l_undef;
+            update_model();
+        }
+        if (hi - lo == 1) {
+            mus.push_back(soft[lo]);
+            return l_true;
+        }
+        IF_VERBOSE(12, verbose_stream() << "(mus quick-xplain: " << hi - lo << " new core: " << mus.size() << ")\n";);
+        unsigned mid = lo + (hi - lo) / 2;
+        unsigned sz = background.size(), mus_sz = mus.size();
+        background.append(mid - lo, soft.data() + lo);
+        lbool r = quick_xplain(background, true, soft, mid, hi, mus);
+        background.shrink(sz);
+        if (r != l_true)
+            return r;
+        unsigned num_delta = mus.size() - mus_sz;
+        for (unsigned i = mus_sz; i < mus_sz + num_delta; ++i)
+            background.push_back(mus.get(i));
+        r = quick_xplain(background, num_delta > 0, soft, lo, mid, mus);
+        background.shrink(sz);
+        return r;
+    }
+
     lbool get_mus1(expr_ref_vector& mus) {
         ptr_vector<expr> unknown(m_lit2expr.size(), m_lit2expr.data());
         expr_ref_vector core_exprs(m);
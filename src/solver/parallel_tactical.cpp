@@ -28,8 +28,10 @@ Notes:
  
 --*/
 
+#include <fstream>
 #include "util/scoped_ptr_vector.h"
 #include "ast/ast_pp.h"
+#include "ast/ast_serialize.h"
 #include "ast/ast_util.h"
 #include "ast/ast_translation.h"
 #include "solver/solver.h"
@@ -396,10 +398,12 @@ private:
     int           m_exn_code;
     std::string   m_exn_msg;
     std::string   m_reason_undef;
+    std::string   m_cube_dump;
+    std::atomic<unsigned> m_num_dumped;
 
     void init() {
         parallel_params pp(m_params);
-        m_num_threads = std::min((unsigned) std::thread::hardware_concurrency(), pp.threads_max());
+        m_num_threads = get_num_threads(pp.threads_max());
         m_progress = 0;
         m_has_undef = false;
         m_allsat = false;
@@ -408,6 +412,8 @@ private:
         m_last_depth = 0;
         m_backtrack_frequency = pp.conquer_backtrack_frequency();
         m_conquer_delay = pp.conquer_delay();
+        m_cube_dump = pp.cube_dump().str();
+        m_num_dumped = 0;
         m_exn_code = 0;
         m_params.set_bool("override_incremental", true);
         m_core = nullptr;        
@@ -636,8 +642,29 @@ private:
         }                
     }
 
+    /*
+     * \brief write each cube with the assertions of s to its own file.
+     */
+    void dump_cubes(solver_state& s, vector<cube_var> const& cubes) {
+        expr_ref_vector fmls(s.m());
+        for (auto const& c : cubes) {
+            fmls.reset();
+            s.get_solver().get_assertions(fmls);
+            fmls.append(c.cube());
+            std::string file_name = m_cube_dump + "_" + std::to_string(m_num_dumped++) + ".bin";
+            std::ofstream out(file_name, std::ios::binary);
+            if (!out) {
+                IF_VERBOSE(0, verbose_stream() << "could not open file " << file_name << " for output\n");
+                return;
+            }
+            serialize(out, fmls);
+        }
+    }
+
     void spawn_cubes(solver_state& s, unsigned width, vector<cube_var>& cubes) {
         if (cubes.empty()) return;
+        if (!m_cube_dump.empty())
+            dump_cubes(s, cubes);
         add_branches(cubes.size());
         s.set_cubes(cubes);        
         solver_state* s1 = nullptr;
@@ -856,6 +883,7 @@ public:
         m_params.copy(p);
         parallel_params pp(p);
         m_conquer_delay = pp.conquer_delay();
+        m_cube_dump = pp.cube_dump().str();
     }
 
     void collect_statistics(statistics & st) const override {
@@ -116,6 +116,7 @@ class simplifier_solver : public solver {
     expr_ref_vector             m_assumptions;
     model_converter_ref         m_mc;
     bool                        m_inconsistent = false;
+    bool                        m_mc_updated = true;    // the reconstruction trail changed since m_mc was extracted
     expr_safe_replace           m_core_replace;
 
     void replace(expr_ref_vector& r) {
@@ -137,13 +138,20 @@ class simplifier_solver : public solver {
             TRACE("solver", tout << "qhead " << qhead << "\n";
                   m_preprocess_state.display(tout));
             m_preprocess_state.advance_qhead();
+            m_mc_updated = true;
         }
         if (!assumptions.empty()) {
             m_preprocess_state.replay(m_preprocess_state.qhead(), assumptions);   
+            m_mc_updated = true;
             for (unsigned i = 0; i < assumptions.size(); ++i) 
                 m_core_replace.insert(assumptions.get(i), orig_assumptions.get(i));            
         }
-        m_mc = m_preprocess_state.model_trail().get_model_converter(); 
+        // extracting the model converter walks the entire trail, 
+        // so it is only redone when preprocessing or pop changed the trail.
+        if (m_mc_updated) {
+            m_mc = m_preprocess_state.model_trail().get_model_converter(); 
+            m_mc_updated = false;
+        }
         m_cached_mc = nullptr;
         for (; qhead < m_fmls.size(); ++qhead)
             add_with_dependency(m_fmls[qhead]);
@@ -220,6 +228,7 @@ public:
         m_cached_model = nullptr;
         m_preprocess.pop(n);
         m_preprocess_state.pop(n);
+        m_mc_updated = true;
     }
 
     lbool check_sat_core(unsigned num_assumptions, expr* const* assumptions) override { 
@@ -371,6 +380,8 @@ public:
     void get_units_core(expr_ref_vector& units) override { s->get_units_core(units); }
     expr_ref_vector get_trail(unsigned max_level) override { return s->get_trail(max_level); }
     void get_levels(ptr_vector<expr> const& vars, unsigned_vector& depth) override { s->get_levels(vars, depth); }
+    void export_lemmas(unsigned max_num, expr_ref_vector& lemmas, unsigned_vector& glue) override { s->export_lemmas(max_num, lemmas, glue); }
+    void import_lemmas(expr_ref_vector const& lemmas, unsigned_vector const& glue) override { s->import_lemmas(lemmas, glue); }
 
     void register_on_clause(void* ctx, user_propagator::on_clause_eh_t& on_clause) override {
         s->register_on_clause(ctx, on_clause);
@@ -387,6 +398,7 @@ public:
     void user_propagate_register_final(user_propagator::final_eh_t& final_eh) override { s->user_propagate_register_final(final_eh); }
     void user_propagate_register_eq(user_propagator::eq_eh_t& eq_eh) override { s->user_propagate_register_eq(eq_eh); }    
     void user_propagate_register_diseq(user_propagator::eq_eh_t& diseq_eh) override { s->user_propagate_register_diseq(diseq_eh); }    
+    void user_propagate_register_batch(user_propagator::batch_eh_t& batch_eh) override { s->user_propagate_register_batch(batch_eh); }
     void user_propagate_register_expr(expr* e) override { m_preprocess_state.freeze(e);  s->user_propagate_register_expr(e); }
     void user_propagate_register_created(user_propagator::created_eh_t& r) override { s->user_propagate_register_created(r); }
     void user_propagate_register_decide(user_propagator::decide_eh_t& r) override { s->user_propagate_register_decide(r); }
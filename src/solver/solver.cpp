@@ -18,6 +18,7 @@ Notes:
 --*/
 #include "util/common_msgs.h"
 #include "util/stopwatch.h"
+#include "util/phase_profiler.h"
 #include "ast/ast_util.h"
 #include "ast/ast_pp.h"
 #include "ast/ast_pp_util.h"
@@ -110,14 +111,33 @@ lbool solver::get_consequences_core(expr_ref_vector const& asms, expr_ref_vector
     model_ref model;
     get_model(model);
     expr_ref tmp(m), nlit(m), lit(m), val(m);
-    expr_ref_vector asms1(asms);
+    expr_ref_vector asms1(asms), values(m);
     model_evaluator eval(*model.get());
+    for (expr* v : vars)
+        values.push_back(eval(v));
+    // a variable whose value differs from the first model in a later model is not fixed.
+    bool_vector unfixed(vars.size(), false);
+    auto filter_unfixed = [&](unsigned i) {
+        model_ref mdl;
+        get_model(mdl);
+        if (!mdl)
+            return;
+        model_evaluator ev(*mdl.get());
+        expr_ref r(m);
+        for (unsigned j = i + 1; j < vars.size(); ++j) {
+            if (unfixed[j] || !m.is_value(values.get(j)))
+                continue;
+            r = ev(vars[j]);
+            if (m.is_value(r) && r != values.get(j))
+                unfixed[j] = true;
+        }
+    };
     unsigned k = 0;
     for (unsigned i = 0; i < vars.size(); ++i) {
         expr_ref_vector core(m);
         tmp = vars[i];
-        val = eval(tmp);
-        if (!m.is_value(val)) {
+        val = values.get(i);
+        if (unfixed[i] || !m.is_value(val)) {
             // vars[i] is unfixed
             continue;
         }
@@ -141,6 +161,7 @@ lbool solver::get_consequences_core(expr_ref_vector const& asms, expr_ref_vector
                 return is_sat;
             case l_true:
                 // vars[i] is unfixed
+                filter_unfixed(i);
                 break;
             case l_false:
                 get_unsat_core(core);
@@ -167,6 +188,7 @@ lbool solver::get_consequences_core(expr_ref_vector const& asms, expr_ref_vector
                 return is_sat;
             case l_true:
                 // vars[i] is unfixed
+                filter_unfixed(i);
                 break;
             case l_false:
                 get_unsat_core(core);
@@ -229,12 +251,20 @@ void solver::reset_params(params_ref const & p) {
     m_params.append(p);
     solver_params sp(m_params);
     m_cancel_backup_file = sp.cancel_backup_file();
+    set_memory_limits();
 }
 
 void solver::updt_params(params_ref const & p) {
     m_params.copy(p);
     solver_params sp(m_params);
     m_cancel_backup_file = sp.cancel_backup_file();
+    set_memory_limits();
+}
+
+void solver::set_memory_limits() {
+    solver_params sp(m_params);
+    m_max_memory = megabytes_to_bytes(sp.check_max_memory());
+    m_memory_high = megabytes_to_bytes(sp.memory_high_watermark());
 }
 
 
@@ -314,6 +344,8 @@ expr_ref_vector solver::get_non_units() {
 lbool solver::check_sat(unsigned num_assumptions, expr * const * assumptions) {
     lbool r = l_undef;
     scoped_solver_time _st(*this);
+    phase_scope _profile("check-sat", phase_profiler::enabled() ? get_num_assertions() : 0);
+    scoped_memory_rlimit _ml(get_manager().limit(), m_max_memory, m_memory_high);
     try {
         r = check_sat_core(num_assumptions, assumptions);
     }
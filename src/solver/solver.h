@@ -51,6 +51,9 @@ solver* mk_smt2_solver(ast_manager& m, params_ref const& p, symbol const& logic
 class solver : public check_sat_result, public user_propagator::core {
     params_ref  m_params;
     symbol      m_cancel_backup_file;
+    uint64_t    m_max_memory = 0;        // per check, in bytes, 0 for no limit
+    uint64_t    m_memory_high = 0;
+    void set_memory_limits();
 public:
     solver(ast_manager& m): check_sat_result(m) {}
 
@@ -277,6 +280,18 @@ public:
     
     virtual void get_levels(ptr_vector<expr> const& vars, unsigned_vector& depth) = 0;
 
+    /**
+       \brief retrieve up to max_num learned clauses with their glue (literal block distance),
+       the lowest glue first. Solvers that do not learn clauses return nothing.
+    */
+    virtual void export_lemmas(unsigned max_num, expr_ref_vector& lemmas, unsigned_vector& glue) {}
+
+    /**
+       \brief add clauses that are implied by the assertions as learned clauses.
+       Lemmas over atoms that the solver does not know are ignored.
+    */
+    virtual void import_lemmas(expr_ref_vector const& lemmas, unsigned_vector const& glue) {}
+
     class scoped_push {
         solver& s;
         bool    m_nopop;
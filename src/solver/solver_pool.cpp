@@ -35,7 +35,10 @@ class pool_solver : public solver_na2as {
     bool               m_dump_benchmarks;
     double             m_dump_threshold;
     unsigned           m_dump_counter;
+    unsigned           m_num_retired;
 
+    // number of resets that retire the predicate before the base solver is refreshed.
+    static const unsigned max_retired = 32;
 
     bool is_virtual() const { return !m.is_true(m_pred); }
 public:
@@ -52,7 +55,8 @@ public:
         m_in_delayed_scope(false),
         m_dump_benchmarks(false),
         m_dump_threshold(5.0),
-        m_dump_counter(0) {
+        m_dump_counter(0),
+        m_num_retired(0) {
         if (is_virtual()) {
             solver_na2as::assert_expr_core2(m.mk_true(), pred);
         }
@@ -62,6 +66,7 @@ public:
     ~pool_solver() override {
         if (m_pushed) pop(get_scope_level());
         if (is_virtual()) {
+            ++m_pool.m_stats.m_num_retired;
             m_pred = m.mk_not(m_pred);
             m_base->assert_expr(m_pred);
         }
@@ -277,7 +282,21 @@ public:
         SASSERT(!m_pushed);
         m_head = 0;
         m_assertions.reset();
-        m_pool.refresh(m_base.get());
+        if (is_virtual() && get_scope_level() == 0 && m_num_retired < max_retired) {
+            // disable the assertions guarded by the current predicate and
+            // continue on the same base solver with a fresh predicate.
+            // This avoids internalizing the background assertions again.
+            ++m_num_retired;
+            ++m_pool.m_stats.m_num_retired;
+            m_base->assert_expr(m.mk_not(m_pred));
+            m_pred = m_pool.mk_pred();
+            SASSERT(!m_assumptions.empty());
+            m_assumptions[0] = m_pred;
+        }
+        else {
+            m_num_retired = 0;
+            m_pool.refresh(m_base.get());
+        }
     }
 
 private:
@@ -367,6 +386,9 @@ void solver_pool::collect_statistics(statistics &st) const {
     st.update("pool_solver.checks", m_stats.m_num_checks);
     st.update("pool_solver.checks.sat", m_stats.m_num_sat_checks);
     st.update("pool_solver.checks.undef", m_stats.m_num_undef_checks);
+    st.update("pool_solver.retired", m_stats.m_num_retired);
+    st.update("pool_solver.refreshes", m_stats.m_num_refreshes);
+    st.update("pool_solver.solvers", m_solvers.size());
 }
 
 void solver_pool::reset_statistics() {
@@ -400,22 +422,34 @@ solver* solver_pool::mk_solver() {
         solver* s = m_solvers[(m_current_pool++) % m_num_pools];
         base_solver = dynamic_cast<pool_solver*>(s)->base_solver();
     }
-    std::stringstream name;
-    name << "vsolver#" << m_solvers.size();
-    app_ref pred(m.mk_const(symbol(name.str()), m.mk_bool_sort()), m);
+    app_ref pred = mk_pred();
     pool_solver* solver = alloc(pool_solver, base_solver.get(), *this, pred);
     m_solvers.push_back(solver);
     return solver;
 }
 
+app_ref solver_pool::mk_pred() {
+    ast_manager& m = m_base_solver->get_manager();
+    std::stringstream name;
+    name << "vsolver#" << m_num_preds++;
+    return app_ref(m.mk_const(symbol(name.str()), m.mk_bool_sort()), m);
+}
+
 void solver_pool::reset_solver(solver* s) {
     pool_solver* ps = dynamic_cast<pool_solver*>(s);
     SASSERT(ps);
     if (ps) ps->reset();
 }
 
+/**
+   \brief replace base_solver by a fresh copy of the background solver.
+   The assertions guarded by retired predicates are dropped together with the old
+   base solver, and the pool solvers using it assert their current assertions again
+   on the next check.
+*/
 void solver_pool::refresh(solver* base_solver) {
     ast_manager& m = m_base_solver->get_manager();
+    ++m_stats.m_num_refreshes;
     ref<solver> new_base = m_base_solver->translate(m, m_base_solver->get_params());
     for (solver* s0 : m_solvers) {
         pool_solver* s = dynamic_cast<pool_solver*>(s0);
@@ -37,6 +37,8 @@ class solver_pool {
         unsigned m_num_checks;
         unsigned m_num_sat_checks;
         unsigned m_num_undef_checks;
+        unsigned m_num_retired;      // activation predicates disabled in place
+        unsigned m_num_refreshes;    // base solvers replaced to drop retired assertions
         stats() { reset(); }
         void reset() { memset(this, 0, sizeof(*this)); }
     };
@@ -44,6 +46,7 @@ class solver_pool {
     ref<solver>         m_base_solver;
     unsigned            m_num_pools;
     unsigned            m_current_pool;
+    unsigned            m_num_preds = 0;
     sref_vector<solver> m_solvers;
     stats               m_stats;
 
@@ -54,6 +57,8 @@ class solver_pool {
 
     void refresh(solver* s);
 
+    app_ref mk_pred();
+
     ptr_vector<solver> get_base_solvers() const;
   
 public:
@@ -41,6 +41,7 @@ Notes:
 #include "ast/simplifiers/flatten_clauses.h"
 #include "ast/simplifiers/bound_simplifier.h"
 #include "ast/simplifiers/cnf_nnf.h"
+#include "ast/simplifiers/seq_length_abstraction.h"
 #include "smt/params/smt_params.h"
 #include "solver/solver_preprocess.h"
 #include "qe/lite/qe_lite_tactic.h"
@@ -64,6 +65,7 @@ void init_preprocess(ast_manager& m, params_ref const& p, then_simplifier& s, de
     if (smtp.m_solve_eqs) s.add_simplifier(alloc(euf::solve_eqs, m, st));
     if (smtp.m_elim_unconstrained) s.add_simplifier(alloc(elim_unconstrained, m, st));
     if (smtp.m_nnf_cnf) s.add_simplifier(alloc(cnf_nnf_simplifier, m, p, st));
+    if (smtp.m_seq_length_abstraction) s.add_simplifier(alloc(seq_length_abstraction_simplifier, m, p, st));
     if (smtp.m_macro_finder || smtp.m_quasi_macros) s.add_simplifier(alloc(eliminate_predicates, m, st));
     if (smtp.m_qe_lite) s.add_simplifier(mk_qe_lite_simplifier(m, p, st));
     if (smtp.m_pull_nested_quantifiers) s.add_simplifier(alloc(pull_nested_quantifiers_simplifier, m, p, st));
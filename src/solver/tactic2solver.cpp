@@ -116,6 +116,10 @@ public:
         m_tactic->user_propagate_register_diseq(diseq_eh);
     }
 
+    void user_propagate_register_batch(user_propagator::batch_eh_t& batch_eh) override {
+        m_tactic->user_propagate_register_batch(batch_eh);
+    }
+
     void user_propagate_register_expr(expr* e) override {
         m_tactic->user_propagate_register_expr(e);
     }
@@ -310,6 +310,7 @@ static bool is_qfauflia(goal const & g) {
 
 class is_qflia_probe : public probe {
 public:
+    char const* cache_key() const override { return "is-qflia"; }
     result operator()(goal const & g) override {
         return is_qflia(g);
     }
@@ -317,6 +318,7 @@ public:
 
 class is_qfauflia_probe : public probe {
 public:
+    char const* cache_key() const override { return "is-qfauflia"; }
     result operator()(goal const & g) override {
         return is_qfauflia(g);
     }
@@ -329,6 +331,7 @@ static bool is_qflra(goal const & g) {
 
 class is_qflra_probe : public probe {
 public:
+    char const* cache_key() const override { return "is-qflra"; }
     result operator()(goal const & g) override {
         return is_qflra(g);
     }
@@ -341,6 +344,7 @@ static bool is_qflira(goal const & g) {
 
 class is_qflira_probe : public probe {
 public:
+    char const* cache_key() const override { return "is-qflira"; }
     result operator()(goal const & g) override {
         return is_qflira(g);
     }
@@ -385,6 +389,7 @@ static bool is_mip(goal const & g) {
 
 class is_ilp_probe : public probe {
 public:
+    char const* cache_key() const override { return "is-ilp"; }
     result operator()(goal const & g) override {
         return is_ilp(g);
     }
@@ -392,6 +397,7 @@ public:
 
 class is_mip_probe : public probe {
 public:
+    char const* cache_key() const override { return "is-mip"; }
     result operator()(goal const & g) override {
         return is_mip(g);
     }
@@ -642,6 +648,7 @@ struct is_non_qfufnra_functor {
 
 class is_qfnia_probe : public probe {
 public:
+    char const* cache_key() const override { return "is-qfnia"; }
     result operator()(goal const & g) override {
         return is_qfnia(g);
     }
@@ -649,6 +656,7 @@ public:
 
 class is_qfnra_probe : public probe {
 public:
+    char const* cache_key() const override { return "is-qfnra"; }
     result operator()(goal const & g) override {
         return is_qfnra(g);
     }
@@ -656,6 +664,7 @@ public:
 
 class is_nia_probe : public probe {
 public:
+    char const* cache_key() const override { return "is-nia"; }
     result operator()(goal const & g) override {
         return is_nia(g);
     }
@@ -663,6 +672,7 @@ public:
 
 class is_nra_probe : public probe {
 public:
+    char const* cache_key() const override { return "is-nra"; }
     result operator()(goal const & g) override {
         return is_nra(g);
     }
@@ -670,6 +680,7 @@ public:
 
 class is_nira_probe : public probe {
 public:
+    char const* cache_key() const override { return "is-nira"; }
     result operator()(goal const & g) override {
         return is_nira(g);
     }
@@ -677,6 +688,7 @@ public:
 
 class is_lia_probe : public probe {
 public:
+    char const* cache_key() const override { return "is-lia"; }
     result operator()(goal const & g) override {
         return is_lia(g);
     }
@@ -684,6 +696,7 @@ public:
 
 class is_lra_probe : public probe {
 public:
+    char const* cache_key() const override { return "is-lra"; }
     result operator()(goal const & g) override {
         return is_lra(g);
     }
@@ -691,6 +704,7 @@ public:
 
 class is_lira_probe : public probe {
 public:
+    char const* cache_key() const override { return "is-lira"; }
     result operator()(goal const & g) override {
         return is_lira(g);
     }
@@ -703,6 +717,7 @@ static bool is_qfufnra(goal const& g) {
 
 class is_qfufnra_probe : public probe {
 public:
+    char const* cache_key() const override { return "is-qfufnra"; }
     result operator()(goal const & g) override {
         return is_qfufnra(g);
     }
@@ -0,0 +1,55 @@
+/*++
+Copyright (c) 2024 Microsoft Corporation
+
+Module Name:
+
+    seq_length_abstraction_tactic.h
+
+Abstract:
+
+    Tactic for adding the length abstraction of sequence constraints.
+
+Tactic Documentation:
+
+## Tactic seq-length-abstraction
+
+### Short Description:
+
+Add linear constraints over the lengths of sequences that are implied by
+equations, regular membership, prefix, suffix and containment constraints.
+
+### Long Description
+
+The added constraints are redundant, but they are available to the
+arithmetic solver from the start. Length conflicts are then detected
+before the sequence solver enumerates splits, and lengths that are
+determined by the abstraction are propagated eagerly.
+
+### Example
+
+```z3
+  (declare-const x String)
+  (declare-const y String)
+  (assert (= (str.++ x "ab" y) (str.++ y x)))
+  (apply seq-length-abstraction)
+```
+
+### Notes
+
+* supports unsat cores
+
+--*/
+#pragma once
+
+#include "util/params.h"
+#include "tactic/dependent_expr_state_tactic.h"
+#include "ast/simplifiers/seq_length_abstraction.h"
+
+inline tactic * mk_seq_length_abstraction_tactic(ast_manager& m, params_ref const& p = params_ref()) {
+    return alloc(dependent_expr_state_tactic, m, p,
+                 [](auto& m, auto& p, auto &s) -> dependent_expr_simplifier* { return alloc(seq_length_abstraction_simplifier, m, p, s); });
+}
+
+/*
+  ADD_TACTIC("seq-length-abstraction", "add linear length constraints implied by sequence constraints.", "mk_seq_length_abstraction_tactic(m, p)")
+*/
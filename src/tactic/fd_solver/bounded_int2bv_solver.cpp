@@ -44,6 +44,7 @@ class bounded_int2bv_solver : public solver_na2as {
     mutable obj_map<func_decl, rational>   m_bv2offset;
     mutable bv2int_rewriter_ctx   m_rewriter_ctx;
     mutable bv2int_rewriter_star  m_rewriter;
+    mutable expr_safe_replace     m_sub;
     mutable bool                  m_flushed;
 
 public:
@@ -59,6 +60,7 @@ public:
         m_int_fns(m),
         m_rewriter_ctx(m, p, p.get_uint("max_bv_size", UINT_MAX)),
         m_rewriter(m, m_rewriter_ctx),
+        m_sub(m),
         m_flushed(false)
     {
         solver::updt_params(p);
@@ -79,6 +81,7 @@ public:
         for (auto& kv : m_int2bv) result->m_int2bv.insert(tr(kv.m_key), tr(kv.m_value));        
         for (auto& kv : m_bv2int) result->m_bv2int.insert(tr(kv.m_key), tr(kv.m_value));
         for (auto& kv : m_bv2offset) result->m_bv2offset.insert(tr(kv.m_key), kv.m_value);
+        for (auto& kv : result->m_int2bv) result->m_sub.insert(dst_m.mk_const(kv.m_key), result->mk_bv_term(kv.m_value));
         for (func_decl* f : m_bv_fns) result->m_bv_fns.push_back(tr(f));
         for (func_decl* f : m_int_fns) result->m_int_fns.push_back(tr(f));
         for (bound_manager* b : m_bounds) result->m_bounds.push_back(b->translate(dst_m));
@@ -112,6 +115,7 @@ public:
         m_solver->push();
         m_bv_fns_lim.push_back(m_bv_fns.size());
         m_bounds.push_back(alloc(bound_manager, m));
+        m_sub.push_scope();
     }
 
     void pop_core(unsigned n) override {
@@ -131,6 +135,7 @@ public:
             m_bv_fns_lim.resize(new_sz);
             m_bv_fns.resize(lim);
             m_int_fns.resize(lim);
+            m_sub.pop_scope(n);
         }
 
         while (n > 0) {
@@ -175,6 +180,12 @@ public:
     void get_levels(ptr_vector<expr> const& vars, unsigned_vector& depth) override {
         m_solver->get_levels(vars, depth);
     }
+    void export_lemmas(unsigned max_num, expr_ref_vector& lemmas, unsigned_vector& glue) override {
+        m_solver->export_lemmas(max_num, lemmas, glue);
+    }
+    void import_lemmas(expr_ref_vector const& lemmas, unsigned_vector const& glue) override {
+        m_solver->import_lemmas(lemmas, glue);
+    }
     expr_ref_vector get_trail(unsigned max_level) override {
         return m_solver->get_trail(max_level);
     }
@@ -253,13 +264,26 @@ public:
 
 private:
 
-    void accumulate_sub(expr_safe_replace& sub) const {
-        for (unsigned i = 0; i < m_bounds.size(); ++i) {
-            accumulate_sub(sub, *m_bounds[i]);
+    /**
+       \brief the integer constant of fbv as a bit-vector term with its offset.
+    */
+    expr_ref mk_bv_term(func_decl* fbv) const {
+        rational offset;
+        VERIFY(m_bv2offset.find(fbv, offset));
+        expr_ref t(m.mk_const(fbv), m);
+        t = m_bv.mk_bv2int(t);
+        if (!offset.is_zero()) {
+            t = m_arith.mk_add(t, m_arith.mk_numeral(offset, true));
         }
+        return t;
     }
 
-    void accumulate_sub(expr_safe_replace& sub, bound_manager& bm) const {
+    /**
+       \brief add the bounded integers of bm that have no bit-vector yet to the substitution.
+       The substitution is scoped with the solver, so integers introduced
+       in earlier flushes or scopes keep their encoding and are not revisited.
+    */
+    void accumulate_sub(bound_manager& bm) const {
         bound_manager::iterator it = bm.begin(), end = bm.end();
         for (; it != end; ++it) {
             expr* e = *it;
@@ -269,35 +293,26 @@ private:
             func_decl* f = to_app(e)->get_decl();
 
             if (bm.has_lower(e, lo, s1) && bm.has_upper(e, hi, s2) && lo <= hi && !s1 && !s2 && m_arith.is_int(e)) {
-                func_decl* fbv;
-                rational offset;
-                if (!m_int2bv.find(f, fbv)) {
-                    rational n = hi - lo + rational::one();
-                    unsigned num_bits = get_num_bits(n);
-                    expr_ref b(m);
-                    b = m.mk_fresh_const("b", m_bv.mk_sort(num_bits));
-                    fbv = to_app(b)->get_decl();
-                    offset = lo;
-                    m_int2bv.insert(f, fbv);
-                    m_bv2int.insert(fbv, f);
-                    m_bv2offset.insert(fbv, offset);
-                    m_bv_fns.push_back(fbv);
-                    m_int_fns.push_back(f);
-                    unsigned shift;
-                    if (!offset.is_zero() && !n.is_power_of_two(shift)) {
-                        m_assertions.push_back(m_bv.mk_ule(b, m_bv.mk_numeral(n-rational::one(), num_bits)));
-                    }
-                }
-                else {
-                    VERIFY(m_bv2offset.find(fbv, offset));
-                }
-                expr_ref t(m.mk_const(fbv), m);
-                t = m_bv.mk_bv2int(t);
-                if (!offset.is_zero()) {
-                    t = m_arith.mk_add(t, m_arith.mk_numeral(offset, true));
+                if (m_int2bv.contains(f))
+                    continue;
+                rational n = hi - lo + rational::one();
+                unsigned num_bits = get_num_bits(n);
+                expr_ref b(m);
+                b = m.mk_fresh_const("b", m_bv.mk_sort(num_bits));
+                func_decl* fbv = to_app(b)->get_decl();
+                rational offset = lo;
+                m_int2bv.insert(f, fbv);
+                m_bv2int.insert(fbv, f);
+                m_bv2offset.insert(fbv, offset);
+                m_bv_fns.push_back(fbv);
+                m_int_fns.push_back(f);
+                unsigned shift;
+                if (!offset.is_zero() && !n.is_power_of_two(shift)) {
+                    m_assertions.push_back(m_bv.mk_ule(b, m_bv.mk_numeral(n-rational::one(), num_bits)));
                 }
+                expr_ref t = mk_bv_term(fbv);
                 TRACE("pb", tout << lo << " <= " << hi << " offset: " << offset << "\n"; tout << mk_pp(e, m) << " |-> " << t << "\n";);
-                sub.insert(e, t);
+                m_sub.insert(e, t);
             }
             else {
                 TRACE("pb", 
@@ -333,16 +348,15 @@ private:
         for (expr* a : m_assertions) 
             bm(a, nullptr, nullptr);        
         TRACE("int2bv", bm.display(tout););
-        expr_safe_replace sub(m);
-        accumulate_sub(sub);
+        accumulate_sub(bm);
         proof_ref proof(m);
         expr_ref fml1(m), fml2(m);
-        if (sub.empty()) {
+        if (m_sub.empty()) {
             m_solver->assert_expr(m_assertions);
         }
         else {
             for (expr* a : m_assertions) {
-                sub(a, fml1);
+                m_sub(a, fml1);
                 m_rewriter(fml1, fml2, proof);
                 if (!m.inc()) {
                     m_rewriter.reset();
@@ -102,6 +102,12 @@ public:
     void get_levels(ptr_vector<expr> const& vars, unsigned_vector& depth) override {
         m_solver->get_levels(vars, depth);
     }
+    void export_lemmas(unsigned max_num, expr_ref_vector& lemmas, unsigned_vector& glue) override {
+        m_solver->export_lemmas(max_num, lemmas, glue);
+    }
+    void import_lemmas(expr_ref_vector const& lemmas, unsigned_vector const& glue) override {
+        m_solver->import_lemmas(lemmas, glue);
+    }
 
     expr_ref_vector get_trail(unsigned max_level) override {
         return m_solver->get_trail(max_level);
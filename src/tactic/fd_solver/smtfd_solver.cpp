@@ -470,6 +470,7 @@ namespace smtfd {
         plugin_context&          m_context;
         expr_ref_vector          m_values;
         ast_ref_vector           m_pinned;
+        ast_ref_vector           m_table_keys;
         expr_ref_vector          m_args, m_vargs;
         f_app_eq                 m_eq;
         f_app_hash               m_hash;
@@ -501,6 +502,7 @@ namespace smtfd {
             m_context(context),
             m_values(m),
             m_pinned(m),
+            m_table_keys(m),
             m_args(m), 
             m_vargs(m),
             m_eq(*this),
@@ -517,7 +519,8 @@ namespace smtfd {
                 idx = m_tables.size();
                 m_tables.push_back(alloc(table, DEFAULT_HASHTABLE_INITIAL_CAPACITY, m_hash, m_eq));
                 m_ast2table.insert(f, s, idx);
-                m_pinned.push_back(f);
+                m_table_keys.push_back(f);
+                m_table_keys.push_back(s);
             }
             return *m_tables[idx];
         }
@@ -598,10 +601,15 @@ namespace smtfd {
         virtual bool sort_covered(sort* s) = 0;
         virtual unsigned max_rounds() = 0;
         virtual void populate_model(model_ref& mdl, expr_ref_vector const& terms) {}
+        /**
+           \brief the table entries refer to values of the current model.
+           The tables and their keys are kept allocated for the next refinement
+           round and only their entries are removed.
+        */
         virtual void reset() {
+            for (table* t : m_tables)
+                t->reset();
             m_pinned.reset();
-            m_tables.reset();
-            m_ast2table.reset();
             m_values.reset();
         }
     };
@@ -863,7 +871,8 @@ namespace smtfd {
                     TRACE("smtfd_verbose", tout << mk_bounded_pp(f.m_t, m, 2) << " := " << val << "\n";);
                     fi->insert_new_entry(args.data(), val);
                 }
-                mdl->register_decl(fn, fi);
+                if (fi)
+                    mdl->register_decl(fn, fi);
             }
             for (expr* t : subterms::ground(terms)) {
                 if (is_uninterp_const(t) && sort_covered(t->get_sort())) {
@@ -113,10 +113,22 @@ void goal::copy_to(goal & target) const {
     target.m_mc                   = m_mc.get(); 
     target.m_pc                   = m_pc.get(); 
     target.m_dc                   = m_dc.get();
+    target.m_probe_cache          = m_probe_cache;
+}
+
+bool goal::find_probe_result(char const* key, double& r) const {
+    for (auto const& [k, v] : m_probe_cache) {
+        if (k == key) {
+            r = v;
+            return true;
+        }
+    }
+    return false;
 }
 
 void goal::push_back(expr * f, proof * pr, expr_dependency * d) {
     SASSERT(!proofs_enabled() || pr);
+    m_probe_cache.reset();
     if (m().is_true(f))
         return;
     if (m().is_false(f)) {
@@ -285,6 +297,7 @@ void goal::get_formulas(expr_ref_vector & result) const {
 void goal::update(unsigned i, expr * f, proof * pr, expr_dependency * d) {
     if (m_inconsistent)
         return;
+    m_probe_cache.reset();
     if (proofs_enabled()) {
         SASSERT(pr);
         if (!pr)
@@ -322,6 +335,7 @@ void goal::update(unsigned i, expr * f, proof * pr, expr_dependency * d) {
 }
 
 void goal::reset_core() {
+    m_probe_cache.reset();
     m().del(m_forms);
     m().del(m_proofs);
     m().del(m_dependencies);
@@ -473,6 +487,7 @@ unsigned goal::num_exprs() const {
 
 void goal::shrink(unsigned j) {
     SASSERT(j <= size());
+    m_probe_cache.reset();
     unsigned sz = size();
     for (unsigned i = j; i < sz; i++)
         m().pop_back(m_forms);
@@ -487,6 +502,7 @@ void goal::shrink(unsigned j) {
    \brief Eliminate true formulas.
 */
 void goal::elim_true() {
+    m_probe_cache.reset();
     unsigned sz = size();
     unsigned j = 0;
     for (unsigned i = 0; i < sz; i++) {
@@ -536,6 +552,7 @@ unsigned goal::get_not_idx(expr * f) const {
 void goal::elim_redundancies() {
     if (inconsistent())
         return;
+    m_probe_cache.reset();
     expr_ref_fast_mark1 neg_lits(m());
     expr_ref_fast_mark2 pos_lits(m());
     unsigned sz = size();
@@ -657,6 +674,8 @@ bool goal::is_decided() const {
 }
 
 bool is_equal(goal const & s1, goal const & s2) {
+    if (s1.shares_formulas(s2))
+        return true;
     if (s1.size() != s2.size())
         return false;
     unsigned num1 = 0; // num unique ASTs in s1
@@ -66,6 +66,9 @@ protected:
     unsigned              m_core_enabled:1;    // unsat core extraction is enabled.
     unsigned              m_inconsistent:1;    // true if the goal is known to be inconsistent. 
     unsigned              m_precision:2;       // PRECISE, UNDER, OVER.
+    // results of probes over the formulas of the goal, see probe::cache_key.
+    // The cache is cleared when the formulas change.
+    mutable svector<std::pair<char const*, double>> m_probe_cache;
 
     void push_back(expr * f, proof * pr, expr_dependency * d);
     void quick_process(bool save_first, expr_ref & f, expr_dependency * d);
@@ -108,8 +111,13 @@ public:
     void reset_all(); // reset goal and precision and depth attributes.
     void reset(); // reset goal but preserve precision and depth attributes.
 
+    bool find_probe_result(char const* key, double& r) const;
+    void cache_probe_result(char const* key, double r) const { m_probe_cache.push_back({ key, r }); }
+
     void copy_to(goal & target) const;
     void copy_from(goal const & src) { src.copy_to(*this); }
+    // copies share the formulas until one of them is updated
+    bool shares_formulas(goal const & g) const { return m().same(m_forms, g.m_forms) && m_inconsistent == g.m_inconsistent; }
 
     void assert_expr(expr * f, proof * pr, expr_dependency * d);
     void assert_expr(expr * f, expr_dependency * d);
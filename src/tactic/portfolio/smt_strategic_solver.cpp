@@ -17,6 +17,7 @@ Author:
 Notes:
 
 --*/
+#include <fstream>
 #include "cmd_context/cmd_context.h"
 #include "solver/combined_solver.h"
 #include "solver/tactic2solver.h"
@@ -147,6 +148,25 @@ static solver* mk_solver_for_logic(ast_manager & m, params_ref const & p, symbol
     return s;
 }
 
+/**
+   \brief Return the s-expression of the tactic that overwrites the default tactic, 
+   or the empty string if there is none.
+*/
+static std::string get_default_tactic(tactic_params const& tp) {
+    symbol const& t = tp.default_tactic();
+    if (t != symbol::null && !t.is_numerical() && t.str()[0])
+        return t.str();
+    symbol const& file = tp.default_tactic_file();
+    if (file == symbol::null || file.is_numerical() || !file.str()[0])
+        return std::string();
+    std::ifstream in(file.str());
+    if (!in)
+        throw default_exception("could not open default tactic file " + file.str());
+    std::stringstream strm;
+    strm << in.rdbuf();
+    return strm.str();
+}
+
 class smt_strategic_solver_factory : public solver_factory {
     symbol m_logic;
 public:
@@ -161,11 +181,10 @@ public:
 
         tactic_params tp;
         tactic_ref t;
-        if (tp.default_tactic() != symbol::null &&
-            !tp.default_tactic().is_numerical() && 
-            tp.default_tactic().str()[0]) {
+        std::string default_tactic = get_default_tactic(tp);
+        if (!default_tactic.empty()) {
             cmd_context ctx(false, &m, l);
-            std::istringstream is(tp.default_tactic().str());
+            std::istringstream is(default_tactic);
             char const* file_name = "";
             sexpr_ref se = parse_sexpr(ctx, is, p, file_name);
             if (se) {
@@ -25,6 +25,17 @@ Revision History:
 #include "tactic/goal_util.h"
 #include "ast/rewriter/bv_rewriter.h"
 
+probe::result probe::eval(goal const & g) {
+    char const* key = cache_key();
+    double r;
+    if (key && g.find_probe_result(key, r))
+        return result(r);
+    result res = (*this)(g);
+    if (key)
+        g.cache_probe_result(key, res.get_value());
+    return res;
+}
+
 class memory_probe : public probe {
 public:
     result operator()(goal const & g) override {
@@ -52,6 +63,7 @@ public:
 
 class num_exprs_probe : public probe {
 public:
+    char const* cache_key() const override { return "num-exprs"; }
     result operator()(goal const & g) override {
         return result(g.num_exprs());
     }
@@ -109,7 +121,7 @@ class not_probe : public unary_probe {
 public:
     not_probe(probe * p):unary_probe(p) {}
     result operator()(goal const & g) override {
-        return result(!m_p->operator()(g).is_true());
+        return result(!m_p->eval(g).is_true());
     }
 };
 
@@ -117,7 +129,7 @@ class and_probe : public bin_probe {
 public:
     and_probe(probe * p1, probe * p2):bin_probe(p1, p2) {}
     result operator()(goal const & g) override {
-        return result(m_p1->operator()(g).is_true() && m_p2->operator()(g).is_true());
+        return result(m_p1->eval(g).is_true() && m_p2->eval(g).is_true());
     }
 };
 
@@ -125,7 +137,7 @@ class or_probe : public bin_probe {
 public:
     or_probe(probe * p1, probe * p2):bin_probe(p1, p2) {}
     result operator()(goal const & g) override {
-        return result(m_p1->operator()(g).is_true() || m_p2->operator()(g).is_true());
+        return result(m_p1->eval(g).is_true() || m_p2->eval(g).is_true());
     }
 };
 
@@ -133,7 +145,7 @@ class eq_probe : public bin_probe {
 public:
     eq_probe(probe * p1, probe * p2):bin_probe(p1, p2) {}
     result operator()(goal const & g) override {
-        return result(m_p1->operator()(g).get_value() == m_p2->operator()(g).get_value());
+        return result(m_p1->eval(g).get_value() == m_p2->eval(g).get_value());
     }
 };
 
@@ -141,7 +153,7 @@ class le_probe : public bin_probe {
 public:
     le_probe(probe * p1, probe * p2):bin_probe(p1, p2) {}
     result operator()(goal const & g) override {
-        return result(m_p1->operator()(g).get_value() <= m_p2->operator()(g).get_value());
+        return result(m_p1->eval(g).get_value() <= m_p2->eval(g).get_value());
     }
 };
 
@@ -149,7 +161,7 @@ class add_probe : public bin_probe {
 public:
     add_probe(probe * p1, probe * p2):bin_probe(p1, p2) {}
     result operator()(goal const & g) override {
-        return result(m_p1->operator()(g).get_value() + m_p2->operator()(g).get_value());
+        return result(m_p1->eval(g).get_value() + m_p2->eval(g).get_value());
     }
 };
 
@@ -157,7 +169,7 @@ class sub_probe : public bin_probe {
 public:
     sub_probe(probe * p1, probe * p2):bin_probe(p1, p2) {}
     result operator()(goal const & g) override {
-        return result(m_p1->operator()(g).get_value() - m_p2->operator()(g).get_value());
+        return result(m_p1->eval(g).get_value() - m_p2->eval(g).get_value());
     }
 };
 
@@ -165,7 +177,7 @@ class mul_probe : public bin_probe {
 public:
     mul_probe(probe * p1, probe * p2):bin_probe(p1, p2) {}
     result operator()(goal const & g) override {
-        return result(m_p1->operator()(g).get_value() * m_p2->operator()(g).get_value());
+        return result(m_p1->eval(g).get_value() * m_p2->eval(g).get_value());
     }
 };
 
@@ -173,7 +185,7 @@ class div_probe : public bin_probe {
 public:
     div_probe(probe * p1, probe * p2):bin_probe(p1, p2) {}
     result operator()(goal const & g) override {
-        return result(m_p1->operator()(g).get_value() / m_p2->operator()(g).get_value());
+        return result(m_p1->eval(g).get_value() / m_p2->eval(g).get_value());
     }
 };
 
@@ -303,6 +315,7 @@ struct is_non_qfbv_predicate {
 
 class is_propositional_probe : public probe {
 public:
+    char const* cache_key() const override { return "is-propositional"; }
     result operator()(goal const & g) override {
         return !test<is_non_propositional_predicate>(g);
     }
@@ -311,6 +324,7 @@ public:
 
 class is_qfbv_probe : public probe {
 public:
+    char const* cache_key() const override { return "is-qfbv"; }
     result operator()(goal const & g) override {
         return !test<is_non_qfbv_predicate>(g);
     }
@@ -353,6 +367,7 @@ struct is_non_qfaufbv_predicate {
 
 class is_qfaufbv_probe : public probe {
 public:
+    char const* cache_key() const override { return "is-qfaufbv"; }
     result operator()(goal const & g) override {
         return !test<is_non_qfaufbv_predicate>(g);
     }
@@ -391,6 +406,7 @@ struct is_non_qfufbv_predicate {
 
 class is_qfufbv_probe : public probe {
 public:
+    char const* cache_key() const override { return "is-qfufbv"; }
     result operator()(goal const & g) override {
         return !test<is_non_qfufbv_predicate>(g);
     }
@@ -469,6 +485,32 @@ probe * mk_num_bv_consts_probe() {
     return alloc(num_consts_probe, false, "bv");
 }
 
+class max_bv_size_probe : public probe {
+    struct proc {
+        bv_util  m_util;
+        unsigned m_max = 0;
+        proc(ast_manager & m): m_util(m) {}
+        void operator()(quantifier *) {}
+        void operator()(var *) {}
+        void operator()(app * n) {
+            if (n->get_num_args() == 0 && m_util.is_bv(n) && !m_util.is_numeral(n))
+                m_max = std::max(m_max, m_util.get_bv_size(n));
+        }
+    };
+public:
+    result operator()(goal const & g) override {
+        proc p(g.m());
+        expr_fast_mark1 visited;
+        for (unsigned i = 0; i < g.size(); i++)
+            for_each_expr_core<proc, expr_fast_mark1, true, true>(p, visited, g.form(i));
+        return result(p.m_max);
+    }
+};
+
+probe * mk_max_bv_size_probe() {
+    return alloc(max_bv_size_probe);
+}
+
 class produce_proofs_probe : public probe {
 public:
     result operator()(goal const & g) override {
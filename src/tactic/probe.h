@@ -49,6 +49,18 @@ public:
     void dec_ref() { SASSERT(m_ref_count > 0); --m_ref_count; if (m_ref_count == 0) dealloc(this); }
 
     virtual result operator()(goal const & g) = 0;
+
+    /**
+       \brief probes whose result only depends on the formulas of the goal
+       return a key that identifies them, so that their result is cached in the goal
+       until the formulas change.
+    */
+    virtual char const* cache_key() const { return nullptr; }
+
+    /**
+       \brief evaluate the probe, using the result cached in g if there is one.
+    */
+    result eval(goal const & g);
 };
 
 typedef ref<probe> probe_ref;
@@ -70,6 +82,7 @@ probe * mk_num_consts_probe();
 probe * mk_num_bool_consts_probe();
 probe * mk_num_arith_consts_probe();
 probe * mk_num_bv_consts_probe();
+probe * mk_max_bv_size_probe();
 
 /*
   ADD_PROBE("num-exprs", "number of expressions/terms in the given goal.", "mk_num_exprs_probe()")
@@ -77,6 +90,7 @@ probe * mk_num_bv_consts_probe();
   ADD_PROBE("num-bool-consts", "number of Boolean constants in the given goal.", "mk_num_bool_consts_probe()")
   ADD_PROBE("num-arith-consts", "number of arithmetic constants in the given goal.", "mk_num_arith_consts_probe()")
   ADD_PROBE("num-bv-consts", "number of bit-vector constants in the given goal.", "mk_num_bv_consts_probe()")
+  ADD_PROBE("max-bv-size", "maximal width of the bit-vector constants in the given goal.", "mk_max_bv_size_probe()")
 */
 
 probe * mk_produce_proofs_probe();
@@ -30,6 +30,7 @@ Notes:
 #include "sat/sat_solver/inc_sat_solver.h"
 #include "ackermannization/ackermannize_bv_tactic.h"
 #include "tactic/smtlogics/smt_tactic.h"
+#include "params/tactic_params.hpp"
 
 #define MEMLIMIT 300
 
@@ -121,10 +122,33 @@ static tactic * mk_qfbv_tactic(ast_manager& m, params_ref const & p, tactic* sat
 }
 
 
-tactic * mk_qfbv_tactic(ast_manager & m, params_ref const & p) {
+static tactic * mk_qfbv_blast_tactic(ast_manager & m, params_ref const & p) {
     tactic * new_sat = cond(mk_produce_proofs_probe(),
                             and_then(mk_simplify_tactic(m), mk_smt_tactic(m, p)),
                             mk_psat_tactic(m, p));
     return mk_qfbv_tactic(m, p, new_sat, mk_smt_tactic(m, p));
+}
 
+/**
+   \brief wide bit-vectors produce large circuits when they are bit-blasted.
+   Int-blasting translates them to a linear integer problem that is solved
+   by the arithmetic solver of the SAT core, so the two are run in parallel.
+*/
+static tactic * mk_qfbv_intblast_tactic(ast_manager & m, params_ref const & p) {
+    params_ref int_p = p;
+    int_p.set_bool("smt", true);
+    int_p.set_uint("bv.solver", 2);
+    return and_then(mk_qfbv_preamble(m, p), mk_smt_tactic(m, int_p));
+}
+
+tactic * mk_qfbv_tactic(ast_manager & m, params_ref const & p) {
+    tactic_params tp(p);
+    unsigned min_size = tp.qfbv_intblast_min_bv_size();
+    if (min_size == 0)
+        return mk_qfbv_blast_tactic(m, p);
+    probe * wide = mk_and(mk_not(mk_produce_proofs_probe()),
+                          mk_ge(mk_max_bv_size_probe(), mk_const_probe(min_size)));
+    return cond(wide,
+                par(mk_qfbv_intblast_tactic(m, p), mk_qfbv_blast_tactic(m, p)),
+                mk_qfbv_blast_tactic(m, p));
 }
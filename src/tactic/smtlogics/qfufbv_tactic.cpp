@@ -30,7 +30,6 @@ Notes:
 ///////////////
 #include "model/model_smt2_pp.h"
 #include "ackermannization/lackr.h"
-#include "ackermannization/ackermannization_params.hpp"
 #include "tactic/smtlogics/qfufbv_ackr_model_converter.h"
 ///////////////
 #include "sat/sat_solver/inc_sat_solver.h"
@@ -93,8 +92,7 @@ public:
     }
 
     void collect_statistics(statistics & st) const override {
-        ackermannization_params p(m_p);
-        if (!p.eager()) st.update("lackr-its", m_st.m_it);
+        if (m_st.m_it > 0) st.update("lackr-its", m_st.m_it);
         st.update("ackr-constraints", m_st.m_ackrs_sz);
     }
 
@@ -20,6 +20,7 @@ Notes:
 #include "tactic/tactic.h"
 #include "tactic/probe.h"
 #include "util/stopwatch.h"
+#include "util/phase_profiler.h"
 #include "model/model_v2_pp.h"
 
 
@@ -28,11 +29,15 @@ struct tactic_report::imp {
     goal const &    m_goal;
     stopwatch       m_watch;
     double          m_start_memory;
+    bool            m_verbose;
+    phase_scope     m_profile;
 
-    imp(char const * id, goal const & g):
+    imp(char const * id, goal const & g, bool verbose):
         m_id(id),
         m_goal(g),
-        m_start_memory(static_cast<double>(memory::get_allocation_size())/static_cast<double>(1024*1024)) {
+        m_start_memory(static_cast<double>(memory::get_allocation_size())/static_cast<double>(1024*1024)),
+        m_verbose(verbose),
+        m_profile(id, phase_profiler::enabled() ? g.num_exprs() : 0) {
         m_watch.start();
         TRACE("tactic", g.display_with_proofs(tout << id << "\n"););
         SASSERT(g.is_well_formed());
@@ -44,22 +49,27 @@ struct tactic_report::imp {
         TRACE("tactic", m_goal.display(tout << m_id << "\n");
               if (m_goal.mc()) m_goal.mc()->display(tout);
               );
-        IF_VERBOSE(0, 
-                   verbose_stream() << "(" << m_id
-                   << " :num-exprs " << m_goal.num_exprs()
-                   << " :num-asts " << m_goal.m().get_num_asts()
-                   << " :time " << std::fixed << std::setprecision(2) << m_watch.get_seconds()
-                   << " :before-memory " << std::fixed << std::setprecision(2) << m_start_memory
-                   << " :after-memory " << std::fixed << std::setprecision(2) << end_memory
-                   << ")\n");
-        IF_VERBOSE(20, m_goal.display(verbose_stream() << m_id << "\n"));
+        unsigned num_exprs = m_goal.num_exprs();
+        m_profile.set_size_after(num_exprs);
+        if (m_verbose) {
+            IF_VERBOSE(0, 
+                       verbose_stream() << "(" << m_id
+                       << " :num-exprs " << num_exprs
+                       << " :num-asts " << m_goal.m().get_num_asts()
+                       << " :time " << std::fixed << std::setprecision(2) << m_watch.get_seconds()
+                       << " :before-memory " << std::fixed << std::setprecision(2) << m_start_memory
+                       << " :after-memory " << std::fixed << std::setprecision(2) << end_memory
+                       << ")\n");
+            IF_VERBOSE(20, m_goal.display(verbose_stream() << m_id << "\n"));
+        }
         SASSERT(m_goal.is_well_formed());
     }
 };
 
 tactic_report::tactic_report(char const * id, goal const & g) {
-    if (get_verbosity_level() >= TACTIC_VERBOSITY_LVL)
-        m_imp = alloc(imp, id, g);
+    bool verbose = get_verbosity_level() >= TACTIC_VERBOSITY_LVL;
+    if (verbose || phase_profiler::enabled())
+        m_imp = alloc(imp, id, g, verbose);
     else
         m_imp = nullptr;
 }
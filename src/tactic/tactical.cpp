@@ -195,6 +195,10 @@ public:
         m_t2->user_propagate_register_diseq(diseq_eh);
     }
 
+    void user_propagate_register_batch(user_propagator::batch_eh_t& batch_eh) override {
+        m_t2->user_propagate_register_batch(batch_eh);
+    }
+
     void user_propagate_register_expr(expr* e) override {
         m_t1->user_propagate_register_expr(e);
         m_t2->user_propagate_register_expr(e);
@@ -467,6 +471,32 @@ class par_tactical : public or_else_tactical {
 
 	std::string        ex_msg;
 	unsigned           error_code;
+    // per branch: number of runs and number of runs the branch finished first.
+    unsigned_vector    m_runs;
+    unsigned_vector    m_wins;
+    unsigned           m_prune_after = 0;
+    unsigned           m_num_pruned = 0;
+
+    bool is_pruned(unsigned i) const {
+        return m_prune_after > 0 && m_runs[i] >= m_prune_after && m_wins[i] == 0;
+    }
+
+    /**
+       \brief branches to run, leaving out those that never finished first
+       in the last par.prune_after runs.
+    */
+    void active_branches(unsigned_vector& active) {
+        unsigned sz = m_ts.size();
+        m_runs.reserve(sz, 0);
+        m_wins.reserve(sz, 0);
+        for (unsigned i = 0; i < sz; ++i)
+            if (!is_pruned(i))
+                active.push_back(i);
+        if (active.empty())
+            for (unsigned i = 0; i < sz; ++i)
+                active.push_back(i);
+        m_num_pruned += sz - active.size();
+    }
 
 public:
     par_tactical(unsigned num, tactic * const * ts):or_else_tactical(num, ts) {
@@ -475,6 +505,26 @@ public:
 
     char const* name() const override { return "par"; }
 
+    void updt_params(params_ref const & p) override {
+        or_else_tactical::updt_params(p);
+        m_prune_after = p.get_uint("par.prune_after", m_prune_after);
+    }
+
+    void collect_param_descrs(param_descrs & r) override {
+        or_else_tactical::collect_param_descrs(r);
+        r.insert("par.prune_after", CPK_UINT, "skip branches that did not finish first in any of this many runs (0: never skip)", "0");
+    }
+
+    void collect_statistics(statistics & st) const override {
+        or_else_tactical::collect_statistics(st);
+        st.update("par pruned branches", m_num_pruned);
+    }
+
+    void reset_statistics() override {
+        or_else_tactical::reset_statistics();
+        m_num_pruned = 0;
+    }
+
     void operator()(goal_ref const & in, goal_ref_buffer& result) override {
         bool use_seq;
         use_seq = false;
@@ -489,18 +539,28 @@ public:
         if (m.has_trace_stream())
             throw default_exception("threads and trace are incompatible");
 
+        unsigned_vector active;
+        active_branches(active);
+        if (active.size() == 1) {
+            m_runs[active[0]]++;
+            m_ts.get(active[0])->operator()(in, result);
+            m_wins[active[0]]++;
+            return;
+        }
+
         scoped_ptr_vector<ast_manager> managers;
         scoped_limits scl(m.limit());
         goal_ref_vector                in_copies;
         tactic_ref_vector              ts;
-        unsigned sz = m_ts.size();
+        unsigned sz = active.size();
         for (unsigned i = 0; i < sz; i++) {
             ast_manager * new_m = alloc(ast_manager, m, !m.proof_mode());
             managers.push_back(new_m);
             ast_translation translator(m, *new_m);
             in_copies.push_back(in->translate(translator));
-            ts.push_back(m_ts.get(i)->translate(*new_m));
+            ts.push_back(m_ts.get(active[i])->translate(*new_m));
             scl.push_child(&new_m->limit());
+            m_runs[active[i]]++;
         }
 
         unsigned finished_id       = UINT_MAX;
@@ -566,6 +626,11 @@ public:
         for (unsigned i = 0; i < sz; ++i) {
             threads[i].join();
         }
+
+        if (finished_id != UINT_MAX) {
+            m_wins[active[finished_id]]++;
+            IF_VERBOSE(10, verbose_stream() << "(par :winner " << active[finished_id] << " :wins " << m_wins[active[finished_id]] << " :runs " << m_runs[active[finished_id]] << ")\n");
+        }
         
         if (finished_id == UINT_MAX) {
             switch (ex_kind) {
@@ -1158,7 +1223,7 @@ public:
     char const* name() const override { return "cond"; }
     
     void operator()(goal_ref const & in, goal_ref_buffer & result) override {
-        if (m_p->operator()(*(in.get())).is_true()) 
+        if (m_p->eval(*(in.get())).is_true()) 
             m_t1->operator()(in, result);
         else
             m_t2->operator()(in, result);
@@ -1197,7 +1262,7 @@ public:
     void cleanup() override {}
 
     void  operator()(goal_ref const & in, goal_ref_buffer& result) override {
-        if (m_p->operator()(*(in.get())).is_true()) {
+        if (m_p->eval(*(in.get())).is_true()) {
             throw tactic_exception("fail-if tactic");
         }
         result.push_back(in.get());
@@ -28,6 +28,7 @@ namespace user_propagator {
     typedef std::function<void(void*, callback*, expr*)>                     created_eh_t;
     typedef std::function<void(void*, callback*, expr*, unsigned, bool)>     decide_eh_t;
     typedef std::function<void(void*, expr*, unsigned, unsigned const*, unsigned, expr* const*)>        on_clause_eh_t;
+    typedef std::function<void(void*, callback*, unsigned, expr* const*, expr* const*, unsigned, expr* const*, expr* const*)> batch_eh_t;
 
     class plugin : public decl_plugin {
     public:
@@ -80,6 +81,10 @@ namespace user_propagator {
             throw default_exception("user-propagators are only supported on the SMT solver");
         }
         
+        virtual void user_propagate_register_batch(batch_eh_t& batch_eh) {
+            throw default_exception("user-propagators are only supported on the SMT solver");
+        }
+        
         virtual void user_propagate_register_expr(expr* e) { 
             throw default_exception("user-propagators are only supported on the SMT solver");
         }
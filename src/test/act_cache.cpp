@@ -0,0 +1,69 @@
+/*++
+Copyright (c) 2024 Microsoft Corporation
+
+Module Name:
+
+    act_cache.cpp
+
+Abstract:
+
+    Test the expr -> expr activity cache.
+
+--*/
+#include "ast/act_cache.h"
+#include "ast/reg_decl_plugins.h"
+#include "ast/arith_decl_plugin.h"
+
+static void tst_dense_and_sparse() {
+    ast_manager m;
+    reg_decl_plugins(m);
+    arith_util a(m);
+    expr_ref_vector xs(m);
+    for (unsigned i = 0; i < 5000; ++i)
+        xs.push_back(m.mk_const(symbol(i), a.mk_int()));
+    act_cache c(m, 1000000);
+    for (unsigned i = 0; i < xs.size(); ++i) {
+        c.insert(xs.get(i), xs.get((i + 1) % xs.size()));
+        c.insert(xs.get(i), 1, xs.get((i + 2) % xs.size()));
+    }
+    ENSURE(c.size() == 2 * xs.size());
+    for (unsigned i = 0; i < xs.size(); ++i) {
+        ENSURE(c.find(xs.get(i)) == xs.get((i + 1) % xs.size()));
+        ENSURE(c.find(xs.get(i), 1) == xs.get((i + 2) % xs.size()));
+        ENSURE(c.find(xs.get(i), 2) == nullptr);
+    }
+    // overwrite entries
+    for (unsigned i = 0; i < xs.size(); i += 2)
+        c.insert(xs.get(i), xs.get(i));
+    for (unsigned i = 0; i < xs.size(); ++i)
+        ENSURE(c.find(xs.get(i)) == (i % 2 == 0 ? xs.get(i) : xs.get((i + 1) % xs.size())));
+    c.reset();
+    ENSURE(c.empty());
+    ENSURE(c.find(xs.get(0)) == nullptr);
+}
+
+static void tst_eviction() {
+    ast_manager m;
+    reg_decl_plugins(m);
+    arith_util a(m);
+    expr_ref_vector xs(m);
+    for (unsigned i = 0; i < 3000; ++i)
+        xs.push_back(m.mk_const(symbol(i), a.mk_int()));
+    // at most 1024 unused entries are kept
+    act_cache c(m, 0);
+    expr * x0 = xs.get(0);
+    c.insert(x0, x0);
+    ENSURE(c.find(x0) == x0);
+    for (unsigned i = 1; i < xs.size(); ++i)
+        c.insert(xs.get(i), x0);
+    ENSURE(c.size() <= 1025);
+    // used entries are not evicted, the oldest unused entries are.
+    ENSURE(c.find(x0) == x0);
+    ENSURE(c.find(xs.get(1)) == nullptr);
+    ENSURE(c.find(xs.back()) == x0);
+}
+
+void tst_act_cache() {
+    tst_dense_and_sparse();
+    tst_eviction();
+}
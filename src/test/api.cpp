@@ -107,8 +107,307 @@ static void test_mk_distinct() {
     
 }
 
+static void test_check_async() {
+    Z3_config cfg = Z3_mk_config();
+    Z3_context ctx = Z3_mk_context(cfg);
+    Z3_del_config(cfg);
+    Z3_solver s = Z3_mk_solver(ctx);
+    Z3_solver_inc_ref(ctx, s);
+    Z3_sort int_sort = Z3_mk_int_sort(ctx);
+    Z3_ast x = Z3_mk_const(ctx, Z3_mk_string_symbol(ctx, "x"), int_sort);
+    Z3_ast one = Z3_mk_int(ctx, 1, int_sort);
+    Z3_ast two = Z3_mk_int(ctx, 2, int_sort);
+    Z3_solver_assert(ctx, s, Z3_mk_gt(ctx, x, one));
+    Z3_ast lt2 = Z3_mk_lt(ctx, x, two);
+
+    Z3_solver_check_async(ctx, s, 0, nullptr);
+    while (!Z3_solver_check_async_wait(ctx, s, 10))
+        ;
+    ENSURE(Z3_solver_check_async_result(ctx, s) == Z3_L_TRUE);
+
+    Z3_solver_check_async(ctx, s, 1, &lt2);
+    ENSURE(Z3_solver_check_async_result(ctx, s) == Z3_L_FALSE);
+    ENSURE(Z3_get_error_code(ctx) == Z3_OK);
+
+    // retrieving a result without a running check is an error
+    Z3_set_error_handler(ctx, my_cb);
+    cb_called = false;
+    Z3_solver_check_async_result(ctx, s);
+    ENSURE(cb_called);
+    Z3_solver_dec_ref(ctx, s);
+    Z3_del_context(ctx);
+}
+
+static void test_context_reset() {
+    Z3_config cfg = Z3_mk_config();
+    Z3_context ctx = Z3_mk_context(cfg);
+    Z3_del_config(cfg);
+    Z3_sort int_sort = Z3_mk_int_sort(ctx);
+    Z3_ast x = Z3_mk_const(ctx, Z3_mk_string_symbol(ctx, "x"), int_sort);
+    Z3_ast fml = Z3_mk_gt(ctx, x, Z3_mk_int(ctx, 1, int_sort));
+
+    // terms of a child context are terms of the parent
+    Z3_context child = Z3_mk_child_context(ctx);
+    Z3_solver s = Z3_mk_solver(child);
+    Z3_solver_inc_ref(child, s);
+    Z3_solver_assert(child, s, fml);
+    Z3_solver_assert(child, s, Z3_mk_lt(child, x, Z3_mk_int(child, 3, int_sort)));
+    ENSURE(Z3_solver_check(child, s) == Z3_L_TRUE);
+    Z3_solver_dec_ref(child, s);
+    Z3_del_context(child);
+
+    Z3_eval_smtlib2_string(ctx, "(declare-const y Int)");
+    Z3_context_reset(ctx);
+    ENSURE(Z3_get_error_code(ctx) == Z3_OK);
+    Z3_solver s2 = Z3_mk_solver(ctx);
+    Z3_solver_inc_ref(ctx, s2);
+    Z3_ast y = Z3_mk_const(ctx, Z3_mk_string_symbol(ctx, "y"), Z3_mk_int_sort(ctx));
+    Z3_solver_assert(ctx, s2, Z3_mk_eq(ctx, y, y));
+    ENSURE(Z3_solver_check(ctx, s2) == Z3_L_TRUE);
+    Z3_solver_dec_ref(ctx, s2);
+    Z3_del_context(ctx);
+}
+
+static void test_mk_ast_dag() {
+    Z3_config cfg = Z3_mk_config();
+    Z3_context ctx = Z3_mk_context(cfg);
+    Z3_del_config(cfg);
+    Z3_sort int_sort = Z3_mk_int_sort(ctx);
+    Z3_ast x = Z3_mk_const(ctx, Z3_mk_string_symbol(ctx, "x"), int_sort);
+    Z3_ast y = Z3_mk_const(ctx, Z3_mk_string_symbol(ctx, "y"), int_sort);
+    Z3_ast xy[2] = { x, y };
+    Z3_ast leaves[2] = { x, y };
+    Z3_func_decl decls[2] = { Z3_get_app_decl(ctx, Z3_to_app(ctx, Z3_mk_add(ctx, 2, xy))),
+                              Z3_get_app_decl(ctx, Z3_to_app(ctx, Z3_mk_le(ctx, x, y))) };
+    // node 2: x + y, node 3: x + y <= x, node 4: y <= x + y
+    unsigned code[] = { 0, 2, 0, 1,  1, 2, 2, 0,  1, 2, 1, 2 };
+    unsigned roots[] = { 3, 4 };
+    Z3_ast_vector v = Z3_mk_ast_dag(ctx, 2, leaves, 2, decls, 12, code, 2, roots);
+    Z3_ast_vector_inc_ref(ctx, v);
+    ENSURE(Z3_ast_vector_size(ctx, v) == 2);
+    ENSURE(Z3_get_app_arg(ctx, Z3_to_app(ctx, Z3_ast_vector_get(ctx, v, 0)), 0) ==
+           Z3_get_app_arg(ctx, Z3_to_app(ctx, Z3_ast_vector_get(ctx, v, 1)), 1));
+    Z3_solver s = Z3_mk_solver(ctx);
+    Z3_solver_inc_ref(ctx, s);
+    Z3_solver_assert_vector(ctx, s, v);
+    ENSURE(Z3_solver_get_num_scopes(ctx, s) == 0);
+    ENSURE(Z3_solver_check(ctx, s) == Z3_L_TRUE);
+
+    Z3_set_error_handler(ctx, my_cb);
+    cb_called = false;
+    unsigned bad[] = { 0, 2, 0, 7 };
+    Z3_mk_ast_dag(ctx, 2, leaves, 2, decls, 4, bad, 0, nullptr);
+    ENSURE(cb_called);
+    Z3_solver_dec_ref(ctx, s);
+    Z3_ast_vector_dec_ref(ctx, v);
+    Z3_del_context(ctx);
+}
+
+static void test_model_eval_values() {
+    Z3_config cfg = Z3_mk_config();
+    Z3_context ctx = Z3_mk_context(cfg);
+    Z3_del_config(cfg);
+    Z3_sort int_sort = Z3_mk_int_sort(ctx);
+    Z3_sort bv_sort = Z3_mk_bv_sort(ctx, 64);
+    Z3_ast x = Z3_mk_const(ctx, Z3_mk_string_symbol(ctx, "x"), int_sort);
+    Z3_ast b = Z3_mk_const(ctx, Z3_mk_string_symbol(ctx, "b"), bv_sort);
+    Z3_ast p = Z3_mk_const(ctx, Z3_mk_string_symbol(ctx, "p"), Z3_mk_bool_sort(ctx));
+    Z3_solver s = Z3_mk_solver(ctx);
+    Z3_solver_inc_ref(ctx, s);
+    Z3_solver_assert(ctx, s, Z3_mk_eq(ctx, x, Z3_mk_int64(ctx, -5000000000ll, int_sort)));
+    Z3_solver_assert(ctx, s, Z3_mk_eq(ctx, b, Z3_mk_unsigned_int64(ctx, 0xfedcba9876543210ull, bv_sort)));
+    Z3_solver_assert(ctx, s, p);
+    ENSURE(Z3_solver_check(ctx, s) == Z3_L_TRUE);
+    Z3_model m = Z3_solver_get_model(ctx, s);
+    Z3_model_inc_ref(ctx, m);
+    Z3_ast terms[3] = { x, b, p };
+    int64_t values[3];
+    ENSURE(Z3_model_eval_values(ctx, m, 3, terms, true, false, 6, reinterpret_cast<unsigned*>(values)));
+    ENSURE(values[0] == -5000000000ll);
+    ENSURE(static_cast<uint64_t>(values[1]) == 0xfedcba9876543210ull);
+    ENSURE(values[2] == 1);
+    double d;
+    ENSURE(Z3_model_eval_values(ctx, m, 1, terms, true, true, 2, reinterpret_cast<unsigned*>(&d)));
+    ENSURE(d == -5e9);
+    unsigned w;
+    ENSURE(!Z3_model_eval_values(ctx, m, 1, terms, true, false, 1, &w));
+    Z3_model_dec_ref(ctx, m);
+    Z3_solver_dec_ref(ctx, s);
+    Z3_del_context(ctx);
+}
+
+// pigeon hole problem with 4 pigeons and 3 holes
+static void assert_pigeon_hole(Z3_context ctx, Z3_solver s) {
+    Z3_ast p[4][3];
+    for (unsigned i = 0; i < 4; ++i)
+        for (unsigned j = 0; j < 3; ++j)
+            p[i][j] = Z3_mk_const(ctx, Z3_mk_int_symbol(ctx, 3 * i + j), Z3_mk_bool_sort(ctx));
+    for (unsigned i = 0; i < 4; ++i)
+        Z3_solver_assert(ctx, s, Z3_mk_or(ctx, 3, p[i]));
+    for (unsigned j = 0; j < 3; ++j)
+        for (unsigned i = 0; i < 4; ++i)
+            for (unsigned k = i + 1; k < 4; ++k) {
+                Z3_ast args[2] = { Z3_mk_not(ctx, p[i][j]), Z3_mk_not(ctx, p[k][j]) };
+                Z3_solver_assert(ctx, s, Z3_mk_or(ctx, 2, args));
+            }
+}
+
+static void test_export_import_lemmas() {
+    Z3_config cfg = Z3_mk_config();
+    Z3_context ctx = Z3_mk_context(cfg);
+    Z3_del_config(cfg);
+    Z3_params p = Z3_mk_params(ctx);
+    Z3_params_inc_ref(ctx, p);
+    Z3_params_set_bool(ctx, p, Z3_mk_string_symbol(ctx, "sat.elim_vars"), false);
+    Z3_solver s1 = Z3_mk_solver_for_logic(ctx, Z3_mk_string_symbol(ctx, "QF_FD"));
+    Z3_solver_inc_ref(ctx, s1);
+    Z3_solver_set_params(ctx, s1, p);
+    assert_pigeon_hole(ctx, s1);
+    ENSURE(Z3_solver_check(ctx, s1) == Z3_L_FALSE);
+    Z3_ast_vector lemmas = Z3_mk_ast_vector(ctx);
+    Z3_ast_vector_inc_ref(ctx, lemmas);
+    unsigned glue[100];
+    unsigned n = Z3_solver_export_lemmas(ctx, s1, lemmas, 100, glue);
+    ENSURE(n == Z3_ast_vector_size(ctx, lemmas));
+    for (unsigned i = 1; i < n; ++i)
+        ENSURE(glue[i - 1] <= glue[i]);
+
+    Z3_solver s2 = Z3_mk_solver_for_logic(ctx, Z3_mk_string_symbol(ctx, "QF_FD"));
+    Z3_solver_inc_ref(ctx, s2);
+    assert_pigeon_hole(ctx, s2);
+    Z3_solver_import_lemmas(ctx, s2, lemmas, n, glue);
+    ENSURE(Z3_solver_check(ctx, s2) == Z3_L_FALSE);
+    Z3_solver_import_lemmas(ctx, s2, lemmas, n, glue);
+    ENSURE(Z3_solver_check(ctx, s2) == Z3_L_FALSE);
+
+    Z3_solver_dec_ref(ctx, s2);
+    Z3_ast_vector_dec_ref(ctx, lemmas);
+    Z3_solver_dec_ref(ctx, s1);
+    Z3_params_dec_ref(ctx, p);
+    Z3_del_context(ctx);
+}
+
+// nnf names a formula once and reuses the name under the opposite polarity
+static void test_nnf_polarity() {
+    Z3_config cfg = Z3_mk_config();
+    Z3_context ctx = Z3_mk_context(cfg);
+    Z3_del_config(cfg);
+    char const* decls =
+        "(declare-fun p (Int) Bool)\n"
+        "(declare-fun q (Int) Bool)\n"
+        "(declare-fun h (Bool) Bool)\n";
+    Z3_eval_smtlib2_string(ctx, decls);
+    std::string r = Z3_eval_smtlib2_string(ctx,
+        "(push)\n"
+        "(assert (and (h (forall ((x Int)) (p x))) (not (h (forall ((x Int)) (p x))))))\n"
+        "(check-sat-using (then nnf smt))\n"
+        "(pop)\n");
+    ENSURE(r.find("unsat") != std::string::npos);
+    r = Z3_eval_smtlib2_string(ctx,
+        "(assert (forall ((y Int)) (or (and (q y) (h (forall ((x Int)) (p x)))) (and (not (q y)) (not (h (forall ((x Int)) (p x))))))))\n"
+        "(assert (q 1))\n"
+        "(assert (not (q 2)))\n"
+        "(check-sat)\n");
+    ENSURE(r.find("unsat") != std::string::npos);
+    Z3_del_context(ctx);
+}
+
+static Z3_context g_batch_ctx = nullptr;
+
+struct batch_stats {
+    unsigned m_calls = 0;
+    unsigned m_fixed = 0;
+    unsigned m_eqs = 0;
+    bool     m_all_true = true;
+};
+
+static void batch_push(void*, Z3_solver_callback) {}
+static void batch_pop(void*, Z3_solver_callback, unsigned) {}
+static void* batch_fresh(void* ctx, Z3_context) { return ctx; }
+
+static void batch_eh(void* ctx, Z3_solver_callback, unsigned num_fixed, Z3_ast const*, Z3_ast const* values,
+                     unsigned num_eqs, Z3_ast const*, Z3_ast const*) {
+    batch_stats& st = *static_cast<batch_stats*>(ctx);
+    ++st.m_calls;
+    st.m_fixed += num_fixed;
+    st.m_eqs += num_eqs;
+    for (unsigned i = 0; i < num_fixed; ++i)
+        st.m_all_true &= Z3_get_bool_value(g_batch_ctx, values[i]) == Z3_L_TRUE;
+}
+
+static void test_propagate_batch() {
+    Z3_config cfg = Z3_mk_config();
+    Z3_context ctx = Z3_mk_context(cfg);
+    Z3_del_config(cfg);
+    g_batch_ctx = ctx;
+    Z3_solver s = Z3_mk_simple_solver(ctx);
+    Z3_solver_inc_ref(ctx, s);
+    batch_stats st;
+    Z3_solver_propagate_init(ctx, s, &st, batch_push, batch_pop, batch_fresh);
+    Z3_solver_propagate_batch(ctx, s, batch_eh);
+    Z3_sort S = Z3_mk_uninterpreted_sort(ctx, Z3_mk_string_symbol(ctx, "S"));
+    Z3_ast a = Z3_mk_const(ctx, Z3_mk_string_symbol(ctx, "a"), Z3_mk_bool_sort(ctx));
+    Z3_ast b = Z3_mk_const(ctx, Z3_mk_string_symbol(ctx, "b"), Z3_mk_bool_sort(ctx));
+    Z3_ast x = Z3_mk_const(ctx, Z3_mk_string_symbol(ctx, "x"), S);
+    Z3_ast y = Z3_mk_const(ctx, Z3_mk_string_symbol(ctx, "y"), S);
+    Z3_solver_propagate_register(ctx, s, a);
+    Z3_solver_propagate_register(ctx, s, b);
+    Z3_solver_propagate_register(ctx, s, x);
+    Z3_solver_propagate_register(ctx, s, y);
+    Z3_solver_assert(ctx, s, a);
+    Z3_solver_assert(ctx, s, b);
+    Z3_solver_assert(ctx, s, Z3_mk_eq(ctx, x, y));
+    ENSURE(Z3_solver_check(ctx, s) == Z3_L_TRUE);
+    ENSURE(st.m_fixed == 2);
+    ENSURE(st.m_eqs >= 1);
+    ENSURE(st.m_all_true);
+    ENSURE(0 < st.m_calls && st.m_calls < st.m_fixed + st.m_eqs);
+    Z3_solver_dec_ref(ctx, s);
+    Z3_del_context(ctx);
+}
+
+static void test_combined_race() {
+    Z3_global_param_set("combined_solver.race", "true");
+    Z3_config cfg = Z3_mk_config();
+    Z3_set_param_value(cfg, "proof", "true");
+    Z3_context ctx = Z3_mk_context(cfg);
+    Z3_del_config(cfg);
+    Z3_solver s = Z3_mk_solver(ctx);
+    Z3_solver_inc_ref(ctx, s);
+    Z3_sort int_sort = Z3_mk_int_sort(ctx);
+    Z3_ast x = Z3_mk_const(ctx, Z3_mk_string_symbol(ctx, "x"), int_sort);
+    Z3_ast one = Z3_mk_int(ctx, 1, int_sort);
+    // push switches to incremental mode, where the solvers race
+    Z3_solver_push(ctx, s);
+    Z3_solver_assert(ctx, s, Z3_mk_gt(ctx, x, one));
+    ENSURE(Z3_solver_check(ctx, s) == Z3_L_TRUE);
+    Z3_model mdl = Z3_solver_get_model(ctx, s);
+    ENSURE(mdl);
+    Z3_model_inc_ref(ctx, mdl);
+    Z3_ast v = nullptr;
+    ENSURE(Z3_model_eval(ctx, mdl, Z3_mk_gt(ctx, x, one), true, &v));
+    ENSURE(Z3_get_bool_value(ctx, v) == Z3_L_TRUE);
+    Z3_model_dec_ref(ctx, mdl);
+    Z3_solver_assert(ctx, s, Z3_mk_lt(ctx, x, one));
+    ENSURE(Z3_solver_check(ctx, s) == Z3_L_FALSE);
+    ENSURE(Z3_solver_get_proof(ctx, s));
+    Z3_solver_get_reason_unknown(ctx, s);
+    ENSURE(Z3_get_error_code(ctx) == Z3_OK);
+    Z3_solver_dec_ref(ctx, s);
+    Z3_del_context(ctx);
+    Z3_global_param_set("combined_solver.race", "false");
+}
+
 void tst_api() {
     test_apps();
     test_bvneg();
     test_mk_distinct();
+    test_check_async();
+    test_context_reset();
+    test_mk_ast_dag();
+    test_model_eval_values();
+    test_export_import_lemmas();
+    test_nnf_polarity();
+    test_propagate_batch();
+    test_combined_race();
 }
@@ -8,6 +8,7 @@ Copyright (c) 2015 Microsoft Corporation
 #include "ast/ast_pp.h"
 #include "ast/reg_decl_plugins.h"
 #include "ast/rewriter/th_rewriter.h"
+#include "ast/rewriter/th_rewriter_cache.h"
 #include "model/model.h"
 #include "parsers/smt2/smt2parser.h"
 #include <iostream>
@@ -34,6 +35,40 @@ static char const* example1 = "(<= (+ (* 1.3 x y) (* 2.3 y y) (* (- 1.1 x x))) 2
 static char const* example2 = "(= (+ 4 3 (- (* 3 x x) (* 5 y)) y) 0)";
 
 
+static void tst_shared_cache() {
+    ast_manager m;
+    reg_decl_plugins(m);
+    th_rewriter_cache cache(m);
+    expr_ref fml1 = parse_fml(m, example1), fml2(fml1);
+    th_rewriter rw1(m), rw2(m);
+    rw1.set_cache(&cache);
+    rw2.set_cache(&cache);
+    rw1(fml1);
+    ENSURE(cache.size() == 1);
+    rw2(fml2);
+    ENSURE(fml1 == fml2);
+    ENSURE(cache.size() == 1);
+    statistics st;
+    cache.collect_statistics(st);
+    st.display(std::cout);
+    // the first rewriter misses on its lookups, the second hits the stored result.
+    for (unsigned i = 0; i < st.size(); ++i) {
+        if (std::string("rewriter cache hits") == st.get_key(i))
+            ENSURE(st.get_uint_value(i) > 0);
+        if (std::string("rewriter cache misses") == st.get_key(i))
+            ENSURE(st.get_uint_value(i) > 0);
+    }
+
+    // rewriters with different parameters do not share results.
+    params_ref p;
+    p.set_bool("som", true);
+    th_rewriter rw3(m, p);
+    rw3.set_cache(&cache);
+    expr_ref fml3 = parse_fml(m, example1);
+    rw3(fml3);
+    ENSURE(cache.size() == 2);
+}
+
 void tst_arith_rewriter() {
     ast_manager m;
     reg_decl_plugins(m);
@@ -56,4 +91,6 @@ void tst_arith_rewriter() {
     fml = parse_fml(m, example2);
     rw(fml);
     std::cout << mk_pp(fml, m) << "\n";
+
+    tst_shared_cache();
 }
@@ -0,0 +1,116 @@
+/*++
+Copyright (c) 2024 Microsoft Corporation
+
+Module Name:
+
+    ast_serialize.cpp
+
+Abstract:
+
+    Test binary serialization of expressions.
+
+--*/
+#include <sstream>
+#include "ast/ast_serialize.h"
+#include "ast/ast_translation.h"
+#include "ast/reg_decl_plugins.h"
+#include "ast/arith_decl_plugin.h"
+#include "ast/bv_decl_plugin.h"
+#include "ast/array_decl_plugin.h"
+#include "ast/seq_decl_plugin.h"
+
+static void tst_roundtrip() {
+    ast_manager m;
+    reg_decl_plugins(m);
+    arith_util a(m);
+    bv_util bv(m);
+    array_util ar(m);
+    seq_util su(m);
+
+    sort_ref U(m.mk_uninterpreted_sort(symbol("U")), m);
+    sort_ref I(a.mk_int(), m);
+    sort_ref B(bv.mk_sort(32), m);
+    sort* dom[1] = { I.get() };
+    sort_ref A(ar.mk_array_sort(1, dom, B), m);
+    func_decl_ref f(m.mk_func_decl(symbol("f"), U, I), m);
+    expr_ref u(m.mk_const(symbol("u"), U), m);
+    expr_ref x(m.mk_const(symbol("x"), I), m);
+    expr_ref y(m.mk_const(symbol(3), B), m);
+    expr_ref arr(m.mk_const(symbol("arr"), A), m);
+    expr_ref s(m.mk_const(symbol("s"), su.str.mk_string_sort()), m);
+
+    expr_ref_vector fmls(m);
+    fmls.push_back(a.mk_le(m.mk_app(f, u.get()), a.mk_add(x, a.mk_numeral(rational(-7, 3), false))));
+    fmls.push_back(m.mk_eq(ar.mk_select(arr, x), bv.mk_bv_add(y, bv.mk_numeral(rational(123456789), 32))));
+    fmls.push_back(m.mk_eq(s, su.str.mk_string(zstring("hello"))));
+    fmls.push_back(m.mk_eq(bv.mk_extract(7, 0, y), bv.mk_numeral(rational(3), 8)));
+    sort* vs[1] = { I.get() };
+    symbol ns[1] = { symbol("v") };
+    expr_ref body(a.mk_ge(m.mk_var(0, I), x), m);
+    fmls.push_back(m.mk_quantifier(forall_k, 1, vs, ns, body, 2, symbol("q"), symbol::null));
+    fmls.push_back(m.mk_lambda(1, vs, ns, ar.mk_select(arr, m.mk_var(0, I))));
+    fmls.push_back(fmls.get(0));
+
+    std::stringstream strm;
+    serialize(strm, fmls);
+
+    // deserializing into the same manager yields the same nodes.
+    expr_ref_vector same(m);
+    deserialize(strm, same);
+    ENSURE(same.size() == fmls.size());
+    for (unsigned i = 0; i < fmls.size(); ++i)
+        ENSURE(same.get(i) == fmls.get(i));
+
+    // deserializing into a fresh manager agrees with translation.
+    ast_manager m2;
+    reg_decl_plugins(m2);
+    std::stringstream strm2(strm.str());
+    expr_ref_vector other(m2);
+    deserialize(strm2, other);
+    ast_translation tr(m, m2);
+    ENSURE(other.size() == fmls.size());
+    for (unsigned i = 0; i < fmls.size(); ++i)
+        ENSURE(other.get(i) == tr(fmls.get(i)));
+}
+
+static void tst_malformed() {
+    ast_manager m;
+    reg_decl_plugins(m);
+    expr_ref_vector fmls(m);
+    fmls.push_back(m.mk_const(symbol("p"), m.mk_bool_sort()));
+    std::stringstream strm;
+    serialize(strm, fmls);
+    std::string data = strm.str();
+    for (unsigned len = 0; len + 1 < data.size(); ++len) {
+        std::stringstream truncated(data.substr(0, len));
+        expr_ref_vector result(m);
+        bool failed = false;
+        try {
+            deserialize(truncated, result);
+        }
+        catch (default_exception&) {
+            failed = true;
+        }
+        ENSURE(failed);
+    }
+
+    // a string length far beyond the end of the input is rejected.
+    size_t pos = data.find(std::string("\x01p", 2));
+    ENSURE(pos != std::string::npos);
+    std::string corrupt = data.substr(0, pos) + "\xff\xff\xff\xff\x0f" + data.substr(pos + 1);
+    std::stringstream strm2(corrupt);
+    expr_ref_vector result(m);
+    bool failed = false;
+    try {
+        deserialize(strm2, result);
+    }
+    catch (default_exception&) {
+        failed = true;
+    }
+    ENSURE(failed);
+}
+
+void tst_ast_serialize() {
+    tst_roundtrip();
+    tst_malformed();
+}
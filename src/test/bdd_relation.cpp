@@ -0,0 +1,148 @@
+/*++
+Copyright (c) 2024 Microsoft Corporation
+
+Module Name:
+
+    bdd_relation.cpp
+
+Abstract:
+
+    Test the BDD relation plugin against the hashtable backed table relations.
+
+--*/
+
+#include "ast/reg_decl_plugins.h"
+#include "ast/bv_decl_plugin.h"
+#include "smt/params/smt_params.h"
+#include "muz/fp/dl_register_engine.h"
+#include "muz/rel/rel_context.h"
+#include "muz/rel/dl_relation_manager.h"
+#include "muz/rel/dl_table_relation.h"
+#include "muz/rel/bdd_relation.h"
+#include <iostream>
+
+class bdd_relation_tester {
+    typedef datalog::relation_base relation_base;
+    typedef datalog::relation_signature relation_signature;
+    typedef datalog::relation_fact relation_fact;
+    typedef datalog::scoped_rel<relation_base> rel;
+
+    struct init {
+        init(ast_manager& m) { reg_decl_plugins(m); }
+    };
+    ast_manager               m;
+    init                      m_init;
+    bv_util                   bv;
+    smt_params                m_smt_params;
+    datalog::register_engine  m_reg;
+    datalog::context          m_ctx;
+    datalog::rel_context      rc;
+    random_gen                m_rand;
+    static const unsigned     width = 2;
+
+    datalog::relation_manager& rm() { return rc.get_rmanager(); }
+
+    datalog::relation_plugin& bdd() { return *rm().get_relation_plugin(symbol("bdd")); }
+
+    datalog::relation_plugin& tbl() { return rm().get_table_relation_plugin(*rm().get_table_plugin(symbol("hashtable"))); }
+
+    relation_signature mk_sig(unsigned n) {
+        relation_signature sig;
+        for (unsigned i = 0; i < n; ++i)
+            sig.push_back(bv.mk_sort(width));
+        return sig;
+    }
+
+    relation_fact mk_fact(unsigned n, unsigned code) {
+        relation_fact f(m);
+        for (unsigned i = 0; i < n; ++i, code >>= width)
+            f.push_back(bv.mk_numeral(rational(code & ((1 << width) - 1)), width));
+        return f;
+    }
+
+    // add the same random facts to a BDD relation and a table relation.
+    void mk_random(unsigned n, unsigned num_facts, rel& b, rel& t) {
+        relation_signature sig = mk_sig(n);
+        b = bdd().mk_empty(sig);
+        t = tbl().mk_empty(sig);
+        for (unsigned i = 0; i < num_facts; ++i) {
+            relation_fact f = mk_fact(n, m_rand(1 << (width * n)));
+            b->add_fact(f);
+            t->add_fact(f);
+        }
+    }
+
+    void check_same(relation_base const& b, relation_base const& t) {
+        unsigned n = b.get_signature().size();
+        ENSURE(n == t.get_signature().size());
+        ENSURE(&b.get_plugin() == &bdd());
+        for (unsigned code = 0; code < (1u << (width * n)); ++code) {
+            relation_fact f = mk_fact(n, code);
+            ENSURE(b.contains_fact(f) == t.contains_fact(f));
+        }
+    }
+
+public:
+    bdd_relation_tester():
+        m_init(m), bv(m), m_ctx(m, m_reg, m_smt_params), rc(m_ctx) {}
+
+    void test_join() {
+        rel b1, t1, b2, t2;
+        mk_random(2, 6, b1, t1);
+        mk_random(2, 6, b2, t2);
+        unsigned cols1[1] = { 1 }, cols2[1] = { 0 };
+        scoped_ptr<datalog::relation_join_fn> jb = rm().mk_join_fn(*b1, *b2, 1, cols1, cols2);
+        scoped_ptr<datalog::relation_join_fn> jt = rm().mk_join_fn(*t1, *t2, 1, cols1, cols2);
+        ENSURE(jb && jt);
+        rel rb = (*jb)(*b1, *b2), rt = (*jt)(*t1, *t2);
+        check_same(*rb, *rt);
+    }
+
+    void test_project() {
+        rel b, t;
+        mk_random(3, 12, b, t);
+        unsigned removed[1] = { 1 };
+        scoped_ptr<datalog::relation_transformer_fn> pb = rm().mk_project_fn(*b, 1, removed);
+        scoped_ptr<datalog::relation_transformer_fn> pt = rm().mk_project_fn(*t, 1, removed);
+        ENSURE(pb && pt);
+        rel rb = (*pb)(*b), rt = (*pt)(*t);
+        check_same(*rb, *rt);
+    }
+
+    void test_rename() {
+        rel b, t;
+        mk_random(3, 12, b, t);
+        unsigned cycle[3] = { 0, 1, 2 };
+        scoped_ptr<datalog::relation_transformer_fn> rnb = rm().mk_rename_fn(*b, 3, cycle);
+        scoped_ptr<datalog::relation_transformer_fn> rnt = rm().mk_rename_fn(*t, 3, cycle);
+        ENSURE(rnb && rnt);
+        rel rb = (*rnb)(*b), rt = (*rnt)(*t);
+        check_same(*rb, *rt);
+    }
+
+    void test_union() {
+        rel b1, t1, b2, t2;
+        mk_random(3, 8, b1, t1);
+        mk_random(3, 8, b2, t2);
+        scoped_ptr<datalog::relation_union_fn> ub = rm().mk_union_fn(*b1, *b2);
+        scoped_ptr<datalog::relation_union_fn> ut = rm().mk_union_fn(*t1, *t2);
+        ENSURE(ub && ut);
+        (*ub)(*b1, *b2);
+        (*ut)(*t1, *t2);
+        check_same(*b1, *t1);
+    }
+
+    void test() {
+        for (unsigned i = 0; i < 20; ++i) {
+            test_join();
+            test_project();
+            test_rename();
+            test_union();
+        }
+    }
+};
+
+void tst_bdd_relation() {
+    bdd_relation_tester tester;
+    tester.test();
+}
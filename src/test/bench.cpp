@@ -0,0 +1,157 @@
+/*++
+Copyright (c) 2024 Microsoft Corporation
+
+Module Name:
+
+    bench.cpp
+
+Abstract:
+
+    Benchmark runner for performance regressions.
+
+    test-z3 bench [param=value ...] file1.smt2 file2.cnf ... [baseline.json]
+
+    Each SMT2 file is run in a fresh command context and each DIMACS file
+    (.cnf, .dimacs) on a fresh SAT solver. One JSON record is printed per file
+    with the result, time, peak memory of the process and solver statistics. Seeds and other
+    parameters are set on the command line.
+    If a .json file with the output of a previous run is given, the times are
+    compared against it and files that became slower are reported.
+
+--*/
+#include "cmd_context/cmd_context.h"
+#include "parsers/smt2/smt2parser.h"
+#include "solver/solver.h"
+#include "sat/sat_solver.h"
+#include "sat/dimacs.h"
+#include "util/stopwatch.h"
+#include "util/statistics.h"
+#include "util/file_path.h"
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <map>
+
+namespace {
+
+    struct bench_result {
+        std::string m_file;
+        std::string m_status;
+        double      m_time = 0;
+        double      m_memory = 0;
+        statistics  m_stats;
+    };
+
+    bool is_dimacs(char const* file) {
+        char const* ext = get_extension(file);
+        return ext && (strcmp(ext, "cnf") == 0 || strcmp(ext, "dimacs") == 0);
+    }
+
+    void run_dimacs(char const* file, bench_result& r) {
+        std::ifstream in(file);
+        reslimit limit;
+        params_ref p;
+        sat::solver solver(p, limit);
+        if (!parse_dimacs(in, std::cerr, solver)) {
+            r.m_status = "error";
+            return;
+        }
+        std::ostringstream out;
+        out << solver.check();
+        r.m_status = out.str();
+        solver.collect_statistics(r.m_stats);
+    }
+
+    void run_smt2(char const* file, bench_result& r) {
+        std::ifstream in(file);
+        std::ostringstream out;
+        cmd_context ctx;
+        ctx.set_solver_factory(mk_smt_strategic_solver_factory());
+        ctx.set_regular_stream(out);
+        if (!parse_smt2_commands(ctx, in)) {
+            r.m_status = "error";
+            return;
+        }
+        // the last line of the output is the result of the last check-sat
+        std::string s = out.str();
+        while (!s.empty() && s.back() == '\n')
+            s.pop_back();
+        r.m_status = s.substr(s.find_last_of('\n') + 1);
+        if (ctx.get_solver())
+            ctx.get_solver()->collect_statistics(r.m_stats);
+    }
+
+    void display_json(std::ostream& out, bench_result const& r) {
+        out << "{\"file\": \"" << r.m_file << "\", \"status\": \"" << r.m_status
+            << "\", \"time\": " << r.m_time << ", \"memory\": " << r.m_memory << ", \"stats\": {";
+        for (unsigned i = 0; i < r.m_stats.size(); ++i) {
+            if (i > 0)
+                out << ", ";
+            out << "\"" << r.m_stats.get_key(i) << "\": ";
+            if (r.m_stats.is_uint(i))
+                out << r.m_stats.get_uint_value(i);
+            else
+                out << r.m_stats.get_double_value(i);
+        }
+        out << "}}\n";
+    }
+
+    // read the file and time fields of the records of a previous run.
+    void read_baseline(char const* file, std::map<std::string, double>& times) {
+        std::ifstream in(file);
+        std::string line;
+        auto field = [&](char const* name) {
+            std::string key = std::string("\"") + name + "\": ";
+            size_t pos = line.find(key);
+            if (pos == std::string::npos)
+                return std::string();
+            pos += key.size();
+            if (line[pos] == '"')
+                return line.substr(pos + 1, line.find('"', pos + 1) - pos - 1);
+            return line.substr(pos, line.find_first_of(",}", pos) - pos);
+        };
+        while (std::getline(in, line)) {
+            std::string f = field("file"), t = field("time");
+            if (!f.empty() && !t.empty())
+                times[f] = std::stod(t);
+        }
+    }
+}
+
+void tst_bench(char** argv, int argc, int& i) {
+    std::map<std::string, double> baseline;
+    vector<char const*> files;
+    for (++i; i < argc; ++i) {
+        char const* arg = argv[i];
+        if (arg[0] == '-' || arg[0] == '/' || strchr(arg, '='))
+            continue;
+        char const* ext = get_extension(arg);
+        if (ext && strcmp(ext, "json") == 0)
+            read_baseline(arg, baseline);
+        else
+            files.push_back(arg);
+    }
+    unsigned num_slower = 0;
+    for (char const* file : files) {
+        bench_result r;
+        r.m_file = file;
+        stopwatch sw;
+        sw.start();
+        if (is_dimacs(file))
+            run_dimacs(file, r);
+        else
+            run_smt2(file, r);
+        sw.stop();
+        r.m_time = sw.get_seconds();
+        r.m_memory = static_cast<double>(memory::get_max_used_memory()) / (1024 * 1024);
+        display_json(std::cout, r);
+        auto it = baseline.find(r.m_file);
+        // ignore noise on short runs
+        if (it != baseline.end() && r.m_time > 1.2 * it->second + 0.1) {
+            std::cout << "slower: " << r.m_file << " " << it->second << "s -> " << r.m_time << "s\n";
+            ++num_slower;
+        }
+    }
+    if (!baseline.empty())
+        std::cout << "files slower than baseline: " << num_slower << " of " << files.size() << "\n";
+}
@@ -21,6 +21,7 @@ Revision History:
 #include "ast/ast_ll_pp.h"
 #include "ast/reg_decl_plugins.h"
 #include "ast/rewriter/bit_blaster/bit_blaster.h"
+#include "ast/rewriter/bit_blaster/bit_blaster_rewriter.h"
 #include "model/model.h"
 #include "model/model_evaluator.h"
 
@@ -184,6 +185,41 @@ void tst_multiplier(ast_manager & m, bit_blaster & blaster) {
     ENSURE_INT(mdl, c, 7); // b111 * b001
 }
 
+static void tst_rewriter(ast_manager & m, unsigned sz) {
+    bv_util bv(m);
+    bit_blaster_rewriter rw(m, params_ref());
+    expr_ref x(m.mk_const("x", bv.mk_sort(sz)), m);
+    expr_ref y(m.mk_const("y", bv.mk_sort(sz)), m);
+    expr_ref mul(bv.mk_bv_mul(x, y), m), add(bv.mk_bv_add(x, y), m);
+    expr_ref mul_bits(m), add_bits(m);
+    proof_ref pr(m);
+    rw.start_rewrite();
+    rw(mul, mul_bits, pr);
+    rw(add, add_bits, pr);
+    obj_map<func_decl, expr*> const2bits;
+    ptr_vector<func_decl> newbits;
+    rw.end_rewrite(const2bits, newbits);
+    app* xb = to_app(const2bits[to_app(x)->get_decl()]);
+    app* yb = to_app(const2bits[to_app(y)->get_decl()]);
+    unsigned mask = (1u << sz) - 1;
+    for (unsigned a = 0; a <= mask; ++a) {
+        for (unsigned b = 0; b <= mask; ++b) {
+            model mdl(m);
+            for (unsigned i = 0; i < sz; ++i) {
+                mdl.register_decl(to_app(xb->get_arg(i))->get_decl(), (a & (1u << i)) ? m.mk_true() : m.mk_false());
+                mdl.register_decl(to_app(yb->get_arg(i))->get_decl(), (b & (1u << i)) ? m.mk_true() : m.mk_false());
+            }
+            model_evaluator eval(mdl);
+            expr_ref v(m);
+            rational r;
+            eval(mul_bits, v);
+            ENSURE(bv.is_numeral(v, r) && r == rational((a * b) & mask));
+            eval(add_bits, v);
+            ENSURE(bv.is_numeral(v, r) && r == rational((a + b) & mask));
+        }
+    }
+}
+
 void tst_le(ast_manager & m, unsigned sz) {
 //     expr_ref_vector a(m);
 //     expr_ref_vector b(m);
@@ -235,6 +271,7 @@ void tst_bit_blaster() {
 
     tst_adder(m, blaster);
     tst_multiplier(m, blaster);
+    tst_rewriter(m, 4);
     tst_le(m, 4);
     tst_eqs(m, 8);
     tst_sh(m, 4);
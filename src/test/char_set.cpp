@@ -0,0 +1,46 @@
+/*++
+Copyright (c) 2024 Microsoft Corporation
+
+Module Name:
+
+    char_set.cpp
+
+Abstract:
+
+    Test interval lists of characters.
+
+--*/
+#include "util/char_set.h"
+#include "util/debug.h"
+#include <iostream>
+
+static bool contains_all(char_set const& s, unsigned lo, unsigned hi) {
+    for (unsigned c = lo; c <= hi; ++c)
+        if (!s.contains(c))
+            return false;
+    return true;
+}
+
+void tst_char_set() {
+    char_set a(10, 20), b(15, 30), c(40, 50), d(21, 25);
+    ENSURE((a | b) == char_set(10, 30));
+    ENSURE((a & b) == char_set(15, 20));
+    ENSURE((a & c).empty());
+    // adjacent intervals are merged
+    ENSURE((a | d) == char_set(10, 25));
+    char_set ac = a | c;
+    ENSURE(ac.num_ranges() == 2);
+    ENSURE(ac.contains(10) && ac.contains(45) && !ac.contains(30) && !ac.contains(51));
+    ENSURE((ac & b) == (char_set(15, 30) & ac));
+    ENSURE(((ac & b) | d) == char_set(15, 25));
+
+    char_set n = ac.complement(100);
+    ENSURE(n.num_ranges() == 3);
+    ENSURE(contains_all(n, 0, 9) && contains_all(n, 21, 39) && contains_all(n, 51, 100));
+    ENSURE((n | ac) == char_set(0, 100));
+    ENSURE((n & ac).empty());
+    ENSURE(n.complement(100) == ac);
+    ENSURE(char_set().complement(7) == char_set(0, 7));
+    ENSURE(char_set(0, 7).complement(7).empty());
+    std::cout << ac << " " << n << "\n";
+}
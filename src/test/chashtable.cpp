@@ -172,6 +172,20 @@ static void tst6() {
     });
 }
 
+static void tst7() {
+    int_table t;
+    t.insert(3);
+    t.insert(5);
+    t.reserve(4096);
+    unsigned cap = t.capacity();
+    for (int i = 0; i < 1000; i++)
+        t.insert(i);
+    ENSURE(t.capacity() == cap);
+    ENSURE(t.size() == 1000);
+    for (int i = 0; i < 1000; i++)
+        ENSURE(t.contains(i));
+}
+
 void tst_chashtable() {
     tst1();
     tst2();
@@ -181,4 +195,5 @@ void tst_chashtable() {
     tst4<dint_table>(10000,10);
     tst4<int_table>(50000,1000);
     tst5();
+    tst7();
 }
@@ -0,0 +1,70 @@
+/*++
+Copyright (c) 2024 Microsoft Corporation
+
+Module Name:
+
+    component_simplifier.cpp
+
+Abstract:
+
+    Test parallel simplification of independent components.
+
+--*/
+#include "ast/reg_decl_plugins.h"
+#include "ast/arith_decl_plugin.h"
+#include "ast/simplifiers/component_simplifier.h"
+#include "ast/simplifiers/solve_eqs.h"
+#include "model/model.h"
+
+namespace {
+    class test_state : public dependent_expr_state {
+        ast_manager&               m;
+        vector<dependent_expr>     m_fmls;
+        model_reconstruction_trail m_model_trail;
+    public:
+        test_state(ast_manager& m) : dependent_expr_state(m), m(m), m_model_trail(m, m_trail) {}
+        unsigned qtail() const override { return m_fmls.size(); }
+        dependent_expr const& operator[](unsigned i) override { return m_fmls[i]; }
+        void update(unsigned i, dependent_expr const& j) override { m_fmls[i] = j; }
+        void add(dependent_expr const& j) override { m_fmls.push_back(j); }
+        bool inconsistent() override { return false; }
+        model_reconstruction_trail& model_trail() override { return m_model_trail; }
+        bool updated() override { return false; }
+        void reset_updated() override {}
+    };
+}
+
+void tst_component_simplifier() {
+    ast_manager m;
+    reg_decl_plugins(m);
+    arith_util a(m);
+    test_state st(m);
+    expr_ref_vector xs(m);
+    unsigned n = 8;
+    for (unsigned i = 0; i < 2 * n; ++i)
+        xs.push_back(m.mk_const(symbol(i), a.mk_int()));
+    // n independent components: x_2i = x_2i+1 + 1, x_2i+1 = i
+    for (unsigned i = 0; i < n; ++i) {
+        expr* x = xs.get(2 * i), *y = xs.get(2 * i + 1);
+        st.add(dependent_expr(m, m.mk_eq(x, a.mk_add(y, a.mk_int(1))), nullptr, nullptr));
+        st.add(dependent_expr(m, m.mk_eq(y, a.mk_int(i)), nullptr, nullptr));
+    }
+    params_ref p;
+    p.set_uint("threads", 4);
+    simplifier_factory f = [](ast_manager& m, params_ref const& p, dependent_expr_state& s) -> dependent_expr_simplifier* {
+        return alloc(euf::solve_eqs, m, s);
+    };
+    component_simplifier s(m, p, st, f);
+    s.reduce();
+    for (unsigned i = 0; i < st.qtail(); ++i)
+        ENSURE(m.is_true(st[i].fml()));
+    model_ref mdl = alloc(model, m);
+    (*st.model_trail().get_model_converter())(mdl);
+    for (unsigned i = 0; i < n; ++i) {
+        ENSURE(mdl->is_true(m.mk_eq(xs.get(2 * i), a.mk_int(i + 1))));
+        ENSURE(mdl->is_true(m.mk_eq(xs.get(2 * i + 1), a.mk_int(i))));
+    }
+    statistics stats;
+    s.collect_statistics(stats);
+    stats.display(std::cout);
+}
@@ -203,7 +203,57 @@ void dl_query_test_wpa(smt_params & fparams, params_ref& params) {
 
 }
 
+static void dl_query_incremental_test(bool incremental) {
+    ast_manager m;
+    reg_decl_plugins(m);
+    smt_params fparams;
+    params_ref params;
+    params.set_bool("datalog.incremental", incremental);
+    register_engine re;
+    context ctx(m, re, fparams);
+    ctx.updt_params(params);
+    dl_decl_util decl_util(m);
+
+    parser* p = parser::create(ctx, m);
+    VERIFY(p->parse_string(
+        "Z 16\n\n"
+        "e(x:Z, y:Z)\n"
+        "t(x:Z, y:Z)\n"
+        "t(X,Y) :- e(X,Y).\n"
+        "t(X,Z) :- e(X,Y), t(Y,Z).\n"));
+    dealloc(p);
+    func_decl* e = ctx.try_get_predicate_decl(symbol("e"));
+    func_decl* t = ctx.try_get_predicate_decl(symbol("t"));
+    ENSURE(e && t);
+    sort* s = e->get_domain(0);
+
+    auto mk_fact = [&](unsigned a, unsigned b) {
+        relation_fact f(m);
+        f.push_back(decl_util.mk_numeral(a, s));
+        f.push_back(decl_util.mk_numeral(b, s));
+        return f;
+    };
+    // a chain 0 -> 1 -> ... -> 5, extended one edge at a time
+    ctx.add_fact(e, mk_fact(0, 1));
+    for (unsigned i = 1; i < 6; ++i) {
+        ENSURE(ctx.rel_query(1, &t) == l_true);
+        relation_base& rel = ctx.get_rel_context()->get_relation(t);
+        ENSURE(rel.contains_fact(mk_fact(0, i)));
+        ENSURE(!rel.contains_fact(mk_fact(0, i + 1)));
+        ENSURE(rel.get_size_estimate_rows() == i * (i + 1) / 2);
+        ctx.add_fact(e, mk_fact(i, i + 1));
+    }
+    // a fact that closes a cycle
+    ctx.add_fact(e, mk_fact(6, 0));
+    ENSURE(ctx.rel_query(1, &t) == l_true);
+    relation_base& rel = ctx.get_rel_context()->get_relation(t);
+    ENSURE(rel.get_size_estimate_rows() == 49);
+}
+
 void tst_dl_query() {
+    dl_query_incremental_test(false);
+    dl_query_incremental_test(true);
+
     smt_params fparams;
     params_ref params;
     params.set_sym("default_table", symbol("sparse"));
@@ -6,6 +6,7 @@ Copyright (c) 2015 Microsoft Corporation
 #include "muz/rel/dl_table.h"
 #include "muz/fp/dl_register_engine.h"
 #include "muz/rel/dl_relation_manager.h"
+#include "muz/rel/dl_leapfrog_join.h"
 #include <iostream>
 
 typedef datalog::table_base* (*mk_table_fn)(datalog::relation_manager& m, datalog::table_signature& sig);
@@ -96,6 +97,82 @@ void test_dl_bitvector_table() {
     test_table(mk_bv_table);
 }
 
+static void test_leapfrog_triangles() {
+    smt_params params;
+    ast_manager ast_m;
+    reg_decl_plugins(ast_m);
+    datalog::register_engine re;
+    datalog::context ctx(ast_m, re, params);
+    datalog::relation_manager & m = ctx.get_rel_context()->get_rmanager();
+
+    datalog::table_signature sig;
+    sig.push_back(16);
+    sig.push_back(16);
+    datalog::table_base* edges = m.mk_empty_table(sig);
+    datalog::table_fact fact;
+    bool adj[16][16] = {};
+    for (unsigned i = 0; i < 16; ++i) {
+        for (unsigned j = 0; j < 16; ++j) {
+            if ((i * 7 + j * 5) % 3 == 0 && i != j) {
+                adj[i][j] = true;
+                fact.reset();
+                fact.push_back(i);
+                fact.push_back(j);
+                edges->add_fact(fact);
+            }
+        }
+    }
+    unsigned expected = 0;
+    for (unsigned i = 0; i < 16; ++i)
+        for (unsigned j = 0; j < 16; ++j)
+            for (unsigned k = 0; k < 16; ++k)
+                if (adj[i][j] && adj[j][k] && adj[k][i])
+                    ++expected;
+
+    // triangles x -> y -> z -> x
+    datalog::leapfrog_join join(3);
+    unsigned_vector args;
+    datalog::table_fact constants(2, datalog::table_element(0));
+    args.push_back(0); args.push_back(1);
+    join.add_table(*edges, args, constants);
+    args[0] = 1; args[1] = 2;
+    join.add_table(*edges, args, constants);
+    args[0] = 2; args[1] = 0;
+    join.add_table(*edges, args, constants);
+    unsigned found = 0;
+    join([&](svector<datalog::table_element> const& v) {
+        ENSURE(adj[v[0]][v[1]] && adj[v[1]][v[2]] && adj[v[2]][v[0]]);
+        ++found;
+        return true;
+    });
+    ENSURE(found == expected);
+
+    // the triangles through node 3
+    datalog::leapfrog_join join3(2);
+    args[0] = UINT_MAX; args[1] = 0;
+    constants[0] = 3;
+    join3.add_table(*edges, args, constants);
+    args[0] = 0; args[1] = 1;
+    join3.add_table(*edges, args, constants);
+    args[0] = 1; args[1] = UINT_MAX;
+    constants[1] = 3;
+    join3.add_table(*edges, args, constants);
+    found = 0;
+    join3([&](svector<datalog::table_element> const& v) {
+        ENSURE(adj[3][v[0]] && adj[v[0]][v[1]] && adj[v[1]][3]);
+        ++found;
+        return true;
+    });
+    expected = 0;
+    for (unsigned j = 0; j < 16; ++j)
+        for (unsigned k = 0; k < 16; ++k)
+            if (adj[3][j] && adj[j][k] && adj[k][3])
+                ++expected;
+    ENSURE(found == expected);
+    edges->deallocate();
+}
+
 void tst_dl_table() {
     test_dl_bitvector_table();
+    test_leapfrog_triangles();
 }
@@ -152,10 +152,14 @@ int main(int argc, char ** argv) {
     TST(region);
     TST(symbol);
     TST(heap);
+    TST(var_queue);
     TST(hashtable);
+    TST(swiss_hashtable);
     TST(rational);
     TST(inf_rational);
     TST(ast);
+    TST(ast_serialize);
+    TST(act_cache);
     TST(optional);
     TST(bit_vector);
     TST(fixed_bit_vector);
@@ -170,6 +174,7 @@ int main(int argc, char ** argv) {
     TST(list);
     TST(small_object_allocator);
     TST(timeout);
+    TST(rlimit);
     TST(proof_checker);
     TST(simplifier);
     TST(bit_blaster);
@@ -190,13 +195,17 @@ int main(int argc, char ** argv) {
     TST(dl_context);
     TST(dlist);
     TST(dl_util);
+    TST(bdd_relation);
     TST(dl_product_relation);
     TST(dl_relation);
     TST(parray);
     TST(stack);
     TST(escaped);
     TST(buffer);
+    TST(char_set);
     TST(chashtable);
+    TST(component_simplifier);
+    TST(seq_length_abstraction);
     TST(egraph);
     TST(ex);
     TST(nlarith_util);
@@ -257,6 +266,8 @@ int main(int argc, char ** argv) {
     TST_ARGV(sat_lookahead);
     TST_ARGV(sat_local_search);
     TST_ARGV(cnf_backbones);
+    TST_ARGV(bench);
+    TST_ARGV(util_bench);
     TST(bdd);
     TST(pdd);
     TST(pdd_solver);
@@ -265,6 +276,7 @@ int main(int argc, char ** argv) {
     //TST_ARGV(hs);
     TST(finder);
     TST(totalizer);
+    TST(totalizer_merge);
     TST(distribution);
     TST(euf_bv_plugin);
     TST(euf_arith_plugin);
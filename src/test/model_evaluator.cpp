@@ -6,7 +6,48 @@
 #include "ast/ast_pp.h"
 #include <iostream>
 
+static void tst_func_interp_index() {
+    ast_manager m;
+    reg_decl_plugins(m);
+    arith_util a(m);
+    unsigned const n = 1000;
+    func_interp fi(m, 2);
+    expr_ref_vector vals(m);
+    for (unsigned i = 0; i < n; ++i)
+        vals.push_back(a.mk_int(i));
+    for (unsigned i = 0; i < n; ++i) {
+        expr* args[2] = { vals.get(i), vals.get((7 * i) % n) };
+        fi.insert_entry(args, vals.get((3 * i) % n));
+    }
+    // updating an entry keeps a single entry for the arguments
+    expr* args0[2] = { vals.get(0), vals.get(0) };
+    fi.insert_entry(args0, vals.get(1));
+    ENSURE(fi.num_entries() == n);
+    ENSURE(fi.get_entry(args0)->get_result() == vals.get(1));
+    for (unsigned i = 1; i < n; ++i) {
+        expr* args[2] = { vals.get(i), vals.get((7 * i) % n) };
+        func_entry* e = fi.get_entry(args);
+        ENSURE(e && e->get_result() == vals.get((3 * i) % n));
+        expr* other[2] = { vals.get(i), vals.get((7 * i + 1) % n) };
+        ENSURE(!fi.get_entry(other));
+    }
+    // entries stay reachable after deletions move other entries
+    for (unsigned i = 0; i < fi.num_entries(); i += 3) {
+        expr* args[2] = { fi.get_entry(i)->get_arg(0), fi.get_entry(i)->get_arg(1) };
+        expr_ref a0(args[0], m), a1(args[1], m);
+        fi.del_entry(i);
+        expr* dargs[2] = { a0, a1 };
+        ENSURE(!fi.get_entry(dargs));
+    }
+    for (unsigned i = 0; i < fi.num_entries(); ++i) {
+        func_entry const* e = fi.get_entry(i);
+        ENSURE(fi.get_entry(e->get_args()) == e);
+    }
+}
+
 void tst_model_evaluator() {
+    tst_func_interp_index();
+
     ast_manager m;
     reg_decl_plugins(m);
     arith_util a(m);
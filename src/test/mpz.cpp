@@ -306,6 +306,30 @@ void tst_int64_min_bug() {
     m.del(test);
 }
 
+static void tst_int64_overflow() {
+    synch_mpz_manager m;
+    scoped_synch_mpz a(m), b(m), c(m), r(m);
+    m.set(a, std::numeric_limits<int64_t>::max());
+    m.set(b, 1);
+    m.add(a, b, c);
+    m.set(r, "9223372036854775808");
+    ENSURE(m.eq(c, r));
+    m.sub(b, c, c);
+    m.set(r, "-9223372036854775807");
+    ENSURE(m.eq(c, r));
+    m.set(a, static_cast<int64_t>(3037000500));
+    m.mul(a, a, c);
+    m.set(r, "9223372037000250000");
+    ENSURE(m.eq(c, r));
+    m.set(a, static_cast<int64_t>(3037000499));
+    m.mul(a, a, c);
+    m.set(r, "9223372030926249001");
+    ENSURE(m.eq(c, r));
+    m.set(a, INT_MIN);
+    m.submul(b, a, a, c);
+    m.set(r, "-4611686018427387903");
+    ENSURE(m.eq(c, r));
+}
 
 void tst_scoped() {
     synch_mpz_manager m;
@@ -519,6 +543,7 @@ void tst_mpz() {
     tst_scoped();
     tst_int_min_bug();
     tst_int64_min_bug();
+    tst_int64_overflow();
     bug4();
     bug3();
     bug1();
@@ -0,0 +1,56 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    rlimit.cpp
+
+Abstract:
+
+    Test the memory accounting of resource limits.
+
+--*/
+#include "util/rlimit.h"
+#include "util/memory_manager.h"
+#include "util/debug.h"
+
+static void tst_memout() {
+    reslimit parent, child, late;
+    parent.push_child(&child);
+    {
+        scoped_memory_rlimit _ml(parent, 1024 * 1024, 0);
+        ENSURE(parent.not_canceled());
+        void* p = memory::allocate(4 * 1024 * 1024);
+        memory::deallocate(p);
+        ENSURE(parent.memory_exceeded());
+        ENSURE(parent.is_canceled());
+        // the memout reaches the children, also the ones that are attached later
+        ENSURE(child.memory_exceeded());
+        ENSURE(child.is_canceled());
+        parent.push_child(&late);
+        ENSURE(late.is_canceled());
+        parent.pop_child();
+    }
+    ENSURE(!parent.memory_exceeded());
+    ENSURE(parent.not_canceled());
+    ENSURE(child.not_canceled());
+    parent.pop_child();
+}
+
+static void tst_watermark() {
+    reslimit r;
+    {
+        scoped_memory_rlimit _ml(r, 0, 1024 * 1024);
+        ENSURE(!r.above_memory_high_watermark() || memory::above_high_watermark());
+        void* p = memory::allocate(4 * 1024 * 1024);
+        ENSURE(r.above_memory_high_watermark());
+        ENSURE(r.not_canceled());
+        memory::deallocate(p);
+    }
+    ENSURE(r.not_canceled());
+}
+
+void tst_rlimit() {
+    tst_memout();
+    tst_watermark();
+}
@@ -0,0 +1,65 @@
+/*++
+Copyright (c) 2024 Microsoft Corporation
+
+Module Name:
+
+    seq_length_abstraction.cpp
+
+Abstract:
+
+    Test the length abstraction of sequence constraints.
+
+--*/
+#include "ast/reg_decl_plugins.h"
+#include "ast/seq_decl_plugin.h"
+#include "ast/simplifiers/seq_length_abstraction.h"
+
+namespace {
+    class test_state : public dependent_expr_state {
+        ast_manager&               m;
+        vector<dependent_expr>     m_fmls;
+        model_reconstruction_trail m_model_trail;
+    public:
+        test_state(ast_manager& m) : dependent_expr_state(m), m(m), m_model_trail(m, m_trail) {}
+        unsigned qtail() const override { return m_fmls.size(); }
+        dependent_expr const& operator[](unsigned i) override { return m_fmls[i]; }
+        void update(unsigned i, dependent_expr const& j) override { m_fmls[i] = j; }
+        void add(dependent_expr const& j) override { m_fmls.push_back(j); m_trail.push(push_back_vector(m_fmls)); }
+        bool inconsistent() override { return false; }
+        model_reconstruction_trail& model_trail() override { return m_model_trail; }
+        bool updated() override { return false; }
+        void reset_updated() override {}
+    };
+}
+
+void tst_seq_length_abstraction() {
+    ast_manager m;
+    reg_decl_plugins(m);
+    seq_util seq(m);
+    sort* str = seq.str.mk_string_sort();
+    expr_ref x(m.mk_const(symbol("x"), str), m);
+    expr_ref y(m.mk_const(symbol("y"), str), m);
+    expr_ref z(m.mk_const(symbol("z"), str), m);
+    expr_ref eq(m.mk_eq(x, seq.str.mk_concat(y, z)), m);
+    test_state st(m);
+    seq_length_abstraction_simplifier s(m, params_ref(), st);
+
+    // the constraints of a popped scope are added again when the equation is asserted again.
+    unsigned counts[2];
+    for (unsigned& n : counts) {
+        st.push();
+        st.add(dependent_expr(m, eq, nullptr, nullptr));
+        s.reduce();
+        n = st.qtail() - 1;
+        st.pop(1);
+        ENSURE(st.qtail() == 0);
+    }
+    ENSURE(counts[0] > 0);
+    ENSURE(counts[0] == counts[1]);
+
+    // constraints are not repeated within a scope.
+    st.add(dependent_expr(m, eq, nullptr, nullptr));
+    st.add(dependent_expr(m, eq, nullptr, nullptr));
+    s.reduce();
+    ENSURE(st.qtail() == 2 + counts[0]);
+}
@@ -39,4 +39,12 @@ void tst_solver_pool() {
     std::cout << *s1;
     std::cout << *s2;
     std::cout << *base;
+
+    // resetting a solver drops its assertions but keeps the background.
+    pool.reset_solver(s1.get());
+    s1->assert_expr(m.mk_not(b));
+    ENSURE(s1->check_sat(asms) == l_false);
+    pool.reset_solver(s1.get());
+    ENSURE(s1->check_sat(asms) == l_true);
+    ENSURE(s2->check_sat(asms) == l_false);
 }
@@ -0,0 +1,208 @@
+/*++
+Copyright (c) 2024 Microsoft Corporation
+
+Module Name:
+
+    swiss_hashtable.cpp
+
+Abstract:
+
+    Test the hashtable with control bytes and compare it with core_hashtable.
+
+--*/
+#include <iostream>
+#include <unordered_map>
+#include <unordered_set>
+#include "util/swiss_hashtable.h"
+#include "util/stopwatch.h"
+#include "util/util.h"
+
+namespace {
+
+    struct id_hash { unsigned operator()(int x) const { return static_cast<unsigned>(x); } };
+
+    typedef swiss_hashtable<int, id_hash, default_eq<int> > swiss_int_set;
+    typedef hashtable<int, id_hash, default_eq<int> >       core_int_set;
+
+    // random inserts and removals, checked against std::unordered_set
+    void tst_random_ops(unsigned num_ops, unsigned range) {
+        swiss_int_set h;
+        std::unordered_set<int> ref;
+        random_gen r(num_ops + range);
+        for (unsigned i = 0; i < num_ops; ++i) {
+            int v = r() % range;
+            switch (r() % 4) {
+            case 0:
+                h.remove(v);
+                ref.erase(v);
+                ENSURE(!h.contains(v));
+                break;
+            default:
+                h.insert(v);
+                ref.insert(v);
+                ENSURE(h.contains(v));
+                break;
+            }
+            ENSURE(h.size() == ref.size());
+        }
+        DEBUG_CODE(ENSURE(h.check_invariant()););
+        unsigned n = 0;
+        for (int v : h) {
+            ENSURE(ref.count(v) == 1);
+            ++n;
+        }
+        ENSURE(n == ref.size());
+        for (int v : ref)
+            ENSURE(h.contains(v));
+    }
+
+    void tst_basic() {
+        swiss_int_set h;
+        ENSURE(h.empty());
+        h.insert(1);
+        h.insert(2);
+        h.insert(2);
+        ENSURE(h.size() == 2);
+        int r = 0;
+        ENSURE(h.find(2, r) && r == 2);
+        ENSURE(!h.find(3, r));
+        ENSURE(h.find(1) != h.end());
+        ENSURE(h.find(3) == h.end());
+
+        swiss_int_set::entry* e = nullptr;
+        ENSURE(!h.insert_if_not_there_core(1, e) && e->get_data() == 1);
+        ENSURE(h.insert_if_not_there_core(3, e) && e->get_data() == 3);
+
+        swiss_int_set copy(h);
+        h.remove(1);
+        ENSURE(!h.contains(1) && copy.contains(1));
+        ENSURE(copy.size() == 3);
+
+        swiss_int_set other;
+        other.insert(5);
+        h |= other;
+        ENSURE(h.contains(5) && h.size() == 3);
+        h &= copy;
+        ENSURE(!h.contains(5) && h.contains(2) && h.contains(3));
+
+        swiss_int_set moved(std::move(copy));
+        ENSURE(moved.size() == 3);
+        moved.swap(h);
+        ENSURE(h.size() == 3 && moved.size() == 2);
+
+        for (int i = 0; i < 1000; ++i)
+            h.insert(i);
+        h.reset();
+        ENSURE(h.empty() && !h.contains(1));
+        h.insert(7);
+        ENSURE(h.contains(7));
+        h.finalize();
+        ENSURE(h.empty());
+    }
+
+    // many removals leave tombstones; the table must keep working without growing
+    void tst_tombstones() {
+        swiss_int_set h;
+        for (int i = 0; i < 100; ++i)
+            h.insert(i);
+        unsigned cap = h.capacity();
+        for (int round = 0; round < 100; ++round) {
+            for (int i = 0; i < 100; ++i)
+                h.remove(round * 100 + i);
+            for (int i = 0; i < 100; ++i)
+                h.insert((round + 1) * 100 + i);
+            ENSURE(h.size() == 100);
+        }
+        ENSURE(h.capacity() <= 2 * cap);
+        for (int i = 0; i < 100; ++i)
+            ENSURE(h.contains(10000 + i));
+        DEBUG_CODE(ENSURE(h.check_invariant()););
+    }
+
+    void tst_map() {
+        u_swiss_map<unsigned> m;
+        std::unordered_map<unsigned, unsigned> ref;
+        random_gen r(3);
+        for (unsigned i = 0; i < 20000; ++i) {
+            unsigned k = r() % 5000;
+            if (r() % 3 == 0) {
+                m.remove(k);
+                ref.erase(k);
+            }
+            else {
+                m.insert(k, i);
+                ref[k] = i;
+            }
+        }
+        ENSURE(m.size() == ref.size());
+        for (auto const& [k, v] : ref) {
+            unsigned w = 0;
+            ENSURE(m.find(k, w) && w == v);
+        }
+        m.insert_if_not_there(100000, 1)++;
+        ENSURE(m[100000] == 2);
+    }
+
+    /**
+       \brief key distributions that occur in the solver:
+       consecutive identifiers (expression and variable ids), strided
+       identifiers (ids of one kind of term among others) and random
+       keys (hashes of composite keys).
+    */
+    void mk_keys(unsigned kind, unsigned n, vector<int>& keys) {
+        random_gen r(kind + 1);
+        keys.reset();
+        for (unsigned i = 0; i < n; ++i) {
+            switch (kind) {
+            case 0: keys.push_back(i); break;
+            case 1: keys.push_back(i * 64); break;
+            default: keys.push_back(static_cast<int>((r() << 15) | r())); break;
+            }
+        }
+    }
+
+    template<typename Table>
+    double bench(vector<int> const& keys, unsigned rounds, unsigned& checksum) {
+        stopwatch sw;
+        sw.start();
+        for (unsigned round = 0; round < rounds; ++round) {
+            Table t;
+            for (int k : keys)
+                t.insert(k);
+            for (int k : keys)
+                checksum += t.contains(k + 1);
+            for (unsigned i = 0; i < keys.size(); i += 2)
+                t.remove(keys[i]);
+            for (int k : keys)
+                checksum += t.contains(k);
+        }
+        sw.stop();
+        return sw.get_seconds();
+    }
+
+    void tst_bench() {
+        char const* names[3] = { "consecutive", "strided", "random" };
+        vector<int> keys;
+        unsigned checksum1 = 0, checksum2 = 0;
+        for (unsigned kind = 0; kind < 3; ++kind) {
+            for (unsigned n : { 100u, 1000u, 20000u }) {
+                mk_keys(kind, n, keys);
+                unsigned rounds = 100000 / n + 1;
+                double t1 = bench<core_int_set>(keys, rounds, checksum1);
+                double t2 = bench<swiss_int_set>(keys, rounds, checksum2);
+                std::cout << names[kind] << " keys: " << n << " rounds: " << rounds
+                          << " core_hashtable: " << t1 << "s swiss_hashtable: " << t2 << "s\n";
+            }
+        }
+        ENSURE(checksum1 == checksum2);
+    }
+}
+
+void tst_swiss_hashtable() {
+    tst_basic();
+    tst_tombstones();
+    for (unsigned i = 0; i < 20; ++i)
+        tst_random_ops(2000 + 500 * i, 50 + 100 * i);
+    tst_map();
+    tst_bench();
+}
@@ -1,6 +1,8 @@
 #include "opt/totalizer.h"
 #include "ast/ast_pp.h"
 #include "ast/reg_decl_plugins.h"
+#include "smt/smt_kernel.h"
+#include "smt/params/smt_params.h"
 #include <iostream>
 
 void tst_totalizer() {
@@ -20,3 +22,42 @@ void tst_totalizer() {
     for (auto& clause : tot.clauses()) 
         std::cout << clause << "\n";
 }
+
+// a totalizer merged from an existing one counts the union of the literals
+void tst_totalizer_merge() {
+    ast_manager m;
+    reg_decl_plugins(m);
+    expr_ref_vector lits(m), lits1(m), lits2(m);
+    for (unsigned i = 0; i < 6; ++i)
+        lits.push_back(m.mk_fresh_const("a", m.mk_bool_sort()));
+    lits1.append(3, lits.data());
+    lits2.append(3, lits.data() + 3);
+    opt::totalizer tot1(lits1);
+    ptr_vector<opt::totalizer> parts;
+    parts.push_back(&tot1);
+    opt::totalizer tot(m, parts, lits2);
+    ENSURE(tot.literals().size() == 6);
+
+    smt_params fp;
+    smt::kernel solver(m, fp);
+    tot1.at_least(2);
+    expr_ref_vector outputs(m);
+    for (unsigned k = 1; k <= 6; ++k)
+        outputs.push_back(tot.at_least(k));
+    solver.assert_expr(tot1.clauses());
+    solver.assert_expr(tot.clauses());
+    for (unsigned bits = 0; bits < 64; ++bits) {
+        unsigned count = 0;
+        expr_ref_vector asms(m);
+        for (unsigned i = 0; i < 6; ++i) {
+            bool b = (bits & (1u << i)) != 0;
+            count += b;
+            asms.push_back(b ? lits.get(i) : m.mk_not(lits.get(i)));
+        }
+        for (unsigned k = 1; k <= 6; ++k) {
+            asms.push_back(m.mk_not(outputs.get(k - 1)));
+            ENSURE((solver.check(asms.size(), asms.data()) == l_true) == (count < k));
+            asms.pop_back();
+        }
+    }
+}
@@ -495,6 +495,9 @@ static void tst_refinable(polynomial_ref const & p, mpbq_manager & bqm, mpbq & a
     upolynomial::scoped_numeral_vector _p(um);
     um.to_numeral_vector(p, _p);
     std::cout << "before (" << bqm.to_string(a) << ", " << bqm.to_string(b) << ")\n";
+    scoped_mpbq a0(bqm), b0(bqm);
+    bqm.set(a0, a);
+    bqm.set(b0, b);
     bool r = um.isolating2refinable(_p.size(), _p.data(), bqm, a, b);
     if (r) {
         std::cout << "new (" << bqm.to_string(a) << ", " << bqm.to_string(b) << ")\n";
@@ -505,6 +508,8 @@ static void tst_refinable(polynomial_ref const & p, mpbq_manager & bqm, mpbq & a
     else {
         std::cout << "new root: " << bqm.to_string(a) << "\n";
         ENSURE(um.eval_sign_at(_p.size(), _p.data(), a) == 0);
+        // the root lies in the open isolating interval
+        ENSURE(bqm.lt(a0, a) && bqm.lt(a, b0));
     }
 }
 
@@ -564,10 +569,15 @@ static void tst_refine(polynomial_ref const & p, mpbq_manager & bqm, mpbq & a, m
     std::cout << "before (" << bqm.to_string(a) << ", " << bqm.to_string(b) << ")\n";
     bool r = um.refine(_p.size(), _p.data(), bqm, a, b, prec_k);
     if (r) {
+        scoped_mpbq w(bqm);
+        bqm.sub(b, a, w);
+        ENSURE(bqm.lt_1div2k(w, prec_k));
+        ENSURE(um.eval_sign_at(_p.size(), _p.data(), a) == -um.eval_sign_at(_p.size(), _p.data(), b));
         std::cout << "new (" << bqm.to_string(a) << ", " << bqm.to_string(b) << ")\n";
         std::cout << "as decimal: "; bqm.display_decimal(std::cout, a, prec_k); std::cout << "\n";
     }
     else {
+        ENSURE(um.eval_sign_at(_p.size(), _p.data(), a) == 0);
         std::cout << "new root: " << bqm.to_string(a) << "\n";
         std::cout << "as decimal: "; bqm.display_decimal(std::cout, a, prec_k); std::cout << "\n";
     }
@@ -595,6 +605,19 @@ static void tst_refine() {
     a = 1;
     b = 2;
     tst_refine(p, bqm, a, b, 200);
+
+    p = (x^3) - 3*x + 1;
+    std::cout << "p: " << p << "\n";
+    a = 0;
+    b = 1;
+    tst_refine(p, bqm, a, b, 1000);
+
+    // the grid of quadratic interval refinement hits the rational root
+    p = (2*x - 1)*(x + 3);
+    std::cout << "p: " << p << "\n";
+    a = 0;
+    b = 1;
+    tst_refine(p, bqm, a, b, 100);
 }
 
 static void tst_translate_q() {
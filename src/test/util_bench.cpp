@@ -0,0 +1,211 @@
+/*++
+Copyright (c) 2024 Microsoft Corporation
+
+Module Name:
+
+    util_bench.cpp
+
+Abstract:
+
+    Throughput of the hot data structures in util.
+
+    test-z3 util_bench [scale]
+
+    Each case runs a fixed mix of operations, scaled by the optional
+    integer argument, and prints the number of operations per second.
+    The checksums keep the compiler from removing the work.
+
+--*/
+#include "util/vector.h"
+#include "util/hashtable.h"
+#include "util/map.h"
+#include "util/heap.h"
+#include "util/small_object_allocator.h"
+#include "util/region.h"
+#include "util/mpq.h"
+#include "util/rational.h"
+#include "util/stopwatch.h"
+#include "util/util.h"
+#include <iostream>
+#include <cstdlib>
+
+namespace {
+
+    struct lt_proc { bool operator()(int v1, int v2) const { return v1 < v2; } };
+
+    unsigned g_checksum = 0;
+
+    template<typename F>
+    void run(char const* name, unsigned num_ops, F& f) {
+        stopwatch sw;
+        sw.start();
+        f();
+        sw.stop();
+        double secs = sw.get_seconds();
+        std::cout << name << ": " << num_ops << " ops " << secs << "s";
+        if (secs > 0)
+            std::cout << " " << (num_ops / secs) / 1000000 << " Mops/s";
+        std::cout << "\n";
+    }
+
+    void bench_vector(unsigned n) {
+        auto f = [&]() {
+            unsigned_vector v;
+            for (unsigned round = 0; round < 10; ++round) {
+                for (unsigned i = 0; i < n; ++i)
+                    v.push_back(i);
+                for (unsigned i = 0; i < n; ++i)
+                    g_checksum += v[i];
+                v.shrink(n / 2);
+                while (!v.empty())
+                    v.pop_back();
+            }
+        };
+        run("vector push/read/pop", 30 * n, f);
+    }
+
+    // insert, lookup and erase mix over random keys
+    void bench_u_map(unsigned n) {
+        auto f = [&]() {
+            u_map<unsigned> m;
+            random_gen r(0);
+            for (unsigned i = 0; i < 4 * n; ++i) {
+                unsigned k = r() % n;
+                switch (i % 4) {
+                case 0: m.insert(k, i); break;
+                case 1: m.erase(k); break;
+                default: g_checksum += m.contains(k); break;
+                }
+            }
+        };
+        run("u_map insert/lookup/erase", 4 * n, f);
+    }
+
+    void bench_hashtable(unsigned n) {
+        auto f = [&]() {
+            int_hashtable<int_hash, default_eq<int>> t;
+            for (unsigned i = 0; i < n; ++i)
+                t.insert(i * 7);
+            for (unsigned i = 0; i < 2 * n; ++i)
+                g_checksum += t.contains(i);
+            for (unsigned i = 0; i < n; i += 2)
+                t.erase(i * 7);
+        };
+        run("int_hashtable insert/lookup/erase", 7 * n / 2, f);
+    }
+
+    void bench_heap(unsigned n) {
+        auto f = [&]() {
+            heap<lt_proc> h(n);
+            random_gen r(1);
+            for (unsigned round = 0; round < 4; ++round) {
+                for (unsigned i = 0; i < n; ++i)
+                    if (!h.contains(r() % n))
+                        h.insert(r() % n);
+                while (!h.empty())
+                    g_checksum += h.erase_min();
+            }
+        };
+        run("heap insert/erase_min", 8 * n, f);
+    }
+
+    // allocation churn with the size mix of small AST nodes and clauses
+    void bench_small_object_allocator(unsigned n) {
+        auto f = [&]() {
+            small_object_allocator a;
+            ptr_vector<char> objs;
+            svector<size_t> sizes;
+            random_gen r(2);
+            for (unsigned i = 0; i < 4 * n; ++i) {
+                if (objs.empty() || r() % 3 != 0) {
+                    size_t sz = 8 + 8 * (r() % 16);
+                    objs.push_back(static_cast<char*>(a.allocate(sz)));
+                    sizes.push_back(sz);
+                }
+                else {
+                    unsigned j = r() % objs.size();
+                    a.deallocate(sizes[j], objs[j]);
+                    objs[j] = objs.back();
+                    sizes[j] = sizes.back();
+                    objs.pop_back();
+                    sizes.pop_back();
+                }
+            }
+            for (unsigned j = 0; j < objs.size(); ++j)
+                a.deallocate(sizes[j], objs[j]);
+        };
+        run("small_object_allocator churn", 4 * n, f);
+    }
+
+    void bench_region(unsigned n) {
+        auto f = [&]() {
+            region r;
+            for (unsigned round = 0; round < 10; ++round) {
+                r.push_scope();
+                for (unsigned i = 0; i < n; ++i)
+                    g_checksum += (reinterpret_cast<size_t>(r.allocate(8 + 8 * (i % 8))) & 1);
+                r.pop_scope();
+            }
+        };
+        run("region allocate/pop_scope", 10 * n, f);
+    }
+
+    // arithmetic mix on small operands (fit in machine words) and on
+    // operands of a few hundred bits as they occur in simplex and Groebner bases.
+    void bench_mpz(unsigned n, unsigned num_bits) {
+        auto f = [&]() {
+            unsynch_mpz_manager m;
+            scoped_mpz a(m), b(m), c(m);
+            m.set(a, 1);
+            m.mul2k(a, num_bits);
+            m.add(a, mpz(12345), a);
+            m.set(b, 1);
+            m.mul2k(b, num_bits / 2);
+            m.add(b, mpz(6789), b);
+            for (unsigned i = 0; i < n; ++i) {
+                m.mul(a, b, c);
+                m.add(c, a, c);
+                m.div(c, b, c);
+                m.sub(c, a, c);
+                m.gcd(a, b, c);
+                g_checksum += m.is_odd(c);
+            }
+        };
+        std::string name = "mpz mul/add/div/sub/gcd " + std::to_string(num_bits) + " bits";
+        run(name.c_str(), 5 * n, f);
+    }
+
+    void bench_rational(unsigned n) {
+        auto f = [&]() {
+            rational sum(0), x(1, 3);
+            for (unsigned i = 0; i < n; ++i) {
+                rational y(static_cast<int>(i % 97) + 1, static_cast<int>(i % 89) + 1);
+                sum += x * y;
+                sum -= y;
+                if (sum > rational(1000))
+                    sum /= rational(7);
+                g_checksum += sum.is_int();
+            }
+        };
+        run("rational add/mul/div", 4 * n, f);
+    }
+}
+
+void tst_util_bench(char** argv, int argc, int& i) {
+    unsigned scale = 1;
+    if (i + 1 < argc && atoi(argv[i + 1]) > 0) {
+        scale = atoi(argv[i + 1]);
+        ++i;
+    }
+    unsigned n = 100000 * scale;
+    bench_vector(n);
+    bench_u_map(n);
+    bench_hashtable(n);
+    bench_heap(n);
+    bench_small_object_allocator(n);
+    bench_region(n);
+    bench_mpz(n, 32);
+    bench_mpz(n / 10, 512);
+    bench_rational(n);
+    std::cout << "checksum: " << g_checksum << "\n";
+}
@@ -0,0 +1,69 @@
+/*++
+Copyright (c) 2024 Microsoft Corporation
+
+Module Name:
+
+    var_queue.cpp
+
+Abstract:
+
+    Test the variable move-to-front representation of var_queue.
+
+--*/
+#include "util/var_queue.h"
+#include "util/util.h"
+
+namespace {
+
+    // the next variable is the queued variable that was bumped last
+    void tst_vmtf(unsigned num_vars, unsigned num_ops, unsigned seed) {
+        unsigned_vector activity;
+        unsigned_vector order;       // least recently bumped first
+        var_queue<unsigned_vector> q(activity);
+        for (unsigned v = 0; v < num_vars; ++v) {
+            activity.push_back(v);
+            order.push_back(v);
+            q.mk_var_eh(v);
+        }
+        // the VMTF list starts in the order of activity
+        q.set_vmtf(true, num_vars);
+        random_gen r(seed);
+        bool_vector queued(num_vars, true);
+        for (unsigned i = 0; i < num_ops; ++i) {
+            unsigned v = r() % num_vars;
+            switch (r() % 3) {
+            case 0:
+                q.activity_increased_eh(v);
+                order.erase(v);
+                order.push_back(v);
+                break;
+            case 1:
+                q.unassign_var_eh(v);
+                queued[v] = true;
+                break;
+            default:
+                if (!q.empty()) {
+                    unsigned w = q.next_var();
+                    unsigned expected = UINT_MAX;
+                    for (unsigned j = order.size(); j-- > 0 && expected == UINT_MAX; )
+                        if (queued[order[j]])
+                            expected = order[j];
+                    ENSURE(w == expected);
+                    queued[w] = false;
+                }
+                break;
+            }
+            for (unsigned u = 0; u < num_vars; ++u)
+                ENSURE(q.contains(u) == queued[u]);
+        }
+        // converting back to the heap keeps the queued variables
+        q.set_vmtf(false, num_vars);
+        for (unsigned u = 0; u < num_vars; ++u)
+            ENSURE(q.contains(u) == queued[u]);
+    }
+}
+
+void tst_var_queue() {
+    for (unsigned i = 0; i < 10; ++i)
+        tst_vmtf(5 + 10 * i, 2000, i);
+}
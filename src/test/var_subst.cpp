@@ -17,6 +17,7 @@ Revision History:
 
 --*/
 #include "ast/rewriter/var_subst.h"
+#include "ast/rewriter/cached_var_subst.h"
 #include "ast/ast_pp.h"
 #include "ast/arith_decl_plugin.h"
 #include "ast/bv_decl_plugin.h"
@@ -99,8 +100,60 @@ void tst_subst(ast_manager& m) {
 
 }
 
+static expr_ref cached_instance(cached_var_subst& cs, quantifier* q, unsigned n, expr* const* bindings) {
+    expr** ebindings = cs(q, n);
+    for (unsigned i = 0; i < n; ++i)
+        ebindings[i] = bindings[i];
+    return cs();
+}
+
+// the instances of cached_var_subst agree with var_subst, both when the body
+// is compiled to a template and when it falls back to var_subst.
+void tst_cached_subst(ast_manager& m) {
+    arith_util a(m);
+    sort_ref s(m.mk_uninterpreted_sort(symbol("S")), m);
+    sort_ref I(a.mk_int(), m);
+    sort* ss[2] = { s.get(), I.get() };
+    symbol names[2] = { symbol("x"), symbol("i") };
+    func_decl_ref p(m.mk_func_decl(symbol("p"), 2, ss, m.mk_bool_sort()), m);
+    func_decl_ref f(m.mk_func_decl(symbol("f"), s, s), m);
+    expr_ref c(m.mk_const(symbol("c"), s), m);
+    expr_ref x(m.mk_var(1, s), m), i(m.mk_var(0, I), m);
+    expr_ref fx(m.mk_app(f, x.get()), m);
+    // shared sub-terms, a ground sub-term and arithmetic over the bound variable
+    expr_ref body(m.mk_or(m.mk_app(p, fx.get(), a.mk_add(i, a.mk_int(1))),
+                          m.mk_eq(fx, m.mk_app(f, c.get())),
+                          m.mk_app(p, c.get(), i.get())), m);
+    quantifier_ref q1(m.mk_forall(2, ss, names, body), m);
+    // a nested quantifier makes the body fall back to var_subst
+    sort* ss1[1] = { s.get() };
+    symbol names1[1] = { symbol("y") };
+    expr_ref inner(m.mk_forall(1, ss1, names1, m.mk_app(p, m.mk_var(0, s), m.mk_var(1, I))), m);
+    quantifier_ref q2(m.mk_forall(2, ss, names, m.mk_and(inner, m.mk_eq(x, c))), m);
+
+    var_subst subst(m);
+    cached_var_subst cs(m);
+    for (unsigned k = 0; k < 3; ++k) {
+        expr_ref b0(m.mk_app(f, c.get()), m), b1(a.mk_int(k), m);
+        expr* bindings[2] = { b0.get(), b1.get() };
+        for (quantifier* q : { q1.get(), q2.get() }) {
+            expr_ref expected = subst(q->get_expr(), 2, bindings);
+            expr_ref r = cached_instance(cs, q, 2, bindings);
+            ENSURE(r.get() == expected.get());
+            // a repeated instance comes from the cache
+            ENSURE(cached_instance(cs, q, 2, bindings).get() == r.get());
+        }
+    }
+    cs.reset();
+    expr_ref seven(a.mk_int(7), m);
+    expr* bindings[2] = { c.get(), seven.get() };
+    expr_ref r = cached_instance(cs, q1, 2, bindings);
+    ENSURE(r.get() == subst(q1->get_expr(), 2, bindings).get());
+}
+
 void tst_var_subst() {
     ast_manager m;
     reg_decl_plugins(m);
     tst_subst(m);
+    tst_cached_subst(m);
 }
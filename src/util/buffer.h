@@ -193,9 +193,11 @@ public:
     }
 
     void append(unsigned n, T const * elems) {
-        for (unsigned i = 0; i < n; i++) {
-            push_back(elems[i]);
-        }
+        while (m_pos + n > m_capacity)
+            expand();
+        for (unsigned i = 0; i < n; i++) 
+            new (m_buffer + m_pos + i) T(elems[i]);
+        m_pos += n;
     }
 
     void append(const buffer& source) {
@@ -257,6 +259,26 @@ public:
         append(other);
         return *this;
     }
+
+    buffer & operator=(buffer && other) noexcept {
+        if (this == &other)
+            return *this;
+        if (other.m_buffer == reinterpret_cast<T*>(other.m_initial_buffer)) {
+            reset();
+            for (unsigned i = 0, sz = other.size(); i < sz; ++i)
+                push_back(std::move(other.m_buffer[i]));
+        }
+        else {
+            destroy();
+            m_buffer         = other.m_buffer;
+            m_pos            = other.m_pos;
+            m_capacity       = other.m_capacity;
+            other.m_buffer   = reinterpret_cast<T*>(other.m_initial_buffer);
+            other.m_pos      = 0;
+            other.m_capacity = INITIAL_SIZE;
+        }
+        return *this;
+    }
 };
 
 // note that the append added is actually not an addition over its base class buffer,
@@ -0,0 +1,126 @@
+/*++
+Copyright (c) 2024 Microsoft Corporation
+
+Module Name:
+
+    char_set.h
+
+Abstract:
+
+    Sets of characters represented as sorted lists of disjoint,
+    non-adjacent closed intervals. Union, intersection and complement
+    are linear in the number of intervals, independently of the number
+    of characters in the set.
+
+--*/
+#pragma once
+
+#include <algorithm>
+#include <ostream>
+#include "util/vector.h"
+
+class char_set {
+public:
+    typedef std::pair<unsigned, unsigned> range;
+private:
+    svector<range> m_ranges;
+
+    // append [lo, hi], where lo is not below the start of the last interval.
+    void push(unsigned lo, unsigned hi) {
+        if (!m_ranges.empty() && (m_ranges.back().second == UINT_MAX || lo <= m_ranges.back().second + 1))
+            m_ranges.back().second = std::max(m_ranges.back().second, hi);
+        else
+            m_ranges.push_back(range(lo, hi));
+    }
+
+public:
+    char_set() = default;
+    char_set(unsigned lo, unsigned hi) { if (lo <= hi) m_ranges.push_back(range(lo, hi)); }
+
+    bool empty() const { return m_ranges.empty(); }
+    unsigned num_ranges() const { return m_ranges.size(); }
+    svector<range> const& ranges() const { return m_ranges; }
+    range const& operator[](unsigned i) const { return m_ranges[i]; }
+
+    bool contains(unsigned c) const {
+        auto it = std::upper_bound(m_ranges.begin(), m_ranges.end(), c,
+                                   [](unsigned c, range const& r) { return c < r.first; });
+        return it != m_ranges.begin() && c <= (it - 1)->second;
+    }
+
+    char_set operator|(char_set const& other) const {
+        char_set result;
+        unsigned i = 0, j = 0;
+        auto const& a = m_ranges;
+        auto const& b = other.m_ranges;
+        while (i < a.size() || j < b.size()) {
+            if (j == b.size() || (i < a.size() && a[i].first <= b[j].first))
+                result.push(a[i].first, a[i].second), ++i;
+            else
+                result.push(b[j].first, b[j].second), ++j;
+        }
+        return result;
+    }
+
+    char_set operator&(char_set const& other) const {
+        char_set result;
+        unsigned i = 0, j = 0;
+        auto const& a = m_ranges;
+        auto const& b = other.m_ranges;
+        while (i < a.size() && j < b.size()) {
+            unsigned lo = std::max(a[i].first, b[j].first);
+            unsigned hi = std::min(a[i].second, b[j].second);
+            if (lo <= hi)
+                result.m_ranges.push_back(range(lo, hi));
+            if (a[i].second < b[j].second)
+                ++i;
+            else
+                ++j;
+        }
+        return result;
+    }
+
+    /**
+       \brief complement with respect to [0, max_char].
+    */
+    char_set complement(unsigned max_char) const {
+        char_set result;
+        unsigned lo = 0;
+        for (auto const& r : m_ranges) {
+            if (r.first > max_char)
+                break;
+            if (lo < r.first)
+                result.m_ranges.push_back(range(lo, r.first - 1));
+            if (r.second >= max_char)
+                return result;
+            lo = r.second + 1;
+        }
+        result.m_ranges.push_back(range(lo, max_char));
+        return result;
+    }
+
+    bool operator==(char_set const& other) const {
+        if (m_ranges.size() != other.m_ranges.size())
+            return false;
+        for (unsigned i = 0; i < m_ranges.size(); ++i)
+            if (m_ranges[i] != other.m_ranges[i])
+                return false;
+        return true;
+    }
+
+    bool operator!=(char_set const& other) const { return !(*this == other); }
+
+    std::ostream& display(std::ostream& out) const {
+        out << "[";
+        for (auto const& r : m_ranges) {
+            out << " " << r.first;
+            if (r.first != r.second)
+                out << "-" << r.second;
+        }
+        return out << " ]";
+    }
+};
+
+inline std::ostream& operator<<(std::ostream& out, char_set const& s) {
+    return s.display(out);
+}
@@ -282,6 +282,15 @@ public:
         return m_capacity;
     }
 
+    /**
+       \brief Expand the table until its capacity is at least \c capacity.
+       Useful to avoid repeated rehashing when many elements are about to be inserted.
+    */
+    void reserve(unsigned capacity) {
+        while (m_capacity < capacity)
+            expand_table();
+    }
+
     unsigned used_slots() const {
         return m_used_slots;
     }
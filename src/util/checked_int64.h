@@ -26,6 +26,12 @@ Revision History:
 #include "util/z3_exception.h"
 #include "util/rational.h"
 
+#ifdef __has_builtin
+#if __has_builtin(__builtin_add_overflow) && __has_builtin(__builtin_sub_overflow) && __has_builtin(__builtin_mul_overflow)
+#define _CHECKED_INT64_BUILTIN_OVERFLOW
+#endif
+#endif
+
 template<bool CHECK>
 class checked_int64 {
     int64_t m_value;
@@ -115,11 +121,16 @@ public:
 
     checked_int64& operator+=(checked_int64 const& other) { 
         if (CHECK) {
+#ifdef _CHECKED_INT64_BUILTIN_OVERFLOW
+            int64_t r;
+            if (__builtin_add_overflow(m_value, other.m_value, &r)) throw overflow_exception();
+#else
             uint64_t x = static_cast<uint64_t>(m_value);
             uint64_t y = static_cast<uint64_t>(other.m_value);
             int64_t r = static_cast<int64_t>(x + y);
             if (m_value > 0 && other.m_value > 0 && r <= 0) throw overflow_exception();
             if (m_value < 0 && other.m_value < 0 && r >= 0) throw overflow_exception();
+#endif
             m_value = r;
         }
         else {
@@ -130,11 +141,16 @@ public:
 
     checked_int64& operator-=(checked_int64 const& other) {
         if (CHECK) {
+#ifdef _CHECKED_INT64_BUILTIN_OVERFLOW
+            int64_t r;
+            if (__builtin_sub_overflow(m_value, other.m_value, &r)) throw overflow_exception();
+#else
             uint64_t x = static_cast<uint64_t>(m_value);
             uint64_t y = static_cast<uint64_t>(other.m_value);
             int64_t r = static_cast<int64_t>(x - y);
             if (m_value > 0 && other.m_value < 0 && r <= 0) throw overflow_exception();
             if (m_value < 0 && other.m_value > 0 && r >= 0) throw overflow_exception();
+#endif
             m_value = r;            
         }
         else {
@@ -145,10 +161,14 @@ public:
 
     checked_int64& operator*=(checked_int64 const& other) {
         if (CHECK) {
+#ifdef _CHECKED_INT64_BUILTIN_OVERFLOW
+            int64_t r;
+            if (__builtin_mul_overflow(m_value, other.m_value, &r)) throw overflow_exception();
+            m_value = r;
+#else
             if (INT_MIN < m_value && m_value <= INT_MAX && INT_MIN < other.m_value && other.m_value <= INT_MAX) {
                 m_value *= other.m_value;
             }
-            // TBD: could be tuned by using known techniques or 128-bit arithmetic.
             else {
                 rational r(r64(m_value) * r64(other.m_value));
                 if (!r.is_int64()) {
@@ -156,6 +176,7 @@ public:
                 }
                 m_value = r.get_int64();
             }
+#endif
         }
         else {
             m_value *= other.m_value; 
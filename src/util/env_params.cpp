@@ -21,6 +21,7 @@ Notes:
 #include "util/gparams.h"
 #include "util/util.h"
 #include "util/memory_manager.h"
+#include "util/phase_profiler.h"
 
 void env_params::updt_params() {
     params_ref const& p = gparams::get_ref();
@@ -32,6 +33,9 @@ void env_params::updt_params() {
     unsigned mb = p.get_uint("memory_high_watermark_mb", 0);
     if (mb > 0)
         memory::set_high_watermark(megabytes_to_bytes(mb));    
+    phase_profiler::set_file(p.get_str("profile_file", ""));
+    set_max_threads(p.get_uint("threads_max", 0));
+    set_pin_threads(p.get_bool("threads_pin", false));
 }
 
 void env_params::collect_param_descrs(param_descrs & d) {
@@ -41,4 +45,8 @@ void env_params::collect_param_descrs(param_descrs & d) {
     d.insert("memory_max_alloc_count", CPK_UINT, "set hard upper limit for memory allocations, if 0 then there is no limit", "0");
     d.insert("memory_high_watermark", CPK_UINT, "set high watermark for memory consumption (in bytes), if 0 then there is no limit", "0");
     d.insert("memory_high_watermark_mb", CPK_UINT, "set high watermark for memory consumption (in megabytes), if 0 then there is no limit", "0");
+    d.insert("threads_max", CPK_UINT, "set hard upper limit on the number of threads spawned by parallel solvers, tactics and simplifiers, if 0 then there is no limit other than the number of processors", "0");
+    d.insert("threads_pin", CPK_BOOL, "pin the worker threads of parallel solvers to processors, so that each worker allocates its state on the memory node of its processor (Linux only)", "false");
+    d.insert("log_buffered", CPK_BOOL, "write the API log opened with Z3_open_log from a background buffer instead of at the end of each call; faster, but the end of the log is lost if the process crashes", "false");
+    d.insert("profile_file", CPK_STRING, "record time, memory and input size of each tactic, simplifier and check-sat call in the given file: Chrome trace format if the name ends with .json, folded stacks otherwise", "");
 }
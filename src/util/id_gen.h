@@ -18,6 +18,7 @@ Revision History:
 --*/
 #pragma once
 
+#include <algorithm>
 #include "util/vector.h"
 #include "util/util.h"
 
@@ -56,6 +57,20 @@ public:
         m_free_ids.finalize();
     }
     
+    /**
+       \brief Give back the free ids at the top of the range and order the
+       remaining ones so that the smallest ids are handed out first.
+       Keeps the id range, and the side tables indexed by it, dense.
+    */
+    void compact() {
+        std::sort(m_free_ids.begin(), m_free_ids.end());
+        while (!m_free_ids.empty() && m_free_ids.back() + 1 == m_next_id) {
+            --m_next_id;
+            m_free_ids.pop_back();
+        }
+        std::reverse(m_free_ids.begin(), m_free_ids.end());
+    }
+    
     unsigned show_hash(){
       unsigned h = string_hash((char *)&m_free_ids[0],m_free_ids.size()*sizeof(unsigned),17);
       return hash_u_u(h,m_next_id);
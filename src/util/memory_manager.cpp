@@ -10,6 +10,7 @@ Copyright (c) 2015 Microsoft Corporation
 #include "util/mutex.h"
 #include "util/trace.h"
 #include "util/memory_manager.h"
+#include "util/rlimit.h"
 #include "util/error_codes.h"
 #include "util/debug.h"
 #include "util/scoped_timer.h"
@@ -54,14 +55,15 @@ out_of_memory_error::out_of_memory_error():z3_error(ERR_MEMOUT) {
 }
 
 
-static DECLARE_INIT_MUTEX(g_memory_mux);
 static atomic<bool> g_memory_out_of_memory(false);
 static bool       g_memory_initialized       = false;
-static long long  g_memory_alloc_size        = 0;
+// The global counters are updated with atomic operations so that threads
+// folding their local counters into them do not serialize on a mutex.
+static atomic<long long> g_memory_alloc_size(0);
 static long long  g_memory_max_size          = 0;
-static long long  g_memory_max_used_size     = 0;
+static atomic<long long> g_memory_max_used_size(0);
 static long long  g_memory_watermark         = 0;
-static long long  g_memory_alloc_count       = 0;
+static atomic<long long> g_memory_alloc_count(0);
 static long long  g_memory_max_alloc_count   = 0;
 static bool       g_exit_when_out_of_memory  = false;
 static char const * g_out_of_memory_msg      = "ERROR: out of memory";
@@ -132,7 +134,6 @@ void memory::set_high_watermark(size_t watermark) {
 bool memory::above_high_watermark() {
     if (g_memory_watermark == 0)
         return false;
-    lock_guard lock(*g_memory_mux);
     return g_memory_watermark < g_memory_alloc_size;
 }
 
@@ -153,9 +154,6 @@ void memory::finalize(bool shutdown) {
     if (g_memory_initialized) {
         g_finalizing = true;
         mem_finalize();
-        // we leak the mutex since we need it to be always live since memory may
-        // be reinitialized again
-        //delete g_memory_mux;
         g_memory_initialized = false;
         g_finalizing = false;
 
@@ -166,22 +164,14 @@ void memory::finalize(bool shutdown) {
 }
 
 unsigned long long memory::get_allocation_size() {
-    long long r;
-    {
-        lock_guard lock(*g_memory_mux);
-        r = g_memory_alloc_size;
-    }
+    long long r = g_memory_alloc_size;
     if (r < 0)
         r = 0;
     return r;
 }
 
 unsigned long long memory::get_max_used_memory() {
-    unsigned long long r;
-    {
-        lock_guard lock(*g_memory_mux);
-        r = g_memory_max_used_size;
-    }
+    unsigned long long r = g_memory_max_used_size;
     return r;
 }
 
@@ -247,26 +237,24 @@ void * memory::allocate(char const* file, int line, char const* obj, size_t s) {
 
 thread_local long long g_memory_thread_alloc_size    = 0;
 thread_local long long g_memory_thread_alloc_count   = 0;
+thread_local reslimit* g_memory_thread_limit         = nullptr;
 
 static void synchronize_counters(bool allocating) {
 #ifdef PROFILE_MEMORY
     g_synch_counter++;
 #endif
 
-    bool out_of_mem = false;
-    bool counts_exceeded = false;
-    {
-        lock_guard lock(*g_memory_mux);
-        g_memory_alloc_size += g_memory_thread_alloc_size;
-        g_memory_alloc_count += g_memory_thread_alloc_count;
-        if (g_memory_alloc_size > g_memory_max_used_size)
-            g_memory_max_used_size = g_memory_alloc_size;
-        if (g_memory_max_size != 0 && g_memory_alloc_size > g_memory_max_size)
-            out_of_mem = true;
-        if (g_memory_max_alloc_count != 0 && g_memory_alloc_count > g_memory_max_alloc_count)
-            counts_exceeded = true;
-    }
-    g_memory_thread_alloc_size = 0;
+    long long alloc_size  = (g_memory_alloc_size += g_memory_thread_alloc_size);
+    long long alloc_count = (g_memory_alloc_count += g_memory_thread_alloc_count);
+    long long max_used    = g_memory_max_used_size;
+    while (alloc_size > max_used && !g_memory_max_used_size.compare_exchange_weak(max_used, alloc_size))
+        ;
+    bool out_of_mem      = g_memory_max_size != 0 && alloc_size > g_memory_max_size;
+    bool counts_exceeded = g_memory_max_alloc_count != 0 && alloc_count > g_memory_max_alloc_count;
+    if (g_memory_thread_limit)
+        g_memory_thread_limit->inc_memory(g_memory_thread_alloc_size);
+    g_memory_thread_alloc_size  = 0;
+    g_memory_thread_alloc_count = 0;
     if (out_of_mem && allocating) {
         throw_out_of_memory();
     }
@@ -275,6 +263,14 @@ static void synchronize_counters(bool allocating) {
     }
 }
 
+reslimit* memory::set_thread_limit(reslimit* r) {
+    // the pending allocations belong to the previous limit
+    synchronize_counters(false);
+    reslimit* prev = g_memory_thread_limit;
+    g_memory_thread_limit = r;
+    return prev;
+}
+
 void memory::deallocate(void * p) {
 #ifdef HAS_MALLOC_USABLE_SIZE
     size_t sz      = malloc_usable_size(p);
@@ -355,6 +351,14 @@ void* memory::reallocate(void *p, size_t s) {
 // ==================================
 // allocate & deallocate without locking
 
+static reslimit* g_memory_thread_limit = nullptr;
+
+reslimit* memory::set_thread_limit(reslimit* r) {
+    reslimit* prev = g_memory_thread_limit;
+    g_memory_thread_limit = r;
+    return prev;
+}
+
 void memory::deallocate(void * p) {
 #ifdef HAS_MALLOC_USABLE_SIZE
     size_t sz      = malloc_usable_size(p);
@@ -365,6 +369,8 @@ void memory::deallocate(void * p) {
     void * real_p  = reinterpret_cast<void*>(sz_p);
 #endif
     g_memory_alloc_size -= sz;
+    if (g_memory_thread_limit)
+        g_memory_thread_limit->inc_memory(-static_cast<long long>(sz));
     free(real_p);
 }
 
@@ -374,6 +380,8 @@ void * memory::allocate(size_t s) {
 #endif
     g_memory_alloc_size += s;
     g_memory_alloc_count += 1;
+    if (g_memory_thread_limit)
+        g_memory_thread_limit->inc_memory(s);
     if (g_memory_alloc_size > g_memory_max_used_size)
         g_memory_max_used_size = g_memory_alloc_size;
     if (g_memory_max_size != 0 && g_memory_alloc_size > g_memory_max_size)
@@ -410,6 +418,8 @@ void* memory::reallocate(void *p, size_t s) {
 #endif
     g_memory_alloc_size += s - sz;
     g_memory_alloc_count += 1;
+    if (g_memory_thread_limit)
+        g_memory_thread_limit->inc_memory(static_cast<long long>(s) - static_cast<long long>(sz));
     if (g_memory_alloc_size > g_memory_max_used_size)
         g_memory_max_used_size = g_memory_alloc_size;
     if (g_memory_max_size != 0 && g_memory_alloc_size > g_memory_max_size)
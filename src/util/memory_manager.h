@@ -48,6 +48,8 @@ public:
     out_of_memory_error();
 };
 
+class reslimit;
+
 class memory {
 public:
     static bool is_out_of_memory();
@@ -70,6 +72,8 @@ public:
     static unsigned long long get_max_used_memory();
     static unsigned long long get_allocation_count();
     static unsigned long long get_max_memory_size();
+    // account the allocations of the calling thread to r, returns the previous limit
+    static reslimit* set_thread_limit(reslimit* r);
     // temporary hack to avoid out-of-memory crash in z3.exe
     static void exit_when_out_of_memory(bool flag, char const * msg);
 };
@@ -51,6 +51,11 @@ Revision History:
 #else
     #define HAS_BUILTIN(X) 0
 #endif
+#if HAS_BUILTIN(__builtin_add_overflow) && HAS_BUILTIN(__builtin_sub_overflow) && HAS_BUILTIN(__builtin_mul_overflow)
+// operands that fit in 64 bits are combined directly when the result does not overflow.
+#define _MPZ_INT64_FAST_PATH
+#endif
+
 #if HAS_BUILTIN(__builtin_ctz)
 #define _trailing_zeros32(X) __builtin_ctz(X)
 #elif defined(_WINDOWS) && (defined(_M_X86) || (defined(_M_X64) && !defined(_M_ARM64EC))) && !defined(__clang__)
@@ -252,9 +257,17 @@ void mpz_manager<SYNCH>::del(mpz_manager<SYNCH>* m, mpz & a) {
 template<bool SYNCH>
 void mpz_manager<SYNCH>::add(mpz const & a, mpz const & b, mpz & c) {
     STRACE("mpz", tout << "[mpz] " << to_string(a) << " + " << to_string(b) << " == ";); 
+#ifdef _MPZ_INT64_FAST_PATH
+    int64_t r;
+#endif
     if (is_small(a) && is_small(b)) {
         set_i64(c, i64(a) + i64(b));
     }
+#ifdef _MPZ_INT64_FAST_PATH
+    else if (is_int64(a) && is_int64(b) && !__builtin_add_overflow(get_int64(a), get_int64(b), &r)) {
+        set_i64(c, r);
+    }
+#endif
     else {
         big_add(a, b, c);
     }
@@ -264,9 +277,17 @@ void mpz_manager<SYNCH>::add(mpz const & a, mpz const & b, mpz & c) {
 template<bool SYNCH>
 void mpz_manager<SYNCH>::sub(mpz const & a, mpz const & b, mpz & c) {
     STRACE("mpz", tout << "[mpz] " << to_string(a) << " - " << to_string(b) << " == ";); 
+#ifdef _MPZ_INT64_FAST_PATH
+    int64_t r;
+#endif
     if (is_small(a) && is_small(b)) {
         set_i64(c, i64(a) - i64(b));
     }
+#ifdef _MPZ_INT64_FAST_PATH
+    else if (is_int64(a) && is_int64(b) && !__builtin_sub_overflow(get_int64(a), get_int64(b), &r)) {
+        set_i64(c, r);
+    }
+#endif
     else {
         big_sub(a, b, c);
     }
@@ -508,9 +529,17 @@ void mpz_manager<SYNCH>::set_digits(mpz & target, unsigned sz, digit_t const * d
 template<bool SYNCH>
 void mpz_manager<SYNCH>::mul(mpz const & a, mpz const & b, mpz & c) {
     STRACE("mpz", tout << "[mpz] " << to_string(a) << " * " << to_string(b) << " == ";); 
+#ifdef _MPZ_INT64_FAST_PATH
+    int64_t r;
+#endif
     if (is_small(a) && is_small(b)) {
         set_i64(c, i64(a) * i64(b));
     }
+#ifdef _MPZ_INT64_FAST_PATH
+    else if (is_int64(a) && is_int64(b) && !__builtin_mul_overflow(get_int64(a), get_int64(b), &r)) {
+        set_i64(c, r);
+    }
+#endif
     else {
         big_mul(a, b, c);
     }
@@ -520,7 +549,11 @@ void mpz_manager<SYNCH>::mul(mpz const & a, mpz const & b, mpz & c) {
 // d <- a + b*c
 template<bool SYNCH>
 void mpz_manager<SYNCH>::addmul(mpz const & a, mpz const & b, mpz const & c, mpz & d) {
-    if (is_one(b)) {
+    if (is_small(a) && is_small(b) && is_small(c)) {
+        // the product of two small values is below 2^62 in absolute value.
+        set_i64(d, i64(a) + i64(b) * i64(c));
+    }
+    else if (is_one(b)) {
         add(a, c, d);
     }
     else if (is_minus_one(b)) {
@@ -538,7 +571,10 @@ void mpz_manager<SYNCH>::addmul(mpz const & a, mpz const & b, mpz const & c, mpz
 // d <- a - b*c
 template<bool SYNCH>
 void mpz_manager<SYNCH>::submul(mpz const & a, mpz const & b, mpz const & c, mpz & d) {
-    if (is_one(b)) {
+    if (is_small(a) && is_small(b) && is_small(c)) {
+        set_i64(d, i64(a) - i64(b) * i64(c));
+    }
+    else if (is_one(b)) {
         sub(a, c, d);
     }
     else if (is_minus_one(b)) {
@@ -19,6 +19,30 @@ Revision History:
 #pragma once
 
 #include "util/bit_vector.h"
+#include "util/vector.h"
+
+/**
+   \brief marks stored as generation counters: an index is marked if its
+   counter equals the current generation. reset() bumps the generation, so it
+   takes constant time instead of clearing the whole vector.
+   Use it for marks that are reset frequently; it takes a word per index.
+*/
+class epoch_bit_vector {
+    unsigned_vector m_epochs;
+    unsigned        m_epoch = 1;
+public:
+    unsigned size() const { return m_epochs.size(); }
+    bool get(unsigned idx) const { return m_epochs[idx] == m_epoch; }
+    void set(unsigned idx, bool val) { m_epochs[idx] = val ? m_epoch : 0; }
+    void resize(unsigned sz, bool val) { m_epochs.resize(sz, val ? m_epoch : 0); }
+    void reset() {
+        ++m_epoch;
+        if (m_epoch == 0) {
+            m_epochs.fill(0);
+            m_epoch = 1;
+        }
+    }
+};
 
 template<typename T>
 struct default_t2uint {
@@ -291,6 +291,11 @@ public:
         t.m_updt_counter = 0;
     }
 
+    // r1 and r2 denote the same version of an array, so they have the same contents.
+    bool same(ref const & r1, ref const & r2) const {
+        return r1.m_ref == r2.m_ref;
+    }
+
     unsigned size(ref const & r) const {
         cell * c = r.m_ref;
         if (c == nullptr) return 0;
@@ -0,0 +1,141 @@
+/*++
+Copyright (c) 2024 Microsoft Corporation
+
+Module Name:
+
+    phase_profiler.cpp
+
+Abstract:
+
+    Opt-in profiling of tactics, simplifiers and solver calls.
+
+--*/
+#include <chrono>
+#include <fstream>
+#include <thread>
+#include <functional>
+#include <vector>
+#include "util/phase_profiler.h"
+#include "util/memory_manager.h"
+#include "util/mutex.h"
+#include "util/z3_exception.h"
+
+namespace phase_profiler {
+    std::atomic<bool> g_enabled(false);
+}
+
+static DECLARE_MUTEX(g_profile_mux);
+static std::ofstream * g_profile_out = nullptr;
+static bool            g_profile_chrome = false;
+static bool            g_profile_first = true;
+static std::string *   g_profile_file = nullptr;
+
+static unsigned long long now_us() {
+    using namespace std::chrono;
+    static steady_clock::time_point start = steady_clock::now();
+    return duration_cast<microseconds>(steady_clock::now() - start).count();
+}
+
+namespace {
+    struct frame {
+        char const *       m_name;
+        unsigned long long m_child_us;
+    };
+}
+
+// open scopes of the current thread, used for folded stacks and self time.
+// std::vector is used because the vector may outlive the memory manager.
+static thread_local std::vector<frame> g_stack;
+
+static void close_profile_file() {
+    if (!g_profile_out)
+        return;
+    if (g_profile_chrome)
+        *g_profile_out << "\n]\n";
+    g_profile_out->close();
+    dealloc(g_profile_out);
+    g_profile_out = nullptr;
+}
+
+void initialize_phase_profiler() {
+    ALLOC_MUTEX(g_profile_mux);
+}
+
+void finalize_phase_profiler() {
+    phase_profiler::set_file(std::string());
+    DEALLOC_MUTEX(g_profile_mux);
+}
+
+void phase_profiler::set_file(std::string const& file_name) {
+    lock_guard lock(*g_profile_mux);
+    if (g_profile_file && *g_profile_file == file_name)
+        return;
+    close_profile_file();
+    dealloc(g_profile_file);
+    g_profile_file = nullptr;
+    g_enabled = false;
+    if (file_name.empty())
+        return;
+    g_profile_out = alloc(std::ofstream, file_name);
+    if (!*g_profile_out) {
+        dealloc(g_profile_out);
+        g_profile_out = nullptr;
+        throw default_exception("could not open profile file " + file_name);
+    }
+    g_profile_chrome = file_name.size() >= 5 && file_name.compare(file_name.size() - 5, 5, ".json") == 0;
+    g_profile_first = true;
+    g_profile_file = alloc(std::string, file_name);
+    if (g_profile_chrome)
+        *g_profile_out << "[\n";
+    g_enabled = true;
+}
+
+phase_scope::phase_scope(char const * name, unsigned size_before):
+    m_name(name),
+    m_enabled(phase_profiler::enabled()) {
+    if (!m_enabled)
+        return;
+    m_size_before = size_before;
+    m_size_after = size_before;
+    m_start_memory = memory::get_allocation_size();
+    m_start_allocs = memory::get_allocation_count();
+    g_stack.push_back({ name, 0 });
+    m_start_us = now_us();
+}
+
+phase_scope::~phase_scope() {
+    if (!m_enabled)
+        return;
+    unsigned long long dur = now_us() - m_start_us;
+    long long mem = static_cast<long long>(memory::get_allocation_size()) - static_cast<long long>(m_start_memory);
+    unsigned long long allocs = memory::get_allocation_count() - m_start_allocs;
+    unsigned long long self = dur > g_stack.back().m_child_us ? dur - g_stack.back().m_child_us : 0;
+    std::string stack;
+    for (frame const& f : g_stack) {
+        if (!stack.empty())
+            stack += ";";
+        stack += f.m_name;
+    }
+    g_stack.pop_back();
+    if (!g_stack.empty())
+        g_stack.back().m_child_us += dur;
+
+    lock_guard lock(*g_profile_mux);
+    if (!g_profile_out)
+        return;
+    std::ostream& out = *g_profile_out;
+    if (g_profile_chrome) {
+        if (!g_profile_first)
+            out << ",\n";
+        g_profile_first = false;
+        out << "{\"name\":\"" << m_name << "\",\"ph\":\"X\",\"pid\":1"
+            << ",\"tid\":" << std::hash<std::thread::id>()(std::this_thread::get_id()) % 100000
+            << ",\"ts\":" << m_start_us << ",\"dur\":" << dur
+            << ",\"args\":{\"memory-delta\":" << mem << ",\"allocations\":" << allocs
+            << ",\"size-before\":" << m_size_before << ",\"size-after\":" << m_size_after << "}}";
+    }
+    else {
+        out << stack << " " << self << "\n";
+    }
+    out.flush();
+}
@@ -0,0 +1,57 @@
+/*++
+Copyright (c) 2024 Microsoft Corporation
+
+Module Name:
+
+    phase_profiler.h
+
+Abstract:
+
+    Opt-in profiling of tactics, simplifiers and solver calls.
+
+    When the global parameter profile_file is set, every phase_scope
+    records its wall time, the change in allocated memory, the number of
+    allocations and the size of its input and output. Events are appended
+    to the file as they complete. A file name ending with .json produces
+    the Chrome trace event format (chrome://tracing, Perfetto); any other
+    name produces folded stacks, one "outer;inner self-time-in-us" line
+    per event, as read by flamegraph.pl.
+
+--*/
+#pragma once
+
+#include <string>
+#include <atomic>
+
+void initialize_phase_profiler();
+void finalize_phase_profiler();
+/*
+  ADD_INITIALIZER('initialize_phase_profiler();')
+  ADD_FINALIZER('finalize_phase_profiler();')
+*/
+
+namespace phase_profiler {
+    extern std::atomic<bool> g_enabled;
+
+    inline bool enabled() { return g_enabled; }
+
+    /**
+       \brief start writing events to the given file. The empty string stops profiling.
+       Setting the file that is already in use has no effect.
+    */
+    void set_file(std::string const& file_name);
+}
+
+class phase_scope {
+    char const *       m_name;
+    bool               m_enabled;
+    unsigned long long m_start_us = 0;
+    unsigned long long m_start_memory = 0;
+    unsigned long long m_start_allocs = 0;
+    unsigned           m_size_before = 0;
+    unsigned           m_size_after = 0;
+public:
+    phase_scope(char const * name, unsigned size_before = 0);
+    ~phase_scope();
+    void set_size_after(unsigned sz) { m_size_after = sz; }
+};
@@ -0,0 +1,27 @@
+/*++
+Copyright (c) 2024 Microsoft Corporation
+
+Module Name:
+
+    prefetch.h
+
+Abstract:
+
+    Hint to the processor that an address is going to be read soon.
+
+--*/
+#pragma once
+
+#if defined(_MSC_VER) && !defined(_M_ARM) && !defined(_M_ARM64)
+# include <xmmintrin.h>
+#endif
+
+inline void prefetch_address(void const* p) {
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(p);
+#elif !defined(_M_ARM) && !defined(_M_ARM64)
+    _mm_prefetch((const char*)p, _MM_HINT_T1);
+#else
+    (void)p;
+#endif
+}
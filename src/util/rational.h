@@ -412,11 +412,8 @@ public:
             operator+=(c);
         else if (k.is_minus_one())
             operator-=(c);
-        else {
-            rational tmp(k);
-            tmp *= c;
-            operator+=(tmp);
-        }
+        else 
+            m().addmul(m_val, c.m_val, k.m_val, m_val);
     }
 
     // Perform:  this -= c * k
@@ -425,11 +422,8 @@ public:
             operator-=(k);
         else if (c.is_minus_one())
             operator+=(k);
-        else {
-            rational tmp(k);
-            tmp *= c;
-            operator-=(tmp);
-        }
+        else 
+            m().submul(m_val, c.m_val, k.m_val, m_val);
     }
 
     bool is_int_perfect_square(rational & root) const {
@@ -35,7 +35,9 @@ reslimit::reslimit():
     m_cancel(0),
     m_suspend(false),
     m_count(0),
-    m_limit(std::numeric_limits<uint64_t>::max()) {
+    m_limit(std::numeric_limits<uint64_t>::max()),
+    m_memory(0),
+    m_memout(false) {
 }
 
 uint64_t reslimit::count() const {
@@ -75,14 +77,24 @@ char const* reslimit::get_cancel_msg() const {
     if (m_cancel > 0) {
         return Z3_CANCELED_MSG;
     }
+    else if (m_memout) {
+        return Z3_MAX_MEMORY_MSG;
+    }
     else {
         return Z3_MAX_RESOURCE_MSG;
     }
 }
 
 void reslimit::push_child(reslimit* r) {
-    lock_guard lock(*g_rlimit_mux);
-    m_children.push_back(r);    
+    // growing m_children allocates, a memout raised by the allocation would take the lock again
+    reslimit* lim = memory::set_thread_limit(nullptr);
+    {
+        lock_guard lock(*g_rlimit_mux);
+        m_children.push_back(r);
+        if (m_memout)
+            r->set_memout(true);
+    }
+    memory::set_thread_limit(lim);
 }
 
 void reslimit::pop_child() {
@@ -120,3 +132,39 @@ void reslimit::set_cancel(unsigned f) {
         m_children[i]->set_cancel(f);
     }
 }
+
+void reslimit::memout() {
+    lock_guard lock(*g_rlimit_mux);
+    set_memout(true);
+}
+
+void reslimit::set_memout(bool f) {
+    m_memout = f;
+    for (unsigned i = 0; i < m_children.size(); ++i) {
+        m_children[i]->set_memout(f);
+    }
+}
+
+scoped_memory_rlimit::scoped_memory_rlimit(reslimit& r, uint64_t max_memory, uint64_t high_watermark):
+    m_limit(r) {
+    if (max_memory == 0 && high_watermark == 0)
+        return;
+    m_prev = memory::set_thread_limit(&r);
+    if (m_prev == &r)
+        return;
+    m_active = true;
+    r.m_memory = 0;
+    r.m_memout = false;
+    r.m_max_memory = max_memory;
+    r.m_memory_high = high_watermark;
+}
+
+scoped_memory_rlimit::~scoped_memory_rlimit() {
+    if (!m_active)
+        return;
+    memory::set_thread_limit(m_prev);
+    m_limit.m_max_memory = 0;
+    m_limit.m_memory_high = 0;
+    lock_guard lock(*g_rlimit_mux);
+    m_limit.set_memout(false);
+}
@@ -35,9 +35,16 @@ class reslimit {
     uint64_t        m_limit;
     svector<uint64_t> m_limits;
     ptr_vector<reslimit> m_children;
+    std::atomic<long long> m_memory;    // bytes allocated by the threads attached to this limit
+    std::atomic<bool> m_memout;
+    uint64_t        m_max_memory = 0;   // 0 means no limit
+    uint64_t        m_memory_high = 0;
 
     void set_cancel(unsigned f);
+    void set_memout(bool f);
+    void memout();
     friend class scoped_suspend_rlimit;
+    friend class scoped_memory_rlimit;
 
 public:
     reslimit();
@@ -51,7 +58,7 @@ public:
     uint64_t count() const;
 
     bool suspended() const { return m_suspend;  }
-    inline bool not_canceled() const { return (m_cancel == 0 && m_count <= m_limit) || m_suspend; }
+    inline bool not_canceled() const { return (m_cancel == 0 && m_count <= m_limit && !m_memout) || m_suspend; }
     inline bool is_canceled() const { return !not_canceled(); }
     char const* get_cancel_msg() const;
     void cancel();
@@ -59,6 +66,22 @@ public:
 
     void inc_cancel();
     void dec_cancel();
+
+    /**
+       \brief memory accounting for the threads attached with scoped_memory_rlimit.
+       Exceeding the maximum cancels the limit and its children, exceeding the
+       high watermark asks the solvers to reduce their clause databases and caches.
+    */
+    void inc_memory(long long delta) {
+        long long sz = (m_memory += delta);
+        if (m_max_memory != 0 && sz > static_cast<long long>(m_max_memory) && !m_memout)
+            memout();
+    }
+    long long memory() const { return m_memory; }
+    bool memory_exceeded() const { return m_memout; }
+    bool above_memory_high_watermark() const {
+        return (m_memory_high != 0 && m_memory > static_cast<long long>(m_memory_high)) || memory::above_high_watermark();
+    }
 };
 
 class scoped_rlimit {
@@ -89,6 +112,21 @@ public:
     }
 };
 
+/**
+   \brief attach the current thread to the memory accounting of r with the
+   given maximum and high watermark (in bytes, 0 for none).
+   The accounting starts from zero, nested scopes on the same limit keep the
+   outer scope.
+*/
+class scoped_memory_rlimit {
+    reslimit& m_limit;
+    reslimit* m_prev = nullptr;
+    bool      m_active = false;
+public:
+    scoped_memory_rlimit(reslimit& r, uint64_t max_memory, uint64_t high_watermark);
+    ~scoped_memory_rlimit();
+};
+
 struct scoped_limits {
     reslimit&  m_limit;
     unsigned   m_sz = 0;
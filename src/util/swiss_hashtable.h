@@ -0,0 +1,569 @@
+/*++
+Copyright (c) 2024 Microsoft Corporation
+
+Module Name:
+
+    swiss_hashtable.h
+
+Abstract:
+
+    Open addressing hashtable with control bytes.
+
+    The table has the interface of core_hashtable and uses the same
+    entries, so a table can switch between the two implementations.
+    Next to the entries, it keeps one control byte per slot that is
+    either EMPTY, DELETED or holds 7 bits of the (mixed) hash code.
+    Probing scans the control bytes of a group of consecutive slots at
+    once, 16 with SSE2 and 8 with portable word operations otherwise,
+    and only compares the entries whose control byte matches. Groups
+    are visited in triangular order, which covers the whole table.
+
+    The control bytes of the first group are mirrored after the last
+    slot, so that a group can be loaded at any slot without wrapping.
+
+--*/
+#pragma once
+
+#include <cstring>
+#include "util/hashtable.h"
+#include "util/map.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define SWISS_TABLE_SSE2
+#endif
+
+namespace swiss_table {
+
+    typedef signed char ctrl_t;
+
+    // full slots hold values in [0, 127]
+    const ctrl_t EMPTY   = -128;
+    const ctrl_t DELETED = -2;
+
+    inline unsigned lowest_bit(uint64_t bits) {
+        SASSERT(bits != 0);
+#ifdef __GNUC__
+        return __builtin_ctzll(bits);
+#else
+        return get_num_1bits((bits & (0 - bits)) - 1);
+#endif
+    }
+
+#ifdef SWISS_TABLE_SSE2
+
+    class group {
+        __m128i m_ctrl;
+    public:
+        static const unsigned width = 16;
+        explicit group(ctrl_t const* p): m_ctrl(_mm_loadu_si128(reinterpret_cast<__m128i const*>(p))) {}
+        uint64_t match(ctrl_t h) const { return static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h), m_ctrl))); }
+        uint64_t match_empty() const { return match(EMPTY); }
+        uint64_t match_empty_or_deleted() const { return static_cast<unsigned>(_mm_movemask_epi8(m_ctrl)); }
+        static unsigned index(uint64_t bits) { return lowest_bit(bits); }
+    };
+
+#else
+
+    /**
+       \brief group of 8 control bytes in a machine word.
+       A match sets the most significant bit of the matching bytes.
+       match may report false positives above a true match; they are
+       filtered by the comparison of entries.
+    */
+    class group {
+        uint64_t m_ctrl;
+        static const uint64_t lsbs = 0x0101010101010101ull;
+        static const uint64_t msbs = 0x8080808080808080ull;
+    public:
+        static const unsigned width = 8;
+        explicit group(ctrl_t const* p) { memcpy(&m_ctrl, p, sizeof(m_ctrl)); }
+        uint64_t match(ctrl_t h) const {
+            uint64_t x = m_ctrl ^ (lsbs * static_cast<unsigned char>(h));
+            return (x - lsbs) & ~x & msbs;
+        }
+        // EMPTY is the only control value with bit 7 set and bit 1 clear.
+        uint64_t match_empty() const { return m_ctrl & ~(m_ctrl << 6) & msbs; }
+        uint64_t match_empty_or_deleted() const { return m_ctrl & msbs; }
+        static unsigned index(uint64_t bits) { return lowest_bit(bits) >> 3; }
+    };
+
+#endif
+
+};
+
+template<typename Entry, typename HashProc, typename EqProc>
+class core_swiss_hashtable : private HashProc, private EqProc {
+public:
+    typedef typename Entry::data data;
+    typedef Entry                entry;
+protected:
+    typedef swiss_table::ctrl_t ctrl_t;
+    typedef swiss_table::group  group;
+
+    Entry *  m_table;
+    ctrl_t * m_ctrl;
+    unsigned m_capacity;
+    unsigned m_size;
+    unsigned m_num_deleted;
+
+    unsigned get_hash(data const & e) const { return HashProc::operator()(e); }
+    bool equals(data const & e1, data const & e2) const { return EqProc::operator()(e1, e2); }
+
+    // hash codes of identifiers are often consecutive; the low bits of the
+    // product select the slot and the high bits are kept in the control byte.
+    static unsigned scramble(unsigned hash) { return hash * 0x9E3779B9u; }
+    static ctrl_t h2(unsigned m) { return static_cast<ctrl_t>(m >> 25); }
+    static bool is_full(ctrl_t c) { return c >= 0; }
+
+    static unsigned normalize_capacity(unsigned c) {
+        unsigned r = group::width;
+        while (r < c)
+            r <<= 1;
+        return r;
+    }
+
+    void alloc_table(unsigned capacity) {
+        SASSERT(is_power_of_two(capacity) && capacity >= group::width);
+        m_capacity = capacity;
+        m_table    = alloc_vect<Entry>(capacity);
+        m_ctrl     = alloc_svect(ctrl_t, capacity + group::width);
+        memset(m_ctrl, swiss_table::EMPTY, capacity + group::width);
+    }
+
+    void delete_table() {
+        dealloc_vect(m_table, m_capacity);
+        dealloc_svect(m_ctrl);
+        m_table = nullptr;
+        m_ctrl  = nullptr;
+    }
+
+    void set_ctrl(unsigned idx, ctrl_t c) {
+        m_ctrl[idx] = c;
+        if (idx < group::width)
+            m_ctrl[m_capacity + idx] = c;
+    }
+
+    unsigned max_load() const { return m_capacity - m_capacity / 8; }
+
+    /**
+       \brief return the slot of e, or UINT_MAX if e is not in the table.
+    */
+    unsigned find_index(data const & e, unsigned hash) const {
+        unsigned m    = scramble(hash);
+        ctrl_t   h    = h2(m);
+        unsigned mask = m_capacity - 1;
+        unsigned pos  = m & mask;
+        for (unsigned step = group::width; ; step += group::width) {
+            group g(m_ctrl + pos);
+            for (uint64_t bits = g.match(h); bits; bits &= bits - 1) {
+                unsigned idx = (pos + group::index(bits)) & mask;
+                entry const & t = m_table[idx];
+                if (is_full(m_ctrl[idx]) && t.get_hash() == hash && equals(t.get_data(), e))
+                    return idx;
+            }
+            if (g.match_empty())
+                return UINT_MAX;
+            pos = (pos + step) & mask;
+        }
+    }
+
+    /**
+       \brief return the first empty or deleted slot on the probe sequence of m.
+    */
+    unsigned find_insert_slot(unsigned m) const {
+        unsigned mask = m_capacity - 1;
+        unsigned pos  = m & mask;
+        for (unsigned step = group::width; ; step += group::width) {
+            uint64_t bits = group(m_ctrl + pos).match_empty_or_deleted();
+            if (bits)
+                return (pos + group::index(bits)) & mask;
+            pos = (pos + step) & mask;
+        }
+    }
+
+    entry * insert_new(data && e, unsigned hash) {
+        if (m_size + m_num_deleted + 1 > max_load())
+            rehash(2 * (m_size + 1) > max_load() ? 2 * m_capacity : m_capacity);
+        unsigned m   = scramble(hash);
+        unsigned idx = find_insert_slot(m);
+        if (m_ctrl[idx] == swiss_table::DELETED)
+            m_num_deleted--;
+        set_ctrl(idx, h2(m));
+        entry * t = m_table + idx;
+        t->set_data(std::move(e));
+        t->set_hash(hash);
+        m_size++;
+        return t;
+    }
+
+    void rehash(unsigned new_capacity) {
+        Entry *  old_table    = m_table;
+        ctrl_t * old_ctrl     = m_ctrl;
+        unsigned old_capacity = m_capacity;
+        alloc_table(new_capacity);
+        for (unsigned i = 0; i < old_capacity; ++i) {
+            if (!is_full(old_ctrl[i]))
+                continue;
+            unsigned hash = old_table[i].get_hash();
+            unsigned m    = scramble(hash);
+            unsigned idx  = find_insert_slot(m);
+            set_ctrl(idx, h2(m));
+            m_table[idx] = std::move(old_table[i]);
+        }
+        dealloc_vect(old_table, old_capacity);
+        dealloc_svect(old_ctrl);
+        m_num_deleted = 0;
+    }
+
+    void copy_from(core_swiss_hashtable const & source) {
+        alloc_table(source.m_capacity);
+        memcpy(m_ctrl, source.m_ctrl, m_capacity + group::width);
+        for (unsigned i = 0; i < m_capacity; ++i)
+            if (is_full(m_ctrl[i]))
+                m_table[i] = source.m_table[i];
+        m_size        = source.m_size;
+        m_num_deleted = source.m_num_deleted;
+    }
+
+public:
+    core_swiss_hashtable(unsigned initial_capacity = DEFAULT_HASHTABLE_INITIAL_CAPACITY,
+                         HashProc const & h = HashProc(),
+                         EqProc const & e = EqProc()):
+        HashProc(h),
+        EqProc(e),
+        m_size(0),
+        m_num_deleted(0) {
+        alloc_table(normalize_capacity(initial_capacity));
+    }
+
+    core_swiss_hashtable(core_swiss_hashtable const & source):
+        HashProc(source),
+        EqProc(source) {
+        copy_from(source);
+    }
+
+    core_swiss_hashtable(core_swiss_hashtable && source) noexcept :
+        HashProc(source),
+        EqProc(source),
+        m_table(nullptr),
+        m_ctrl(nullptr),
+        m_capacity(0),
+        m_size(0),
+        m_num_deleted(0) {
+        swap(source);
+    }
+
+    ~core_swiss_hashtable() {
+        if (m_table)
+            delete_table();
+    }
+
+    void swap(core_swiss_hashtable & source) noexcept {
+        std::swap(m_table,       source.m_table);
+        std::swap(m_ctrl,        source.m_ctrl);
+        std::swap(m_capacity,    source.m_capacity);
+        std::swap(m_size,        source.m_size);
+        std::swap(m_num_deleted, source.m_num_deleted);
+    }
+
+    void reset() {
+        if (m_size == 0 && m_num_deleted == 0)
+            return;
+        bool shrink = m_capacity > SMALL_TABLE_CAPACITY && (m_size + m_num_deleted) * 4 < m_capacity;
+        for (unsigned i = 0; i < m_capacity; ++i)
+            if (!m_table[i].is_free())
+                m_table[i].mark_as_free();
+        if (shrink) {
+            unsigned capacity = m_capacity >> 1;
+            delete_table();
+            alloc_table(capacity);
+        }
+        else {
+            memset(m_ctrl, swiss_table::EMPTY, m_capacity + group::width);
+        }
+        m_size        = 0;
+        m_num_deleted = 0;
+    }
+
+    void finalize() {
+        if (m_capacity > SMALL_TABLE_CAPACITY) {
+            delete_table();
+            alloc_table(SMALL_TABLE_CAPACITY);
+            m_size        = 0;
+            m_num_deleted = 0;
+        }
+        else {
+            reset();
+        }
+    }
+
+    class iterator {
+        entry *        m_curr;
+        entry *        m_end;
+        ctrl_t const * m_ctrl;
+        void move_to_used() {
+            while (m_curr != m_end && !is_full(*m_ctrl)) {
+                ++m_curr;
+                ++m_ctrl;
+            }
+        }
+    public:
+        iterator(entry * start, entry * end, ctrl_t const * ctrl): m_curr(start), m_end(end), m_ctrl(ctrl) { move_to_used(); }
+        data & operator*() { return m_curr->get_data(); }
+        data const & operator*() const { return m_curr->get_data(); }
+        data const * operator->() const { return &(operator*()); }
+        data * operator->() { return &(operator*()); }
+        iterator & operator++() { ++m_curr; ++m_ctrl; move_to_used(); return *this; }
+        iterator operator++(int) { iterator tmp = *this; ++*this; return tmp; }
+        bool operator==(iterator const & it) const { return m_curr == it.m_curr; }
+        bool operator!=(iterator const & it) const { return m_curr != it.m_curr; }
+    };
+
+    bool empty() const { return m_size == 0; }
+
+    unsigned size() const { return m_size; }
+
+    unsigned capacity() const { return m_capacity; }
+
+    iterator begin() const { return iterator(m_table, m_table + m_capacity, m_ctrl); }
+
+    iterator end() const { return iterator(m_table + m_capacity, m_table + m_capacity, m_ctrl + m_capacity); }
+
+    void insert(data && e) {
+        unsigned hash = get_hash(e);
+        unsigned idx  = find_index(e, hash);
+        if (idx != UINT_MAX)
+            m_table[idx].set_data(std::move(e));
+        else
+            insert_new(std::move(e), hash);
+    }
+
+    void insert(const data & e) {
+        data tmp(e);
+        insert(std::move(tmp));
+    }
+
+    /**
+       \brief Insert the element e if it is not in the table.
+       Return true if it is a new element, and false otherwise.
+       Store the entry/slot of the table in et.
+    */
+    bool insert_if_not_there_core(data && e, entry * & et) {
+        unsigned hash = get_hash(e);
+        unsigned idx  = find_index(e, hash);
+        if (idx != UINT_MAX) {
+            et = m_table + idx;
+            return false;
+        }
+        et = insert_new(std::move(e), hash);
+        return true;
+    }
+
+    bool insert_if_not_there_core(const data & e, entry * & et) {
+        data temp(e);
+        return insert_if_not_there_core(std::move(temp), et);
+    }
+
+    data const & insert_if_not_there(data const & e) {
+        entry * et = nullptr;
+        insert_if_not_there_core(e, et);
+        return et->get_data();
+    }
+
+    entry * insert_if_not_there2(data const & e) {
+        entry * et = nullptr;
+        insert_if_not_there_core(e, et);
+        return et;
+    }
+
+    entry * find_core(data const & e) const {
+        unsigned idx = find_index(e, get_hash(e));
+        return idx == UINT_MAX ? nullptr : m_table + idx;
+    }
+
+    bool find(data const & k, data & r) const {
+        entry * e = find_core(k);
+        if (e != nullptr) {
+            r = e->get_data();
+            return true;
+        }
+        return false;
+    }
+
+    bool contains(data const & e) const {
+        return find_core(e) != nullptr;
+    }
+
+    iterator find(data const & e) const {
+        unsigned idx = find_index(e, get_hash(e));
+        if (idx == UINT_MAX)
+            return end();
+        return iterator(m_table + idx, m_table + m_capacity, m_ctrl + idx);
+    }
+
+    void remove(data const & e) {
+        unsigned idx = find_index(e, get_hash(e));
+        if (idx == UINT_MAX)
+            return;
+        set_ctrl(idx, swiss_table::DELETED);
+        m_table[idx].mark_as_free();
+        m_num_deleted++;
+        m_size--;
+    }
+
+    void erase(data const & e) { remove(e); }
+
+    void dump(std::ostream & out) {
+        out << "[";
+        bool first = true;
+        for (data const & d : *this) {
+            if (!first)
+                out << " ";
+            first = false;
+            out << d;
+        }
+        out << "]";
+    }
+
+    core_swiss_hashtable& operator|=(core_swiss_hashtable const& other) {
+        if (this == &other) return *this;
+        for (const data& d : other)
+            insert(d);
+        return *this;
+    }
+
+    core_swiss_hashtable& operator&=(core_swiss_hashtable const& other) {
+        if (this == &other) return *this;
+        core_swiss_hashtable copy(*this);
+        for (const data& d : copy)
+            if (!other.contains(d))
+                remove(d);
+        return *this;
+    }
+
+    core_swiss_hashtable& operator=(core_swiss_hashtable const& other) {
+        if (this == &other) return *this;
+        reset();
+        for (const data& d : other)
+            insert(d);
+        return *this;
+    }
+
+#ifdef Z3DEBUG
+    bool check_invariant() {
+        if (!is_power_of_two(m_capacity) || m_capacity < group::width)
+            return false;
+        if (m_size + m_num_deleted > max_load())
+            return false;
+        unsigned num_deleted = 0, num_used = 0;
+        for (unsigned i = 0; i < m_capacity; ++i) {
+            if (m_ctrl[i] == swiss_table::DELETED)
+                num_deleted++;
+            else if (is_full(m_ctrl[i])) {
+                num_used++;
+                if (h2(scramble(m_table[i].get_hash())) != m_ctrl[i])
+                    return false;
+            }
+        }
+        for (unsigned i = 0; i < group::width; ++i)
+            if (m_ctrl[i] != m_ctrl[m_capacity + i])
+                return false;
+        return num_deleted == m_num_deleted && num_used == m_size;
+    }
+#endif
+
+    unsigned long long get_num_collision() const { return 0; }
+};
+
+template<typename T, typename HashProc, typename EqProc>
+class swiss_hashtable : public core_swiss_hashtable<default_hash_entry<T>, HashProc, EqProc> {
+public:
+    swiss_hashtable(unsigned initial_capacity = DEFAULT_HASHTABLE_INITIAL_CAPACITY,
+                    HashProc const & h = HashProc(),
+                    EqProc const & e = EqProc()):
+        core_swiss_hashtable<default_hash_entry<T>, HashProc, EqProc>(initial_capacity, h, e) {}
+};
+
+template<typename T, typename HashProc, typename EqProc>
+class ptr_swiss_hashtable : public core_swiss_hashtable<ptr_hash_entry<T>, HashProc, EqProc> {
+public:
+    ptr_swiss_hashtable(unsigned initial_capacity = DEFAULT_HASHTABLE_INITIAL_CAPACITY,
+                        HashProc const & h = HashProc(),
+                        EqProc const & e = EqProc()):
+        core_swiss_hashtable<ptr_hash_entry<T>, HashProc, EqProc>(initial_capacity, h, e) {}
+};
+
+/**
+   \brief map with the interface of table2map on top of core_swiss_hashtable.
+*/
+template<typename Key, typename Value, typename HashProc, typename EqProc>
+class swiss_map {
+    typedef table2map<default_map_entry<Key, Value>, HashProc, EqProc> base;
+public:
+    typedef typename base::entry    entry;
+    typedef typename base::key      key;
+    typedef typename base::value    value;
+    typedef typename base::key_data key_data;
+    typedef core_swiss_hashtable<entry, typename base::entry_hash_proc, typename base::entry_eq_proc> table;
+    typedef typename table::iterator iterator;
+private:
+    table m_table;
+public:
+    swiss_map(HashProc const & h = HashProc(), EqProc const & e = EqProc()):
+        m_table(DEFAULT_HASHTABLE_INITIAL_CAPACITY, typename base::entry_hash_proc(h), typename base::entry_eq_proc(e)) {
+    }
+
+    void reset() { m_table.reset(); }
+    void finalize() { m_table.finalize(); }
+    bool empty() const { return m_table.empty(); }
+    unsigned size() const { return m_table.size(); }
+    unsigned capacity() const { return m_table.capacity(); }
+    iterator begin() const { return m_table.begin(); }
+    iterator end() const { return m_table.end(); }
+
+    void insert(key const & k, value const & v) { m_table.insert(key_data(k, v)); }
+    void insert(key const & k, value && v) { m_table.insert(key_data(k, std::move(v))); }
+    bool insert_if_not_there_core(key const & k, value const & v, entry *& et) { return m_table.insert_if_not_there_core(key_data(k, v), et); }
+    value & insert_if_not_there(key const & k, value const & v) { return m_table.insert_if_not_there2(key_data(k, v))->get_data().m_value; }
+    entry * insert_if_not_there3(key const & k, value const & v) { return m_table.insert_if_not_there2(key_data(k, v)); }
+
+    entry * find_core(key const & k) const { return m_table.find_core(key_data(k)); }
+
+    bool find(key const & k, value & v) const {
+        entry * e = find_core(k);
+        if (e)
+            v = e->get_data().m_value;
+        return nullptr != e;
+    }
+
+    value const & get(key const & k, value const & default_value) const {
+        entry * e = find_core(k);
+        return e ? e->get_data().m_value : default_value;
+    }
+
+    iterator find_iterator(key const & k) const { return m_table.find(key_data(k)); }
+
+    value const & find(key const & k) const {
+        entry * e = find_core(k);
+        SASSERT(e);
+        return e->get_data().m_value;
+    }
+
+    value & find(key const & k) {
+        entry * e = find_core(k);
+        SASSERT(e);
+        return e->get_data().m_value;
+    }
+
+    value const & operator[](key const & k) const { return find(k); }
+    value & operator[](key const & k) { return find(k); }
+
+    bool contains(key const & k) const { return find_core(k) != nullptr; }
+    void remove(key const & k) { m_table.remove(key_data(k)); }
+    void erase(key const & k) { remove(k); }
+    void swap(swiss_map & other) noexcept { m_table.swap(other.m_table); }
+};
+
+template<typename Value>
+class u_swiss_map : public swiss_map<unsigned, Value, u_hash, u_eq> {};
@@ -19,12 +19,13 @@ Revision History:
 
 #include "util/symbol.h"
 #include "util/mutex.h"
-#include "util/str_hashtable.h"
+#include "util/hashtable.h"
 #include "util/region.h"
 #include "util/string_buffer.h"
 #include <cstring>
 #include <optional>
 #ifndef SINGLE_THREAD
+#include <atomic>
 #include <thread>
 #endif
 
@@ -37,9 +38,34 @@ const symbol symbol::null;
    \brief Symbol table manager. It stores the symbol strings created at runtime.
 */
 namespace {
+
+/**
+   \brief string to be interned, with its length and hash code.
+   They are computed once per lookup and shared by the shard selection,
+   the lookup cache and the table.
+*/
+struct symbol_key {
+    char const * m_str;
+    unsigned     m_len;
+    unsigned     m_hash;
+    symbol_key() = default;
+    symbol_key(char const * s, unsigned len): m_str(s), m_len(len), m_hash(string_hash(s, len, 17)) {}
+};
+
+struct symbol_key_hash { unsigned operator()(symbol_key const & k) const { return k.m_hash; } };
+struct symbol_key_eq {
+    bool operator()(symbol_key const & k1, symbol_key const & k2) const {
+        return k1.m_len == k2.m_len && memcmp(k1.m_str, k2.m_str, k1.m_len) == 0;
+    }
+};
+
+typedef hashtable<symbol_key, symbol_key_hash, symbol_key_eq> symbol_key_table;
+
+inline unsigned stored_hash(char const * s) { return static_cast<unsigned>(reinterpret_cast<size_t const *>(s)[-1]); }
+
 class internal_symbol_table {
-    region        m_region; //!< Region used to store symbol strings.
-    str_hashtable m_table;  //!< Table of created symbol strings.
+    region           m_region; //!< Region used to store symbol strings.
+    symbol_key_table m_table;  //!< Table of created symbol strings.
     DECLARE_MUTEX(lock);
     
 public:
@@ -52,27 +78,21 @@ public:
         DEALLOC_MUTEX(lock);
     }
 
-    char const * get_str(char const * d) {
-        const char * result;
+    char const * get_str(symbol_key const & k) {
         lock_guard _lock(*lock);
-        str_hashtable::entry * e;
-        if (m_table.insert_if_not_there_core(d, e)) {
+        symbol_key_table::entry * e;
+        if (m_table.insert_if_not_there_core(k, e)) {
             // new entry
-            size_t l   = strlen(d);
             // store the hash-code before the string
-            size_t * mem = static_cast<size_t*>(m_region.allocate(l + 1 + sizeof(size_t)));
-            *mem = e->get_hash();
+            size_t * mem = static_cast<size_t*>(m_region.allocate(k.m_len + 1 + sizeof(size_t)));
+            *mem = k.m_hash;
             mem++;
-            result = reinterpret_cast<const char*>(mem);
-            memcpy(mem, d, l+1);
+            memcpy(mem, k.m_str, k.m_len + 1);
             // update the entry with the new ptr.
-            e->set_data(result);
+            e->get_data().m_str = reinterpret_cast<const char*>(mem);
         }
-        else {
-            result = e->get_data();
-        }
-        SASSERT(m_table.contains(result));
-        return result;
+        SASSERT(stored_hash(e->get_data().m_str) == k.m_hash);
+        return e->get_data().m_str;
     }
 };
 }
@@ -90,8 +110,27 @@ void finalize_symbols() {
     g_symbol_tables.reset();
 }
 
+static char const * get_str(char const * d) {
+    return g_symbol_tables->get_str(symbol_key(d, static_cast<unsigned>(strlen(d))));
+}
+
 #else
 
+/**
+   \brief per-thread direct mapped cache of interned strings.
+   Hits return without taking the lock of a shard. The epoch invalidates
+   the caches of all threads when the symbol tables are recreated.
+*/
+namespace {
+struct cached_symbol {
+    char const * m_str   = nullptr;
+    unsigned     m_epoch = 0;
+};
+const unsigned symbol_cache_size = 512;
+thread_local cached_symbol t_symbol_cache[symbol_cache_size];
+std::atomic<unsigned> g_symbol_epoch(0);
+}
+
 struct internal_symbol_tables {
     unsigned sz;
     internal_symbol_table** tables;
@@ -109,8 +148,16 @@ struct internal_symbol_tables {
     }
 
     char const * get_str(char const * d) {
-        auto* table = tables[string_hash(d, static_cast<unsigned>(strlen(d)), 251) % sz];
-        return table->get_str(d);
+        symbol_key k(d, static_cast<unsigned>(strlen(d)));
+        unsigned epoch = g_symbol_epoch.load(std::memory_order_relaxed);
+        cached_symbol & c = t_symbol_cache[k.m_hash & (symbol_cache_size - 1)];
+        if (c.m_epoch == epoch && stored_hash(c.m_str) == k.m_hash && strcmp(c.m_str, d) == 0)
+            return c.m_str;
+        // the low bits of the hash code index the tables of the shards
+        auto* table = tables[((k.m_hash * 2654435761u) >> 20) % sz];
+        c.m_str   = table->get_str(k);
+        c.m_epoch = epoch;
+        return c.m_str;
     }
 };
 
@@ -121,7 +168,7 @@ void initialize_symbols() {
     if (!g_symbol_tables) {
         unsigned num_tables = 2 * std::min((unsigned) std::thread::hardware_concurrency(), 64u);
         g_symbol_tables = alloc(internal_symbol_tables, num_tables);
-        
+        ++g_symbol_epoch;
     }
 }
 
@@ -129,17 +176,21 @@ void finalize_symbols() {
     dealloc(g_symbol_tables);
     g_symbol_tables = nullptr;
 }
+
+static char const * get_str(char const * d) {
+    return g_symbol_tables->get_str(d);
+}
 #endif
 
 symbol::symbol(char const * d) {
     if (d == nullptr)
         m_data = nullptr;
     else
-        m_data = g_symbol_tables->get_str(d);
+        m_data = get_str(d);
 }
 
 symbol & symbol::operator=(char const * d) {
-    m_data = d ? g_symbol_tables->get_str(d) : nullptr;
+    m_data = d ? get_str(d) : nullptr;
     return *this;
 }
 
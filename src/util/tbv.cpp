@@ -109,16 +109,29 @@ tbv* tbv_manager::allocate(char const* bv) {
     return result;
 }
 
+/**
+   \brief copy the tbits that are not deleted.
+   The two bits of a tbit are in the same word, so they are moved
+   together and the words of the result are written once.
+*/
 tbv* tbv_manager::project(bit_vector const& to_delete, tbv const& src) {
     tbv* r = allocate();
     unsigned i, j;
     unsigned n = to_delete.size();
+    unsigned w = 0;
     for (i = 0, j = 0; i < n; ++i) {
-        if (!to_delete.get(i)) {
-            set(*r, j, src[i]);
-            ++j;
+        if (to_delete.get(i))
+            continue;
+        unsigned f = (src.m_data[i / 16] >> (2 * (i % 16))) & 0x3;
+        w |= f << (2 * (j % 16));
+        ++j;
+        if (j % 16 == 0) {
+            r->m_data[j / 16 - 1] = w;
+            w = 0;
         }
     }
+    if (j % 16 != 0)
+        r->m_data[j / 16] = w;
     SASSERT(num_tbits() == j);
     return r;
 }
@@ -203,30 +216,36 @@ tbv& tbv_manager::set_or(tbv& dst,  tbv const& src) const {
     return dst;
 }
 bool tbv_manager::set_and(tbv& dst,  tbv const& src) const {
-    m.set_and(dst, src); 
-    return is_well_formed(dst);
+    // callers inspect dst also when it is empty, so all words are updated
+    unsigned nw = m.num_words();
+    if (nw == 0)
+        return true;
+    bool ok = true;
+    for (unsigned i = 0; i + 1 < nw; ++i) {
+        dst.m_data[i] &= src.m_data[i];
+        ok &= is_well_formed_word(dst.m_data[i]);
+    }
+    dst.m_data[nw - 1] &= src.m_data[nw - 1];
+    return ok && is_well_formed_word(m.last_word(dst) | ~m.get_mask());
 }
 
 bool tbv_manager::is_well_formed(tbv const& dst) const {
     unsigned nw = m.num_words();
-    unsigned w;
-    for (unsigned i = 0; i + 1 < nw; ++i) {
-        w = dst.get_word(i);
-        w = w | (w << 1) | 0x55555555;
-        if (w != 0xFFFFFFFF) return false;
-    }
-    if (nw > 0) {        
-        w = m.last_word(dst);
-        w = w | (w << 1) | 0x55555555 | ~m.get_mask();
-        if (w != 0xFFFFFFFF) return false;
-    }
-    return true;
+    for (unsigned i = 0; i + 1 < nw; ++i) 
+        if (!is_well_formed_word(dst.get_word(i)))
+            return false;
+    return nw == 0 || is_well_formed_word(m.last_word(dst) | ~m.get_mask());
 }
 
 void tbv_manager::complement(tbv const& src, ptr_vector<tbv>& result) {
     tbv* r;
     unsigned n = num_tbits();
     for (unsigned i = 0; i < n; ++i) {
+        // skip words of don't cares
+        if (i % 16 == 0 && src.m_data[i / 16] == 0xFFFFFFFF) {
+            i += 15;
+            continue;
+        }
         switch (src.get(i)) {
         case BIT_0:
             r = allocate(src);
@@ -264,9 +283,24 @@ bool tbv_manager::contains(tbv const& a, unsigned_vector const& colsa,
     return true;
 }
 
-bool tbv_manager::intersect(tbv const& a, tbv const& b, tbv& result) {
-    copy(result, a);
-    return set_and(result, b);
+/**
+   \brief result := a & b in one pass over the words, which stops at
+   the first word that contains an empty tbit (BIT_z).
+   The content of result is unspecified when the intersection is empty.
+*/
+bool tbv_manager::intersect(tbv const& a, tbv const& b, tbv& result) const {
+    unsigned nw = m.num_words();
+    if (nw == 0)
+        return true;
+    for (unsigned i = 0; i + 1 < nw; ++i) {
+        unsigned w = a.m_data[i] & b.m_data[i];
+        result.m_data[i] = w;
+        if (!is_well_formed_word(w))
+            return false;
+    }
+    unsigned w = a.m_data[nw - 1] & b.m_data[nw - 1];
+    result.m_data[nw - 1] = w;
+    return is_well_formed_word(w | ~m.get_mask());
 }
 
 std::ostream& tbv_manager::display(std::ostream& out, tbv const& b, unsigned hi, unsigned lo) const {
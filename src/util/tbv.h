@@ -41,6 +41,9 @@ class tbv_manager {
     friend class tbv;
     fixed_bit_vector_manager m;
     ptr_vector<tbv> allocated_tbvs;
+
+    // every tbit of w has at least one bit set
+    static bool is_well_formed_word(unsigned w) { return (w | (w << 1) | 0x55555555) == 0xFFFFFFFF; }
 public:
     tbv_manager(unsigned n): m(2*n) {}
     tbv_manager(tbv_manager const& m) = delete;
@@ -75,7 +78,7 @@ public:
     bool contains(tbv const& a, tbv const& b) const;
     bool contains(tbv const& a, unsigned_vector const& colsa,
                   tbv const& b, unsigned_vector const& colsb) const;
-    bool intersect(tbv const& a, tbv const& b, tbv& result);
+    bool intersect(tbv const& a, tbv const& b, tbv& result) const;
     std::ostream& display(std::ostream& out, tbv const& b) const;
     std::ostream& display(std::ostream& out, tbv const& b, unsigned hi, unsigned lo) const;
     tbv* project(bit_vector const& to_delete, tbv const& src);
@@ -123,9 +126,10 @@ public:
 private:
 
 
+    // tbit i occupies bits 2i (high bit of the tbit) and 2i+1 (low bit) of the same word.
     unsigned get(unsigned index) const {
-        index *= 2;
-        return (fixed_bit_vector::get(index) << 1) | (unsigned)fixed_bit_vector::get(index+1);
+        unsigned f = (get_word(index / 16) >> (2 * (index % 16))) & 0x3;
+        return ((f & 0x1) << 1) | (f >> 1);
     }
 };
 
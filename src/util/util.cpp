@@ -19,6 +19,11 @@ Revision History:
 
 #include "util/util.h"
 #include <iostream>
+#include <thread>
+#if defined(__linux__) && !defined(SINGLE_THREAD)
+#include <pthread.h>
+#include <sched.h>
+#endif
 
 static unsigned g_verbosity_level = 0;
 
@@ -30,6 +35,46 @@ unsigned get_verbosity_level() {
     return g_verbosity_level;
 }
 
+static unsigned g_max_threads = 0;
+
+void set_max_threads(unsigned n) {
+    g_max_threads = n;
+}
+
+unsigned get_num_threads(unsigned n) {
+    unsigned num_procs = std::thread::hardware_concurrency();
+    if (num_procs > 0)
+        n = std::min(n, num_procs);
+    if (g_max_threads > 0)
+        n = std::min(n, g_max_threads);
+#ifdef Z3_WASM_THREADS
+    // the wasm build preallocates a fixed pool of workers;
+    // spawning more blocks until the browser event loop creates a new one.
+    n = std::min(n, (unsigned)Z3_WASM_THREADS);
+#endif
+    return std::max(n, 1u);
+}
+
+static bool g_pin_threads = false;
+
+void set_pin_threads(bool f) {
+    g_pin_threads = f;
+}
+
+void pin_thread(unsigned i) {
+    if (!g_pin_threads)
+        return;
+#if defined(__linux__) && !defined(SINGLE_THREAD)
+    unsigned num_procs = std::thread::hardware_concurrency();
+    if (num_procs == 0)
+        return;
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    CPU_SET(i % num_procs, &cpus);
+    pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus);
+#endif
+}
+
 static std::ostream* g_verbose_stream = &std::cerr;
 
 void set_verbose_stream(std::ostream& str) {
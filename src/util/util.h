@@ -193,6 +193,22 @@ unsigned get_verbosity_level();
 std::ostream& verbose_stream();
 void set_verbose_stream(std::ostream& str);
 
+/**
+   \brief process-wide cap on the number of threads, 0 means no cap.
+   get_num_threads(n) is the number of threads to spawn for a request of n threads:
+   it is at least 1 and capped by the number of processors and set_max_threads.
+*/
+void set_max_threads(unsigned n);
+unsigned get_num_threads(unsigned n);
+
+/**
+   \brief when enabled, worker i of a parallel solver calls pin_thread(i) to bind
+   itself to processor i modulo the number of processors, so that the memory it
+   allocates stays on the node of that processor. Only supported on Linux.
+*/
+void set_pin_threads(bool f);
+void pin_thread(unsigned i);
+
   
 #define IF_VERBOSE(LVL, CODE) { if (get_verbosity_level() >= LVL) { THREAD_LOCK(CODE); } } ((void) 0)              
 
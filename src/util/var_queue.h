@@ -21,9 +21,19 @@ Revision History:
 #include "util/heap.h"
 
 
+/**
+   \brief queue of unassigned variables ordered by activity.
+
+   The default representation is a binary heap on activities.
+   Alternatively, variables are kept in a variable move-to-front (VMTF)
+   list ordered by the time they were last bumped. Bumping a variable moves
+   it to the end of the list in constant time, and the search for the next
+   variable starts from a cursor that is at or after every queued variable.
+*/
 template <class ActivityVector>    
 class var_queue {
     typedef unsigned var;
+    static constexpr var null_var = UINT_MAX;
 
     struct lt {
         ActivityVector & m_activity;
@@ -32,17 +42,110 @@ class var_queue {
     };
     heap<lt>  m_queue;
 
+    bool              m_vmtf = false;
+    unsigned_vector   m_prev, m_next;       // list from the least to the most recently bumped variable
+    svector<uint64_t> m_stamp;              // bump time, 0 for variables not in the list
+    bool_vector       m_queued;
+    unsigned          m_num_queued = 0;
+    var               m_first = null_var, m_last = null_var;
+    var               m_search = null_var;  // no queued variable has a larger stamp
+    uint64_t          m_time = 0;
+
+    void link_last(var v) {
+        m_prev[v] = m_last;
+        m_next[v] = null_var;
+        if (m_last == null_var)
+            m_first = v;
+        else
+            m_next[m_last] = v;
+        m_last = v;
+        m_stamp[v] = ++m_time;
+    }
+
+    void unlink(var v) {
+        if (m_prev[v] == null_var)
+            m_first = m_next[v];
+        else
+            m_next[m_prev[v]] = m_next[v];
+        if (m_next[v] == null_var)
+            m_last = m_prev[v];
+        else
+            m_prev[m_next[v]] = m_prev[v];
+    }
+
+    void move_to_front(var v) {
+        if (v != m_last) {
+            unlink(v);
+            link_last(v);
+        }
+        if (m_queued[v])
+            m_search = v;
+    }
+
+    void vmtf_reset() {
+        m_prev.reset();
+        m_next.reset();
+        m_stamp.reset();
+        m_queued.reset();
+        m_num_queued = 0;
+        m_first = m_last = m_search = null_var;
+    }
+
 public:
     
     var_queue(ActivityVector & act):m_queue(128, lt(act)) {}
+
+    /**
+       \brief switch between the heap and the VMTF representation.
+       Queued variables remain queued. Variables enter the VMTF list in the
+       order of their activity.
+    */
+    void set_vmtf(bool vmtf, unsigned num_vars) {
+        if (vmtf == m_vmtf)
+            return;
+        unsigned_vector queued;
+        if (m_vmtf) {
+            for (var v = 0; v < m_queued.size(); ++v) 
+                if (m_queued[v])
+                    queued.push_back(v);
+            vmtf_reset();
+            m_vmtf = false;
+            m_queue.reserve(num_vars);
+            for (var v : queued)
+                m_queue.insert(v);
+        }
+        else {
+            while (!m_queue.empty())
+                queued.push_back(m_queue.erase_min());
+            m_vmtf = true;
+            bool_vector is_queued(num_vars, false);
+            for (var v : queued)
+                is_queued.setx(v, true, false);
+            for (var v = 0; v < num_vars; ++v) {
+                if (!is_queued[v]) {
+                    mk_var_eh(v);
+                    del_var_eh(v);
+                }
+            }
+            // least active variables first
+            for (unsigned i = queued.size(); i-- > 0; )
+                mk_var_eh(queued[i]);
+        }
+    }
     
     void activity_increased_eh(var v) {
-        if (m_queue.contains(v))
+        if (m_vmtf)
+            move_to_front(v);
+        else if (m_queue.contains(v))
             m_queue.decreased(v);
     }
     
     void activity_changed_eh(var v, bool up) {
-        if (m_queue.contains(v)) {
+        if (m_vmtf) {
+            if (up)
+                move_to_front(v);
+        }
+        else if (m_queue.contains(v)) {
             if (up) 
                 m_queue.decreased(v);
             else 
@@ -51,47 +154,103 @@ public:
     }
     
     void mk_var_eh(var v) {
-        m_queue.reserve(v+1);
+        if (m_vmtf) {
+            if (v >= m_stamp.size()) {
+                m_prev.resize(v + 1, null_var);
+                m_next.resize(v + 1, null_var);
+                m_stamp.resize(v + 1, 0);
+                m_queued.resize(v + 1, false);
+            }
+            if (m_stamp[v] == 0)
+                link_last(v);
+        }
+        else 
+            m_queue.reserve(v+1);
         unassign_var_eh(v);
     }
     
     void del_var_eh(var v) {
-        if (m_queue.contains(v))
+        if (m_vmtf) {
+            if (v < m_queued.size() && m_queued[v]) {
+                m_queued[v] = false;
+                --m_num_queued;
+            }
+        }
+        else if (m_queue.contains(v))
             m_queue.erase(v);
     }
     
     void unassign_var_eh(var v) {
-        if (!m_queue.contains(v))
+        if (m_vmtf) {
+            if (!m_queued[v]) {
+                m_queued[v] = true;
+                ++m_num_queued;
+                if (m_search == null_var || m_stamp[v] > m_stamp[m_search])
+                    m_search = v;
+            }
+        }
+        else if (!m_queue.contains(v))
             m_queue.insert(v);
     }
     
     void reset() {
         m_queue.reset();
+        if (m_vmtf) {
+            for (var v = 0; v < m_queued.size(); ++v) 
+                m_queued[v] = false;
+            m_num_queued = 0;
+            m_search = null_var;
+        }
     }
 
-    bool contains(var v) const { return m_queue.contains(v); }
+    bool contains(var v) const { return m_vmtf ? v < m_queued.size() && m_queued[v] : m_queue.contains(v); }
     
-    bool empty() const { return m_queue.empty(); }
+    bool empty() const { return m_vmtf ? m_num_queued == 0 : m_queue.empty(); }
     
-    var next_var() { SASSERT(!empty()); return m_queue.erase_min(); }
+    var next_var() { 
+        SASSERT(!empty()); 
+        if (!m_vmtf)
+            return m_queue.erase_min(); 
+        var v = min_var();
+        m_queued[v] = false;
+        --m_num_queued;
+        return v;
+    }
     
-    var min_var() { SASSERT(!empty()); return m_queue.min_value(); }
+    var min_var() { 
+        SASSERT(!empty()); 
+        if (!m_vmtf)
+            return m_queue.min_value(); 
+        while (!m_queued[m_search])
+            m_search = m_prev[m_search];
+        return m_search;
+    }
     
-    bool more_active(var v1, var v2) const { return m_queue.less_than(v1, v2); }
+    bool more_active(var v1, var v2) const { return m_vmtf ? m_stamp[v1] > m_stamp[v2] : m_queue.less_than(v1, v2); }
 
     std::ostream& display(std::ostream& out) const {
         bool first = true;
-        for (auto v : m_queue) {
+        auto display_var = [&](var v) {
             if (first) {
                 first = false;
             } else {
                 out << " ";
             }
             out << v;
+        };
+        if (m_vmtf) {
+            for (var v = m_last; v != null_var; v = m_prev[v])
+                if (m_queued[v])
+                    display_var(v);
+        }
+        else {
+            for (auto v : m_queue) 
+                display_var(v);
         }
         return out;
     }
 
+    // iterates over the heap; empty in VMTF mode
     using const_iterator = const int *;
     const_iterator begin() const { return m_queue.begin(); }
     const_iterator end() const { return m_queue.end(); }
@@ -164,35 +164,23 @@ std::string zstring::encode() const {
     return std::move(strm).str();
 }
 
+// compare n characters starting at a and b
+static bool equal_chars(uint32_t const* a, uint32_t const* b, unsigned n) {
+    return n == 0 || memcmp(a, b, n * sizeof(uint32_t)) == 0;
+}
+
 bool zstring::suffixof(zstring const& other) const {
     if (length() > other.length()) return false;
-    bool suffix = true;
-    for (unsigned i = 0; suffix && i < length(); ++i) {
-        suffix = m_buffer[length()-i-1] == other[other.length()-i-1];
-    }
-    return suffix;
+    return equal_chars(m_buffer.data(), other.m_buffer.data() + other.length() - length(), length());
 }
 
 bool zstring::prefixof(zstring const& other) const {
     if (length() > other.length()) return false;
-    bool prefix = true;
-    for (unsigned i = 0; prefix && i < length(); ++i) {
-        prefix = m_buffer[i] == other[i];
-    }
-    return prefix;
+    return equal_chars(m_buffer.data(), other.m_buffer.data(), length());
 }
 
 bool zstring::contains(zstring const& other) const {
-    if (other.length() > length()) return false;
-    unsigned last = length() - other.length();
-    bool cont = false;
-    for (unsigned i = 0; !cont && i <= last; ++i) {
-        cont = true;
-        for (unsigned j = 0; cont && j < other.length(); ++j) {
-            cont = other[j] == m_buffer[j+i];
-        }
-    }
-    return cont;
+    return indexofu(other, 0) >= 0;
 }
 
 int zstring::indexofu(zstring const& other, unsigned offset) const {
@@ -201,14 +189,10 @@ int zstring::indexofu(zstring const& other, unsigned offset) const {
     if (offset > other.length() + offset) return -1;
     if (other.length() + offset > length()) return -1;
     unsigned last = length() - other.length();
+    uint32_t first = other[0];
     for (unsigned i = offset; i <= last; ++i) {
-        bool prefix = true;
-        for (unsigned j = 0; prefix && j < other.length(); ++j) {
-            prefix = m_buffer[i + j] == other[j];
-        }
-        if (prefix) {
+        if (m_buffer[i] == first && equal_chars(m_buffer.data() + i, other.m_buffer.data(), other.length()))
             return static_cast<int>(i);
-        }
     }
     return -1;
 }
@@ -217,13 +201,8 @@ int zstring::last_indexof(zstring const& other) const {
     if (other.length() == 0) return length();
     if (other.length() > length()) return -1;
     for (unsigned last = length() - other.length() + 1; last-- > 0; ) {
-        bool suffix = true;
-        for (unsigned j = 0; suffix && j < other.length(); ++j) {
-            suffix = m_buffer[last + j] == other[j];
-        }
-        if (suffix) {
+        if (equal_chars(m_buffer.data() + last, other.m_buffer.data(), other.length()))
             return static_cast<int>(last);
-        }
     }
     return -1;
 }
@@ -231,10 +210,9 @@ int zstring::last_indexof(zstring const& other) const {
 zstring zstring::extract(unsigned offset, unsigned len) const {
     zstring result;
     if (offset + len < offset) return result;
-    int last = std::min(offset+len, length());
-    for (int i = offset; i < last; ++i) {
-        result.m_buffer.push_back(m_buffer[i]);
-    }
+    unsigned last = std::min(offset+len, length());
+    if (offset < last)
+        result.m_buffer.append(last - offset, m_buffer.data() + offset);
     return result;
 }
 
@@ -251,15 +229,7 @@ zstring zstring::operator+(zstring const& other) const {
 
 bool zstring::operator==(const zstring& other) const {
     // two strings are equal iff they have the same length and characters
-    if (length() != other.length()) {
-        return false;
-    }
-    for (unsigned i = 0; i < length(); ++i) {
-        if (m_buffer[i] != other[i]) {
-            return false;
-        }
-    }
-    return true;
+    return length() == other.length() && equal_chars(m_buffer.data(), other.m_buffer.data(), length());
 }
 
 bool zstring::operator!=(const zstring& other) const {